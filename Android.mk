@@ -22,6 +22,7 @@ LOCAL_SRC_FILES := \
     source/convert_to_i420.cc   \
     source/cpu_id.cc            \
     source/planar_functions.cc  \
+    source/profile.cc           \
     source/rotate.cc            \
     source/rotate_any.cc        \
     source/rotate_argb.cc       \
@@ -51,6 +52,7 @@ LOCAL_SRC_FILES := \
     source/scale_neon64.cc      \
     source/scale_uv.cc          \
     source/scale_win.cc         \
+    source/slice.cc             \
     source/video_common.cc
 
 common_CFLAGS := -Wall -fexceptions
@@ -0,0 +1,102 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "../benchmark/libyuv_benchmark.h"
+#include "libyuv/compare.h"
+
+namespace libyuv {
+
+// The plane benchmarks measure the Y plane of a frame.
+
+static void HashDjb2Benchmark(benchmark::State& state, int width, int height) {
+  BenchmarkBuffer src(width * height);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        HashDjb2(src.get(), static_cast<uint64_t>(width) * height, 5381));
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height);
+}
+
+static void ComputeHammingDistanceBenchmark(benchmark::State& state,
+                                            int width,
+                                            int height) {
+  BenchmarkBuffer src_a(width * height);
+  BenchmarkBuffer src_b(width * height);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        ComputeHammingDistance(src_a.get(), src_b.get(), width * height));
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 2);
+}
+
+static void ComputeSumSquareErrorPlaneBenchmark(benchmark::State& state,
+                                                int width,
+                                                int height) {
+  BenchmarkBuffer src_a(width * height);
+  BenchmarkBuffer src_b(width * height);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(ComputeSumSquareErrorPlane(
+        src_a.get(), width, src_b.get(), width, width, height));
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 2);
+}
+
+// I420 frame comparisons.  measure is I420Psnr or I420Ssim.
+template <double (*measure)(const uint8_t*,
+                            int,
+                            const uint8_t*,
+                            int,
+                            const uint8_t*,
+                            int,
+                            const uint8_t*,
+                            int,
+                            const uint8_t*,
+                            int,
+                            const uint8_t*,
+                            int,
+                            int,
+                            int)>
+static void I420CompareBenchmark(benchmark::State& state,
+                                 int width,
+                                 int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y_a(width * height);
+  BenchmarkBuffer src_u_a(halfwidth * halfheight);
+  BenchmarkBuffer src_v_a(halfwidth * halfheight);
+  BenchmarkBuffer src_y_b(width * height);
+  BenchmarkBuffer src_u_b(halfwidth * halfheight);
+  BenchmarkBuffer src_v_b(halfwidth * halfheight);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        measure(src_y_a.get(), width, src_u_a.get(), halfwidth, src_v_a.get(),
+                halfwidth, src_y_b.get(), width, src_u_b.get(), halfwidth,
+                src_v_b.get(), halfwidth, width, height));
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   (static_cast<int64_t>(width) * height +
+                    static_cast<int64_t>(halfwidth) * halfheight * 2) *
+                       2);
+}
+
+void RegisterCompareBenchmarks() {
+  RegisterFrameBenchmark("HashDjb2", HashDjb2Benchmark);
+  RegisterFrameBenchmark("ComputeHammingDistance",
+                         ComputeHammingDistanceBenchmark);
+  RegisterFrameBenchmark("ComputeSumSquareErrorPlane",
+                         ComputeSumSquareErrorPlaneBenchmark);
+  RegisterFrameBenchmark("I420Psnr", I420CompareBenchmark<I420Psnr>);
+  RegisterFrameBenchmark("I420Ssim", I420CompareBenchmark<I420Ssim>);
+}
+
+}  // namespace libyuv
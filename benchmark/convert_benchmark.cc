@@ -0,0 +1,140 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "../benchmark/libyuv_benchmark.h"
+#include "libyuv/convert.h"
+#include "libyuv/convert_argb.h"
+#include "libyuv/convert_from.h"
+
+namespace libyuv {
+
+static void I420ToARGBBenchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_u(halfwidth * halfheight);
+  BenchmarkBuffer src_v(halfwidth * halfheight);
+  BenchmarkBuffer dst_argb(width * 4 * height);
+  for (auto _ : state) {
+    I420ToARGB(src_y.get(), width, src_u.get(), halfwidth, src_v.get(),
+               halfwidth, dst_argb.get(), width * 4, width, height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 5 +
+                       static_cast<int64_t>(halfwidth) * halfheight * 2);
+}
+
+static void NV12ToARGBBenchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_uv(halfwidth * 2 * halfheight);
+  BenchmarkBuffer dst_argb(width * 4 * height);
+  for (auto _ : state) {
+    NV12ToARGB(src_y.get(), width, src_uv.get(), halfwidth * 2,
+               dst_argb.get(), width * 4, width, height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 5 +
+                       static_cast<int64_t>(halfwidth) * halfheight * 2);
+}
+
+static void ARGBToI420Benchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_argb(width * 4 * height);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  for (auto _ : state) {
+    ARGBToI420(src_argb.get(), width * 4, dst_y.get(), width, dst_u.get(),
+               halfwidth, dst_v.get(), halfwidth, width, height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 5 +
+                       static_cast<int64_t>(halfwidth) * halfheight * 2);
+}
+
+static void RAWToI420Benchmark(benchmark::State& state,
+                               int width,
+                               int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_raw(width * 3 * height);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  for (auto _ : state) {
+    RAWToI420(src_raw.get(), width * 3, dst_y.get(), width, dst_u.get(),
+              halfwidth, dst_v.get(), halfwidth, width, height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 4 +
+                       static_cast<int64_t>(halfwidth) * halfheight * 2);
+}
+
+static void I420ToNV12Benchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_u(halfwidth * halfheight);
+  BenchmarkBuffer src_v(halfwidth * halfheight);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_uv(halfwidth * 2 * halfheight);
+  for (auto _ : state) {
+    I420ToNV12(src_y.get(), width, src_u.get(), halfwidth, src_v.get(),
+               halfwidth, dst_y.get(), width, dst_uv.get(), halfwidth * 2,
+               width, height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   (static_cast<int64_t>(width) * height +
+                    static_cast<int64_t>(halfwidth) * halfheight * 2) *
+                       2);
+}
+
+static void NV12ToI420Benchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_uv(halfwidth * 2 * halfheight);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  for (auto _ : state) {
+    NV12ToI420(src_y.get(), width, src_uv.get(), halfwidth * 2, dst_y.get(),
+               width, dst_u.get(), halfwidth, dst_v.get(), halfwidth, width,
+               height);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   (static_cast<int64_t>(width) * height +
+                    static_cast<int64_t>(halfwidth) * halfheight * 2) *
+                       2);
+}
+
+void RegisterConvertBenchmarks() {
+  RegisterFrameBenchmark("I420ToARGB", I420ToARGBBenchmark);
+  RegisterFrameBenchmark("NV12ToARGB", NV12ToARGBBenchmark);
+  RegisterFrameBenchmark("ARGBToI420", ARGBToI420Benchmark);
+  RegisterFrameBenchmark("RAWToI420", RAWToI420Benchmark);
+  RegisterFrameBenchmark("I420ToNV12", I420ToNV12Benchmark);
+  RegisterFrameBenchmark("NV12ToI420", NV12ToI420Benchmark);
+}
+
+}  // namespace libyuv
@@ -0,0 +1,137 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+// Performance suite for libyuv.  Unlike libyuv_unittest, which times the
+// tests it runs, this only measures, and reports the time per call with
+// statistics and throughput counters.  For results to track regressions:
+//   libyuv_benchmark --benchmark_out=libyuv.json --benchmark_out_format=json
+// Use --benchmark_filter to pick benchmarks, such as
+//   --benchmark_filter='I420ToARGB/1080p/.*'
+
+#include "../benchmark/libyuv_benchmark.h"
+
+#include <stdlib.h>
+
+#include <string>
+
+#include "libyuv/cpu_id.h"
+#include "libyuv/version.h"
+
+namespace libyuv {
+
+struct FrameSize {
+  const char* name;
+  int width;
+  int height;
+};
+
+static const FrameSize kFrameSizes[] = {
+    {"480p", 640, 480},
+    {"1080p", 1920, 1080},
+    {"4K", 3840, 2160},
+};
+
+// A CPU tier is run if the CPU has the required flag, with the flags masked
+// to mask.  Each tier turns off the instruction sets of the tiers after it.
+struct CpuTier {
+  const char* name;
+  int required;
+  int mask;
+};
+
+static const int kCpuAVX512 = kCpuHasAVX512BW | kCpuHasAVX512VL |
+                              kCpuHasAVX512VBMI | kCpuHasAVX512VBMI2 |
+                              kCpuHasAVX512VBITALG | kCpuHasAVX512VPOPCNTDQ;
+static const int kCpuAVX = kCpuHasAVX | kCpuHasAVX2 | kCpuHasFMA3 |
+                           kCpuHasF16C | kCpuHasGFNI | kCpuAVX512;
+
+static const CpuTier kCpuTiers[] = {
+    {"C", 0, kCpuInitialized},
+    {"SSSE3", kCpuHasSSSE3, ~kCpuAVX},
+    {"AVX2", kCpuHasAVX2, ~kCpuAVX512},
+    {"AVX512", kCpuHasAVX512BW, -1},
+    {"NEON", kCpuHasNEON, -1},
+    {"MSA", kCpuHasMSA, -1},
+    {"MMI", kCpuHasMMI, -1},
+};
+
+static void RunFrameBenchmark(benchmark::State& state,
+                              FrameBenchmark function,
+                              int width,
+                              int height,
+                              int mask) {
+  MaskCpuFlags(mask);
+  function(state, width, height);
+  MaskCpuFlags(-1);
+}
+
+void RegisterFrameBenchmark(const char* name, FrameBenchmark function) {
+  for (const FrameSize& size : kFrameSizes) {
+    for (const CpuTier& tier : kCpuTiers) {
+      if (tier.required && !TestCpuFlag(tier.required)) {
+        continue;
+      }
+      std::string full_name =
+          std::string(name) + "/" + size.name + "/" + tier.name;
+      benchmark::RegisterBenchmark(full_name.c_str(), RunFrameBenchmark,
+                                   function, size.width, size.height,
+                                   tier.mask)
+          ->Unit(benchmark::kMicrosecond);
+    }
+  }
+}
+
+void SetFrameCounters(benchmark::State& state, int64_t pixels, int64_t bytes) {
+  state.counters["pixels"] =
+      benchmark::Counter(static_cast<double>(pixels),
+                         benchmark::Counter::kIsIterationInvariantRate,
+                         benchmark::Counter::kIs1000);
+  state.counters["bytes"] =
+      benchmark::Counter(static_cast<double>(bytes),
+                         benchmark::Counter::kIsIterationInvariantRate,
+                         benchmark::Counter::kIs1000);
+}
+
+BenchmarkBuffer::BenchmarkBuffer(size_t size) {
+  size_t i;
+  uint32_t seed = 1234;
+  mem_ = static_cast<uint8_t*>(malloc(size + 63));
+  data_ = reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(mem_) + 63) & ~static_cast<uintptr_t>(63));
+  for (i = 0; i < size; ++i) {
+    seed = seed * 214013u + 2531011u;
+    data_[i] = static_cast<uint8_t>(seed >> 16);
+  }
+}
+
+BenchmarkBuffer::~BenchmarkBuffer() {
+  free(mem_);
+}
+
+}  // namespace libyuv
+
+int main(int argc, char** argv) {
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  libyuv::RegisterCompareBenchmarks();
+  libyuv::RegisterConvertBenchmarks();
+  libyuv::RegisterMjpegBenchmarks();
+  libyuv::RegisterRotateBenchmarks();
+  libyuv::RegisterScaleBenchmarks();
+  benchmark::AddCustomContext("libyuv_version",
+                              std::to_string(LIBYUV_VERSION));
+  benchmark::AddCustomContext("libyuv_cpu_flags",
+                              std::to_string(libyuv::TestCpuFlag(-1)));
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
@@ -0,0 +1,60 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef BENCHMARK_LIBYUV_BENCHMARK_H_  // NOLINT
+#define BENCHMARK_LIBYUV_BENCHMARK_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include <benchmark/benchmark.h>
+
+namespace libyuv {
+
+// Benchmarks one frame operation.  width and height are the frame size the
+// benchmark is named for; for scaling up that is the destination size, and
+// otherwise the source size.
+typedef void (*FrameBenchmark)(benchmark::State& state, int width, int height);
+
+// Registers function as "name/<size>/<cpu>" for 480p, 1080p and 4K frames and
+// for each CPU tier this CPU has, from C alone up to all of its SIMD.  The CPU
+// flags are masked with MaskCpuFlags while the benchmark runs.
+void RegisterFrameBenchmark(const char* name, FrameBenchmark function);
+
+// Reports throughput as "pixels" and "bytes" counters per second, from the
+// pixels and the bytes read and written by one iteration.  They print with
+// 1000 based units, so 1.2G/s bytes is 1.2 GB/s.
+void SetFrameCounters(benchmark::State& state, int64_t pixels, int64_t bytes);
+
+// 64 byte aligned buffer of pseudo random bytes.
+class BenchmarkBuffer {
+ public:
+  explicit BenchmarkBuffer(size_t size);
+  ~BenchmarkBuffer();
+
+  uint8_t* get() const { return data_; }
+
+ private:
+  BenchmarkBuffer(const BenchmarkBuffer&);
+  void operator=(const BenchmarkBuffer&);
+
+  uint8_t* mem_;
+  uint8_t* data_;
+};
+
+void RegisterCompareBenchmarks();
+void RegisterConvertBenchmarks();
+void RegisterMjpegBenchmarks();
+void RegisterRotateBenchmarks();
+void RegisterScaleBenchmarks();
+
+}  // namespace libyuv
+
+#endif  // BENCHMARK_LIBYUV_BENCHMARK_H_  NOLINT
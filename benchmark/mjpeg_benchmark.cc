@@ -0,0 +1,265 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "../benchmark/libyuv_benchmark.h"
+
+#ifdef HAVE_JPEG
+#include <stdio.h>  // For jpeglib.h.
+#include <stdlib.h>
+
+#include <string>
+#include <vector>
+
+#include "libyuv/convert.h"
+extern "C" {
+#include <jpeglib.h>
+}
+#endif
+
+namespace libyuv {
+
+#ifdef HAVE_JPEG
+// A 4:2:0 JPEG of a width x height RGB image.
+class BenchmarkJpeg {
+ public:
+  BenchmarkJpeg(const uint8_t* src_rgb, int width, int height)
+      : data_(NULL), size_(0) {
+    jpeg_compress_struct cinfo;
+    jpeg_error_mgr jerr;
+    unsigned long size = 0;  // NOLINT
+    int y;
+    cinfo.err = jpeg_std_error(&jerr);
+    jpeg_create_compress(&cinfo);
+    jpeg_mem_dest(&cinfo, &data_, &size);
+    cinfo.image_width = width;
+    cinfo.image_height = height;
+    cinfo.input_components = 3;
+    cinfo.in_color_space = JCS_RGB;
+    jpeg_set_defaults(&cinfo);
+    jpeg_set_quality(&cinfo, 90, TRUE);
+    jpeg_start_compress(&cinfo, TRUE);
+    for (y = 0; y < height; ++y) {
+      JSAMPROW row = const_cast<uint8_t*>(src_rgb + y * width * 3);
+      jpeg_write_scanlines(&cinfo, &row, 1);
+    }
+    jpeg_finish_compress(&cinfo);
+    jpeg_destroy_compress(&cinfo);
+    size_ = size;
+  }
+  ~BenchmarkJpeg() { free(data_); }
+
+  const uint8_t* data() const { return data_; }
+  size_t size() const { return size_; }
+
+ private:
+  BenchmarkJpeg(const BenchmarkJpeg&);
+  void operator=(const BenchmarkJpeg&);
+
+  uint8_t* data_;
+  size_t size_;
+};
+
+// A smooth image, so that the JPEG compresses like a camera frame rather than
+// like noise.
+static void FillGradient(uint8_t* dst_rgb, int width, int height) {
+  int x, y;
+  for (y = 0; y < height; ++y) {
+    for (x = 0; x < width; ++x) {
+      uint8_t* p = dst_rgb + (y * width + x) * 3;
+      p[0] = static_cast<uint8_t>(x * 255 / width);
+      p[1] = static_cast<uint8_t>(y * 255 / height);
+      p[2] = static_cast<uint8_t>(((x / 32 + y / 32) & 1) * 128 + (x ^ y));
+    }
+  }
+}
+
+// Reports the heap allocations a MJPGDecoder made as "allocs" per iteration.
+// Only the first frame of a size and format should allocate.
+static void SetAllocationCounter(benchmark::State& state, int allocations) {
+  state.counters["allocs"] =
+      benchmark::Counter(static_cast<double>(allocations),
+                         benchmark::Counter::kAvgIterations);
+}
+
+// decoder is NULL to decode with MJPGToI420, which sets up a decoder on each
+// call, or a MJPGDecoder to reuse.
+static void DecodeBenchmark(benchmark::State& state,
+                            int width,
+                            int height,
+                            MJPGDecoder* decoder) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_rgb(width * 3 * height);
+  FillGradient(src_rgb.get(), width, height);
+  BenchmarkJpeg jpeg(src_rgb.get(), width, height);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  int allocations = 0;
+  if (decoder) {
+    // The first frame sets up the decoder, so is not counted.
+    MJPGDecoderToI420(decoder, jpeg.data(), jpeg.size(), dst_y.get(), width,
+                      dst_u.get(), halfwidth, dst_v.get(), halfwidth, width,
+                      height, width, height);
+    allocations = MJPGDecoderAllocationCount(decoder);
+  }
+  for (auto _ : state) {
+    int ret;
+    if (decoder) {
+      ret = MJPGDecoderToI420(decoder, jpeg.data(), jpeg.size(), dst_y.get(),
+                              width, dst_u.get(), halfwidth, dst_v.get(),
+                              halfwidth, width, height, width, height);
+    } else {
+      ret = MJPGToI420(jpeg.data(), jpeg.size(), dst_y.get(), width,
+                       dst_u.get(), halfwidth, dst_v.get(), halfwidth, width,
+                       height, width, height);
+    }
+    if (ret != 0) {
+      state.SkipWithError("MJPG decode failed");
+      break;
+    }
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(jpeg.size()) +
+                       static_cast<int64_t>(width) * height +
+                       static_cast<int64_t>(halfwidth) * halfheight * 2);
+  if (decoder) {
+    SetAllocationCounter(state,
+                         MJPGDecoderAllocationCount(decoder) - allocations);
+  }
+}
+
+static void MJPGToI420Benchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  DecodeBenchmark(state, width, height, NULL);
+}
+
+static void MJPGDecoderToI420Benchmark(benchmark::State& state,
+                                       int width,
+                                       int height) {
+  MJPGDecoder* decoder = MJPGDecoderCreate();
+  DecodeBenchmark(state, width, height, decoder);
+  MJPGDecoderFree(decoder);
+}
+
+// The frames of unit_test/testdata, read relative to the working directory.
+static const int kTestdataFrames = 5;
+
+struct TestdataFrame {
+  std::string jpeg;
+  int width;
+  int height;
+};
+
+static bool ReadTestdataFrame(int n, TestdataFrame* frame) {
+  char path[64];
+  char buf[4096];
+  size_t size;
+  FILE* file;
+  snprintf(path, sizeof(path), "unit_test/testdata/test%d.jpg", n);
+  file = fopen(path, "rb");
+  if (!file) {
+    return false;
+  }
+  frame->jpeg.clear();
+  while ((size = fread(buf, 1, sizeof(buf), file)) > 0) {
+    frame->jpeg.append(buf, size);
+  }
+  fclose(file);
+  return MJPGSize(reinterpret_cast<const uint8_t*>(frame->jpeg.data()),
+                  frame->jpeg.size(), &frame->width, &frame->height) == 0;
+}
+
+static int DecodeTestdataFrame(MJPGDecoder* decoder,
+                               const TestdataFrame& frame,
+                               uint8_t* dst_y,
+                               uint8_t* dst_u,
+                               uint8_t* dst_v) {
+  const int halfwidth = (frame.width + 1) / 2;
+  return MJPGDecoderToI420(
+      decoder, reinterpret_cast<const uint8_t*>(frame.jpeg.data()),
+      frame.jpeg.size(), dst_y, frame.width, dst_u, halfwidth, dst_v,
+      halfwidth, frame.width, frame.height, frame.width, frame.height);
+}
+
+// Decode the testdata frames in turn with one MJPGDecoder, as a stream of
+// frames of mixed formats.  Frames that MJPGDecoderToI420 does not support,
+// such as progressive JPEG, are left out.  Run from the libyuv directory.
+static void MJPGDecoderTestdataBenchmark(benchmark::State& state) {
+  std::vector<TestdataFrame> frames;
+  size_t max_size = 0;
+  int64_t pixels = 0;
+  int64_t bytes = 0;
+  int allocations;
+  size_t i;
+  int n;
+  for (n = 0; n < kTestdataFrames; ++n) {
+    TestdataFrame frame;
+    if (!ReadTestdataFrame(n, &frame)) {
+      state.SkipWithError("unit_test/testdata not found");
+      return;
+    }
+    if (static_cast<size_t>(frame.width) * frame.height > max_size) {
+      max_size = static_cast<size_t>(frame.width) * frame.height;
+    }
+    frames.push_back(frame);
+  }
+  BenchmarkBuffer dst_y(max_size);
+  BenchmarkBuffer dst_u(max_size);
+  BenchmarkBuffer dst_v(max_size);
+  MJPGDecoder* decoder = MJPGDecoderCreate();
+  // The first pass over the frames sets up the decoder, so is not counted.
+  for (i = 0; i < frames.size();) {
+    if (DecodeTestdataFrame(decoder, frames[i], dst_y.get(), dst_u.get(),
+                            dst_v.get()) != 0) {
+      frames.erase(frames.begin() + i);
+      continue;
+    }
+    pixels += static_cast<int64_t>(frames[i].width) * frames[i].height;
+    bytes += static_cast<int64_t>(frames[i].jpeg.size()) +
+             static_cast<int64_t>(frames[i].width) * frames[i].height +
+             static_cast<int64_t>((frames[i].width + 1) / 2) *
+                 ((frames[i].height + 1) / 2) * 2;
+    ++i;
+  }
+  if (frames.empty()) {
+    state.SkipWithError("No testdata frame decodes");
+    MJPGDecoderFree(decoder);
+    return;
+  }
+  allocations = MJPGDecoderAllocationCount(decoder);
+  for (auto _ : state) {
+    for (i = 0; i < frames.size(); ++i) {
+      if (DecodeTestdataFrame(decoder, frames[i], dst_y.get(), dst_u.get(),
+                              dst_v.get()) != 0) {
+        state.SkipWithError("MJPG decode failed");
+        break;
+      }
+    }
+  }
+  SetFrameCounters(state, pixels, bytes);
+  SetAllocationCounter(state,
+                       MJPGDecoderAllocationCount(decoder) - allocations);
+  MJPGDecoderFree(decoder);
+}
+#endif  // HAVE_JPEG
+
+void RegisterMjpegBenchmarks() {
+#ifdef HAVE_JPEG
+  RegisterFrameBenchmark("MJPGToI420", MJPGToI420Benchmark);
+  RegisterFrameBenchmark("MJPGDecoderToI420", MJPGDecoderToI420Benchmark);
+  benchmark::RegisterBenchmark("MJPGDecoderTestdata",
+                               MJPGDecoderTestdataBenchmark)
+      ->Unit(benchmark::kMicrosecond);
+#endif
+}
+
+}  // namespace libyuv
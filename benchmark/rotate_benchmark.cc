@@ -0,0 +1,89 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "../benchmark/libyuv_benchmark.h"
+#include "libyuv/rotate.h"
+#include "libyuv/rotate_argb.h"
+
+namespace libyuv {
+
+// Destination stride of a width x height plane rotated by mode.
+static int RotatedStride(int width, int height, RotationMode mode) {
+  return (mode == kRotate90 || mode == kRotate270) ? height : width;
+}
+
+template <RotationMode mode>
+static void I420RotateBenchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  const int dst_stride_y = RotatedStride(width, height, mode);
+  const int dst_stride_uv = RotatedStride(halfwidth, halfheight, mode);
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_u(halfwidth * halfheight);
+  BenchmarkBuffer src_v(halfwidth * halfheight);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  for (auto _ : state) {
+    I420Rotate(src_y.get(), width, src_u.get(), halfwidth, src_v.get(),
+               halfwidth, dst_y.get(), dst_stride_y, dst_u.get(),
+               dst_stride_uv, dst_v.get(), dst_stride_uv, width, height, mode);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   (static_cast<int64_t>(width) * height +
+                    static_cast<int64_t>(halfwidth) * halfheight * 2) *
+                       2);
+}
+
+static void NV12ToI420Rotate90Benchmark(benchmark::State& state,
+                                        int width,
+                                        int height) {
+  const int halfwidth = (width + 1) / 2;
+  const int halfheight = (height + 1) / 2;
+  BenchmarkBuffer src_y(width * height);
+  BenchmarkBuffer src_uv(halfwidth * 2 * halfheight);
+  BenchmarkBuffer dst_y(width * height);
+  BenchmarkBuffer dst_u(halfwidth * halfheight);
+  BenchmarkBuffer dst_v(halfwidth * halfheight);
+  for (auto _ : state) {
+    NV12ToI420Rotate(src_y.get(), width, src_uv.get(), halfwidth * 2,
+                     dst_y.get(), height, dst_u.get(), halfheight, dst_v.get(),
+                     halfheight, width, height, kRotate90);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   (static_cast<int64_t>(width) * height +
+                    static_cast<int64_t>(halfwidth) * halfheight * 2) *
+                       2);
+}
+
+template <RotationMode mode>
+static void ARGBRotateBenchmark(benchmark::State& state,
+                                int width,
+                                int height) {
+  BenchmarkBuffer src_argb(width * 4 * height);
+  BenchmarkBuffer dst_argb(width * 4 * height);
+  for (auto _ : state) {
+    ARGBRotate(src_argb.get(), width * 4, dst_argb.get(),
+               RotatedStride(width, height, mode) * 4, width, height, mode);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(width) * height * 8);
+}
+
+void RegisterRotateBenchmarks() {
+  RegisterFrameBenchmark("I420Rotate90", I420RotateBenchmark<kRotate90>);
+  RegisterFrameBenchmark("I420Rotate180", I420RotateBenchmark<kRotate180>);
+  RegisterFrameBenchmark("NV12ToI420Rotate90", NV12ToI420Rotate90Benchmark);
+  RegisterFrameBenchmark("ARGBRotate90", ARGBRotateBenchmark<kRotate90>);
+}
+
+}  // namespace libyuv
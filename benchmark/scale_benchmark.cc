@@ -0,0 +1,131 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "../benchmark/libyuv_benchmark.h"
+#include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+
+namespace libyuv {
+
+// Scales by kNum / kDen.  The frame size is the larger of the source and the
+// destination.
+template <int kNum, int kDen>
+static void ScaleSizes(int width,
+                       int height,
+                       int* src_width,
+                       int* src_height,
+                       int* dst_width,
+                       int* dst_height) {
+  if (kNum > kDen) {
+    *src_width = width * kDen / kNum;
+    *src_height = height * kDen / kNum;
+    *dst_width = width;
+    *dst_height = height;
+  } else {
+    *src_width = width;
+    *src_height = height;
+    *dst_width = width * kNum / kDen;
+    *dst_height = height * kNum / kDen;
+  }
+}
+
+// Bytes of an I420 or NV12 frame.
+static int64_t YUV420Size(int width, int height) {
+  return static_cast<int64_t>(width) * height +
+         static_cast<int64_t>((width + 1) / 2) * ((height + 1) / 2) * 2;
+}
+
+template <int kNum, int kDen, FilterMode filter>
+static void I420ScaleBenchmark(benchmark::State& state,
+                               int width,
+                               int height) {
+  int src_width, src_height, dst_width, dst_height;
+  ScaleSizes<kNum, kDen>(width, height, &src_width, &src_height, &dst_width,
+                         &dst_height);
+  const int src_halfwidth = (src_width + 1) / 2;
+  const int src_halfheight = (src_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  BenchmarkBuffer src_y(src_width * src_height);
+  BenchmarkBuffer src_u(src_halfwidth * src_halfheight);
+  BenchmarkBuffer src_v(src_halfwidth * src_halfheight);
+  BenchmarkBuffer dst_y(dst_width * dst_height);
+  BenchmarkBuffer dst_u(dst_halfwidth * dst_halfheight);
+  BenchmarkBuffer dst_v(dst_halfwidth * dst_halfheight);
+  for (auto _ : state) {
+    I420Scale(src_y.get(), src_width, src_u.get(), src_halfwidth, src_v.get(),
+              src_halfwidth, src_width, src_height, dst_y.get(), dst_width,
+              dst_u.get(), dst_halfwidth, dst_v.get(), dst_halfwidth,
+              dst_width, dst_height, filter);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   YUV420Size(src_width, src_height) +
+                       YUV420Size(dst_width, dst_height));
+}
+
+template <int kNum, int kDen, FilterMode filter>
+static void NV12ScaleBenchmark(benchmark::State& state,
+                               int width,
+                               int height) {
+  int src_width, src_height, dst_width, dst_height;
+  ScaleSizes<kNum, kDen>(width, height, &src_width, &src_height, &dst_width,
+                         &dst_height);
+  const int src_halfwidth = (src_width + 1) / 2;
+  const int src_halfheight = (src_height + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  const int dst_halfheight = (dst_height + 1) / 2;
+  BenchmarkBuffer src_y(src_width * src_height);
+  BenchmarkBuffer src_uv(src_halfwidth * 2 * src_halfheight);
+  BenchmarkBuffer dst_y(dst_width * dst_height);
+  BenchmarkBuffer dst_uv(dst_halfwidth * 2 * dst_halfheight);
+  for (auto _ : state) {
+    NV12Scale(src_y.get(), src_width, src_uv.get(), src_halfwidth * 2,
+              src_width, src_height, dst_y.get(), dst_width, dst_uv.get(),
+              dst_halfwidth * 2, dst_width, dst_height, filter);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   YUV420Size(src_width, src_height) +
+                       YUV420Size(dst_width, dst_height));
+}
+
+template <int kNum, int kDen, FilterMode filter>
+static void ARGBScaleBenchmark(benchmark::State& state,
+                               int width,
+                               int height) {
+  int src_width, src_height, dst_width, dst_height;
+  ScaleSizes<kNum, kDen>(width, height, &src_width, &src_height, &dst_width,
+                         &dst_height);
+  BenchmarkBuffer src_argb(src_width * 4 * src_height);
+  BenchmarkBuffer dst_argb(dst_width * 4 * dst_height);
+  for (auto _ : state) {
+    ARGBScale(src_argb.get(), src_width * 4, src_width, src_height,
+              dst_argb.get(), dst_width * 4, dst_width, dst_height, filter);
+  }
+  SetFrameCounters(state, static_cast<int64_t>(width) * height,
+                   static_cast<int64_t>(src_width) * src_height * 4 +
+                       static_cast<int64_t>(dst_width) * dst_height * 4);
+}
+
+void RegisterScaleBenchmarks() {
+  RegisterFrameBenchmark("I420ScaleDown2_Box",
+                         I420ScaleBenchmark<1, 2, kFilterBox>);
+  RegisterFrameBenchmark("I420ScaleDown3by4_Bilinear",
+                         I420ScaleBenchmark<3, 4, kFilterBilinear>);
+  RegisterFrameBenchmark("I420ScaleUp2_Bilinear",
+                         I420ScaleBenchmark<2, 1, kFilterBilinear>);
+  RegisterFrameBenchmark("NV12ScaleDown2_Bilinear",
+                         NV12ScaleBenchmark<1, 2, kFilterBilinear>);
+  RegisterFrameBenchmark("ARGBScaleDown2_Bilinear",
+                         ARGBScaleBenchmark<1, 2, kFilterBilinear>);
+  RegisterFrameBenchmark("ARGBScaleUp2_Bilinear",
+                         ARGBScaleBenchmark<2, 1, kFilterBilinear>);
+}
+
+}  // namespace libyuv
@@ -20,6 +20,7 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/mjpeg_decoder.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/profile.h"
 #include "libyuv/rotate.h"
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
@@ -27,6 +28,7 @@
 #include "libyuv/scale_argb.h"
 #include "libyuv/scale_row.h"
 #include "libyuv/scale_uv.h"
+#include "libyuv/slice.h"
 #include "libyuv/version.h"
 #include "libyuv/video_common.h"
 
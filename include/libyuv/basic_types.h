@@ -60,6 +60,44 @@ typedef int8_t int8;
 #endif  // __GNUC__
 #endif  // LIBYUV_API
 
+// Job callback for threaded functions.  Processes job number index.
+typedef void (*LibyuvJobFunc)(void* job_opaque, int index);
+
+// Caller supplied dispatcher for threaded functions.  Must call
+// job(job_opaque, i) exactly once for each i in [0, num_jobs), on any thread
+// and in any order, and return only after all of the calls have completed.
+typedef void (*LibyuvDispatchFunc)(void* dispatch_opaque,
+                                   LibyuvJobFunc job,
+                                   void* job_opaque,
+                                   int num_jobs);
+
+// Caller owned scratch memory for the _WithScratch functions.
+// Create one per thread, sized with the matching ScratchSize function, and
+// reuse it across calls to avoid allocating row buffers on every call.
+// Functions fall back to malloc if the scratch is NULL or too small.
+typedef struct LibyuvScratch {
+  uint8_t* buffer;
+  size_t size;
+} LibyuvScratch;
+
+// One image of a batch for the Batch functions.  Formats with fewer than 3
+// planes use the first entries of data and stride and ignore the rest.
+// A negative height inverts the image.
+typedef struct LibyuvFrame {
+  uint8_t* data[3];
+  int stride[3];
+  int width;
+  int height;
+} LibyuvFrame;
+
+// A source image of a batch, which the Batch functions only read.
+typedef struct LibyuvConstFrame {
+  const uint8_t* data[3];
+  int stride[3];
+  int width;
+  int height;
+} LibyuvConstFrame;
+
 // TODO(fbarchard): Remove bool macros.
 #define LIBYUV_BOOL int
 #define LIBYUV_FALSE 0
@@ -103,6 +103,51 @@ double I420Ssim(const uint8_t* src_y_a,
                 int width,
                 int height);
 
+// Threaded variants of I420Psnr and I420Ssim.
+// Each plane is split into up to num_jobs horizontal bands which are measured
+// as independent jobs through the caller supplied dispatch function.  Partial
+// results are reduced in a fixed order, so the result is identical to the
+// single threaded functions.  If dispatch is NULL or num_jobs is 1 or less,
+// the measurement runs on the calling thread.
+
+LIBYUV_API
+double I420PsnrThreaded(const uint8_t* src_y_a,
+                        int stride_y_a,
+                        const uint8_t* src_u_a,
+                        int stride_u_a,
+                        const uint8_t* src_v_a,
+                        int stride_v_a,
+                        const uint8_t* src_y_b,
+                        int stride_y_b,
+                        const uint8_t* src_u_b,
+                        int stride_u_b,
+                        const uint8_t* src_v_b,
+                        int stride_v_b,
+                        int width,
+                        int height,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque);
+
+LIBYUV_API
+double I420SsimThreaded(const uint8_t* src_y_a,
+                        int stride_y_a,
+                        const uint8_t* src_u_a,
+                        int stride_u_a,
+                        const uint8_t* src_v_a,
+                        int stride_v_a,
+                        const uint8_t* src_y_b,
+                        int stride_y_b,
+                        const uint8_t* src_u_b,
+                        int stride_u_b,
+                        const uint8_t* src_v_b,
+                        int stride_v_b,
+                        int width,
+                        int height,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -45,6 +45,13 @@ extern "C" {
 #endif  // clang >= 3.4
 #endif  // __clang__
 
+// GCC >= 4.7.0 required for AVX2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ > 4) || (__GNUC__ == 4 && (__GNUC_MINOR__ >= 7))
+#define GCC_HAS_AVX2 1
+#endif  // GNUC >= 4.7
+#endif  // __GNUC__
+
 // The following are available for Visual C and GCC:
 #if !defined(LIBYUV_DISABLE_X86) && \
     (defined(__x86_64__) || defined(__i386__) || defined(_M_IX86))
@@ -73,6 +80,18 @@ extern "C" {
 #define HAS_HAMMINGDISTANCE_AVX2
 #endif
 
+// The following are available for GCC and clang:
+#if !defined(LIBYUV_DISABLE_X86) && \
+    (defined(__x86_64__) || defined(__i386__))
+#define HAS_SSIM8X8_SSE41
+#endif
+
+#if !defined(LIBYUV_DISABLE_X86) &&                 \
+    (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SSIM8X8_AVX2
+#endif
+
 // The following are available for Neon:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
@@ -80,6 +99,10 @@ extern "C" {
 #define HAS_HAMMINGDISTANCE_NEON
 #endif
 
+#if !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
+#define HAS_SSIM8X8_NEON
+#endif
+
 #if !defined(LIBYUV_DISABLE_MSA) && defined(__mips_msa)
 #define HAS_HAMMINGDISTANCE_MSA
 #define HAS_SUMSQUAREERROR_MSA
@@ -130,6 +153,29 @@ uint32_t SumSquareError_MMI(const uint8_t* src_a,
                             const uint8_t* src_b,
                             int count);
 
+// SSIM of an 8x8 block from the sums of its pixels, squares and products.
+double Ssim8x8FromSums(int sum_a,
+                       int sum_b,
+                       int sum_sq_a,
+                       int sum_sq_b,
+                       int sum_axb);
+double Ssim8x8_C(const uint8_t* src_a,
+                 int stride_a,
+                 const uint8_t* src_b,
+                 int stride_b);
+double Ssim8x8_SSE41(const uint8_t* src_a,
+                     int stride_a,
+                     const uint8_t* src_b,
+                     int stride_b);
+double Ssim8x8_AVX2(const uint8_t* src_a,
+                    int stride_a,
+                    const uint8_t* src_b,
+                    int stride_b);
+double Ssim8x8_NEON(const uint8_t* src_a,
+                    int stride_a,
+                    const uint8_t* src_b,
+                    int stride_b);
+
 uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed);
 uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed);
 uint32_t HashDjb2_AVX2(const uint8_t* src, int count, uint32_t seed);
@@ -14,6 +14,7 @@
 #include "libyuv/basic_types.h"
 
 #include "libyuv/rotate.h"  // For enum RotationMode.
+#include "libyuv/scale.h"   // For enum FilterMode.
 
 // TODO(fbarchard): fix WebRTC source to include following libyuv headers:
 #include "libyuv/convert_argb.h"      // For WebRTC I420ToARGB. b/620
@@ -193,6 +194,69 @@ int I010ToI420(const uint16_t* src_y,
                int width,
                int height);
 
+// Convert BT.2020 limited range 10 bit YUV with PQ or HLG transfer to SDR
+// BT.709 limited range 8 bit YUV.  See InitToneMapConstants() in
+// convert_argb.h for building the tone mapping tables.
+LIBYUV_API
+int I010ToI420ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
+LIBYUV_API
+int I010ToNV12ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
+LIBYUV_API
+int P010ToI420ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
+LIBYUV_API
+int P010ToNV12ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
 #define H210ToH422 I210ToI422
 LIBYUV_API
 int I210ToI422(const uint16_t* src_y,
@@ -472,6 +536,37 @@ int NV21ToI420(const uint8_t* src_y,
                int width,
                int height);
 
+// Convert MM21 to NV12.  MM21 is NV12 stored in tiles by MediaTek and other
+// hardware decoders.  Y tiles are 16x32 and UV tiles are 16x16 bytes.
+// src_stride_y and src_stride_uv are the row strides of the tiled planes,
+// typically the width aligned to 16.
+LIBYUV_API
+int MM21ToNV12(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height);
+
+// Convert MM21 to I420.
+LIBYUV_API
+int MM21ToI420(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_u,
+               int dst_stride_u,
+               uint8_t* dst_v,
+               int dst_stride_v,
+               int width,
+               int height);
+
 // Convert NV12 to NV24.
 LIBYUV_API
 int NV12ToNV24(const uint8_t* src_y,
@@ -615,6 +710,17 @@ int ARGBToI420(const uint8_t* src_argb,
                int width,
                int height);
 
+// Convert a batch of ARGB frames to I420.  src_frames[i] uses plane 0 and
+// its size, and dst_frames[i] uses 3 planes and ignores its size.  See
+// I420ToARGBMatrixBatch for how the batch is split into jobs.
+LIBYUV_API
+int ARGBToI420Batch(const LibyuvConstFrame* src_frames,
+                    const LibyuvFrame* dst_frames,
+                    int num_frames,
+                    int num_jobs,
+                    LibyuvDispatchFunc dispatch,
+                    void* dispatch_opaque);
+
 // BGRA little endian (argb in memory) to I420.
 LIBYUV_API
 int BGRAToI420(const uint8_t* src_bgra,
@@ -667,6 +773,35 @@ int RGB24ToI420(const uint8_t* src_rgb24,
                 int width,
                 int height);
 
+// RGB24ToI420 using a caller supplied scratch for its row buffers.
+// RGB24ToI420ScratchSize returns the scratch size in bytes it needs.
+LIBYUV_API
+int RGB24ToI420ScratchSize(int width);
+
+LIBYUV_API
+int RGB24ToI420_WithScratch(const uint8_t* src_rgb24,
+                            int src_stride_rgb24,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int width,
+                            int height,
+                            const LibyuvScratch* scratch);
+
+// RGB little endian (bgr in memory) to NV12.
+LIBYUV_API
+int RGB24ToNV12(const uint8_t* src_rgb24,
+                int src_stride_rgb24,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_uv,
+                int dst_stride_uv,
+                int width,
+                int height);
+
 // RGB little endian (bgr in memory) to J420.
 LIBYUV_API
 int RGB24ToJ420(const uint8_t* src_rgb24,
@@ -693,6 +828,35 @@ int RAWToI420(const uint8_t* src_raw,
               int width,
               int height);
 
+// RAWToI420 using a caller supplied scratch for its row buffers.
+// RAWToI420ScratchSize returns the scratch size in bytes it needs.
+LIBYUV_API
+int RAWToI420ScratchSize(int width);
+
+LIBYUV_API
+int RAWToI420_WithScratch(const uint8_t* src_raw,
+                          int src_stride_raw,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int width,
+                          int height,
+                          const LibyuvScratch* scratch);
+
+// RGB big endian (rgb in memory) to NV12.
+LIBYUV_API
+int RAWToNV12(const uint8_t* src_raw,
+              int src_stride_raw,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_uv,
+              int dst_stride_uv,
+              int width,
+              int height);
+
 // RGB big endian (rgb in memory) to J420.
 LIBYUV_API
 int RAWToJ420(const uint8_t* src_raw,
@@ -805,6 +969,26 @@ int MJPGToNV12(const uint8_t* sample,
                int dst_width,
                int dst_height);
 
+// JPEG to NV12 scaled to dst_width x dst_height and rotated, in one pass.
+// dst_width and dst_height are the size after rotation.  The frame is decoded
+// with the largest DCT scale factor (1/2, 1/4 or 1/8) that does not go below
+// the destination size, and the remaining scale is done with ScalePlane
+// filtering as each MCU row is decoded, so only a few rows of each plane are
+// held in memory rather than a full size frame.
+LIBYUV_API
+int MJPGScaleToNV12(const uint8_t* sample,
+                    size_t sample_size,
+                    uint8_t* dst_y,
+                    int dst_stride_y,
+                    uint8_t* dst_uv,
+                    int dst_stride_uv,
+                    int src_width,
+                    int src_height,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    enum RotationMode rotation);
+
 // Query size of MJPG in pixels.
 LIBYUV_API
 int MJPGSize(const uint8_t* sample,
@@ -812,6 +996,82 @@ int MJPGSize(const uint8_t* sample,
              int* width,
              int* height);
 
+// A MJPGDecoder decodes the frames of a MJPEG stream, keeping the jpeg decoder
+// state and its buffers between frames.  Once a frame of a given size and
+// format has been decoded, following frames like it are decoded without
+// allocating memory, which the MJPGTo functions do on every call.  A decoder
+// may be used by one thread at a time.  MJPGDecoderToARGB is in
+// convert_argb.h.
+typedef struct MJPGDecoder MJPGDecoder;
+
+LIBYUV_API
+MJPGDecoder* MJPGDecoderCreate(void);
+
+LIBYUV_API
+void MJPGDecoderFree(MJPGDecoder* decoder);
+
+// Number of heap allocations the decoder has made since it was created.
+LIBYUV_API
+int MJPGDecoderAllocationCount(MJPGDecoder* decoder);
+
+// Same as MJPGToI420, MJPGToNV21, MJPGToNV12 and MJPGScaleToNV12, decoding
+// with a MJPGDecoder.
+LIBYUV_API
+int MJPGDecoderToI420(MJPGDecoder* decoder,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
+LIBYUV_API
+int MJPGDecoderToNV21(MJPGDecoder* decoder,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_vu,
+                      int dst_stride_vu,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
+LIBYUV_API
+int MJPGDecoderToNV12(MJPGDecoder* decoder,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
+LIBYUV_API
+int MJPGDecoderScaleToNV12(MJPGDecoder* decoder,
+                           const uint8_t* sample,
+                           size_t sample_size,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           enum RotationMode rotation);
+
 // Convert camera sample to I420 with cropping, rotation and vertical flip.
 // "src_size" is needed to parse MJPG.
 // "dst_stride_y" number of bytes in a row of the dst_y plane.
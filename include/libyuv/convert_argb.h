@@ -14,6 +14,7 @@
 #include "libyuv/basic_types.h"
 
 #include "libyuv/rotate.h"  // For enum RotationMode.
+#include "libyuv/scale.h"   // For enum FilterMode.
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -687,6 +688,17 @@ int NV12ToARGB(const uint8_t* src_y,
                int width,
                int height);
 
+// Convert MM21 (tiled NV12, see MM21ToNV12) to ARGB.
+LIBYUV_API
+int MM21ToARGB(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_argb,
+               int dst_stride_argb,
+               int width,
+               int height);
+
 // Convert NV21 to ARGB.
 LIBYUV_API
 int NV21ToARGB(const uint8_t* src_y,
@@ -1113,6 +1125,20 @@ int MJPGToARGB(const uint8_t* sample,
                int dst_width,
                int dst_height);
 
+// MJPGToARGB decoding with a MJPGDecoder, which is declared in convert.h.
+struct MJPGDecoder;
+
+LIBYUV_API
+int MJPGDecoderToARGB(struct MJPGDecoder* decoder,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height);
+
 // Convert Android420 to ARGB.
 LIBYUV_API
 int Android420ToARGB(const uint8_t* src_y,
@@ -1466,6 +1492,35 @@ int I420ToARGBMatrix(const uint8_t* src_y,
                      int width,
                      int height);
 
+// Convert a batch of I420 frames to ARGB.  Meant for many small frames,
+// such as thumbnails and ML crops, where choosing row functions for each
+// call costs more than converting.  Row functions are chosen once for the
+// batch.  src_frames[i] uses 3 planes and its size, and dst_frames[i] uses
+// plane 0 and ignores its size.
+// The frames are split into up to num_jobs contiguous runs, which are
+// converted as independent jobs through the caller supplied dispatch
+// function.  If dispatch is NULL or num_jobs is 1 or less, the batch runs on
+// the calling thread.
+// Returns 0 on success, or -1 without converting anything if any frame is
+// invalid.
+LIBYUV_API
+int I420ToARGBMatrixBatch(const LibyuvConstFrame* src_frames,
+                          const LibyuvFrame* dst_frames,
+                          int num_frames,
+                          const struct YuvConstants* yuvconstants,
+                          int num_jobs,
+                          LibyuvDispatchFunc dispatch,
+                          void* dispatch_opaque);
+
+// Convert a batch of BT.601 I420 frames to ARGB.
+LIBYUV_API
+int I420ToARGBBatch(const LibyuvConstFrame* src_frames,
+                    const LibyuvFrame* dst_frames,
+                    int num_frames,
+                    int num_jobs,
+                    LibyuvDispatchFunc dispatch,
+                    void* dispatch_opaque);
+
 // Convert I422 to ARGB with matrix.
 LIBYUV_API
 int I422ToARGBMatrix(const uint8_t* src_y,
@@ -1673,6 +1728,79 @@ int P210ToAR30Matrix(const uint16_t* src_y,
 // Convert P216 to AR30 with matrix.
 #define P216ToAR30Matrix P210ToAR30Matrix
 
+// HDR transfer functions for the ToneMap conversions.
+// The HLG OOTF raises each of R, G and B to the system gamma, instead of
+// scaling all three by Y_s^(gamma - 1) of the scene luminance Y_s as BT.2100
+// defines it.  The tables are per channel.  The two agree on greys, but
+// saturated colours come out more saturated than on a BT.2100 display.
+enum HdrTransfer {
+  kHdrTransferPQ = 0,   // SMPTE ST 2084 Perceptual Quantizer (HDR10).
+  kHdrTransferHLG = 1,  // ARIB STD-B67 Hybrid Log-Gamma.
+};
+
+// Curves that compress HDR highlights into the SDR range.
+enum ToneMapCurve {
+  kToneMapClip = 0,      // Clip everything brighter than SDR white.
+  kToneMapReinhard = 1,  // Extended Reinhard. Peak maps to SDR white.
+  kToneMapHable = 2,     // Hable filmic curve, normalized to the peak.
+  kToneMapBT2390 = 3,    // ITU-R BT.2390 EETF hermite spline in PQ space.
+};
+
+// Lookup tables and matrix for converting BT.2020 PQ or HLG video to SDR
+// BT.709.  Fill with InitToneMapConstants() once and reuse for every frame.
+// Tone mapping is applied to each of R, G and B in BT.2020 linear light,
+// followed by the BT.2020 to BT.709 gamut matrix and the BT.709 OETF.
+// The AVX2 rows take about 5.5 cycles per pixel, bound by the 6 table
+// gathers of each pixel.  That is 4K60 on one core of 3 GHz or more.
+// On slower cores, convert slices of an even number of rows on 2 threads.
+struct ToneMapConstants {
+  int16_t kMatrix[6][16];  // BT.2020 to BT.709, 12 bit, pairs for pmaddwd.
+  uint16_t kLinear[1026];  // 10 bit R'G'B' to tone mapped linear, 14 bit.
+  uint8_t kGamma[4100];    // 12 bit linear to BT.709 OETF, 8 bit.
+};
+
+// Build tone mapping tables.
+// peak_nits is the brightest luminance of the content: the mastering display
+// peak for PQ, or the nominal display peak for HLG, which also sets the HLG
+// system gamma.  The gamma uses the peak clamped to the 400 to 2000 nits
+// that BT.2100 defines it for.  sdr_white_nits is the luminance that maps to
+// SDR white, typically 203 (ITU-R BT.2408 HDR reference white).
+// Returns 0 on success, -1 for invalid parameters.
+LIBYUV_API
+int InitToneMapConstants(struct ToneMapConstants* tonemap,
+                         enum HdrTransfer transfer,
+                         enum ToneMapCurve curve,
+                         int peak_nits,
+                         int sdr_white_nits);
+
+// Convert BT.2020 limited range P010 with PQ or HLG transfer to SDR BT.709
+// ARGB.
+LIBYUV_API
+int P010ToARGBToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
+// Convert BT.2020 limited range I010 with PQ or HLG transfer to SDR BT.709
+// ARGB.
+LIBYUV_API
+int I010ToARGBToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height);
+
 // Convert I420 with Alpha to preattenuated ARGB with matrix.
 LIBYUV_API
 int I420AlphaToARGBMatrix(const uint8_t* src_y,
@@ -1787,6 +1915,18 @@ int NV12ToARGBMatrix(const uint8_t* src_y,
                      int width,
                      int height);
 
+// Convert MM21 to ARGB with matrix.  Detiles one row at a time.
+LIBYUV_API
+int MM21ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height);
+
 // Convert NV21 to ARGB with matrix.
 LIBYUV_API
 int NV21ToARGBMatrix(const uint8_t* src_y,
@@ -1930,6 +2070,71 @@ int I400ToARGBMatrix(const uint8_t* src_y,
                      int width,
                      int height);
 
+// Element type and layout of RGB tensors for ML inference.  CHW stores the
+// R, G and B planes one after the other and HWC stores R, G and B of each
+// pixel together.  Half is IEEE half float, rounded toward zero.
+typedef enum RGBTensorFormat {
+  kTensorFloatCHW = 0,
+  kTensorFloatHWC = 1,
+  kTensorHalfCHW = 2,
+  kTensorHalfHWC = 3,
+} RGBTensorFormatEnum;
+
+// Convert ARGB to a dense dst_width x dst_height RGB tensor in one pass.
+// Each channel c, in R, G, B order, is stored as (value - mean[c]) * scale[c]
+// with value from 0 to 255.  A NULL mean is 0 and a NULL scale is 1 / 255.
+// If the destination size differs from the source, the image is resized in
+// the same pass, with point sampling for kFilterNone and bilinear filtering
+// for the other modes.
+LIBYUV_API
+int ARGBToRGBTensor(const uint8_t* src_argb,
+                    int src_stride_argb,
+                    int src_width,
+                    int src_height,
+                    void* dst_tensor,
+                    int dst_width,
+                    int dst_height,
+                    enum RGBTensorFormat format,
+                    const float* mean,
+                    const float* scale,
+                    enum FilterMode filtering);
+
+// Convert I420 to an RGB tensor with matrix.  See ARGBToRGBTensor.
+LIBYUV_API
+int I420ToRGBTensorMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          const struct YuvConstants* yuvconstants,
+                          int src_width,
+                          int src_height,
+                          void* dst_tensor,
+                          int dst_width,
+                          int dst_height,
+                          enum RGBTensorFormat format,
+                          const float* mean,
+                          const float* scale,
+                          enum FilterMode filtering);
+
+// Convert NV12 to an RGB tensor with matrix.  See ARGBToRGBTensor.
+LIBYUV_API
+int NV12ToRGBTensorMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          const struct YuvConstants* yuvconstants,
+                          int src_width,
+                          int src_height,
+                          void* dst_tensor,
+                          int dst_width,
+                          int dst_height,
+                          enum RGBTensorFormat format,
+                          const float* mean,
+                          const float* scale,
+                          enum FilterMode filtering);
+
 // Convert camera sample to ARGB with cropping, rotation and vertical flip.
 // "sample_size" is needed to parse MJPG.
 // "dst_stride_argb" number of bytes in a row of the dst_argb plane.
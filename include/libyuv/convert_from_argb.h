@@ -276,6 +276,23 @@ int ARGBToNV12(const uint8_t* src_argb,
                int width,
                int height);
 
+// ARGBToNV12 using a caller supplied scratch for its U and V rows.
+// ARGBToNV12ScratchSize returns the scratch size in bytes it needs.
+// ARGBToI420 writes its rows straight to the destination and needs none.
+LIBYUV_API
+int ARGBToNV12ScratchSize(int width);
+
+LIBYUV_API
+int ARGBToNV12_WithScratch(const uint8_t* src_argb,
+                           int src_stride_argb,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int width,
+                           int height,
+                           const LibyuvScratch* scratch);
+
 // Convert ARGB To NV21.
 LIBYUV_API
 int ARGBToNV21(const uint8_t* src_argb,
@@ -108,6 +108,11 @@ static __inline void SetCpuFlags(int cpu_flags) {
 #endif
 }
 
+// Returns the size in bytes of the level 1, 2 or 3 data or unified cache,
+// as reported by cpuid. Returns 0 if unknown, including on non-X86 CPUs.
+LIBYUV_API
+int GetCpuCacheSize(int level);
+
 // Low level cpuid for X86. Returns zeros on other CPUs.
 // eax is the info type that you want.
 // ecx is typically the cpu number, and should normally be zero.
@@ -54,6 +54,7 @@ struct BufferVector {
 };
 
 struct SetJmpErrorMgr;
+struct JpegImagePool;
 
 // MJPEG ("Motion JPEG") is a pseudo-standard video codec where the frames are
 // simply independent JPEG images with a fixed huffman table (which is omitted).
@@ -80,7 +81,10 @@ class LIBYUV_API MJpegDecoder {
   ~MJpegDecoder();
 
   // Loads a new frame, reads its headers, and determines the uncompressed
-  // image format.
+  // image format.  A decoder may be reused for many frames.  The jpeglib
+  // state and the row buffers are kept between frames, so once a frame of a
+  // given size and format has been decoded, decoding more frames like it does
+  // not allocate memory.
   // Returns LIBYUV_TRUE if image looks valid and format is supported.
   // If return value is LIBYUV_TRUE, then the values for all the following
   // getters are populated.
@@ -93,6 +97,18 @@ class LIBYUV_API MJpegDecoder {
   // Returns height of the last loaded frame in pixels.
   int GetHeight();
 
+  // Decodes at 1/scale_denom of the frame size using the reduced size inverse
+  // DCT of libjpeg, which is much cheaper than decoding at full size and
+  // scaling down.  scale_denom must be 1, 2, 4 or 8.  Call after LoadFrame(),
+  // which resets it to 1.  The component getters and the Decode functions
+  // then use the scaled size, GetScaledWidth() x GetScaledHeight().
+  LIBYUV_BOOL SetScaleDenom(int scale_denom);
+
+  // Size of the decoded image after DCT scaling.
+  int GetScaledWidth();
+
+  int GetScaledHeight();
+
   // Returns format of the last loaded frame. The return value is one of the
   // kColorSpace* constants.
   int GetColorSpace();
@@ -149,6 +165,11 @@ class LIBYUV_API MJpegDecoder {
                                int dst_width,
                                int dst_height);
 
+  // Number of heap allocations made by the decoder and by jpeglib on its
+  // behalf since construction.  For testing that decoding a stream does not
+  // allocate memory per frame.
+  int GetAllocationCount();
+
   // The helper function which recognizes the jpeg sub-sampling type.
   static JpegSubsamplingType JpegSubsamplingTypeHelper(
       int* subsample_x,
@@ -157,6 +178,7 @@ class LIBYUV_API MJpegDecoder {
 
  private:
   void AllocOutputBuffers(int num_outbufs);
+  void AllocScanlineBuffers();
   void DestroyOutputBuffers();
 
   LIBYUV_BOOL StartDecode();
@@ -171,6 +193,7 @@ class LIBYUV_API MJpegDecoder {
   Buffer buf_;
   BufferVector buf_vec_;
 
+  JpegImagePool* image_pool_;
   jpeg_decompress_struct* decompress_struct_;
   jpeg_source_mgr* source_mgr_;
   SetJmpErrorMgr* error_mgr_;
@@ -187,6 +210,9 @@ class LIBYUV_API MJpegDecoder {
   // output buffers. Large enough for just one iMCU row.
   uint8_t** databuf_;
   int* databuf_strides_;
+
+  // Allocations of the buffers above.
+  int allocation_count_;
 };
 
 }  // namespace libyuv
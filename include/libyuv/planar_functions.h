@@ -105,6 +105,33 @@ void MergeUVPlane(const uint8_t* src_u,
                   int width,
                   int height);
 
+// Copy a tiled plane, as output by hardware video decoders, to a linear
+// plane.  Tiles are 16 bytes wide and tile_height rows high, stored one after
+// another.  src_stride_y is the stride of one row of the image, so a row of
+// tiles is src_stride_y * tile_height bytes.  tile_height must be a power
+// of 2.  Returns 0 on success, -1 for invalid parameters.
+LIBYUV_API
+int DetilePlane(const uint8_t* src_y,
+                int src_stride_y,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                int width,
+                int height,
+                int tile_height);
+
+// Copy a tiled interleaved UV plane to separate linear U and V planes.
+// width is the width of the UV plane in bytes, ie twice the U width.
+LIBYUV_API
+int DetileSplitUVPlane(const uint8_t* src_uv,
+                       int src_stride_uv,
+                       uint8_t* dst_u,
+                       int dst_stride_u,
+                       uint8_t* dst_v,
+                       int dst_stride_v,
+                       int width,
+                       int height,
+                       int tile_height);
+
 // Split interleaved msb UV plane into separate lsb U and V planes.
 LIBYUV_API
 void SplitUVPlane_16(const uint16_t* src_uv,
@@ -400,6 +427,36 @@ int UYVYToNV12(const uint8_t* src_uyvy,
                int width,
                int height);
 
+// YUY2ToNV12 and UYVYToNV12 using a caller supplied scratch for their row
+// buffers.  The ScratchSize functions return the scratch size in bytes needed.
+LIBYUV_API
+int YUY2ToNV12ScratchSize(int width);
+
+LIBYUV_API
+int YUY2ToNV12_WithScratch(const uint8_t* src_yuy2,
+                           int src_stride_yuy2,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int width,
+                           int height,
+                           const LibyuvScratch* scratch);
+
+LIBYUV_API
+int UYVYToNV12ScratchSize(int width);
+
+LIBYUV_API
+int UYVYToNV12_WithScratch(const uint8_t* src_uyvy,
+                           int src_stride_uyvy,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int width,
+                           int height,
+                           const LibyuvScratch* scratch);
+
 // Convert NV21 to NV12.
 LIBYUV_API
 int NV21ToNV12(const uint8_t* src_y,
@@ -0,0 +1,108 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_PROFILE_H_
+#define INCLUDE_LIBYUV_PROFILE_H_
+
+#include "libyuv/basic_types.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Call counts, pixel counts and time spent in libyuv functions.
+// Profiling is only built if libyuv is compiled with LIBYUV_ENABLE_PROFILE
+// (cmake -DPROFILE=ON or gn libyuv_enable_profile=true).  Otherwise the
+// functions below still exist but record nothing.  When built, profiling is
+// off until EnableProfile(1) is called, and while it is off each profiled
+// function only tests one flag.
+//
+// Profiled functions, and the public functions counted under each of them:
+//   I420ToARGBMatrix: I420ToARGB, I420ToABGR, J420ToARGB, J420ToABGR,
+//     H420ToARGB, H420ToABGR, U420ToARGB, U420ToABGR.
+//   I422ToARGBMatrix: I422ToARGB, I422ToABGR, J422ToARGB, J422ToABGR,
+//     H422ToARGB, H422ToABGR, U422ToARGB, U422ToABGR.
+//   NV12ToARGBMatrix: NV12ToARGB, NV21ToABGR, NV12ToARGBSlice.
+//   I420ToARGBMatrixBatch: I420ToARGBBatch.
+//   ARGBToI420, ARGBToI420Batch.
+//   I420ToRGBTensorMatrix, NV12ToRGBTensorMatrix.
+//   I420Scale, NV12Scale, ARGBScale, and ScalePlanExecute of plans of the
+//     same format.  Plane and UV plans are not profiled, as ScalePlane and
+//     UVScale are not.
+// Android420ToARGBMatrix is counted under I420ToARGBMatrix or
+// NV12ToARGBMatrix unless its chroma is NV21.  Other functions,
+// including the _16 and clip variants of the scalers, are not profiled.
+
+enum ProfileFunction {
+  kProfileI420ToARGBMatrix = 0,
+  kProfileI422ToARGBMatrix,
+  kProfileNV12ToARGBMatrix,
+  kProfileI420ToARGBMatrixBatch,
+  kProfileARGBToI420,
+  kProfileARGBToI420Batch,
+  kProfileI420ToRGBTensorMatrix,
+  kProfileNV12ToRGBTensorMatrix,
+  kProfileI420Scale,
+  kProfileNV12Scale,
+  kProfileARGBScale,
+  kProfileFunctionCount
+};
+
+// Values of ProfileStats.kernel that are not kCpuHas flags.
+enum ProfileKernel {
+  kProfileKernelC = 0,       // Only C row functions were used.
+  kProfileKernelMixed = -1,  // Several row functions were used.
+};
+
+struct ProfileStats {
+  const char* name;      // Function name, such as "I420ToARGBMatrix".
+  uint64_t calls;        // Successful calls.
+  uint64_t pixels;       // Destination pixels written.
+  uint64_t nanoseconds;  // Total time in the function.
+  // kCpuHas flag of the row function used by the last call, or a
+  // ProfileKernel value.
+  int kernel;
+};
+
+// Called at the end of each profiled call while profiling is on.
+// start_ns is from a monotonic clock.
+typedef void (*ProfileCallback)(void* opaque,
+                                const char* name,
+                                uint64_t start_ns,
+                                uint64_t nanoseconds,
+                                uint64_t pixels,
+                                int kernel);
+
+// Turns profiling on (1) or off (0).  Returns 1 if profiling is now on, which
+// is never the case unless built with LIBYUV_ENABLE_PROFILE.
+LIBYUV_API
+int EnableProfile(int enable);
+
+// Copies the stats of the functions that have been called, up to max_stats
+// of them, in ProfileFunction order.  Returns the number copied.
+LIBYUV_API
+int GetProfileStats(struct ProfileStats* stats, int max_stats);
+
+// Sets all counts and times back to 0.
+LIBYUV_API
+void ResetProfileStats(void);
+
+// Sets a callback for tracing, or NULL for none.  Set it before turning
+// profiling on, not while profiled functions are running on other threads.
+LIBYUV_API
+void SetProfileCallback(ProfileCallback callback, void* opaque);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_PROFILE_H_
@@ -93,6 +93,16 @@ int RotatePlane(const uint8_t* src,
                 int height,
                 enum RotationMode mode);
 
+// Set the tile size used to cache block rotation by 90 and 270 degrees.
+// Planes are transposed in tiles of tile_width source columns by tile_height
+// source rows; UV planes use half the tile width and ARGB uses bands of twice
+// tile_width source rows. Pass 0 to select a size from the CPU cache sizes.
+// The width and height are stored together atomically, so it may be called
+// while other threads rotate; a rotation already in progress keeps the size
+// it started with, and later rotations use the new size.
+LIBYUV_API
+void SetRotateTileSize(int tile_width, int tile_height);
+
 // Rotate planes by 90, 180, 270. Deprecated.
 LIBYUV_API
 void RotatePlane90(const uint8_t* src,
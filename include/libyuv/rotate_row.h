@@ -12,6 +12,7 @@
 #define INCLUDE_LIBYUV_ROTATE_ROW_H_
 
 #include "libyuv/basic_types.h"
+#include "libyuv/rotate.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -50,6 +51,36 @@ extern "C" {
 #define HAS_TRANSPOSEUVWX8_SSE2
 #endif
 
+// clang >= 6.0.0 required for AVX512.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+// clang in xcode follows a different versioning scheme.
+#if (__clang_major__ >= 7) && !defined(__APPLE__)
+#define CLANG_HAS_AVX512 1
+#endif  // clang >= 7
+#endif  // __clang__
+
+// GCC >= 5.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 5)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 5
+#endif  // __GNUC__
+
+// The following are available for AVX2 with 64 bit GCC or clang:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(__clang__) || (defined(__GNUC__) && __GNUC__ >= 5))
+#define HAS_TRANSPOSEWX16_AVX2
+#define HAS_TRANSPOSEUVWX16_AVX2
+#endif
+
+// The following are available for AVX512BW with 64 bit GCC or clang:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_TRANSPOSEWX16_AVX512BW
+#define HAS_TRANSPOSEUVWX16_AVX512BW
+#endif
+
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__ARM_NEON__) || defined(LIBYUV_NEON) || defined(__aarch64__))
 #define HAS_TRANSPOSEWX8_NEON
@@ -66,6 +97,35 @@ extern "C" {
 #define HAS_TRANSPOSEUVWX8_MMI
 #endif
 
+// Returns the tile size used to cache block transposes, either as set by
+// SetRotateTileSize() or derived from the CPU cache sizes.
+void GetRotateTileSize(int* tile_width, int* tile_height);
+
+// Converts rows of a crop into a strip buffer of strip_rows rows, then
+// rotates them into the destination.  rows rows start at crop row
+// strip_crop_y, and dst_offset is the first row, or column, of the strip
+// in the rotated destination.  Returns 0 on success.
+typedef int (*RotateStripFunc)(void* opaque,
+                               uint8_t* strip,
+                               int strip_rows,
+                               int strip_crop_y,
+                               int rows,
+                               int dst_offset);
+
+// Converts and rotates a crop of crop_height rows a strip of rows at a
+// time, calling convert_rotate for each strip.  Each strip of row_bytes
+// bytes per row fits in half of the L2 cache, with the destination lines it
+// is rotated into.  Strips are a multiple of 16 rows, except the last.
+// invert reads the crop from the bottom up.  Returns 1 if out of memory, or
+// the first error of convert_rotate.
+int RotateStrips(int row_bytes,
+                 int crop_y,
+                 int crop_height,
+                 int invert,
+                 enum RotationMode rotation,
+                 RotateStripFunc convert_rotate,
+                 void* opaque);
+
 void TransposeWxH_C(const uint8_t* src,
                     int src_stride,
                     uint8_t* dst,
@@ -108,6 +168,16 @@ void TransposeWx16_MSA(const uint8_t* src,
                        uint8_t* dst,
                        int dst_stride,
                        int width);
+void TransposeWx16_AVX2(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width);
+void TransposeWx16_AVX512BW(const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int width);
 
 void TransposeWx8_Any_NEON(const uint8_t* src,
                            int src_stride,
@@ -134,6 +204,16 @@ void TransposeWx16_Any_MSA(const uint8_t* src,
                            uint8_t* dst,
                            int dst_stride,
                            int width);
+void TransposeWx16_Any_AVX2(const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int width);
+void TransposeWx16_Any_AVX512BW(const uint8_t* src,
+                                int src_stride,
+                                uint8_t* dst,
+                                int dst_stride,
+                                int width);
 
 void TransposeUVWxH_C(const uint8_t* src,
                       int src_stride,
@@ -186,6 +266,20 @@ void TransposeUVWx16_MSA(const uint8_t* src,
                          uint8_t* dst_b,
                          int dst_stride_b,
                          int width);
+void TransposeUVWx16_AVX2(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst_a,
+                          int dst_stride_a,
+                          uint8_t* dst_b,
+                          int dst_stride_b,
+                          int width);
+void TransposeUVWx16_AVX512BW(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst_a,
+                              int dst_stride_a,
+                              uint8_t* dst_b,
+                              int dst_stride_b,
+                              int width);
 
 void TransposeUVWx8_Any_SSE2(const uint8_t* src,
                              int src_stride,
@@ -215,6 +309,20 @@ void TransposeUVWx16_Any_MSA(const uint8_t* src,
                              uint8_t* dst_b,
                              int dst_stride_b,
                              int width);
+void TransposeUVWx16_Any_AVX2(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst_a,
+                              int dst_stride_a,
+                              uint8_t* dst_b,
+                              int dst_stride_b,
+                              int width);
+void TransposeUVWx16_Any_AVX512BW(const uint8_t* src,
+                                  int src_stride,
+                                  uint8_t* dst_a,
+                                  int dst_stride_a,
+                                  uint8_t* dst_b,
+                                  int dst_stride_b,
+                                  int width);
 
 #ifdef __cplusplus
 }  // extern "C"
@@ -64,6 +64,14 @@ extern "C" {
 #endif  // clang >= 7
 #endif  // __clang__
 
+// GCC >= 5.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 5)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 5
+#endif  // __GNUC__
+
 // Visual C 2012 required for AVX2.
 #if defined(_M_IX86) && !defined(__clang__) && defined(_MSC_VER) && \
     _MSC_VER >= 1700
@@ -119,9 +127,7 @@ extern "C" {
 #define HAS_NV21TORGB24ROW_SSSE3
 #define HAS_RAWTOARGBROW_SSSE3
 #define HAS_RAWTORGB24ROW_SSSE3
-#define HAS_RAWTOYROW_SSSE3
 #define HAS_RGB24TOARGBROW_SSSE3
-#define HAS_RGB24TOYROW_SSSE3
 #define HAS_RGB24TOYJROW_SSSE3
 #define HAS_RAWTOYJROW_SSSE3
 #define HAS_RGB565TOARGBROW_SSE2
@@ -276,9 +282,13 @@ extern "C" {
 #define HAS_ARGBTOAR64ROW_SSSE3
 #define HAS_ARGBTOAB64ROW_SSSE3
 #define HAS_AR64TOARGBROW_SSSE3
+#define HAS_ARGBTOUVHROW_SSSE3
+#define HAS_ARGBTOYHROW_SSSE3
 #define HAS_AB64TOARGBROW_SSSE3
 #define HAS_CONVERT16TO8ROW_SSSE3
 #define HAS_CONVERT8TO16ROW_SSE2
+#define HAS_DETILEROW_SSE2
+#define HAS_DETILESPLITUVROW_SSSE3
 #define HAS_HALFMERGEUVROW_SSSE3
 #define HAS_I210TOAR30ROW_SSSE3
 #define HAS_I210TOARGBROW_SSSE3
@@ -288,6 +298,7 @@ extern "C" {
 #define HAS_I422TOAR30ROW_SSSE3
 #define HAS_I410TOAR30ROW_SSSE3
 #define HAS_I410TOARGBROW_SSSE3
+#define HAS_INTERPOLATEROW_16_SSE2
 #define HAS_MERGEARGBROW_SSE2
 #define HAS_MERGEXRGBROW_SSE2
 #define HAS_MERGERGBROW_SSSE3
@@ -297,7 +308,11 @@ extern "C" {
 #define HAS_P410TOAR30ROW_SSSE3
 #define HAS_P410TOARGBROW_SSSE3
 #define HAS_RAWTORGBAROW_SSSE3
+#define HAS_RAWTOUVROW_SSSE3
+#define HAS_RAWTOYROW_SSSE3
 #define HAS_RGB24MIRRORROW_SSSE3
+#define HAS_RGB24TOUVROW_SSSE3
+#define HAS_RGB24TOYROW_SSSE3
 #define HAS_RGBATOYJROW_SSSE3
 #define HAS_SPLITARGBROW_SSE2
 #define HAS_SPLITARGBROW_SSSE3
@@ -328,6 +343,8 @@ extern "C" {
 #define HAS_ARGBTOAR64ROW_AVX2
 #define HAS_ARGBTOAB64ROW_AVX2
 #define HAS_AR64TOARGBROW_AVX2
+#define HAS_ARGBTOUVHROW_AVX2
+#define HAS_ARGBTOYHROW_AVX2
 #define HAS_AB64TOARGBROW_AVX2
 #define HAS_CONVERT16TO8ROW_AVX2
 #define HAS_CONVERT8TO16ROW_AVX2
@@ -354,9 +371,14 @@ extern "C" {
 #define HAS_I422TOAR30ROW_AVX2
 #define HAS_I422TOUYVYROW_AVX2
 #define HAS_I422TOYUY2ROW_AVX2
+#define HAS_INTERPOLATEROW_16_AVX2
 #define HAS_MERGEUVROW_16_AVX2
 #define HAS_MIRRORUVROW_AVX2
 #define HAS_MULTIPLYROW_16_AVX2
+#define HAS_RAWTOUVROW_AVX2
+#define HAS_RAWTOYROW_AVX2
+#define HAS_RGB24TOUVROW_AVX2
+#define HAS_RGB24TOYROW_AVX2
 #define HAS_RGBATOYJROW_AVX2
 #define HAS_SPLITARGBROW_AVX2
 #define HAS_SPLITXRGBROW_AVX2
@@ -370,6 +392,14 @@ extern "C" {
 // https://code.google.com/p/libyuv/issues/detail?id=517
 #define HAS_I210ALPHATOARGBROW_AVX2
 #define HAS_I410ALPHATOARGBROW_AVX2
+#define HAS_ARGBTORGBFLOATROW_AVX2
+#define HAS_FLOATTOHALFROW_AVX2
+#define HAS_RAWTOFLOATROW_AVX2
+#endif
+// The fused tone map rows need ymm14, ymm15 and 9 general registers.
+#if defined(__x86_64__)
+#define HAS_I210TOARGBTONEMAPROW_AVX2
+#define HAS_P210TOARGBTONEMAPROW_AVX2
 #endif
 #endif
 
@@ -382,6 +412,15 @@ extern "C" {
 #define HAS_ARGBTORGB24ROW_AVX512VBMI
 #endif
 
+// The following are available for AVX512BW x64 platforms with GCC or clang:
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_ARGBTOUVROW_AVX512BW
+#define HAS_ARGBTOYROW_AVX512BW
+#define HAS_I422TOARGBROW_AVX512BW
+#define HAS_NV12TOARGBROW_AVX512BW
+#endif
+
 // The following are available on Neon platforms:
 #if !defined(LIBYUV_DISABLE_NEON) && \
     (defined(__aarch64__) || defined(__ARM_NEON__) || defined(LIBYUV_NEON))
@@ -417,6 +456,8 @@ extern "C" {
 #define HAS_BGRATOYROW_NEON
 #define HAS_BYTETOFLOATROW_NEON
 #define HAS_COPYROW_NEON
+#define HAS_DETILEROW_NEON
+#define HAS_DETILESPLITUVROW_NEON
 #define HAS_DIVIDEROW_16_NEON
 #define HAS_HALFFLOATROW_NEON
 #define HAS_HALFMERGEUVROW_NEON
@@ -508,6 +549,8 @@ extern "C" {
 
 // The following are available on AArch64 platforms:
 #if !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
+// TODO: Enable once it passes the unit tests on AArch64.
+// #define HAS_INTERPOLATEROW_16_NEON
 #define HAS_SCALESUMSAMPLES_NEON
 #define HAS_GAUSSROW_F32_NEON
 #define HAS_GAUSSCOL_F32_NEON
@@ -743,6 +786,118 @@ struct YuvConstants {
 
 #endif
 
+// Tables for the ToneMap rows, defined in convert_argb.h.
+struct ToneMapConstants;
+
+// Normalization for the float tensor rows.  Channel c of a pixel, in R, G, B
+// order, is stored as value * kScale[c] + kBias[c].  kScaleRGB and kBiasRGB
+// repeat them for 8 packed RGB pixels.
+struct RGBNormConstants {
+  float kScale[4];
+  float kBias[4];
+  float kScaleRGB[24];
+  float kBiasRGB[24];
+};
+
+// Row functions chosen for the CPU flags once, so that the conversions do not
+// test the flags on every call.  For each kernel the _Any function handles
+// any width, and the plain one is used when the width is a multiple of _Align.
+// _Cpu is the kCpuHas flag the kernel was chosen for, or 0 for C.
+// ROW_KERNEL picks one of them for a width.
+// Only I420/I422/NV12ToARGB, ARGBToI420, the plane bilinear and vertical
+// scalers and the row interpolation of the ARGB and UV scalers use the
+// table.  The other conversions and scalers still walk their TestCpuFlag
+// chains: the box, Down2, Down4, Down34, Down38 and Up2 plane scalers, the
+// ARGB and UV columns and the 16 bit scalers.  The 8 bit scalers walk them
+// once in their Init, and the 16 bit scalers on every call.
+struct RowKernels {
+  int cpu_info;  // The flags the kernels were chosen for.
+  void (*I422ToARGBRow)(const uint8_t* y_buf,
+                        const uint8_t* u_buf,
+                        const uint8_t* v_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+  void (*I422ToARGBRow_Any)(const uint8_t* y_buf,
+                            const uint8_t* u_buf,
+                            const uint8_t* v_buf,
+                            uint8_t* rgb_buf,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
+  int I422ToARGBRow_Align;
+  int I422ToARGBRow_Cpu;
+  void (*NV12ToARGBRow)(const uint8_t* y_buf,
+                        const uint8_t* uv_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+  void (*NV12ToARGBRow_Any)(const uint8_t* y_buf,
+                            const uint8_t* uv_buf,
+                            uint8_t* rgb_buf,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
+  int NV12ToARGBRow_Align;
+  int NV12ToARGBRow_Cpu;
+  void (*ARGBToYRow)(const uint8_t* src_argb, uint8_t* dst_y, int width);
+  void (*ARGBToYRow_Any)(const uint8_t* src_argb, uint8_t* dst_y, int width);
+  int ARGBToYRow_Align;
+  int ARGBToYRow_Cpu;
+  void (*ARGBToUVRow)(const uint8_t* src_argb,
+                      int src_stride_argb,
+                      uint8_t* dst_u,
+                      uint8_t* dst_v,
+                      int width);
+  void (*ARGBToUVRow_Any)(const uint8_t* src_argb,
+                          int src_stride_argb,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width);
+  int ARGBToUVRow_Align;
+  int ARGBToUVRow_Cpu;
+  // Width in bytes.
+  void (*InterpolateRow)(uint8_t* dst_ptr,
+                         const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         int width,
+                         int source_y_fraction);
+  void (*InterpolateRow_Any)(uint8_t* dst_ptr,
+                             const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             int width,
+                             int source_y_fraction);
+  int InterpolateRow_Align;
+  int InterpolateRow_Cpu;
+  // Bilinear columns for source widths of 4 to 32767.  Aligned on the
+  // destination width.
+  void (*ScaleFilterCols)(uint8_t* dst_ptr,
+                          const uint8_t* src_ptr,
+                          int dst_width,
+                          int x,
+                          int dx);
+  void (*ScaleFilterCols_Any)(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx);
+  int ScaleFilterCols_Align;
+  int ScaleFilterCols_Cpu;
+  // Bilinear columns for source widths of 32768 or more, any width.
+  void (*ScaleFilterCols64)(uint8_t* dst_ptr,
+                            const uint8_t* src_ptr,
+                            int dst_width,
+                            int x,
+                            int dx);
+};
+
+// Returns the row kernels for the current CPU flags.  They are chosen on the
+// first call for each set of flags, and the returned table is never changed,
+// so it is safe to call from several threads and across MaskCpuFlags.
+const struct RowKernels* GetRowKernels(void);
+
+#define ROW_KERNEL(kernels, name, width)                          \
+  (IS_ALIGNED((width), (kernels)->name##_Align) ? (kernels)->name \
+                                                : (kernels)->name##_Any)
+
 #define IS_ALIGNED(p, a) (!((uintptr_t)(p) & ((a)-1)))
 
 #define align_buffer_64(var, size)                                           \
@@ -753,6 +908,21 @@ struct YuvConstants {
   free(var##_mem);                  \
   var = 0
 
+// Same as align_buffer_64 but uses the caller supplied LibyuvScratch when
+// it is large enough.  Release with free_aligned_buffer_64.
+#define SCRATCH_FITS(scratch, bytes) \
+  ((scratch) && (scratch)->buffer && (scratch)->size >= (size_t)(bytes) + 63)
+
+#define align_buffer_64_scratch(var, size, scratch)                         \
+  uint8_t* var##_mem = SCRATCH_FITS(scratch, size)                          \
+                           ? NULL                                           \
+                           : (uint8_t*)(malloc((size) + 63)); /* NOLINT */  \
+  uint8_t* var =                                                            \
+      (uint8_t*)(((intptr_t)(SCRATCH_FITS(scratch, size) ? (scratch)->buffer \
+                                                         : var##_mem) +     \
+                  63) &                                                     \
+                 ~63) /* NOLINT */
+
 #if defined(__APPLE__) || defined(__x86_64__) || defined(__llvm__)
 #define OMITFP
 #else
@@ -998,11 +1168,19 @@ void UYVYToARGBRow_MSA(const uint8_t* src_uyvy,
 
 void ARGBToYRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void ARGBToYRow_AVX512BW(const uint8_t* src_argb, uint8_t* dst_y, int width);
+void ARGBToYRow_Any_AVX512BW(const uint8_t* src_ptr,
+                             uint8_t* dst_ptr,
+                             int width);
 void ABGRToYRow_AVX2(const uint8_t* src_abgr, uint8_t* dst_y, int width);
 void ABGRToYRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void ARGBToYRow_SSSE3(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYJRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void ARGBToYJRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void ARGBToYHRow_SSSE3(const uint8_t* src_argb, uint8_t* dst_y, int width);
+void ARGBToYHRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width);
+void ARGBToYHRow_Any_SSSE3(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void ARGBToYHRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void ARGBToYJRow_SSSE3(const uint8_t* src_argb, uint8_t* dst_y, int width);
 void RGBAToYJRow_AVX2(const uint8_t* src_rgba, uint8_t* dst_y, int width);
 void RGBAToYJRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
@@ -1014,6 +1192,8 @@ void RGB24ToYRow_SSSE3(const uint8_t* src_rgb24, uint8_t* dst_y, int width);
 void RGB24ToYJRow_SSSE3(const uint8_t* src_rgb24, uint8_t* dst_yj, int width);
 void RAWToYRow_SSSE3(const uint8_t* src_raw, uint8_t* dst_y, int width);
 void RAWToYJRow_SSSE3(const uint8_t* src_raw, uint8_t* dst_yj, int width);
+void RGB24ToYRow_AVX2(const uint8_t* src_rgb24, uint8_t* dst_y, int width);
+void RAWToYRow_AVX2(const uint8_t* src_raw, uint8_t* dst_y, int width);
 void RGB24ToYJRow_AVX2(const uint8_t* src_rgb24, uint8_t* dst_yj, int width);
 void RAWToYJRow_AVX2(const uint8_t* src_raw, uint8_t* dst_yj, int width);
 void ARGBToYRow_NEON(const uint8_t* src_argb, uint8_t* dst_y, int width);
@@ -1212,6 +1392,7 @@ void ARGB4444ToYRow_MMI(const uint8_t* src_argb4444, uint8_t* dst_y, int width);
 
 void ARGBToYRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
 void ARGBToYJRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
+void ARGBToYHRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
 void RGBAToYJRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
 void BGRAToYRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
 void ABGRToYRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width);
@@ -1235,6 +1416,8 @@ void RGB24ToYJRow_Any_SSSE3(const uint8_t* src_ptr,
                             int width);
 void RAWToYRow_Any_SSSE3(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void RAWToYJRow_Any_SSSE3(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void RGB24ToYRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
+void RAWToYRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void RGB24ToYJRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void RAWToYJRow_Any_AVX2(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
 void ARGBToYRow_Any_NEON(const uint8_t* src_ptr, uint8_t* dst_ptr, int width);
@@ -1285,6 +1468,11 @@ void ARGBToUVRow_AVX2(const uint8_t* src_argb,
                       uint8_t* dst_u,
                       uint8_t* dst_v,
                       int width);
+void ARGBToUVRow_AVX512BW(const uint8_t* src_argb,
+                          int src_stride_argb,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width);
 void ABGRToUVRow_AVX2(const uint8_t* src_abgr,
                       int src_stride_abgr,
                       uint8_t* dst_u,
@@ -1320,16 +1508,61 @@ void RGBAToUVRow_SSSE3(const uint8_t* src_rgba,
                        uint8_t* dst_u,
                        uint8_t* dst_v,
                        int width);
+void RGB24ToUVRow_SSSE3(const uint8_t* src_rgb24,
+                        int src_stride_rgb24,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width);
+void RAWToUVRow_SSSE3(const uint8_t* src_raw,
+                      int src_stride_raw,
+                      uint8_t* dst_u,
+                      uint8_t* dst_v,
+                      int width);
+void RGB24ToUVRow_AVX2(const uint8_t* src_rgb24,
+                       int src_stride_rgb24,
+                       uint8_t* dst_u,
+                       uint8_t* dst_v,
+                       int width);
+void RAWToUVRow_AVX2(const uint8_t* src_raw,
+                     int src_stride_raw,
+                     uint8_t* dst_u,
+                     uint8_t* dst_v,
+                     int width);
 void ARGBToUVRow_Any_AVX2(const uint8_t* src_ptr,
                           int src_stride,
                           uint8_t* dst_u,
                           uint8_t* dst_v,
                           int width);
+void ARGBToUVRow_Any_AVX512BW(const uint8_t* src_ptr,
+                              int src_stride,
+                              uint8_t* dst_u,
+                              uint8_t* dst_v,
+                              int width);
 void ABGRToUVRow_Any_AVX2(const uint8_t* src_ptr,
                           int src_stride,
                           uint8_t* dst_u,
                           uint8_t* dst_v,
                           int width);
+void ARGBToUVHRow_SSSE3(const uint8_t* src_argb,
+                        int src_stride_argb,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width);
+void ARGBToUVHRow_AVX2(const uint8_t* src_argb,
+                       int src_stride_argb,
+                       uint8_t* dst_u,
+                       uint8_t* dst_v,
+                       int width);
+void ARGBToUVHRow_Any_SSSE3(const uint8_t* src_ptr,
+                            int src_stride,
+                            uint8_t* dst_u,
+                            uint8_t* dst_v,
+                            int width);
+void ARGBToUVHRow_Any_AVX2(const uint8_t* src_ptr,
+                           int src_stride,
+                           uint8_t* dst_u,
+                           uint8_t* dst_v,
+                           int width);
 void ARGBToUVJRow_Any_AVX2(const uint8_t* src_ptr,
                            int src_stride,
                            uint8_t* dst_u,
@@ -1340,6 +1573,26 @@ void ARGBToUVRow_Any_SSSE3(const uint8_t* src_ptr,
                            uint8_t* dst_u,
                            uint8_t* dst_v,
                            int width);
+void RGB24ToUVRow_Any_SSSE3(const uint8_t* src_ptr,
+                            int src_stride,
+                            uint8_t* dst_u,
+                            uint8_t* dst_v,
+                            int width);
+void RAWToUVRow_Any_SSSE3(const uint8_t* src_ptr,
+                          int src_stride,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width);
+void RGB24ToUVRow_Any_AVX2(const uint8_t* src_ptr,
+                           int src_stride,
+                           uint8_t* dst_u,
+                           uint8_t* dst_v,
+                           int width);
+void RAWToUVRow_Any_AVX2(const uint8_t* src_ptr,
+                         int src_stride,
+                         uint8_t* dst_u,
+                         uint8_t* dst_v,
+                         int width);
 void ARGBToUVJRow_Any_SSSE3(const uint8_t* src_ptr,
                             int src_stride,
                             uint8_t* dst_u,
@@ -1537,6 +1790,11 @@ void ARGBToUVJRow_C(const uint8_t* src_rgb,
                     uint8_t* dst_u,
                     uint8_t* dst_v,
                     int width);
+void ARGBToUVHRow_C(const uint8_t* src_rgb,
+                    int src_stride_rgb,
+                    uint8_t* dst_u,
+                    uint8_t* dst_v,
+                    int width);
 void BGRAToUVRow_C(const uint8_t* src_rgb,
                    int src_stride_rgb,
                    uint8_t* dst_u,
@@ -1667,6 +1925,52 @@ void RGB24MirrorRow_Any_NEON(const uint8_t* src_ptr,
                              uint8_t* dst_ptr,
                              int width);
 
+void DetileRow_C(const uint8_t* src,
+                 ptrdiff_t src_tile_stride,
+                 uint8_t* dst,
+                 int width);
+void DetileRow_SSE2(const uint8_t* src,
+                    ptrdiff_t src_tile_stride,
+                    uint8_t* dst,
+                    int width);
+void DetileRow_NEON(const uint8_t* src,
+                    ptrdiff_t src_tile_stride,
+                    uint8_t* dst,
+                    int width);
+void DetileRow_Any_SSE2(const uint8_t* src,
+                        ptrdiff_t src_tile_stride,
+                        uint8_t* dst,
+                        int width);
+void DetileRow_Any_NEON(const uint8_t* src,
+                        ptrdiff_t src_tile_stride,
+                        uint8_t* dst,
+                        int width);
+void DetileSplitUVRow_C(const uint8_t* src_uv,
+                        ptrdiff_t src_tile_stride,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width);
+void DetileSplitUVRow_SSSE3(const uint8_t* src_uv,
+                            ptrdiff_t src_tile_stride,
+                            uint8_t* dst_u,
+                            uint8_t* dst_v,
+                            int width);
+void DetileSplitUVRow_NEON(const uint8_t* src_uv,
+                           ptrdiff_t src_tile_stride,
+                           uint8_t* dst_u,
+                           uint8_t* dst_v,
+                           int width);
+void DetileSplitUVRow_Any_SSSE3(const uint8_t* src_uv,
+                                ptrdiff_t src_tile_stride,
+                                uint8_t* dst_u,
+                                uint8_t* dst_v,
+                                int width);
+void DetileSplitUVRow_Any_NEON(const uint8_t* src_uv,
+                               ptrdiff_t src_tile_stride,
+                               uint8_t* dst_u,
+                               uint8_t* dst_v,
+                               int width);
+
 void SplitUVRow_C(const uint8_t* src_uv,
                   uint8_t* dst_u,
                   uint8_t* dst_v,
@@ -2979,6 +3283,12 @@ void I422ToARGBRow_AVX2(const uint8_t* y_buf,
                         uint8_t* dst_argb,
                         const struct YuvConstants* yuvconstants,
                         int width);
+void I422ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                            const uint8_t* u_buf,
+                            const uint8_t* v_buf,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
 void I422ToRGBARow_AVX2(const uint8_t* y_buf,
                         const uint8_t* u_buf,
                         const uint8_t* v_buf,
@@ -3154,6 +3464,11 @@ void NV12ToARGBRow_AVX2(const uint8_t* y_buf,
                         uint8_t* dst_argb,
                         const struct YuvConstants* yuvconstants,
                         int width);
+void NV12ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                            const uint8_t* uv_buf,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            int width);
 void NV12ToRGB24Row_SSSE3(const uint8_t* src_y,
                           const uint8_t* src_uv,
                           uint8_t* dst_rgb24,
@@ -3316,6 +3631,12 @@ void I422ToARGBRow_Any_AVX2(const uint8_t* y_buf,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* yuvconstants,
                             int width);
+void I422ToARGBRow_Any_AVX512BW(const uint8_t* y_buf,
+                                const uint8_t* u_buf,
+                                const uint8_t* v_buf,
+                                uint8_t* dst_ptr,
+                                const struct YuvConstants* yuvconstants,
+                                int width);
 void I422ToRGBARow_Any_AVX2(const uint8_t* y_buf,
                             const uint8_t* u_buf,
                             const uint8_t* v_buf,
@@ -3490,6 +3811,11 @@ void NV12ToARGBRow_Any_AVX2(const uint8_t* y_buf,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* yuvconstants,
                             int width);
+void NV12ToARGBRow_Any_AVX512BW(const uint8_t* y_buf,
+                                const uint8_t* uv_buf,
+                                uint8_t* dst_ptr,
+                                const struct YuvConstants* yuvconstants,
+                                int width);
 void NV21ToARGBRow_Any_SSSE3(const uint8_t* y_buf,
                              const uint8_t* uv_buf,
                              uint8_t* dst_ptr,
@@ -3669,6 +3995,45 @@ void I400ToARGBRow_MMI(const uint8_t* src_y,
                        uint8_t* dst_argb,
                        const struct YuvConstants* yuvconstants,
                        int width);
+void I210ToARGBToneMapRow_C(const uint16_t* src_y,
+                            const uint16_t* src_u,
+                            const uint16_t* src_v,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            const struct ToneMapConstants* tonemap,
+                            int width);
+void I210ToARGBToneMapRow_AVX2(const uint16_t* y_buf,
+                               const uint16_t* u_buf,
+                               const uint16_t* v_buf,
+                               uint8_t* dst_argb,
+                               const struct YuvConstants* yuvconstants,
+                               const struct ToneMapConstants* tonemap,
+                               int width);
+void I210ToARGBToneMapRow_Any_AVX2(const uint16_t* y_buf,
+                                   const uint16_t* u_buf,
+                                   const uint16_t* v_buf,
+                                   uint8_t* dst_ptr,
+                                   const struct YuvConstants* yuvconstants,
+                                   const struct ToneMapConstants* tonemap,
+                                   int width);
+void P210ToARGBToneMapRow_C(const uint16_t* src_y,
+                            const uint16_t* src_uv,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            const struct ToneMapConstants* tonemap,
+                            int width);
+void P210ToARGBToneMapRow_AVX2(const uint16_t* y_buf,
+                               const uint16_t* uv_buf,
+                               uint8_t* dst_argb,
+                               const struct YuvConstants* yuvconstants,
+                               const struct ToneMapConstants* tonemap,
+                               int width);
+void P210ToARGBToneMapRow_Any_AVX2(const uint16_t* y_buf,
+                                   const uint16_t* uv_buf,
+                                   uint8_t* dst_ptr,
+                                   const struct YuvConstants* yuvconstants,
+                                   const struct ToneMapConstants* tonemap,
+                                   int width);
 void I400ToARGBRow_Any_SSE2(const uint8_t* src_ptr,
                             uint8_t* dst_ptr,
                             const struct YuvConstants* param,
@@ -4833,6 +5198,36 @@ void InterpolateRow_16_C(uint16_t* dst_ptr,
                          ptrdiff_t src_stride,
                          int width,
                          int source_y_fraction);
+void InterpolateRow_16_SSE2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+void InterpolateRow_16_AVX2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+void InterpolateRow_16_NEON(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int width,
+                            int source_y_fraction);
+void InterpolateRow_16_Any_SSE2(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
+void InterpolateRow_16_Any_AVX2(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
+void InterpolateRow_16_Any_NEON(uint16_t* dst_ptr,
+                                const uint16_t* src_ptr,
+                                ptrdiff_t src_stride,
+                                int width,
+                                int source_y_fraction);
 
 // Sobel images.
 void SobelXRow_C(const uint8_t* src_y0,
@@ -5070,6 +5465,47 @@ void ByteToFloatRow_Any_NEON(const uint8_t* src_ptr,
                              float param,
                              int width);
 
+// Normalize to float for RGB tensors.  ARGBToRGBFloatRow writes planar R, G
+// and B and RAWToFloatRow writes packed RGB.
+void ARGBToRGBFloatRow_C(const uint8_t* src_argb,
+                         float* dst_r,
+                         float* dst_g,
+                         float* dst_b,
+                         const struct RGBNormConstants* norm,
+                         int width);
+void ARGBToRGBFloatRow_AVX2(const uint8_t* src_argb,
+                            float* dst_r,
+                            float* dst_g,
+                            float* dst_b,
+                            const struct RGBNormConstants* norm,
+                            int width);
+void ARGBToRGBFloatRow_Any_AVX2(const uint8_t* src_ptr,
+                                float* dst_r,
+                                float* dst_g,
+                                float* dst_b,
+                                const struct RGBNormConstants* param,
+                                int width);
+void RAWToFloatRow_C(const uint8_t* src_raw,
+                     float* dst,
+                     const struct RGBNormConstants* norm,
+                     int width);
+void RAWToFloatRow_AVX2(const uint8_t* src_raw,
+                        float* dst,
+                        const struct RGBNormConstants* norm,
+                        int width);
+void RAWToFloatRow_Any_AVX2(const uint8_t* src_ptr,
+                            float* dst_ptr,
+                            const struct RGBNormConstants* param,
+                            int width);
+
+// Convert floats to half floats, with rounding toward zero.  Values beyond
+// the half float range are clamped to +-65504.
+void FloatToHalfRow_C(const float* src, uint16_t* dst, int width);
+void FloatToHalfRow_AVX2(const float* src, uint16_t* dst, int width);
+void FloatToHalfRow_Any_AVX2(const float* src_ptr,
+                             uint16_t* dst_ptr,
+                             int width);
+
 void ARGBLumaColorTableRow_C(const uint8_t* src_argb,
                              uint8_t* dst_argb,
                              int width,
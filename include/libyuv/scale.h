@@ -23,9 +23,16 @@ typedef enum FilterMode {
   kFilterNone = 0,      // Point sample; Fastest.
   kFilterLinear = 1,    // Filter horizontally only.
   kFilterBilinear = 2,  // Faster than box, but lower quality scaling down.
-  kFilterBox = 3        // Highest quality.
+  kFilterBox = 3,       // Highest quality when scaling down by 2x or more.
+  kFilterBicubic = 4,   // Catmull-Rom cubic, 4 taps when scaling up.
+  kFilterLanczos = 5    // Lanczos 3, 6 taps when scaling up.  Sharpest.
 } FilterModeEnum;
 
+// kFilterBicubic and kFilterLanczos are separable polyphase filters for 8 bit
+// planes, UV planes and ARGB.  Scaling down stretches the filter over the
+// source pixels of each destination pixel.  16 bit planes use kFilterBox for
+// these modes.
+
 // Scale a YUV plane.
 LIBYUV_API
 void ScalePlane(const uint8_t* src,
@@ -195,14 +202,76 @@ int I444Scale_12(const uint16_t* src_y,
                  int dst_height,
                  enum FilterMode filtering);
 
+// Scales a YUV 4:2:2 image from the src width and height to the
+// dst width and height.  The U and V planes are half width and full height.
+// Filtering is as for I420Scale.
+// Returns 0 if successful.
+
+LIBYUV_API
+int I422Scale(const uint8_t* src_y,
+              int src_stride_y,
+              const uint8_t* src_u,
+              int src_stride_u,
+              const uint8_t* src_v,
+              int src_stride_v,
+              int src_width,
+              int src_height,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_u,
+              int dst_stride_u,
+              uint8_t* dst_v,
+              int dst_stride_v,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering);
+
+LIBYUV_API
+int I422Scale_16(const uint16_t* src_y,
+                 int src_stride_y,
+                 const uint16_t* src_u,
+                 int src_stride_u,
+                 const uint16_t* src_v,
+                 int src_stride_v,
+                 int src_width,
+                 int src_height,
+                 uint16_t* dst_y,
+                 int dst_stride_y,
+                 uint16_t* dst_u,
+                 int dst_stride_u,
+                 uint16_t* dst_v,
+                 int dst_stride_v,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering);
+
+LIBYUV_API
+int I422Scale_12(const uint16_t* src_y,
+                 int src_stride_y,
+                 const uint16_t* src_u,
+                 int src_stride_u,
+                 const uint16_t* src_v,
+                 int src_stride_v,
+                 int src_width,
+                 int src_height,
+                 uint16_t* dst_y,
+                 int dst_stride_y,
+                 uint16_t* dst_u,
+                 int dst_stride_u,
+                 uint16_t* dst_v,
+                 int dst_stride_v,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering);
+
 // Scales an NV12 image from the src width and height to the
 // dst width and height.
 // If filtering is kFilterNone, a simple nearest-neighbor algorithm is
 // used. This produces basic (blocky) quality at the fastest speed.
 // If filtering is kFilterBilinear, interpolation is used to produce a better
 // quality image, at the expense of speed.
-// kFilterBox is not supported for the UV channel and will be treated as
-// bilinear.
+// If filtering is kFilterBox, the interleaved UV channel is box filtered
+// like the Y plane.
 // Returns 0 if successful.
 
 LIBYUV_API
@@ -220,6 +289,423 @@ int NV12Scale(const uint8_t* src_y,
               int dst_height,
               enum FilterMode filtering);
 
+// Scales an NV16 image, which has a half width and full height UV plane.
+// Filtering is as for NV12Scale.
+// Returns 0 if successful.
+
+LIBYUV_API
+int NV16Scale(const uint8_t* src_y,
+              int src_stride_y,
+              const uint8_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering);
+
+// Scales a P010 or P210 image.  These are the 16 bit versions of NV12 and
+// NV16, with 10 bit samples in the upper bits of each 16 bit word.  P012 and
+// P016 have the same layout and may use these functions too.  The UV plane is
+// scaled as interleaved pairs without splitting it into planes.  kFilterBox
+// is treated as bilinear for the UV plane.
+// Returns 0 if successful.
+
+LIBYUV_API
+int P010Scale(const uint16_t* src_y,
+              int src_stride_y,
+              const uint16_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint16_t* dst_y,
+              int dst_stride_y,
+              uint16_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering);
+
+LIBYUV_API
+int P210Scale(const uint16_t* src_y,
+              int src_stride_y,
+              const uint16_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint16_t* dst_y,
+              int dst_stride_y,
+              uint16_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering);
+
+// Variants of the plane and image scalers that take their row buffers from a
+// caller supplied scratch instead of allocating them on each call.
+// ScalePlaneScratchSize returns the scratch size in bytes needed to scale a
+// plane without allocating, and ScalePlaneScratchSize_16 that of a 16 bit
+// plane.  I420ScaleScratchSize and NV12ScaleScratchSize cover all the planes
+// of an image.  An I444 image needs the ScalePlaneScratchSize of its Y plane,
+// an I422 image the larger of those of its Y and U planes, and the 16 and 12
+// bit images the ScalePlaneScratchSize_16 of the same planes.
+
+LIBYUV_API
+int ScalePlaneScratchSize(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int ScalePlaneScratchSize_16(int src_width,
+                             int src_height,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering);
+
+LIBYUV_API
+void ScalePlane_WithScratch(const uint8_t* src,
+                            int src_stride,
+                            int src_width,
+                            int src_height,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I420Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch);
+
+LIBYUV_API
+void ScalePlane_16_WithScratch(const uint16_t* src,
+                               int src_stride,
+                               int src_width,
+                               int src_height,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int dst_width,
+                               int dst_height,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch);
+
+LIBYUV_API
+void ScalePlane_12_WithScratch(const uint16_t* src,
+                               int src_stride,
+                               int src_width,
+                               int src_height,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int dst_width,
+                               int dst_height,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I420Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I420Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I444Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I444Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I444Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I422Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I422Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int I422Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch);
+
+LIBYUV_API
+int NV12ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering);
+
+LIBYUV_API
+int NV12Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_uv,
+                          int dst_stride_uv,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch);
+
+// Threaded variants of ScalePlane and I420Scale.
+// The destination is split into up to num_jobs horizontal bands per plane,
+// which are scaled as independent jobs through the caller supplied dispatch
+// function.  Output is bit exact with the single threaded functions for all
+// filter modes.  If dispatch is NULL or num_jobs is 1 or less, the scale runs
+// on the calling thread.
+
+LIBYUV_API
+void ScalePlaneThreaded(const uint8_t* src,
+                        int src_stride,
+                        int src_width,
+                        int src_height,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque);
+
+LIBYUV_API
+int I420ScaleThreaded(const uint8_t* src_y,
+                      int src_stride_y,
+                      const uint8_t* src_u,
+                      int src_stride_u,
+                      const uint8_t* src_v,
+                      int src_stride_v,
+                      int src_width,
+                      int src_height,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int dst_width,
+                      int dst_height,
+                      enum FilterMode filtering,
+                      int num_jobs,
+                      LibyuvDispatchFunc dispatch,
+                      void* dispatch_opaque);
+
+// Pixel layouts supported by ScalePlan.
+enum ScalePlanFormat {
+  kScalePlanPlane = 0,  // A single 8 bit plane.
+  kScalePlanI420 = 1,
+  kScalePlanNV12 = 2,
+  kScalePlanARGB = 3,
+  kScalePlanUV = 4,  // A single interleaved UV plane.
+};
+
+// A ScalePlan holds the validated geometry, the chosen row functions, the
+// polyphase filter tables and the row buffers for scaling many frames of the
+// same size and format, so that each frame only scales rows.  A plan may be
+// used by one thread at a time; create a plan per thread to scale in
+// parallel.
+typedef struct ScalePlan ScalePlan;
+
+// Returns NULL if the geometry is not supported or on allocation failure.
+// src_height may be negative to invert the image.  src_width may be negative
+// to mirror kScalePlanPlane and kScalePlanARGB, as ScalePlane and ARGBScale
+// do; like I420Scale, NV12Scale and UVScale, the other formats return NULL.
+LIBYUV_API
+ScalePlan* ScalePlanCreate(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           enum ScalePlanFormat format);
+
+LIBYUV_API
+void ScalePlanFree(ScalePlan* plan);
+
+// Scale one frame with a plan.  Single plane formats use src_y and dst_y,
+// NV12 uses the u pointers and strides for its UV plane, and I420 uses all 3.
+// Unused pointers may be NULL.
+LIBYUV_API
+int ScalePlanExecute(const ScalePlan* plan,
+                     const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v);
+
 #ifdef __cplusplus
 // Legacy API.  Deprecated.
 LIBYUV_API
@@ -12,7 +12,8 @@
 #define INCLUDE_LIBYUV_SCALE_ARGB_H_
 
 #include "libyuv/basic_types.h"
-#include "libyuv/scale.h"  // For FilterMode
+#include "libyuv/convert_argb.h"  // For YuvConstants
+#include "libyuv/scale.h"         // For FilterMode
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -30,6 +31,44 @@ int ARGBScale(const uint8_t* src_argb,
               int dst_height,
               enum FilterMode filtering);
 
+// ARGBScale using a caller supplied scratch for row buffers.
+// ARGBScaleScratchSize returns the scratch size in bytes it needs.
+LIBYUV_API
+int ARGBScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering);
+
+LIBYUV_API
+int ARGBScale_WithScratch(const uint8_t* src_argb,
+                          int src_stride_argb,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch);
+
+// Scale a batch of ARGB frames.  Each src_frames[i] is scaled to the size of
+// dst_frames[i], using plane 0.  The row buffers of all jobs are allocated
+// once per call, and each job reuses its part for all of its frames.  Each
+// job chooses the scaler once for each run of frames of the same size.  See
+// I420ToARGBMatrixBatch in convert_argb.h for how the batch is split into
+// jobs.
+// Returns 0 on success, or -1 without scaling anything if any frame is
+// invalid.
+LIBYUV_API
+int ARGBScaleBatch(const LibyuvConstFrame* src_frames,
+                   const LibyuvFrame* dst_frames,
+                   int num_frames,
+                   enum FilterMode filtering,
+                   int num_jobs,
+                   LibyuvDispatchFunc dispatch,
+                   void* dispatch_opaque);
+
 // Clipped scale takes destination rectangle coordinates for clip values.
 LIBYUV_API
 int ARGBScaleClip(const uint8_t* src_argb,
@@ -46,6 +85,24 @@ int ARGBScaleClip(const uint8_t* src_argb,
                   int clip_height,
                   enum FilterMode filtering);
 
+// ARGBScaleClip using a caller supplied scratch for row buffers, sized with
+// ARGBScaleScratchSize.
+LIBYUV_API
+int ARGBScaleClip_WithScratch(const uint8_t* src_argb,
+                              int src_stride_argb,
+                              int src_width,
+                              int src_height,
+                              uint8_t* dst_argb,
+                              int dst_stride_argb,
+                              int dst_width,
+                              int dst_height,
+                              int clip_x,
+                              int clip_y,
+                              int clip_width,
+                              int clip_height,
+                              enum FilterMode filtering,
+                              const LibyuvScratch* scratch);
+
 // Scale with YUV conversion to ARGB and clipping.
 LIBYUV_API
 int YUVToARGBScaleClip(const uint8_t* src_y,
@@ -68,6 +125,256 @@ int YUVToARGBScaleClip(const uint8_t* src_y,
                        int clip_height,
                        enum FilterMode filtering);
 
+// YUVToARGBScaleClip using a caller supplied scratch for the ARGB copy of the
+// source and the row buffers.
+// YUVToARGBScaleClipScratchSize returns the scratch size in bytes it needs.
+LIBYUV_API
+int YUVToARGBScaleClipScratchSize(int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  enum FilterMode filtering);
+
+LIBYUV_API
+int YUVToARGBScaleClip_WithScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint32_t src_fourcc,
+                                   int src_width,
+                                   int src_height,
+                                   uint8_t* dst_argb,
+                                   int dst_stride_argb,
+                                   uint32_t dst_fourcc,
+                                   int dst_width,
+                                   int dst_height,
+                                   int clip_x,
+                                   int clip_y,
+                                   int clip_width,
+                                   int clip_height,
+                                   enum FilterMode filtering,
+                                   const LibyuvScratch* scratch);
+
+// Scale I420 or NV12 and convert to RGB in one pass.
+// The Y and UV planes are scaled a strip of rows at a time into small row
+// buffers that are converted as they fill, instead of scaling into a whole
+// intermediate frame.  I420 output matches I420Scale followed by I420ToARGB.
+LIBYUV_API
+int I420ScaleToARGBMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleToARGB(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleToABGR(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleToAR30Matrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int I420ScaleToAR30(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleToARGBMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleToARGB(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleToABGR(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleToAR30Matrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int NV12ScaleToAR30(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+// Scale P010 and convert to RGB in one pass with the 16 bit scalers, which
+// have no polyphase filters.  Output matches P010Scale followed by
+// P010ToARGBMatrix.  The versions without a matrix use BT.2020.
+LIBYUV_API
+int P010ScaleToARGBMatrix(const uint16_t* src_y,
+                          int src_stride_y,
+                          const uint16_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int P010ScaleToARGB(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int P010ScaleToABGR(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
+LIBYUV_API
+int P010ScaleToAR30Matrix(const uint16_t* src_y,
+                          int src_stride_y,
+                          const uint16_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int P010ScaleToAR30(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -47,6 +47,22 @@ extern "C" {
 #endif  // clang >= 3.4
 #endif  // __clang__
 
+// clang >= 6.0.0 required for AVX512.
+#if defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+// clang in xcode follows a different versioning scheme.
+#if (__clang_major__ >= 7) && !defined(__APPLE__)
+#define CLANG_HAS_AVX512 1
+#endif  // clang >= 7
+#endif  // __clang__
+
+// GCC >= 5.0.0 required for AVX512.
+#if defined(__GNUC__) && !defined(__clang__) && \
+    (defined(__x86_64__) || defined(__i386__))
+#if (__GNUC__ >= 5)
+#define GCC_HAS_AVX512 1
+#endif  // GNUC >= 5
+#endif  // __GNUC__
+
 // Visual C 2012 required for AVX2.
 #if defined(_M_IX86) && !defined(__clang__) && defined(_MSC_VER) && \
     _MSC_VER >= 1700
@@ -85,6 +101,9 @@ extern "C" {
 #define HAS_SCALEROWUP2BILINEAR_12_SSSE3
 #define HAS_SCALEROWUP2LINEAR_16_SSE2
 #define HAS_SCALEROWUP2BILINEAR_16_SSE2
+#define HAS_SCALEADDROW_16_SSE2
+#define HAS_SCALEFILTERCOLS_16_SSE2
+#define HAS_SCALEROWDOWN2_16_SSE2
 #define HAS_SCALEUVROWUP2LINEAR_SSSE3
 #define HAS_SCALEUVROWUP2BILINEAR_SSSE3
 #define HAS_SCALEUVROWUP2LINEAR_16_SSE2
@@ -104,12 +123,42 @@ extern "C" {
 #define HAS_SCALEROWUP2BILINEAR_12_AVX2
 #define HAS_SCALEROWUP2LINEAR_16_AVX2
 #define HAS_SCALEROWUP2BILINEAR_16_AVX2
+#define HAS_SCALEADDROW_16_AVX2
+#define HAS_SCALEFILTERCOLS_16_AVX2
+#define HAS_SCALEROWDOWN2_16_AVX2
 #define HAS_SCALEUVROWUP2LINEAR_AVX2
 #define HAS_SCALEUVROWUP2BILINEAR_AVX2
 #define HAS_SCALEUVROWUP2LINEAR_16_AVX2
 #define HAS_SCALEUVROWUP2BILINEAR_16_AVX2
 #endif
 
+// The following are available for gcc/clang x86_64 platforms.  The
+// polyphase filters need more registers than i386 has.
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define HAS_SCALEARGBROWPOLYPHASEH_SSSE3
+#define HAS_SCALEROWPOLYPHASEH_SSSE3
+#define HAS_SCALEROWPOLYPHASEV_SSE2
+#define HAS_SCALEUVROWPOLYPHASEH_SSSE3
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX2) || defined(GCC_HAS_AVX2))
+#define HAS_SCALEARGBFILTERCOLS_AVX2
+#define HAS_SCALEARGBROWPOLYPHASEH_AVX2
+#define HAS_SCALEFILTERCOLS_AVX2
+#define HAS_SCALEROWDOWN34_AVX2
+#define HAS_SCALEROWDOWN38_AVX2
+#define HAS_SCALEROWPOLYPHASEH_AVX2
+#define HAS_SCALEROWPOLYPHASEV_AVX2
+#define HAS_SCALEUVFILTERCOLS_16_AVX2
+#endif
+#if !defined(LIBYUV_DISABLE_X86) && defined(__x86_64__) && \
+    (defined(CLANG_HAS_AVX512) || defined(GCC_HAS_AVX512))
+#define HAS_SCALEARGBFILTERCOLS_AVX512BW
+#define HAS_SCALEFILTERCOLS_AVX512BW
+#define HAS_SCALEROWDOWN38_AVX512BW
+#endif
+
 // The following are available on all x86 platforms, but
 // require VS2012, clang 3.4 or gcc 4.7.
 // The code supports NaCL but requires a new compiler and validator.
@@ -148,6 +197,18 @@ extern "C" {
 #define HAS_SCALEUVROWUP2BILINEAR_16_NEON
 #endif
 
+#if !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
+#define HAS_SCALEARGBROWPOLYPHASEH_NEON
+#define HAS_SCALEROWPOLYPHASEH_NEON
+#define HAS_SCALEROWPOLYPHASEV_NEON
+#define HAS_SCALEUVROWPOLYPHASEH_NEON
+// TODO: Enable the 16 bit rows once they pass the unit tests on AArch64.
+// They have not been built or run there yet.
+// #define HAS_SCALEADDROW_16_NEON
+// #define HAS_SCALEFILTERCOLS_16_NEON
+// #define HAS_SCALEROWDOWN2_16_NEON
+#endif
+
 #if !defined(LIBYUV_DISABLE_MSA) && defined(__mips_msa)
 #define HAS_SCALEADDROW_MSA
 #define HAS_SCALEARGBCOLS_MSA
@@ -193,6 +254,25 @@ void ScalePlaneVertical(int src_height,
                         int bpp,
                         enum FilterMode filtering);
 
+// Rows of ScalePlaneVertical with a row function chosen by the caller.  src
+// points to the first column of source row src_y.
+void ScalePlaneVerticalRows(int src_height,
+                            int dst_width_bytes,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_argb,
+                            int src_y,
+                            uint8_t* dst_argb,
+                            int y,
+                            int dy,
+                            enum FilterMode filtering,
+                            void (*InterpolateRow)(uint8_t* dst_ptr,
+                                                   const uint8_t* src_ptr,
+                                                   ptrdiff_t src_stride,
+                                                   int dst_width,
+                                                   int source_y_fraction));
+
 void ScalePlaneVertical_16(int src_height,
                            int dst_width,
                            int dst_height,
@@ -243,6 +323,530 @@ void ScaleSlope(int src_width,
                 int* dx,
                 int* dy);
 
+// The taps and row functions of a kFilterBicubic or kFilterLanczos polyphase
+// scale of 1, 2 or 4 byte pixels.  The window starts and coefficients are
+// built for each call to ScalePolyphaseRows, unless ScalePolyphaseTables or
+// ScalePolyphaseAllocTables has built them once for the whole destination.
+typedef struct ScalePolyphaseFilter {
+  int src_width;  // Negative to mirror.
+  int src_height;
+  int dst_width;
+  int dst_height;
+  int bpp;
+  enum FilterMode filtering;
+  int taps_x;    // Horizontal taps, a multiple of 4.
+  int taps_y;    // Vertical taps, a multiple of 2.
+  int window_y;  // Source rows that contribute to a destination row.
+  int v_align;   // ScaleRowPolyphaseV writes a multiple of v_align bytes.
+  void (*ScaleRowPolyphaseH)(const uint8_t* src_ptr,
+                             int16_t* dst_ptr,
+                             const int16_t* coeffs,
+                             const int* starts,
+                             int dst_width,
+                             int taps);
+  void (*ScaleRowPolyphaseV)(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps);
+  const int* x_starts;  // Tables of ScalePolyphaseTables, or NULL.
+  const int16_t* x_coeffs;
+  const int* y_starts;
+  const int16_t* y_coeffs;
+  uint8_t* tables_mem;  // Owned by ScalePolyphaseAllocTables, or NULL.
+  int16_t* ring;        // Rows of ScalePolyphaseRing, or NULL.
+  int* ring_ids;
+} ScalePolyphaseFilter;
+
+// src_height must be positive.
+void ScalePolyphaseInit(ScalePolyphaseFilter* f,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int bpp,
+                        enum FilterMode filtering);
+
+// Size of the tables of ScalePolyphaseTables, or 0 if it is too large.
+int ScalePolyphaseTablesSize(const ScalePolyphaseFilter* f);
+
+// Build the tables into ScalePolyphaseTablesSize bytes at tables, which
+// must be 64 byte aligned and outlive f.
+void ScalePolyphaseTables(ScalePolyphaseFilter* f, uint8_t* tables);
+
+// Build the tables into memory owned by f, released by ScalePolyphaseFree.
+// If they are too large or cannot be allocated, f builds them per call.
+void ScalePolyphaseAllocTables(ScalePolyphaseFilter* f);
+void ScalePolyphaseFree(ScalePolyphaseFilter* f);
+
+// Size of the ring of ScalePolyphaseRing, or 0 if it is too large.
+int ScalePolyphaseRingSize(const ScalePolyphaseFilter* f);
+
+// Keep the horizontally filtered source rows of full width clips in
+// ScalePolyphaseRingSize bytes at ring, which must be 64 byte aligned and
+// outlive f, so that the clips of a frame filter the rows they share once.
+// Call ScalePolyphaseRingReset before each frame.
+void ScalePolyphaseRing(ScalePolyphaseFilter* f, uint8_t* ring);
+void ScalePolyphaseRingReset(const ScalePolyphaseFilter* f);
+
+// Scale the clip rectangle of a plane.  src points to source row src_y, and
+// only the rows the clip reads are addressed.  dst points to the clip
+// rectangle.  clip_x must be a multiple of 8 for 1 byte pixels.
+void ScalePolyphaseRows(const ScalePolyphaseFilter* f,
+                        const uint8_t* src,
+                        int src_stride,
+                        int src_y,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int clip_x,
+                        int clip_y,
+                        int clip_width,
+                        int clip_height,
+                        const LibyuvScratch* scratch);
+
+// The method, slope and row functions of a plane scale, chosen once by
+// ScalePlaneScalerInit so that ScalePlaneScalerRows can scale any number of
+// frames or clips of the same geometry.  Init also builds the polyphase
+// tables, which the scaler owns until ScalePlaneScalerFree.
+enum ScalePlaneMethod {
+  kScalePlaneCopy,
+  kScalePlanePolyphase,
+  kScalePlaneVertical,
+  kScalePlaneDown34,
+  kScalePlaneDown2,
+  kScalePlaneDown38,
+  kScalePlaneDown4,
+  kScalePlaneBox,
+  kScalePlaneUp2Linear,
+  kScalePlaneUp2Bilinear,
+  kScalePlaneBilinearUp,
+  kScalePlaneBilinearDown,
+  kScalePlaneSimple,
+};
+
+typedef struct ScalePlaneScaler {
+  enum ScalePlaneMethod method;
+  int src_width;  // Negative to mirror.
+  int src_height;  // Negative to invert.
+  int dst_width;
+  int dst_height;
+  enum FilterMode filtering;  // As reduced by ScaleFilterReduce.
+  // Source position of the first destination pixel and step, as 16.16.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  // Down2 and Down4 rows, or the first row of each group of Down34 and Down38.
+  void (*ScaleRowDown)(const uint8_t* src_ptr,
+                       ptrdiff_t src_stride,
+                       uint8_t* dst_ptr,
+                       int dst_width);
+  // The other rows of each group of Down34 and Down38.
+  void (*ScaleRowDownAlt)(const uint8_t* src_ptr,
+                          ptrdiff_t src_stride,
+                          uint8_t* dst_ptr,
+                          int dst_width);
+  void (*InterpolateRow)(uint8_t* dst_ptr,
+                         const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         int dst_width,
+                         int source_y_fraction);
+  void (*ScaleCols)(uint8_t* dst_ptr,
+                    const uint8_t* src_ptr,
+                    int dst_width,
+                    int x,
+                    int dx);
+  void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr, int src_width);
+  void (*ScaleAddCols)(int dst_width,
+                       int boxheight,
+                       int x,
+                       int dx,
+                       const uint16_t* src_ptr,
+                       uint8_t* dst_ptr);
+  void (*ScaleRowUp2)(const uint8_t* src_ptr, uint8_t* dst_ptr, int dst_width);
+  void (*Scale2RowUp2)(const uint8_t* src_ptr,
+                       ptrdiff_t src_stride,
+                       uint8_t* dst_ptr,
+                       ptrdiff_t dst_stride,
+                       int dst_width);
+  ScalePolyphaseFilter polyphase;
+} ScalePlaneScaler;
+
+void ScalePlaneScalerInit(ScalePlaneScaler* s,
+                          int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+void ScalePlaneScalerFree(ScalePlaneScaler* s);
+
+// Scale rows [clip_y, clip_y + clip_height) of a plane.  src points to source
+// row src_y, which is 0 for an inverted plane, and may hold only the rows the
+// clip reads.  dst points to row clip_y.  Clips must be aligned as described
+// by ScalePlaneScalerAlign.
+void ScalePlaneScalerRows(const ScalePlaneScaler* s,
+                          const uint8_t* src,
+                          int src_stride,
+                          int src_y,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int clip_y,
+                          int clip_height,
+                          const LibyuvScratch* scratch);
+
+// Scale rows [clip_y, clip_y + clip_height) of a plane, exactly as ScalePlane
+// would.  dst points to row clip_y.
+void ScalePlaneClip(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int clip_y,
+                    int clip_height,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch);
+
+// Row alignment of the clips of a scaler, from the method it chose.
+void ScalePlaneScalerAlign(const ScalePlaneScaler* s, int* align, int* offset);
+
+// Row alignment of clips passed to ScalePlaneClip.
+void ScalePlaneClipAlign(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering,
+                         int* align,
+                         int* offset);
+
+// Scale rows [clip_y, clip_y + clip_height) of a 16 bit plane, exactly as
+// ScalePlane_16 would.  dst points to row clip_y.
+void ScalePlaneClip_16(const uint16_t* src,
+                       int src_stride,
+                       int src_width,
+                       int src_height,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int dst_width,
+                       int dst_height,
+                       int clip_y,
+                       int clip_height,
+                       enum FilterMode filtering,
+                       const LibyuvScratch* scratch);
+
+// Row alignment of clips passed to ScalePlaneClip_16.
+void ScalePlaneClipAlign_16(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            int* align,
+                            int* offset);
+
+// The method, slope and row functions of an ARGB scale, chosen once by
+// ScaleARGBScalerInit for a column clip of the destination.  Init also builds
+// the polyphase tables, which the scaler owns until ScaleARGBScalerFree.
+enum ScaleARGBMethod {
+  kScaleARGBPolyphase,
+  kScaleARGBDown2,
+  kScaleARGBDown4Box,
+  kScaleARGBDownEven,
+  kScaleARGBCopy,
+  kScaleARGBVertical,
+  kScaleARGBBilinearUp,
+  kScaleARGBBilinearDown,
+  kScaleARGBSimple,
+};
+
+typedef struct ScaleARGBScaler {
+  enum ScaleARGBMethod method;
+  int src_width;  // Negative to mirror.
+  int src_height;  // Negative to invert.
+  int dst_width;
+  int dst_height;
+  int clip_x;
+  int clip_width;
+  enum FilterMode filtering;  // As reduced for the method.
+  // Source position of the first destination pixel of the clip columns,
+  // relative to src_offset, and step, as 16.16.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  int src_offset;  // Bytes from the first source column to the clip columns.
+  int row_bytes;   // Source bytes interpolated by ScaleARGBBilinearDown.
+  void (*ScaleARGBRowDown2)(const uint8_t* src_argb,
+                            ptrdiff_t src_stride,
+                            uint8_t* dst_argb,
+                            int dst_width);
+  void (*ScaleARGBRowDownEven)(const uint8_t* src_argb,
+                               ptrdiff_t src_stride,
+                               int src_stepx,
+                               uint8_t* dst_argb,
+                               int dst_width);
+  void (*InterpolateRow)(uint8_t* dst_argb,
+                         const uint8_t* src_argb,
+                         ptrdiff_t src_stride,
+                         int dst_width,
+                         int source_y_fraction);
+  void (*ScaleARGBCols)(uint8_t* dst_argb,
+                        const uint8_t* src_argb,
+                        int dst_width,
+                        int x,
+                        int dx);
+  ScalePolyphaseFilter polyphase;
+} ScaleARGBScaler;
+
+void ScaleARGBScalerInit(ScaleARGBScaler* s,
+                         int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         int clip_x,
+                         int clip_width,
+                         enum FilterMode filtering);
+void ScaleARGBScalerFree(ScaleARGBScaler* s);
+
+// Scale rows [clip_y, clip_y + clip_height) of the clip columns of an ARGB
+// image.  dst points to the clip rectangle.
+void ScaleARGBScalerRows(const ScaleARGBScaler* s,
+                         const uint8_t* src,
+                         int src_stride,
+                         uint8_t* dst,
+                         int dst_stride,
+                         int clip_y,
+                         int clip_height,
+                         const LibyuvScratch* scratch);
+
+// Scale the clip rectangle of a plane of 1, 2 or 4 byte pixels with the
+// kFilterBicubic or kFilterLanczos polyphase filter.  dst points to the clip
+// rectangle.  A negative src_width mirrors; src_height must be positive.
+void ScalePolyphase(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int clip_x,
+                    int clip_y,
+                    int clip_width,
+                    int clip_height,
+                    int bpp,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch);
+
+// Size of the scratch buffer used by ScalePolyphase.
+int ScalePolyphaseScratchSize(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              int bpp,
+                              enum FilterMode filtering);
+
+// Scale the clip rectangle of a UV plane.  dst points to the clip rectangle.
+void ScaleUV(const uint8_t* src,
+             int src_stride,
+             int src_width,
+             int src_height,
+             uint8_t* dst,
+             int dst_stride,
+             int dst_width,
+             int dst_height,
+             int clip_x,
+             int clip_y,
+             int clip_width,
+             int clip_height,
+             enum FilterMode filtering,
+             const LibyuvScratch* scratch);
+
+// Scale rows [clip_y, clip_y + clip_height) of a 16 bit UV plane, exactly as
+// UVScale_16 would.  dst_uv points to row clip_y.
+void UVScaleClip_16(const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint16_t* dst_uv,
+                    int dst_stride_uv,
+                    int dst_width,
+                    int dst_height,
+                    int clip_y,
+                    int clip_height,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch);
+
+// Row alignment of clips passed to UVScaleClip_16.
+void UVScaleClipAlign_16(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering,
+                         int* align,
+                         int* offset);
+
+// The method, slope and row functions of a UV scale, chosen once by
+// ScaleUVScalerInit for a column clip of the destination.  Init also builds
+// the polyphase tables, which the scaler owns until ScaleUVScalerFree.
+enum ScaleUVMethod {
+  kScaleUVPolyphase,
+  kScaleUVBox,
+  kScaleUVDown2,
+  kScaleUVDown4Box,
+  kScaleUVDownEven,
+  kScaleUVCopy,
+  kScaleUVVertical,
+  kScaleUVLinearUp2,
+  kScaleUVBilinearUp,
+  kScaleUVBilinearDown,
+  kScaleUVSimple,
+};
+
+typedef struct ScaleUVScaler {
+  enum ScaleUVMethod method;
+  // Scale clips that start on row 0 or an odd row and end on an odd row or
+  // the last row with Scale2RowUp2.
+  int bilinear_up2;
+  int src_width;
+  int src_height;  // Negative to invert.
+  int dst_width;
+  int dst_height;
+  int clip_x;
+  int clip_width;
+  enum FilterMode filtering;  // As reduced for the method.
+  // Source position of the first destination pixel of the clip columns,
+  // relative to src_offset, and step, as 16.16.
+  int x;
+  int y;
+  int dx;
+  int dy;
+  int src_offset;  // Bytes from the first source column to the clip columns.
+  int row_bytes;   // Source bytes summed or interpolated for each row.
+  void (*ScaleUVRowDown2)(const uint8_t* src_uv,
+                          ptrdiff_t src_stride,
+                          uint8_t* dst_uv,
+                          int dst_width);
+  void (*ScaleUVRowDownEven)(const uint8_t* src_uv,
+                             ptrdiff_t src_stride,
+                             int src_stepx,
+                             uint8_t* dst_uv,
+                             int dst_width);
+  void (*InterpolateRow)(uint8_t* dst_uv,
+                         const uint8_t* src_uv,
+                         ptrdiff_t src_stride,
+                         int dst_width,
+                         int source_y_fraction);
+  void (*ScaleUVCols)(uint8_t* dst_uv,
+                      const uint8_t* src_uv,
+                      int dst_width,
+                      int x,
+                      int dx);
+  void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr, int src_width);
+  void (*ScaleUVAddCols)(int dst_width,
+                         int boxheight,
+                         int x,
+                         int dx,
+                         const uint16_t* src_ptr,
+                         uint8_t* dst_uv);
+  void (*ScaleUVRowUp2)(const uint8_t* src_uv, uint8_t* dst_uv, int dst_width);
+  void (*Scale2RowUp2)(const uint8_t* src_ptr,
+                       ptrdiff_t src_stride,
+                       uint8_t* dst_ptr,
+                       ptrdiff_t dst_stride,
+                       int dst_width);
+  ScalePolyphaseFilter polyphase;
+} ScaleUVScaler;
+
+void ScaleUVScalerInit(ScaleUVScaler* s,
+                       int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       int clip_x,
+                       int clip_width,
+                       enum FilterMode filtering);
+void ScaleUVScalerFree(ScaleUVScaler* s);
+
+// Scale rows [clip_y, clip_y + clip_height) of the clip columns of a UV
+// plane.  src points to source row src_y, which is 0 for an inverted plane.
+// dst points to the clip rectangle.
+void ScaleUVScalerRows(const ScaleUVScaler* s,
+                       const uint8_t* src,
+                       int src_stride,
+                       int src_y,
+                       uint8_t* dst,
+                       int dst_stride,
+                       int clip_y,
+                       int clip_height,
+                       const LibyuvScratch* scratch);
+
+// Scales a plane whose source rows arrive in bands, such as the iMCU rows of
+// a JPEG or the slices of a camera frame.  Source rows are appended to a
+// window that holds only the rows still needed, and each band of destination
+// rows that the window covers is scaled with a scaler chosen once.  Planes of
+// 2 byte pixels are interleaved UV, scaled as UVScale does.
+typedef struct ScaleBandPlane {
+  int src_width;
+  int src_height;
+  int src_rows;  // Most rows appended at a time.
+  int dst_width;
+  int dst_height;
+  int bpp;         // 1, or 2 for UV.
+  int src_stride;  // Bytes per window row, src_width * bpp.
+  enum FilterMode filtering;
+  const LibyuvScratch* scratch;
+  int align;   // Band boundaries, see ScalePlaneScalerAlign.
+  int offset;
+  int margin;  // Source rows read beyond the span of a destination row.
+  uint8_t* window;  // Source rows [window_y, window_end), window_rows long.
+  int window_rows;
+  int window_y;
+  int window_end;
+  int dst_y;  // Next row to scale.
+  ScalePlaneScaler scaler;  // For 1 byte pixels.
+  ScaleUVScaler uv;         // For 2 byte pixels.
+  int ring_size;  // Bytes for ScaleBandPlaneRing, 64 byte aligned.
+} ScaleBandPlane;
+
+// Set up a plane, with window_rows set to the rows window must hold and
+// ring_size to the bytes ScaleBandPlaneRing needs.  The caller points window
+// at src_stride * window_rows bytes.  The scaler builds its polyphase tables
+// once, and ScaleBandPlaneFree releases them.
+void ScaleBandPlaneInit(ScaleBandPlane* p,
+                        int src_width,
+                        int src_height,
+                        int src_rows,
+                        int dst_width,
+                        int dst_height,
+                        int bpp,
+                        enum FilterMode filtering,
+                        const LibyuvScratch* scratch);
+
+// Keep the horizontally filtered rows of a polyphase plane in ring_size bytes
+// at ring, which must be 64 byte aligned and outlive the plane, so that the
+// bands of a frame filter the rows they share once.  Planes without a ring
+// filter them for each band.
+void ScaleBandPlaneRing(ScaleBandPlane* p, uint8_t* ring);
+void ScaleBandPlaneFree(ScaleBandPlane* p);
+
+// Start a new frame.
+void ScaleBandPlaneReset(ScaleBandPlane* p);
+
+// Make room for the next rows, up to src_rows, by first dropping the rows
+// that no remaining destination row reads.  Returns where in the window to
+// write them, or NULL if there are more rows than src_rows, than are left in
+// the plane or than fit in the window.
+uint8_t* ScaleBandAppend(ScaleBandPlane* p, int rows);
+
+// Number of destination rows from dst_y that the window covers, up to
+// max_rows.
+int ScaleBandHeight(const ScaleBandPlane* p, int max_rows);
+
+// Scale the next rows, as returned by ScaleBandHeight, to dst.
+void ScaleBandRows(ScaleBandPlane* p, uint8_t* dst, int dst_stride, int rows);
+
 void ScaleRowDown2_C(const uint8_t* src_ptr,
                      ptrdiff_t src_stride,
                      uint8_t* dst,
@@ -526,6 +1130,16 @@ void ScaleUVCols64_C(uint8_t* dst_uv,
                      int dst_width,
                      int x32,
                      int dx);
+void ScaleUVCols_16_C(uint16_t* dst_uv,
+                      const uint16_t* src_uv,
+                      int dst_width,
+                      int x,
+                      int dx);
+void ScaleUVFilterCols_16_C(uint16_t* dst_uv,
+                            const uint16_t* src_uv,
+                            int dst_width,
+                            int x,
+                            int dx);
 void ScaleUVColsUp2_C(uint8_t* dst_uv,
                       const uint8_t* src_uv,
                       int dst_width,
@@ -608,6 +1222,42 @@ void ScaleRowDown38_2_Box_SSSE3(const uint8_t* src_ptr,
                                 ptrdiff_t src_stride,
                                 uint8_t* dst_ptr,
                                 int dst_width);
+void ScaleRowDown34_AVX2(const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         uint8_t* dst_ptr,
+                         int dst_width);
+void ScaleRowDown34_1_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown34_0_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown38_AVX2(const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         uint8_t* dst_ptr,
+                         int dst_width);
+void ScaleRowDown38_3_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown38_2_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width);
+void ScaleRowDown38_AVX512BW(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+void ScaleRowDown38_3_Box_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_2_Box_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
 
 void ScaleRowUp2_Linear_SSE2(const uint8_t* src_ptr,
                              uint8_t* dst_ptr,
@@ -795,6 +1445,42 @@ void ScaleRowDown38_2_Box_Any_SSSE3(const uint8_t* src_ptr,
                                     ptrdiff_t src_stride,
                                     uint8_t* dst_ptr,
                                     int dst_width);
+void ScaleRowDown34_Any_AVX2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+void ScaleRowDown34_1_Box_Any_AVX2(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown34_0_Box_Any_AVX2(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_Any_AVX2(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_ptr,
+                             int dst_width);
+void ScaleRowDown38_3_Box_Any_AVX2(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_2_Box_Any_AVX2(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width);
+void ScaleRowDown38_Any_AVX512BW(const uint8_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint8_t* dst_ptr,
+                                 int dst_width);
+void ScaleRowDown38_3_Box_Any_AVX512BW(const uint8_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint8_t* dst_ptr,
+                                       int dst_width);
+void ScaleRowDown38_2_Box_Any_AVX512BW(const uint8_t* src_ptr,
+                                       ptrdiff_t src_stride,
+                                       uint8_t* dst_ptr,
+                                       int dst_width);
 
 void ScaleAddRow_SSE2(const uint8_t* src_ptr, uint16_t* dst_ptr, int src_width);
 void ScaleAddRow_AVX2(const uint8_t* src_ptr, uint16_t* dst_ptr, int src_width);
@@ -810,6 +1496,140 @@ void ScaleFilterCols_SSSE3(uint8_t* dst_ptr,
                            int dst_width,
                            int x,
                            int dx);
+void ScaleFilterCols_AVX2(uint8_t* dst_ptr,
+                          const uint8_t* src_ptr,
+                          int dst_width,
+                          int x,
+                          int dx);
+void ScaleFilterCols_AVX512BW(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx);
+void ScaleFilterCols_Any_AVX2(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx);
+void ScaleFilterCols_Any_AVX512BW(uint8_t* dst_ptr,
+                                  const uint8_t* src_ptr,
+                                  int dst_width,
+                                  int x,
+                                  int dx);
+void ScaleFilterCols64_AVX2(uint8_t* dst_ptr,
+                            const uint8_t* src_ptr,
+                            int dst_width,
+                            int x,
+                            int dx);
+void ScaleFilterCols64_AVX512BW(uint8_t* dst_ptr,
+                                const uint8_t* src_ptr,
+                                int dst_width,
+                                int x,
+                                int dx);
+
+void ScaleRowDown2_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width);
+void ScaleRowDown2_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width);
+void ScaleRowDown2_16_Any_SSE2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst,
+                               int dst_width);
+void ScaleRowDown2_16_Any_AVX2(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst,
+                               int dst_width);
+void ScaleRowDown2Linear_16_SSE2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width);
+void ScaleRowDown2Linear_16_AVX2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width);
+void ScaleRowDown2Linear_16_Any_SSE2(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst,
+                                     int dst_width);
+void ScaleRowDown2Linear_16_Any_AVX2(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst,
+                                     int dst_width);
+void ScaleRowDown2Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              int dst_width);
+void ScaleRowDown2Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              int dst_width);
+void ScaleRowDown2Box_16_Any_SSE2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst,
+                                  int dst_width);
+void ScaleRowDown2Box_16_Any_AVX2(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst,
+                                  int dst_width);
+
+void ScaleAddRow_16_SSE2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+void ScaleAddRow_16_AVX2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+void ScaleAddRow_16_Any_SSE2(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+void ScaleAddRow_16_Any_AVX2(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+
+void ScaleFilterCols_16_SSE2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx);
+void ScaleFilterCols_16_AVX2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx);
+void ScaleFilterCols_16_Any_SSE2(uint16_t* dst_ptr,
+                                 const uint16_t* src_ptr,
+                                 int dst_width,
+                                 int x,
+                                 int dx);
+void ScaleFilterCols_16_Any_AVX2(uint16_t* dst_ptr,
+                                 const uint16_t* src_ptr,
+                                 int dst_width,
+                                 int x,
+                                 int dx);
+void ScaleFilterCols64_16_SSE2(uint16_t* dst_ptr,
+                               const uint16_t* src_ptr,
+                               int dst_width,
+                               int x,
+                               int dx);
+void ScaleFilterCols64_16_AVX2(uint16_t* dst_ptr,
+                               const uint16_t* src_ptr,
+                               int dst_width,
+                               int x,
+                               int dx);
+void ScaleUVFilterCols_16_AVX2(uint16_t* dst_uv,
+                               const uint16_t* src_uv,
+                               int dst_width,
+                               int x,
+                               int dx);
+void ScaleUVFilterCols_16_Any_AVX2(uint16_t* dst_uv,
+                                   const uint16_t* src_uv,
+                                   int dst_width,
+                                   int x,
+                                   int dx);
+
 void ScaleColsUp2_SSE2(uint8_t* dst_ptr,
                        const uint8_t* src_ptr,
                        int dst_width,
@@ -827,6 +1647,26 @@ void ScaleARGBFilterCols_SSSE3(uint8_t* dst_argb,
                                int dst_width,
                                int x,
                                int dx);
+void ScaleARGBFilterCols_AVX2(uint8_t* dst_argb,
+                              const uint8_t* src_argb,
+                              int dst_width,
+                              int x,
+                              int dx);
+void ScaleARGBFilterCols_AVX512BW(uint8_t* dst_argb,
+                                  const uint8_t* src_argb,
+                                  int dst_width,
+                                  int x,
+                                  int dx);
+void ScaleARGBFilterCols_Any_AVX2(uint8_t* dst_ptr,
+                                  const uint8_t* src_ptr,
+                                  int dst_width,
+                                  int x,
+                                  int dx);
+void ScaleARGBFilterCols_Any_AVX512BW(uint8_t* dst_ptr,
+                                      const uint8_t* src_ptr,
+                                      int dst_width,
+                                      int x,
+                                      int dx);
 void ScaleARGBColsUp2_SSE2(uint8_t* dst_argb,
                            const uint8_t* src_argb,
                            int dst_width,
@@ -1520,6 +2360,49 @@ void ScaleFilterCols_Any_NEON(uint8_t* dst_ptr,
                               int x,
                               int dx);
 
+void ScaleRowDown2_16_NEON(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width);
+void ScaleRowDown2_16_Any_NEON(const uint16_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint16_t* dst,
+                               int dst_width);
+void ScaleRowDown2Linear_16_NEON(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width);
+void ScaleRowDown2Linear_16_Any_NEON(const uint16_t* src_ptr,
+                                     ptrdiff_t src_stride,
+                                     uint16_t* dst,
+                                     int dst_width);
+void ScaleRowDown2Box_16_NEON(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              int dst_width);
+void ScaleRowDown2Box_16_Any_NEON(const uint16_t* src_ptr,
+                                  ptrdiff_t src_stride,
+                                  uint16_t* dst,
+                                  int dst_width);
+
+void ScaleAddRow_16_NEON(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width);
+void ScaleAddRow_16_Any_NEON(const uint16_t* src_ptr,
+                             uint32_t* dst_ptr,
+                             int src_width);
+
+void ScaleFilterCols_16_NEON(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx);
+void ScaleFilterCols_16_Any_NEON(uint16_t* dst_ptr,
+                                 const uint16_t* src_ptr,
+                                 int dst_width,
+                                 int x,
+                                 int dx);
+
 void ScaleRowDown2_MSA(const uint8_t* src_ptr,
                        ptrdiff_t src_stride,
                        uint8_t* dst,
@@ -1719,6 +2602,95 @@ void ScaleRowDown4Box_Any_MMI(const uint8_t* src_ptr,
 void ScaleAddRow_Any_MMI(const uint8_t* src_ptr,
                          uint16_t* dst_ptr,
                          int src_width);
+// Polyphase filter rows.  The horizontal filters write 16 bit samples with 6
+// fractional bits and the vertical filter reads taps of those rows.
+void ScaleRowPolyphaseH_C(const uint8_t* src_ptr,
+                          int16_t* dst_ptr,
+                          const int16_t* coeffs,
+                          const int* starts,
+                          int dst_width,
+                          int taps);
+void ScaleRowPolyphaseH_SSSE3(const uint8_t* src_ptr,
+                              int16_t* dst_ptr,
+                              const int16_t* coeffs,
+                              const int* starts,
+                              int dst_width,
+                              int taps);
+void ScaleRowPolyphaseH_AVX2(const uint8_t* src_ptr,
+                             int16_t* dst_ptr,
+                             const int16_t* coeffs,
+                             const int* starts,
+                             int dst_width,
+                             int taps);
+void ScaleRowPolyphaseH_NEON(const uint8_t* src_ptr,
+                             int16_t* dst_ptr,
+                             const int16_t* coeffs,
+                             const int* starts,
+                             int dst_width,
+                             int taps);
+void ScaleUVRowPolyphaseH_C(const uint8_t* src_uv,
+                            int16_t* dst_ptr,
+                            const int16_t* coeffs,
+                            const int* starts,
+                            int dst_width,
+                            int taps);
+void ScaleUVRowPolyphaseH_SSSE3(const uint8_t* src_uv,
+                                int16_t* dst_ptr,
+                                const int16_t* coeffs,
+                                const int* starts,
+                                int dst_width,
+                                int taps);
+void ScaleUVRowPolyphaseH_NEON(const uint8_t* src_uv,
+                               int16_t* dst_ptr,
+                               const int16_t* coeffs,
+                               const int* starts,
+                               int dst_width,
+                               int taps);
+void ScaleARGBRowPolyphaseH_C(const uint8_t* src_argb,
+                              int16_t* dst_ptr,
+                              const int16_t* coeffs,
+                              const int* starts,
+                              int dst_width,
+                              int taps);
+void ScaleARGBRowPolyphaseH_SSSE3(const uint8_t* src_argb,
+                                  int16_t* dst_ptr,
+                                  const int16_t* coeffs,
+                                  const int* starts,
+                                  int dst_width,
+                                  int taps);
+void ScaleARGBRowPolyphaseH_AVX2(const uint8_t* src_argb,
+                                 int16_t* dst_ptr,
+                                 const int16_t* coeffs,
+                                 const int* starts,
+                                 int dst_width,
+                                 int taps);
+void ScaleARGBRowPolyphaseH_NEON(const uint8_t* src_argb,
+                                 int16_t* dst_ptr,
+                                 const int16_t* coeffs,
+                                 const int* starts,
+                                 int dst_width,
+                                 int taps);
+void ScaleRowPolyphaseV_C(const int16_t* const* src_rows,
+                          uint8_t* dst_ptr,
+                          const int16_t* coeffs,
+                          int dst_width,
+                          int taps);
+void ScaleRowPolyphaseV_SSE2(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps);
+void ScaleRowPolyphaseV_AVX2(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps);
+void ScaleRowPolyphaseV_NEON(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
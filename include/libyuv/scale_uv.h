@@ -30,8 +30,31 @@ int UVScale(const uint8_t* src_uv,
             int dst_height,
             enum FilterMode filtering);
 
+// UVScale using a caller supplied scratch for row buffers.
+// UVScaleScratchSize returns the scratch size in bytes it needs.
+LIBYUV_API
+int UVScaleScratchSize(int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       enum FilterMode filtering);
+
+LIBYUV_API
+int UVScale_WithScratch(const uint8_t* src_uv,
+                        int src_stride_uv,
+                        int src_width,
+                        int src_height,
+                        uint8_t* dst_uv,
+                        int dst_stride_uv,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering,
+                        const LibyuvScratch* scratch);
+
 // Scale a 16 bit UV image.
 // This function is currently incomplete, it can't handle all cases.
+// The box and polyphase filters are 8 bit only, so kFilterBox, kFilterBicubic
+// and kFilterLanczos scale as kFilterBilinear.
 LIBYUV_API
 int UVScale_16(const uint16_t* src_uv,
                int src_stride_uv,
@@ -43,6 +66,27 @@ int UVScale_16(const uint16_t* src_uv,
                int dst_height,
                enum FilterMode filtering);
 
+// UVScale_16 using a caller supplied scratch for row buffers.
+// UVScaleScratchSize_16 returns the scratch size in bytes it needs.
+LIBYUV_API
+int UVScaleScratchSize_16(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering);
+
+LIBYUV_API
+int UVScale_16_WithScratch(const uint16_t* src_uv,
+                           int src_stride_uv,
+                           int src_width,
+                           int src_height,
+                           uint16_t* dst_uv,
+                           int dst_stride_uv,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           const LibyuvScratch* scratch);
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -0,0 +1,144 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef INCLUDE_LIBYUV_SLICE_H_
+#define INCLUDE_LIBYUV_SLICE_H_
+
+#include "libyuv/basic_types.h"
+#include "libyuv/convert_argb.h"  // For struct YuvConstants.
+#include "libyuv/scale.h"         // For enum FilterMode.
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Slice processing, for frames that arrive a band of rows at a time, such as
+// from a camera that transfers 16 rows at a time.  Rather than waiting for the
+// last band, pass each band to a slice function as it arrives.  Each call
+// writes every destination row that the source rows so far determine, so
+// conversion overlaps with capture.
+//
+// The source pointers of each call point to the first row of the band, which
+// may be in a buffer of its own.  Chroma of the band is the chroma rows of its
+// luma rows, so every band but the last of a frame must have an even number
+// of rows.  The destination pointers point to the whole destination frame.
+//
+// The slice functions return the number of destination rows finished so far,
+// including their chroma, or -1 on error.  When that reaches the destination
+// height the frame is done and the next call starts a new frame.  A band that
+// does not fit the scaler's window is an error that also drops the partly
+// processed frame.
+//
+// I420ScaleSlice gives the same result as I420Scale of the whole frame, and
+// NV12ScaleSlice the same result as NV12Scale, which scales the interleaved UV
+// plane with UVScale.
+// A scaler keeps only the source rows that later destination rows read, so it
+// allocates a few rows per plane, not a frame.
+
+typedef struct SliceContext SliceContext;
+
+// Create a scaler.  max_slice_rows is the most rows a band may have.
+// Returns NULL if the geometry is not supported or on allocation failure.
+LIBYUV_API
+SliceContext* I420ScaleSliceCreate(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   enum FilterMode filtering,
+                                   int max_slice_rows);
+
+LIBYUV_API
+SliceContext* NV12ScaleSliceCreate(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   enum FilterMode filtering,
+                                   int max_slice_rows);
+
+// Create a converter to ARGB with the yuvconstants color matrix, such as
+// &kYuvI601Constants.
+LIBYUV_API
+SliceContext* I420ToARGBSliceCreate(const struct YuvConstants* yuvconstants,
+                                    int width,
+                                    int height);
+
+LIBYUV_API
+SliceContext* NV12ToARGBSliceCreate(const struct YuvConstants* yuvconstants,
+                                    int width,
+                                    int height);
+
+LIBYUV_API
+void SliceFree(SliceContext* slice);
+
+// Drop a partly processed frame, so the next call starts a new frame.
+LIBYUV_API
+void SliceReset(SliceContext* slice);
+
+// Scale the next src_rows rows of an I420 frame.
+LIBYUV_API
+int I420ScaleSlice(SliceContext* slice,
+                   const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_u,
+                   int src_stride_u,
+                   const uint8_t* src_v,
+                   int src_stride_v,
+                   int src_rows,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_u,
+                   int dst_stride_u,
+                   uint8_t* dst_v,
+                   int dst_stride_v);
+
+// Scale the next src_rows rows of an NV12 frame.
+LIBYUV_API
+int NV12ScaleSlice(SliceContext* slice,
+                   const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_uv,
+                   int src_stride_uv,
+                   int src_rows,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_uv,
+                   int dst_stride_uv);
+
+// Convert the next src_rows rows of an I420 frame to ARGB.
+LIBYUV_API
+int I420ToARGBSlice(SliceContext* slice,
+                    const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_rows,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb);
+
+// Convert the next src_rows rows of an NV12 frame to ARGB.
+LIBYUV_API
+int NV12ToARGBSlice(SliceContext* slice,
+                    const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_rows,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb);
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // INCLUDE_LIBYUV_SLICE_H_
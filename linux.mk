@@ -29,6 +29,7 @@ LOCAL_OBJ_FILES := \
 	source/mjpeg_decoder.o     \
 	source/mjpeg_validate.o    \
 	source/planar_functions.o  \
+	source/profile.o           \
 	source/rotate.o            \
 	source/rotate_any.o        \
 	source/rotate_argb.o       \
@@ -58,6 +59,7 @@ LOCAL_OBJ_FILES := \
 	source/scale_neon64.o      \
 	source/scale_uv.o          \
 	source/scale_win.o         \
+	source/slice.o             \
 	source/video_common.o
 
 .cc.o:
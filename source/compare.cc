@@ -10,7 +10,6 @@
 
 #include "libyuv/compare.h"
 
-#include <float.h>
 #include <math.h>
 #ifdef _OPENMP
 #include <omp.h>
@@ -323,62 +322,56 @@ double I420Psnr(const uint8_t* src_y_a,
   return SumSquareErrorToPsnr(sse, samples);
 }
 
-static const int64_t cc1 = 26634;   // (64^2*(.01*255)^2
-static const int64_t cc2 = 239708;  // (64^2*(.03*255)^2
+typedef double (*Ssim8x8Func)(const uint8_t* src_a,
+                              int stride_a,
+                              const uint8_t* src_b,
+                              int stride_b);
 
-static double Ssim8x8_C(const uint8_t* src_a,
-                        int stride_a,
-                        const uint8_t* src_b,
-                        int stride_b) {
-  int64_t sum_a = 0;
-  int64_t sum_b = 0;
-  int64_t sum_sq_a = 0;
-  int64_t sum_sq_b = 0;
-  int64_t sum_axb = 0;
-
-  int i;
-  for (i = 0; i < 8; ++i) {
-    int j;
-    for (j = 0; j < 8; ++j) {
-      sum_a += src_a[j];
-      sum_b += src_b[j];
-      sum_sq_a += src_a[j] * src_a[j];
-      sum_sq_b += src_b[j] * src_b[j];
-      sum_axb += src_a[j] * src_b[j];
-    }
-
-    src_a += stride_a;
-    src_b += stride_b;
+static Ssim8x8Func GetSsim8x8(void) {
+  Ssim8x8Func Ssim8x8 = Ssim8x8_C;
+#if defined(HAS_SSIM8X8_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    Ssim8x8 = Ssim8x8_NEON;
   }
+#endif
+#if defined(HAS_SSIM8X8_SSE41)
+  if (TestCpuFlag(kCpuHasSSE41)) {
+    Ssim8x8 = Ssim8x8_SSE41;
+  }
+#endif
+#if defined(HAS_SSIM8X8_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    Ssim8x8 = Ssim8x8_AVX2;
+  }
+#endif
+  return Ssim8x8;
+}
 
-  {
-    const int64_t count = 64;
-    // scale the constants by number of pixels
-    const int64_t c1 = (cc1 * count * count) >> 12;
-    const int64_t c2 = (cc2 * count * count) >> 12;
-
-    const int64_t sum_a_x_sum_b = sum_a * sum_b;
-
-    const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
-                           (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
-
-    const int64_t sum_a_sq = sum_a * sum_a;
-    const int64_t sum_b_sq = sum_b * sum_b;
-
-    const int64_t ssim_d =
-        (sum_a_sq + sum_b_sq + c1) *
-        (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+// Number of 8x8 windows along a dimension of the given size.
+static int SsimWindows(int size) {
+  return size > 8 ? (size - 5) >> 2 : 0;
+}
 
-    if (ssim_d == 0.0) {
-      return DBL_MAX;
-    }
-    return ssim_n * 1.0 / ssim_d;
-  }
+// Sum of the SSIM of one row of 8x8 windows.
+static double SsimRow(const uint8_t* src_a,
+                      int stride_a,
+                      const uint8_t* src_b,
+                      int stride_b,
+                      int width,
+                      Ssim8x8Func Ssim8x8) {
+  double ssim_row = 0;
+  int j;
+  for (j = 0; j < width - 8; j += 4) {
+    ssim_row += Ssim8x8(src_a + j, stride_a, src_b + j, stride_b);
+  }
+  return ssim_row;
 }
 
 // We are using a 8x8 moving window with starting location of each 8x8 window
 // on the 4x4 pixel grid. Such arrangement allows the windows to overlap
 // block boundaries to penalize blocking artifacts.
+// Each row of windows is summed separately and the row sums are added in
+// order, so bands of rows can be measured in parallel with the same result.
 LIBYUV_API
 double CalcFrameSsim(const uint8_t* src_a,
                      int stride_a,
@@ -386,20 +379,14 @@ double CalcFrameSsim(const uint8_t* src_a,
                      int stride_b,
                      int width,
                      int height) {
-  int samples = 0;
+  int samples = SsimWindows(width) * SsimWindows(height);
   double ssim_total = 0;
-  double (*Ssim8x8)(const uint8_t* src_a, int stride_a, const uint8_t* src_b,
-                    int stride_b) = Ssim8x8_C;
+  Ssim8x8Func Ssim8x8 = GetSsim8x8();
 
   // sample point start with each 4x4 location
   int i;
   for (i = 0; i < height - 8; i += 4) {
-    int j;
-    for (j = 0; j < width - 8; j += 4) {
-      ssim_total += Ssim8x8(src_a + j, stride_a, src_b + j, stride_b);
-      samples++;
-    }
-
+    ssim_total += SsimRow(src_a, stride_a, src_b, stride_b, width, Ssim8x8);
     src_a += stride_a * 4;
     src_b += stride_b * 4;
   }
@@ -434,6 +421,249 @@ double I420Ssim(const uint8_t* src_y_a,
   return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
 }
 
+// A horizontal band of one plane, measured by one job of a threaded PSNR.
+typedef struct {
+  const uint8_t* src_a;
+  int stride_a;
+  const uint8_t* src_b;
+  int stride_b;
+  int width;
+  int height;
+  uint64_t sse;
+} PsnrBand;
+
+static void PsnrBandJob(void* opaque, int index) {
+  PsnrBand* band = (PsnrBand*)(opaque) + index;
+  band->sse = ComputeSumSquareErrorPlane(band->src_a, band->stride_a,
+                                         band->src_b, band->stride_b,
+                                         band->width, band->height);
+}
+
+// Split a plane into at most num_jobs bands of rows.
+// Returns the number of bands written to bands.
+static int PsnrSplitBands(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          int width,
+                          int height,
+                          int num_jobs,
+                          PsnrBand* bands) {
+  int band_height = (height + num_jobs - 1) / num_jobs;
+  int y = 0;
+  int n = 0;
+  while (y < height) {
+    int h = (height - y) < band_height ? (height - y) : band_height;
+    bands[n].src_a = src_a + (ptrdiff_t)y * stride_a;
+    bands[n].stride_a = stride_a;
+    bands[n].src_b = src_b + (ptrdiff_t)y * stride_b;
+    bands[n].stride_b = stride_b;
+    bands[n].width = width;
+    bands[n].height = h;
+    bands[n].sse = 0;
+    y += h;
+    ++n;
+  }
+  return n;
+}
+
+LIBYUV_API
+double I420PsnrThreaded(const uint8_t* src_y_a,
+                        int stride_y_a,
+                        const uint8_t* src_u_a,
+                        int stride_u_a,
+                        const uint8_t* src_v_a,
+                        int stride_v_a,
+                        const uint8_t* src_y_b,
+                        int stride_y_b,
+                        const uint8_t* src_u_b,
+                        int stride_u_b,
+                        const uint8_t* src_v_b,
+                        int stride_v_b,
+                        int width,
+                        int height,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque) {
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  uint64_t samples;
+  uint64_t sse = 0;
+  int num_uv_jobs;
+  PsnrBand* bands;
+  int num_bands;
+  int i;
+  if (!dispatch || num_jobs <= 1 || height <= 1) {
+    return I420Psnr(src_y_a, stride_y_a, src_u_a, stride_u_a, src_v_a,
+                    stride_v_a, src_y_b, stride_y_b, src_u_b, stride_u_b,
+                    src_v_b, stride_v_b, width, height);
+  }
+  if (num_jobs > height) {
+    num_jobs = height;
+  }
+  // The Y plane gets num_jobs bands and each chroma plane half as many.
+  num_uv_jobs = (num_jobs + 1) / 2;
+  bands = (PsnrBand*)malloc((num_jobs + num_uv_jobs * 2) * sizeof(PsnrBand));
+  if (!bands) {
+    return I420Psnr(src_y_a, stride_y_a, src_u_a, stride_u_a, src_v_a,
+                    stride_v_a, src_y_b, stride_y_b, src_u_b, stride_u_b,
+                    src_v_b, stride_v_b, width, height);
+  }
+  num_bands = PsnrSplitBands(src_y_a, stride_y_a, src_y_b, stride_y_b, width,
+                             height, num_jobs, bands);
+  num_bands +=
+      PsnrSplitBands(src_u_a, stride_u_a, src_u_b, stride_u_b, width_uv,
+                     height_uv, num_uv_jobs, bands + num_bands);
+  num_bands +=
+      PsnrSplitBands(src_v_a, stride_v_a, src_v_b, stride_v_b, width_uv,
+                     height_uv, num_uv_jobs, bands + num_bands);
+  dispatch(dispatch_opaque, PsnrBandJob, bands, num_bands);
+  for (i = 0; i < num_bands; ++i) {
+    sse += bands[i].sse;
+  }
+  free(bands);
+  samples = (uint64_t)width * (uint64_t)height +
+            2 * ((uint64_t)width_uv * (uint64_t)height_uv);
+  return SumSquareErrorToPsnr(sse, samples);
+}
+
+// A band of rows of SSIM windows, measured by one job of a threaded SSIM.
+typedef struct {
+  const uint8_t* src_a;
+  int stride_a;
+  const uint8_t* src_b;
+  int stride_b;
+  int width;
+  int num_rows;
+  double* ssim_rows;
+  Ssim8x8Func Ssim8x8;
+} SsimBand;
+
+static void SsimBandJob(void* opaque, int index) {
+  const SsimBand* band = (const SsimBand*)(opaque) + index;
+  const uint8_t* src_a = band->src_a;
+  const uint8_t* src_b = band->src_b;
+  int i;
+  for (i = 0; i < band->num_rows; ++i) {
+    band->ssim_rows[i] = SsimRow(src_a, band->stride_a, src_b, band->stride_b,
+                                 band->width, band->Ssim8x8);
+    src_a += band->stride_a * 4;
+    src_b += band->stride_b * 4;
+  }
+}
+
+// Split the rows of windows of a plane into at most num_jobs bands, each
+// writing its row sums to ssim_rows.  Returns the number of bands written.
+static int SsimSplitBands(const uint8_t* src_a,
+                          int stride_a,
+                          const uint8_t* src_b,
+                          int stride_b,
+                          int width,
+                          int height,
+                          double* ssim_rows,
+                          Ssim8x8Func Ssim8x8,
+                          int num_jobs,
+                          SsimBand* bands) {
+  int num_rows = SsimWindows(height);
+  int band_rows = (num_rows + num_jobs - 1) / num_jobs;
+  int y = 0;
+  int n = 0;
+  while (y < num_rows) {
+    int rows = (num_rows - y) < band_rows ? (num_rows - y) : band_rows;
+    bands[n].src_a = src_a + (ptrdiff_t)y * 4 * stride_a;
+    bands[n].stride_a = stride_a;
+    bands[n].src_b = src_b + (ptrdiff_t)y * 4 * stride_b;
+    bands[n].stride_b = stride_b;
+    bands[n].width = width;
+    bands[n].num_rows = rows;
+    bands[n].ssim_rows = ssim_rows + y;
+    bands[n].Ssim8x8 = Ssim8x8;
+    y += rows;
+    ++n;
+  }
+  return n;
+}
+
+// Reduce row sums in the same order as CalcFrameSsim.
+static double SsimFromRows(const double* ssim_rows, int width, int height) {
+  int samples = SsimWindows(width) * SsimWindows(height);
+  double ssim_total = 0;
+  int i;
+  for (i = 0; i < SsimWindows(height); ++i) {
+    ssim_total += ssim_rows[i];
+  }
+  ssim_total /= samples;
+  return ssim_total;
+}
+
+LIBYUV_API
+double I420SsimThreaded(const uint8_t* src_y_a,
+                        int stride_y_a,
+                        const uint8_t* src_u_a,
+                        int stride_u_a,
+                        const uint8_t* src_v_a,
+                        int stride_v_a,
+                        const uint8_t* src_y_b,
+                        int stride_y_b,
+                        const uint8_t* src_u_b,
+                        int stride_u_b,
+                        const uint8_t* src_v_b,
+                        int stride_v_b,
+                        int width,
+                        int height,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque) {
+  const int width_uv = (width + 1) >> 1;
+  const int height_uv = (height + 1) >> 1;
+  const int num_rows_y = SsimWindows(height);
+  const int num_rows_uv = SsimWindows(height_uv);
+  Ssim8x8Func Ssim8x8 = GetSsim8x8();
+  double* ssim_rows;
+  double ssim_y, ssim_u, ssim_v;
+  int num_uv_jobs;
+  SsimBand* bands;
+  int num_bands;
+  if (!dispatch || num_jobs <= 1 || num_rows_y <= 1) {
+    return I420Ssim(src_y_a, stride_y_a, src_u_a, stride_u_a, src_v_a,
+                    stride_v_a, src_y_b, stride_y_b, src_u_b, stride_u_b,
+                    src_v_b, stride_v_b, width, height);
+  }
+  if (num_jobs > num_rows_y) {
+    num_jobs = num_rows_y;
+  }
+  // The Y plane gets num_jobs bands and each chroma plane half as many.
+  num_uv_jobs = (num_jobs + 1) / 2;
+  bands = (SsimBand*)malloc((num_jobs + num_uv_jobs * 2) * sizeof(SsimBand));
+  ssim_rows =
+      (double*)malloc((num_rows_y + num_rows_uv * 2 + 1) * sizeof(double));
+  if (!bands || !ssim_rows) {
+    free(bands);
+    free(ssim_rows);
+    return I420Ssim(src_y_a, stride_y_a, src_u_a, stride_u_a, src_v_a,
+                    stride_v_a, src_y_b, stride_y_b, src_u_b, stride_u_b,
+                    src_v_b, stride_v_b, width, height);
+  }
+  num_bands =
+      SsimSplitBands(src_y_a, stride_y_a, src_y_b, stride_y_b, width, height,
+                     ssim_rows, Ssim8x8, num_jobs, bands);
+  num_bands += SsimSplitBands(src_u_a, stride_u_a, src_u_b, stride_u_b,
+                              width_uv, height_uv, ssim_rows + num_rows_y,
+                              Ssim8x8, num_uv_jobs, bands + num_bands);
+  num_bands += SsimSplitBands(
+      src_v_a, stride_v_a, src_v_b, stride_v_b, width_uv, height_uv,
+      ssim_rows + num_rows_y + num_rows_uv, Ssim8x8, num_uv_jobs,
+      bands + num_bands);
+  dispatch(dispatch_opaque, SsimBandJob, bands, num_bands);
+  ssim_y = SsimFromRows(ssim_rows, width, height);
+  ssim_u = SsimFromRows(ssim_rows + num_rows_y, width_uv, height_uv);
+  ssim_v =
+      SsimFromRows(ssim_rows + num_rows_y + num_rows_uv, width_uv, height_uv);
+  free(ssim_rows);
+  free(bands);
+  return ssim_y * 0.8 + 0.1 * (ssim_u + ssim_v);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -10,6 +10,8 @@
 
 #include "libyuv/basic_types.h"
 
+#include <float.h>
+
 #include "libyuv/compare_row.h"
 
 #ifdef __cplusplus
@@ -68,6 +70,64 @@ uint32_t HashDjb2_C(const uint8_t* src, int count, uint32_t seed) {
   return hash;
 }
 
+static const int64_t cc1 = 26634;   // (64^2*(.01*255)^2
+static const int64_t cc2 = 239708;  // (64^2*(.03*255)^2
+
+double Ssim8x8FromSums(int sum_a,
+                       int sum_b,
+                       int sum_sq_a,
+                       int sum_sq_b,
+                       int sum_axb) {
+  const int64_t count = 64;
+  // scale the constants by number of pixels
+  const int64_t c1 = (cc1 * count * count) >> 12;
+  const int64_t c2 = (cc2 * count * count) >> 12;
+
+  const int64_t sum_a_x_sum_b = (int64_t)sum_a * sum_b;
+
+  const int64_t ssim_n = (2 * sum_a_x_sum_b + c1) *
+                         (2 * count * sum_axb - 2 * sum_a_x_sum_b + c2);
+
+  const int64_t sum_a_sq = (int64_t)sum_a * sum_a;
+  const int64_t sum_b_sq = (int64_t)sum_b * sum_b;
+
+  const int64_t ssim_d =
+      (sum_a_sq + sum_b_sq + c1) *
+      (count * sum_sq_a - sum_a_sq + count * sum_sq_b - sum_b_sq + c2);
+
+  if (ssim_d == 0.0) {
+    return DBL_MAX;
+  }
+  return ssim_n * 1.0 / ssim_d;
+}
+
+double Ssim8x8_C(const uint8_t* src_a,
+                 int stride_a,
+                 const uint8_t* src_b,
+                 int stride_b) {
+  int sum_a = 0;
+  int sum_b = 0;
+  int sum_sq_a = 0;
+  int sum_sq_b = 0;
+  int sum_axb = 0;
+
+  int i;
+  for (i = 0; i < 8; ++i) {
+    int j;
+    for (j = 0; j < 8; ++j) {
+      sum_a += src_a[j];
+      sum_b += src_b[j];
+      sum_sq_a += src_a[j] * src_a[j];
+      sum_sq_b += src_b[j] * src_b[j];
+      sum_axb += src_a[j] * src_b[j];
+    }
+
+    src_a += stride_a;
+    src_b += stride_b;
+  }
+  return Ssim8x8FromSums(sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
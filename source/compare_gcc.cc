@@ -352,6 +352,125 @@ uint32_t HashDjb2_SSE41(const uint8_t* src, int count, uint32_t seed) {
         "xmm7");
   return hash;
 }
+#ifdef HAS_SSIM8X8_SSE41
+// Accumulate one row of 8 pixels into the sums of a, b, a*a, b*b and a*b.
+#define SSIMROW_SSE41                              \
+  "pmovzxbw    (%0),%%xmm0                   \n" \
+  "pmovzxbw    (%1),%%xmm1                   \n" \
+  "add         %2,%0                         \n" \
+  "add         %3,%1                         \n" \
+  "paddw       %%xmm0,%%xmm2                 \n" \
+  "paddw       %%xmm1,%%xmm3                 \n" \
+  "movdqa      %%xmm0,%%xmm7                 \n" \
+  "pmaddwd     %%xmm0,%%xmm7                 \n" \
+  "paddd       %%xmm7,%%xmm4                 \n" \
+  "movdqa      %%xmm1,%%xmm7                 \n" \
+  "pmaddwd     %%xmm1,%%xmm7                 \n" \
+  "paddd       %%xmm7,%%xmm5                 \n" \
+  "pmaddwd     %%xmm1,%%xmm0                 \n" \
+  "paddd       %%xmm0,%%xmm6                 \n"
+
+double Ssim8x8_SSE41(const uint8_t* src_a,
+                     int stride_a,
+                     const uint8_t* src_b,
+                     int stride_b) {
+  int sums[6];  // sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb, unused.
+  asm volatile(
+      "pxor        %%xmm2,%%xmm2                 \n"
+      "pxor        %%xmm3,%%xmm3                 \n"
+      "pxor        %%xmm4,%%xmm4                 \n"
+      "pxor        %%xmm5,%%xmm5                 \n"
+      "pxor        %%xmm6,%%xmm6                 \n"
+
+      SSIMROW_SSE41 SSIMROW_SSE41 SSIMROW_SSE41 SSIMROW_SSE41
+      SSIMROW_SSE41 SSIMROW_SSE41 SSIMROW_SSE41 SSIMROW_SSE41
+
+      "phaddw      %%xmm3,%%xmm2                 \n"
+      "phaddw      %%xmm2,%%xmm2                 \n"
+      "phaddw      %%xmm2,%%xmm2                 \n"
+      "pmovzxwd    %%xmm2,%%xmm2                 \n"
+      "phaddd      %%xmm5,%%xmm4                 \n"
+      "phaddd      %%xmm6,%%xmm6                 \n"
+      "phaddd      %%xmm6,%%xmm4                 \n"
+      "movq        %%xmm2,(%4)                   \n"
+      "movdqu      %%xmm4,0x8(%4)                \n"
+      : "+r"(src_a),               // %0
+        "+r"(src_b)                // %1
+      : "r"((intptr_t)(stride_a)),  // %2
+        "r"((intptr_t)(stride_b)),  // %3
+        "r"(sums)                   // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+  return Ssim8x8FromSums(sums[0], sums[1], sums[2], sums[3], sums[4]);
+}
+#undef SSIMROW_SSE41
+#endif  // HAS_SSIM8X8_SSE41
+
+#ifdef HAS_SSIM8X8_AVX2
+// Accumulate two rows of 8 pixels into the sums of a, b, a*a, b*b and a*b.
+#define SSIMROW2_AVX2                              \
+  "vmovq       (%0),%%xmm0                   \n" \
+  "vmovhps     (%0,%2),%%xmm0,%%xmm0         \n" \
+  "vmovq       (%1),%%xmm1                   \n" \
+  "vmovhps     (%1,%3),%%xmm1,%%xmm1         \n" \
+  "lea         (%0,%2,2),%0                  \n" \
+  "lea         (%1,%3,2),%1                  \n" \
+  "vpmovzxbw   %%xmm0,%%ymm0                 \n" \
+  "vpmovzxbw   %%xmm1,%%ymm1                 \n" \
+  "vpaddw      %%ymm0,%%ymm2,%%ymm2          \n" \
+  "vpaddw      %%ymm1,%%ymm3,%%ymm3          \n" \
+  "vpmaddwd    %%ymm0,%%ymm0,%%ymm7          \n" \
+  "vpaddd      %%ymm7,%%ymm4,%%ymm4          \n" \
+  "vpmaddwd    %%ymm1,%%ymm1,%%ymm7          \n" \
+  "vpaddd      %%ymm7,%%ymm5,%%ymm5          \n" \
+  "vpmaddwd    %%ymm1,%%ymm0,%%ymm0          \n" \
+  "vpaddd      %%ymm0,%%ymm6,%%ymm6          \n"
+
+double Ssim8x8_AVX2(const uint8_t* src_a,
+                    int stride_a,
+                    const uint8_t* src_b,
+                    int stride_b) {
+  int sums[6];  // sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb, unused.
+  asm volatile(
+      "vpxor       %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpxor       %%ymm3,%%ymm3,%%ymm3          \n"
+      "vpxor       %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpxor       %%ymm5,%%ymm5,%%ymm5          \n"
+      "vpxor       %%ymm6,%%ymm6,%%ymm6          \n"
+
+      SSIMROW2_AVX2 SSIMROW2_AVX2 SSIMROW2_AVX2 SSIMROW2_AVX2
+
+      "vextracti128 $1,%%ymm2,%%xmm0             \n"
+      "vextracti128 $1,%%ymm3,%%xmm1             \n"
+      "vpaddw      %%xmm0,%%xmm2,%%xmm2          \n"
+      "vpaddw      %%xmm1,%%xmm3,%%xmm3          \n"
+      "vextracti128 $1,%%ymm4,%%xmm0             \n"
+      "vextracti128 $1,%%ymm5,%%xmm1             \n"
+      "vextracti128 $1,%%ymm6,%%xmm7             \n"
+      "vpaddd      %%xmm0,%%xmm4,%%xmm4          \n"
+      "vpaddd      %%xmm1,%%xmm5,%%xmm5          \n"
+      "vpaddd      %%xmm7,%%xmm6,%%xmm6          \n"
+      "vphaddw     %%xmm3,%%xmm2,%%xmm2          \n"
+      "vphaddw     %%xmm2,%%xmm2,%%xmm2          \n"
+      "vphaddw     %%xmm2,%%xmm2,%%xmm2          \n"
+      "vpmovzxwd   %%xmm2,%%xmm2                 \n"
+      "vphaddd     %%xmm5,%%xmm4,%%xmm4          \n"
+      "vphaddd     %%xmm6,%%xmm6,%%xmm6          \n"
+      "vphaddd     %%xmm6,%%xmm4,%%xmm4          \n"
+      "vmovq       %%xmm2,(%4)                   \n"
+      "vmovdqu     %%xmm4,0x8(%4)                \n"
+      "vzeroupper                                \n"
+      : "+r"(src_a),               // %0
+        "+r"(src_b)                // %1
+      : "r"((intptr_t)(stride_a)),  // %2
+        "r"((intptr_t)(stride_b)),  // %3
+        "r"(sums)                   // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+  return Ssim8x8FromSums(sums[0], sums[1], sums[2], sums[3], sums[4]);
+}
+#undef SSIMROW2_AVX2
+#endif  // HAS_SSIM8X8_AVX2
 #endif  // defined(__x86_64__) || (defined(__i386__) && !defined(__pic__)))
 
 #ifdef __cplusplus
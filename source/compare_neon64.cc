@@ -86,6 +86,55 @@ uint32_t SumSquareError_NEON(const uint8_t* src_a,
   return sse;
 }
 
+// Sum 8 rows of 8 pixels, their squares and products for SSIM.
+double Ssim8x8_NEON(const uint8_t* src_a,
+                    int stride_a,
+                    const uint8_t* src_b,
+                    int stride_b) {
+  int sums[5];  // sum_a, sum_b, sum_sq_a, sum_sq_b, sum_axb.
+  int rows = 8;
+  asm volatile(
+      "movi        v16.8h, #0                    \n"
+      "movi        v17.8h, #0                    \n"
+      "movi        v18.4s, #0                    \n"
+      "movi        v19.4s, #0                    \n"
+      "movi        v20.4s, #0                    \n"
+
+      "1:                                        \n"
+      "ld1         {v0.8b}, [%0], %3             \n"
+      "ld1         {v1.8b}, [%1], %4             \n"
+      "subs        %w2, %w2, #1                  \n"
+      "uaddw       v16.8h, v16.8h, v0.8b         \n"
+      "uaddw       v17.8h, v17.8h, v1.8b         \n"
+      "umull       v2.8h, v0.8b, v0.8b           \n"
+      "umull       v3.8h, v1.8b, v1.8b           \n"
+      "umull       v4.8h, v0.8b, v1.8b           \n"
+      "uadalp      v18.4s, v2.8h                 \n"
+      "uadalp      v19.4s, v3.8h                 \n"
+      "uadalp      v20.4s, v4.8h                 \n"
+      "b.gt        1b                            \n"
+
+      "uaddlv      s16, v16.8h                   \n"
+      "uaddlv      s17, v17.8h                   \n"
+      "addv        s18, v18.4s                   \n"
+      "addv        s19, v19.4s                   \n"
+      "addv        s20, v20.4s                   \n"
+      "str         s16, [%5]                     \n"
+      "str         s17, [%5, #4]                 \n"
+      "str         s18, [%5, #8]                 \n"
+      "str         s19, [%5, #12]                \n"
+      "str         s20, [%5, #16]                \n"
+      : "+r"(src_a),                            // %0
+        "+r"(src_b),                            // %1
+        "+r"(rows)                              // %2
+      : "r"(static_cast<ptrdiff_t>(stride_a)),  // %3
+        "r"(static_cast<ptrdiff_t>(stride_b)),  // %4
+        "r"(sums)                               // %5
+      : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v16", "v17", "v18",
+        "v19", "v20");
+  return Ssim8x8FromSums(sums[0], sums[1], sums[2], sums[3], sums[4]);
+}
+
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -18,6 +18,8 @@
 #include "libyuv/scale.h"     // For ScalePlane()
 #include "libyuv/scale_uv.h"  // For UVScale()
 
+#include "profile_internal.h"  // For ProfileStart
+
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
@@ -217,6 +219,271 @@ int I010ToI420(const uint16_t* src_y,
                            1, 10);
 }
 
+// Tone map 10 bit BT.2020 YUV to 8 bit BT.709 YUV through a 2 row ARGB
+// buffer.  src_v NULL means src_u is P010 interleaved UV.  dst_v NULL means
+// dst_u is NV12 interleaved UV.
+static int Ix10ToI420ToneMap(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             uint8_t* dst_y,
+                             int dst_stride_y,
+                             uint8_t* dst_u,
+                             int dst_stride_u,
+                             uint8_t* dst_v,
+                             int dst_stride_v,
+                             const struct ToneMapConstants* tonemap,
+                             int width,
+                             int height) {
+  int y;
+  int halfwidth = (width + 1) >> 1;
+  void (*I210ToARGBToneMapRow)(
+      const uint16_t* y_buf, const uint16_t* u_buf, const uint16_t* v_buf,
+      uint8_t* rgb_buf, const struct YuvConstants* yuvconstants,
+      const struct ToneMapConstants* tonemap, int width) =
+      I210ToARGBToneMapRow_C;
+  void (*P210ToARGBToneMapRow)(
+      const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants,
+      const struct ToneMapConstants* tonemap, int width) =
+      P210ToARGBToneMapRow_C;
+  void (*ARGBToUVHRow)(const uint8_t* src_argb0, int src_stride_argb,
+                       uint8_t* dst_u, uint8_t* dst_v, int width) =
+      ARGBToUVHRow_C;
+  void (*ARGBToYHRow)(const uint8_t* src_argb, uint8_t* dst_y, int width) =
+      ARGBToYHRow_C;
+  void (*MergeUVRow_)(const uint8_t* src_u, const uint8_t* src_v,
+                      uint8_t* dst_uv, int width) = MergeUVRow_C;
+  if (!src_y || !src_u || !dst_y || !dst_u || !tonemap || width <= 0 ||
+      height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    int halfheight;
+    height = -height;
+    halfheight = (height + 1) >> 1;
+    src_y = src_y + (height - 1) * src_stride_y;
+    src_u = src_u + (halfheight - 1) * src_stride_u;
+    src_stride_y = -src_stride_y;
+    src_stride_u = -src_stride_u;
+    if (src_v) {
+      src_v = src_v + (halfheight - 1) * src_stride_v;
+      src_stride_v = -src_stride_v;
+    }
+  }
+#if defined(HAS_I210TOARGBTONEMAPROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I210ToARGBToneMapRow = I210ToARGBToneMapRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      I210ToARGBToneMapRow = I210ToARGBToneMapRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_P210TOARGBTONEMAPROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToARGBToneMapRow = P210ToARGBToneMapRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      P210ToARGBToneMapRow = P210ToARGBToneMapRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYHROW_SSSE3) && defined(HAS_ARGBTOUVHROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToUVHRow = ARGBToUVHRow_Any_SSSE3;
+    ARGBToYHRow = ARGBToYHRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      ARGBToUVHRow = ARGBToUVHRow_SSSE3;
+      ARGBToYHRow = ARGBToYHRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTOYHROW_AVX2) && defined(HAS_ARGBTOUVHROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToUVHRow = ARGBToUVHRow_Any_AVX2;
+    ARGBToYHRow = ARGBToYHRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVHRow = ARGBToUVHRow_AVX2;
+      ARGBToYHRow = ARGBToYHRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MergeUVRow_ = MergeUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MergeUVRow_ = MergeUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      MergeUVRow_ = MergeUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    MergeUVRow_ = MergeUVRow_Any_NEON;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    MergeUVRow_ = MergeUVRow_Any_MMI;
+    if (IS_ALIGNED(halfwidth, 8)) {
+      MergeUVRow_ = MergeUVRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    MergeUVRow_ = MergeUVRow_Any_MSA;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_MSA;
+    }
+  }
+#endif
+  {
+    // Allocate 2 rows of ARGB and a row of u and v.
+    const int kRowSize = (width * 4 + 31) & ~31;
+    const int kHalfSize = (halfwidth + 31) & ~31;
+    align_buffer_64(row, kRowSize * 2 + kHalfSize * 2);
+    uint8_t* row_u = row + kRowSize * 2;
+    uint8_t* row_v = row_u + kHalfSize;
+    uint8_t* uv_u = dst_v ? dst_u : row_u;
+    uint8_t* uv_v = dst_v ? dst_v : row_v;
+
+    for (y = 0; y < height; y += 2) {
+      int rows = (height - y) > 1 ? 2 : 1;
+      int r;
+      for (r = 0; r < rows; ++r) {
+        uint8_t* row_argb = row + r * kRowSize;
+        if (src_v) {
+          I210ToARGBToneMapRow(src_y, src_u, src_v, row_argb,
+                               &kYuv2020Constants, tonemap, width);
+        } else {
+          P210ToARGBToneMapRow(src_y, src_u, row_argb, &kYuv2020Constants,
+                               tonemap, width);
+        }
+        ARGBToYHRow(row_argb, dst_y, width);
+        src_y += src_stride_y;
+        dst_y += dst_stride_y;
+      }
+      ARGBToUVHRow(row, rows > 1 ? kRowSize : 0, uv_u, uv_v, width);
+      if (dst_v) {
+        uv_u += dst_stride_u;
+        uv_v += dst_stride_v;
+      } else {
+        MergeUVRow_(row_u, row_v, dst_u, halfwidth);
+        dst_u += dst_stride_u;
+      }
+      src_u += src_stride_u;
+      if (src_v) {
+        src_v += src_stride_v;
+      }
+    }
+    free_aligned_buffer_64(row);
+  }
+  return 0;
+}
+
+// Convert BT.2020 I010 with PQ or HLG transfer to SDR BT.709 I420.
+LIBYUV_API
+int I010ToI420ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  if (!src_v || !dst_v) {
+    return -1;
+  }
+  return Ix10ToI420ToneMap(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                           src_stride_v, dst_y, dst_stride_y, dst_u,
+                           dst_stride_u, dst_v, dst_stride_v, tonemap, width,
+                           height);
+}
+
+// Convert BT.2020 I010 with PQ or HLG transfer to SDR BT.709 NV12.
+LIBYUV_API
+int I010ToNV12ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  if (!src_v) {
+    return -1;
+  }
+  return Ix10ToI420ToneMap(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                           src_stride_v, dst_y, dst_stride_y, dst_uv,
+                           dst_stride_uv, NULL, 0, tonemap, width, height);
+}
+
+// Convert BT.2020 P010 with PQ or HLG transfer to SDR BT.709 I420.
+LIBYUV_API
+int P010ToI420ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  if (!dst_v) {
+    return -1;
+  }
+  return Ix10ToI420ToneMap(src_y, src_stride_y, src_uv, src_stride_uv, NULL,
+                           0, dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+                           dst_stride_v, tonemap, width, height);
+}
+
+// Convert BT.2020 P010 with PQ or HLG transfer to SDR BT.709 NV12.
+LIBYUV_API
+int P010ToNV12ToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  return Ix10ToI420ToneMap(src_y, src_stride_y, src_uv, src_stride_uv, NULL,
+                           0, dst_y, dst_stride_y, dst_uv, dst_stride_uv, NULL,
+                           0, tonemap, width, height);
+}
+
 LIBYUV_API
 int I210ToI422(const uint16_t* src_y,
                int src_stride_y,
@@ -921,6 +1188,66 @@ int NV21ToI420(const uint8_t* src_y,
                     width, height);
 }
 
+// Convert MM21 to NV12.
+LIBYUV_API
+int MM21ToNV12(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int width,
+               int height) {
+  int halfheight = (height + 1) >> 1;
+  if (!src_uv || !dst_uv || width <= 0 || height == 0) {
+    return -1;
+  }
+  if (height < 0) {
+    halfheight = -((1 - height) >> 1);
+  }
+  if (dst_y) {
+    if (DetilePlane(src_y, src_stride_y, dst_y, dst_stride_y, width, height,
+                    32)) {
+      return -1;
+    }
+  }
+  return DetilePlane(src_uv, src_stride_uv, dst_uv, dst_stride_uv,
+                     (width + 1) & ~1, halfheight, 16);
+}
+
+// Convert MM21 to I420.
+LIBYUV_API
+int MM21ToI420(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_u,
+               int dst_stride_u,
+               uint8_t* dst_v,
+               int dst_stride_v,
+               int width,
+               int height) {
+  int halfheight = (height + 1) >> 1;
+  if (!src_uv || !dst_u || !dst_v || width <= 0 || height == 0) {
+    return -1;
+  }
+  if (height < 0) {
+    halfheight = -((1 - height) >> 1);
+  }
+  if (dst_y) {
+    if (DetilePlane(src_y, src_stride_y, dst_y, dst_stride_y, width, height,
+                    32)) {
+      return -1;
+    }
+  }
+  return DetileSplitUVPlane(src_uv, src_stride_uv, dst_u, dst_stride_u, dst_v,
+                            dst_stride_v, (width + 1) & ~1, halfheight, 16);
+}
+
 LIBYUV_API
 int NV12ToNV24(const uint8_t* src_y,
                int src_stride_y,
@@ -1353,6 +1680,8 @@ int ARGBToI420(const uint8_t* src_argb,
                int dst_stride_v,
                int width,
                int height) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
   int y;
   void (*ARGBToUVRow)(const uint8_t* src_argb0, int src_stride_argb,
                       uint8_t* dst_u, uint8_t* dst_v, int width) =
@@ -1368,62 +1697,8 @@ int ARGBToI420(const uint8_t* src_argb,
     src_argb = src_argb + (height - 1) * src_stride_argb;
     src_stride_argb = -src_stride_argb;
   }
-#if defined(HAS_ARGBTOYROW_NEON) && defined(HAS_ARGBTOUVROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    ARGBToYRow = ARGBToYRow_Any_NEON;
-    ARGBToUVRow = ARGBToUVRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      ARGBToYRow = ARGBToYRow_NEON;
-      if (IS_ALIGNED(width, 16)) {
-        ARGBToUVRow = ARGBToUVRow_NEON;
-      }
-    }
-  }
-#endif
-#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    ARGBToUVRow = ARGBToUVRow_Any_SSSE3;
-    ARGBToYRow = ARGBToYRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 16)) {
-      ARGBToUVRow = ARGBToUVRow_SSSE3;
-      ARGBToYRow = ARGBToYRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    ARGBToUVRow = ARGBToUVRow_Any_AVX2;
-    ARGBToYRow = ARGBToYRow_Any_AVX2;
-    if (IS_ALIGNED(width, 32)) {
-      ARGBToUVRow = ARGBToUVRow_AVX2;
-      ARGBToYRow = ARGBToYRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_ARGBTOYROW_MMI) && defined(HAS_ARGBTOUVROW_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    ARGBToYRow = ARGBToYRow_Any_MMI;
-    ARGBToUVRow = ARGBToUVRow_Any_MMI;
-    if (IS_ALIGNED(width, 8)) {
-      ARGBToYRow = ARGBToYRow_MMI;
-    }
-    if (IS_ALIGNED(width, 16)) {
-      ARGBToUVRow = ARGBToUVRow_MMI;
-    }
-  }
-#endif
-#if defined(HAS_ARGBTOYROW_MSA) && defined(HAS_ARGBTOUVROW_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    ARGBToYRow = ARGBToYRow_Any_MSA;
-    ARGBToUVRow = ARGBToUVRow_Any_MSA;
-    if (IS_ALIGNED(width, 16)) {
-      ARGBToYRow = ARGBToYRow_MSA;
-    }
-    if (IS_ALIGNED(width, 32)) {
-      ARGBToUVRow = ARGBToUVRow_MSA;
-    }
-  }
-#endif
+  ARGBToYRow = ROW_KERNEL(kernels, ARGBToYRow, width);
+  ARGBToUVRow = ROW_KERNEL(kernels, ARGBToUVRow, width);
 
   for (y = 0; y < height - 1; y += 2) {
     ARGBToUVRow(src_argb, src_stride_argb, dst_u, dst_v, width);
@@ -1438,15 +1713,119 @@ int ARGBToI420(const uint8_t* src_argb,
     ARGBToUVRow(src_argb, 0, dst_u, dst_v, width);
     ARGBToYRow(src_argb, dst_y, width);
   }
+  ProfileStop(kProfileARGBToI420, profile_start, (uint64_t)width * height,
+              kernels->ARGBToYRow_Cpu);
   return 0;
 }
 
-// Convert BGRA to I420.
+// State shared by the jobs of ARGBToI420Batch.
+typedef struct ARGBToI420BatchJob {
+  const LibyuvConstFrame* src_frames;
+  const LibyuvFrame* dst_frames;
+  int num_frames;
+  int num_jobs;
+  void (*ARGBToUVRow)(const uint8_t* src_argb0,
+                      int src_stride_argb,
+                      uint8_t* dst_u,
+                      uint8_t* dst_v,
+                      int width);
+  void (*ARGBToYRow)(const uint8_t* src_argb, uint8_t* dst_y, int width);
+} ARGBToI420BatchJob;
+
+// Convert the index'th run of frames.
+static void ARGBToI420BatchFrames(void* job_opaque, int index) {
+  const ARGBToI420BatchJob* job = (const ARGBToI420BatchJob*)job_opaque;
+  int begin = (int)((int64_t)job->num_frames * index / job->num_jobs);
+  int end = (int)((int64_t)job->num_frames * (index + 1) / job->num_jobs);
+  int i;
+  for (i = begin; i < end; ++i) {
+    const LibyuvFrame* dst = &job->dst_frames[i];
+    const uint8_t* src_argb = job->src_frames[i].data[0];
+    int src_stride_argb = job->src_frames[i].stride[0];
+    uint8_t* dst_y = dst->data[0];
+    uint8_t* dst_u = dst->data[1];
+    uint8_t* dst_v = dst->data[2];
+    int width = job->src_frames[i].width;
+    int height = job->src_frames[i].height;
+    int y;
+    // Negative height means invert the image.
+    if (height < 0) {
+      height = -height;
+      src_argb = src_argb + (height - 1) * src_stride_argb;
+      src_stride_argb = -src_stride_argb;
+    }
+    for (y = 0; y < height - 1; y += 2) {
+      job->ARGBToUVRow(src_argb, src_stride_argb, dst_u, dst_v, width);
+      job->ARGBToYRow(src_argb, dst_y, width);
+      job->ARGBToYRow(src_argb + src_stride_argb, dst_y + dst->stride[0],
+                      width);
+      src_argb += src_stride_argb * 2;
+      dst_y += dst->stride[0] * 2;
+      dst_u += dst->stride[1];
+      dst_v += dst->stride[2];
+    }
+    if (height & 1) {
+      job->ARGBToUVRow(src_argb, 0, dst_u, dst_v, width);
+      job->ARGBToYRow(src_argb, dst_y, width);
+    }
+  }
+}
+
+// Convert a batch of ARGB frames to I420.
 LIBYUV_API
-int BGRAToI420(const uint8_t* src_bgra,
-               int src_stride_bgra,
-               uint8_t* dst_y,
-               int dst_stride_y,
+int ARGBToI420Batch(const LibyuvConstFrame* src_frames,
+                    const LibyuvFrame* dst_frames,
+                    int num_frames,
+                    int num_jobs,
+                    LibyuvDispatchFunc dispatch,
+                    void* dispatch_opaque) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
+  ARGBToI420BatchJob job;
+  int all_widths = 0;  // Widths or'ed together to test alignment of all.
+  uint64_t pixels = 0;
+  int i;
+  if (!src_frames || !dst_frames || num_frames <= 0) {
+    return -1;
+  }
+  for (i = 0; i < num_frames; ++i) {
+    const LibyuvFrame* dst = &dst_frames[i];
+    if (!src_frames[i].data[0] || !dst->data[0] || !dst->data[1] ||
+        !dst->data[2] || src_frames[i].width <= 0 ||
+        src_frames[i].height == 0) {
+      return -1;
+    }
+    all_widths |= src_frames[i].width;
+    pixels += (uint64_t)src_frames[i].width * Abs(src_frames[i].height);
+  }
+  job.ARGBToYRow = ROW_KERNEL(kernels, ARGBToYRow, all_widths);
+  job.ARGBToUVRow = ROW_KERNEL(kernels, ARGBToUVRow, all_widths);
+  if (num_jobs > num_frames) {
+    num_jobs = num_frames;
+  }
+  if (!dispatch || num_jobs <= 1) {
+    num_jobs = 1;
+  }
+  job.src_frames = src_frames;
+  job.dst_frames = dst_frames;
+  job.num_frames = num_frames;
+  job.num_jobs = num_jobs;
+  if (num_jobs == 1) {
+    ARGBToI420BatchFrames(&job, 0);
+  } else {
+    dispatch(dispatch_opaque, ARGBToI420BatchFrames, &job, num_jobs);
+  }
+  ProfileStop(kProfileARGBToI420Batch, profile_start, pixels,
+              kernels->ARGBToYRow_Cpu);
+  return 0;
+}
+
+// Convert BGRA to I420.
+LIBYUV_API
+int BGRAToI420(const uint8_t* src_bgra,
+               int src_stride_bgra,
+               uint8_t* dst_y,
+               int dst_stride_y,
                uint8_t* dst_u,
                int dst_stride_u,
                uint8_t* dst_v,
@@ -1739,9 +2118,27 @@ int RGB24ToI420(const uint8_t* src_rgb24,
                 int dst_stride_v,
                 int width,
                 int height) {
+  return RGB24ToI420_WithScratch(src_rgb24, src_stride_rgb24, dst_y,
+                                 dst_stride_y, dst_u, dst_stride_u, dst_v,
+                                 dst_stride_v, width, height, NULL);
+}
+
+// Convert RGB24 to I420 with row buffers taken from a caller supplied scratch.
+LIBYUV_API
+int RGB24ToI420_WithScratch(const uint8_t* src_rgb24,
+                            int src_stride_rgb24,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int width,
+                            int height,
+                            const LibyuvScratch* scratch) {
   int y;
 #if (defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
-     defined(HAS_RGB24TOYROW_MMI))
+     defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
   void (*RGB24ToUVRow)(const uint8_t* src_rgb24, int src_stride_rgb24,
                        uint8_t* dst_u, uint8_t* dst_v, int width) =
       RGB24ToUVRow_C;
@@ -1802,6 +2199,28 @@ int RGB24ToI420(const uint8_t* src_rgb24,
     }
   }
 #endif
+// SSSE3 and AVX2 versions do direct RGB24 to YUV.
+#elif defined(HAS_RGB24TOYROW_SSSE3)
+#if defined(HAS_RGB24TOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_SSSE3;
+    RGB24ToYRow = RGB24ToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      RGB24ToUVRow = RGB24ToUVRow_SSSE3;
+      RGB24ToYRow = RGB24ToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_AVX2) && defined(HAS_RGB24TOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_AVX2;
+    RGB24ToYRow = RGB24ToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RGB24ToUVRow = RGB24ToUVRow_AVX2;
+      RGB24ToYRow = RGB24ToYRow_AVX2;
+    }
+  }
+#endif
 // Other platforms do intermediate conversion from RGB24 to ARGB.
 #else
 #if defined(HAS_RGB24TOARGBROW_NEON)
@@ -1856,15 +2275,17 @@ int RGB24ToI420(const uint8_t* src_rgb24,
 
   {
 #if !(defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
-      defined(HAS_RGB24TOYROW_MMI))
+      defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
     // Allocate 2 rows of ARGB.
     const int kRowSize = (width * 4 + 31) & ~31;
-    align_buffer_64(row, kRowSize * 2);
+    align_buffer_64_scratch(row, kRowSize * 2, scratch);
+#else
+    (void)scratch;
 #endif
 
     for (y = 0; y < height - 1; y += 2) {
 #if (defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
-     defined(HAS_RGB24TOYROW_MMI))
+     defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
       RGB24ToUVRow(src_rgb24, src_stride_rgb24, dst_u, dst_v, width);
       RGB24ToYRow(src_rgb24, dst_y, width);
       RGB24ToYRow(src_rgb24 + src_stride_rgb24, dst_y + dst_stride_y, width);
@@ -1882,7 +2303,7 @@ int RGB24ToI420(const uint8_t* src_rgb24,
     }
     if (height & 1) {
 #if (defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
-     defined(HAS_RGB24TOYROW_MMI))
+     defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
       RGB24ToUVRow(src_rgb24, 0, dst_u, dst_v, width);
       RGB24ToYRow(src_rgb24, dst_y, width);
 #else
@@ -1892,13 +2313,172 @@ int RGB24ToI420(const uint8_t* src_rgb24,
 #endif
     }
 #if !(defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
-      defined(HAS_RGB24TOYROW_MMI))
+      defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
     free_aligned_buffer_64(row);
 #endif
   }
   return 0;
 }
 
+// Size of the ARGB row buffers used by RGB24ToI420_WithScratch.
+LIBYUV_API
+int RGB24ToI420ScratchSize(int width) {
+#if (defined(HAS_RGB24TOYROW_NEON) || defined(HAS_RGB24TOYROW_MSA) || \
+     defined(HAS_RGB24TOYROW_MMI) || defined(HAS_RGB24TOYROW_SSSE3))
+  (void)width;
+  return 0;
+#else
+  return ((width * 4 + 31) & ~31) * 2 + 63;
+#endif
+}
+
+// Convert RGB24 to NV12.  The Y and UV rows are computed directly from the
+// RGB24 pixels, without an intermediate ARGB row.
+LIBYUV_API
+int RGB24ToNV12(const uint8_t* src_rgb24,
+                int src_stride_rgb24,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                uint8_t* dst_uv,
+                int dst_stride_uv,
+                int width,
+                int height) {
+  int y;
+  int halfwidth = (width + 1) >> 1;
+  void (*RGB24ToUVRow)(const uint8_t* src_rgb24, int src_stride_rgb24,
+                       uint8_t* dst_u, uint8_t* dst_v, int width) =
+      RGB24ToUVRow_C;
+  void (*RGB24ToYRow)(const uint8_t* src_rgb24, uint8_t* dst_y, int width) =
+      RGB24ToYRow_C;
+  void (*MergeUVRow_)(const uint8_t* src_u, const uint8_t* src_v,
+                      uint8_t* dst_uv, int width) = MergeUVRow_C;
+  if (!src_rgb24 || !dst_y || !dst_uv || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_rgb24 = src_rgb24 + (height - 1) * src_stride_rgb24;
+    src_stride_rgb24 = -src_stride_rgb24;
+  }
+#if defined(HAS_RGB24TOYROW_SSSE3) && defined(HAS_RGB24TOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_SSSE3;
+    RGB24ToYRow = RGB24ToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      RGB24ToUVRow = RGB24ToUVRow_SSSE3;
+      RGB24ToYRow = RGB24ToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_AVX2) && defined(HAS_RGB24TOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_AVX2;
+    RGB24ToYRow = RGB24ToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RGB24ToUVRow = RGB24ToUVRow_AVX2;
+      RGB24ToYRow = RGB24ToYRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_NEON) && defined(HAS_RGB24TOUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_NEON;
+    RGB24ToYRow = RGB24ToYRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      RGB24ToYRow = RGB24ToYRow_NEON;
+      if (IS_ALIGNED(width, 16)) {
+        RGB24ToUVRow = RGB24ToUVRow_NEON;
+      }
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_MMI) && defined(HAS_RGB24TOUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_MMI;
+    RGB24ToYRow = RGB24ToYRow_Any_MMI;
+    if (IS_ALIGNED(width, 8)) {
+      RGB24ToYRow = RGB24ToYRow_MMI;
+      if (IS_ALIGNED(width, 16)) {
+        RGB24ToUVRow = RGB24ToUVRow_MMI;
+      }
+    }
+  }
+#endif
+#if defined(HAS_RGB24TOYROW_MSA) && defined(HAS_RGB24TOUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    RGB24ToUVRow = RGB24ToUVRow_Any_MSA;
+    RGB24ToYRow = RGB24ToYRow_Any_MSA;
+    if (IS_ALIGNED(width, 16)) {
+      RGB24ToYRow = RGB24ToYRow_MSA;
+      RGB24ToUVRow = RGB24ToUVRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MergeUVRow_ = MergeUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MergeUVRow_ = MergeUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      MergeUVRow_ = MergeUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    MergeUVRow_ = MergeUVRow_Any_NEON;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    MergeUVRow_ = MergeUVRow_Any_MMI;
+    if (IS_ALIGNED(halfwidth, 8)) {
+      MergeUVRow_ = MergeUVRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    MergeUVRow_ = MergeUVRow_Any_MSA;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_MSA;
+    }
+  }
+#endif
+  {
+    // Allocate a row of u and a row of v.
+    align_buffer_64(row_u, ((halfwidth + 31) & ~31) * 2);
+    uint8_t* row_v = row_u + ((halfwidth + 31) & ~31);
+
+    for (y = 0; y < height - 1; y += 2) {
+      RGB24ToUVRow(src_rgb24, src_stride_rgb24, row_u, row_v, width);
+      MergeUVRow_(row_u, row_v, dst_uv, halfwidth);
+      RGB24ToYRow(src_rgb24, dst_y, width);
+      RGB24ToYRow(src_rgb24 + src_stride_rgb24, dst_y + dst_stride_y, width);
+      src_rgb24 += src_stride_rgb24 * 2;
+      dst_y += dst_stride_y * 2;
+      dst_uv += dst_stride_uv;
+    }
+    if (height & 1) {
+      RGB24ToUVRow(src_rgb24, 0, row_u, row_v, width);
+      MergeUVRow_(row_u, row_v, dst_uv, halfwidth);
+      RGB24ToYRow(src_rgb24, dst_y, width);
+    }
+    free_aligned_buffer_64(row_u);
+  }
+  return 0;
+}
+
 // TODO(fbarchard): Use Matrix version to implement I420 and J420.
 // Convert RGB24 to J420.
 LIBYUV_API
@@ -2083,9 +2663,28 @@ int RAWToI420(const uint8_t* src_raw,
               int dst_stride_v,
               int width,
               int height) {
+  return RAWToI420_WithScratch(src_raw, src_stride_raw, dst_y, dst_stride_y,
+                               dst_u, dst_stride_u, dst_v, dst_stride_v, width,
+                               height, NULL);
+}
+
+// Convert RAW to I420 with row buffers taken from a caller supplied scratch.
+LIBYUV_API
+int RAWToI420_WithScratch(const uint8_t* src_raw,
+                          int src_stride_raw,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int width,
+                          int height,
+                          const LibyuvScratch* scratch) {
   int y;
 #if (defined(HAS_RAWTOYROW_NEON) && defined(HAS_RAWTOUVROW_NEON)) || \
-    defined(HAS_RAWTOYROW_MSA) || defined(HAS_RAWTOYROW_MMI)
+    defined(HAS_RAWTOYROW_MSA) || defined(HAS_RAWTOYROW_MMI) ||      \
+    defined(HAS_RAWTOYROW_SSSE3)
   void (*RAWToUVRow)(const uint8_t* src_raw, int src_stride_raw, uint8_t* dst_u,
                      uint8_t* dst_v, int width) = RAWToUVRow_C;
   void (*RAWToYRow)(const uint8_t* src_raw, uint8_t* dst_y, int width) =
@@ -2145,6 +2744,28 @@ int RAWToI420(const uint8_t* src_raw,
     }
   }
 #endif
+// SSSE3 and AVX2 versions do direct RAW to YUV.
+#elif defined(HAS_RAWTOYROW_SSSE3)
+#if defined(HAS_RAWTOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    RAWToUVRow = RAWToUVRow_Any_SSSE3;
+    RAWToYRow = RAWToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      RAWToUVRow = RAWToUVRow_SSSE3;
+      RAWToYRow = RAWToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_AVX2) && defined(HAS_RAWTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RAWToUVRow = RAWToUVRow_Any_AVX2;
+    RAWToYRow = RAWToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RAWToUVRow = RAWToUVRow_AVX2;
+      RAWToYRow = RAWToYRow_AVX2;
+    }
+  }
+#endif
 // Other platforms do intermediate conversion from RAW to ARGB.
 #else
 #if defined(HAS_RAWTOARGBROW_NEON)
@@ -2199,15 +2820,17 @@ int RAWToI420(const uint8_t* src_raw,
 
   {
 #if !(defined(HAS_RAWTOYROW_NEON) || defined(HAS_RAWTOYROW_MSA) || \
-      defined(HAS_RAWTOYROW_MMI))
+      defined(HAS_RAWTOYROW_MMI) || defined(HAS_RAWTOYROW_SSSE3))
     // Allocate 2 rows of ARGB.
     const int kRowSize = (width * 4 + 31) & ~31;
-    align_buffer_64(row, kRowSize * 2);
+    align_buffer_64_scratch(row, kRowSize * 2, scratch);
+#else
+    (void)scratch;
 #endif
 
     for (y = 0; y < height - 1; y += 2) {
 #if (defined(HAS_RAWTOYROW_NEON) || defined(HAS_RAWTOYROW_MSA) || \
-     defined(HAS_RAWTOYROW_MMI))
+     defined(HAS_RAWTOYROW_MMI) || defined(HAS_RAWTOYROW_SSSE3))
       RAWToUVRow(src_raw, src_stride_raw, dst_u, dst_v, width);
       RAWToYRow(src_raw, dst_y, width);
       RAWToYRow(src_raw + src_stride_raw, dst_y + dst_stride_y, width);
@@ -2225,7 +2848,7 @@ int RAWToI420(const uint8_t* src_raw,
     }
     if (height & 1) {
 #if (defined(HAS_RAWTOYROW_NEON) || defined(HAS_RAWTOYROW_MSA) || \
-     defined(HAS_RAWTOYROW_MMI))
+     defined(HAS_RAWTOYROW_MMI) || defined(HAS_RAWTOYROW_SSSE3))
       RAWToUVRow(src_raw, 0, dst_u, dst_v, width);
       RAWToYRow(src_raw, dst_y, width);
 #else
@@ -2235,13 +2858,172 @@ int RAWToI420(const uint8_t* src_raw,
 #endif
     }
 #if !(defined(HAS_RAWTOYROW_NEON) || defined(HAS_RAWTOYROW_MSA) || \
-      defined(HAS_RAWTOYROW_MMI))
+      defined(HAS_RAWTOYROW_MMI) || defined(HAS_RAWTOYROW_SSSE3))
     free_aligned_buffer_64(row);
 #endif
   }
   return 0;
 }
 
+// Size of the ARGB row buffers used by RAWToI420_WithScratch.
+LIBYUV_API
+int RAWToI420ScratchSize(int width) {
+#if (defined(HAS_RAWTOYROW_NEON) || defined(HAS_RAWTOYROW_MSA) || \
+     defined(HAS_RAWTOYROW_MMI) || defined(HAS_RAWTOYROW_SSSE3))
+  (void)width;
+  return 0;
+#else
+  return ((width * 4 + 31) & ~31) * 2 + 63;
+#endif
+}
+
+// Convert RAW to NV12.  The Y and UV rows are computed directly from the
+// RAW pixels, without an intermediate ARGB row.
+LIBYUV_API
+int RAWToNV12(const uint8_t* src_raw,
+              int src_stride_raw,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_uv,
+              int dst_stride_uv,
+              int width,
+              int height) {
+  int y;
+  int halfwidth = (width + 1) >> 1;
+  void (*RAWToUVRow)(const uint8_t* src_raw, int src_stride_raw,
+                     uint8_t* dst_u, uint8_t* dst_v, int width) =
+      RAWToUVRow_C;
+  void (*RAWToYRow)(const uint8_t* src_raw, uint8_t* dst_y, int width) =
+      RAWToYRow_C;
+  void (*MergeUVRow_)(const uint8_t* src_u, const uint8_t* src_v,
+                      uint8_t* dst_uv, int width) = MergeUVRow_C;
+  if (!src_raw || !dst_y || !dst_uv || width <= 0 || height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    src_raw = src_raw + (height - 1) * src_stride_raw;
+    src_stride_raw = -src_stride_raw;
+  }
+#if defined(HAS_RAWTOYROW_SSSE3) && defined(HAS_RAWTOUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    RAWToUVRow = RAWToUVRow_Any_SSSE3;
+    RAWToYRow = RAWToYRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      RAWToUVRow = RAWToUVRow_SSSE3;
+      RAWToYRow = RAWToYRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_AVX2) && defined(HAS_RAWTOUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RAWToUVRow = RAWToUVRow_Any_AVX2;
+    RAWToYRow = RAWToYRow_Any_AVX2;
+    if (IS_ALIGNED(width, 32)) {
+      RAWToUVRow = RAWToUVRow_AVX2;
+      RAWToYRow = RAWToYRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_NEON) && defined(HAS_RAWTOUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    RAWToUVRow = RAWToUVRow_Any_NEON;
+    RAWToYRow = RAWToYRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      RAWToYRow = RAWToYRow_NEON;
+      if (IS_ALIGNED(width, 16)) {
+        RAWToUVRow = RAWToUVRow_NEON;
+      }
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_MMI) && defined(HAS_RAWTOUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    RAWToUVRow = RAWToUVRow_Any_MMI;
+    RAWToYRow = RAWToYRow_Any_MMI;
+    if (IS_ALIGNED(width, 8)) {
+      RAWToYRow = RAWToYRow_MMI;
+      if (IS_ALIGNED(width, 16)) {
+        RAWToUVRow = RAWToUVRow_MMI;
+      }
+    }
+  }
+#endif
+#if defined(HAS_RAWTOYROW_MSA) && defined(HAS_RAWTOUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    RAWToUVRow = RAWToUVRow_Any_MSA;
+    RAWToYRow = RAWToYRow_Any_MSA;
+    if (IS_ALIGNED(width, 16)) {
+      RAWToYRow = RAWToYRow_MSA;
+      RAWToUVRow = RAWToUVRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    MergeUVRow_ = MergeUVRow_Any_SSE2;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    MergeUVRow_ = MergeUVRow_Any_AVX2;
+    if (IS_ALIGNED(halfwidth, 32)) {
+      MergeUVRow_ = MergeUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    MergeUVRow_ = MergeUVRow_Any_NEON;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    MergeUVRow_ = MergeUVRow_Any_MMI;
+    if (IS_ALIGNED(halfwidth, 8)) {
+      MergeUVRow_ = MergeUVRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_MERGEUVROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    MergeUVRow_ = MergeUVRow_Any_MSA;
+    if (IS_ALIGNED(halfwidth, 16)) {
+      MergeUVRow_ = MergeUVRow_MSA;
+    }
+  }
+#endif
+  {
+    // Allocate a row of u and a row of v.
+    align_buffer_64(row_u, ((halfwidth + 31) & ~31) * 2);
+    uint8_t* row_v = row_u + ((halfwidth + 31) & ~31);
+
+    for (y = 0; y < height - 1; y += 2) {
+      RAWToUVRow(src_raw, src_stride_raw, row_u, row_v, width);
+      MergeUVRow_(row_u, row_v, dst_uv, halfwidth);
+      RAWToYRow(src_raw, dst_y, width);
+      RAWToYRow(src_raw + src_stride_raw, dst_y + dst_stride_y, width);
+      src_raw += src_stride_raw * 2;
+      dst_y += dst_stride_y * 2;
+      dst_uv += dst_stride_uv;
+    }
+    if (height & 1) {
+      RAWToUVRow(src_raw, 0, row_u, row_v, width);
+      MergeUVRow_(row_u, row_v, dst_uv, halfwidth);
+      RAWToYRow(src_raw, dst_y, width);
+    }
+    free_aligned_buffer_64(row_u);
+  }
+  return 0;
+}
+
 // TODO(fbarchard): Use Matrix version to implement I420 and J420.
 // Convert RAW to J420.
 LIBYUV_API
@@ -2527,6 +3309,16 @@ int RGB565ToI420(const uint8_t* src_rgb565,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
   {
 #if !(defined(HAS_RGB565TOYROW_NEON) || defined(HAS_RGB565TOYROW_MSA) || \
@@ -2686,6 +3478,16 @@ int ARGB1555ToI420(const uint8_t* src_argb1555,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #endif
   {
 #if !(defined(HAS_ARGB1555TOYROW_NEON) || defined(HAS_ARGB1555TOYROW_MSA) || \
@@ -2842,6 +3644,16 @@ int ARGB4444ToI420(const uint8_t* src_argb4444,
     }
   }
 #endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    ARGBToUVRow = ARGBToUVRow_Any_AVX512BW;
+    ARGBToYRow = ARGBToYRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      ARGBToUVRow = ARGBToUVRow_AVX512BW;
+      ARGBToYRow = ARGBToYRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_ARGBTOYROW_MMI) && defined(HAS_ARGBTOUVROW_MMI)
   if (TestCpuFlag(kCpuHasMMI)) {
     ARGBToUVRow = ARGBToUVRow_Any_MMI;
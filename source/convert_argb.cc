@@ -10,6 +10,9 @@
 
 #include "libyuv/convert_argb.h"
 
+#include <math.h>
+#include <string.h>  // For memset.
+
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
 #include "libyuv/mjpeg_decoder.h"
@@ -17,8 +20,11 @@
 #include "libyuv/planar_functions.h"  // For CopyPlane and ARGBShuffle.
 #include "libyuv/rotate_argb.h"
 #include "libyuv/row.h"
+#include "libyuv/scale_row.h"  // For ScaleSlope and ScaleARGBCols.
 #include "libyuv/video_common.h"
 
+#include "profile_internal.h"  // For ProfileStart
+
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
@@ -60,6 +66,8 @@ int I420ToARGBMatrix(const uint8_t* src_y,
                      const struct YuvConstants* yuvconstants,
                      int width,
                      int height) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
   int y;
   void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -74,46 +82,7 @@ int I420ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    I422ToARGBRow = I422ToARGBRow_Any_MMI;
-    if (IS_ALIGNED(width, 4)) {
-      I422ToARGBRow = I422ToARGBRow_MMI;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    I422ToARGBRow = I422ToARGBRow_Any_MSA;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_MSA;
-    }
-  }
-#endif
+  I422ToARGBRow = ROW_KERNEL(kernels, I422ToARGBRow, width);
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, yuvconstants, width);
@@ -124,6 +93,8 @@ int I420ToARGBMatrix(const uint8_t* src_y,
       src_v += src_stride_v;
     }
   }
+  ProfileStop(kProfileI420ToARGBMatrix, profile_start, (uint64_t)width * height,
+              kernels->I422ToARGBRow_Cpu);
   return 0;
 }
 
@@ -144,6 +115,119 @@ int I420ToARGB(const uint8_t* src_y,
                           &kYuvI601Constants, width, height);
 }
 
+// State shared by the jobs of I420ToARGBMatrixBatch.
+typedef struct I420ToARGBBatchJob {
+  const LibyuvConstFrame* src_frames;
+  const LibyuvFrame* dst_frames;
+  int num_frames;
+  int num_jobs;
+  const struct YuvConstants* yuvconstants;
+  void (*I422ToARGBRow)(const uint8_t* y_buf,
+                        const uint8_t* u_buf,
+                        const uint8_t* v_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+} I420ToARGBBatchJob;
+
+// Convert the index'th run of frames.
+static void I420ToARGBBatchFrames(void* job_opaque, int index) {
+  const I420ToARGBBatchJob* job = (const I420ToARGBBatchJob*)job_opaque;
+  int begin = (int)((int64_t)job->num_frames * index / job->num_jobs);
+  int end = (int)((int64_t)job->num_frames * (index + 1) / job->num_jobs);
+  int i;
+  for (i = begin; i < end; ++i) {
+    const LibyuvConstFrame* src = &job->src_frames[i];
+    const uint8_t* src_y = src->data[0];
+    const uint8_t* src_u = src->data[1];
+    const uint8_t* src_v = src->data[2];
+    uint8_t* dst_argb = job->dst_frames[i].data[0];
+    int dst_stride_argb = job->dst_frames[i].stride[0];
+    int width = src->width;
+    int height = src->height;
+    int y;
+    // Negative height means invert the image.
+    if (height < 0) {
+      height = -height;
+      dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+      dst_stride_argb = -dst_stride_argb;
+    }
+    for (y = 0; y < height; ++y) {
+      job->I422ToARGBRow(src_y, src_u, src_v, dst_argb, job->yuvconstants,
+                         width);
+      dst_argb += dst_stride_argb;
+      src_y += src->stride[0];
+      if (y & 1) {
+        src_u += src->stride[1];
+        src_v += src->stride[2];
+      }
+    }
+  }
+}
+
+// Convert a batch of I420 frames to ARGB with matrix.
+LIBYUV_API
+int I420ToARGBMatrixBatch(const LibyuvConstFrame* src_frames,
+                          const LibyuvFrame* dst_frames,
+                          int num_frames,
+                          const struct YuvConstants* yuvconstants,
+                          int num_jobs,
+                          LibyuvDispatchFunc dispatch,
+                          void* dispatch_opaque) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
+  I420ToARGBBatchJob job;
+  int all_widths = 0;  // Widths or'ed together to test alignment of all.
+  uint64_t pixels = 0;
+  int i;
+  if (!src_frames || !dst_frames || num_frames <= 0 || !yuvconstants) {
+    return -1;
+  }
+  for (i = 0; i < num_frames; ++i) {
+    const LibyuvConstFrame* src = &src_frames[i];
+    if (!src->data[0] || !src->data[1] || !src->data[2] ||
+        !dst_frames[i].data[0] || src->width <= 0 || src->height == 0) {
+      return -1;
+    }
+    all_widths |= src->width;
+    pixels += (uint64_t)src->width *
+              (src->height < 0 ? -src->height : src->height);
+  }
+  job.I422ToARGBRow = ROW_KERNEL(kernels, I422ToARGBRow, all_widths);
+  if (num_jobs > num_frames) {
+    num_jobs = num_frames;
+  }
+  if (!dispatch || num_jobs <= 1) {
+    num_jobs = 1;
+  }
+  job.src_frames = src_frames;
+  job.dst_frames = dst_frames;
+  job.num_frames = num_frames;
+  job.num_jobs = num_jobs;
+  job.yuvconstants = yuvconstants;
+  if (num_jobs == 1) {
+    I420ToARGBBatchFrames(&job, 0);
+  } else {
+    dispatch(dispatch_opaque, I420ToARGBBatchFrames, &job, num_jobs);
+  }
+  ProfileStop(kProfileI420ToARGBMatrixBatch, profile_start, pixels,
+              kernels->I422ToARGBRow_Cpu);
+  return 0;
+}
+
+// Convert a batch of I420 frames to ARGB.
+LIBYUV_API
+int I420ToARGBBatch(const LibyuvConstFrame* src_frames,
+                    const LibyuvFrame* dst_frames,
+                    int num_frames,
+                    int num_jobs,
+                    LibyuvDispatchFunc dispatch,
+                    void* dispatch_opaque) {
+  return I420ToARGBMatrixBatch(src_frames, dst_frames, num_frames,
+                               &kYuvI601Constants, num_jobs, dispatch,
+                               dispatch_opaque);
+}
+
 // Convert I420 to ABGR.
 LIBYUV_API
 int I420ToABGR(const uint8_t* src_y,
@@ -284,6 +368,8 @@ int I422ToARGBMatrix(const uint8_t* src_y,
                      const struct YuvConstants* yuvconstants,
                      int width,
                      int height) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
   int y;
   void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
                         const uint8_t* v_buf, uint8_t* rgb_buf,
@@ -305,46 +391,7 @@ int I422ToARGBMatrix(const uint8_t* src_y,
     height = 1;
     src_stride_y = src_stride_u = src_stride_v = dst_stride_argb = 0;
   }
-#if defined(HAS_I422TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      I422ToARGBRow = I422ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    I422ToARGBRow = I422ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    I422ToARGBRow = I422ToARGBRow_Any_MMI;
-    if (IS_ALIGNED(width, 4)) {
-      I422ToARGBRow = I422ToARGBRow_MMI;
-    }
-  }
-#endif
-#if defined(HAS_I422TOARGBROW_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    I422ToARGBRow = I422ToARGBRow_Any_MSA;
-    if (IS_ALIGNED(width, 8)) {
-      I422ToARGBRow = I422ToARGBRow_MSA;
-    }
-  }
-#endif
+  I422ToARGBRow = ROW_KERNEL(kernels, I422ToARGBRow, width);
 
   for (y = 0; y < height; ++y) {
     I422ToARGBRow(src_y, src_u, src_v, dst_argb, yuvconstants, width);
@@ -353,6 +400,8 @@ int I422ToARGBMatrix(const uint8_t* src_y,
     src_u += src_stride_u;
     src_v += src_stride_v;
   }
+  ProfileStop(kProfileI422ToARGBMatrix, profile_start, (uint64_t)width * height,
+              kernels->I422ToARGBRow_Cpu);
   return 0;
 }
 
@@ -1781,6 +1830,238 @@ int P210ToAR30Matrix(const uint16_t* src_y,
   return 0;
 }
 
+// SMPTE ST 2084 PQ EOTF. Returns luminance in nits for a 0 to 1 signal.
+static double PQToNits(double e) {
+  const double m1 = 2610.0 / 16384.0;
+  const double m2 = 2523.0 / 4096.0 * 128.0;
+  const double c1 = 3424.0 / 4096.0;
+  const double c2 = 2413.0 / 4096.0 * 32.0;
+  const double c3 = 2392.0 / 4096.0 * 32.0;
+  double p = pow(e, 1.0 / m2);
+  double n = p - c1;
+  if (n < 0.0) {
+    n = 0.0;
+  }
+  return 10000.0 * pow(n / (c2 - c3 * p), 1.0 / m1);
+}
+
+// Inverse of PQToNits.
+static double NitsToPQ(double nits) {
+  const double m1 = 2610.0 / 16384.0;
+  const double m2 = 2523.0 / 4096.0 * 128.0;
+  const double c1 = 3424.0 / 4096.0;
+  const double c2 = 2413.0 / 4096.0 * 32.0;
+  const double c3 = 2392.0 / 4096.0 * 32.0;
+  double y = pow(nits / 10000.0, m1);
+  return pow((c1 + c2 * y) / (1.0 + c3 * y), m2);
+}
+
+// ARIB STD-B67 HLG inverse OETF. Returns scene linear light 0 to 1.
+static double HLGToScene(double e) {
+  const double a = 0.17883277;
+  const double b = 0.28466892;
+  const double c = 0.55991073;
+  if (e <= 0.5) {
+    return e * e / 3.0;
+  }
+  return (exp((e - c) / a) + b) / 12.0;
+}
+
+static double Hable(double x) {
+  const double A = 0.15, B = 0.50, C = 0.10, D = 0.20, E = 0.02, F = 0.30;
+  return ((x * (A * x + C * B) + D * E) / (x * (A * x + B) + D * F)) - E / F;
+}
+
+// ITU-R BT.2390 EETF. Maps luminance up to peak_nits into white_nits,
+// compressing with a hermite spline in the PQ domain.
+static double BT2390(double nits, double peak_nits, double white_nits) {
+  double max_pq = NitsToPQ(peak_nits);
+  double e = NitsToPQ(nits) / max_pq;
+  double max_lum = NitsToPQ(white_nits) / max_pq;
+  double ks = 1.5 * max_lum - 0.5;
+  if (e > ks && ks < 1.0) {
+    double t = (e - ks) / (1.0 - ks);
+    double t2 = t * t;
+    double t3 = t2 * t;
+    e = (2.0 * t3 - 3.0 * t2 + 1.0) * ks + (t3 - 2.0 * t2 + t) * (1.0 - ks) +
+        (-2.0 * t3 + 3.0 * t2) * max_lum;
+  }
+  return PQToNits(e * max_pq);
+}
+
+// Build the tone mapping tables for P010ToARGBToneMap and friends.
+LIBYUV_API
+int InitToneMapConstants(struct ToneMapConstants* tonemap,
+                         enum HdrTransfer transfer,
+                         enum ToneMapCurve curve,
+                         int peak_nits,
+                         int sdr_white_nits) {
+  // BT.2020 to BT.709 primaries, 12 bit fixed point.
+  static const int16_t kBT2020ToBT709[3][3] = {
+      {6801, -2407, -298}, {-510, 4640, -34}, {-74, -412, 4582}};
+  double white = sdr_white_nits;
+  double peak = peak_nits;
+  // BT.2100 gives the HLG system gamma for displays of 400 to 2000 nits.
+  double hlg_peak = peak < 400.0 ? 400.0 : (peak > 2000.0 ? 2000.0 : peak);
+  double hlg_gamma = 1.2 + 0.42 * log10(hlg_peak / 1000.0);
+  int i;
+  if (!tonemap || peak_nits <= 0 || sdr_white_nits <= 0 ||
+      (transfer != kHdrTransferPQ && transfer != kHdrTransferHLG) ||
+      curve < kToneMapClip || curve > kToneMapBT2390) {
+    return -1;
+  }
+  for (i = 0; i < 3; ++i) {
+    int j;
+    for (j = 0; j < 8; ++j) {
+      tonemap->kMatrix[i * 2][j * 2 + 0] = kBT2020ToBT709[i][0];
+      tonemap->kMatrix[i * 2][j * 2 + 1] = kBT2020ToBT709[i][1];
+      tonemap->kMatrix[i * 2 + 1][j * 2 + 0] = kBT2020ToBT709[i][2];
+      tonemap->kMatrix[i * 2 + 1][j * 2 + 1] = 8192;  // Rounding.
+    }
+  }
+  for (i = 0; i < 1024; ++i) {
+    double e = i / 1023.0;
+    double nits;
+    double x;
+    if (transfer == kHdrTransferPQ) {
+      nits = PQToNits(e);
+    } else {
+      // HLG OOTF, applied per channel.  See kHdrTransferHLG.
+      nits = peak * pow(HLGToScene(e), hlg_gamma);
+    }
+    x = nits / white;
+    switch (curve) {
+      case kToneMapReinhard: {
+        double xmax = peak / white;
+        x = x * (1.0 + x / (xmax * xmax)) / (1.0 + x);
+        break;
+      }
+      case kToneMapHable:
+        x = Hable(x) / Hable(peak / white);
+        break;
+      case kToneMapBT2390:
+        if (peak > white) {
+          x = BT2390(nits < peak ? nits : peak, peak, white) / white;
+        }
+        break;
+      default:
+        break;
+    }
+    x = x < 0.0 ? 0.0 : (x > 1.0 ? 1.0 : x);
+    tonemap->kLinear[i] = (uint16_t)(x * 16384.0 + 0.5);
+  }
+  // Padding read by the 32 bit gathers of the AVX2 row.
+  tonemap->kLinear[1024] = tonemap->kLinear[1023];
+  tonemap->kLinear[1025] = tonemap->kLinear[1023];
+  for (i = 0; i <= 4096; ++i) {
+    double l = i / 4096.0;
+    double v = l < 0.018 ? 4.5 * l : 1.099 * pow(l, 0.45) - 0.099;
+    int g = (int)(v * 255.0 + 0.5);
+    tonemap->kGamma[i] = (uint8_t)(g > 255 ? 255 : g);
+  }
+  for (; i < 4100; ++i) {
+    tonemap->kGamma[i] = 255u;
+  }
+  return 0;
+}
+
+// Convert BT.2020 P010 with PQ or HLG transfer to SDR ARGB.
+LIBYUV_API
+int P010ToARGBToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_uv,
+                      int src_stride_uv,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  int y;
+  void (*P210ToARGBToneMapRow)(
+      const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants,
+      const struct ToneMapConstants* tonemap, int width) =
+      P210ToARGBToneMapRow_C;
+  if (!src_y || !src_uv || !dst_argb || !tonemap || width <= 0 ||
+      height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+#if defined(HAS_P210TOARGBTONEMAPROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToARGBToneMapRow = P210ToARGBToneMapRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      P210ToARGBToneMapRow = P210ToARGBToneMapRow_AVX2;
+    }
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    P210ToARGBToneMapRow(src_y, src_uv, dst_argb, &kYuv2020Constants, tonemap,
+                         width);
+    dst_argb += dst_stride_argb;
+    src_y += src_stride_y;
+    if (y & 1) {
+      src_uv += src_stride_uv;
+    }
+  }
+  return 0;
+}
+
+// Convert BT.2020 I010 with PQ or HLG transfer to SDR ARGB.
+LIBYUV_API
+int I010ToARGBToneMap(const uint16_t* src_y,
+                      int src_stride_y,
+                      const uint16_t* src_u,
+                      int src_stride_u,
+                      const uint16_t* src_v,
+                      int src_stride_v,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      const struct ToneMapConstants* tonemap,
+                      int width,
+                      int height) {
+  int y;
+  void (*I210ToARGBToneMapRow)(
+      const uint16_t* y_buf, const uint16_t* u_buf, const uint16_t* v_buf,
+      uint8_t* rgb_buf, const struct YuvConstants* yuvconstants,
+      const struct ToneMapConstants* tonemap, int width) =
+      I210ToARGBToneMapRow_C;
+  if (!src_y || !src_u || !src_v || !dst_argb || !tonemap || width <= 0 ||
+      height == 0) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+#if defined(HAS_I210TOARGBTONEMAPROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I210ToARGBToneMapRow = I210ToARGBToneMapRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      I210ToARGBToneMapRow = I210ToARGBToneMapRow_AVX2;
+    }
+  }
+#endif
+  for (y = 0; y < height; ++y) {
+    I210ToARGBToneMapRow(src_y, src_u, src_v, dst_argb, &kYuv2020Constants,
+                         tonemap, width);
+    dst_argb += dst_stride_argb;
+    src_y += src_stride_y;
+    if (y & 1) {
+      src_u += src_stride_u;
+      src_v += src_stride_v;
+    }
+  }
+  return 0;
+}
+
 // Convert I420 with Alpha to preattenuated ARGB with matrix.
 LIBYUV_API
 int I420AlphaToARGBMatrix(const uint8_t* src_y,
@@ -3502,6 +3783,8 @@ int NV12ToARGBMatrix(const uint8_t* src_y,
                      const struct YuvConstants* yuvconstants,
                      int width,
                      int height) {
+  const struct RowKernels* kernels = GetRowKernels();
+  uint64_t profile_start = ProfileStart();
   int y;
   void (*NV12ToARGBRow)(
       const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
@@ -3515,46 +3798,7 @@ int NV12ToARGBMatrix(const uint8_t* src_y,
     dst_argb = dst_argb + (height - 1) * dst_stride_argb;
     dst_stride_argb = -dst_stride_argb;
   }
-#if defined(HAS_NV12TOARGBROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
-    if (IS_ALIGNED(width, 8)) {
-      NV12ToARGBRow = NV12ToARGBRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_NV12TOARGBROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
-    if (IS_ALIGNED(width, 16)) {
-      NV12ToARGBRow = NV12ToARGBRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_NV12TOARGBROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
-    if (IS_ALIGNED(width, 8)) {
-      NV12ToARGBRow = NV12ToARGBRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_NV12TOARGBROW_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_MMI;
-    if (IS_ALIGNED(width, 4)) {
-      NV12ToARGBRow = NV12ToARGBRow_MMI;
-    }
-  }
-#endif
-#if defined(HAS_NV12TOARGBROW_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    NV12ToARGBRow = NV12ToARGBRow_Any_MSA;
-    if (IS_ALIGNED(width, 8)) {
-      NV12ToARGBRow = NV12ToARGBRow_MSA;
-    }
-  }
-#endif
+  NV12ToARGBRow = ROW_KERNEL(kernels, NV12ToARGBRow, width);
 
   for (y = 0; y < height; ++y) {
     NV12ToARGBRow(src_y, src_uv, dst_argb, yuvconstants, width);
@@ -3564,6 +3808,8 @@ int NV12ToARGBMatrix(const uint8_t* src_y,
       src_uv += src_stride_uv;
     }
   }
+  ProfileStop(kProfileNV12ToARGBMatrix, profile_start, (uint64_t)width * height,
+              kernels->NV12ToARGBRow_Cpu);
   return 0;
 }
 
@@ -3643,6 +3889,137 @@ int NV21ToARGBMatrix(const uint8_t* src_y,
   return 0;
 }
 
+// Convert MM21 to ARGB with matrix.  Each row of Y and UV is detiled into a
+// row buffer and converted with NV12ToARGBRow while it is in cache.
+LIBYUV_API
+int MM21ToARGBMatrix(const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_uv,
+                     int src_stride_uv,
+                     uint8_t* dst_argb,
+                     int dst_stride_argb,
+                     const struct YuvConstants* yuvconstants,
+                     int width,
+                     int height) {
+  int y;
+  void (*NV12ToARGBRow)(
+      const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants, int width) = NV12ToARGBRow_C;
+  void (*DetileRow)(const uint8_t* src, ptrdiff_t src_tile_stride,
+                    uint8_t* dst, int width) = DetileRow_C;
+  const int uv_width = (width + 1) & ~1;
+  if (!src_y || !src_uv || !dst_argb || width <= 0 || height == 0 ||
+      src_stride_y < width || src_stride_uv < uv_width) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_argb = dst_argb + (height - 1) * dst_stride_argb;
+    dst_stride_argb = -dst_stride_argb;
+  }
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_MMI;
+    if (IS_ALIGNED(width, 4)) {
+      NV12ToARGBRow = NV12ToARGBRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_MSA;
+    if (IS_ALIGNED(width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_DETILEROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    DetileRow = DetileRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16) && IS_ALIGNED(uv_width, 16)) {
+      DetileRow = DetileRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_DETILEROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    DetileRow = DetileRow_Any_NEON;
+    if (IS_ALIGNED(width, 16) && IS_ALIGNED(uv_width, 16)) {
+      DetileRow = DetileRow_NEON;
+    }
+  }
+#endif
+  {
+    // Allocate a row of Y and a row of UV.
+    const int kRowSize = (width + 31) & ~31;
+    align_buffer_64(row_y, kRowSize * 2);
+    uint8_t* row_uv = row_y + kRowSize;
+
+    for (y = 0; y < height; ++y) {
+      // Y tiles are 16x32 and UV tiles are 16x16.
+      DetileRow(src_y + (y & ~31) * src_stride_y + (y & 31) * 16, 16 * 32,
+                row_y, width);
+      if (!(y & 1)) {
+        int uv_y = y >> 1;
+        DetileRow(src_uv + (uv_y & ~15) * src_stride_uv + (uv_y & 15) * 16,
+                  16 * 16, row_uv, uv_width);
+      }
+      NV12ToARGBRow(row_y, row_uv, dst_argb, yuvconstants, width);
+      dst_argb += dst_stride_argb;
+    }
+    free_aligned_buffer_64(row_y);
+  }
+  return 0;
+}
+
+// Convert MM21 to ARGB.
+LIBYUV_API
+int MM21ToARGB(const uint8_t* src_y,
+               int src_stride_y,
+               const uint8_t* src_uv,
+               int src_stride_uv,
+               uint8_t* dst_argb,
+               int dst_stride_argb,
+               int width,
+               int height) {
+  return MM21ToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                          dst_argb, dst_stride_argb, &kYuvI601Constants,
+                          width, height);
+}
+
 // Convert NV12 to ARGB.
 LIBYUV_API
 int NV12ToARGB(const uint8_t* src_y,
@@ -5134,6 +5511,14 @@ int I420ToRGB565Dither(const uint8_t* src_y,
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
@@ -5344,6 +5729,528 @@ int H420ToAB30(const uint8_t* src_y,
                           &kYvuH709Constants, width, height);
 }
 
+// Source image of the RGB tensor functions.  Rows are converted to ARGB with
+// whichever row function is set, or used directly if neither is set.
+typedef struct RGBTensorSource {
+  const uint8_t* src_y;  // ARGB if no row function is set.
+  const uint8_t* src_u;  // UV for NV12.
+  const uint8_t* src_v;
+  int src_stride_y;
+  int src_stride_u;
+  int src_stride_v;
+  const struct YuvConstants* yuvconstants;
+  void (*I422ToARGBRow)(const uint8_t* y_buf,
+                        const uint8_t* u_buf,
+                        const uint8_t* v_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+  void (*NV12ToARGBRow)(const uint8_t* y_buf,
+                        const uint8_t* uv_buf,
+                        uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants,
+                        int width);
+} RGBTensorSource;
+
+// Returns ARGB row y of the source, converted into row_argb if needed.
+static const uint8_t* RGBTensorSourceRow(const RGBTensorSource* source,
+                                         int y,
+                                         uint8_t* row_argb,
+                                         int width) {
+  const uint8_t* src_y = source->src_y + y * source->src_stride_y;
+  const uint8_t* src_u = source->src_u + (y >> 1) * source->src_stride_u;
+  const uint8_t* src_v = source->src_v + (y >> 1) * source->src_stride_v;
+  if (source->I422ToARGBRow) {
+    source->I422ToARGBRow(src_y, src_u, src_v, row_argb, source->yuvconstants,
+                          width);
+    return row_argb;
+  }
+  if (source->NV12ToARGBRow) {
+    source->NV12ToARGBRow(src_y, src_u, row_argb, source->yuvconstants, width);
+    return row_argb;
+  }
+  return src_y;
+}
+
+static void InitRGBNormConstants(struct RGBNormConstants* norm,
+                                 const float* mean,
+                                 const float* scale) {
+  int i;
+  for (i = 0; i < 3; ++i) {
+    norm->kScale[i] = scale ? scale[i] : 1.f / 255.f;
+    norm->kBias[i] = mean ? -mean[i] * norm->kScale[i] : 0.f;
+  }
+  norm->kScale[3] = 0.f;
+  norm->kBias[3] = 0.f;
+  for (i = 0; i < 24; ++i) {
+    norm->kScaleRGB[i] = norm->kScale[i % 3];
+    norm->kBiasRGB[i] = norm->kBias[i % 3];
+  }
+}
+
+// Convert, resize and normalize a row at a time.  Each destination row is
+// made from 1 or 2 horizontally scaled source rows, which are kept while
+// following rows use them.
+static int RGBTensorFromSource(const RGBTensorSource* source,
+                               int src_width,
+                               int src_height,
+                               void* dst_tensor,
+                               int dst_width,
+                               int dst_height,
+                               enum RGBTensorFormat format,
+                               const float* mean,
+                               const float* scale,
+                               enum FilterMode filtering) {
+  const int resize = src_width != dst_width || src_height != dst_height;
+  const int half = format == kTensorHalfCHW || format == kTensorHalfHWC;
+  const int hwc = format == kTensorFloatHWC || format == kTensorHalfHWC;
+  const int converted = source->I422ToARGBRow || source->NV12ToARGBRow;
+  // Filtering reads 1 pixel past the end of the source row.
+  const int kSrcRowSize = converted ? (src_width * 4 + 4 + 63) & ~63 : 0;
+  const int kRowSize = (dst_width * 4 + 63) & ~63;
+  const int kNumRows = !resize ? 0 : filtering ? 3 : 1;
+  const int kRawSize = hwc ? (dst_width * 3 + 63) & ~63 : 0;
+  const int kFloatSize = half ? (dst_width * 3 * 4 + 63) & ~63 : 0;
+  const ptrdiff_t plane = (ptrdiff_t)dst_width * dst_height;
+  const int max_y = (src_height - 1) << 16;
+  float* dst_float = (float*)dst_tensor;
+  uint16_t* dst_half = (uint16_t*)dst_tensor;
+  struct RGBNormConstants norm;
+  int x = 0;
+  int y = 0;
+  int dx = 0;
+  int dy = 0;
+  int j;
+  void (*ARGBToRGBFloatRow)(const uint8_t* src_argb, float* dst_r,
+                            float* dst_g, float* dst_b,
+                            const struct RGBNormConstants* norm, int width) =
+      ARGBToRGBFloatRow_C;
+  void (*ARGBToRAWRow)(const uint8_t* src_argb, uint8_t* dst_rgb, int width) =
+      ARGBToRAWRow_C;
+  void (*RAWToFloatRow)(const uint8_t* src_raw, float* dst,
+                        const struct RGBNormConstants* norm, int width) =
+      RAWToFloatRow_C;
+  void (*FloatToHalfRow)(const float* src, uint16_t* dst, int width) =
+      FloatToHalfRow_C;
+  void (*InterpolateRow)(uint8_t * dst_argb, const uint8_t* src_argb,
+                         ptrdiff_t src_stride, int dst_width,
+                         int source_y_fraction) = InterpolateRow_C;
+  void (*ScaleARGBCols)(uint8_t * dst_argb, const uint8_t* src_argb,
+                        int dst_width, int x, int dx);
+  if (filtering != kFilterNone) {
+    filtering = kFilterBilinear;
+  }
+  ScaleARGBCols = filtering ? ScaleARGBFilterCols_C : ScaleARGBCols_C;
+#if defined(HAS_ARGBTORGBFLOATROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToRGBFloatRow = ARGBToRGBFloatRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ARGBToRGBFloatRow = ARGBToRGBFloatRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_RAWTOFLOATROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    RAWToFloatRow = RAWToFloatRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      RAWToFloatRow = RAWToFloatRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_FLOATTOHALFROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    FloatToHalfRow = FloatToHalfRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      FloatToHalfRow = FloatToHalfRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTORAWROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBToRAWRow = ARGBToRAWRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ARGBToRAWRow = ARGBToRAWRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTORAWROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBToRAWRow = ARGBToRAWRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 32)) {
+      ARGBToRAWRow = ARGBToRAWRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTORAWROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBToRAWRow = ARGBToRAWRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ARGBToRAWRow = ARGBToRAWRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTORAWROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    ARGBToRAWRow = ARGBToRAWRow_Any_MMI;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ARGBToRAWRow = ARGBToRAWRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_ARGBTORAWROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    ARGBToRAWRow = ARGBToRAWRow_Any_MSA;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ARGBToRAWRow = ARGBToRAWRow_MSA;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    InterpolateRow = InterpolateRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 4)) {
+      InterpolateRow = InterpolateRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    InterpolateRow = InterpolateRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      InterpolateRow = InterpolateRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    InterpolateRow = InterpolateRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 4)) {
+      InterpolateRow = InterpolateRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    InterpolateRow = InterpolateRow_Any_MMI;
+    if (IS_ALIGNED(dst_width, 2)) {
+      InterpolateRow = InterpolateRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    InterpolateRow = InterpolateRow_Any_MSA;
+    if (IS_ALIGNED(dst_width, 8)) {
+      InterpolateRow = InterpolateRow_MSA;
+    }
+  }
+#endif
+  if (src_width >= 32768) {
+    ScaleARGBCols = filtering ? ScaleARGBFilterCols64_C : ScaleARGBCols64_C;
+  }
+#if defined(HAS_SCALEARGBFILTERCOLS_SSSE3)
+  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
+    ScaleARGBCols = ScaleARGBFilterCols_SSSE3;
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBCols = ScaleARGBFilterCols_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBCols = ScaleARGBFilterCols_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX512BW)
+  if (filtering && TestCpuFlag(kCpuHasAVX512BW) && src_width < 32768) {
+    ScaleARGBCols = ScaleARGBFilterCols_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleARGBCols = ScaleARGBFilterCols_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_NEON)
+  if (filtering && TestCpuFlag(kCpuHasNEON)) {
+    ScaleARGBCols = ScaleARGBFilterCols_Any_NEON;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ScaleARGBCols = ScaleARGBFilterCols_NEON;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_MSA)
+  if (filtering && TestCpuFlag(kCpuHasMSA)) {
+    ScaleARGBCols = ScaleARGBFilterCols_Any_MSA;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBCols = ScaleARGBFilterCols_MSA;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBCOLS_SSE2)
+  if (!filtering && TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
+    ScaleARGBCols = ScaleARGBCols_SSE2;
+  }
+#endif
+#if defined(HAS_SCALEARGBCOLS_NEON)
+  if (!filtering && TestCpuFlag(kCpuHasNEON)) {
+    ScaleARGBCols = ScaleARGBCols_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBCols = ScaleARGBCols_NEON;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBCOLS_MMI)
+  if (!filtering && TestCpuFlag(kCpuHasMMI)) {
+    ScaleARGBCols = ScaleARGBCols_Any_MMI;
+    if (IS_ALIGNED(dst_width, 1)) {
+      ScaleARGBCols = ScaleARGBCols_MMI;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBCOLS_MSA)
+  if (!filtering && TestCpuFlag(kCpuHasMSA)) {
+    ScaleARGBCols = ScaleARGBCols_Any_MSA;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ScaleARGBCols = ScaleARGBCols_MSA;
+    }
+  }
+#endif
+
+  InitRGBNormConstants(&norm, mean, scale);
+  if (resize) {
+    ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
+               &dx, &dy);
+  }
+
+  {
+    align_buffer_64(row,
+                    kSrcRowSize + kRowSize * kNumRows + kRawSize + kFloatSize);
+    uint8_t* row_argb = row;
+    uint8_t* row_cols0 = row + kSrcRowSize;
+    uint8_t* row_cols1 = row_cols0 + kRowSize;
+    uint8_t* row_blend = row_cols1 + kRowSize;
+    uint8_t* row_raw = row + kSrcRowSize + kRowSize * kNumRows;
+    float* row_float = (float*)(row_raw + kRawSize);
+    int y0 = -1;  // Source rows held in row_cols0 and row_cols1.
+    int y1 = -1;
+    if (!row) {
+      return 1;
+    }
+
+    for (j = 0; j < dst_height; ++j) {
+      const uint8_t* src_argb;
+      if (!resize) {
+        src_argb = RGBTensorSourceRow(source, j, row_argb, src_width);
+      } else if (!filtering) {
+        ScaleARGBCols(row_cols0,
+                      RGBTensorSourceRow(source, y >> 16, row_argb, src_width),
+                      dst_width, x, dx);
+        src_argb = row_cols0;
+        y += dy;
+      } else {
+        int yi;
+        int yf;
+        if (y > max_y) {
+          y = max_y;
+        }
+        yi = y >> 16;
+        yf = (y >> 8) & 255;
+        if (y0 != yi && y1 == yi) {
+          uint8_t* row_swap = row_cols0;
+          row_cols0 = row_cols1;
+          row_cols1 = row_swap;
+          y1 = y0;
+          y0 = yi;
+        }
+        if (y0 != yi) {
+          ScaleARGBCols(row_cols0,
+                        RGBTensorSourceRow(source, yi, row_argb, src_width),
+                        dst_width, x, dx);
+          y0 = yi;
+        }
+        src_argb = row_cols0;
+        if (yf) {
+          if (y1 != yi + 1) {
+            ScaleARGBCols(
+                row_cols1,
+                RGBTensorSourceRow(source, yi + 1, row_argb, src_width),
+                dst_width, x, dx);
+            y1 = yi + 1;
+          }
+          InterpolateRow(row_blend, row_cols0, row_cols1 - row_cols0,
+                         dst_width * 4, yf);
+          src_argb = row_blend;
+        }
+        y += dy;
+      }
+
+      if (!hwc) {
+        float* dst_r = half ? row_float : dst_float + (ptrdiff_t)j * dst_width;
+        float* dst_g = half ? dst_r + dst_width : dst_r + plane;
+        float* dst_b = half ? dst_g + dst_width : dst_g + plane;
+        ARGBToRGBFloatRow(src_argb, dst_r, dst_g, dst_b, &norm, dst_width);
+        if (half) {
+          uint16_t* dst = dst_half + (ptrdiff_t)j * dst_width;
+          FloatToHalfRow(dst_r, dst, dst_width);
+          FloatToHalfRow(dst_g, dst + plane, dst_width);
+          FloatToHalfRow(dst_b, dst + plane * 2, dst_width);
+        }
+      } else {
+        ptrdiff_t offset = (ptrdiff_t)j * dst_width * 3;
+        ARGBToRAWRow(src_argb, row_raw, dst_width);
+        if (half) {
+          RAWToFloatRow(row_raw, row_float, &norm, dst_width);
+          FloatToHalfRow(row_float, dst_half + offset, dst_width * 3);
+        } else {
+          RAWToFloatRow(row_raw, dst_float + offset, &norm, dst_width);
+        }
+      }
+    }
+    free_aligned_buffer_64(row);
+  }
+  return 0;
+}
+
+// Convert ARGB to an RGB tensor.
+LIBYUV_API
+int ARGBToRGBTensor(const uint8_t* src_argb,
+                    int src_stride_argb,
+                    int src_width,
+                    int src_height,
+                    void* dst_tensor,
+                    int dst_width,
+                    int dst_height,
+                    enum RGBTensorFormat format,
+                    const float* mean,
+                    const float* scale,
+                    enum FilterMode filtering) {
+  RGBTensorSource source;
+  memset(&source, 0, sizeof(source));
+  if (!src_argb || !dst_tensor || src_width <= 0 || src_height == 0 ||
+      dst_width <= 0 || dst_height <= 0 || format < kTensorFloatCHW ||
+      format > kTensorHalfHWC) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_argb = src_argb + (src_height - 1) * src_stride_argb;
+    src_stride_argb = -src_stride_argb;
+  }
+  source.src_y = src_argb;
+  source.src_stride_y = src_stride_argb;
+  return RGBTensorFromSource(&source, src_width, src_height, dst_tensor,
+                             dst_width, dst_height, format, mean, scale,
+                             filtering);
+}
+
+// Convert I420 to an RGB tensor with matrix.
+LIBYUV_API
+int I420ToRGBTensorMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          const struct YuvConstants* yuvconstants,
+                          int src_width,
+                          int src_height,
+                          void* dst_tensor,
+                          int dst_width,
+                          int dst_height,
+                          enum RGBTensorFormat format,
+                          const float* mean,
+                          const float* scale,
+                          enum FilterMode filtering) {
+  const struct RowKernels* kernels = GetRowKernels();
+  RGBTensorSource source;
+  uint64_t profile_start = ProfileStart();
+  int r;
+  memset(&source, 0, sizeof(source));
+  if (!src_y || !src_u || !src_v || !yuvconstants || !dst_tensor ||
+      src_width <= 0 || src_height == 0 || dst_width <= 0 || dst_height <= 0 ||
+      format < kTensorFloatCHW || format > kTensorHalfHWC) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    int halfheight;
+    src_height = -src_height;
+    halfheight = (src_height + 1) >> 1;
+    src_y = src_y + (src_height - 1) * src_stride_y;
+    src_u = src_u + (halfheight - 1) * src_stride_u;
+    src_v = src_v + (halfheight - 1) * src_stride_v;
+    src_stride_y = -src_stride_y;
+    src_stride_u = -src_stride_u;
+    src_stride_v = -src_stride_v;
+  }
+  source.src_y = src_y;
+  source.src_u = src_u;
+  source.src_v = src_v;
+  source.src_stride_y = src_stride_y;
+  source.src_stride_u = src_stride_u;
+  source.src_stride_v = src_stride_v;
+  source.yuvconstants = yuvconstants;
+  source.I422ToARGBRow = ROW_KERNEL(kernels, I422ToARGBRow, src_width);
+  r = RGBTensorFromSource(&source, src_width, src_height, dst_tensor,
+                          dst_width, dst_height, format, mean, scale,
+                          filtering);
+  if (r == 0) {
+    ProfileStop(kProfileI420ToRGBTensorMatrix, profile_start,
+                (uint64_t)dst_width * dst_height, kProfileKernelMixed);
+  }
+  return r;
+}
+
+// Convert NV12 to an RGB tensor with matrix.
+LIBYUV_API
+int NV12ToRGBTensorMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          const struct YuvConstants* yuvconstants,
+                          int src_width,
+                          int src_height,
+                          void* dst_tensor,
+                          int dst_width,
+                          int dst_height,
+                          enum RGBTensorFormat format,
+                          const float* mean,
+                          const float* scale,
+                          enum FilterMode filtering) {
+  const struct RowKernels* kernels = GetRowKernels();
+  RGBTensorSource source;
+  uint64_t profile_start = ProfileStart();
+  int r;
+  memset(&source, 0, sizeof(source));
+  if (!src_y || !src_uv || !yuvconstants || !dst_tensor || src_width <= 0 ||
+      src_height == 0 || dst_width <= 0 || dst_height <= 0 ||
+      format < kTensorFloatCHW || format > kTensorHalfHWC) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src_y = src_y + (src_height - 1) * src_stride_y;
+    src_uv = src_uv + (((src_height + 1) >> 1) - 1) * src_stride_uv;
+    src_stride_y = -src_stride_y;
+    src_stride_uv = -src_stride_uv;
+  }
+  source.src_y = src_y;
+  source.src_u = src_uv;
+  source.src_stride_y = src_stride_y;
+  source.src_stride_u = src_stride_uv;
+  source.yuvconstants = yuvconstants;
+  source.NV12ToARGBRow = ROW_KERNEL(kernels, NV12ToARGBRow, src_width);
+  r = RGBTensorFromSource(&source, src_width, src_height, dst_tensor,
+                          dst_width, dst_height, format, mean, scale,
+                          filtering);
+  if (r == 0) {
+    ProfileStop(kProfileNV12ToRGBTensorMatrix, profile_start,
+                (uint64_t)dst_width * dst_height, kProfileKernelMixed);
+  }
+  return r;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -12,7 +12,10 @@
 #include "libyuv/convert_argb.h"
 
 #ifdef HAVE_JPEG
+#include <stdlib.h>  // For malloc.
+
 #include "libyuv/mjpeg_decoder.h"
+#include "libyuv/scale_row.h"  // For ScaleBandPlane.
 #endif
 
 #ifdef __cplusplus
@@ -106,90 +109,108 @@ int MJPGSize(const uint8_t* src_mjpg,
 // MJPG (Motion JPeg) to I420
 // TODO(fbarchard): review src_width and src_height requirement. dst_width and
 // dst_height may be enough.
-LIBYUV_API
-int MJPGToI420(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_u,
-               int dst_stride_u,
-               uint8_t* dst_v,
-               int dst_stride_v,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int DecodeMJPGToI420(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_u,
+                            int dst_stride_u,
+                            uint8_t* dst_v,
+                            int dst_stride_v,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     I420Buffers bufs = {dst_y, dst_stride_y, dst_u,     dst_stride_u,
                         dst_v, dst_stride_v, dst_width, dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegCopyI420, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegCopyI420, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToI420, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToI420, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToI420, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToI420, &bufs, dst_width,
+                                            dst_height);
     } else {
       // TODO(fbarchard): Implement conversion for any other
       // colorspace/subsample factors that occur in practice. ERROR: Unable to
       // convert MJPEG frame because format is not supported
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToI420(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_u,
+               int dst_stride_u,
+               uint8_t* dst_v,
+               int dst_stride_v,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  MJpegDecoder mjpeg_decoder;
+  return DecodeMJPGToI420(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_y,
+                          dst_stride_y, dst_u, dst_stride_u, dst_v,
+                          dst_stride_v, src_width, src_height, dst_width,
+                          dst_height);
+}
+
 struct NV21Buffers {
   uint8_t* y;
   int y_stride;
@@ -248,86 +269,101 @@ static void JpegI400ToNV21(void* opaque,
 }
 
 // MJPG (Motion JPeg) to NV21
-LIBYUV_API
-int MJPGToNV21(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_vu,
-               int dst_stride_vu,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int DecodeMJPGToNV21(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_vu,
+                            int dst_stride_vu,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     NV21Buffers bufs = {dst_y,         dst_stride_y, dst_vu,
                         dst_stride_vu, dst_width,    dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToNV21, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToNV21, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToNV21, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToNV21, &bufs, dst_width,
+                                            dst_height);
     } else {
       // Unknown colorspace.
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToNV21(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_vu,
+               int dst_stride_vu,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  MJpegDecoder mjpeg_decoder;
+  return DecodeMJPGToNV21(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_y,
+                          dst_stride_y, dst_vu, dst_stride_vu, src_width,
+                          src_height, dst_width, dst_height);
+}
+
 static void JpegI420ToNV12(void* opaque,
                            const uint8_t* const* data,
                            const int* strides,
@@ -381,29 +417,27 @@ static void JpegI400ToNV12(void* opaque,
 }
 
 // MJPG (Motion JPEG) to NV12.
-LIBYUV_API
-int MJPGToNV12(const uint8_t* sample,
-               size_t sample_size,
-               uint8_t* dst_y,
-               int dst_stride_y,
-               uint8_t* dst_uv,
-               int dst_stride_uv,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int DecodeMJPGToNV12(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* sample,
+                            size_t sample_size,
+                            uint8_t* dst_y,
+                            int dst_stride_y,
+                            uint8_t* dst_uv,
+                            int dst_stride_uv,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (sample_size == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(sample, sample_size);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(sample, sample_size);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
@@ -411,57 +445,460 @@ int MJPGToNV12(const uint8_t* sample,
     NV21Buffers bufs = {dst_y,         dst_stride_y, dst_uv,
                         dst_stride_uv, dst_width,    dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToNV12, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToNV12, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToNV12, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToNV12, &bufs, dst_width,
+                                            dst_height);
     } else {
       // Unknown colorspace.
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToNV12(const uint8_t* sample,
+               size_t sample_size,
+               uint8_t* dst_y,
+               int dst_stride_y,
+               uint8_t* dst_uv,
+               int dst_stride_uv,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  MJpegDecoder mjpeg_decoder;
+  return DecodeMJPGToNV12(&mjpeg_decoder, sample, sample_size, dst_y,
+                          dst_stride_y, dst_uv, dst_stride_uv, src_width,
+                          src_height, dst_width, dst_height);
+}
+
+// Rows scaled per band by MJPGScaleToNV12, before rotation.
+static const int kJpegScaleBandRows = 16;
+
+// Each plane is scaled with a ScaleBandPlane, as the iMCU rows are decoded.
+struct NV12ScaleBuffers {
+  ScaleBandPlane planes[3];
+  uint8_t* bands[3];  // Scaled rows before rotation.
+  int num_planes;
+  uint8_t* y;
+  int y_stride;
+  uint8_t* uv;
+  int uv_stride;
+  enum RotationMode rotation;
+  uint8_t* rotate_u;  // A rotated U band.
+  uint8_t* rotate_v;
+  LIBYUV_BOOL error;  // Set if a window could not take an iMCU row.
+};
+
+static void JpegScaleRotateY(NV12ScaleBuffers* dest, int rows) {
+  ScaleBandPlane* p = &dest->planes[0];
+  uint8_t* band = dest->bands[0];
+  int w = p->dst_width;
+  int y = p->dst_y;
+  int y_end = p->dst_height - y - rows;  // First row of the band, flipped.
+  switch (dest->rotation) {
+    case kRotate0:
+      ScaleBandRows(p, dest->y + y * dest->y_stride, dest->y_stride, rows);
+      break;
+    case kRotate90:
+      ScaleBandRows(p, band, w, rows);
+      RotatePlane90(band, w, dest->y + y_end, dest->y_stride, w, rows);
+      break;
+    case kRotate180:
+      ScaleBandRows(p, band, w, rows);
+      RotatePlane180(band, w, dest->y + y_end * dest->y_stride,
+                     dest->y_stride, w, rows);
+      break;
+    case kRotate270:
+      ScaleBandRows(p, band, w, rows);
+      RotatePlane270(band, w, dest->y + y, dest->y_stride, w, rows);
+      break;
+  }
+}
+
+static void JpegScaleRotateUV(NV12ScaleBuffers* dest, int rows) {
+  ScaleBandPlane* u = &dest->planes[1];
+  ScaleBandPlane* v = &dest->planes[2];
+  uint8_t* band_u = dest->bands[1];
+  uint8_t* band_v = dest->bands[2];
+  int w = u->dst_width;
+  int y = u->dst_y;
+  int y_end = u->dst_height - y - rows;
+  ScaleBandRows(u, band_u, w, rows);
+  ScaleBandRows(v, band_v, w, rows);
+  switch (dest->rotation) {
+    case kRotate0:
+      MergeUVPlane(band_u, w, band_v, w, dest->uv + y * dest->uv_stride,
+                   dest->uv_stride, w, rows);
+      break;
+    case kRotate90:
+      RotatePlane90(band_u, w, dest->rotate_u, rows, w, rows);
+      RotatePlane90(band_v, w, dest->rotate_v, rows, w, rows);
+      MergeUVPlane(dest->rotate_u, rows, dest->rotate_v, rows,
+                   dest->uv + y_end * 2, dest->uv_stride, rows, w);
+      break;
+    case kRotate180:
+      RotatePlane180(band_u, w, dest->rotate_u, w, w, rows);
+      RotatePlane180(band_v, w, dest->rotate_v, w, w, rows);
+      MergeUVPlane(dest->rotate_u, w, dest->rotate_v, w,
+                   dest->uv + y_end * dest->uv_stride, dest->uv_stride, w,
+                   rows);
+      break;
+    case kRotate270:
+      RotatePlane270(band_u, w, dest->rotate_u, rows, w, rows);
+      RotatePlane270(band_v, w, dest->rotate_v, rows, w, rows);
+      MergeUVPlane(dest->rotate_u, rows, dest->rotate_v, rows,
+                   dest->uv + y * 2, dest->uv_stride, rows, w);
+      break;
+  }
+}
+
+static void JpegScaleToNV12(void* opaque,
+                            const uint8_t* const* data,
+                            const int* strides,
+                            int rows) {
+  NV12ScaleBuffers* dest = (NV12ScaleBuffers*)(opaque);
+  int i;
+  int n;
+  if (dest->error) {
+    return;
+  }
+  for (i = 0; i < dest->num_planes; ++i) {
+    ScaleBandPlane* p = &dest->planes[i];
+    int plane_rows = p->src_height - p->window_end;
+    uint8_t* window;
+    if (plane_rows > p->src_rows) {
+      plane_rows = p->src_rows;
+    }
+    // Each call is one iMCU row, clipped to the image height, and Y has as
+    // many rows as the image.
+    if (i == 0 && rows != plane_rows) {
+      dest->error = LIBYUV_TRUE;
+      return;
+    }
+    window = ScaleBandAppend(p, plane_rows);
+    if (!window) {
+      dest->error = LIBYUV_TRUE;
+      return;
+    }
+    CopyPlane(data[i], strides[i], window, p->src_width, p->src_width,
+              plane_rows);
+  }
+  while ((n = ScaleBandHeight(&dest->planes[0], kJpegScaleBandRows)) > 0) {
+    JpegScaleRotateY(dest, n);
+  }
+  if (dest->num_planes == 3) {
+    // U and V have the same size, so they are ready in the same bands.
+    while ((n = ScaleBandHeight(&dest->planes[1], kJpegScaleBandRows)) > 0) {
+      JpegScaleRotateUV(dest, n);
+    }
+  }
+}
+
+// Row buffers and plane scalers for MJPGScaleToNV12, which a MJPGDecoder
+// keeps between frames.
+struct JpegScaleBuffer {
+  uint8_t* mem;
+  size_t size;
+  int allocation_count;
+  int num_planes;  // Planes set up by JpegScaleBufferPlane.
+  ScaleBandPlane planes[3];
+};
+
+static void JpegScaleBufferInit(JpegScaleBuffer* scale_buffer) {
+  scale_buffer->mem = NULL;
+  scale_buffer->size = 0;
+  scale_buffer->allocation_count = 0;
+  scale_buffer->num_planes = 0;
+}
+
+static void JpegScaleBufferFree(JpegScaleBuffer* scale_buffer) {
+  int i;
+  for (i = 0; i < scale_buffer->num_planes; ++i) {
+    ScaleBandPlaneFree(&scale_buffer->planes[i]);
+  }
+  free(scale_buffer->mem);
+}
+
+// Returns plane i set up for a frame, reusing the scaler and its polyphase
+// tables from the last frame when the geometry is the same.
+static const ScaleBandPlane* JpegScaleBufferPlane(JpegScaleBuffer* scale_buffer,
+                                                  int i,
+                                                  int src_width,
+                                                  int src_height,
+                                                  int src_rows,
+                                                  int dst_width,
+                                                  int dst_height,
+                                                  enum FilterMode filtering) {
+  ScaleBandPlane* p = &scale_buffer->planes[i];
+  if (i < scale_buffer->num_planes) {
+    if (p->src_width == src_width && p->src_height == src_height &&
+        p->src_rows == src_rows && p->dst_width == dst_width &&
+        p->dst_height == dst_height && p->filtering == filtering) {
+      return p;
+    }
+    ScaleBandPlaneFree(p);
+  }
+  ScaleBandPlaneInit(p, src_width, src_height, src_rows, dst_width, dst_height,
+                     1, filtering, NULL);
+  if (p->scaler.polyphase.tables_mem) {
+    ++scale_buffer->allocation_count;
+  }
+  if (scale_buffer->num_planes <= i) {
+    scale_buffer->num_planes = i + 1;
+  }
+  return p;
+}
+
+// Returns the buffer aligned to 64 bytes, growing it if needed.
+static uint8_t* JpegScaleBufferAlloc(JpegScaleBuffer* scale_buffer,
+                                     size_t size) {
+  if (scale_buffer->size < size + 63) {
+    free(scale_buffer->mem);
+    scale_buffer->mem = (uint8_t*)malloc(size + 63);
+    scale_buffer->size = scale_buffer->mem ? size + 63 : 0;
+    if (!scale_buffer->mem) {
+      return NULL;
+    }
+    ++scale_buffer->allocation_count;
+  }
+  return (uint8_t*)(((intptr_t)(scale_buffer->mem) + 63) & ~63);
+}
+
+// MJPG (Motion JPEG) to NV12, scaled and rotated.
+static int DecodeMJPGScaleToNV12(MJpegDecoder* mjpeg_decoder,
+                                 JpegScaleBuffer* scale_buffer,
+                                 const uint8_t* sample,
+                                 size_t sample_size,
+                                 uint8_t* dst_y,
+                                 int dst_stride_y,
+                                 uint8_t* dst_uv,
+                                 int dst_stride_uv,
+                                 int src_width,
+                                 int src_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 enum FilterMode filtering,
+                                 enum RotationMode rotation) {
+  // Size before rotation.
+  int width = dst_width;
+  int height = dst_height;
+  int halfwidth;
+  int halfheight;
+  int scale_denom = 8;
+  int num_planes;
+  int scratch_size;
+  size_t buffer_size = 0;
+  int i;
+  if (!sample || !dst_y || !dst_uv || dst_width <= 0 || dst_height <= 0 ||
+      (rotation != kRotate0 && rotation != kRotate90 &&
+       rotation != kRotate180 && rotation != kRotate270)) {
+    return -1;
+  }
+  if (sample_size == kUnknownDataSize) {
+    // ERROR: MJPEG frame size unknown
+    return -1;
+  }
+  if (rotation == kRotate90 || rotation == kRotate270) {
+    width = dst_height;
+    height = dst_width;
+  }
+  halfwidth = (width + 1) >> 1;
+  halfheight = (height + 1) >> 1;
+
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(sample, sample_size);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
+    // ERROR: MJPEG frame has unexpected dimensions
+    mjpeg_decoder->UnloadFrame();
+    return 1;  // runtime failure
+  }
+  if (!ret) {
+    return 1;
+  }
+  if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+      mjpeg_decoder->GetNumComponents() == 3) {
+    num_planes = 3;
+  } else if (mjpeg_decoder->GetColorSpace() ==
+                 MJpegDecoder::kColorSpaceGrayscale &&
+             mjpeg_decoder->GetNumComponents() == 1) {
+    num_planes = 1;
+  } else {
+    // Unknown colorspace.
+    mjpeg_decoder->UnloadFrame();
+    return 1;
+  }
+
+  // Use the largest DCT scale that does not scale below the destination.
+  while (scale_denom > 1 &&
+         ((src_width + scale_denom - 1) / scale_denom < width ||
+          (src_height + scale_denom - 1) / scale_denom < height)) {
+    scale_denom >>= 1;
+  }
+  if (!mjpeg_decoder->SetScaleDenom(scale_denom) ||
+      (num_planes == 3 &&
+       (mjpeg_decoder->GetComponentWidth(1) !=
+            mjpeg_decoder->GetComponentWidth(2) ||
+        mjpeg_decoder->GetComponentHeight(1) !=
+            mjpeg_decoder->GetComponentHeight(2)))) {
+    mjpeg_decoder->UnloadFrame();
+    return 1;
+  }
+  // The windows are sized from the iMCU rows of each plane, so check that the
+  // planes are ones they can hold: Y the size of the image, and U and V no
+  // larger than Y.
+  for (i = 0; i < num_planes; ++i) {
+    int plane_width = mjpeg_decoder->GetComponentWidth(i);
+    int plane_height = mjpeg_decoder->GetComponentHeight(i);
+    if (plane_width <= 0 || plane_height <= 0 ||
+        plane_width > mjpeg_decoder->GetScaledWidth() ||
+        plane_height > mjpeg_decoder->GetScaledHeight() ||
+        (i == 0 && (plane_width != mjpeg_decoder->GetScaledWidth() ||
+                    plane_height != mjpeg_decoder->GetScaledHeight())) ||
+        mjpeg_decoder->GetComponentScanlinesPerImcuRow(i) <= 0 ||
+        mjpeg_decoder->GetComponentScanlinesPerImcuRow(i) >
+            mjpeg_decoder->GetComponentScanlinesPerImcuRow(0)) {
+      mjpeg_decoder->UnloadFrame();
+      return -1;
+    }
+  }
+
+  NV12ScaleBuffers bufs;
+  LibyuvScratch scratch;
+  bufs.num_planes = num_planes;
+  bufs.y = dst_y;
+  bufs.y_stride = dst_stride_y;
+  bufs.uv = dst_uv;
+  bufs.uv_stride = dst_stride_uv;
+  bufs.rotation = rotation;
+  bufs.error = LIBYUV_FALSE;
+  scratch_size = 0;
+  for (i = 0; i < num_planes; ++i) {
+    ScaleBandPlane* p = &bufs.planes[i];
+    int plane_scratch_size;
+    *p = *JpegScaleBufferPlane(
+        scale_buffer, i, mjpeg_decoder->GetComponentWidth(i),
+        mjpeg_decoder->GetComponentHeight(i),
+        mjpeg_decoder->GetComponentScanlinesPerImcuRow(i),
+        i ? halfwidth : width, i ? halfheight : height, filtering);
+    p->scratch = &scratch;
+    plane_scratch_size = ScalePlaneScratchSize(
+        p->src_width, p->src_height, p->dst_width, p->dst_height, filtering);
+    if (plane_scratch_size > scratch_size) {
+      scratch_size = plane_scratch_size;
+    }
+    buffer_size += (size_t)p->ring_size +
+                   (size_t)p->src_width * p->window_rows +
+                   (size_t)p->dst_width * kJpegScaleBandRows;
+  }
+  buffer_size += (size_t)halfwidth * kJpegScaleBandRows * 2 + scratch_size;
+
+  uint8_t* buffer = JpegScaleBufferAlloc(scale_buffer, buffer_size);
+  if (!buffer) {
+    mjpeg_decoder->UnloadFrame();
+    return 1;
+  }
+  {
+    uint8_t* ptr = buffer;
+    // The rings come first, as they are multiples of 64 bytes.
+    for (i = 0; i < num_planes; ++i) {
+      ScaleBandPlaneRing(&bufs.planes[i], ptr);
+      ptr += bufs.planes[i].ring_size;
+    }
+    for (i = 0; i < num_planes; ++i) {
+      ScaleBandPlane* p = &bufs.planes[i];
+      p->window = ptr;
+      ptr += p->src_width * p->window_rows;
+      bufs.bands[i] = ptr;
+      ptr += p->dst_width * kJpegScaleBandRows;
+    }
+    bufs.rotate_u = ptr;
+    ptr += halfwidth * kJpegScaleBandRows;
+    bufs.rotate_v = ptr;
+    ptr += halfwidth * kJpegScaleBandRows;
+    scratch.buffer = ptr;
+    scratch.size = scratch_size;
+  }
+  if (num_planes == 1) {
+    // No chroma, so fill UV with neutral grey.
+    SetPlane(dst_uv, dst_stride_uv, ((dst_width + 1) >> 1) * 2,
+             (dst_height + 1) >> 1, 128);
+  }
+  ret = mjpeg_decoder->DecodeToCallback(&JpegScaleToNV12, &bufs,
+                                        mjpeg_decoder->GetScaledWidth(),
+                                        mjpeg_decoder->GetScaledHeight());
+  if (bufs.error) {
+    return -1;
+  }
+  return ret ? 0 : 1;
+}
+
+LIBYUV_API
+int MJPGScaleToNV12(const uint8_t* sample,
+                    size_t sample_size,
+                    uint8_t* dst_y,
+                    int dst_stride_y,
+                    uint8_t* dst_uv,
+                    int dst_stride_uv,
+                    int src_width,
+                    int src_height,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering,
+                    enum RotationMode rotation) {
+  JpegScaleBuffer scale_buffer;
+  MJpegDecoder mjpeg_decoder;
+  int ret;
+  JpegScaleBufferInit(&scale_buffer);
+  ret = DecodeMJPGScaleToNV12(&mjpeg_decoder, &scale_buffer, sample,
+                              sample_size, dst_y, dst_stride_y, dst_uv,
+                              dst_stride_uv, src_width, src_height, dst_width,
+                              dst_height, filtering, rotation);
+  JpegScaleBufferFree(&scale_buffer);
+  return ret;
+}
+
 struct ARGBBuffers {
   uint8_t* argb;
   int argb_stride;
@@ -515,85 +952,213 @@ static void JpegI400ToARGB(void* opaque,
 // MJPG (Motion JPeg) to ARGB
 // TODO(fbarchard): review src_width and src_height requirement. dst_width and
 // dst_height may be enough.
-LIBYUV_API
-int MJPGToARGB(const uint8_t* src_mjpg,
-               size_t src_size_mjpg,
-               uint8_t* dst_argb,
-               int dst_stride_argb,
-               int src_width,
-               int src_height,
-               int dst_width,
-               int dst_height) {
+static int DecodeMJPGToARGB(MJpegDecoder* mjpeg_decoder,
+                            const uint8_t* src_mjpg,
+                            size_t src_size_mjpg,
+                            uint8_t* dst_argb,
+                            int dst_stride_argb,
+                            int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height) {
   if (src_size_mjpg == kUnknownDataSize) {
     // ERROR: MJPEG frame size unknown
     return -1;
   }
 
-  // TODO(fbarchard): Port MJpeg to C.
-  MJpegDecoder mjpeg_decoder;
-  LIBYUV_BOOL ret = mjpeg_decoder.LoadFrame(src_mjpg, src_size_mjpg);
-  if (ret && (mjpeg_decoder.GetWidth() != src_width ||
-              mjpeg_decoder.GetHeight() != src_height)) {
+  LIBYUV_BOOL ret = mjpeg_decoder->LoadFrame(src_mjpg, src_size_mjpg);
+  if (ret && (mjpeg_decoder->GetWidth() != src_width ||
+              mjpeg_decoder->GetHeight() != src_height)) {
     // ERROR: MJPEG frame has unexpected dimensions
-    mjpeg_decoder.UnloadFrame();
+    mjpeg_decoder->UnloadFrame();
     return 1;  // runtime failure
   }
   if (ret) {
     ARGBBuffers bufs = {dst_argb, dst_stride_argb, dst_width, dst_height};
     // YUV420
-    if (mjpeg_decoder.GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
-        mjpeg_decoder.GetNumComponents() == 3 &&
-        mjpeg_decoder.GetVertSampFactor(0) == 2 &&
-        mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-        mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-        mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-        mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI420ToARGB, &bufs, dst_width,
-                                           dst_height);
+    if (mjpeg_decoder->GetColorSpace() == MJpegDecoder::kColorSpaceYCbCr &&
+        mjpeg_decoder->GetNumComponents() == 3 &&
+        mjpeg_decoder->GetVertSampFactor(0) == 2 &&
+        mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+        mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+        mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+        mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI420ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV422
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 2 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI422ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 2 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI422ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV444
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceYCbCr &&
-               mjpeg_decoder.GetNumComponents() == 3 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(1) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(1) == 1 &&
-               mjpeg_decoder.GetVertSampFactor(2) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(2) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI444ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 3 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(1) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(1) == 1 &&
+               mjpeg_decoder->GetVertSampFactor(2) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(2) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI444ToARGB, &bufs, dst_width,
+                                            dst_height);
       // YUV400
-    } else if (mjpeg_decoder.GetColorSpace() ==
+    } else if (mjpeg_decoder->GetColorSpace() ==
                    MJpegDecoder::kColorSpaceGrayscale &&
-               mjpeg_decoder.GetNumComponents() == 1 &&
-               mjpeg_decoder.GetVertSampFactor(0) == 1 &&
-               mjpeg_decoder.GetHorizSampFactor(0) == 1) {
-      ret = mjpeg_decoder.DecodeToCallback(&JpegI400ToARGB, &bufs, dst_width,
-                                           dst_height);
+               mjpeg_decoder->GetNumComponents() == 1 &&
+               mjpeg_decoder->GetVertSampFactor(0) == 1 &&
+               mjpeg_decoder->GetHorizSampFactor(0) == 1) {
+      ret = mjpeg_decoder->DecodeToCallback(&JpegI400ToARGB, &bufs, dst_width,
+                                            dst_height);
     } else {
       // TODO(fbarchard): Implement conversion for any other
       // colorspace/subsample factors that occur in practice. ERROR: Unable to
       // convert MJPEG frame because format is not supported
-      mjpeg_decoder.UnloadFrame();
+      mjpeg_decoder->UnloadFrame();
       return 1;
     }
   }
   return ret ? 0 : 1;
 }
 
+LIBYUV_API
+int MJPGToARGB(const uint8_t* src_mjpg,
+               size_t src_size_mjpg,
+               uint8_t* dst_argb,
+               int dst_stride_argb,
+               int src_width,
+               int src_height,
+               int dst_width,
+               int dst_height) {
+  MJpegDecoder mjpeg_decoder;
+  return DecodeMJPGToARGB(&mjpeg_decoder, src_mjpg, src_size_mjpg, dst_argb,
+                          dst_stride_argb, src_width, src_height, dst_width,
+                          dst_height);
+}
+
+struct MJPGDecoder {
+  MJpegDecoder mjpeg_decoder;
+  JpegScaleBuffer scale_buffer;
+};
+
+LIBYUV_API
+MJPGDecoder* MJPGDecoderCreate(void) {
+  MJPGDecoder* decoder = new MJPGDecoder;
+  JpegScaleBufferInit(&decoder->scale_buffer);
+  return decoder;
+}
+
+LIBYUV_API
+void MJPGDecoderFree(MJPGDecoder* decoder) {
+  if (decoder) {
+    JpegScaleBufferFree(&decoder->scale_buffer);
+    delete decoder;
+  }
+}
+
+LIBYUV_API
+int MJPGDecoderAllocationCount(MJPGDecoder* decoder) {
+  return decoder->mjpeg_decoder.GetAllocationCount() +
+         decoder->scale_buffer.allocation_count;
+}
+
+LIBYUV_API
+int MJPGDecoderToI420(MJPGDecoder* decoder,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  return DecodeMJPGToI420(&decoder->mjpeg_decoder, src_mjpg, src_size_mjpg,
+                          dst_y, dst_stride_y, dst_u, dst_stride_u, dst_v,
+                          dst_stride_v, src_width, src_height, dst_width,
+                          dst_height);
+}
+
+LIBYUV_API
+int MJPGDecoderToNV21(MJPGDecoder* decoder,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_vu,
+                      int dst_stride_vu,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  return DecodeMJPGToNV21(&decoder->mjpeg_decoder, src_mjpg, src_size_mjpg,
+                          dst_y, dst_stride_y, dst_vu, dst_stride_vu, src_width,
+                          src_height, dst_width, dst_height);
+}
+
+LIBYUV_API
+int MJPGDecoderToNV12(MJPGDecoder* decoder,
+                      const uint8_t* sample,
+                      size_t sample_size,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_uv,
+                      int dst_stride_uv,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  return DecodeMJPGToNV12(&decoder->mjpeg_decoder, sample, sample_size, dst_y,
+                          dst_stride_y, dst_uv, dst_stride_uv, src_width,
+                          src_height, dst_width, dst_height);
+}
+
+LIBYUV_API
+int MJPGDecoderScaleToNV12(MJPGDecoder* decoder,
+                           const uint8_t* sample,
+                           size_t sample_size,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           enum RotationMode rotation) {
+  return DecodeMJPGScaleToNV12(&decoder->mjpeg_decoder, &decoder->scale_buffer,
+                               sample, sample_size, dst_y, dst_stride_y, dst_uv,
+                               dst_stride_uv, src_width, src_height, dst_width,
+                               dst_height, filtering, rotation);
+}
+
+LIBYUV_API
+int MJPGDecoderToARGB(MJPGDecoder* decoder,
+                      const uint8_t* src_mjpg,
+                      size_t src_size_mjpg,
+                      uint8_t* dst_argb,
+                      int dst_stride_argb,
+                      int src_width,
+                      int src_height,
+                      int dst_width,
+                      int dst_height) {
+  return DecodeMJPGToARGB(&decoder->mjpeg_decoder, src_mjpg, src_size_mjpg,
+                          dst_argb, dst_stride_argb, src_width, src_height,
+                          dst_width, dst_height);
+}
+
 #endif  // HAVE_JPEG
 
 #ifdef __cplusplus
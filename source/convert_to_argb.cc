@@ -15,6 +15,7 @@
 #include "libyuv/mjpeg_decoder.h"
 #endif
 #include "libyuv/rotate_argb.h"
+#include "libyuv/rotate_row.h"
 #include "libyuv/row.h"
 #include "libyuv/video_common.h"
 
@@ -23,6 +24,76 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// A camera sample converted to ARGB and rotated by RotateStrips.
+typedef struct {
+  const uint8_t* sample;
+  size_t sample_size;
+  uint8_t* dst_argb;
+  int dst_stride_argb;
+  int crop_x;
+  int src_width;
+  int src_height;
+  int crop_width;
+  enum RotationMode rotation;
+  uint32_t fourcc;
+} ConvertToARGBStrip;
+
+// Convert a strip to a small ARGB buffer and rotate it into its place.
+static int ConvertToARGBStripRotate(void* opaque,
+                                    uint8_t* strip,
+                                    int strip_rows,
+                                    int strip_crop_y,
+                                    int rows,
+                                    int dst_offset) {
+  const ConvertToARGBStrip* s = (const ConvertToARGBStrip*)opaque;
+  uint8_t* rotate_argb = (s->rotation == kRotate180)
+                             ? s->dst_argb + dst_offset * s->dst_stride_argb
+                             : s->dst_argb + dst_offset * 4;
+  int r;
+  (void)strip_rows;
+  r = ConvertToARGB(s->sample, s->sample_size, strip, s->crop_width * 4,
+                    s->crop_x, strip_crop_y, s->src_width, s->src_height,
+                    s->crop_width, rows, kRotate0, s->fourcc);
+  if (!r) {
+    r = ARGBRotate(strip, s->crop_width * 4, rotate_argb, s->dst_stride_argb,
+                   s->crop_width, rows, s->rotation);
+  }
+  return r;
+}
+
+// Convert and rotate a camera sample a strip of rows at a time.  Each strip
+// is converted to a small ARGB buffer and rotated into its place in the
+// destination while still in cache, instead of converting the whole frame to
+// a temporary frame and then rotating that.
+// Strips start on even rows, so 4:2:0 chroma rows pair up as they would for
+// the whole frame; crop_height must be even when inverting.
+static int ConvertToARGBStrips(const uint8_t* sample,
+                               size_t sample_size,
+                               uint8_t* dst_argb,
+                               int dst_stride_argb,
+                               int crop_x,
+                               int crop_y,
+                               int src_width,
+                               int src_height,
+                               int crop_width,
+                               int crop_height,
+                               enum RotationMode rotation,
+                               uint32_t fourcc) {
+  ConvertToARGBStrip strip;
+  strip.sample = sample;
+  strip.sample_size = sample_size;
+  strip.dst_argb = dst_argb;
+  strip.dst_stride_argb = dst_stride_argb;
+  strip.crop_x = crop_x;
+  strip.src_width = src_width;
+  strip.src_height = src_height;
+  strip.crop_width = crop_width;
+  strip.rotation = rotation;
+  strip.fourcc = fourcc;
+  return RotateStrips(crop_width * 4, crop_y, crop_height, src_height < 0,
+                      rotation, ConvertToARGBStripRotate, &strip);
+}
+
 // Convert camera sample to ARGB with cropping, rotation and vertical flip.
 // src_width is used for source stride computation
 // src_height is used to compute location of planes, and indicate inversion
@@ -54,9 +125,12 @@ int ConvertToARGB(const uint8_t* sample,
   int inv_crop_height = (crop_height < 0) ? -crop_height : crop_height;
   int r = 0;
 
-  // One pass rotation is available for some formats. For the rest, convert
-  // to ARGB (with optional vertical flipping) into a temporary ARGB buffer,
-  // and then rotate the ARGB to the final destination buffer.
+  // One pass rotation is available for some formats. The rest are converted
+  // and rotated a strip of rows at a time, except for MJPEG, which is decoded
+  // a whole frame at a time, and odd inverted crops, whose chroma rows do not
+  // pair up the same way in strips. Those convert to ARGB (with optional
+  // vertical flipping) into a temporary ARGB buffer, and then rotate the ARGB
+  // to the final destination buffer.
   // For in-place conversion, if destination dst_argb is same as source sample,
   // also enable temporary buffer.
   LIBYUV_BOOL need_buf =
@@ -74,6 +148,12 @@ int ConvertToARGB(const uint8_t* sample,
     inv_crop_height = -inv_crop_height;
   }
 
+  if (need_buf && dst_argb != sample && format != FOURCC_MJPG &&
+      (src_height > 0 || !(abs_crop_height & 1))) {
+    return ConvertToARGBStrips(sample, sample_size, dst_argb, dst_stride_argb,
+                               crop_x, crop_y, src_width, src_height,
+                               crop_width, abs_crop_height, rotation, fourcc);
+  }
   if (need_buf) {
     int argb_size = crop_width * 4 * abs_crop_height;
     rotate_buffer = (uint8_t*)malloc(argb_size); /* NOLINT */
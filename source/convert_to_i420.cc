@@ -12,6 +12,7 @@
 
 #include "libyuv/convert.h"
 
+#include "libyuv/rotate_row.h"
 #include "libyuv/video_common.h"
 
 #ifdef __cplusplus
@@ -19,6 +20,104 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// A camera sample converted to I420 and rotated by RotateStrips.
+typedef struct {
+  const uint8_t* sample;
+  size_t sample_size;
+  uint8_t* dst_y;
+  int dst_stride_y;
+  uint8_t* dst_u;
+  int dst_stride_u;
+  uint8_t* dst_v;
+  int dst_stride_v;
+  int crop_x;
+  int src_width;
+  int src_height;
+  int crop_width;
+  enum RotationMode rotation;
+  uint32_t fourcc;
+} ConvertToI420Strip;
+
+// Convert a strip to a small I420 buffer and rotate it into its place.
+static int ConvertToI420StripRotate(void* opaque,
+                                    uint8_t* strip,
+                                    int strip_rows,
+                                    int strip_crop_y,
+                                    int rows,
+                                    int dst_offset) {
+  const ConvertToI420Strip* s = (const ConvertToI420Strip*)opaque;
+  const int halfwidth = (s->crop_width + 1) / 2;
+  const int y_size = s->crop_width * strip_rows;
+  const int uv_size = halfwidth * (strip_rows / 2);
+  uint8_t* rotate_y;
+  uint8_t* rotate_u;
+  uint8_t* rotate_v;
+  int r;
+  if (s->rotation == kRotate180) {
+    rotate_y = s->dst_y + dst_offset * s->dst_stride_y;
+    rotate_u = s->dst_u + (dst_offset / 2) * s->dst_stride_u;
+    rotate_v = s->dst_v + (dst_offset / 2) * s->dst_stride_v;
+  } else {
+    rotate_y = s->dst_y + dst_offset;
+    rotate_u = s->dst_u + dst_offset / 2;
+    rotate_v = s->dst_v + dst_offset / 2;
+  }
+  r = ConvertToI420(s->sample, s->sample_size, strip, s->crop_width,
+                    strip + y_size, halfwidth, strip + y_size + uv_size,
+                    halfwidth, s->crop_x, strip_crop_y, s->src_width,
+                    s->src_height, s->crop_width, rows, kRotate0, s->fourcc);
+  if (!r) {
+    r = I420Rotate(strip, s->crop_width, strip + y_size, halfwidth,
+                   strip + y_size + uv_size, halfwidth, rotate_y,
+                   s->dst_stride_y, rotate_u, s->dst_stride_u, rotate_v,
+                   s->dst_stride_v, s->crop_width, rows, s->rotation);
+  }
+  return r;
+}
+
+// Convert and rotate a camera sample a strip of rows at a time.  Each strip
+// is converted to a small I420 buffer and rotated into its place in the
+// destination while still in cache, instead of converting the whole frame to
+// a temporary frame and then rotating that.
+// Strips have an even number of rows, so chroma rows pair up as they would
+// for the whole frame; crop_height must be even.
+static int ConvertToI420Strips(const uint8_t* sample,
+                               size_t sample_size,
+                               uint8_t* dst_y,
+                               int dst_stride_y,
+                               uint8_t* dst_u,
+                               int dst_stride_u,
+                               uint8_t* dst_v,
+                               int dst_stride_v,
+                               int crop_x,
+                               int crop_y,
+                               int src_width,
+                               int src_height,
+                               int crop_width,
+                               int crop_height,
+                               enum RotationMode rotation,
+                               uint32_t fourcc) {
+  ConvertToI420Strip strip;
+  strip.sample = sample;
+  strip.sample_size = sample_size;
+  strip.dst_y = dst_y;
+  strip.dst_stride_y = dst_stride_y;
+  strip.dst_u = dst_u;
+  strip.dst_stride_u = dst_stride_u;
+  strip.dst_v = dst_v;
+  strip.dst_stride_v = dst_stride_v;
+  strip.crop_x = crop_x;
+  strip.src_width = src_width;
+  strip.src_height = src_height;
+  strip.crop_width = crop_width;
+  strip.rotation = rotation;
+  strip.fourcc = fourcc;
+  // A row of Y and half a row each of U and V.
+  return RotateStrips(crop_width + (crop_width + 1) / 2, crop_y, crop_height,
+                      src_height < 0, rotation, ConvertToI420StripRotate,
+                      &strip);
+}
+
 // Convert camera sample to I420 with cropping, rotation and vertical flip.
 // src_width is used for source stride computation
 // src_height is used to compute location of planes, and indicate inversion
@@ -69,10 +168,20 @@ int ConvertToI420(const uint8_t* sample,
   }
 
   // One pass rotation is available for some formats. For the rest, convert
-  // to I420 (with optional vertical flipping) into a temporary I420 buffer,
-  // and then rotate the I420 to the final destination buffer.
+  // and rotate a strip of rows at a time, except for MJPEG, which is decoded
+  // a whole frame at a time, and odd crop heights, whose chroma rows are
+  // subsampled differently in strips. Those convert to I420 (with optional
+  // vertical flipping) into a temporary I420 buffer, and then rotate the I420
+  // to the final destination buffer.
   // For in-place conversion, if destination dst_y is same as source sample,
   // also enable temporary buffer.
+  if (need_buf && dst_y != sample && format != FOURCC_MJPG &&
+      !(abs_crop_height & 1)) {
+    return ConvertToI420Strips(sample, sample_size, dst_y, dst_stride_y, dst_u,
+                               dst_stride_u, dst_v, dst_stride_v, crop_x,
+                               crop_y, src_width, src_height, crop_width,
+                               abs_crop_height, rotation, fourcc);
+  }
   if (need_buf) {
     int y_size = crop_width * abs_crop_height;
     int uv_size = ((crop_width + 1) / 2) * ((abs_crop_height + 1) / 2);
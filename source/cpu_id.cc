@@ -274,6 +274,48 @@ int InitCpuFlags(void) {
   return MaskCpuFlags(-1);
 }
 
+// Deterministic cache parameters are reported by leaf 4 on Intel and leaf
+// 0x8000001D on AMD. Each subleaf describes one cache; type 0 ends the list.
+static int GetCacheSizeFromLeaf(int leaf, int level) {
+  int i;
+  for (i = 0; i < 16; ++i) {
+    int cpu_info[4] = {0, 0, 0, 0};
+    int type;
+    CpuId(leaf, i, cpu_info);
+    type = cpu_info[0] & 31;
+    if (type == 0) {
+      break;
+    }
+    // Skip instruction caches (type 2).
+    if (type != 2 && ((cpu_info[0] >> 5) & 7) == level) {
+      int ways = ((cpu_info[1] >> 22) & 0x3ff) + 1;
+      int partitions = ((cpu_info[1] >> 12) & 0x3ff) + 1;
+      int line_size = (cpu_info[1] & 0xfff) + 1;
+      int sets = cpu_info[2] + 1;
+      return ways * partitions * line_size * sets;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int GetCpuCacheSize(int level) {
+  int cpu_info0[4] = {0, 0, 0, 0};
+  int cache_size = 0;
+  CpuId(0, 0, cpu_info0);
+  if (cpu_info0[0] >= 4) {
+    cache_size = GetCacheSizeFromLeaf(4, level);
+  }
+  if (!cache_size) {
+    int cpu_info80[4] = {0, 0, 0, 0};
+    CpuId((int)0x80000000, 0, cpu_info80);
+    if ((unsigned int)cpu_info80[0] >= 0x8000001Du) {
+      cache_size = GetCacheSizeFromLeaf((int)0x8000001D, level);
+    }
+  }
+  return cache_size;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -12,6 +12,7 @@
 
 #ifdef HAVE_JPEG
 #include <assert.h>
+#include <stdlib.h>  // For malloc.
 
 #if !defined(__pnacl__) && !defined(__CLR_VER) && \
     !defined(COVERAGE_ENABLED) && !defined(TARGET_IPHONE_SIMULATOR)
@@ -41,6 +42,19 @@ extern "C" {
 
 #include "libyuv/planar_functions.h"  // For CopyPlane().
 
+// Field names for the DCT scaled sizes changed in libjpeg 7.
+#if JPEG_LIB_VERSION >= 70
+#define MIN_DCT_H_SCALED_SIZE min_DCT_h_scaled_size
+#define MIN_DCT_V_SCALED_SIZE min_DCT_v_scaled_size
+#define DCT_H_SCALED_SIZE DCT_h_scaled_size
+#define DCT_V_SCALED_SIZE DCT_v_scaled_size
+#else
+#define MIN_DCT_H_SCALED_SIZE min_DCT_scaled_size
+#define MIN_DCT_V_SCALED_SIZE min_DCT_scaled_size
+#define DCT_H_SCALED_SIZE DCT_scaled_size
+#define DCT_V_SCALED_SIZE DCT_scaled_size
+#endif
+
 namespace libyuv {
 
 #ifdef HAVE_SETJMP
@@ -50,6 +64,192 @@ struct SetJmpErrorMgr {
 };
 #endif
 
+// jpeglib allocates its decoder modules and their buffers for each image from
+// the image pool, which jpeg_abort() frees again.  To keep that memory between
+// frames, the image pool allocators are replaced with ones that take memory
+// from chunks owned by the decoder.  When the image pool is freed, the chunks
+// are merged into one that holds everything the image used, so following
+// frames of the same format are decoded without calling malloc.  Permanent
+// pool requests, and the virtual arrays of buffered image mode, still use the
+// jpeglib memory manager.
+struct JpegPoolChunk {
+  JpegPoolChunk* next;
+  size_t size;
+  size_t used;
+};
+
+struct JpegImagePool {
+  jpeg_decompress_struct cinfo;  // Must be at the top
+  JpegPoolChunk* chunks;         // Allocations are made from the first chunk.
+  int allocation_count;
+  // The jpeglib memory manager methods that are replaced.
+  void* (*alloc_small)(j_common_ptr cinfo, int pool_id, size_t size);
+  void* (*alloc_large)(j_common_ptr cinfo, int pool_id, size_t size);
+  JSAMPARRAY (*alloc_sarray)(j_common_ptr cinfo,
+                             int pool_id,
+                             JDIMENSION samplesperrow,
+                             JDIMENSION numrows);
+  JBLOCKARRAY (*alloc_barray)(j_common_ptr cinfo,
+                              int pool_id,
+                              JDIMENSION blocksperrow,
+                              JDIMENSION numrows);
+  void (*free_pool)(j_common_ptr cinfo, int pool_id);
+};
+
+static const size_t kJpegPoolAlign = 64;
+static const size_t kJpegPoolMinChunkSize = 16384;
+
+static size_t JpegPoolRound(size_t size) {
+  return (size + kJpegPoolAlign - 1) & ~(kJpegPoolAlign - 1);
+}
+
+static uint8_t* JpegPoolChunkData(JpegPoolChunk* chunk) {
+  return reinterpret_cast<uint8_t*>(
+      (reinterpret_cast<uintptr_t>(chunk + 1) + kJpegPoolAlign - 1) &
+      ~(kJpegPoolAlign - 1));
+}
+
+static JpegPoolChunk* JpegPoolNewChunk(JpegImagePool* pool, size_t size) {
+  JpegPoolChunk* chunk = static_cast<JpegPoolChunk*>(
+      malloc(sizeof(JpegPoolChunk) + size + kJpegPoolAlign - 1));
+  if (chunk) {
+    ++pool->allocation_count;
+    chunk->next = pool->chunks;
+    chunk->size = size;
+    chunk->used = 0;
+    pool->chunks = chunk;
+  }
+  return chunk;
+}
+
+// Returns NULL on allocation failure, for the caller to fall back to jpeglib.
+static void* JpegPoolAlloc(JpegImagePool* pool, size_t size) {
+  size = JpegPoolRound(size);
+  JpegPoolChunk* chunk = pool->chunks;
+  if (!chunk || chunk->size - chunk->used < size) {
+    chunk = JpegPoolNewChunk(
+        pool, size > kJpegPoolMinChunkSize ? size : kJpegPoolMinChunkSize);
+    if (!chunk) {
+      return NULL;
+    }
+  }
+  void* ptr = JpegPoolChunkData(chunk) + chunk->used;
+  chunk->used += size;
+  return ptr;
+}
+
+// Frees the image pool allocations, keeping one chunk large enough for them.
+static void JpegPoolReset(JpegImagePool* pool) {
+  JpegPoolChunk* chunk = pool->chunks;
+  if (chunk && chunk->next) {
+    size_t total_size = 0;
+    while (chunk) {
+      JpegPoolChunk* next = chunk->next;
+      total_size += chunk->used;
+      free(chunk);
+      chunk = next;
+    }
+    pool->chunks = NULL;
+    JpegPoolNewChunk(pool, total_size);
+  }
+  if (pool->chunks) {
+    pool->chunks->used = 0;
+  }
+}
+
+static void JpegPoolDestroy(JpegImagePool* pool) {
+  JpegPoolChunk* chunk = pool->chunks;
+  while (chunk) {
+    JpegPoolChunk* next = chunk->next;
+    free(chunk);
+    chunk = next;
+  }
+  pool->chunks = NULL;
+}
+
+static void* JpegPoolAllocSmall(j_common_ptr cinfo,
+                                int pool_id,
+                                size_t size) {
+  JpegImagePool* pool = reinterpret_cast<JpegImagePool*>(cinfo);
+  void* ptr = NULL;
+  if (pool_id == JPOOL_IMAGE) {
+    ptr = JpegPoolAlloc(pool, size);
+  }
+  if (!ptr) {
+    ++pool->allocation_count;
+    ptr = pool->alloc_small(cinfo, pool_id, size);
+  }
+  return ptr;
+}
+
+static void* JpegPoolAllocLarge(j_common_ptr cinfo,
+                                int pool_id,
+                                size_t size) {
+  JpegImagePool* pool = reinterpret_cast<JpegImagePool*>(cinfo);
+  void* ptr = NULL;
+  if (pool_id == JPOOL_IMAGE) {
+    ptr = JpegPoolAlloc(pool, size);
+  }
+  if (!ptr) {
+    ++pool->allocation_count;
+    ptr = pool->alloc_large(cinfo, pool_id, size);
+  }
+  return ptr;
+}
+
+static JSAMPARRAY JpegPoolAllocSarray(j_common_ptr cinfo,
+                                      int pool_id,
+                                      JDIMENSION samplesperrow,
+                                      JDIMENSION numrows) {
+  JpegImagePool* pool = reinterpret_cast<JpegImagePool*>(cinfo);
+  if (pool_id == JPOOL_IMAGE) {
+    size_t row_size = JpegPoolRound(samplesperrow * sizeof(JSAMPLE));
+    JSAMPARRAY rows = static_cast<JSAMPARRAY>(
+        JpegPoolAlloc(pool, numrows * sizeof(JSAMPROW)));
+    JSAMPLE* data = rows ? static_cast<JSAMPLE*>(
+                               JpegPoolAlloc(pool, numrows * row_size))
+                         : NULL;
+    if (data) {
+      for (JDIMENSION i = 0; i < numrows; ++i) {
+        rows[i] = data + i * row_size;
+      }
+      return rows;
+    }
+  }
+  ++pool->allocation_count;
+  return pool->alloc_sarray(cinfo, pool_id, samplesperrow, numrows);
+}
+
+static JBLOCKARRAY JpegPoolAllocBarray(j_common_ptr cinfo,
+                                       int pool_id,
+                                       JDIMENSION blocksperrow,
+                                       JDIMENSION numrows) {
+  JpegImagePool* pool = reinterpret_cast<JpegImagePool*>(cinfo);
+  if (pool_id == JPOOL_IMAGE) {
+    JBLOCKARRAY rows = static_cast<JBLOCKARRAY>(
+        JpegPoolAlloc(pool, numrows * sizeof(JBLOCKROW)));
+    JBLOCKROW data = rows ? static_cast<JBLOCKROW>(JpegPoolAlloc(
+                                pool, numrows * blocksperrow * sizeof(JBLOCK)))
+                          : NULL;
+    if (data) {
+      for (JDIMENSION i = 0; i < numrows; ++i) {
+        rows[i] = data + i * blocksperrow;
+      }
+      return rows;
+    }
+  }
+  ++pool->allocation_count;
+  return pool->alloc_barray(cinfo, pool_id, blocksperrow, numrows);
+}
+
+static void JpegPoolFree(j_common_ptr cinfo, int pool_id) {
+  JpegImagePool* pool = reinterpret_cast<JpegImagePool*>(cinfo);
+  pool->free_pool(cinfo, pool_id);
+  if (pool_id == JPOOL_IMAGE) {
+    JpegPoolReset(pool);
+  }
+}
+
 const int MJpegDecoder::kColorSpaceUnknown = JCS_UNKNOWN;
 const int MJpegDecoder::kColorSpaceGrayscale = JCS_GRAYSCALE;
 const int MJpegDecoder::kColorSpaceRgb = JCS_RGB;
@@ -71,8 +271,12 @@ MJpegDecoder::MJpegDecoder()
       scanlines_(NULL),
       scanlines_sizes_(NULL),
       databuf_(NULL),
-      databuf_strides_(NULL) {
-  decompress_struct_ = new jpeg_decompress_struct;
+      databuf_strides_(NULL),
+      allocation_count_(0) {
+  image_pool_ = new JpegImagePool;
+  image_pool_->chunks = NULL;
+  image_pool_->allocation_count = 0;
+  decompress_struct_ = &image_pool_->cinfo;
   source_mgr_ = new jpeg_source_mgr;
 #ifdef HAVE_SETJMP
   error_mgr_ = new SetJmpErrorMgr;
@@ -89,13 +293,25 @@ MJpegDecoder::MJpegDecoder()
   source_mgr_->term_source = &term_source;
   jpeg_create_decompress(decompress_struct_);
   decompress_struct_->src = source_mgr_;
+  jpeg_memory_mgr* mem = decompress_struct_->mem;
+  image_pool_->alloc_small = mem->alloc_small;
+  image_pool_->alloc_large = mem->alloc_large;
+  image_pool_->alloc_sarray = mem->alloc_sarray;
+  image_pool_->alloc_barray = mem->alloc_barray;
+  image_pool_->free_pool = mem->free_pool;
+  mem->alloc_small = &JpegPoolAllocSmall;
+  mem->alloc_large = &JpegPoolAllocLarge;
+  mem->alloc_sarray = &JpegPoolAllocSarray;
+  mem->alloc_barray = &JpegPoolAllocBarray;
+  mem->free_pool = &JpegPoolFree;
   buf_vec_.buffers = &buf_;
   buf_vec_.len = 1;
 }
 
 MJpegDecoder::~MJpegDecoder() {
   jpeg_destroy_decompress(decompress_struct_);
-  delete decompress_struct_;
+  JpegPoolDestroy(image_pool_);
+  delete image_pool_;
   delete source_mgr_;
 #ifdef HAVE_SETJMP
   delete error_mgr_;
@@ -119,19 +335,47 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
     return LIBYUV_FALSE;
   }
 #endif
+  // Returns to the start state if the previous frame was not decoded or
+  // unloaded, or its header failed to load.
+  jpeg_abort_decompress(decompress_struct_);
   if (jpeg_read_header(decompress_struct_, TRUE) != JPEG_HEADER_OK) {
     // ERROR: Bad MJPEG header
     return LIBYUV_FALSE;
   }
   AllocOutputBuffers(GetNumComponents());
+  decompress_struct_->scale_num = 1;
+  decompress_struct_->scale_denom = 1;
+  jpeg_calc_output_dimensions(decompress_struct_);
+  return LIBYUV_TRUE;
+}
+
+LIBYUV_BOOL MJpegDecoder::SetScaleDenom(int scale_denom) {
+  if (scale_denom != 1 && scale_denom != 2 && scale_denom != 4 &&
+      scale_denom != 8) {
+    return LIBYUV_FALSE;
+  }
+#ifdef HAVE_SETJMP
+  if (setjmp(error_mgr_->setjmp_buffer)) {
+    return LIBYUV_FALSE;
+  }
+#endif
+  decompress_struct_->scale_num = 1;
+  decompress_struct_->scale_denom = scale_denom;
+  // Computes the scaled image and component sizes.
+  jpeg_calc_output_dimensions(decompress_struct_);
+  return LIBYUV_TRUE;
+}
+
+void MJpegDecoder::AllocScanlineBuffers() {
+  has_scanline_padding_ = LIBYUV_FALSE;
   for (int i = 0; i < num_outbufs_; ++i) {
     int scanlines_size = GetComponentScanlinesPerImcuRow(i);
-    if (scanlines_sizes_[i] != scanlines_size) {
-      if (scanlines_[i]) {
-        delete scanlines_[i];
-      }
+    LIBYUV_BOOL scanlines_changed = scanlines_sizes_[i] != scanlines_size;
+    if (scanlines_changed) {
+      delete[] scanlines_[i];
       scanlines_[i] = new uint8_t*[scanlines_size];
       scanlines_sizes_[i] = scanlines_size;
+      ++allocation_count_;
     }
 
     // We allocate padding for the final scanline to pad it up to DCTSIZE bytes
@@ -142,19 +386,17 @@ LIBYUV_BOOL MJpegDecoder::LoadFrame(const uint8_t* src, size_t src_len) {
     // next scanline.
     int databuf_stride = GetComponentStride(i);
     int databuf_size = scanlines_size * databuf_stride;
-    if (databuf_strides_[i] != databuf_stride) {
-      if (databuf_[i]) {
-        delete databuf_[i];
-      }
+    if (scanlines_changed || databuf_strides_[i] != databuf_stride) {
+      delete[] databuf_[i];
       databuf_[i] = new uint8_t[databuf_size];
       databuf_strides_[i] = databuf_stride;
+      ++allocation_count_;
     }
 
     if (GetComponentStride(i) != GetComponentWidth(i)) {
       has_scanline_padding_ = LIBYUV_TRUE;
     }
   }
-  return LIBYUV_TRUE;
 }
 
 static int DivideAndRoundUp(int numerator, int denominator) {
@@ -175,6 +417,14 @@ int MJpegDecoder::GetHeight() {
   return decompress_struct_->image_height;
 }
 
+int MJpegDecoder::GetScaledWidth() {
+  return decompress_struct_->output_width;
+}
+
+int MJpegDecoder::GetScaledHeight() {
+  return decompress_struct_->output_height;
+}
+
 // Returns format of the last loaded frame. The return value is one of the
 // kColorSpace* constants.
 int MJpegDecoder::GetColorSpace() {
@@ -195,31 +445,40 @@ int MJpegDecoder::GetVertSampFactor(int component) {
   return decompress_struct_->comp_info[component].v_samp_factor;
 }
 
+// Subsampling of the decoded component, which is less than the sample factors
+// imply when libjpeg scales a component less than luma.
 int MJpegDecoder::GetHorizSubSampFactor(int component) {
-  return decompress_struct_->max_h_samp_factor / GetHorizSampFactor(component);
+  jpeg_component_info* comp = &decompress_struct_->comp_info[component];
+  return decompress_struct_->max_h_samp_factor *
+         decompress_struct_->MIN_DCT_H_SCALED_SIZE /
+         (comp->h_samp_factor * comp->DCT_H_SCALED_SIZE);
 }
 
 int MJpegDecoder::GetVertSubSampFactor(int component) {
-  return decompress_struct_->max_v_samp_factor / GetVertSampFactor(component);
+  jpeg_component_info* comp = &decompress_struct_->comp_info[component];
+  return decompress_struct_->max_v_samp_factor *
+         decompress_struct_->MIN_DCT_V_SCALED_SIZE /
+         (comp->v_samp_factor * comp->DCT_V_SCALED_SIZE);
 }
 
+// The component geometry comes from jpeg_calc_output_dimensions(), which
+// accounts for DCT scaling.
 int MJpegDecoder::GetImageScanlinesPerImcuRow() {
-  return decompress_struct_->max_v_samp_factor * DCTSIZE;
+  return decompress_struct_->max_v_samp_factor *
+         decompress_struct_->MIN_DCT_V_SCALED_SIZE;
 }
 
 int MJpegDecoder::GetComponentScanlinesPerImcuRow(int component) {
-  int vs = GetVertSubSampFactor(component);
-  return DivideAndRoundUp(GetImageScanlinesPerImcuRow(), vs);
+  jpeg_component_info* comp = &decompress_struct_->comp_info[component];
+  return comp->v_samp_factor * comp->DCT_V_SCALED_SIZE;
 }
 
 int MJpegDecoder::GetComponentWidth(int component) {
-  int hs = GetHorizSubSampFactor(component);
-  return DivideAndRoundUp(GetWidth(), hs);
+  return decompress_struct_->comp_info[component].downsampled_width;
 }
 
 int MJpegDecoder::GetComponentHeight(int component) {
-  int vs = GetVertSubSampFactor(component);
-  return DivideAndRoundUp(GetHeight(), vs);
+  return decompress_struct_->comp_info[component].downsampled_height;
 }
 
 // Get width in bytes padded out to a multiple of DCTSIZE
@@ -231,6 +490,10 @@ int MJpegDecoder::GetComponentSize(int component) {
   return GetComponentWidth(component) * GetComponentHeight(component);
 }
 
+int MJpegDecoder::GetAllocationCount() {
+  return allocation_count_ + image_pool_->allocation_count;
+}
+
 LIBYUV_BOOL MJpegDecoder::UnloadFrame() {
 #ifdef HAVE_SETJMP
   if (setjmp(error_mgr_->setjmp_buffer)) {
@@ -247,7 +510,7 @@ LIBYUV_BOOL MJpegDecoder::UnloadFrame() {
 LIBYUV_BOOL MJpegDecoder::DecodeToBuffers(uint8_t** planes,
                                           int dst_width,
                                           int dst_height) {
-  if (dst_width != GetWidth() || dst_height > GetHeight()) {
+  if (dst_width != GetScaledWidth() || dst_height > GetScaledHeight()) {
     // ERROR: Bad dimensions
     return LIBYUV_FALSE;
   }
@@ -267,7 +530,7 @@ LIBYUV_BOOL MJpegDecoder::DecodeToBuffers(uint8_t** planes,
   // Compute amount of lines to skip to implement vertical crop.
   // TODO(fbarchard): Ensure skip is a multiple of maximum component
   // subsample. ie 2
-  int skip = (GetHeight() - dst_height) / 2;
+  int skip = (GetScaledHeight() - dst_height) / 2;
   if (skip > 0) {
     // There is no API to skip lines in the output data, so we read them
     // into the temp buffer.
@@ -337,7 +600,7 @@ LIBYUV_BOOL MJpegDecoder::DecodeToCallback(CallbackFunction fn,
                                            void* opaque,
                                            int dst_width,
                                            int dst_height) {
-  if (dst_width != GetWidth() || dst_height > GetHeight()) {
+  if (dst_width != GetScaledWidth() || dst_height > GetScaledHeight()) {
     // ERROR: Bad dimensions
     return LIBYUV_FALSE;
   }
@@ -355,7 +618,7 @@ LIBYUV_BOOL MJpegDecoder::DecodeToCallback(CallbackFunction fn,
   SetScanlinePointers(databuf_);
   int lines_left = dst_height;
   // TODO(fbarchard): Compute amount of lines to skip to implement vertical crop
-  int skip = (GetHeight() - dst_height) / 2;
+  int skip = (GetScaledHeight() - dst_height) / 2;
   if (skip > 0) {
     while (skip >= GetImageScanlinesPerImcuRow()) {
       if (!DecodeImcuRow()) {
@@ -485,6 +748,7 @@ void MJpegDecoder::AllocOutputBuffers(int num_outbufs) {
     scanlines_sizes_ = new int[num_outbufs];
     databuf_ = new uint8_t*[num_outbufs];
     databuf_strides_ = new int[num_outbufs];
+    allocation_count_ += 4;
 
     for (int i = 0; i < num_outbufs; ++i) {
       scanlines_[i] = NULL;
@@ -529,6 +793,9 @@ LIBYUV_BOOL MJpegDecoder::StartDecode() {
     // ERROR: Couldn't start JPEG decompressor";
     return LIBYUV_FALSE;
   }
+  // Allocated here rather than in LoadFrame() and SetScaleDenom(), so that
+  // frames decoded at a scale reuse the buffers of the previous frame.
+  AllocScanlineBuffers();
   return LIBYUV_TRUE;
 }
 
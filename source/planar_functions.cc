@@ -476,6 +476,115 @@ void SplitUVPlane(const uint8_t* src_uv,
   }
 }
 
+LIBYUV_API
+int DetilePlane(const uint8_t* src_y,
+                int src_stride_y,
+                uint8_t* dst_y,
+                int dst_stride_y,
+                int width,
+                int height,
+                int tile_height) {
+  const ptrdiff_t src_tile_stride = 16 * tile_height;
+  int y;
+  void (*DetileRow)(const uint8_t* src, ptrdiff_t src_tile_stride,
+                    uint8_t* dst, int width) = DetileRow_C;
+  if (!src_y || !dst_y || width <= 0 || height == 0 || tile_height <= 0 ||
+      (tile_height & (tile_height - 1)) || src_stride_y < width) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_y = dst_y + (height - 1) * dst_stride_y;
+    dst_stride_y = -dst_stride_y;
+  }
+#if defined(HAS_DETILEROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    DetileRow = DetileRow_Any_SSE2;
+    if (IS_ALIGNED(width, 16)) {
+      DetileRow = DetileRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_DETILEROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    DetileRow = DetileRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      DetileRow = DetileRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    DetileRow(src_y, src_tile_stride, dst_y, width);
+    dst_y += dst_stride_y;
+    src_y += 16;
+    // Advance to next row of tiles.
+    if ((y & (tile_height - 1)) == (tile_height - 1)) {
+      src_y = src_y - src_tile_stride + src_stride_y * tile_height;
+    }
+  }
+  return 0;
+}
+
+LIBYUV_API
+int DetileSplitUVPlane(const uint8_t* src_uv,
+                       int src_stride_uv,
+                       uint8_t* dst_u,
+                       int dst_stride_u,
+                       uint8_t* dst_v,
+                       int dst_stride_v,
+                       int width,
+                       int height,
+                       int tile_height) {
+  const ptrdiff_t src_tile_stride = 16 * tile_height;
+  int y;
+  void (*DetileSplitUVRow)(const uint8_t* src, ptrdiff_t src_tile_stride,
+                           uint8_t* dst_u, uint8_t* dst_v, int width) =
+      DetileSplitUVRow_C;
+  if (!src_uv || !dst_u || !dst_v || width <= 0 || height == 0 ||
+      tile_height <= 0 || (tile_height & (tile_height - 1)) ||
+      src_stride_uv < width) {
+    return -1;
+  }
+  // Negative height means invert the image.
+  if (height < 0) {
+    height = -height;
+    dst_u = dst_u + (height - 1) * dst_stride_u;
+    dst_v = dst_v + (height - 1) * dst_stride_v;
+    dst_stride_u = -dst_stride_u;
+    dst_stride_v = -dst_stride_v;
+  }
+#if defined(HAS_DETILESPLITUVROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    DetileSplitUVRow = DetileSplitUVRow_Any_SSSE3;
+    if (IS_ALIGNED(width, 16)) {
+      DetileSplitUVRow = DetileSplitUVRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_DETILESPLITUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    DetileSplitUVRow = DetileSplitUVRow_Any_NEON;
+    if (IS_ALIGNED(width, 16)) {
+      DetileSplitUVRow = DetileSplitUVRow_NEON;
+    }
+  }
+#endif
+
+  for (y = 0; y < height; ++y) {
+    DetileSplitUVRow(src_uv, src_tile_stride, dst_u, dst_v, width);
+    dst_u += dst_stride_u;
+    dst_v += dst_stride_v;
+    src_uv += 16;
+    // Advance to next row of tiles.
+    if ((y & (tile_height - 1)) == (tile_height - 1)) {
+      src_uv = src_uv - src_tile_stride + src_stride_uv * tile_height;
+    }
+  }
+  return 0;
+}
+
 LIBYUV_API
 void MergeUVPlane(const uint8_t* src_u,
                   int src_stride_u,
@@ -4752,6 +4861,20 @@ int YUY2ToNV12(const uint8_t* src_yuy2,
                int dst_stride_uv,
                int width,
                int height) {
+  return YUY2ToNV12_WithScratch(src_yuy2, src_stride_yuy2, dst_y, dst_stride_y,
+                                dst_uv, dst_stride_uv, width, height, NULL);
+}
+
+LIBYUV_API
+int YUY2ToNV12_WithScratch(const uint8_t* src_yuy2,
+                           int src_stride_yuy2,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int width,
+                           int height,
+                           const LibyuvScratch* scratch) {
   int y;
   int halfwidth = (width + 1) >> 1;
   void (*SplitUVRow)(const uint8_t* src_uv, uint8_t* dst_u, uint8_t* dst_v,
@@ -4852,7 +4975,7 @@ int YUY2ToNV12(const uint8_t* src_yuy2,
   {
     int awidth = halfwidth * 2;
     // row of y and 2 rows of uv
-    align_buffer_64(rows, awidth * 3);
+    align_buffer_64_scratch(rows, awidth * 3, scratch);
 
     for (y = 0; y < height - 1; y += 2) {
       // Split Y from UV.
@@ -4875,6 +4998,12 @@ int YUY2ToNV12(const uint8_t* src_yuy2,
   return 0;
 }
 
+// Size of the row buffers used by YUY2ToNV12_WithScratch.
+LIBYUV_API
+int YUY2ToNV12ScratchSize(int width) {
+  return ((width + 1) & ~1) * 3 + 63;
+}
+
 LIBYUV_API
 int UYVYToNV12(const uint8_t* src_uyvy,
                int src_stride_uyvy,
@@ -4884,6 +5013,20 @@ int UYVYToNV12(const uint8_t* src_uyvy,
                int dst_stride_uv,
                int width,
                int height) {
+  return UYVYToNV12_WithScratch(src_uyvy, src_stride_uyvy, dst_y, dst_stride_y,
+                                dst_uv, dst_stride_uv, width, height, NULL);
+}
+
+LIBYUV_API
+int UYVYToNV12_WithScratch(const uint8_t* src_uyvy,
+                           int src_stride_uyvy,
+                           uint8_t* dst_y,
+                           int dst_stride_y,
+                           uint8_t* dst_uv,
+                           int dst_stride_uv,
+                           int width,
+                           int height,
+                           const LibyuvScratch* scratch) {
   int y;
   int halfwidth = (width + 1) >> 1;
   void (*SplitUVRow)(const uint8_t* src_uv, uint8_t* dst_u, uint8_t* dst_v,
@@ -4984,7 +5127,7 @@ int UYVYToNV12(const uint8_t* src_uyvy,
   {
     int awidth = halfwidth * 2;
     // row of y and 2 rows of uv
-    align_buffer_64(rows, awidth * 3);
+    align_buffer_64_scratch(rows, awidth * 3, scratch);
 
     for (y = 0; y < height - 1; y += 2) {
       // Split Y from UV.
@@ -5007,6 +5150,12 @@ int UYVYToNV12(const uint8_t* src_uyvy,
   return 0;
 }
 
+// Size of the row buffers used by UYVYToNV12_WithScratch.
+LIBYUV_API
+int UYVYToNV12ScratchSize(int width) {
+  return ((width + 1) & ~1) * 3 + 63;
+}
+
 // width and height are src size allowing odd size handling.
 LIBYUV_API
 void HalfMergeUVPlane(const uint8_t* src_u,
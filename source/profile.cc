@@ -0,0 +1,185 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "profile_internal.h"
+
+#if defined(LIBYUV_ENABLE_PROFILE)
+#if defined(_WIN32)
+#include <windows.h>  // For QueryPerformanceCounter()
+#else
+#include <time.h>  // For clock_gettime()
+#endif
+#endif
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// profile_enabled is read by ProfileStart() in profile_internal.h.
+int profile_enabled = 0;
+
+#if defined(LIBYUV_ENABLE_PROFILE)
+
+// Names of the ProfileFunction values.
+static const char* const kProfileNames[kProfileFunctionCount] = {
+    "I420ToARGBMatrix",
+    "I422ToARGBMatrix",
+    "NV12ToARGBMatrix",
+    "I420ToARGBMatrixBatch",
+    "ARGBToI420",
+    "ARGBToI420Batch",
+    "I420ToRGBTensorMatrix",
+    "NV12ToRGBTensorMatrix",
+    "I420Scale",
+    "NV12Scale",
+    "ARGBScale",
+};
+
+// Counters are updated with relaxed atomics so that calls on several threads
+// are all counted.  32 bit targets may need libatomic for these.
+static uint64_t profile_calls[kProfileFunctionCount];
+static uint64_t profile_pixels[kProfileFunctionCount];
+static uint64_t profile_nanoseconds[kProfileFunctionCount];
+static int profile_kernel[kProfileFunctionCount];
+
+static ProfileCallback profile_callback = NULL;
+static void* profile_callback_opaque = NULL;
+
+#ifdef __ATOMIC_RELAXED
+#define PROFILE_ADD(var, value) \
+  __atomic_fetch_add(&(var), value, __ATOMIC_RELAXED)
+#define PROFILE_LOAD(var) __atomic_load_n(&(var), __ATOMIC_RELAXED)
+#define PROFILE_STORE(var, value) \
+  __atomic_store_n(&(var), value, __ATOMIC_RELAXED)
+#else
+#define PROFILE_ADD(var, value) (var) += (value)
+#define PROFILE_LOAD(var) (var)
+#define PROFILE_STORE(var, value) (var) = (value)
+#endif
+
+uint64_t ProfileTime(void) {
+#if defined(_WIN32)
+  LARGE_INTEGER t, f;
+  QueryPerformanceCounter(&t);
+  QueryPerformanceFrequency(&f);
+  return (uint64_t)((double)t.QuadPart * 1e9 / (double)f.QuadPart);
+#else
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (uint64_t)t.tv_sec * 1000000000u + (uint64_t)t.tv_nsec;
+#endif
+}
+
+void ProfileRecord(enum ProfileFunction function,
+                   uint64_t start_ns,
+                   uint64_t pixels,
+                   int kernel) {
+  uint64_t nanoseconds = ProfileTime() - start_ns;
+  PROFILE_ADD(profile_calls[function], 1);
+  PROFILE_ADD(profile_pixels[function], pixels);
+  PROFILE_ADD(profile_nanoseconds[function], nanoseconds);
+  PROFILE_STORE(profile_kernel[function], kernel);
+  if (profile_callback) {
+    profile_callback(profile_callback_opaque, kProfileNames[function],
+                     start_ns, nanoseconds, pixels, kernel);
+  }
+}
+
+LIBYUV_API
+int EnableProfile(int enable) {
+  PROFILE_STORE(profile_enabled, enable ? 1 : 0);
+  return enable ? 1 : 0;
+}
+
+LIBYUV_API
+int GetProfileStats(struct ProfileStats* stats, int max_stats) {
+  int count = 0;
+  int i;
+  if (!stats) {
+    return 0;
+  }
+  for (i = 0; i < kProfileFunctionCount && count < max_stats; ++i) {
+    uint64_t calls = PROFILE_LOAD(profile_calls[i]);
+    if (calls) {
+      stats[count].name = kProfileNames[i];
+      stats[count].calls = calls;
+      stats[count].pixels = PROFILE_LOAD(profile_pixels[i]);
+      stats[count].nanoseconds = PROFILE_LOAD(profile_nanoseconds[i]);
+      stats[count].kernel = PROFILE_LOAD(profile_kernel[i]);
+      ++count;
+    }
+  }
+  return count;
+}
+
+LIBYUV_API
+void ResetProfileStats(void) {
+  int i;
+  for (i = 0; i < kProfileFunctionCount; ++i) {
+    PROFILE_STORE(profile_calls[i], 0);
+    PROFILE_STORE(profile_pixels[i], 0);
+    PROFILE_STORE(profile_nanoseconds[i], 0);
+    PROFILE_STORE(profile_kernel[i], 0);
+  }
+}
+
+LIBYUV_API
+void SetProfileCallback(ProfileCallback callback, void* opaque) {
+  profile_callback_opaque = opaque;
+  profile_callback = callback;
+}
+
+#else  // defined(LIBYUV_ENABLE_PROFILE)
+
+// Without LIBYUV_ENABLE_PROFILE ProfileStart() always returns 0, so these are
+// only here to link unoptimized builds and keep the API.
+uint64_t ProfileTime(void) {
+  return 0;
+}
+
+void ProfileRecord(enum ProfileFunction function,
+                   uint64_t start_ns,
+                   uint64_t pixels,
+                   int kernel) {
+  (void)function;
+  (void)start_ns;
+  (void)pixels;
+  (void)kernel;
+}
+
+LIBYUV_API
+int EnableProfile(int enable) {
+  (void)enable;
+  return 0;
+}
+
+LIBYUV_API
+int GetProfileStats(struct ProfileStats* stats, int max_stats) {
+  (void)stats;
+  (void)max_stats;
+  return 0;
+}
+
+LIBYUV_API
+void ResetProfileStats(void) {}
+
+LIBYUV_API
+void SetProfileCallback(ProfileCallback callback, void* opaque) {
+  (void)callback;
+  (void)opaque;
+}
+
+#endif  // defined(LIBYUV_ENABLE_PROFILE)
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
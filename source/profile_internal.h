@@ -0,0 +1,61 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#ifndef SOURCE_PROFILE_INTERNAL_H_
+#define SOURCE_PROFILE_INTERNAL_H_
+
+#include "libyuv/profile.h"
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+// Functions used by the profiled functions; not part of the API.
+// ProfileStart returns the time, or 0 if profiling is off, and ProfileStop
+// records the call if the start time is not 0.
+
+// Set by EnableProfile.
+extern int profile_enabled;
+
+uint64_t ProfileTime(void);
+void ProfileRecord(enum ProfileFunction function,
+                   uint64_t start_ns,
+                   uint64_t pixels,
+                   int kernel);
+
+static __inline uint64_t ProfileStart(void) {
+#if defined(LIBYUV_ENABLE_PROFILE)
+#ifdef __ATOMIC_RELAXED
+  if (__atomic_load_n(&profile_enabled, __ATOMIC_RELAXED)) {
+#else
+  if (profile_enabled) {
+#endif
+    return ProfileTime();
+  }
+#endif
+  return 0;
+}
+
+static __inline void ProfileStop(enum ProfileFunction function,
+                                 uint64_t start_ns,
+                                 uint64_t pixels,
+                                 int kernel) {
+  if (start_ns) {
+    ProfileRecord(function, start_ns, pixels, kernel);
+  }
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
+
+#endif  // SOURCE_PROFILE_INTERNAL_H_
@@ -21,6 +21,171 @@ namespace libyuv {
 extern "C" {
 #endif
 
+// Tile size used to cache block transposes, packed as width << 16 | height.
+// 0 selects automatically.
+static int rotate_tile_size_ = 0;
+static int auto_rotate_tile_size_ = 0;
+
+#ifdef __ATOMIC_RELAXED
+#define ROTATE_LOAD(var) __atomic_load_n(&(var), __ATOMIC_RELAXED)
+#define ROTATE_STORE(var, value) \
+  __atomic_store_n(&(var), value, __ATOMIC_RELAXED)
+#else
+#define ROTATE_LOAD(var) (var)
+#define ROTATE_STORE(var, value) (var) = (value)
+#endif
+
+LIBYUV_API
+void SetRotateTileSize(int tile_width, int tile_height) {
+  tile_width = tile_width > 0 ? tile_width : 0;
+  tile_height = tile_height > 0 ? tile_height : 0;
+  if (tile_width > 0x7fff) {
+    tile_width = 0x7fff;
+  }
+  if (tile_height > 0xffff) {
+    tile_height = 0xffff;
+  }
+  ROTATE_STORE(rotate_tile_size_, (tile_width << 16) | tile_height);
+}
+
+static int CalcRotateTileSize(void) {
+  int l1_size = GetCpuCacheSize(1);
+  int l2_size = GetCpuCacheSize(2);
+  int tw = 32;
+  int th;
+  if (!l1_size) {
+    l1_size = 32 * 1024;
+  }
+  if (!l2_size) {
+    l2_size = 256 * 1024;
+  }
+  // Keep each destination row's cache line, plus the source rows of the
+  // strip being transposed, in L1. Wider tiles lose L1 and TLB hits.
+  while (tw * 2 * 1024 <= l1_size && tw < 128) {
+    tw *= 2;
+  }
+  // Keep the source cache lines of a column of tiles in half of L2 so the
+  // next column of tiles reads the rest of each line from L2.
+  th = (l2_size / 128) & ~15;
+  if (th < 64) {
+    th = 64;
+  }
+  if (th > 0xfff0) {
+    th = 0xfff0;
+  }
+  return (tw << 16) | th;
+}
+
+void GetRotateTileSize(int* tile_width, int* tile_height) {
+  int tile_size = ROTATE_LOAD(rotate_tile_size_);
+  int auto_tile_size = ROTATE_LOAD(auto_rotate_tile_size_);
+  if (!auto_tile_size) {
+    // Every thread computes the same value, so publishing it with a single
+    // word store is safe if several threads race on first use.
+    auto_tile_size = CalcRotateTileSize();
+    ROTATE_STORE(auto_rotate_tile_size_, auto_tile_size);
+  }
+  *tile_width = (tile_size >> 16) ? (tile_size >> 16) : (auto_tile_size >> 16);
+  *tile_height =
+      (tile_size & 0xffff) ? (tile_size & 0xffff) : (auto_tile_size & 0xffff);
+}
+
+// Bytes of converted rows that RotateStrips rotates at a time.  0 until
+// first use.
+static int auto_rotate_strip_bytes_ = 0;
+
+// Half of L2, or 512 KB if the L2 size is unknown.
+static int CalcRotateStripBytes(void) {
+  int l2_size = GetCpuCacheSize(2);
+  return l2_size ? l2_size / 2 : 512 * 1024;
+}
+
+int RotateStrips(int row_bytes,
+                 int crop_y,
+                 int crop_height,
+                 int invert,
+                 enum RotationMode rotation,
+                 RotateStripFunc convert_rotate,
+                 void* opaque) {
+  int strip_bytes = ROTATE_LOAD(auto_rotate_strip_bytes_);
+  int strip_rows;
+  uint8_t* strip;
+  int y;
+  int r = 0;
+  if (!strip_bytes) {
+    strip_bytes = CalcRotateStripBytes();
+    ROTATE_STORE(auto_rotate_strip_bytes_, strip_bytes);
+  }
+  strip_rows = (strip_bytes / row_bytes) & ~15;
+  if (strip_rows < 16) {
+    strip_rows = 16;
+  }
+  if (strip_rows > crop_height) {
+    strip_rows = crop_height;
+  }
+  strip = (uint8_t*)malloc((size_t)row_bytes * strip_rows); /* NOLINT */
+  if (!strip) {
+    return 1;  // Out of memory runtime error.
+  }
+  for (y = 0; y < crop_height; y += strip_rows) {
+    const int rows =
+        (crop_height - y < strip_rows) ? crop_height - y : strip_rows;
+    // An inverted sample is read from the bottom of the crop up.
+    const int strip_crop_y =
+        invert ? crop_y + crop_height - y - rows : crop_y + y;
+    const int dst_offset =
+        (rotation == kRotate270) ? y : crop_height - y - rows;
+    r = convert_rotate(opaque, strip, strip_rows, strip_crop_y, rows,
+                       dst_offset);
+    if (r) {
+      break;
+    }
+  }
+  free(strip);
+  return r;
+}
+
+// Transpose one tile in strips of 16 or 8 rows.
+static void TransposeTile(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int width,
+                          int height,
+                          void (*TransposeWx16)(const uint8_t* src,
+                                                int src_stride,
+                                                uint8_t* dst,
+                                                int dst_stride,
+                                                int width),
+                          void (*TransposeWx8)(const uint8_t* src,
+                                               int src_stride,
+                                               uint8_t* dst,
+                                               int dst_stride,
+                                               int width)) {
+  int i = height;
+  if (TransposeWx16) {
+    // Work across the source in 16x16 tiles
+    while (i >= 16) {
+      TransposeWx16(src, src_stride, dst, dst_stride, width);
+      src += 16 * src_stride;  // Go down 16 rows.
+      dst += 16;               // Move over 16 columns.
+      i -= 16;
+    }
+  }
+
+  // Work across the source in 8x8 tiles
+  while (i >= 8) {
+    TransposeWx8(src, src_stride, dst, dst_stride, width);
+    src += 8 * src_stride;  // Go down 8 rows.
+    dst += 8;               // Move over 8 columns.
+    i -= 8;
+  }
+
+  if (i > 0) {
+    TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
+  }
+}
+
 LIBYUV_API
 void TransposePlane(const uint8_t* src,
                     int src_stride,
@@ -28,14 +193,14 @@ void TransposePlane(const uint8_t* src,
                     int dst_stride,
                     int width,
                     int height) {
-  int i = height;
-#if defined(HAS_TRANSPOSEWX16_MSA)
+  int tile_width;
+  int tile_height;
+  int x;
+  int y;
   void (*TransposeWx16)(const uint8_t* src, int src_stride, uint8_t* dst,
-                        int dst_stride, int width) = TransposeWx16_C;
-#else
+                        int dst_stride, int width) = NULL;
   void (*TransposeWx8)(const uint8_t* src, int src_stride, uint8_t* dst,
                        int dst_stride, int width) = TransposeWx8_C;
-#endif
 
 #if defined(HAS_TRANSPOSEWX16_MSA)
   if (TestCpuFlag(kCpuHasMSA)) {
@@ -44,7 +209,7 @@ void TransposePlane(const uint8_t* src,
       TransposeWx16 = TransposeWx16_MSA;
     }
   }
-#else
+#endif
 #if defined(HAS_TRANSPOSEWX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     TransposeWx8 = TransposeWx8_NEON;
@@ -71,28 +236,37 @@ void TransposePlane(const uint8_t* src,
     }
   }
 #endif
-#endif /* defined(HAS_TRANSPOSEWX16_MSA) */
-
-#if defined(HAS_TRANSPOSEWX16_MSA)
-  // Work across the source in 16x16 tiles
-  while (i >= 16) {
-    TransposeWx16(src, src_stride, dst, dst_stride, width);
-    src += 16 * src_stride;  // Go down 16 rows.
-    dst += 16;               // Move over 16 columns.
-    i -= 16;
+#if defined(HAS_TRANSPOSEWX16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeWx16 = TransposeWx16_Any_AVX2;
+    if (IS_ALIGNED(width, 16)) {
+      TransposeWx16 = TransposeWx16_AVX2;
+    }
   }
-#else
-  // Work across the source in 8x8 tiles
-  while (i >= 8) {
-    TransposeWx8(src, src_stride, dst, dst_stride, width);
-    src += 8 * src_stride;  // Go down 8 rows.
-    dst += 8;               // Move over 8 columns.
-    i -= 8;
+#endif
+#if defined(HAS_TRANSPOSEWX16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    TransposeWx16 = TransposeWx16_Any_AVX512BW;
+    if (IS_ALIGNED(width, 32)) {
+      TransposeWx16 = TransposeWx16_AVX512BW;
+    }
   }
 #endif
 
-  if (i > 0) {
-    TransposeWxH_C(src, src_stride, dst, dst_stride, width, i);
+  GetRotateTileSize(&tile_width, &tile_height);
+  // Round the tile width up to the widest kernel block, 32 columns, so every
+  // tile of an aligned width stays aligned for the kernels chosen above.
+  tile_width = (tile_width + 31) & ~31;
+  // Cache block the transpose so the destination rows being written stay
+  // resident while the source is walked down a tile_width wide column.
+  for (x = 0; x < width; x += tile_width) {
+    int tw = (width - x) < tile_width ? (width - x) : tile_width;
+    for (y = 0; y < height; y += tile_height) {
+      int th = (height - y) < tile_height ? (height - y) : tile_height;
+      TransposeTile(src + y * src_stride + x, src_stride,
+                    dst + x * dst_stride + y, dst_stride, tw, th,
+                    TransposeWx16, TransposeWx8);
+    }
   }
 }
 
@@ -220,6 +394,59 @@ void RotatePlane180(const uint8_t* src,
   free_aligned_buffer_64(row);
 }
 
+// Transpose one tile of UV pairs in strips of 16 or 8 rows.
+static void TransposeUVTile(
+    const uint8_t* src,
+    int src_stride,
+    uint8_t* dst_a,
+    int dst_stride_a,
+    uint8_t* dst_b,
+    int dst_stride_b,
+    int width,
+    int height,
+    void (*TransposeUVWx16)(const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst_a,
+                            int dst_stride_a,
+                            uint8_t* dst_b,
+                            int dst_stride_b,
+                            int width),
+    void (*TransposeUVWx8)(const uint8_t* src,
+                           int src_stride,
+                           uint8_t* dst_a,
+                           int dst_stride_a,
+                           uint8_t* dst_b,
+                           int dst_stride_b,
+                           int width)) {
+  int i = height;
+  if (TransposeUVWx16) {
+    // Work through the source in 16x16 tiles.
+    while (i >= 16) {
+      TransposeUVWx16(src, src_stride, dst_a, dst_stride_a, dst_b,
+                      dst_stride_b, width);
+      src += 16 * src_stride;  // Go down 16 rows.
+      dst_a += 16;             // Move over 16 columns.
+      dst_b += 16;             // Move over 16 columns.
+      i -= 16;
+    }
+  }
+
+  // Work through the source in 8x8 tiles.
+  while (i >= 8) {
+    TransposeUVWx8(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
+                   width);
+    src += 8 * src_stride;  // Go down 8 rows.
+    dst_a += 8;             // Move over 8 columns.
+    dst_b += 8;             // Move over 8 columns.
+    i -= 8;
+  }
+
+  if (i > 0) {
+    TransposeUVWxH_C(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
+                     width, i);
+  }
+}
+
 LIBYUV_API
 void TransposeUV(const uint8_t* src,
                  int src_stride,
@@ -229,16 +456,16 @@ void TransposeUV(const uint8_t* src,
                  int dst_stride_b,
                  int width,
                  int height) {
-  int i = height;
-#if defined(HAS_TRANSPOSEUVWX16_MSA)
+  int tile_width;
+  int tile_height;
+  int x;
+  int y;
   void (*TransposeUVWx16)(const uint8_t* src, int src_stride, uint8_t* dst_a,
                           int dst_stride_a, uint8_t* dst_b, int dst_stride_b,
-                          int width) = TransposeUVWx16_C;
-#else
+                          int width) = NULL;
   void (*TransposeUVWx8)(const uint8_t* src, int src_stride, uint8_t* dst_a,
                          int dst_stride_a, uint8_t* dst_b, int dst_stride_b,
                          int width) = TransposeUVWx8_C;
-#endif
 
 #if defined(HAS_TRANSPOSEUVWX16_MSA)
   if (TestCpuFlag(kCpuHasMSA)) {
@@ -247,7 +474,7 @@ void TransposeUV(const uint8_t* src,
       TransposeUVWx16 = TransposeUVWx16_MSA;
     }
   }
-#else
+#endif
 #if defined(HAS_TRANSPOSEUVWX8_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     TransposeUVWx8 = TransposeUVWx8_NEON;
@@ -269,33 +496,37 @@ void TransposeUV(const uint8_t* src,
     }
   }
 #endif
-#endif /* defined(HAS_TRANSPOSEUVWX16_MSA) */
-
-#if defined(HAS_TRANSPOSEUVWX16_MSA)
-  // Work through the source in 8x8 tiles.
-  while (i >= 16) {
-    TransposeUVWx16(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
-                    width);
-    src += 16 * src_stride;  // Go down 16 rows.
-    dst_a += 16;             // Move over 8 columns.
-    dst_b += 16;             // Move over 8 columns.
-    i -= 16;
+#if defined(HAS_TRANSPOSEUVWX16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    TransposeUVWx16 = TransposeUVWx16_Any_AVX2;
+    if (IS_ALIGNED(width, 8)) {
+      TransposeUVWx16 = TransposeUVWx16_AVX2;
+    }
   }
-#else
-  // Work through the source in 8x8 tiles.
-  while (i >= 8) {
-    TransposeUVWx8(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
-                   width);
-    src += 8 * src_stride;  // Go down 8 rows.
-    dst_a += 8;             // Move over 8 columns.
-    dst_b += 8;             // Move over 8 columns.
-    i -= 8;
+#endif
+#if defined(HAS_TRANSPOSEUVWX16_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    TransposeUVWx16 = TransposeUVWx16_Any_AVX512BW;
+    if (IS_ALIGNED(width, 16)) {
+      TransposeUVWx16 = TransposeUVWx16_AVX512BW;
+    }
   }
 #endif
 
-  if (i > 0) {
-    TransposeUVWxH_C(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b,
-                     width, i);
+  GetRotateTileSize(&tile_width, &tile_height);
+  // Each UV pair writes a row to both destinations, so halve the tile width
+  // to keep the same number of destination rows in flight as TransposePlane.
+  // Round up to the widest kernel block, 16 pairs, as in TransposePlane.
+  tile_width = (((tile_width + 1) >> 1) + 15) & ~15;
+  for (x = 0; x < width; x += tile_width) {
+    int tw = (width - x) < tile_width ? (width - x) : tile_width;
+    for (y = 0; y < height; y += tile_height) {
+      int th = (height - y) < tile_height ? (height - y) : tile_height;
+      TransposeUVTile(src + y * src_stride + x * 2, src_stride,
+                      dst_a + x * dst_stride_a + y, dst_stride_a,
+                      dst_b + x * dst_stride_b + y, dst_stride_b, tw, th,
+                      TransposeUVWx16, TransposeUVWx8);
+    }
   }
 }
 
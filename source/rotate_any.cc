@@ -41,10 +41,30 @@ TANY(TransposeWx8_Any_MMI, TransposeWx8_MMI, 7)
 #ifdef HAS_TRANSPOSEWX8_FAST_SSSE3
 TANY(TransposeWx8_Fast_Any_SSSE3, TransposeWx8_Fast_SSSE3, 15)
 #endif
+#undef TANY
+
+// Same as TANY but the remainder columns are transposed 16 rows at a time.
+#define TANY16(NAMEANY, TPOS_SIMD, MASK)                                       \
+  void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst,               \
+               int dst_stride, int width) {                                    \
+    int r = width & MASK;                                                      \
+    int n = width - r;                                                         \
+    if (n > 0) {                                                               \
+      TPOS_SIMD(src, src_stride, dst, dst_stride, n);                          \
+    }                                                                          \
+    TransposeWx16_C(src + n, src_stride, dst + n * dst_stride, dst_stride, r); \
+  }
+
 #ifdef HAS_TRANSPOSEWX16_MSA
-TANY(TransposeWx16_Any_MSA, TransposeWx16_MSA, 15)
+TANY16(TransposeWx16_Any_MSA, TransposeWx16_MSA, 15)
 #endif
-#undef TANY
+#ifdef HAS_TRANSPOSEWX16_AVX2
+TANY16(TransposeWx16_Any_AVX2, TransposeWx16_AVX2, 15)
+#endif
+#ifdef HAS_TRANSPOSEWX16_AVX512BW
+TANY16(TransposeWx16_Any_AVX512BW, TransposeWx16_AVX512BW, 31)
+#endif
+#undef TANY16
 
 #define TUVANY(NAMEANY, TPOS_SIMD, MASK)                                       \
   void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst_a,             \
@@ -68,10 +88,33 @@ TUVANY(TransposeUVWx8_Any_SSE2, TransposeUVWx8_SSE2, 7)
 #ifdef HAS_TRANSPOSEUVWX8_MMI
 TUVANY(TransposeUVWx8_Any_MMI, TransposeUVWx8_MMI, 7)
 #endif
+#undef TUVANY
+
+// Same as TUVANY but the remainder columns are transposed 16 rows at a time.
+#define TUVANY16(NAMEANY, TPOS_SIMD, MASK)                                     \
+  void NAMEANY(const uint8_t* src, int src_stride, uint8_t* dst_a,             \
+               int dst_stride_a, uint8_t* dst_b, int dst_stride_b,             \
+               int width) {                                                    \
+    int r = width & MASK;                                                      \
+    int n = width - r;                                                         \
+    if (n > 0) {                                                               \
+      TPOS_SIMD(src, src_stride, dst_a, dst_stride_a, dst_b, dst_stride_b, n); \
+    }                                                                          \
+    TransposeUVWx16_C(src + n * 2, src_stride, dst_a + n * dst_stride_a,       \
+                      dst_stride_a, dst_b + n * dst_stride_b, dst_stride_b,    \
+                      r);                                                      \
+  }
+
 #ifdef HAS_TRANSPOSEUVWX16_MSA
-TUVANY(TransposeUVWx16_Any_MSA, TransposeUVWx16_MSA, 7)
+TUVANY16(TransposeUVWx16_Any_MSA, TransposeUVWx16_MSA, 7)
 #endif
-#undef TUVANY
+#ifdef HAS_TRANSPOSEUVWX16_AVX2
+TUVANY16(TransposeUVWx16_Any_AVX2, TransposeUVWx16_AVX2, 7)
+#endif
+#ifdef HAS_TRANSPOSEUVWX16_AVX512BW
+TUVANY16(TransposeUVWx16_Any_AVX512BW, TransposeUVWx16_AVX512BW, 15)
+#endif
+#undef TUVANY16
 
 #ifdef __cplusplus
 }  // extern "C"
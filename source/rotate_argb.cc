@@ -13,6 +13,7 @@
 #include "libyuv/convert.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"
+#include "libyuv/rotate_row.h"
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h" /* for ScaleARGBRowDownEven_ */
 
@@ -28,6 +29,9 @@ static int ARGBTranspose(const uint8_t* src_argb,
                          int width,
                          int height) {
   int i;
+  int y;
+  int tile_width;
+  int tile_height;
   int src_pixel_step = src_stride_argb >> 2;
   void (*ScaleARGBRowDownEven)(
       const uint8_t* src_argb, ptrdiff_t src_stride_argb, int src_step,
@@ -69,10 +73,19 @@ static int ARGBTranspose(const uint8_t* src_argb,
   }
 #endif
 
-  for (i = 0; i < width; ++i) {  // column of source to row of dest.
-    ScaleARGBRowDownEven(src_argb, 0, src_pixel_step, dst_argb, height);
-    dst_argb += dst_stride_argb;
-    src_argb += 4;
+  GetRotateTileSize(&tile_width, &tile_height);
+  // Each source column is gathered with a stride, so work down the source in
+  // bands of rows whose cache lines stay resident across adjacent columns.
+  tile_height = (tile_width * 2 + 3) & ~3;  // Multiple of 4 for SIMD.
+  for (y = 0; y < height; y += tile_height) {
+    int th = (height - y) < tile_height ? (height - y) : tile_height;
+    const uint8_t* src = src_argb + y * src_stride_argb;
+    uint8_t* dst = dst_argb + y * 4;
+    for (i = 0; i < width; ++i) {  // column of source to row of dest.
+      ScaleARGBRowDownEven(src, 0, src_pixel_step, dst, th);
+      dst += dst_stride_argb;
+      src += 4;
+    }
   }
   return 0;
 }
@@ -366,6 +366,290 @@ void TransposeUVWx8_SSE2(const uint8_t* src,
         "xmm7", "xmm8", "xmm9");
 }
 #endif  // defined(HAS_TRANSPOSEUVWX8_SSE2)
+
+#if defined(HAS_TRANSPOSEWX16_AVX2) || defined(HAS_TRANSPOSEUVWX16_AVX2) || \
+    defined(HAS_TRANSPOSEWX16_AVX512BW) || defined(HAS_TRANSPOSEUVWX16_AVX512BW)
+// clang-format off
+
+// Read 16 rows of 16 bytes.  Row n goes in the low lane and row n + 8 in the
+// high lane of register n.
+#define LOAD16X16_AVX2(n)                                                 \
+  "vmovdqu     (%[src]),%%xmm" #n "                                  \n" \
+  "vinserti128 $0x1,(%[src],%[src_stride],8),%%ymm" #n ",%%ymm" #n " \n" \
+  "lea         (%[src],%[src_stride]),%[src]                         \n"
+
+// Read 16 rows of 32 bytes.  The lanes of register n hold row n columns 0 to
+// 15, row n + 8 columns 0 to 15, then the same for columns 16 to 31.
+#define LOAD16X32_AVX512BW(n)                                             \
+  "vmovdqu     (%[src]),%%ymm" #n "                                  \n" \
+  "vinserti64x4 $0x1,(%[src],%[src_stride],8),%%zmm" #n ",%%zmm" #n "\n" \
+  "vshufi64x2  $0xd8,%%zmm" #n ",%%zmm" #n ",%%zmm" #n "             \n" \
+  "lea         (%[src],%[src_stride]),%[src]                         \n"
+
+// Step the source back up 8 rows and across by the number of bytes read.
+#define NEXT16ROWS(bytes)                                                 \
+  "neg         %[src_stride]                                         \n" \
+  "lea         " #bytes "(%[src],%[src_stride],8),%[src]             \n" \
+  "neg         %[src_stride]                                         \n"
+
+// Transpose 8x8 bytes in each 128 bit lane of registers 0 to 7.  Each lane of
+// the results in registers 0, 12, 1, 13, 8, 14, 3 and 15 holds 2 columns, in
+// order, 8 bytes each.
+#define TRANSPOSE8X8_LANES(R)                                             \
+  "vpunpckhbw  %%" #R "1,%%" #R "0,%%" #R "8                         \n" \
+  "vpunpcklbw  %%" #R "1,%%" #R "0,%%" #R "0                         \n" \
+  "vpunpckhbw  %%" #R "3,%%" #R "2,%%" #R "9                         \n" \
+  "vpunpcklbw  %%" #R "3,%%" #R "2,%%" #R "2                         \n" \
+  "vpunpckhbw  %%" #R "5,%%" #R "4,%%" #R "10                        \n" \
+  "vpunpcklbw  %%" #R "5,%%" #R "4,%%" #R "4                         \n" \
+  "vpunpckhbw  %%" #R "7,%%" #R "6,%%" #R "11                        \n" \
+  "vpunpcklbw  %%" #R "7,%%" #R "6,%%" #R "6                         \n" \
+  "vpunpckhwd  %%" #R "2,%%" #R "0,%%" #R "1                         \n" \
+  "vpunpcklwd  %%" #R "2,%%" #R "0,%%" #R "0                         \n" \
+  "vpunpckhwd  %%" #R "9,%%" #R "8,%%" #R "3                         \n" \
+  "vpunpcklwd  %%" #R "9,%%" #R "8,%%" #R "8                         \n" \
+  "vpunpckhwd  %%" #R "6,%%" #R "4,%%" #R "5                         \n" \
+  "vpunpcklwd  %%" #R "6,%%" #R "4,%%" #R "4                         \n" \
+  "vpunpckhwd  %%" #R "11,%%" #R "10,%%" #R "7                       \n" \
+  "vpunpcklwd  %%" #R "11,%%" #R "10,%%" #R "10                      \n" \
+  "vpunpckhdq  %%" #R "4,%%" #R "0,%%" #R "12                        \n" \
+  "vpunpckldq  %%" #R "4,%%" #R "0,%%" #R "0                         \n" \
+  "vpunpckhdq  %%" #R "5,%%" #R "1,%%" #R "13                        \n" \
+  "vpunpckldq  %%" #R "5,%%" #R "1,%%" #R "1                         \n" \
+  "vpunpckhdq  %%" #R "10,%%" #R "8,%%" #R "14                       \n" \
+  "vpunpckldq  %%" #R "10,%%" #R "8,%%" #R "8                        \n" \
+  "vpunpckhdq  %%" #R "7,%%" #R "3,%%" #R "15                        \n" \
+  "vpunpckldq  %%" #R "7,%%" #R "3,%%" #R "3                         \n"
+
+// Join rows 0 to 7 and rows 8 to 15 of the 2 columns in register n and store
+// them to 2 rows of the destination.
+#define STORE16X2_AVX2(n)                                                 \
+  "vpermq      $0xd8,%%ymm" #n ",%%ymm" #n "                         \n" \
+  "vmovdqu     %%xmm" #n ",(%[dst])                                  \n" \
+  "vextracti128 $0x1,%%ymm" #n ",(%[dst],%[dst_stride])              \n" \
+  "lea         (%[dst],%[dst_stride],2),%[dst]                       \n"
+
+// Same as STORE16X2_AVX2 plus 2 more columns stored 16 rows further on.
+#define STORE16X4_AVX512BW(n)                                             \
+  "vpermq      $0xd8,%%zmm" #n ",%%zmm" #n "                         \n" \
+  "vmovdqu     %%xmm" #n ",(%[dst])                                  \n" \
+  "vextracti128 $0x1,%%ymm" #n ",(%[dst],%[dst_stride])              \n" \
+  "vextracti32x4 $0x2,%%zmm" #n ",(%[dst16])                         \n" \
+  "vextracti32x4 $0x3,%%zmm" #n ",(%[dst16],%[dst_stride])           \n" \
+  "lea         (%[dst],%[dst_stride],2),%[dst]                       \n" \
+  "lea         (%[dst16],%[dst_stride],2),%[dst16]                   \n"
+
+// Store the U column in register n to destination A and the V column to B.
+#define STOREUV16_AVX2(n)                                                 \
+  "vpermq      $0xd8,%%ymm" #n ",%%ymm" #n "                         \n" \
+  "vmovdqu     %%xmm" #n ",(%[dst_a])                                \n" \
+  "vextracti128 $0x1,%%ymm" #n ",(%[dst_b])                          \n" \
+  "lea         (%[dst_a],%[dst_stride_a]),%[dst_a]                   \n" \
+  "lea         (%[dst_b],%[dst_stride_b]),%[dst_b]                   \n"
+
+// Same as STOREUV16_AVX2 plus 2 more columns stored 8 rows further on.
+#define STOREUV16X2_AVX512BW(n)                                           \
+  "vpermq      $0xd8,%%zmm" #n ",%%zmm" #n "                         \n" \
+  "vmovdqu     %%xmm" #n ",(%[dst_a])                                \n" \
+  "vextracti128 $0x1,%%ymm" #n ",(%[dst_b])                          \n" \
+  "vextracti32x4 $0x2,%%zmm" #n ",(%[dst_a],%[dst_stride_a],8)       \n" \
+  "vextracti32x4 $0x3,%%zmm" #n ",(%[dst_b],%[dst_stride_b],8)       \n" \
+  "lea         (%[dst_a],%[dst_stride_a]),%[dst_a]                   \n" \
+  "lea         (%[dst_b],%[dst_stride_b]),%[dst_b]                   \n"
+
+// clang-format on
+#endif
+
+// Transpose 16x16. 64 bit
+#if defined(HAS_TRANSPOSEWX16_AVX2)
+void TransposeWx16_AVX2(const uint8_t* src,
+                        int src_stride,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int width) {
+  // clang-format off
+  asm volatile(
+    LABELALIGN
+      "1:                                        \n"
+    LOAD16X16_AVX2(0)
+    LOAD16X16_AVX2(1)
+    LOAD16X16_AVX2(2)
+    LOAD16X16_AVX2(3)
+    LOAD16X16_AVX2(4)
+    LOAD16X16_AVX2(5)
+    LOAD16X16_AVX2(6)
+    LOAD16X16_AVX2(7)
+    NEXT16ROWS(0x10)
+    TRANSPOSE8X8_LANES(ymm)
+    STORE16X2_AVX2(0)
+    STORE16X2_AVX2(12)
+    STORE16X2_AVX2(1)
+    STORE16X2_AVX2(13)
+    STORE16X2_AVX2(8)
+    STORE16X2_AVX2(14)
+    STORE16X2_AVX2(3)
+    STORE16X2_AVX2(15)
+      "sub         $0x10,%[width]                \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+  : [src]"+r"(src),    // %[src]
+    [dst]"+r"(dst),    // %[dst]
+    [width]"+r"(width)    // %[width]
+  : [src_stride]"r"((intptr_t)(src_stride)),    // %[src_stride]
+    [dst_stride]"r"((intptr_t)(dst_stride))    // %[dst_stride]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+    "xmm15");
+  // clang-format on
+}
+#endif  // defined(HAS_TRANSPOSEWX16_AVX2)
+
+// Transpose 32x16. 64 bit
+#if defined(HAS_TRANSPOSEWX16_AVX512BW)
+void TransposeWx16_AVX512BW(const uint8_t* src,
+                            int src_stride,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int width) {
+  uint8_t* dst16;  // Destination 16 rows down.
+  // clang-format off
+  asm volatile(
+    LABELALIGN
+      "1:                                        \n"
+    LOAD16X32_AVX512BW(0)
+    LOAD16X32_AVX512BW(1)
+    LOAD16X32_AVX512BW(2)
+    LOAD16X32_AVX512BW(3)
+    LOAD16X32_AVX512BW(4)
+    LOAD16X32_AVX512BW(5)
+    LOAD16X32_AVX512BW(6)
+    LOAD16X32_AVX512BW(7)
+    NEXT16ROWS(0x20)
+    TRANSPOSE8X8_LANES(zmm)
+      "lea         (%[dst],%[dst_stride],8),%[dst16] \n"
+      "lea         (%[dst16],%[dst_stride],8),%[dst16] \n"
+    STORE16X4_AVX512BW(0)
+    STORE16X4_AVX512BW(12)
+    STORE16X4_AVX512BW(1)
+    STORE16X4_AVX512BW(13)
+    STORE16X4_AVX512BW(8)
+    STORE16X4_AVX512BW(14)
+    STORE16X4_AVX512BW(3)
+    STORE16X4_AVX512BW(15)
+      "mov         %[dst16],%[dst]               \n"
+      "sub         $0x20,%[width]                \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+  : [src]"+r"(src),    // %[src]
+    [dst]"+r"(dst),    // %[dst]
+    [dst16]"=&r"(dst16),    // %[dst16]
+    [width]"+r"(width)    // %[width]
+  : [src_stride]"r"((intptr_t)(src_stride)),    // %[src_stride]
+    [dst_stride]"r"((intptr_t)(dst_stride))    // %[dst_stride]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+    "xmm15");
+  // clang-format on
+}
+#endif  // defined(HAS_TRANSPOSEWX16_AVX512BW)
+
+// Transpose UV 8x16. 64 bit
+#if defined(HAS_TRANSPOSEUVWX16_AVX2)
+void TransposeUVWx16_AVX2(const uint8_t* src,
+                          int src_stride,
+                          uint8_t* dst_a,
+                          int dst_stride_a,
+                          uint8_t* dst_b,
+                          int dst_stride_b,
+                          int width) {
+  // clang-format off
+  asm volatile(
+    LABELALIGN
+      "1:                                        \n"
+    LOAD16X16_AVX2(0)
+    LOAD16X16_AVX2(1)
+    LOAD16X16_AVX2(2)
+    LOAD16X16_AVX2(3)
+    LOAD16X16_AVX2(4)
+    LOAD16X16_AVX2(5)
+    LOAD16X16_AVX2(6)
+    LOAD16X16_AVX2(7)
+    NEXT16ROWS(0x10)
+    TRANSPOSE8X8_LANES(ymm)
+    STOREUV16_AVX2(0)
+    STOREUV16_AVX2(12)
+    STOREUV16_AVX2(1)
+    STOREUV16_AVX2(13)
+    STOREUV16_AVX2(8)
+    STOREUV16_AVX2(14)
+    STOREUV16_AVX2(3)
+    STOREUV16_AVX2(15)
+      "sub         $0x8,%[width]                 \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+  : [src]"+r"(src),    // %[src]
+    [dst_a]"+r"(dst_a),    // %[dst_a]
+    [dst_b]"+r"(dst_b),    // %[dst_b]
+    [width]"+r"(width)    // %[width]
+  : [src_stride]"r"((intptr_t)(src_stride)),    // %[src_stride]
+    [dst_stride_a]"r"((intptr_t)(dst_stride_a)),    // %[dst_stride_a]
+    [dst_stride_b]"r"((intptr_t)(dst_stride_b))    // %[dst_stride_b]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+    "xmm15");
+  // clang-format on
+}
+#endif  // defined(HAS_TRANSPOSEUVWX16_AVX2)
+
+// Transpose UV 16x16. 64 bit
+#if defined(HAS_TRANSPOSEUVWX16_AVX512BW)
+void TransposeUVWx16_AVX512BW(const uint8_t* src,
+                              int src_stride,
+                              uint8_t* dst_a,
+                              int dst_stride_a,
+                              uint8_t* dst_b,
+                              int dst_stride_b,
+                              int width) {
+  // clang-format off
+  asm volatile(
+    LABELALIGN
+      "1:                                        \n"
+    LOAD16X32_AVX512BW(0)
+    LOAD16X32_AVX512BW(1)
+    LOAD16X32_AVX512BW(2)
+    LOAD16X32_AVX512BW(3)
+    LOAD16X32_AVX512BW(4)
+    LOAD16X32_AVX512BW(5)
+    LOAD16X32_AVX512BW(6)
+    LOAD16X32_AVX512BW(7)
+    NEXT16ROWS(0x20)
+    TRANSPOSE8X8_LANES(zmm)
+    STOREUV16X2_AVX512BW(0)
+    STOREUV16X2_AVX512BW(12)
+    STOREUV16X2_AVX512BW(1)
+    STOREUV16X2_AVX512BW(13)
+    STOREUV16X2_AVX512BW(8)
+    STOREUV16X2_AVX512BW(14)
+    STOREUV16X2_AVX512BW(3)
+    STOREUV16X2_AVX512BW(15)
+      "lea         (%[dst_a],%[dst_stride_a],8),%[dst_a] \n"
+      "lea         (%[dst_b],%[dst_stride_b],8),%[dst_b] \n"
+      "sub         $0x10,%[width]                \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+  : [src]"+r"(src),    // %[src]
+    [dst_a]"+r"(dst_a),    // %[dst_a]
+    [dst_b]"+r"(dst_b),    // %[dst_b]
+    [width]"+r"(width)    // %[width]
+  : [src_stride]"r"((intptr_t)(src_stride)),    // %[src_stride]
+    [dst_stride_a]"r"((intptr_t)(dst_stride_a)),    // %[dst_stride_a]
+    [dst_stride_b]"r"((intptr_t)(dst_stride_b))    // %[dst_stride_b]
+  : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+    "xmm7", "xmm8", "xmm9", "xmm10", "xmm11", "xmm12", "xmm13", "xmm14",
+    "xmm15");
+  // clang-format on
+}
+#endif  // defined(HAS_TRANSPOSEUVWX16_AVX512BW)
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
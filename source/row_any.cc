@@ -374,6 +374,9 @@ ANY31C(I422ToRGB24Row_Any_AVX2, I422ToRGB24Row_AVX2, 1, 0, 3, 31)
 #ifdef HAS_I422TOARGBROW_AVX2
 ANY31C(I422ToARGBRow_Any_AVX2, I422ToARGBRow_AVX2, 1, 0, 4, 15)
 #endif
+#ifdef HAS_I422TOARGBROW_AVX512BW
+ANY31C(I422ToARGBRow_Any_AVX512BW, I422ToARGBRow_AVX512BW, 1, 0, 4, 31)
+#endif
 #ifdef HAS_I422TORGBAROW_AVX2
 ANY31C(I422ToRGBARow_Any_AVX2, I422ToRGBARow_AVX2, 1, 0, 4, 15)
 #endif
@@ -480,6 +483,33 @@ ANY31CT(I212ToAR30Row_Any_AVX2, I212ToAR30Row_AVX2, 1, 0, uint16_t, 2, 4, 15)
 #endif
 #undef ANY31CT
 
+// Any 3 planes of 10 bit YUV to tone mapped ARGB.
+#ifdef HAS_I210TOARGBTONEMAPROW_AVX2
+void I210ToARGBToneMapRow_Any_AVX2(const uint16_t* y_buf,
+                                   const uint16_t* u_buf,
+                                   const uint16_t* v_buf,
+                                   uint8_t* dst_ptr,
+                                   const struct YuvConstants* yuvconstants,
+                                   const struct ToneMapConstants* tonemap,
+                                   int width) {
+  SIMD_ALIGNED(uint16_t temp[16 * 3]);
+  SIMD_ALIGNED(uint8_t out[64]);
+  memset(temp, 0, 16 * 3 * 2); /* for msan */
+  int r = width & 15;
+  int n = width & ~15;
+  if (n > 0) {
+    I210ToARGBToneMapRow_AVX2(y_buf, u_buf, v_buf, dst_ptr, yuvconstants,
+                              tonemap, n);
+  }
+  memcpy(temp, y_buf + n, r * 2);
+  memcpy(temp + 16, u_buf + (n >> 1), SS(r, 1) * 2);
+  memcpy(temp + 32, v_buf + (n >> 1), SS(r, 1) * 2);
+  I210ToARGBToneMapRow_AVX2(temp, temp + 16, temp + 32, out, yuvconstants,
+                            tonemap, 16);
+  memcpy(dst_ptr + n * 4, out, r * 4);
+}
+#endif
+
 // Any 3 planes to 1 plane with parameter
 #define ANY31PT(NAMEANY, ANY_SIMD, STYPE, SBPP, DTYPE, BPP, MASK)          \
   void NAMEANY(const STYPE* r_buf, const STYPE* g_buf, const STYPE* b_buf, \
@@ -693,6 +723,9 @@ ANY21C(NV12ToARGBRow_Any_SSSE3, NV12ToARGBRow_SSSE3, 1, 1, 2, 4, 7)
 #ifdef HAS_NV12TOARGBROW_AVX2
 ANY21C(NV12ToARGBRow_Any_AVX2, NV12ToARGBRow_AVX2, 1, 1, 2, 4, 15)
 #endif
+#ifdef HAS_NV12TOARGBROW_AVX512BW
+ANY21C(NV12ToARGBRow_Any_AVX512BW, NV12ToARGBRow_AVX512BW, 1, 1, 2, 4, 31)
+#endif
 #ifdef HAS_NV12TOARGBROW_NEON
 ANY21C(NV12ToARGBRow_Any_NEON, NV12ToARGBRow_NEON, 1, 1, 2, 4, 7)
 #endif
@@ -803,6 +836,30 @@ ANY21CT(P410ToAR30Row_Any_AVX2, P410ToAR30Row_AVX2, 0, 0, uint16_t, 2, 4, 15)
 
 #undef ANY21CT
 
+// Any biplanar 10 bit YUV to tone mapped ARGB.
+#ifdef HAS_P210TOARGBTONEMAPROW_AVX2
+void P210ToARGBToneMapRow_Any_AVX2(const uint16_t* y_buf,
+                                   const uint16_t* uv_buf,
+                                   uint8_t* dst_ptr,
+                                   const struct YuvConstants* yuvconstants,
+                                   const struct ToneMapConstants* tonemap,
+                                   int width) {
+  SIMD_ALIGNED(uint16_t temp[16 * 3]);
+  SIMD_ALIGNED(uint8_t out[64]);
+  memset(temp, 0, 16 * 3 * 2); /* for msan */
+  int r = width & 15;
+  int n = width & ~15;
+  if (n > 0) {
+    P210ToARGBToneMapRow_AVX2(y_buf, uv_buf, dst_ptr, yuvconstants, tonemap,
+                              n);
+  }
+  memcpy(temp, y_buf + n, r * 2);
+  memcpy(temp + 16, uv_buf + 2 * (n >> 1), SS(r, 1) * 2 * 2);
+  P210ToARGBToneMapRow_AVX2(temp, temp + 16, out, yuvconstants, tonemap, 16);
+  memcpy(dst_ptr + n * 4, out, r * 4);
+}
+#endif
+
 // Any 2 16 bit planes with parameter to 1
 #define ANY21PT(NAMEANY, ANY_SIMD, T, BPP, MASK)                     \
   void NAMEANY(const T* src_u, const T* src_v, T* dst_uv, int depth, \
@@ -952,12 +1009,21 @@ ANY11(RAWToRGB24Row_Any_MMI, RAWToRGB24Row_MMI, 0, 3, 3, 3)
 #ifdef HAS_ARGBTOYROW_AVX2
 ANY11(ARGBToYRow_Any_AVX2, ARGBToYRow_AVX2, 0, 4, 1, 31)
 #endif
+#ifdef HAS_ARGBTOYROW_AVX512BW
+ANY11(ARGBToYRow_Any_AVX512BW, ARGBToYRow_AVX512BW, 0, 4, 1, 31)
+#endif
 #ifdef HAS_ABGRTOYROW_AVX2
 ANY11(ABGRToYRow_Any_AVX2, ABGRToYRow_AVX2, 0, 4, 1, 31)
 #endif
 #ifdef HAS_ARGBTOYJROW_AVX2
 ANY11(ARGBToYJRow_Any_AVX2, ARGBToYJRow_AVX2, 0, 4, 1, 31)
 #endif
+#ifdef HAS_ARGBTOYHROW_SSSE3
+ANY11(ARGBToYHRow_Any_SSSE3, ARGBToYHRow_SSSE3, 0, 4, 1, 15)
+#endif
+#ifdef HAS_ARGBTOYHROW_AVX2
+ANY11(ARGBToYHRow_Any_AVX2, ARGBToYHRow_AVX2, 0, 4, 1, 31)
+#endif
 #ifdef HAS_RGBATOYJROW_AVX2
 ANY11(RGBAToYJRow_Any_AVX2, RGBAToYJRow_AVX2, 0, 4, 1, 31)
 #endif
@@ -1034,6 +1100,12 @@ ANY11(RGBAToYRow_Any_MMI, RGBAToYRow_MMI, 0, 4, 1, 7)
 #ifdef HAS_RGB24TOYROW_NEON
 ANY11(RGB24ToYRow_Any_NEON, RGB24ToYRow_NEON, 0, 3, 1, 7)
 #endif
+#ifdef HAS_RGB24TOYROW_AVX2
+ANY11(RGB24ToYRow_Any_AVX2, RGB24ToYRow_AVX2, 0, 3, 1, 31)
+#endif
+#ifdef HAS_RGB24TOYROW_SSSE3
+ANY11(RGB24ToYRow_Any_SSSE3, RGB24ToYRow_SSSE3, 0, 3, 1, 15)
+#endif
 #ifdef HAS_RGB24TOYJROW_AVX2
 ANY11(RGB24ToYJRow_Any_AVX2, RGB24ToYJRow_AVX2, 0, 3, 1, 31)
 #endif
@@ -1052,6 +1124,12 @@ ANY11(RGB24ToYRow_Any_MMI, RGB24ToYRow_MMI, 0, 3, 1, 7)
 #ifdef HAS_RAWTOYROW_NEON
 ANY11(RAWToYRow_Any_NEON, RAWToYRow_NEON, 0, 3, 1, 7)
 #endif
+#ifdef HAS_RAWTOYROW_AVX2
+ANY11(RAWToYRow_Any_AVX2, RAWToYRow_AVX2, 0, 3, 1, 31)
+#endif
+#ifdef HAS_RAWTOYROW_SSSE3
+ANY11(RAWToYRow_Any_SSSE3, RAWToYRow_SSSE3, 0, 3, 1, 15)
+#endif
 #ifdef HAS_RAWTOYJROW_AVX2
 ANY11(RAWToYJRow_Any_AVX2, RAWToYJRow_AVX2, 0, 3, 1, 31)
 #endif
@@ -1421,8 +1499,38 @@ ANY11T(AR64ToARGBRow_Any_NEON, AR64ToARGBRow_NEON, 8, 4, uint16_t, uint8_t, 7)
 ANY11T(AB64ToARGBRow_Any_NEON, AB64ToARGBRow_NEON, 8, 4, uint16_t, uint8_t, 7)
 #endif
 
+#ifdef HAS_FLOATTOHALFROW_AVX2
+ANY11T(FloatToHalfRow_Any_AVX2, FloatToHalfRow_AVX2, 4, 2, float, uint16_t, 15)
+#endif
+
 #undef ANY11T
 
+// Any 1 to 1 with a parameter, from bytes to floats.
+#define ANY11PF(NAMEANY, ANY_SIMD, T, SBPP, BPP, MASK)                       \
+  void NAMEANY(const uint8_t* src_ptr, float* dst_ptr, T param, int width) { \
+    SIMD_ALIGNED(uint8_t temp[(MASK + 1) * SBPP]);                           \
+    SIMD_ALIGNED(float out[(MASK + 1) * BPP]);                               \
+    memset(temp, 0, (MASK + 1) * SBPP); /* for msan */                       \
+    int r = width & MASK;                                                    \
+    int n = width & ~MASK;                                                   \
+    if (n > 0) {                                                             \
+      ANY_SIMD(src_ptr, dst_ptr, param, n);                                  \
+    }                                                                        \
+    memcpy(temp, src_ptr + n * SBPP, r * SBPP);                              \
+    ANY_SIMD(temp, out, param, MASK + 1);                                    \
+    memcpy(dst_ptr + n * BPP, out, r * BPP * sizeof(float));                 \
+  }
+
+#ifdef HAS_RAWTOFLOATROW_AVX2
+ANY11PF(RAWToFloatRow_Any_AVX2,
+        RAWToFloatRow_AVX2,
+        const struct RGBNormConstants*,
+        3,
+        3,
+        7)
+#endif
+#undef ANY11PF
+
 // Any 1 to 1 with parameter and shorts.  BPP measures in shorts.
 #define ANY11C(NAMEANY, ANY_SIMD, SBPP, BPP, STYPE, DTYPE, MASK)             \
   void NAMEANY(const STYPE* src_ptr, DTYPE* dst_ptr, int scale, int width) { \
@@ -1622,6 +1730,36 @@ ANY11I(InterpolateRow_Any_MMI, InterpolateRow_MMI, 1, 1, 7)
 #endif
 #undef ANY11I
 
+// Any 1 to 1 interpolate for 16 bit pixels.  Stride is in uint16_t.
+#define ANY11I16(NAMEANY, ANY_SIMD, MASK)                                   \
+  void NAMEANY(uint16_t* dst_ptr, const uint16_t* src_ptr,                  \
+               ptrdiff_t src_stride, int width, int source_y_fraction) {    \
+    SIMD_ALIGNED(uint16_t temp[32 * 3]);                                    \
+    memset(temp, 0, 32 * 2 * 2); /* for msan */                             \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(dst_ptr, src_ptr, src_stride, n, source_y_fraction);         \
+    }                                                                       \
+    memcpy(temp, src_ptr + n, r * 2);                                       \
+    if (source_y_fraction) {                                                \
+      memcpy(temp + 32, src_ptr + src_stride + n, r * 2);                   \
+    }                                                                       \
+    ANY_SIMD(temp + 64, temp, 32, MASK + 1, source_y_fraction);             \
+    memcpy(dst_ptr + n, temp + 64, r * 2);                                  \
+  }
+
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+ANY11I16(InterpolateRow_16_Any_AVX2, InterpolateRow_16_AVX2, 15)
+#endif
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+ANY11I16(InterpolateRow_16_Any_SSE2, InterpolateRow_16_SSE2, 7)
+#endif
+#ifdef HAS_INTERPOLATEROW_16_NEON
+ANY11I16(InterpolateRow_16_Any_NEON, InterpolateRow_16_NEON, 7)
+#endif
+#undef ANY11I16
+
 // Any 1 to 1 mirror.
 #define ANY11M(NAMEANY, ANY_SIMD, BPP, MASK)                              \
   void NAMEANY(const uint8_t* src_ptr, uint8_t* dst_ptr, int width) {     \
@@ -1822,6 +1960,35 @@ ANY12PT(SplitUVRow_16_Any_NEON, SplitUVRow_16_NEON, uint16_t, 2, 7)
     memcpy(dst_b + n, temp + 16 * 5, r);                                   \
   }
 
+// Any 1 to 3 float planes with a parameter.
+#define ANY13PF(NAMEANY, ANY_SIMD, T, BPP, MASK)                       \
+  void NAMEANY(const uint8_t* src_ptr, float* dst_r, float* dst_g,     \
+               float* dst_b, T param, int width) {                     \
+    SIMD_ALIGNED(uint8_t temp[(MASK + 1) * BPP]);                      \
+    SIMD_ALIGNED(float out[(MASK + 1) * 3]);                           \
+    memset(temp, 0, (MASK + 1) * BPP); /* for msan */                  \
+    int r = width & MASK;                                              \
+    int n = width & ~MASK;                                             \
+    if (n > 0) {                                                       \
+      ANY_SIMD(src_ptr, dst_r, dst_g, dst_b, param, n);                \
+    }                                                                  \
+    memcpy(temp, src_ptr + n * BPP, r * BPP);                          \
+    ANY_SIMD(temp, out, out + (MASK + 1), out + (MASK + 1) * 2, param, \
+             MASK + 1);                                                \
+    memcpy(dst_r + n, out, r * sizeof(float));                         \
+    memcpy(dst_g + n, out + (MASK + 1), r * sizeof(float));            \
+    memcpy(dst_b + n, out + (MASK + 1) * 2, r * sizeof(float));        \
+  }
+
+#ifdef HAS_ARGBTORGBFLOATROW_AVX2
+ANY13PF(ARGBToRGBFloatRow_Any_AVX2,
+        ARGBToRGBFloatRow_AVX2,
+        const struct RGBNormConstants*,
+        4,
+        7)
+#endif
+#undef ANY13PF
+
 #ifdef HAS_SPLITRGBROW_SSSE3
 ANY13(SplitRGBRow_Any_SSSE3, SplitRGBRow_SSSE3, 3, 15)
 #endif
@@ -1906,12 +2073,21 @@ ANY14(SplitARGBRow_Any_NEON, SplitARGBRow_NEON, 4, 15)
 #ifdef HAS_ARGBTOUVROW_AVX2
 ANY12S(ARGBToUVRow_Any_AVX2, ARGBToUVRow_AVX2, 0, 4, 31)
 #endif
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+ANY12S(ARGBToUVRow_Any_AVX512BW, ARGBToUVRow_AVX512BW, 0, 4, 31)
+#endif
 #ifdef HAS_ABGRTOUVROW_AVX2
 ANY12S(ABGRToUVRow_Any_AVX2, ABGRToUVRow_AVX2, 0, 4, 31)
 #endif
 #ifdef HAS_ARGBTOUVJROW_AVX2
 ANY12S(ARGBToUVJRow_Any_AVX2, ARGBToUVJRow_AVX2, 0, 4, 31)
 #endif
+#ifdef HAS_ARGBTOUVHROW_SSSE3
+ANY12S(ARGBToUVHRow_Any_SSSE3, ARGBToUVHRow_SSSE3, 0, 4, 15)
+#endif
+#ifdef HAS_ARGBTOUVHROW_AVX2
+ANY12S(ARGBToUVHRow_Any_AVX2, ARGBToUVHRow_AVX2, 0, 4, 31)
+#endif
 #ifdef HAS_ARGBTOUVROW_SSSE3
 ANY12S(ARGBToUVRow_Any_SSSE3, ARGBToUVRow_SSSE3, 0, 4, 15)
 ANY12S(ARGBToUVJRow_Any_SSSE3, ARGBToUVJRow_SSSE3, 0, 4, 15)
@@ -1975,6 +2151,12 @@ ANY12S(RGBAToUVRow_Any_MMI, RGBAToUVRow_MMI, 0, 4, 15)
 #ifdef HAS_RGB24TOUVROW_NEON
 ANY12S(RGB24ToUVRow_Any_NEON, RGB24ToUVRow_NEON, 0, 3, 15)
 #endif
+#ifdef HAS_RGB24TOUVROW_AVX2
+ANY12S(RGB24ToUVRow_Any_AVX2, RGB24ToUVRow_AVX2, 0, 3, 31)
+#endif
+#ifdef HAS_RGB24TOUVROW_SSSE3
+ANY12S(RGB24ToUVRow_Any_SSSE3, RGB24ToUVRow_SSSE3, 0, 3, 15)
+#endif
 #ifdef HAS_RGB24TOUVROW_MSA
 ANY12S(RGB24ToUVRow_Any_MSA, RGB24ToUVRow_MSA, 0, 3, 15)
 #endif
@@ -1984,6 +2166,12 @@ ANY12S(RGB24ToUVRow_Any_MMI, RGB24ToUVRow_MMI, 0, 3, 15)
 #ifdef HAS_RAWTOUVROW_NEON
 ANY12S(RAWToUVRow_Any_NEON, RAWToUVRow_NEON, 0, 3, 15)
 #endif
+#ifdef HAS_RAWTOUVROW_AVX2
+ANY12S(RAWToUVRow_Any_AVX2, RAWToUVRow_AVX2, 0, 3, 31)
+#endif
+#ifdef HAS_RAWTOUVROW_SSSE3
+ANY12S(RAWToUVRow_Any_SSSE3, RAWToUVRow_SSSE3, 0, 3, 15)
+#endif
 #ifdef HAS_RAWTOUVROW_MSA
 ANY12S(RAWToUVRow_Any_MSA, RAWToUVRow_MSA, 0, 3, 15)
 #endif
@@ -2065,6 +2253,55 @@ ANY11S(AYUVToVURow_Any_NEON, AYUVToVURow_NEON, 0, 4, 15)
 #endif
 #undef ANY11S
 
+// Any 1 to 1 of tiled rows.  The remainder is less than one 16 byte tile.
+#define ANYDETILE(NAMEANY, ANY_SIMD, MASK)                                  \
+  void NAMEANY(const uint8_t* src, ptrdiff_t src_tile_stride, uint8_t* dst, \
+               int width) {                                                 \
+    SIMD_ALIGNED(uint8_t temp[16 * 2]);                                     \
+    memset(temp, 0, 16); /* for msan */                                     \
+    int r = width & MASK;                                                   \
+    int n = width & ~MASK;                                                  \
+    if (n > 0) {                                                            \
+      ANY_SIMD(src, src_tile_stride, dst, n);                               \
+    }                                                                       \
+    memcpy(temp, src + (n / 16) * src_tile_stride, r);                      \
+    ANY_SIMD(temp, src_tile_stride, temp + 16, MASK + 1);                   \
+    memcpy(dst + n, temp + 16, r);                                          \
+  }
+
+#ifdef HAS_DETILEROW_NEON
+ANYDETILE(DetileRow_Any_NEON, DetileRow_NEON, 15)
+#endif
+#ifdef HAS_DETILEROW_SSE2
+ANYDETILE(DetileRow_Any_SSE2, DetileRow_SSE2, 15)
+#endif
+#undef ANYDETILE
+
+// Any 1 to 2 of tiled UV rows.  width is in bytes of UV.
+#define ANYDETILESPLITUV(NAMEANY, ANY_SIMD, MASK)                          \
+  void NAMEANY(const uint8_t* src_uv, ptrdiff_t src_tile_stride,           \
+               uint8_t* dst_u, uint8_t* dst_v, int width) {                \
+    SIMD_ALIGNED(uint8_t temp[16 * 2]);                                    \
+    memset(temp, 0, 16 * 2); /* for msan */                                \
+    int r = width & MASK;                                                  \
+    int n = width & ~MASK;                                                 \
+    if (n > 0) {                                                           \
+      ANY_SIMD(src_uv, src_tile_stride, dst_u, dst_v, n);                  \
+    }                                                                      \
+    memcpy(temp, src_uv + (n / 16) * src_tile_stride, r);                  \
+    ANY_SIMD(temp, src_tile_stride, temp + 16, temp + 24, MASK + 1);       \
+    memcpy(dst_u + n / 2, temp + 16, (r + 1) / 2);                         \
+    memcpy(dst_v + n / 2, temp + 24, (r + 1) / 2);                         \
+  }
+
+#ifdef HAS_DETILESPLITUVROW_NEON
+ANYDETILESPLITUV(DetileSplitUVRow_Any_NEON, DetileSplitUVRow_NEON, 15)
+#endif
+#ifdef HAS_DETILESPLITUVROW_SSSE3
+ANYDETILESPLITUV(DetileSplitUVRow_Any_SSSE3, DetileSplitUVRow_SSSE3, 15)
+#endif
+#undef ANYDETILESPLITUV
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
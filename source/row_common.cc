@@ -16,6 +16,12 @@
 
 #include "libyuv/basic_types.h"
 #include "libyuv/convert_argb.h"  // For kYuvI601Constants
+#include "libyuv/cpu_id.h"        // For GetRowKernels
+#include "libyuv/scale_row.h"     // For ScaleFilterCols
+
+#if defined(_MSC_VER)
+#include <intrin.h>  // For _InterlockedCompareExchange and _mm_pause
+#endif
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -265,6 +271,36 @@ void AR30ToAB30Row_C(const uint8_t* src_ar30, uint8_t* dst_ab30, int width) {
   }
 }
 
+// Apply the BT.2020 to BT.709 matrix to tone mapped 14 bit linear RGB.
+// rg holds the R and G coefficients and ba the B coefficient and rounding.
+// Returns a 12 bit index into the gamma table.
+static __inline int ToneMapMatrix(int r,
+                                  int g,
+                                  int b,
+                                  const int16_t* rg,
+                                  const int16_t* ba) {
+  int v = (r * rg[0] + g * rg[1] + b * ba[0] + ba[1]) >> 14;
+  return v < 0 ? 0 : (v > 4096 ? 4096 : v);
+}
+
+// Tone map one pixel of 10 bit B, G and R to ARGB.
+static __inline void ToneMapPixel(uint32_t b10,
+                                  uint32_t g10,
+                                  uint32_t r10,
+                                  uint8_t* dst_argb,
+                                  const struct ToneMapConstants* tonemap) {
+  int b = tonemap->kLinear[b10];
+  int g = tonemap->kLinear[g10];
+  int r = tonemap->kLinear[r10];
+  dst_argb[0] = tonemap->kGamma[ToneMapMatrix(r, g, b, tonemap->kMatrix[4],
+                                              tonemap->kMatrix[5])];
+  dst_argb[1] = tonemap->kGamma[ToneMapMatrix(r, g, b, tonemap->kMatrix[2],
+                                              tonemap->kMatrix[3])];
+  dst_argb[2] = tonemap->kGamma[ToneMapMatrix(r, g, b, tonemap->kMatrix[0],
+                                              tonemap->kMatrix[1])];
+  dst_argb[3] = 255u;
+}
+
 void ARGBToRGB24Row_C(const uint8_t* src_argb, uint8_t* dst_rgb, int width) {
   int x;
   for (x = 0; x < width; ++x) {
@@ -637,6 +673,66 @@ MAKEROWY(RGB24, 2, 1, 0, 3)
 MAKEROWY(RAW, 0, 1, 2, 3)
 #undef MAKEROWY
 
+// BT.709 limited range, used for HDR to SDR conversion.
+static __inline int RGBToYH(uint8_t r, uint8_t g, uint8_t b) {
+  return (47 * r + 157 * g + 16 * b + 0x1080) >> 8;
+}
+#ifdef LIBYUV_RGBTOU_TRUNCATE
+static __inline int RGBToUH(uint8_t r, uint8_t g, uint8_t b) {
+  return (112 * b - 86 * g - 26 * r + 0x8000) >> 8;
+}
+static __inline int RGBToVH(uint8_t r, uint8_t g, uint8_t b) {
+  return (112 * r - 102 * g - 10 * b + 0x8000) >> 8;
+}
+#else
+static __inline int RGBToUH(uint8_t r, uint8_t g, uint8_t b) {
+  return (112 * b - 86 * g - 26 * r + 0x8080) >> 8;
+}
+static __inline int RGBToVH(uint8_t r, uint8_t g, uint8_t b) {
+  return (112 * r - 102 * g - 10 * b + 0x8080) >> 8;
+}
+#endif
+
+void ARGBToYHRow_C(const uint8_t* src_rgb, uint8_t* dst_y, int width) {
+  int x;
+  for (x = 0; x < width; ++x) {
+    dst_y[0] = RGBToYH(src_rgb[2], src_rgb[1], src_rgb[0]);
+    src_rgb += 4;
+    dst_y += 1;
+  }
+}
+
+// Averages the same way as the SSSE3 and AVX2 versions, with 2 pavgb.
+void ARGBToUVHRow_C(const uint8_t* src_rgb,
+                    int src_stride_rgb,
+                    uint8_t* dst_u,
+                    uint8_t* dst_v,
+                    int width) {
+  const uint8_t* src_rgb1 = src_rgb + src_stride_rgb;
+  int x;
+  for (x = 0; x < width - 1; x += 2) {
+    uint8_t ab = AVGB(AVGB(src_rgb[0], src_rgb1[0]),
+                      AVGB(src_rgb[4], src_rgb1[4]));
+    uint8_t ag = AVGB(AVGB(src_rgb[1], src_rgb1[1]),
+                      AVGB(src_rgb[5], src_rgb1[5]));
+    uint8_t ar = AVGB(AVGB(src_rgb[2], src_rgb1[2]),
+                      AVGB(src_rgb[6], src_rgb1[6]));
+    dst_u[0] = RGBToUH(ar, ag, ab);
+    dst_v[0] = RGBToVH(ar, ag, ab);
+    src_rgb += 8;
+    src_rgb1 += 8;
+    dst_u += 1;
+    dst_v += 1;
+  }
+  if (width & 1) {
+    uint8_t ab = AVGB(src_rgb[0], src_rgb1[0]);
+    uint8_t ag = AVGB(src_rgb[1], src_rgb1[1]);
+    uint8_t ar = AVGB(src_rgb[2], src_rgb1[2]);
+    dst_u[0] = RGBToUH(ar, ag, ab);
+    dst_v[0] = RGBToVH(ar, ag, ab);
+  }
+}
+
 // JPeg uses a variation on BT.601-1 full range
 // y =  0.29900 * r + 0.58700 * g + 0.11400 * b
 // u = -0.16874 * r - 0.33126 * g + 0.50000 * b  + center
@@ -2137,6 +2233,51 @@ void P210ToAR30Row_C(const uint16_t* src_y,
   }
 }
 
+// 10 bit YUV to tone mapped ARGB.  The RGB is clamped to 10 bits as for
+// AR30 and then mapped through the ToneMapConstants tables.
+void I210ToARGBToneMapRow_C(const uint16_t* src_y,
+                            const uint16_t* src_u,
+                            const uint16_t* src_v,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            const struct ToneMapConstants* tonemap,
+                            int width) {
+  int x;
+  int b;
+  int g;
+  int r;
+  for (x = 0; x < width; ++x) {
+    YuvPixel10_16(src_y[0], src_u[0], src_v[0], &b, &g, &r, yuvconstants);
+    ToneMapPixel(Clamp10(b >> 4), Clamp10(g >> 4), Clamp10(r >> 4), dst_argb,
+                 tonemap);
+    src_y += 1;
+    src_u += x & 1;
+    src_v += x & 1;
+    dst_argb += 4;
+  }
+}
+
+// P210 to tone mapped ARGB.
+void P210ToARGBToneMapRow_C(const uint16_t* src_y,
+                            const uint16_t* src_uv,
+                            uint8_t* dst_argb,
+                            const struct YuvConstants* yuvconstants,
+                            const struct ToneMapConstants* tonemap,
+                            int width) {
+  int x;
+  int b;
+  int g;
+  int r;
+  for (x = 0; x < width; ++x) {
+    YuvPixel16_16(src_y[0], src_uv[0], src_uv[1], &b, &g, &r, yuvconstants);
+    ToneMapPixel(Clamp10(b >> 4), Clamp10(g >> 4), Clamp10(r >> 4), dst_argb,
+                 tonemap);
+    src_y += 1;
+    src_uv += (x & 1) * 2;
+    dst_argb += 4;
+  }
+}
+
 void P410ToAR30Row_C(const uint16_t* src_y,
                      const uint16_t* src_uv,
                      uint8_t* dst_ar30,
@@ -2656,6 +2797,41 @@ void RGB24MirrorRow_C(const uint8_t* src_rgb24, uint8_t* dst_rgb24, int width) {
   }
 }
 
+// Copy a row of a tiled image.  Tiles are 16 bytes wide and
+// src_tile_stride is the number of bytes from one tile to the next.
+void DetileRow_C(const uint8_t* src,
+                 ptrdiff_t src_tile_stride,
+                 uint8_t* dst,
+                 int width) {
+  int x;
+  for (x = 0; x < width - 15; x += 16) {
+    memcpy(dst, src, 16);
+    dst += 16;
+    src += src_tile_stride;
+  }
+  if (width & 15) {
+    memcpy(dst, src, width & 15);
+  }
+}
+
+// Same as DetileRow_C for interleaved UV.  width is in bytes of UV.
+void DetileSplitUVRow_C(const uint8_t* src_uv,
+                        ptrdiff_t src_tile_stride,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width) {
+  int x;
+  for (x = 0; x < width - 15; x += 16) {
+    SplitUVRow_C(src_uv, dst_u, dst_v, 8);
+    dst_u += 8;
+    dst_v += 8;
+    src_uv += src_tile_stride;
+  }
+  if (width & 15) {
+    SplitUVRow_C(src_uv, dst_u, dst_v, ((width & 15) + 1) / 2);
+  }
+}
+
 void SplitUVRow_C(const uint8_t* src_uv,
                   uint8_t* dst_u,
                   uint8_t* dst_v,
@@ -3562,6 +3738,47 @@ void ByteToFloatRow_C(const uint8_t* src, float* dst, float scale, int width) {
   }
 }
 
+void ARGBToRGBFloatRow_C(const uint8_t* src_argb,
+                         float* dst_r,
+                         float* dst_g,
+                         float* dst_b,
+                         const struct RGBNormConstants* norm,
+                         int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    dst_r[i] = src_argb[2] * norm->kScale[0] + norm->kBias[0];
+    dst_g[i] = src_argb[1] * norm->kScale[1] + norm->kBias[1];
+    dst_b[i] = src_argb[0] * norm->kScale[2] + norm->kBias[2];
+    src_argb += 4;
+  }
+}
+
+void RAWToFloatRow_C(const uint8_t* src_raw,
+                     float* dst,
+                     const struct RGBNormConstants* norm,
+                     int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    dst[0] = src_raw[0] * norm->kScale[0] + norm->kBias[0];
+    dst[1] = src_raw[1] * norm->kScale[1] + norm->kBias[1];
+    dst[2] = src_raw[2] * norm->kScale[2] + norm->kBias[2];
+    src_raw += 3;
+    dst += 3;
+  }
+}
+
+// Same magic constant as HalfFloatRow_C, applied to the magnitude.
+void FloatToHalfRow_C(const float* src, uint16_t* dst, int width) {
+  int i;
+  for (i = 0; i < width; ++i) {
+    float value = src[i];
+    uint16_t sign = (uint16_t)((*(const uint32_alias_t*)&value >> 16) & 0x8000);
+    value = value < 0.f ? -value : value;
+    value = (value < 65504.f ? value : 65504.f) * 1.9259299444e-34f;
+    dst[i] = sign | (uint16_t)((*(const uint32_alias_t*)&value) >> 13);
+  }
+}
+
 void ARGBLumaColorTableRow_C(const uint8_t* src_argb,
                              uint8_t* dst_argb,
                              int width,
@@ -4206,6 +4423,401 @@ void HalfMergeUVRow_C(const uint8_t* src_u,
   }
 }
 
+// Sets the row kernels for cpu_info, with the same choices the conversions
+// made by testing the CPU flags on each call.
+static void InitRowKernels(struct RowKernels* kernels, int cpu_info) {
+  kernels->I422ToARGBRow = I422ToARGBRow_C;
+  kernels->I422ToARGBRow_Any = I422ToARGBRow_C;
+  kernels->I422ToARGBRow_Align = 1;
+  kernels->I422ToARGBRow_Cpu = 0;
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    kernels->I422ToARGBRow = I422ToARGBRow_SSSE3;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_SSSE3;
+    kernels->I422ToARGBRow_Align = 8;
+    kernels->I422ToARGBRow_Cpu = kCpuHasSSSE3;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    kernels->I422ToARGBRow = I422ToARGBRow_AVX2;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_AVX2;
+    kernels->I422ToARGBRow_Align = 16;
+    kernels->I422ToARGBRow_Cpu = kCpuHasAVX2;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    kernels->I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_AVX512BW;
+    kernels->I422ToARGBRow_Align = 32;
+    kernels->I422ToARGBRow_Cpu = kCpuHasAVX512BW;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    kernels->I422ToARGBRow = I422ToARGBRow_NEON;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_NEON;
+    kernels->I422ToARGBRow_Align = 8;
+    kernels->I422ToARGBRow_Cpu = kCpuHasNEON;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_MMI)
+  if (cpu_info & kCpuHasMMI) {
+    kernels->I422ToARGBRow = I422ToARGBRow_MMI;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_MMI;
+    kernels->I422ToARGBRow_Align = 4;
+    kernels->I422ToARGBRow_Cpu = kCpuHasMMI;
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_MSA)
+  if (cpu_info & kCpuHasMSA) {
+    kernels->I422ToARGBRow = I422ToARGBRow_MSA;
+    kernels->I422ToARGBRow_Any = I422ToARGBRow_Any_MSA;
+    kernels->I422ToARGBRow_Align = 8;
+    kernels->I422ToARGBRow_Cpu = kCpuHasMSA;
+  }
+#endif
+
+  kernels->NV12ToARGBRow = NV12ToARGBRow_C;
+  kernels->NV12ToARGBRow_Any = NV12ToARGBRow_C;
+  kernels->NV12ToARGBRow_Align = 1;
+  kernels->NV12ToARGBRow_Cpu = 0;
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_SSSE3;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_SSSE3;
+    kernels->NV12ToARGBRow_Align = 8;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasSSSE3;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_AVX2;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_AVX2;
+    kernels->NV12ToARGBRow_Align = 16;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasAVX2;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_AVX512BW;
+    kernels->NV12ToARGBRow_Align = 32;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasAVX512BW;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_NEON;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_NEON;
+    kernels->NV12ToARGBRow_Align = 8;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasNEON;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MMI)
+  if (cpu_info & kCpuHasMMI) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_MMI;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_MMI;
+    kernels->NV12ToARGBRow_Align = 4;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasMMI;
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MSA)
+  if (cpu_info & kCpuHasMSA) {
+    kernels->NV12ToARGBRow = NV12ToARGBRow_MSA;
+    kernels->NV12ToARGBRow_Any = NV12ToARGBRow_Any_MSA;
+    kernels->NV12ToARGBRow_Align = 8;
+    kernels->NV12ToARGBRow_Cpu = kCpuHasMSA;
+  }
+#endif
+
+  kernels->ARGBToYRow = ARGBToYRow_C;
+  kernels->ARGBToYRow_Any = ARGBToYRow_C;
+  kernels->ARGBToYRow_Align = 1;
+  kernels->ARGBToYRow_Cpu = 0;
+  kernels->ARGBToUVRow = ARGBToUVRow_C;
+  kernels->ARGBToUVRow_Any = ARGBToUVRow_C;
+  kernels->ARGBToUVRow_Align = 1;
+  kernels->ARGBToUVRow_Cpu = 0;
+#if defined(HAS_ARGBTOYROW_NEON) && defined(HAS_ARGBTOUVROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    kernels->ARGBToYRow = ARGBToYRow_NEON;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_NEON;
+    kernels->ARGBToYRow_Align = 8;
+    kernels->ARGBToYRow_Cpu = kCpuHasNEON;
+    kernels->ARGBToUVRow = ARGBToUVRow_NEON;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_NEON;
+    kernels->ARGBToUVRow_Align = 16;
+    kernels->ARGBToUVRow_Cpu = kCpuHasNEON;
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_SSSE3) && defined(HAS_ARGBTOUVROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    kernels->ARGBToYRow = ARGBToYRow_SSSE3;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_SSSE3;
+    kernels->ARGBToYRow_Align = 16;
+    kernels->ARGBToYRow_Cpu = kCpuHasSSSE3;
+    kernels->ARGBToUVRow = ARGBToUVRow_SSSE3;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_SSSE3;
+    kernels->ARGBToUVRow_Align = 16;
+    kernels->ARGBToUVRow_Cpu = kCpuHasSSSE3;
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX2) && defined(HAS_ARGBTOUVROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    kernels->ARGBToYRow = ARGBToYRow_AVX2;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_AVX2;
+    kernels->ARGBToYRow_Align = 32;
+    kernels->ARGBToYRow_Cpu = kCpuHasAVX2;
+    kernels->ARGBToUVRow = ARGBToUVRow_AVX2;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_AVX2;
+    kernels->ARGBToUVRow_Align = 32;
+    kernels->ARGBToUVRow_Cpu = kCpuHasAVX2;
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_AVX512BW) && defined(HAS_ARGBTOUVROW_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    kernels->ARGBToYRow = ARGBToYRow_AVX512BW;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_AVX512BW;
+    kernels->ARGBToYRow_Align = 32;
+    kernels->ARGBToYRow_Cpu = kCpuHasAVX512BW;
+    kernels->ARGBToUVRow = ARGBToUVRow_AVX512BW;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_AVX512BW;
+    kernels->ARGBToUVRow_Align = 32;
+    kernels->ARGBToUVRow_Cpu = kCpuHasAVX512BW;
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_MMI) && defined(HAS_ARGBTOUVROW_MMI)
+  if (cpu_info & kCpuHasMMI) {
+    kernels->ARGBToYRow = ARGBToYRow_MMI;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_MMI;
+    kernels->ARGBToYRow_Align = 8;
+    kernels->ARGBToYRow_Cpu = kCpuHasMMI;
+    kernels->ARGBToUVRow = ARGBToUVRow_MMI;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_MMI;
+    kernels->ARGBToUVRow_Align = 16;
+    kernels->ARGBToUVRow_Cpu = kCpuHasMMI;
+  }
+#endif
+#if defined(HAS_ARGBTOYROW_MSA) && defined(HAS_ARGBTOUVROW_MSA)
+  if (cpu_info & kCpuHasMSA) {
+    kernels->ARGBToYRow = ARGBToYRow_MSA;
+    kernels->ARGBToYRow_Any = ARGBToYRow_Any_MSA;
+    kernels->ARGBToYRow_Align = 16;
+    kernels->ARGBToYRow_Cpu = kCpuHasMSA;
+    kernels->ARGBToUVRow = ARGBToUVRow_MSA;
+    kernels->ARGBToUVRow_Any = ARGBToUVRow_Any_MSA;
+    kernels->ARGBToUVRow_Align = 32;
+    kernels->ARGBToUVRow_Cpu = kCpuHasMSA;
+  }
+#endif
+
+  kernels->InterpolateRow = InterpolateRow_C;
+  kernels->InterpolateRow_Any = InterpolateRow_C;
+  kernels->InterpolateRow_Align = 1;
+  kernels->InterpolateRow_Cpu = 0;
+#if defined(HAS_INTERPOLATEROW_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    kernels->InterpolateRow = InterpolateRow_SSSE3;
+    kernels->InterpolateRow_Any = InterpolateRow_Any_SSSE3;
+    kernels->InterpolateRow_Align = 16;
+    kernels->InterpolateRow_Cpu = kCpuHasSSSE3;
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    kernels->InterpolateRow = InterpolateRow_AVX2;
+    kernels->InterpolateRow_Any = InterpolateRow_Any_AVX2;
+    kernels->InterpolateRow_Align = 32;
+    kernels->InterpolateRow_Cpu = kCpuHasAVX2;
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    kernels->InterpolateRow = InterpolateRow_NEON;
+    kernels->InterpolateRow_Any = InterpolateRow_Any_NEON;
+    kernels->InterpolateRow_Align = 16;
+    kernels->InterpolateRow_Cpu = kCpuHasNEON;
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_MMI)
+  if (cpu_info & kCpuHasMMI) {
+    kernels->InterpolateRow = InterpolateRow_MMI;
+    kernels->InterpolateRow_Any = InterpolateRow_Any_MMI;
+    kernels->InterpolateRow_Align = 16;
+    kernels->InterpolateRow_Cpu = kCpuHasMMI;
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_MSA)
+  if (cpu_info & kCpuHasMSA) {
+    kernels->InterpolateRow = InterpolateRow_MSA;
+    kernels->InterpolateRow_Any = InterpolateRow_Any_MSA;
+    kernels->InterpolateRow_Align = 32;
+    kernels->InterpolateRow_Cpu = kCpuHasMSA;
+  }
+#endif
+
+  kernels->ScaleFilterCols = ScaleFilterCols_C;
+  kernels->ScaleFilterCols_Any = ScaleFilterCols_C;
+  kernels->ScaleFilterCols_Align = 1;
+  kernels->ScaleFilterCols_Cpu = 0;
+  kernels->ScaleFilterCols64 = ScaleFilterCols64_C;
+#if defined(HAS_SCALEFILTERCOLS_SSSE3)
+  if (cpu_info & kCpuHasSSSE3) {
+    kernels->ScaleFilterCols = ScaleFilterCols_SSSE3;
+    kernels->ScaleFilterCols_Any = ScaleFilterCols_SSSE3;
+    kernels->ScaleFilterCols_Align = 1;
+    kernels->ScaleFilterCols_Cpu = kCpuHasSSSE3;
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_AVX2)
+  if (cpu_info & kCpuHasAVX2) {
+    kernels->ScaleFilterCols = ScaleFilterCols_AVX2;
+    kernels->ScaleFilterCols_Any = ScaleFilterCols_Any_AVX2;
+    kernels->ScaleFilterCols_Align = 8;
+    kernels->ScaleFilterCols_Cpu = kCpuHasAVX2;
+    kernels->ScaleFilterCols64 = ScaleFilterCols64_AVX2;
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_AVX512BW)
+  if (cpu_info & kCpuHasAVX512BW) {
+    kernels->ScaleFilterCols = ScaleFilterCols_AVX512BW;
+    kernels->ScaleFilterCols_Any = ScaleFilterCols_Any_AVX512BW;
+    kernels->ScaleFilterCols_Align = 16;
+    kernels->ScaleFilterCols_Cpu = kCpuHasAVX512BW;
+    kernels->ScaleFilterCols64 = ScaleFilterCols64_AVX512BW;
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_NEON)
+  if (cpu_info & kCpuHasNEON) {
+    kernels->ScaleFilterCols = ScaleFilterCols_NEON;
+    kernels->ScaleFilterCols_Any = ScaleFilterCols_Any_NEON;
+    kernels->ScaleFilterCols_Align = 8;
+    kernels->ScaleFilterCols_Cpu = kCpuHasNEON;
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_MSA)
+  if (cpu_info & kCpuHasMSA) {
+    kernels->ScaleFilterCols = ScaleFilterCols_MSA;
+    kernels->ScaleFilterCols_Any = ScaleFilterCols_Any_MSA;
+    kernels->ScaleFilterCols_Align = 16;
+    kernels->ScaleFilterCols_Cpu = kCpuHasMSA;
+  }
+#endif
+}
+
+// Tables are built once per set of CPU flags and never changed after they
+// are published, so threads can keep using a table while another thread
+// masks the flags.  A slot is claimed by setting state, filled, and then
+// published by a release store of cpu_info that readers load with acquire.
+#define kRowKernelsSlots 16
+struct RowKernelsSlot {
+  int state;     // 0 if free, 1 once claimed.
+  int cpu_info;  // The flags of the published table, or 0.
+  struct RowKernels kernels;
+};
+static struct RowKernelsSlot row_kernels_slots[kRowKernelsSlots];
+
+#ifdef __ATOMIC_RELAXED
+#define ROW_KERNELS_LOAD(var) __atomic_load_n(&(var), __ATOMIC_ACQUIRE)
+#define ROW_KERNELS_STORE(var, value) \
+  __atomic_store_n(&(var), value, __ATOMIC_RELEASE)
+static int RowKernelsClaim(int* state) {
+  int expected = 0;
+  return __atomic_compare_exchange_n(state, &expected, 1, 0, __ATOMIC_ACQ_REL,
+                                     __ATOMIC_ACQUIRE);
+}
+#elif defined(_MSC_VER)
+// Interlocked functions are full barriers on all Windows targets.
+#define ROW_KERNELS_LOAD(var) \
+  ((int)_InterlockedCompareExchange((long volatile*)&(var), 0, 0))
+#define ROW_KERNELS_STORE(var, value) \
+  _InterlockedExchange((long volatile*)&(var), (long)(value))
+static int RowKernelsClaim(int* state) {
+  return _InterlockedCompareExchange((long volatile*)state, 1, 0) == 0;
+}
+#else
+// No atomics available.  Only correct if one thread calls GetRowKernels.
+#define ROW_KERNELS_LOAD(var) (*(volatile int*)&(var))
+#define ROW_KERNELS_STORE(var, value) (*(volatile int*)&(var)) = (value)
+static int RowKernelsClaim(int* state) {
+  if (*state) {
+    return 0;
+  }
+  *state = 1;
+  return 1;
+}
+#endif
+
+#if defined(__i386__) || defined(__x86_64__)
+#define ROW_KERNELS_PAUSE() __builtin_ia32_pause()
+#elif defined(_M_IX86) || defined(_M_X64)
+#define ROW_KERNELS_PAUSE() _mm_pause()
+#elif defined(_M_ARM) || defined(_M_ARM64)
+#define ROW_KERNELS_PAUSE() __yield()
+#else
+#define ROW_KERNELS_PAUSE()
+#endif
+
+// Used if more sets of flags are seen than there are slots.
+static const struct RowKernels kRowKernels_C = {
+    0,
+    I422ToARGBRow_C,
+    I422ToARGBRow_C,
+    1,
+    0,
+    NV12ToARGBRow_C,
+    NV12ToARGBRow_C,
+    1,
+    0,
+    ARGBToYRow_C,
+    ARGBToYRow_C,
+    1,
+    0,
+    ARGBToUVRow_C,
+    ARGBToUVRow_C,
+    1,
+    0,
+    InterpolateRow_C,
+    InterpolateRow_C,
+    1,
+    0,
+    ScaleFilterCols_C,
+    ScaleFilterCols_C,
+    1,
+    0,
+    ScaleFilterCols64_C,
+};
+
+const struct RowKernels* GetRowKernels(void) {
+  // All flags, including kCpuInitialized, so 0 is never published.
+  int cpu_info = TestCpuFlag(-1);
+  int i;
+  for (i = 0; i < kRowKernelsSlots; ++i) {
+    struct RowKernelsSlot* slot = &row_kernels_slots[i];
+    int slot_cpu_info = ROW_KERNELS_LOAD(slot->cpu_info);
+    if (!slot_cpu_info) {
+      if (RowKernelsClaim(&slot->state)) {
+        struct RowKernels kernels;
+        InitRowKernels(&kernels, cpu_info);
+        kernels.cpu_info = cpu_info;
+        slot->kernels = kernels;
+        ROW_KERNELS_STORE(slot->cpu_info, cpu_info);
+        return &slot->kernels;
+      }
+      // Another thread is filling this slot.  Wait for it to be published.
+      while (!(slot_cpu_info = ROW_KERNELS_LOAD(slot->cpu_info))) {
+        ROW_KERNELS_PAUSE();
+      }
+    }
+    if (slot_cpu_info == cpu_info) {
+      return &slot->kernels;
+    }
+  }
+  return &kRowKernels_C;
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -8,6 +8,7 @@
  *  be found in the AUTHORS file in the root of the source tree.
  */
 
+#include "libyuv/convert_argb.h"  // For struct ToneMapConstants.
 #include "libyuv/row.h"
 
 #ifdef __cplusplus
@@ -1443,6 +1444,55 @@ void ARGBToYRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width) {
 }
 #endif  // HAS_ARGBTOYROW_AVX2
 
+#ifdef HAS_ARGBTOYROW_AVX512BW
+// vpermq for vpackssdw.
+static const uvec8 kPermqARGBToY_AVX512 = {0, 2, 4, 6, 1, 3, 5, 7,
+                                           0, 0, 0, 0, 0, 0, 0, 0};
+
+// Convert 32 ARGB pixels (128 bytes) to 32 Y values.
+// There is no 512 bit vphaddw, so pairs are summed with vpmaddwd by 1 and
+// packed back to shorts, which is exact because the sums fit in 16 bits.
+void ARGBToYRow_AVX512BW(const uint8_t* src_argb, uint8_t* dst_y, int width) {
+  asm volatile(
+      "vbroadcasti32x4 %3,%%zmm4                 \n"
+      "vbroadcasti32x4 %4,%%zmm5                 \n"
+      "vbroadcasti32x4 %5,%%zmm7                 \n"
+      "vpmovzxbq   %6,%%zmm6                     \n"
+      "vpternlogd  $0xff,%%zmm3,%%zmm3,%%zmm3    \n"
+      "vpsrlw      $0xf,%%zmm3,%%zmm3            \n"  // 1
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "vmovdqu64   0x40(%0),%%zmm1               \n"
+      "vpsubb      %%zmm5,%%zmm0,%%zmm0          \n"
+      "vpsubb      %%zmm5,%%zmm1,%%zmm1          \n"
+      "vpmaddubsw  %%zmm0,%%zmm4,%%zmm0          \n"
+      "vpmaddubsw  %%zmm1,%%zmm4,%%zmm1          \n"
+      "vpmaddwd    %%zmm3,%%zmm0,%%zmm0          \n"
+      "vpmaddwd    %%zmm3,%%zmm1,%%zmm1          \n"
+      "lea         0x80(%0),%0                   \n"
+      "vpackssdw   %%zmm1,%%zmm0,%%zmm0          \n"  // mutates.
+      "vpaddw      %%zmm7,%%zmm0,%%zmm0          \n"
+      "vpsrlw      $0x8,%%zmm0,%%zmm0            \n"
+      "vpermq      %%zmm0,%%zmm6,%%zmm0          \n"  // unmutate.
+      "vpmovwb     %%zmm0,(%1)                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x20,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb),            // %0
+        "+r"(dst_y),               // %1
+        "+r"(width)                // %2
+      : "m"(kARGBToY),             // %3
+        "m"(kSub128),              // %4
+        "m"(kAddY16),              // %5
+        "m"(kPermqARGBToY_AVX512)  // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOYROW_AVX512BW
+
 #ifdef HAS_ABGRTOYROW_AVX2
 // Convert 32 ABGR pixels (128 bytes) to 32 Y values.
 void ABGRToYRow_AVX2(const uint8_t* src_abgr, uint8_t* dst_y, int width) {
@@ -1637,6 +1687,668 @@ void ARGBToUVRow_AVX2(const uint8_t* src_argb,
 }
 #endif  // HAS_ARGBTOUVROW_AVX2
 
+#ifdef HAS_ARGBTOUVROW_AVX512BW
+// vpermw for vpackssdw: 16 U followed by 16 V.
+static const lvec8 kPermwARGBToUV_AVX512 = {
+    0, 1, 8,  9,  16, 17, 24, 25, 2, 3, 10, 11, 18, 19, 26, 27,
+    4, 5, 12, 13, 20, 21, 28, 29, 6, 7, 14, 15, 22, 23, 30, 31};
+
+// Convert 32 ARGB pixels on 2 rows (256 bytes) to 16 U and 16 V values.
+void ARGBToUVRow_AVX512BW(const uint8_t* src_argb,
+                          int src_stride_argb,
+                          uint8_t* dst_u,
+                          uint8_t* dst_v,
+                          int width) {
+  asm volatile(
+      "vbroadcastf128 %5,%%ymm5                  \n"
+      "vbroadcasti32x4 %6,%%zmm6                 \n"
+      "vbroadcasti32x4 %7,%%zmm7                 \n"
+      "vpmovzxbw   %8,%%zmm3                     \n"
+      "vpternlogd  $0xff,%%zmm4,%%zmm4,%%zmm4    \n"
+      "vpsrlw      $0xf,%%zmm4,%%zmm4            \n"  // 1
+      "sub         %1,%2                         \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "vmovdqu64   0x40(%0),%%zmm1               \n"
+      "vpavgb      0x00(%0,%4,1),%%zmm0,%%zmm0   \n"
+      "vpavgb      0x40(%0,%4,1),%%zmm1,%%zmm1   \n"
+      "lea         0x80(%0),%0                   \n"
+      "vshufps     $0x88,%%zmm1,%%zmm0,%%zmm2    \n"
+      "vshufps     $0xdd,%%zmm1,%%zmm0,%%zmm0    \n"
+      "vpavgb      %%zmm2,%%zmm0,%%zmm0          \n"
+
+      "vpmaddubsw  %%zmm7,%%zmm0,%%zmm1          \n"
+      "vpmaddubsw  %%zmm6,%%zmm0,%%zmm0          \n"
+      "vpmaddwd    %%zmm4,%%zmm1,%%zmm1          \n"
+      "vpmaddwd    %%zmm4,%%zmm0,%%zmm0          \n"
+      "vpackssdw   %%zmm0,%%zmm1,%%zmm0          \n"  // mutates.
+      "vpsraw      $0x8,%%zmm0,%%zmm0            \n"
+      "vpermw      %%zmm0,%%zmm3,%%zmm0          \n"  // unmutate.
+      "vpmovswb    %%zmm0,%%ymm0                 \n"
+      "vpaddb      %%ymm5,%%ymm0,%%ymm0          \n"
+
+      "vextractf128 $0x0,%%ymm0,(%1)             \n"
+      "vextractf128 $0x1,%%ymm0,0x0(%1,%2,1)     \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x20,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb),                    // %0
+        "+r"(dst_u),                       // %1
+        "+r"(dst_v),                       // %2
+        "+rm"(width)                       // %3
+      : "r"((intptr_t)(src_stride_argb)),  // %4
+        "m"(kAddUV128),                    // %5
+        "m"(kARGBToV),                     // %6
+        "m"(kARGBToU),                     // %7
+        "m"(kPermwARGBToUV_AVX512)         // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOUVROW_AVX512BW
+
+#if defined(HAS_RGB24TOYROW_SSSE3) || defined(HAS_RGB24TOUVROW_SSSE3)
+// Shuffle tables for expanding 4 RGB24 or RAW pixels (12 bytes) to ARGB
+// order, with A zeroed.  The 4 suffix tables take the pixels from bytes 4 to
+// 15, for loads that end at the end of a group of pixels.
+static const uvec8 kShuffleRGB24ToARGB0 = {0u, 1u, 2u, 128u, 3u, 4u,  5u,  128u,
+                                          6u, 7u, 8u, 128u, 9u, 10u, 11u, 128u};
+static const uvec8 kShuffleRGB24ToARGB4 = {4u,  5u,  6u,  128u, 7u,  8u,
+                                          9u,  128u, 10u, 11u, 12u, 128u,
+                                          13u, 14u, 15u, 128u};
+static const uvec8 kShuffleRAWToARGB0 = {2u, 1u, 0u, 128u, 5u,  4u,  3u, 128u,
+                                        8u, 7u, 6u, 128u, 11u, 10u, 9u, 128u};
+static const uvec8 kShuffleRAWToARGB4 = {6u,  5u,  4u,  128u, 9u,  8u,
+                                        7u,  128u, 12u, 11u, 10u, 128u,
+                                        15u, 14u, 13u, 128u};
+#endif
+
+#ifdef HAS_RGB24TOYROW_SSSE3
+// clang-format off
+
+// Same as RGBTOY but reads 16 RGB24 or RAW pixels (48 bytes), expanding them
+// to ARGB in registers with the shuffle tables in %6 and %7.
+#define RGB24TOY(round)                          \
+  "1:                                        \n" \
+  "movdqu    (%0),%%xmm0                     \n" \
+  "movdqu    0xc(%0),%%xmm1                  \n" \
+  "movdqu    0x18(%0),%%xmm2                 \n" \
+  "movdqu    0x20(%0),%%xmm3                 \n" \
+  "pshufb    %6,%%xmm0                       \n" \
+  "pshufb    %6,%%xmm1                       \n" \
+  "pshufb    %6,%%xmm2                       \n" \
+  "pshufb    %7,%%xmm3                       \n" \
+  "psubb     %%xmm5,%%xmm0                   \n" \
+  "psubb     %%xmm5,%%xmm1                   \n" \
+  "psubb     %%xmm5,%%xmm2                   \n" \
+  "psubb     %%xmm5,%%xmm3                   \n" \
+  "movdqu    %%xmm4,%%xmm6                   \n" \
+  "pmaddubsw %%xmm0,%%xmm6                   \n" \
+  "movdqu    %%xmm4,%%xmm0                   \n" \
+  "pmaddubsw %%xmm1,%%xmm0                   \n" \
+  "movdqu    %%xmm4,%%xmm1                   \n" \
+  "pmaddubsw %%xmm2,%%xmm1                   \n" \
+  "movdqu    %%xmm4,%%xmm2                   \n" \
+  "pmaddubsw %%xmm3,%%xmm2                   \n" \
+  "lea       0x30(%0),%0                     \n" \
+  "phaddw    %%xmm0,%%xmm6                   \n" \
+  "phaddw    %%xmm2,%%xmm1                   \n" \
+  "prefetcht0 1280(%0)                       \n" \
+  "paddw     %%" #round ",%%xmm6             \n" \
+  "paddw     %%" #round ",%%xmm1             \n" \
+  "psrlw     $0x8,%%xmm6                     \n" \
+  "psrlw     $0x8,%%xmm1                     \n" \
+  "packuswb  %%xmm1,%%xmm6                   \n" \
+  "movdqu    %%xmm6,(%1)                     \n" \
+  "lea       0x10(%1),%1                     \n" \
+  "sub       $0x10,%2                        \n" \
+  "jg        1b                              \n"
+
+// clang-format on
+
+// Convert 16 RGB24 pixels (48 bytes) to 16 Y values.
+void RGB24ToYRow_SSSE3(const uint8_t* src_rgb24, uint8_t* dst_y, int width) {
+  asm volatile(
+      "movdqa      %3,%%xmm4                     \n"
+      "movdqa      %4,%%xmm5                     \n"
+      "movdqa      %5,%%xmm7                     \n"
+
+      LABELALIGN RGB24TOY(xmm7)
+      : "+r"(src_rgb24),            // %0
+        "+r"(dst_y),                // %1
+        "+r"(width)                 // %2
+      : "m"(kARGBToY),              // %3
+        "m"(kSub128),               // %4
+        "m"(kAddY16),               // %5
+        "m"(kShuffleRGB24ToARGB0),  // %6
+        "m"(kShuffleRGB24ToARGB4)   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+
+// Convert 16 RAW pixels (48 bytes) to 16 Y values.
+void RAWToYRow_SSSE3(const uint8_t* src_raw, uint8_t* dst_y, int width) {
+  asm volatile(
+      "movdqa      %3,%%xmm4                     \n"
+      "movdqa      %4,%%xmm5                     \n"
+      "movdqa      %5,%%xmm7                     \n"
+
+      LABELALIGN RGB24TOY(xmm7)
+      : "+r"(src_raw),            // %0
+        "+r"(dst_y),              // %1
+        "+r"(width)               // %2
+      : "m"(kARGBToY),            // %3
+        "m"(kSub128),             // %4
+        "m"(kAddY16),             // %5
+        "m"(kShuffleRAWToARGB0),  // %6
+        "m"(kShuffleRAWToARGB4)   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_RGB24TOYROW_SSSE3
+
+#ifdef HAS_RGB24TOUVROW_SSSE3
+// Same as ARGBToUVRow_SSSE3 but reads 16 RGB24 or RAW pixels (48 bytes) from
+// each row.  The 2 rows are averaged before the pixels are expanded to ARGB
+// with the shuffle tables in %8 and %9.
+#define RGB24TOUV                                                       \
+  "movdqa      %5,%%xmm3                     \n"                        \
+  "movdqa      %6,%%xmm4                     \n"                        \
+  "movdqa      %7,%%xmm5                     \n"                        \
+  "sub         %1,%2                         \n"                        \
+                                                                        \
+  LABELALIGN                                                            \
+  "1:                                        \n"                        \
+  "movdqu      (%0),%%xmm0                   \n"                        \
+  "movdqu      0x00(%0,%4,1),%%xmm7          \n"                        \
+  "pavgb       %%xmm7,%%xmm0                 \n"                        \
+  "pshufb      %8,%%xmm0                     \n"                        \
+  "movdqu      0xc(%0),%%xmm1                \n"                        \
+  "movdqu      0xc(%0,%4,1),%%xmm7           \n"                        \
+  "pavgb       %%xmm7,%%xmm1                 \n"                        \
+  "pshufb      %8,%%xmm1                     \n"                        \
+  "movdqu      0x18(%0),%%xmm2               \n"                        \
+  "movdqu      0x18(%0,%4,1),%%xmm7          \n"                        \
+  "pavgb       %%xmm7,%%xmm2                 \n"                        \
+  "pshufb      %8,%%xmm2                     \n"                        \
+  "movdqu      0x20(%0),%%xmm6               \n"                        \
+  "movdqu      0x20(%0,%4,1),%%xmm7          \n"                        \
+  "pavgb       %%xmm7,%%xmm6                 \n"                        \
+  "pshufb      %9,%%xmm6                     \n"                        \
+                                                                        \
+  "lea         0x30(%0),%0                   \n"                        \
+  "movdqa      %%xmm0,%%xmm7                 \n"                        \
+  "shufps      $0x88,%%xmm1,%%xmm0           \n"                        \
+  "shufps      $0xdd,%%xmm1,%%xmm7           \n"                        \
+  "pavgb       %%xmm7,%%xmm0                 \n"                        \
+  "movdqa      %%xmm2,%%xmm7                 \n"                        \
+  "shufps      $0x88,%%xmm6,%%xmm2           \n"                        \
+  "shufps      $0xdd,%%xmm6,%%xmm7           \n"                        \
+  "pavgb       %%xmm7,%%xmm2                 \n"                        \
+  "movdqa      %%xmm0,%%xmm1                 \n"                        \
+  "movdqa      %%xmm2,%%xmm6                 \n"                        \
+  "pmaddubsw   %%xmm4,%%xmm0                 \n"                        \
+  "pmaddubsw   %%xmm4,%%xmm2                 \n"                        \
+  "pmaddubsw   %%xmm3,%%xmm1                 \n"                        \
+  "pmaddubsw   %%xmm3,%%xmm6                 \n"                        \
+  "phaddw      %%xmm2,%%xmm0                 \n"                        \
+  "phaddw      %%xmm6,%%xmm1                 \n"                        \
+  "psraw       $0x8,%%xmm0                   \n"                        \
+  "psraw       $0x8,%%xmm1                   \n"                        \
+  "packsswb    %%xmm1,%%xmm0                 \n"                        \
+  "paddb       %%xmm5,%%xmm0                 \n"                        \
+  "movlps      %%xmm0,(%1)                   \n"                        \
+  "movhps      %%xmm0,0x00(%1,%2,1)          \n"                        \
+  "lea         0x8(%1),%1                    \n"                        \
+  "sub         $0x10,%3                      \n"                        \
+  "jg          1b                            \n"
+
+void RGB24ToUVRow_SSSE3(const uint8_t* src_rgb24,
+                        int src_stride_rgb24,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width) {
+  asm volatile(RGB24TOUV
+               : "+r"(src_rgb24),                    // %0
+                 "+r"(dst_u),                        // %1
+                 "+r"(dst_v),                        // %2
+                 "+rm"(width)                        // %3
+               : "r"((intptr_t)(src_stride_rgb24)),  // %4
+                 "m"(kARGBToV),                      // %5
+                 "m"(kARGBToU),                      // %6
+                 "m"(kAddUV128),                     // %7
+                 "m"(kShuffleRGB24ToARGB0),          // %8
+                 "m"(kShuffleRGB24ToARGB4)           // %9
+               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4",
+                 "xmm5", "xmm6", "xmm7");
+}
+
+void RAWToUVRow_SSSE3(const uint8_t* src_raw,
+                      int src_stride_raw,
+                      uint8_t* dst_u,
+                      uint8_t* dst_v,
+                      int width) {
+  asm volatile(RGB24TOUV
+               : "+r"(src_raw),                    // %0
+                 "+r"(dst_u),                      // %1
+                 "+r"(dst_v),                      // %2
+                 "+rm"(width)                      // %3
+               : "r"((intptr_t)(src_stride_raw)),  // %4
+                 "m"(kARGBToV),                    // %5
+                 "m"(kARGBToU),                    // %6
+                 "m"(kAddUV128),                   // %7
+                 "m"(kShuffleRAWToARGB0),          // %8
+                 "m"(kShuffleRAWToARGB4)           // %9
+               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4",
+                 "xmm5", "xmm6", "xmm7");
+}
+#undef RGB24TOUV
+#endif  // HAS_RGB24TOUVROW_SSSE3
+
+#if defined(HAS_RGB24TOYROW_AVX2) || defined(HAS_RGB24TOUVROW_AVX2)
+// Shuffle tables for expanding 8 RGB24 or RAW pixels to ARGB, with the low
+// lane loaded from the first pixel and the high lane loaded 8 bytes later.
+static const lvec8 kShuffleRGB24ToARGB_AVX2 = {
+    0, 1,  2,  -128, 3,  4,  5,  -128, 6,  7,  8,  -128, 9,  10, 11, -128,
+    4, 5,  6,  -128, 7,  8,  9,  -128, 10, 11, 12, -128, 13, 14, 15, -128};
+static const lvec8 kShuffleRAWToARGB_AVX2 = {
+    2, 1,  0,  -128, 5,  4,  3,  -128, 8,  7,  6,  -128, 11, 10, 9,  -128,
+    6, 5,  4,  -128, 9,  8,  7,  -128, 12, 11, 10, -128, 15, 14, 13, -128};
+#endif
+
+#ifdef HAS_RGB24TOYROW_AVX2
+// clang-format off
+
+// Same as RGBTOY_AVX2 but reads 32 RGB24 or RAW pixels (96 bytes), expanding
+// them to ARGB in registers with the shuffle table in %7.
+#define RGB24TOY_AVX2(round)                                     \
+  "1:                                        \n"                 \
+  "vmovdqu    (%0),%%xmm0                    \n"                 \
+  "vmovdqu    0x18(%0),%%xmm1                \n"                 \
+  "vmovdqu    0x30(%0),%%xmm2                \n"                 \
+  "vmovdqu    0x48(%0),%%xmm3                \n"                 \
+  "vinserti128 $0x1,0x8(%0),%%ymm0,%%ymm0    \n"                 \
+  "vinserti128 $0x1,0x20(%0),%%ymm1,%%ymm1   \n"                 \
+  "vinserti128 $0x1,0x38(%0),%%ymm2,%%ymm2   \n"                 \
+  "vinserti128 $0x1,0x50(%0),%%ymm3,%%ymm3   \n"                 \
+  "vpshufb    %7,%%ymm0,%%ymm0               \n"                 \
+  "vpshufb    %7,%%ymm1,%%ymm1               \n"                 \
+  "vpshufb    %7,%%ymm2,%%ymm2               \n"                 \
+  "vpshufb    %7,%%ymm3,%%ymm3               \n"                 \
+  "vpsubb     %%ymm5, %%ymm0, %%ymm0         \n"                 \
+  "vpsubb     %%ymm5, %%ymm1, %%ymm1         \n"                 \
+  "vpsubb     %%ymm5, %%ymm2, %%ymm2         \n"                 \
+  "vpsubb     %%ymm5, %%ymm3, %%ymm3         \n"                 \
+  "vpmaddubsw %%ymm0,%%ymm4,%%ymm0           \n"                 \
+  "vpmaddubsw %%ymm1,%%ymm4,%%ymm1           \n"                 \
+  "vpmaddubsw %%ymm2,%%ymm4,%%ymm2           \n"                 \
+  "vpmaddubsw %%ymm3,%%ymm4,%%ymm3           \n"                 \
+  "lea       0x60(%0),%0                     \n"                 \
+  "vphaddw    %%ymm1,%%ymm0,%%ymm0           \n" /* mutates. */  \
+  "vphaddw    %%ymm3,%%ymm2,%%ymm2           \n"                 \
+  "prefetcht0 1280(%0)                       \n"                 \
+  "vpaddw     %%" #round ",%%ymm0,%%ymm0     \n"                 \
+  "vpaddw     %%" #round ",%%ymm2,%%ymm2     \n"                 \
+  "vpsrlw     $0x8,%%ymm0,%%ymm0             \n"                 \
+  "vpsrlw     $0x8,%%ymm2,%%ymm2             \n"                 \
+  "vpackuswb  %%ymm2,%%ymm0,%%ymm0           \n" /* mutates. */  \
+  "vpermd     %%ymm0,%%ymm6,%%ymm0           \n" /* unmutate. */ \
+  "vmovdqu    %%ymm0,(%1)                    \n"                 \
+  "lea       0x20(%1),%1                     \n"                 \
+  "sub       $0x20,%2                        \n"                 \
+  "jg        1b                              \n"                 \
+  "vzeroupper                                \n"
+
+// clang-format on
+
+// Convert 32 RGB24 pixels (96 bytes) to 32 Y values.
+void RGB24ToYRow_AVX2(const uint8_t* src_rgb24, uint8_t* dst_y, int width) {
+  asm volatile(
+      "vbroadcastf128 %3,%%ymm4                  \n"
+      "vbroadcastf128 %4,%%ymm5                  \n"
+      "vbroadcastf128 %5,%%ymm7                  \n"
+      "vmovdqu     %6,%%ymm6                     \n"
+
+      LABELALIGN RGB24TOY_AVX2(ymm7)
+      : "+r"(src_rgb24),               // %0
+        "+r"(dst_y),                   // %1
+        "+r"(width)                    // %2
+      : "m"(kARGBToY),                 // %3
+        "m"(kSub128),                  // %4
+        "m"(kAddY16),                  // %5
+        "m"(kPermdARGBToY_AVX),        // %6
+        "m"(kShuffleRGB24ToARGB_AVX2)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+
+// Convert 32 RAW pixels (96 bytes) to 32 Y values.
+void RAWToYRow_AVX2(const uint8_t* src_raw, uint8_t* dst_y, int width) {
+  asm volatile(
+      "vbroadcastf128 %3,%%ymm4                  \n"
+      "vbroadcastf128 %4,%%ymm5                  \n"
+      "vbroadcastf128 %5,%%ymm7                  \n"
+      "vmovdqu     %6,%%ymm6                     \n"
+
+      LABELALIGN RGB24TOY_AVX2(ymm7)
+      : "+r"(src_raw),               // %0
+        "+r"(dst_y),                 // %1
+        "+r"(width)                  // %2
+      : "m"(kARGBToY),               // %3
+        "m"(kSub128),                // %4
+        "m"(kAddY16),                // %5
+        "m"(kPermdARGBToY_AVX),      // %6
+        "m"(kShuffleRAWToARGB_AVX2)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_RGB24TOYROW_AVX2
+
+#ifdef HAS_RGB24TOUVROW_AVX2
+// Same as ARGBToUVRow_AVX2 but reads 32 RGB24 or RAW pixels (96 bytes) from
+// each row.  The 2 rows are averaged before the pixels are expanded to ARGB
+// with the shuffle table in %9.
+#define RGB24TOUV_AVX2                                                  \
+  "vbroadcastf128 %5,%%ymm5                  \n"                        \
+  "vbroadcastf128 %6,%%ymm6                  \n"                        \
+  "vbroadcastf128 %7,%%ymm7                  \n"                        \
+  "sub         %1,%2                         \n"                        \
+                                                                        \
+  LABELALIGN                                                            \
+  "1:                                        \n"                        \
+  "vmovdqu     (%0),%%xmm0                   \n"                        \
+  "vinserti128 $0x1,0x8(%0),%%ymm0,%%ymm0    \n"                        \
+  "vmovdqu     0x00(%0,%4,1),%%xmm4          \n"                        \
+  "vinserti128 $0x1,0x8(%0,%4,1),%%ymm4,%%ymm4 \n"                      \
+  "vpavgb      %%ymm4,%%ymm0,%%ymm0          \n"                        \
+  "vmovdqu     0x18(%0),%%xmm1               \n"                        \
+  "vinserti128 $0x1,0x20(%0),%%ymm1,%%ymm1   \n"                        \
+  "vmovdqu     0x18(%0,%4,1),%%xmm4          \n"                        \
+  "vinserti128 $0x1,0x20(%0,%4,1),%%ymm4,%%ymm4 \n"                     \
+  "vpavgb      %%ymm4,%%ymm1,%%ymm1          \n"                        \
+  "vmovdqu     0x30(%0),%%xmm2               \n"                        \
+  "vinserti128 $0x1,0x38(%0),%%ymm2,%%ymm2   \n"                        \
+  "vmovdqu     0x30(%0,%4,1),%%xmm4          \n"                        \
+  "vinserti128 $0x1,0x38(%0,%4,1),%%ymm4,%%ymm4 \n"                     \
+  "vpavgb      %%ymm4,%%ymm2,%%ymm2          \n"                        \
+  "vmovdqu     0x48(%0),%%xmm3               \n"                        \
+  "vinserti128 $0x1,0x50(%0),%%ymm3,%%ymm3   \n"                        \
+  "vmovdqu     0x48(%0,%4,1),%%xmm4          \n"                        \
+  "vinserti128 $0x1,0x50(%0,%4,1),%%ymm4,%%ymm4 \n"                     \
+  "vpavgb      %%ymm4,%%ymm3,%%ymm3          \n"                        \
+  "vpshufb     %9,%%ymm0,%%ymm0              \n"                        \
+  "vpshufb     %9,%%ymm1,%%ymm1              \n"                        \
+  "vpshufb     %9,%%ymm2,%%ymm2              \n"                        \
+  "vpshufb     %9,%%ymm3,%%ymm3              \n"                        \
+  "lea         0x60(%0),%0                   \n"                        \
+  "vshufps     $0x88,%%ymm1,%%ymm0,%%ymm4    \n"                        \
+  "vshufps     $0xdd,%%ymm1,%%ymm0,%%ymm0    \n"                        \
+  "vpavgb      %%ymm4,%%ymm0,%%ymm0          \n"                        \
+  "vshufps     $0x88,%%ymm3,%%ymm2,%%ymm4    \n"                        \
+  "vshufps     $0xdd,%%ymm3,%%ymm2,%%ymm2    \n"                        \
+  "vpavgb      %%ymm4,%%ymm2,%%ymm2          \n"                        \
+                                                                        \
+  "vpmaddubsw  %%ymm7,%%ymm0,%%ymm1          \n"                        \
+  "vpmaddubsw  %%ymm7,%%ymm2,%%ymm3          \n"                        \
+  "vpmaddubsw  %%ymm6,%%ymm0,%%ymm0          \n"                        \
+  "vpmaddubsw  %%ymm6,%%ymm2,%%ymm2          \n"                        \
+  "vphaddw     %%ymm3,%%ymm1,%%ymm1          \n"                        \
+  "vphaddw     %%ymm2,%%ymm0,%%ymm0          \n"                        \
+  "vpsraw      $0x8,%%ymm1,%%ymm1            \n"                        \
+  "vpsraw      $0x8,%%ymm0,%%ymm0            \n"                        \
+  "vpacksswb   %%ymm0,%%ymm1,%%ymm0          \n"                        \
+  "vpermq      $0xd8,%%ymm0,%%ymm0           \n"                        \
+  "vpshufb     %8,%%ymm0,%%ymm0              \n"                        \
+  "vpaddb      %%ymm5,%%ymm0,%%ymm0          \n"                        \
+                                                                        \
+  "vextractf128 $0x0,%%ymm0,(%1)             \n"                        \
+  "vextractf128 $0x1,%%ymm0,0x0(%1,%2,1)     \n"                        \
+  "lea         0x10(%1),%1                   \n"                        \
+  "sub         $0x20,%3                      \n"                        \
+  "jg          1b                            \n"                        \
+  "vzeroupper                                \n"
+
+void RGB24ToUVRow_AVX2(const uint8_t* src_rgb24,
+                       int src_stride_rgb24,
+                       uint8_t* dst_u,
+                       uint8_t* dst_v,
+                       int width) {
+  asm volatile(RGB24TOUV_AVX2
+               : "+r"(src_rgb24),                    // %0
+                 "+r"(dst_u),                        // %1
+                 "+r"(dst_v),                        // %2
+                 "+rm"(width)                        // %3
+               : "r"((intptr_t)(src_stride_rgb24)),  // %4
+                 "m"(kAddUV128),                     // %5
+                 "m"(kARGBToV),                      // %6
+                 "m"(kARGBToU),                      // %7
+                 "m"(kShufARGBToUV_AVX),             // %8
+                 "m"(kShuffleRGB24ToARGB_AVX2)       // %9
+               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4",
+                 "xmm5", "xmm6", "xmm7");
+}
+
+void RAWToUVRow_AVX2(const uint8_t* src_raw,
+                     int src_stride_raw,
+                     uint8_t* dst_u,
+                     uint8_t* dst_v,
+                     int width) {
+  asm volatile(RGB24TOUV_AVX2
+               : "+r"(src_raw),                    // %0
+                 "+r"(dst_u),                      // %1
+                 "+r"(dst_v),                      // %2
+                 "+rm"(width)                      // %3
+               : "r"((intptr_t)(src_stride_raw)),  // %4
+                 "m"(kAddUV128),                   // %5
+                 "m"(kARGBToV),                    // %6
+                 "m"(kARGBToU),                    // %7
+                 "m"(kShufARGBToUV_AVX),           // %8
+                 "m"(kShuffleRAWToARGB_AVX2)       // %9
+               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4",
+                 "xmm5", "xmm6", "xmm7");
+}
+#undef RGB24TOUV_AVX2
+#endif  // HAS_RGB24TOUVROW_AVX2
+
+#if defined(HAS_ARGBTOYHROW_SSSE3) || defined(HAS_ARGBTOUVHROW_SSSE3)
+// BT.709 limited range coefficients, used for HDR to SDR conversion.
+// The Y coefficients sum to 220 like kARGBToY, so kAddY16 also applies.
+static const uvec8 kARGBToYH = {16u, 157u, 47u, 0u, 16u, 157u, 47u, 0u,
+                                16u, 157u, 47u, 0u, 16u, 157u, 47u, 0u};
+
+static const vec8 kARGBToUH = {112, -86, -26, 0, 112, -86, -26, 0,
+                               112, -86, -26, 0, 112, -86, -26, 0};
+
+static const vec8 kARGBToVH = {-10, -102, 112, 0, -10, -102, 112, 0,
+                               -10, -102, 112, 0, -10, -102, 112, 0};
+#endif
+
+#ifdef HAS_ARGBTOYHROW_SSSE3
+// Convert 16 ARGB pixels (64 bytes) to 16 BT.709 Y values.
+void ARGBToYHRow_SSSE3(const uint8_t* src_argb, uint8_t* dst_y, int width) {
+  asm volatile(
+      "movdqa      %3,%%xmm4                     \n"
+      "movdqa      %4,%%xmm5                     \n"
+      "movdqa      %5,%%xmm7                     \n"
+
+      LABELALIGN RGBTOY(xmm7)
+      : "+r"(src_argb),  // %0
+        "+r"(dst_y),     // %1
+        "+r"(width)      // %2
+      : "m"(kARGBToYH),  // %3
+        "m"(kSub128),    // %4
+        "m"(kAddY16)     // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOYHROW_SSSE3
+
+#ifdef HAS_ARGBTOYHROW_AVX2
+// Convert 32 ARGB pixels (128 bytes) to 32 BT.709 Y values.
+void ARGBToYHRow_AVX2(const uint8_t* src_argb, uint8_t* dst_y, int width) {
+  asm volatile(
+      "vbroadcastf128 %3,%%ymm4                  \n"
+      "vbroadcastf128 %4,%%ymm5                  \n"
+      "vbroadcastf128 %5,%%ymm7                  \n"
+      "vmovdqu     %6,%%ymm6                     \n"
+
+      LABELALIGN RGBTOY_AVX2(ymm7)
+      : "+r"(src_argb),         // %0
+        "+r"(dst_y),            // %1
+        "+r"(width)             // %2
+      : "m"(kARGBToYH),         // %3
+        "m"(kSub128),           // %4
+        "m"(kAddY16),           // %5
+        "m"(kPermdARGBToY_AVX)  // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOYHROW_AVX2
+
+#ifdef HAS_ARGBTOUVHROW_SSSE3
+// Same as ARGBToUVRow_SSSE3 with BT.709 coefficients.
+void ARGBToUVHRow_SSSE3(const uint8_t* src_argb,
+                        int src_stride_argb,
+                        uint8_t* dst_u,
+                        uint8_t* dst_v,
+                        int width) {
+  asm volatile(
+      "movdqa      %5,%%xmm3                     \n"
+      "movdqa      %6,%%xmm4                     \n"
+      "movdqa      %7,%%xmm5                     \n"
+      "sub         %1,%2                         \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "movdqu      0x00(%0,%4,1),%%xmm7          \n"
+      "pavgb       %%xmm7,%%xmm0                 \n"
+      "movdqu      0x10(%0),%%xmm1               \n"
+      "movdqu      0x10(%0,%4,1),%%xmm7          \n"
+      "pavgb       %%xmm7,%%xmm1                 \n"
+      "movdqu      0x20(%0),%%xmm2               \n"
+      "movdqu      0x20(%0,%4,1),%%xmm7          \n"
+      "pavgb       %%xmm7,%%xmm2                 \n"
+      "movdqu      0x30(%0),%%xmm6               \n"
+      "movdqu      0x30(%0,%4,1),%%xmm7          \n"
+      "pavgb       %%xmm7,%%xmm6                 \n"
+
+      "lea         0x40(%0),%0                   \n"
+      "movdqa      %%xmm0,%%xmm7                 \n"
+      "shufps      $0x88,%%xmm1,%%xmm0           \n"
+      "shufps      $0xdd,%%xmm1,%%xmm7           \n"
+      "pavgb       %%xmm7,%%xmm0                 \n"
+      "movdqa      %%xmm2,%%xmm7                 \n"
+      "shufps      $0x88,%%xmm6,%%xmm2           \n"
+      "shufps      $0xdd,%%xmm6,%%xmm7           \n"
+      "pavgb       %%xmm7,%%xmm2                 \n"
+      "movdqa      %%xmm0,%%xmm1                 \n"
+      "movdqa      %%xmm2,%%xmm6                 \n"
+      "pmaddubsw   %%xmm4,%%xmm0                 \n"
+      "pmaddubsw   %%xmm4,%%xmm2                 \n"
+      "pmaddubsw   %%xmm3,%%xmm1                 \n"
+      "pmaddubsw   %%xmm3,%%xmm6                 \n"
+      "phaddw      %%xmm2,%%xmm0                 \n"
+      "phaddw      %%xmm6,%%xmm1                 \n"
+      "psraw       $0x8,%%xmm0                   \n"
+      "psraw       $0x8,%%xmm1                   \n"
+      "packsswb    %%xmm1,%%xmm0                 \n"
+      "paddb       %%xmm5,%%xmm0                 \n"
+      "movlps      %%xmm0,(%1)                   \n"
+      "movhps      %%xmm0,0x00(%1,%2,1)          \n"
+      "lea         0x8(%1),%1                    \n"
+      "sub         $0x10,%3                      \n"
+      "jg          1b                            \n"
+      : "+r"(src_argb),                    // %0
+        "+r"(dst_u),                       // %1
+        "+r"(dst_v),                       // %2
+        "+rm"(width)                       // %3
+      : "r"((intptr_t)(src_stride_argb)),  // %4
+        "m"(kARGBToVH),                    // %5
+        "m"(kARGBToUH),                    // %6
+        "m"(kAddUV128)                     // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOUVHROW_SSSE3
+
+#ifdef HAS_ARGBTOUVHROW_AVX2
+// Same as ARGBToUVRow_AVX2 with BT.709 coefficients.
+void ARGBToUVHRow_AVX2(const uint8_t* src_argb,
+                       int src_stride_argb,
+                       uint8_t* dst_u,
+                       uint8_t* dst_v,
+                       int width) {
+  asm volatile(
+      "vbroadcastf128 %5,%%ymm5                  \n"
+      "vbroadcastf128 %6,%%ymm6                  \n"
+      "vbroadcastf128 %7,%%ymm7                  \n"
+      "sub         %1,%2                         \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "vmovdqu     0x40(%0),%%ymm2               \n"
+      "vmovdqu     0x60(%0),%%ymm3               \n"
+      "vpavgb      0x00(%0,%4,1),%%ymm0,%%ymm0   \n"
+      "vpavgb      0x20(%0,%4,1),%%ymm1,%%ymm1   \n"
+      "vpavgb      0x40(%0,%4,1),%%ymm2,%%ymm2   \n"
+      "vpavgb      0x60(%0,%4,1),%%ymm3,%%ymm3   \n"
+      "lea         0x80(%0),%0                   \n"
+      "vshufps     $0x88,%%ymm1,%%ymm0,%%ymm4    \n"
+      "vshufps     $0xdd,%%ymm1,%%ymm0,%%ymm0    \n"
+      "vpavgb      %%ymm4,%%ymm0,%%ymm0          \n"
+      "vshufps     $0x88,%%ymm3,%%ymm2,%%ymm4    \n"
+      "vshufps     $0xdd,%%ymm3,%%ymm2,%%ymm2    \n"
+      "vpavgb      %%ymm4,%%ymm2,%%ymm2          \n"
+
+      "vpmaddubsw  %%ymm7,%%ymm0,%%ymm1          \n"
+      "vpmaddubsw  %%ymm7,%%ymm2,%%ymm3          \n"
+      "vpmaddubsw  %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpmaddubsw  %%ymm6,%%ymm2,%%ymm2          \n"
+      "vphaddw     %%ymm3,%%ymm1,%%ymm1          \n"
+      "vphaddw     %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpsraw      $0x8,%%ymm1,%%ymm1            \n"
+      "vpsraw      $0x8,%%ymm0,%%ymm0            \n"
+      "vpacksswb   %%ymm0,%%ymm1,%%ymm0          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vpshufb     %8,%%ymm0,%%ymm0              \n"
+      "vpaddb      %%ymm5,%%ymm0,%%ymm0          \n"
+
+      "vextractf128 $0x0,%%ymm0,(%1)             \n"
+      "vextractf128 $0x1,%%ymm0,0x0(%1,%2,1)     \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x20,%3                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb),                    // %0
+        "+r"(dst_u),                       // %1
+        "+r"(dst_v),                       // %2
+        "+rm"(width)                       // %3
+      : "r"((intptr_t)(src_stride_argb)),  // %4
+        "m"(kAddUV128),                    // %5
+        "m"(kARGBToVH),                    // %6
+        "m"(kARGBToUH),                    // %7
+        "m"(kShufARGBToUV_AVX)             // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTOUVHROW_AVX2
+
+#if defined(HAS_I210TOARGBTONEMAPROW_AVX2) || \
+    defined(HAS_P210TOARGBTONEMAPROW_AVX2)
+static const ulvec32 kToneMapOne = {0x10000u, 0x10000u, 0x10000u, 0x10000u,
+                                    0x10000u, 0x10000u, 0x10000u, 0x10000u};
+static const ulvec32 kToneMap4096 = {4096u, 4096u, 4096u, 4096u,
+                                     4096u, 4096u, 4096u, 4096u};
+static const ulvec32 kToneMapAlpha = {0xff000000u, 0xff000000u, 0xff000000u,
+                                      0xff000000u, 0xff000000u, 0xff000000u,
+                                      0xff000000u, 0xff000000u};
+#endif
+
 #ifdef HAS_ABGRTOUVROW_AVX2
 void ABGRToUVRow_AVX2(const uint8_t* src_abgr,
                       int src_stride_abgr,
@@ -3451,6 +4163,79 @@ void OMITFP I422ToRGBARow_SSSE3(const uint8_t* y_buf,
   "vmovdqu    %%ymm3,0x20(%[dst_ar30])                            \n" \
   "lea        0x40(%[dst_ar30]), %[dst_ar30]                      \n"
 
+// Tone map 8 pixels of 10 bit B, G and R in ymm3, ymm4 and ymm5 to ARGB.
+// The linear and gamma tables are read with vpgatherdd, the gamut matrix is
+// 2 vpmaddwd per channel.  Needs ymm6 = 0, uses ymm14 and ymm15.
+#define TONEMAP8_AVX2                                                 \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kLinear],%%ymm3,2),%%ymm14               \n" \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kLinear],%%ymm4,2),%%ymm3                \n" \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kLinear],%%ymm5,2),%%ymm4                \n" \
+  "vpslld     $16,%%ymm3,%%ymm3                                   \n" \
+  "vpblendw   $0xaa,%%ymm3,%%ymm4,%%ymm4                          \n" \
+  "vpblendw   $0xaa,%[kToneMapOne],%%ymm14,%%ymm14                \n" \
+  "vpmaddwd   0x80(%[kMatrix]),%%ymm4,%%ymm5                      \n" \
+  "vpmaddwd   0xa0(%[kMatrix]),%%ymm14,%%ymm15                    \n" \
+  "vpaddd     %%ymm15,%%ymm5,%%ymm5                               \n" \
+  "vpmaddwd   0x40(%[kMatrix]),%%ymm4,%%ymm3                      \n" \
+  "vpmaddwd   0x60(%[kMatrix]),%%ymm14,%%ymm15                    \n" \
+  "vpaddd     %%ymm15,%%ymm3,%%ymm3                               \n" \
+  "vpmaddwd   0x00(%[kMatrix]),%%ymm4,%%ymm4                      \n" \
+  "vpmaddwd   0x20(%[kMatrix]),%%ymm14,%%ymm14                    \n" \
+  "vpaddd     %%ymm14,%%ymm4,%%ymm4                               \n" \
+  "vpsrad     $14,%%ymm5,%%ymm5                                   \n" \
+  "vpsrad     $14,%%ymm3,%%ymm3                                   \n" \
+  "vpsrad     $14,%%ymm4,%%ymm4                                   \n" \
+  "vpmaxsd    %%ymm6,%%ymm5,%%ymm5                                \n" \
+  "vpmaxsd    %%ymm6,%%ymm3,%%ymm3                                \n" \
+  "vpmaxsd    %%ymm6,%%ymm4,%%ymm4                                \n" \
+  "vpminsd    %[kToneMap4096],%%ymm5,%%ymm5                       \n" \
+  "vpminsd    %[kToneMap4096],%%ymm3,%%ymm3                       \n" \
+  "vpminsd    %[kToneMap4096],%%ymm4,%%ymm4                       \n" \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kGamma],%%ymm5,1),%%ymm14                \n" \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kGamma],%%ymm3,1),%%ymm5                 \n" \
+  "vpcmpeqd   %%ymm15,%%ymm15,%%ymm15                             \n" \
+  "vpgatherdd %%ymm15,(%[kGamma],%%ymm4,1),%%ymm3                 \n" \
+  "vpslld     $24,%%ymm14,%%ymm14                                 \n" \
+  "vpsrld     $24,%%ymm14,%%ymm14                                 \n" \
+  "vpslld     $24,%%ymm5,%%ymm5                                   \n" \
+  "vpsrld     $16,%%ymm5,%%ymm5                                   \n" \
+  "vpslld     $24,%%ymm3,%%ymm3                                   \n" \
+  "vpsrld     $8,%%ymm3,%%ymm3                                    \n" \
+  "vpor       %%ymm5,%%ymm14,%%ymm14                              \n" \
+  "vpor       %%ymm3,%%ymm14,%%ymm14                              \n" \
+  "vpor       %[kToneMapAlpha],%%ymm14,%%ymm14                    \n" \
+  "vmovdqu    %%ymm14,(%[dst_argb])                               \n" \
+  "lea        0x20(%[dst_argb]),%[dst_argb]                       \n"
+
+// Tone map 16 pixels of YUVTORGB16_AVX2 output to ARGB without packing them
+// to AR30.  Needs ymm6 = 0 and ymm7 = 1023 in each word.
+#define STORETONEMAP_AVX2                                             \
+  "vpsraw     $0x4,%%ymm0,%%ymm0                                  \n" \
+  "vpsraw     $0x4,%%ymm1,%%ymm1                                  \n" \
+  "vpsraw     $0x4,%%ymm2,%%ymm2                                  \n" \
+  "vpminsw    %%ymm7,%%ymm0,%%ymm0                                \n" \
+  "vpminsw    %%ymm7,%%ymm1,%%ymm1                                \n" \
+  "vpminsw    %%ymm7,%%ymm2,%%ymm2                                \n" \
+  "vpmaxsw    %%ymm6,%%ymm0,%%ymm0                                \n" \
+  "vpmaxsw    %%ymm6,%%ymm1,%%ymm1                                \n" \
+  "vpmaxsw    %%ymm6,%%ymm2,%%ymm2                                \n" \
+  "vpmovzxwd  %%xmm0,%%ymm3                                       \n" \
+  "vpmovzxwd  %%xmm1,%%ymm4                                       \n" \
+  "vpmovzxwd  %%xmm2,%%ymm5                                       \n" \
+  TONEMAP8_AVX2                                                       \
+  "vextracti128 $1,%%ymm0,%%xmm0                                  \n" \
+  "vextracti128 $1,%%ymm1,%%xmm1                                  \n" \
+  "vextracti128 $1,%%ymm2,%%xmm2                                  \n" \
+  "vpmovzxwd  %%xmm0,%%ymm3                                       \n" \
+  "vpmovzxwd  %%xmm1,%%ymm4                                       \n" \
+  "vpmovzxwd  %%xmm2,%%ymm5                                       \n" \
+  TONEMAP8_AVX2
+
 #ifdef HAS_I444TOARGBROW_AVX2
 // 16 pixels
 // 16 UV values with 16 Y producing 16 ARGB (64 bytes).
@@ -3670,6 +4455,53 @@ void OMITFP I210ToAR30Row_AVX2(const uint16_t* y_buf,
 }
 #endif  // HAS_I210TOAR30ROW_AVX2
 
+#if defined(HAS_I210TOARGBTONEMAPROW_AVX2)
+// 16 pixels
+// 16 UV values with 16 Y producing 16 tone mapped ARGB (64 bytes).
+// As I210ToAR30Row_AVX2, but the 10 bit RGB is tone mapped in registers
+// instead of being packed to AR30.
+void OMITFP I210ToARGBToneMapRow_AVX2(const uint16_t* y_buf,
+                                      const uint16_t* u_buf,
+                                      const uint16_t* v_buf,
+                                      uint8_t* dst_argb,
+                                      const struct YuvConstants* yuvconstants,
+                                      const struct ToneMapConstants* tonemap,
+                                      int width) {
+  asm volatile (
+    YUVTORGB_SETUP_AVX2(yuvconstants)
+      "sub         %[u_buf],%[v_buf]             \n"
+      "vpxor       %%ymm6,%%ymm6,%%ymm6          \n"  // 0 for min
+      "vpcmpeqb    %%ymm7,%%ymm7,%%ymm7          \n"  // 1023 for max
+      "vpsrlw      $6,%%ymm7,%%ymm7              \n"
+
+    LABELALIGN
+      "1:                                        \n"
+    READYUV210_AVX2
+    YUVTORGB16_AVX2(yuvconstants)
+    STORETONEMAP_AVX2
+      "sub         $0x10,%[width]                \n"
+      "jg          1b                            \n"
+
+      "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kLinear]"r"(tonemap->kLinear),  // %[kLinear]
+    [kGamma]"r"(tonemap->kGamma),  // %[kGamma]
+    [kMatrix]"r"(tonemap->kMatrix[0]),  // %[kMatrix]
+    [kToneMapOne]"m"(kToneMapOne),  // %[kToneMapOne]
+    [kToneMap4096]"m"(kToneMap4096),  // %[kToneMap4096]
+    [kToneMapAlpha]"m"(kToneMapAlpha)  // %[kToneMapAlpha]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+    "xmm14", "xmm15"
+  );
+}
+#endif  // HAS_I210TOARGBTONEMAPROW_AVX2
+
 #if defined(HAS_I212TOAR30ROW_AVX2)
 // 16 pixels
 // 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 AR30 (64 bytes).
@@ -3958,63 +4790,210 @@ void OMITFP I422ToRGBARow_AVX2(const uint8_t* y_buf,
     READYUV422_AVX2
     YUVTORGB_AVX2(yuvconstants)
 
-    // Step 3: Weave into RGBA
-    "vpunpcklbw %%ymm2,%%ymm1,%%ymm1           \n"
-    "vpermq     $0xd8,%%ymm1,%%ymm1            \n"
-    "vpunpcklbw %%ymm0,%%ymm5,%%ymm2           \n"
-    "vpermq     $0xd8,%%ymm2,%%ymm2            \n"
-    "vpunpcklwd %%ymm1,%%ymm2,%%ymm0           \n"
-    "vpunpckhwd %%ymm1,%%ymm2,%%ymm1           \n"
-    "vmovdqu    %%ymm0,(%[dst_argb])           \n"
-    "vmovdqu    %%ymm1,0x20(%[dst_argb])       \n"
-    "lea        0x40(%[dst_argb]),%[dst_argb]  \n"
-    "sub        $0x10,%[width]                 \n"
-    "jg         1b                             \n"
-    "vzeroupper                                \n"
+    // Step 3: Weave into RGBA
+    "vpunpcklbw %%ymm2,%%ymm1,%%ymm1           \n"
+    "vpermq     $0xd8,%%ymm1,%%ymm1            \n"
+    "vpunpcklbw %%ymm0,%%ymm5,%%ymm2           \n"
+    "vpermq     $0xd8,%%ymm2,%%ymm2            \n"
+    "vpunpcklwd %%ymm1,%%ymm2,%%ymm0           \n"
+    "vpunpckhwd %%ymm1,%%ymm2,%%ymm1           \n"
+    "vmovdqu    %%ymm0,(%[dst_argb])           \n"
+    "vmovdqu    %%ymm1,0x20(%[dst_argb])       \n"
+    "lea        0x40(%[dst_argb]),%[dst_argb]  \n"
+    "sub        $0x10,%[width]                 \n"
+    "jg         1b                             \n"
+    "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [u_buf]"+r"(u_buf),    // %[u_buf]
+    [v_buf]"+r"(v_buf),    // %[v_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+}
+#endif  // HAS_I422TORGBAROW_AVX2
+
+#if defined(HAS_NV12TOARGBROW_AVX2)
+// 16 pixels.
+// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
+void OMITFP NV12ToARGBRow_AVX2(const uint8_t* y_buf,
+                               const uint8_t* uv_buf,
+                               uint8_t* dst_argb,
+                               const struct YuvConstants* yuvconstants,
+                               int width) {
+  // clang-format off
+  asm volatile (
+    YUVTORGB_SETUP_AVX2(yuvconstants)
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+
+    LABELALIGN
+      "1:                                        \n"
+    READNV12_AVX2
+    YUVTORGB_AVX2(yuvconstants)
+    STOREARGB_AVX2
+      "sub         $0x10,%[width]                \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),    // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+    : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  );
+  // clang-format on
+}
+#endif  // HAS_NV12TOARGBROW_AVX2
+
+#if defined(HAS_I422TOARGBROW_AVX512BW) || defined(HAS_NV12TOARGBROW_AVX512BW)
+// vpermq to spread 4 qwords of Y or UV into the low half of each 128 bit lane
+// for the in-lane unpacks, and to gather lanes back together when storing.
+static const uvec8 kPermqYUV_AVX512 = {0, 4, 1, 5, 2, 6, 3, 7,
+                                       0, 0, 0, 0, 0, 0, 0, 0};
+
+// Read 16 UV from 422, upsample to 32 UV.
+#define READYUV422_AVX512BW                                           \
+  "vmovdqu    (%[u_buf]),%%xmm3                                   \n" \
+  "vmovdqu    0x00(%[u_buf],%[v_buf],1),%%xmm1                    \n" \
+  "lea        0x10(%[u_buf]),%[u_buf]                             \n" \
+  "vpunpckhbw %%xmm1,%%xmm3,%%xmm2                                \n" \
+  "vpunpcklbw %%xmm1,%%xmm3,%%xmm3                                \n" \
+  "vinserti128 $0x1,%%xmm2,%%ymm3,%%ymm3                          \n" \
+  "vpermq     %%zmm3,%%zmm7,%%zmm3                                \n" \
+  "vpunpcklwd %%zmm3,%%zmm3,%%zmm3                                \n" \
+  "vmovdqu    (%[y_buf]),%%ymm4                                   \n" \
+  "vpermq     %%zmm4,%%zmm7,%%zmm4                                \n" \
+  "vpunpcklbw %%zmm4,%%zmm4,%%zmm4                                \n" \
+  "lea        0x20(%[y_buf]),%[y_buf]                             \n"
+
+// Read 16 UV from NV12, upsample to 32 UV.
+#define READNV12_AVX512BW                                             \
+  "vmovdqu    (%[uv_buf]),%%ymm3                                  \n" \
+  "lea        0x20(%[uv_buf]),%[uv_buf]                           \n" \
+  "vpermq     %%zmm3,%%zmm7,%%zmm3                                \n" \
+  "vpunpcklwd %%zmm3,%%zmm3,%%zmm3                                \n" \
+  "vmovdqu    (%[y_buf]),%%ymm4                                   \n" \
+  "vpermq     %%zmm4,%%zmm7,%%zmm4                                \n" \
+  "vpunpcklbw %%zmm4,%%zmm4,%%zmm4                                \n" \
+  "lea        0x20(%[y_buf]),%[y_buf]                             \n"
+
+#define YUVTORGB_SETUP_AVX512BW(yuvconstants)                         \
+  "vpcmpeqb    %%xmm13,%%xmm13,%%xmm13                            \n" \
+  "vbroadcasti64x4 (%[yuvconstants]),%%zmm8                       \n" \
+  "vpsllw      $7,%%xmm13,%%xmm13                                 \n" \
+  "vbroadcasti64x4 32(%[yuvconstants]),%%zmm9                     \n" \
+  "vpbroadcastb %%xmm13,%%zmm13                                   \n" \
+  "vbroadcasti64x4 64(%[yuvconstants]),%%zmm10                    \n" \
+  "vbroadcasti64x4 96(%[yuvconstants]),%%zmm11                    \n" \
+  "vbroadcasti64x4 128(%[yuvconstants]),%%zmm12                   \n" \
+  "vpmovzxbq   %[kPermqYUV],%%zmm7                                \n"
+
+#define YUVTORGB_AVX512BW(yuvconstants)                               \
+  "vpsubb      %%zmm13,%%zmm3,%%zmm3                              \n" \
+  "vpmulhuw    %%zmm11,%%zmm4,%%zmm4                              \n" \
+  "vpmaddubsw  %%zmm3,%%zmm8,%%zmm0                               \n" \
+  "vpmaddubsw  %%zmm3,%%zmm9,%%zmm1                               \n" \
+  "vpmaddubsw  %%zmm3,%%zmm10,%%zmm2                              \n" \
+  "vpaddw      %%zmm4,%%zmm12,%%zmm4                              \n" \
+  "vpaddsw     %%zmm4,%%zmm0,%%zmm0                               \n" \
+  "vpsubsw     %%zmm1,%%zmm4,%%zmm1                               \n" \
+  "vpaddsw     %%zmm4,%%zmm2,%%zmm2                               \n" \
+  "vpsraw      $0x6,%%zmm0,%%zmm0                                 \n" \
+  "vpsraw      $0x6,%%zmm1,%%zmm1                                 \n" \
+  "vpsraw      $0x6,%%zmm2,%%zmm2                                 \n" \
+  "vpackuswb   %%zmm0,%%zmm0,%%zmm0                               \n" \
+  "vpackuswb   %%zmm1,%%zmm1,%%zmm1                               \n" \
+  "vpackuswb   %%zmm2,%%zmm2,%%zmm2                               \n"
+
+// Store 32 ARGB values.
+#define STOREARGB_AVX512BW                                            \
+  "vpunpcklbw %%zmm1,%%zmm0,%%zmm0                                \n" \
+  "vpermq     %%zmm0,%%zmm7,%%zmm0                                \n" \
+  "vpunpcklbw %%zmm5,%%zmm2,%%zmm2                                \n" \
+  "vpermq     %%zmm2,%%zmm7,%%zmm2                                \n" \
+  "vpunpcklwd %%zmm2,%%zmm0,%%zmm1                                \n" \
+  "vpunpckhwd %%zmm2,%%zmm0,%%zmm0                                \n" \
+  "vmovdqu64  %%zmm1,(%[dst_argb])                                \n" \
+  "vmovdqu64  %%zmm0,0x40(%[dst_argb])                            \n" \
+  "lea        0x80(%[dst_argb]), %[dst_argb]                      \n"
+#endif  // HAS_I422TOARGBROW_AVX512BW || HAS_NV12TOARGBROW_AVX512BW
+
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+// 32 pixels
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB (128
+// bytes).
+void OMITFP I422ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                                   const uint8_t* u_buf,
+                                   const uint8_t* v_buf,
+                                   uint8_t* dst_argb,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width) {
+  // clang-format off
+  asm volatile (
+    YUVTORGB_SETUP_AVX512BW(yuvconstants)
+      "sub         %[u_buf],%[v_buf]             \n"
+      "vpternlogd  $0xff,%%zmm5,%%zmm5,%%zmm5    \n"
+
+    LABELALIGN
+      "1:                                        \n"
+    READYUV422_AVX512BW
+    YUVTORGB_AVX512BW(yuvconstants)
+    STOREARGB_AVX512BW
+      "sub         $0x20,%[width]                \n"
+      "jg          1b                            \n"
+
+      "vzeroupper                                \n"
   : [y_buf]"+r"(y_buf),    // %[y_buf]
     [u_buf]"+r"(u_buf),    // %[u_buf]
     [v_buf]"+r"(v_buf),    // %[v_buf]
     [dst_argb]"+r"(dst_argb),  // %[dst_argb]
     [width]"+rm"(width)    // %[width]
-  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermqYUV]"m"(kPermqYUV_AVX512)  // %[kPermqYUV]
   : "memory", "cc", YUVTORGB_REGS_AVX2
-    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm7"
   );
+  // clang-format on
 }
-#endif  // HAS_I422TORGBAROW_AVX2
-
-#if defined(HAS_NV12TOARGBROW_AVX2)
-// 16 pixels.
-// 8 UV values upsampled to 16 UV, mixed with 16 Y producing 16 ARGB (64 bytes).
-void OMITFP NV12ToARGBRow_AVX2(const uint8_t* y_buf,
-                               const uint8_t* uv_buf,
-                               uint8_t* dst_argb,
-                               const struct YuvConstants* yuvconstants,
-                               int width) {
+#endif  // HAS_I422TOARGBROW_AVX512BW
+
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+// 32 pixels.
+// 16 UV values upsampled to 32 UV, mixed with 32 Y producing 32 ARGB (128
+// bytes).
+void OMITFP NV12ToARGBRow_AVX512BW(const uint8_t* y_buf,
+                                   const uint8_t* uv_buf,
+                                   uint8_t* dst_argb,
+                                   const struct YuvConstants* yuvconstants,
+                                   int width) {
   // clang-format off
   asm volatile (
-    YUVTORGB_SETUP_AVX2(yuvconstants)
-      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+    YUVTORGB_SETUP_AVX512BW(yuvconstants)
+      "vpternlogd  $0xff,%%zmm5,%%zmm5,%%zmm5    \n"
 
     LABELALIGN
       "1:                                        \n"
-    READNV12_AVX2
-    YUVTORGB_AVX2(yuvconstants)
-    STOREARGB_AVX2
-      "sub         $0x10,%[width]                \n"
+    READNV12_AVX512BW
+    YUVTORGB_AVX512BW(yuvconstants)
+    STOREARGB_AVX512BW
+      "sub         $0x20,%[width]                \n"
       "jg          1b                            \n"
       "vzeroupper                                \n"
   : [y_buf]"+r"(y_buf),    // %[y_buf]
     [uv_buf]"+r"(uv_buf),    // %[uv_buf]
     [dst_argb]"+r"(dst_argb),  // %[dst_argb]
     [width]"+rm"(width)    // %[width]
-  : [yuvconstants]"r"(yuvconstants)  // %[yuvconstants]
-    : "memory", "cc", YUVTORGB_REGS_AVX2
-    "xmm0", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5"
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kPermqYUV]"m"(kPermqYUV_AVX512)  // %[kPermqYUV]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm7"
   );
   // clang-format on
 }
-#endif  // HAS_NV12TOARGBROW_AVX2
+#endif  // HAS_NV12TOARGBROW_AVX512BW
 
 #if defined(HAS_NV21TOARGBROW_AVX2)
 // 16 pixels.
@@ -4219,6 +5198,50 @@ void OMITFP P210ToAR30Row_AVX2(const uint16_t* y_buf,
 }
 #endif  // HAS_P210TOAR30ROW_AVX2
 
+#if defined(HAS_P210TOARGBTONEMAPROW_AVX2)
+// 16 pixels
+// 16 UV values with 16 Y producing 16 tone mapped ARGB (64 bytes).
+// As P210ToAR30Row_AVX2, but the 10 bit RGB is tone mapped in registers
+// instead of being packed to AR30.
+void OMITFP P210ToARGBToneMapRow_AVX2(const uint16_t* y_buf,
+                                      const uint16_t* uv_buf,
+                                      uint8_t* dst_argb,
+                                      const struct YuvConstants* yuvconstants,
+                                      const struct ToneMapConstants* tonemap,
+                                      int width) {
+  asm volatile (
+    YUVTORGB_SETUP_AVX2(yuvconstants)
+      "vpxor       %%ymm6,%%ymm6,%%ymm6          \n"  // 0 for min
+      "vpcmpeqb    %%ymm7,%%ymm7,%%ymm7          \n"  // 1023 for max
+      "vpsrlw      $6,%%ymm7,%%ymm7              \n"
+
+    LABELALIGN
+      "1:                                        \n"
+    READP210_AVX2
+    YUVTORGB16_AVX2(yuvconstants)
+    STORETONEMAP_AVX2
+      "sub         $0x10,%[width]                \n"
+      "jg          1b                            \n"
+
+      "vzeroupper                                \n"
+  : [y_buf]"+r"(y_buf),    // %[y_buf]
+    [uv_buf]"+r"(uv_buf),    // %[uv_buf]
+    [dst_argb]"+r"(dst_argb),  // %[dst_argb]
+    [width]"+rm"(width)    // %[width]
+  : [yuvconstants]"r"(yuvconstants),  // %[yuvconstants]
+    [kLinear]"r"(tonemap->kLinear),  // %[kLinear]
+    [kGamma]"r"(tonemap->kGamma),  // %[kGamma]
+    [kMatrix]"r"(tonemap->kMatrix[0]),  // %[kMatrix]
+    [kToneMapOne]"m"(kToneMapOne),  // %[kToneMapOne]
+    [kToneMap4096]"m"(kToneMap4096),  // %[kToneMap4096]
+    [kToneMapAlpha]"m"(kToneMapAlpha)  // %[kToneMapAlpha]
+  : "memory", "cc", YUVTORGB_REGS_AVX2
+    "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6", "xmm7",
+    "xmm14", "xmm15"
+  );
+}
+#endif  // HAS_P210TOARGBTONEMAPROW_AVX2
+
 #if defined(HAS_P410TOAR30ROW_AVX2)
 // 16 pixels
 // 16 UV values with 16 Y producing 16 AR30 (64 bytes).
@@ -4615,6 +5638,63 @@ void SplitUVRow_AVX2(const uint8_t* src_uv,
 }
 #endif  // HAS_SPLITUVROW_AVX2
 
+#ifdef HAS_DETILEROW_SSE2
+void DetileRow_SSE2(const uint8_t* src,
+                    ptrdiff_t src_tile_stride,
+                    uint8_t* dst,
+                    int width) {
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "sub         $0x10,%2                      \n"
+      "lea         (%0,%3),%0                    \n"
+      "movdqu      %%xmm0,(%1)                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "jg          1b                            \n"
+      : "+r"(src),            // %0
+        "+r"(dst),            // %1
+        "+r"(width)           // %2
+      : "r"(src_tile_stride)  // %3
+      : "cc", "memory", "xmm0");
+}
+#endif  // HAS_DETILEROW_SSE2
+
+#ifdef HAS_DETILESPLITUVROW_SSSE3
+// Shuffle 8 U's to the low half and 8 V's to the high half.
+static const uvec8 kDeinterlaceUV = {0, 2, 4, 6, 8, 10, 12, 14,
+                                     1, 3, 5, 7, 9, 11, 13, 15};
+
+// Detile one 16 byte wide UV tile row into 8 U's and 8 V's per loop.
+void DetileSplitUVRow_SSSE3(const uint8_t* src_uv,
+                            ptrdiff_t src_tile_stride,
+                            uint8_t* dst_u,
+                            uint8_t* dst_v,
+                            int width) {
+  asm volatile(
+      "movdqu      %4,%%xmm1                     \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "lea         (%0,%5),%0                    \n"
+      "pshufb      %%xmm1,%%xmm0                 \n"
+      "movq        %%xmm0,(%1)                   \n"
+      "lea         0x8(%1),%1                    \n"
+      "movhps      %%xmm0,(%2)                   \n"
+      "lea         0x8(%2),%2                    \n"
+      "sub         $0x10,%3                      \n"
+      "jg          1b                            \n"
+      : "+r"(src_uv),         // %0
+        "+r"(dst_u),          // %1
+        "+r"(dst_v),          // %2
+        "+r"(width)           // %3
+      : "m"(kDeinterlaceUV),  // %4
+        "r"(src_tile_stride)  // %5
+      : "cc", "memory", "xmm0", "xmm1");
+}
+#endif  // HAS_DETILESPLITUVROW_SSSE3
+
 #ifdef HAS_SPLITUVROW_SSE2
 void SplitUVRow_SSE2(const uint8_t* src_uv,
                      uint8_t* dst_u,
@@ -8275,6 +9355,156 @@ void InterpolateRow_AVX2(uint8_t* dst_ptr,
 }
 #endif  // HAS_INTERPOLATEROW_AVX2
 
+#ifdef HAS_INTERPOLATEROW_16_SSE2
+// Bilinear filter 8x2 -> 8x1 for 16 bit pixels.  The pixels are biased by
+// 0x8000 so that pmaddwd can weight them and packssdw can pack the result.
+void InterpolateRow_16_SSE2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int dst_width,
+                            int source_y_fraction) {
+  asm volatile(
+      "sub         %1,%0                         \n"
+      "cmp         $0x0,%3                       \n"
+      "je          100f                          \n"
+      "cmp         $0x80,%3                      \n"
+      "je          50f                           \n"
+
+      "movd        %3,%%xmm0                     \n"
+      "neg         %3                            \n"
+      "add         $0x100,%3                     \n"
+      "movd        %3,%%xmm5                     \n"
+      "punpcklwd   %%xmm0,%%xmm5                 \n"
+      "pshufd      $0x0,%%xmm5,%%xmm5            \n"
+      "pcmpeqb     %%xmm4,%%xmm4                 \n"
+      "psllw       $0xf,%%xmm4                   \n"  // 0x8000
+
+      // General purpose row blend.
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%1),%%xmm0                   \n"
+      "movdqu      0x00(%1,%4,2),%%xmm2          \n"
+      "pxor        %%xmm4,%%xmm0                 \n"
+      "pxor        %%xmm4,%%xmm2                 \n"
+      "movdqa      %%xmm0,%%xmm1                 \n"
+      "punpcklwd   %%xmm2,%%xmm0                 \n"
+      "punpckhwd   %%xmm2,%%xmm1                 \n"
+      "pmaddwd     %%xmm5,%%xmm0                 \n"
+      "pmaddwd     %%xmm5,%%xmm1                 \n"
+      "psrad       $0x8,%%xmm0                   \n"
+      "psrad       $0x8,%%xmm1                   \n"
+      "packssdw    %%xmm1,%%xmm0                 \n"
+      "pxor        %%xmm4,%%xmm0                 \n"
+      "movdqu      %%xmm0,0x00(%1,%0,1)          \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "jmp         99f                           \n"
+
+      // Blend 50 / 50.
+      LABELALIGN
+      "50:                                       \n"
+      "movdqu      (%1),%%xmm0                   \n"
+      "movdqu      0x00(%1,%4,2),%%xmm1          \n"
+      "pavgw       %%xmm1,%%xmm0                 \n"
+      "movdqu      %%xmm0,0x00(%1,%0,1)          \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          50b                           \n"
+      "jmp         99f                           \n"
+
+      // Blend 100 / 0 - Copy row unchanged.
+      LABELALIGN
+      "100:                                      \n"
+      "movdqu      (%1),%%xmm0                   \n"
+      "movdqu      %%xmm0,0x00(%1,%0,1)          \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          100b                          \n"
+
+      "99:                                       \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(src_ptr),               // %1
+        "+rm"(dst_width),            // %2
+        "+r"(source_y_fraction)      // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5");
+}
+#endif  // HAS_INTERPOLATEROW_16_SSE2
+
+#ifdef HAS_INTERPOLATEROW_16_AVX2
+// Bilinear filter 16x2 -> 16x1 for 16 bit pixels.
+void InterpolateRow_16_AVX2(uint16_t* dst_ptr,
+                            const uint16_t* src_ptr,
+                            ptrdiff_t src_stride,
+                            int dst_width,
+                            int source_y_fraction) {
+  asm volatile(
+      "sub         %1,%0                         \n"
+      "cmp         $0x0,%3                       \n"
+      "je          100f                          \n"
+      "cmp         $0x80,%3                      \n"
+      "je          50f                           \n"
+
+      "vmovd       %3,%%xmm0                     \n"
+      "neg         %3                            \n"
+      "add         $0x100,%3                     \n"
+      "vmovd       %3,%%xmm5                     \n"
+      "vpunpcklwd  %%xmm0,%%xmm5,%%xmm5          \n"
+      "vbroadcastss %%xmm5,%%ymm5                \n"
+      "vpcmpeqb    %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpsllw      $0xf,%%ymm4,%%ymm4            \n"  // 0x8000
+
+      // General purpose row blend.
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor       (%1),%%ymm4,%%ymm0            \n"
+      "vpxor       0x00(%1,%4,2),%%ymm4,%%ymm2   \n"
+      "vpunpckhwd  %%ymm2,%%ymm0,%%ymm1          \n"
+      "vpunpcklwd  %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpmaddwd    %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpsrad      $0x8,%%ymm1,%%ymm1            \n"
+      "vpsrad      $0x8,%%ymm0,%%ymm0            \n"
+      "vpackssdw   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpxor       %%ymm4,%%ymm0,%%ymm0          \n"
+      "vmovdqu     %%ymm0,0x00(%1,%0,1)          \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "jmp         99f                           \n"
+
+      // Blend 50 / 50.
+      LABELALIGN
+      "50:                                       \n"
+      "vmovdqu     (%1),%%ymm0                   \n"
+      "vpavgw      0x00(%1,%4,2),%%ymm0,%%ymm0   \n"
+      "vmovdqu     %%ymm0,0x00(%1,%0,1)          \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          50b                           \n"
+      "jmp         99f                           \n"
+
+      // Blend 100 / 0 - Copy row unchanged.
+      LABELALIGN
+      "100:                                      \n"
+      "vmovdqu     (%1),%%ymm0                   \n"
+      "vmovdqu     %%ymm0,0x00(%1,%0,1)          \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          100b                          \n"
+
+      "99:                                       \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(src_ptr),               // %1
+        "+rm"(dst_width),            // %2
+        "+r"(source_y_fraction)      // %3
+      : "r"((intptr_t)(src_stride))  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5");
+}
+#endif  // HAS_INTERPOLATEROW_16_AVX2
+
 #ifdef HAS_ARGBSHUFFLEROW_SSSE3
 // For BGRAToARGB, ABGRToARGB, RGBAToARGB, and ARGBToRGBA.
 void ARGBShuffleRow_SSSE3(const uint8_t* src_argb,
@@ -8729,6 +9959,151 @@ void HalfFloat1Row_F16C(const uint16_t* src, uint16_t* dst, float, int width) {
 }
 #endif  // HAS_HALFFLOATROW_F16C
 
+#ifdef HAS_ARGBTORGBFLOATROW_AVX2
+// Normalize 8 ARGB pixels to 8 R, 8 G and 8 B floats per loop.
+void ARGBToRGBFloatRow_AVX2(const uint8_t* src_argb,
+                            float* dst_r,
+                            float* dst_g,
+                            float* dst_b,
+                            const struct RGBNormConstants* norm,
+                            int width) {
+  asm volatile(
+      "vbroadcastss (%5),%%ymm4                  \n"  // kScale
+      "vbroadcastss 0x4(%5),%%ymm5               \n"
+      "vbroadcastss 0x8(%5),%%ymm6               \n"
+      "vpcmpeqb    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpsrld      $0x18,%%ymm7,%%ymm7           \n"  // 0x000000ff
+      "sub         %1,%2                         \n"
+      "sub         %1,%3                         \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vpsrld      $0x10,%%ymm0,%%ymm1           \n"  // R
+      "vpand       %%ymm7,%%ymm1,%%ymm1          \n"
+      "vcvtdq2ps   %%ymm1,%%ymm1                 \n"
+      "vbroadcastss 0x10(%5),%%ymm3              \n"  // kBias
+      "vmulps      %%ymm4,%%ymm1,%%ymm1          \n"
+      "vaddps      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovups     %%ymm1,(%1)                   \n"
+      "vpsrld      $0x8,%%ymm0,%%ymm2            \n"  // G
+      "vpand       %%ymm7,%%ymm2,%%ymm2          \n"
+      "vcvtdq2ps   %%ymm2,%%ymm2                 \n"
+      "vbroadcastss 0x14(%5),%%ymm3              \n"
+      "vmulps      %%ymm5,%%ymm2,%%ymm2          \n"
+      "vaddps      %%ymm3,%%ymm2,%%ymm2          \n"
+      "vmovups     %%ymm2,(%1,%2,1)              \n"
+      "vpand       %%ymm7,%%ymm0,%%ymm0          \n"  // B
+      "vcvtdq2ps   %%ymm0,%%ymm0                 \n"
+      "vbroadcastss 0x18(%5),%%ymm3              \n"
+      "vmulps      %%ymm6,%%ymm0,%%ymm0          \n"
+      "vaddps      %%ymm3,%%ymm0,%%ymm0          \n"
+      "vmovups     %%ymm0,(%1,%3,1)              \n"
+      "lea         0x20(%0),%0                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x8,%4                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_argb),  // %0
+        "+r"(dst_r),     // %1
+        "+r"(dst_g),     // %2
+        "+r"(dst_b),     // %3
+        "+r"(width)      // %4
+      : "r"(norm)        // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_ARGBTORGBFLOATROW_AVX2
+
+#ifdef HAS_RAWTOFLOATROW_AVX2
+// Normalize 8 RAW pixels to 24 packed RGB floats per loop.  The kScaleRGB and
+// kBiasRGB vectors line up with the channels since each loop stores 24 floats.
+void RAWToFloatRow_AVX2(const uint8_t* src_raw,
+                        float* dst,
+                        const struct RGBNormConstants* norm,
+                        int width) {
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "vpmovzxbd   (%0),%%ymm0                   \n"  // 8 bytes -> 8 ints
+      "vpmovzxbd   0x8(%0),%%ymm1                \n"
+      "vpmovzxbd   0x10(%0),%%ymm2               \n"
+      "vcvtdq2ps   %%ymm0,%%ymm0                 \n"
+      "vcvtdq2ps   %%ymm1,%%ymm1                 \n"
+      "vcvtdq2ps   %%ymm2,%%ymm2                 \n"
+      "vmulps      0x20(%3),%%ymm0,%%ymm0        \n"  // kScaleRGB
+      "vmulps      0x40(%3),%%ymm1,%%ymm1        \n"
+      "vmulps      0x60(%3),%%ymm2,%%ymm2        \n"
+      "vaddps      0x80(%3),%%ymm0,%%ymm0        \n"  // kBiasRGB
+      "vaddps      0xa0(%3),%%ymm1,%%ymm1        \n"
+      "vaddps      0xc0(%3),%%ymm2,%%ymm2        \n"
+      "vmovups     %%ymm0,(%1)                   \n"
+      "vmovups     %%ymm1,0x20(%1)               \n"
+      "vmovups     %%ymm2,0x40(%1)               \n"
+      "lea         0x18(%0),%0                   \n"
+      "lea         0x60(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_raw),  // %0
+        "+r"(dst),      // %1
+        "+r"(width)     // %2
+      : "r"(norm)       // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2");
+}
+#endif  // HAS_RAWTOFLOATROW_AVX2
+
+#ifdef HAS_FLOATTOHALFROW_AVX2
+static const float kFloatToHalfMax = 65504.f;
+static const float kFloatToHalfMagic = 1.9259299444e-34f;  // 2^-112
+
+// Convert 16 floats to half floats per loop, with the same magic constant as
+// HalfFloatRow_AVX2 applied to the magnitude and the sign copied over.
+void FloatToHalfRow_AVX2(const float* src, uint16_t* dst, int width) {
+  asm volatile(
+      "vbroadcastss %3,%%ymm4                    \n"
+      "vbroadcastss %4,%%ymm5                    \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1,%%ymm6,%%ymm7            \n"  // 0x7fffffff
+      "vpsrld      $0x1f,%%ymm6,%%ymm6           \n"
+      "vpslld      $0xf,%%ymm6,%%ymm6            \n"  // 0x00008000
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovups     (%0),%%ymm0                   \n"
+      "vmovups     0x20(%0),%%ymm1               \n"
+      "vandps      %%ymm7,%%ymm0,%%ymm2          \n"  // abs
+      "vandps      %%ymm7,%%ymm1,%%ymm3          \n"
+      "vminps      %%ymm4,%%ymm2,%%ymm2          \n"
+      "vminps      %%ymm4,%%ymm3,%%ymm3          \n"
+      "vmulps      %%ymm5,%%ymm2,%%ymm2          \n"
+      "vmulps      %%ymm5,%%ymm3,%%ymm3          \n"
+      "vpsrld      $0xd,%%ymm2,%%ymm2            \n"
+      "vpsrld      $0xd,%%ymm3,%%ymm3            \n"
+      "vpsrld      $0x10,%%ymm0,%%ymm0           \n"  // sign
+      "vpsrld      $0x10,%%ymm1,%%ymm1           \n"
+      "vpand       %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpand       %%ymm6,%%ymm1,%%ymm1          \n"
+      "vpor        %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpor        %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpackusdw   %%ymm1,%%ymm0,%%ymm0          \n"  // mutates
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x40(%0),%0                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src),              // %0
+        "+r"(dst),              // %1
+        "+r"(width)             // %2
+      : "m"(kFloatToHalfMax),   // %3
+        "m"(kFloatToHalfMagic)  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_FLOATTOHALFROW_AVX2
+
 #ifdef HAS_ARGBCOLORTABLEROW_X86
 // Tranform ARGB pixels with color table.
 void ARGBColorTableRow_X86(uint8_t* dst_argb,
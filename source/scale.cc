@@ -16,9 +16,12 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyPlane
 #include "libyuv/row.h"
+#include "libyuv/scale_argb.h"  // For ARGBScale_WithScratch
 #include "libyuv/scale_row.h"
 #include "libyuv/scale_uv.h"  // For UVScale
 
+#include "profile_internal.h"  // For ProfileStart
+
 #ifdef __cplusplus
 namespace libyuv {
 extern "C" {
@@ -28,35 +31,26 @@ static __inline int Abs(int v) {
   return v >= 0 ? v : -v;
 }
 
+// Advance a 16.16 fixed point source position by clip_y destination rows.
+static __inline int ScaleClipY(int y, int dy, int clip_y) {
+  return (int)(y + (int64_t)clip_y * dy);
+}
+
 #define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
 
 // Scale plane, 1/2
 // This is an optimized version for scaling down a plane to 1/2 of
 // its original size.
 
-static void ScalePlaneDown2(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_ptr,
-                            uint8_t* dst_ptr,
-                            enum FilterMode filtering) {
-  int y;
+static void ScalePlaneDown2Init(ScalePlaneScaler* s) {
+  const int dst_width = s->dst_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleRowDown2)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                         uint8_t* dst_ptr, int dst_width) =
       filtering == kFilterNone
           ? ScaleRowDown2_C
           : (filtering == kFilterLinear ? ScaleRowDown2Linear_C
                                         : ScaleRowDown2Box_C);
-  int row_stride = src_stride << 1;
-  (void)src_width;
-  (void)src_height;
-  if (!filtering) {
-    src_ptr += src_stride;  // Point to odd rows.
-    src_stride = 0;
-  }
 
 #if defined(HAS_SCALEROWDOWN2_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
@@ -134,13 +128,27 @@ static void ScalePlaneDown2(int src_width,
     }
   }
 #endif
+  s->ScaleRowDown = ScaleRowDown2;
+}
 
-  if (filtering == kFilterLinear) {
+static void ScalePlaneDown2(const ScalePlaneScaler* s,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_ptr,
+                            uint8_t* dst_ptr) {
+  int y;
+  int row_stride = src_stride << 1;
+  if (!s->filtering) {
+    src_ptr += src_stride;  // Point to odd rows.
+    src_stride = 0;
+  }
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   // TODO(fbarchard): Loop through source height to allow odd height.
   for (y = 0; y < dst_height; ++y) {
-    ScaleRowDown2(src_ptr, src_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, src_stride, dst_ptr, s->dst_width);
     src_ptr += row_stride;
     dst_ptr += dst_stride;
   }
@@ -154,6 +162,8 @@ static void ScalePlaneDown2_16(int src_width,
                                int dst_stride,
                                const uint16_t* src_ptr,
                                uint16_t* dst_ptr,
+                               int clip_y,
+                               int clip_height,
                                enum FilterMode filtering) {
   int y;
   void (*ScaleRowDown2)(const uint16_t* src_ptr, ptrdiff_t src_stride,
@@ -165,24 +175,59 @@ static void ScalePlaneDown2_16(int src_width,
   int row_stride = src_stride << 1;
   (void)src_width;
   (void)src_height;
+  (void)dst_height;
+  src_ptr += (ptrdiff_t)clip_y * row_stride;
   if (!filtering) {
     src_ptr += src_stride;  // Point to odd rows.
     src_stride = 0;
   }
 
 #if defined(HAS_SCALEROWDOWN2_16_NEON)
-  if (TestCpuFlag(kCpuHasNEON) && IS_ALIGNED(dst_width, 16)) {
+  if (TestCpuFlag(kCpuHasNEON)) {
     ScaleRowDown2 =
-        filtering ? ScaleRowDown2Box_16_NEON : ScaleRowDown2_16_NEON;
+        filtering == kFilterNone
+            ? ScaleRowDown2_16_Any_NEON
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_Any_NEON
+                                          : ScaleRowDown2Box_16_Any_NEON);
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_NEON
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_NEON
+                                            : ScaleRowDown2Box_16_NEON);
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_SSE2)
-  if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 16)) {
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleRowDown2 =
+        filtering == kFilterNone
+            ? ScaleRowDown2_16_Any_SSE2
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_Any_SSE2
+                                          : ScaleRowDown2Box_16_Any_SSE2);
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_SSE2
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2
+                                            : ScaleRowDown2Box_16_SSE2);
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN2_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
     ScaleRowDown2 =
         filtering == kFilterNone
-            ? ScaleRowDown2_16_SSE2
-            : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_SSE2
-                                          : ScaleRowDown2Box_16_SSE2);
+            ? ScaleRowDown2_16_Any_AVX2
+            : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_Any_AVX2
+                                          : ScaleRowDown2Box_16_Any_AVX2);
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleRowDown2 =
+          filtering == kFilterNone
+              ? ScaleRowDown2_16_AVX2
+              : (filtering == kFilterLinear ? ScaleRowDown2Linear_16_AVX2
+                                            : ScaleRowDown2Box_16_AVX2);
+    }
   }
 #endif
 #if defined(HAS_SCALEROWDOWN2_16_MMI)
@@ -198,7 +243,7 @@ static void ScalePlaneDown2_16(int src_width,
     src_stride = 0;
   }
   // TODO(fbarchard): Loop through source height to allow odd height.
-  for (y = 0; y < dst_height; ++y) {
+  for (y = 0; y < clip_height; ++y) {
     ScaleRowDown2(src_ptr, src_stride, dst_ptr, dst_width);
     src_ptr += row_stride;
     dst_ptr += dst_stride;
@@ -209,26 +254,12 @@ static void ScalePlaneDown2_16(int src_width,
 // This is an optimized version for scaling down a plane to 1/4 of
 // its original size.
 
-static void ScalePlaneDown4(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_ptr,
-                            uint8_t* dst_ptr,
-                            enum FilterMode filtering) {
-  int y;
+static void ScalePlaneDown4Init(ScalePlaneScaler* s) {
+  const int dst_width = s->dst_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleRowDown4)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                         uint8_t* dst_ptr, int dst_width) =
       filtering ? ScaleRowDown4Box_C : ScaleRowDown4_C;
-  int row_stride = src_stride << 2;
-  (void)src_width;
-  (void)src_height;
-  if (!filtering) {
-    src_ptr += src_stride * 2;  // Point to row 2.
-    src_stride = 0;
-  }
 #if defined(HAS_SCALEROWDOWN4_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ScaleRowDown4 =
@@ -274,12 +305,26 @@ static void ScalePlaneDown4(int src_width,
     }
   }
 #endif
+  s->ScaleRowDown = ScaleRowDown4;
+}
 
-  if (filtering == kFilterLinear) {
+static void ScalePlaneDown4(const ScalePlaneScaler* s,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_ptr,
+                            uint8_t* dst_ptr) {
+  int y;
+  int row_stride = src_stride << 2;
+  if (!s->filtering) {
+    src_ptr += src_stride * 2;  // Point to row 2.
+    src_stride = 0;
+  }
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   for (y = 0; y < dst_height; ++y) {
-    ScaleRowDown4(src_ptr, src_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, src_stride, dst_ptr, s->dst_width);
     src_ptr += row_stride;
     dst_ptr += dst_stride;
   }
@@ -293,6 +338,8 @@ static void ScalePlaneDown4_16(int src_width,
                                int dst_stride,
                                const uint16_t* src_ptr,
                                uint16_t* dst_ptr,
+                               int clip_y,
+                               int clip_height,
                                enum FilterMode filtering) {
   int y;
   void (*ScaleRowDown4)(const uint16_t* src_ptr, ptrdiff_t src_stride,
@@ -301,6 +348,8 @@ static void ScalePlaneDown4_16(int src_width,
   int row_stride = src_stride << 2;
   (void)src_width;
   (void)src_height;
+  (void)dst_height;
+  src_ptr += (ptrdiff_t)clip_y * row_stride;
   if (!filtering) {
     src_ptr += src_stride * 2;  // Point to row 2.
     src_stride = 0;
@@ -326,7 +375,7 @@ static void ScalePlaneDown4_16(int src_width,
   if (filtering == kFilterLinear) {
     src_stride = 0;
   }
-  for (y = 0; y < dst_height; ++y) {
+  for (y = 0; y < clip_height; ++y) {
     ScaleRowDown4(src_ptr, src_stride, dst_ptr, dst_width);
     src_ptr += row_stride;
     dst_ptr += dst_stride;
@@ -334,23 +383,13 @@ static void ScalePlaneDown4_16(int src_width,
 }
 
 // Scale plane down, 3/4
-static void ScalePlaneDown34(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             int src_stride,
-                             int dst_stride,
-                             const uint8_t* src_ptr,
-                             uint8_t* dst_ptr,
-                             enum FilterMode filtering) {
-  int y;
+static void ScalePlaneDown34Init(ScalePlaneScaler* s) {
+  const int dst_width = s->dst_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleRowDown34_0)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                            uint8_t* dst_ptr, int dst_width);
   void (*ScaleRowDown34_1)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                            uint8_t* dst_ptr, int dst_width);
-  const int filter_stride = (filtering == kFilterLinear) ? 0 : src_stride;
-  (void)src_width;
-  (void)src_height;
   assert(dst_width % 3 == 0);
   if (!filtering) {
     ScaleRowDown34_0 = ScaleRowDown34_C;
@@ -431,27 +470,58 @@ static void ScalePlaneDown34(int src_width,
     }
   }
 #endif
+#if defined(HAS_SCALEROWDOWN34_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    if (!filtering) {
+      ScaleRowDown34_0 = ScaleRowDown34_Any_AVX2;
+      ScaleRowDown34_1 = ScaleRowDown34_Any_AVX2;
+      if (dst_width % 48 == 0) {
+        ScaleRowDown34_0 = ScaleRowDown34_AVX2;
+        ScaleRowDown34_1 = ScaleRowDown34_AVX2;
+      }
+    } else {
+      ScaleRowDown34_0 = ScaleRowDown34_0_Box_Any_AVX2;
+      ScaleRowDown34_1 = ScaleRowDown34_1_Box_Any_AVX2;
+      if (dst_width % 48 == 0) {
+        ScaleRowDown34_0 = ScaleRowDown34_0_Box_AVX2;
+        ScaleRowDown34_1 = ScaleRowDown34_1_Box_AVX2;
+      }
+    }
+  }
+#endif
+  s->ScaleRowDown = ScaleRowDown34_0;
+  s->ScaleRowDownAlt = ScaleRowDown34_1;
+}
 
+static void ScalePlaneDown34(const ScalePlaneScaler* s,
+                             int dst_height,
+                             int src_stride,
+                             int dst_stride,
+                             const uint8_t* src_ptr,
+                             uint8_t* dst_ptr) {
+  int y;
+  const int dst_width = s->dst_width;
+  const int filter_stride = (s->filtering == kFilterLinear) ? 0 : src_stride;
   for (y = 0; y < dst_height - 2; y += 3) {
-    ScaleRowDown34_0(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
-    ScaleRowDown34_1(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDownAlt(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
-    ScaleRowDown34_0(src_ptr + src_stride, -filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr + src_stride, -filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 2;
     dst_ptr += dst_stride;
   }
 
   // Remainder 1 or 2 rows with last row vertically unfiltered
   if ((dst_height % 3) == 2) {
-    ScaleRowDown34_0(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
-    ScaleRowDown34_1(src_ptr, 0, dst_ptr, dst_width);
+    s->ScaleRowDownAlt(src_ptr, 0, dst_ptr, dst_width);
   } else if ((dst_height % 3) == 1) {
-    ScaleRowDown34_0(src_ptr, 0, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, 0, dst_ptr, dst_width);
   }
 }
 
@@ -463,6 +533,8 @@ static void ScalePlaneDown34_16(int src_width,
                                 int dst_stride,
                                 const uint16_t* src_ptr,
                                 uint16_t* dst_ptr,
+                                int clip_y,
+                                int clip_height,
                                 enum FilterMode filtering) {
   int y;
   void (*ScaleRowDown34_0)(const uint16_t* src_ptr, ptrdiff_t src_stride,
@@ -472,7 +544,12 @@ static void ScalePlaneDown34_16(int src_width,
   const int filter_stride = (filtering == kFilterLinear) ? 0 : src_stride;
   (void)src_width;
   (void)src_height;
+  (void)dst_height;
   assert(dst_width % 3 == 0);
+  // Groups of 3 destination rows read 4 source rows, so clips start on a
+  // group.
+  assert(clip_y % 3 == 0);
+  src_ptr += (ptrdiff_t)(clip_y / 3 * 4) * src_stride;
   if (!filtering) {
     ScaleRowDown34_0 = ScaleRowDown34_16_C;
     ScaleRowDown34_1 = ScaleRowDown34_16_C;
@@ -503,7 +580,7 @@ static void ScalePlaneDown34_16(int src_width,
   }
 #endif
 
-  for (y = 0; y < dst_height - 2; y += 3) {
+  for (y = 0; y < clip_height - 2; y += 3) {
     ScaleRowDown34_0(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
@@ -516,12 +593,12 @@ static void ScalePlaneDown34_16(int src_width,
   }
 
   // Remainder 1 or 2 rows with last row vertically unfiltered
-  if ((dst_height % 3) == 2) {
+  if ((clip_height % 3) == 2) {
     ScaleRowDown34_0(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride;
     dst_ptr += dst_stride;
     ScaleRowDown34_1(src_ptr, 0, dst_ptr, dst_width);
-  } else if ((dst_height % 3) == 1) {
+  } else if ((clip_height % 3) == 1) {
     ScaleRowDown34_0(src_ptr, 0, dst_ptr, dst_width);
   }
 }
@@ -541,24 +618,14 @@ static void ScalePlaneDown34_16(int src_width,
 // ggghhhii
 // Boxes are 3x3, 2x3, 3x2 and 2x2
 
-static void ScalePlaneDown38(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             int src_stride,
-                             int dst_stride,
-                             const uint8_t* src_ptr,
-                             uint8_t* dst_ptr,
-                             enum FilterMode filtering) {
-  int y;
+static void ScalePlaneDown38Init(ScalePlaneScaler* s) {
+  const int dst_width = s->dst_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleRowDown38_3)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                            uint8_t* dst_ptr, int dst_width);
   void (*ScaleRowDown38_2)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                            uint8_t* dst_ptr, int dst_width);
-  const int filter_stride = (filtering == kFilterLinear) ? 0 : src_stride;
   assert(dst_width % 3 == 0);
-  (void)src_width;
-  (void)src_height;
   if (!filtering) {
     ScaleRowDown38_3 = ScaleRowDown38_C;
     ScaleRowDown38_2 = ScaleRowDown38_C;
@@ -606,6 +673,46 @@ static void ScalePlaneDown38(int src_width,
     }
   }
 #endif
+#if defined(HAS_SCALEROWDOWN38_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    if (!filtering) {
+      ScaleRowDown38_3 = ScaleRowDown38_Any_AVX2;
+      ScaleRowDown38_2 = ScaleRowDown38_Any_AVX2;
+    } else {
+      ScaleRowDown38_3 = ScaleRowDown38_3_Box_Any_AVX2;
+      ScaleRowDown38_2 = ScaleRowDown38_2_Box_Any_AVX2;
+    }
+    if (dst_width % 24 == 0) {
+      if (!filtering) {
+        ScaleRowDown38_3 = ScaleRowDown38_AVX2;
+        ScaleRowDown38_2 = ScaleRowDown38_AVX2;
+      } else {
+        ScaleRowDown38_3 = ScaleRowDown38_3_Box_AVX2;
+        ScaleRowDown38_2 = ScaleRowDown38_2_Box_AVX2;
+      }
+    }
+  }
+#endif
+#if defined(HAS_SCALEROWDOWN38_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    if (!filtering) {
+      ScaleRowDown38_3 = ScaleRowDown38_Any_AVX512BW;
+      ScaleRowDown38_2 = ScaleRowDown38_Any_AVX512BW;
+    } else {
+      ScaleRowDown38_3 = ScaleRowDown38_3_Box_Any_AVX512BW;
+      ScaleRowDown38_2 = ScaleRowDown38_2_Box_Any_AVX512BW;
+    }
+    if (dst_width % 48 == 0) {
+      if (!filtering) {
+        ScaleRowDown38_3 = ScaleRowDown38_AVX512BW;
+        ScaleRowDown38_2 = ScaleRowDown38_AVX512BW;
+      } else {
+        ScaleRowDown38_3 = ScaleRowDown38_3_Box_AVX512BW;
+        ScaleRowDown38_2 = ScaleRowDown38_2_Box_AVX512BW;
+      }
+    }
+  }
+#endif
 #if defined(HAS_SCALEROWDOWN38_MSA)
   if (TestCpuFlag(kCpuHasMSA)) {
     if (!filtering) {
@@ -626,27 +733,39 @@ static void ScalePlaneDown38(int src_width,
     }
   }
 #endif
+  s->ScaleRowDown = ScaleRowDown38_3;
+  s->ScaleRowDownAlt = ScaleRowDown38_2;
+}
 
+static void ScalePlaneDown38(const ScalePlaneScaler* s,
+                             int dst_height,
+                             int src_stride,
+                             int dst_stride,
+                             const uint8_t* src_ptr,
+                             uint8_t* dst_ptr) {
+  int y;
+  const int dst_width = s->dst_width;
+  const int filter_stride = (s->filtering == kFilterLinear) ? 0 : src_stride;
   for (y = 0; y < dst_height - 2; y += 3) {
-    ScaleRowDown38_3(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 3;
     dst_ptr += dst_stride;
-    ScaleRowDown38_3(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 3;
     dst_ptr += dst_stride;
-    ScaleRowDown38_2(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDownAlt(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 2;
     dst_ptr += dst_stride;
   }
 
   // Remainder 1 or 2 rows with last row vertically unfiltered
   if ((dst_height % 3) == 2) {
-    ScaleRowDown38_3(src_ptr, filter_stride, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 3;
     dst_ptr += dst_stride;
-    ScaleRowDown38_3(src_ptr, 0, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, 0, dst_ptr, dst_width);
   } else if ((dst_height % 3) == 1) {
-    ScaleRowDown38_3(src_ptr, 0, dst_ptr, dst_width);
+    s->ScaleRowDown(src_ptr, 0, dst_ptr, dst_width);
   }
 }
 
@@ -658,6 +777,8 @@ static void ScalePlaneDown38_16(int src_width,
                                 int dst_stride,
                                 const uint16_t* src_ptr,
                                 uint16_t* dst_ptr,
+                                int clip_y,
+                                int clip_height,
                                 enum FilterMode filtering) {
   int y;
   void (*ScaleRowDown38_3)(const uint16_t* src_ptr, ptrdiff_t src_stride,
@@ -667,7 +788,12 @@ static void ScalePlaneDown38_16(int src_width,
   const int filter_stride = (filtering == kFilterLinear) ? 0 : src_stride;
   (void)src_width;
   (void)src_height;
+  (void)dst_height;
   assert(dst_width % 3 == 0);
+  // Groups of 3 destination rows read 8 source rows, so clips start on a
+  // group.
+  assert(clip_y % 3 == 0);
+  src_ptr += (ptrdiff_t)(clip_y / 3 * 8) * src_stride;
   if (!filtering) {
     ScaleRowDown38_3 = ScaleRowDown38_16_C;
     ScaleRowDown38_2 = ScaleRowDown38_16_C;
@@ -698,7 +824,7 @@ static void ScalePlaneDown38_16(int src_width,
   }
 #endif
 
-  for (y = 0; y < dst_height - 2; y += 3) {
+  for (y = 0; y < clip_height - 2; y += 3) {
     ScaleRowDown38_3(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 3;
     dst_ptr += dst_stride;
@@ -711,12 +837,12 @@ static void ScalePlaneDown38_16(int src_width,
   }
 
   // Remainder 1 or 2 rows with last row vertically unfiltered
-  if ((dst_height % 3) == 2) {
+  if ((clip_height % 3) == 2) {
     ScaleRowDown38_3(src_ptr, filter_stride, dst_ptr, dst_width);
     src_ptr += src_stride * 3;
     dst_ptr += dst_stride;
     ScaleRowDown38_3(src_ptr, 0, dst_ptr, dst_width);
-  } else if ((dst_height % 3) == 1) {
+  } else if ((clip_height % 3) == 1) {
     ScaleRowDown38_3(src_ptr, 0, dst_ptr, dst_width);
   }
 }
@@ -840,78 +966,81 @@ static void ScaleAddCols1_16_C(int dst_width,
 // one pixel of destination using fixed point (16.16) to step
 // through source, sampling a box of pixel with simple
 // averaging.
-static void ScalePlaneBox(int src_width,
-                          int src_height,
-                          int dst_width,
-                          int dst_height,
-                          int src_stride,
-                          int dst_stride,
-                          const uint8_t* src_ptr,
-                          uint8_t* dst_ptr) {
-  int j, k;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  const int max_y = (src_height << 16);
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-  {
-    // Allocate a row buffer of uint16_t.
-    align_buffer_64(row16, src_width * 2);
-    void (*ScaleAddCols)(int dst_width, int boxheight, int x, int dx,
-                         const uint16_t* src_ptr, uint8_t* dst_ptr) =
-        (dx & 0xffff) ? ScaleAddCols2_C
-                      : ((dx != 0x10000) ? ScaleAddCols1_C : ScaleAddCols0_C);
-    void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr,
-                        int src_width) = ScaleAddRow_C;
+static void ScalePlaneBoxInit(ScalePlaneScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dx = s->dx;
+  void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr,
+                      int src_width) = ScaleAddRow_C;
 #if defined(HAS_SCALEADDROW_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2)) {
-      ScaleAddRow = ScaleAddRow_Any_SSE2;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_SSE2;
-      }
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleAddRow = ScaleAddRow_Any_SSE2;
+    if (IS_ALIGNED(src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_SSE2;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_AVX2)
-    if (TestCpuFlag(kCpuHasAVX2)) {
-      ScaleAddRow = ScaleAddRow_Any_AVX2;
-      if (IS_ALIGNED(src_width, 32)) {
-        ScaleAddRow = ScaleAddRow_AVX2;
-      }
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleAddRow = ScaleAddRow_Any_AVX2;
+    if (IS_ALIGNED(src_width, 32)) {
+      ScaleAddRow = ScaleAddRow_AVX2;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_NEON)
-    if (TestCpuFlag(kCpuHasNEON)) {
-      ScaleAddRow = ScaleAddRow_Any_NEON;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_NEON;
-      }
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ScaleAddRow = ScaleAddRow_Any_NEON;
+    if (IS_ALIGNED(src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_NEON;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_MMI)
-    if (TestCpuFlag(kCpuHasMMI)) {
-      ScaleAddRow = ScaleAddRow_Any_MMI;
-      if (IS_ALIGNED(src_width, 8)) {
-        ScaleAddRow = ScaleAddRow_MMI;
-      }
+  if (TestCpuFlag(kCpuHasMMI)) {
+    ScaleAddRow = ScaleAddRow_Any_MMI;
+    if (IS_ALIGNED(src_width, 8)) {
+      ScaleAddRow = ScaleAddRow_MMI;
     }
+  }
 #endif
 #if defined(HAS_SCALEADDROW_MSA)
-    if (TestCpuFlag(kCpuHasMSA)) {
-      ScaleAddRow = ScaleAddRow_Any_MSA;
-      if (IS_ALIGNED(src_width, 16)) {
-        ScaleAddRow = ScaleAddRow_MSA;
-      }
+  if (TestCpuFlag(kCpuHasMSA)) {
+    ScaleAddRow = ScaleAddRow_Any_MSA;
+    if (IS_ALIGNED(src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_MSA;
     }
+  }
 #endif
+  s->ScaleAddRow = ScaleAddRow;
+  s->ScaleAddCols =
+      (dx & 0xffff) ? ScaleAddCols2_C
+                    : ((dx != 0x10000) ? ScaleAddCols1_C : ScaleAddCols0_C);
+}
+
+static void ScalePlaneBox(const ScalePlaneScaler* s,
+                          int src_stride,
+                          int dst_stride,
+                          const uint8_t* src_ptr,
+                          int src_y,
+                          uint8_t* dst_ptr,
+                          int clip_y,
+                          int clip_height,
+                          const LibyuvScratch* scratch) {
+  int j, k;
+  const int src_width = Abs(s->src_width);
+  const int max_y = (Abs(s->src_height) << 16);
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
+  int y = ScaleClipY(s->y, dy, clip_y);
+  {
+    // Allocate a row buffer of uint16_t.
+    align_buffer_64_scratch(row16, src_width * 2, scratch);
 
-    for (j = 0; j < dst_height; ++j) {
+    for (j = 0; j < clip_height; ++j) {
       int boxheight;
       int iy = y >> 16;
-      const uint8_t* src = src_ptr + iy * src_stride;
+      const uint8_t* src = src_ptr + (ptrdiff_t)(iy - src_y) * src_stride;
       y += dy;
       if (y > max_y) {
         y = max_y;
@@ -919,10 +1048,11 @@ static void ScalePlaneBox(int src_width,
       boxheight = MIN1((y >> 16) - iy);
       memset(row16, 0, src_width * 2);
       for (k = 0; k < boxheight; ++k) {
-        ScaleAddRow(src, (uint16_t*)(row16), src_width);
+        s->ScaleAddRow(src, (uint16_t*)(row16), src_width);
         src += src_stride;
       }
-      ScaleAddCols(dst_width, boxheight, x, dx, (uint16_t*)(row16), dst_ptr);
+      s->ScaleAddCols(s->dst_width, boxheight, x, dx, (uint16_t*)(row16),
+                      dst_ptr);
       dst_ptr += dst_stride;
     }
     free_aligned_buffer_64(row16);
@@ -936,7 +1066,10 @@ static void ScalePlaneBox_16(int src_width,
                              int src_stride,
                              int dst_stride,
                              const uint16_t* src_ptr,
-                             uint16_t* dst_ptr) {
+                             uint16_t* dst_ptr,
+                             int clip_y,
+                             int clip_height,
+                             const LibyuvScratch* scratch) {
   int j, k;
   // Initial source x/y coordinate and step values as 16.16 fixed point.
   int x = 0;
@@ -946,10 +1079,11 @@ static void ScalePlaneBox_16(int src_width,
   const int max_y = (src_height << 16);
   ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterBox, &x, &y,
              &dx, &dy);
+  y = ScaleClipY(y, dy, clip_y);
   src_width = Abs(src_width);
   {
     // Allocate a row buffer of uint32_t.
-    align_buffer_64(row32, src_width * 4);
+    align_buffer_64_scratch(row32, src_width * 4, scratch);
     void (*ScaleAddCols)(int dst_width, int boxheight, int x, int dx,
                          const uint32_t* src_ptr, uint16_t* dst_ptr) =
         (dx & 0xffff) ? ScaleAddCols2_16_C : ScaleAddCols1_16_C;
@@ -957,8 +1091,27 @@ static void ScalePlaneBox_16(int src_width,
                         int src_width) = ScaleAddRow_16_C;
 
 #if defined(HAS_SCALEADDROW_16_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(src_width, 16)) {
-      ScaleAddRow = ScaleAddRow_16_SSE2;
+    if (TestCpuFlag(kCpuHasSSE2)) {
+      ScaleAddRow = ScaleAddRow_16_Any_SSE2;
+      if (IS_ALIGNED(src_width, 8)) {
+        ScaleAddRow = ScaleAddRow_16_SSE2;
+      }
+    }
+#endif
+#if defined(HAS_SCALEADDROW_16_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      ScaleAddRow = ScaleAddRow_16_Any_AVX2;
+      if (IS_ALIGNED(src_width, 16)) {
+        ScaleAddRow = ScaleAddRow_16_AVX2;
+      }
+    }
+#endif
+#if defined(HAS_SCALEADDROW_16_NEON)
+    if (TestCpuFlag(kCpuHasNEON)) {
+      ScaleAddRow = ScaleAddRow_16_Any_NEON;
+      if (IS_ALIGNED(src_width, 8)) {
+        ScaleAddRow = ScaleAddRow_16_NEON;
+      }
     }
 #endif
 
@@ -967,7 +1120,7 @@ static void ScalePlaneBox_16(int src_width,
       ScaleAddRow = ScaleAddRow_16_MMI;
     }
 #endif
-    for (j = 0; j < dst_height; ++j) {
+    for (j = 0; j < clip_height; ++j) {
       int boxheight;
       int iy = y >> 16;
       const uint16_t* src = src_ptr + iy * src_stride;
@@ -988,112 +1141,62 @@ static void ScalePlaneBox_16(int src_width,
   }
 }
 
+// Bilinear columns of a plane scaler.
+static void ScalePlaneFilterColsInit(ScalePlaneScaler* s,
+                                     const struct RowKernels* kernels) {
+  const int src_width = Abs(s->src_width);
+  // The AVX2 and AVX512BW columns need a source of at least 4 pixels.
+  if (src_width >= 32768) {
+    s->ScaleCols = kernels->ScaleFilterCols64;
+  } else if (src_width < 4) {
+    s->ScaleCols = ScaleFilterCols_C;
+  } else {
+    s->ScaleCols = ROW_KERNEL(kernels, ScaleFilterCols, s->dst_width);
+  }
+}
+
+static void ScalePlaneBilinearDownInit(ScalePlaneScaler* s) {
+  const struct RowKernels* kernels = GetRowKernels();
+  s->InterpolateRow = ROW_KERNEL(kernels, InterpolateRow, Abs(s->src_width));
+  ScalePlaneFilterColsInit(s, kernels);
+}
+
 // Scale plane down with bilinear interpolation.
-void ScalePlaneBilinearDown(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_ptr,
-                            uint8_t* dst_ptr,
-                            enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+static void ScalePlaneBilinearDown(const ScalePlaneScaler* s,
+                                   int src_stride,
+                                   int dst_stride,
+                                   const uint8_t* src_ptr,
+                                   int src_y,
+                                   uint8_t* dst_ptr,
+                                   int clip_y,
+                                   int clip_height,
+                                   const LibyuvScratch* scratch) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->dst_width;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
+  int y = ScaleClipY(s->y, dy, clip_y);
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row buffer.
-  align_buffer_64(row, src_width);
+  align_buffer_64_scratch(row, src_width, scratch);
 
-  const int max_y = (src_height - 1) << 16;
+  const int max_y = (Abs(s->src_height) - 1) << 16;
   int j;
-  void (*ScaleFilterCols)(uint8_t * dst_ptr, const uint8_t* src_ptr,
-                          int dst_width, int x, int dx) =
-      (src_width >= 32768) ? ScaleFilterCols64_C : ScaleFilterCols_C;
-  void (*InterpolateRow)(uint8_t * dst_ptr, const uint8_t* src_ptr,
-                         ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-#if defined(HAS_INTERPOLATEROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_Any_SSSE3;
-    if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(src_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_MMI)
-  if (TestCpuFlag(kCpuHasMMI)) {
-    InterpolateRow = InterpolateRow_Any_MMI;
-    if (IS_ALIGNED(src_width, 16)) {
-      InterpolateRow = InterpolateRow_MMI;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_MSA)
-  if (TestCpuFlag(kCpuHasMSA)) {
-    InterpolateRow = InterpolateRow_Any_MSA;
-    if (IS_ALIGNED(src_width, 32)) {
-      InterpolateRow = InterpolateRow_MSA;
-    }
-  }
-#endif
 
-#if defined(HAS_SCALEFILTERCOLS_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_NEON)
-  if (TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleFilterCols_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_MSA)
-  if (TestCpuFlag(kCpuHasMSA) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_MSA;
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleFilterCols = ScaleFilterCols_MSA;
-    }
-  }
-#endif
   if (y > max_y) {
     y = max_y;
   }
 
-  for (j = 0; j < dst_height; ++j) {
+  for (j = 0; j < clip_height; ++j) {
     int yi = y >> 16;
-    const uint8_t* src = src_ptr + yi * src_stride;
-    if (filtering == kFilterLinear) {
-      ScaleFilterCols(dst_ptr, src, dst_width, x, dx);
+    const uint8_t* src = src_ptr + (ptrdiff_t)(yi - src_y) * src_stride;
+    if (s->filtering == kFilterLinear) {
+      s->ScaleCols(dst_ptr, src, dst_width, x, dx);
     } else {
       int yf = (y >> 8) & 255;
-      InterpolateRow(row, src, src_stride, src_width, yf);
-      ScaleFilterCols(dst_ptr, row, dst_width, x, dx);
+      s->InterpolateRow(row, src, src_stride, src_width, yf);
+      s->ScaleCols(dst_ptr, row, dst_width, x, dx);
     }
     dst_ptr += dst_stride;
     y += dy;
@@ -1112,7 +1215,10 @@ void ScalePlaneBilinearDown_16(int src_width,
                                int dst_stride,
                                const uint16_t* src_ptr,
                                uint16_t* dst_ptr,
-                               enum FilterMode filtering) {
+                               int clip_y,
+                               int clip_height,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch) {
   // Initial source x/y coordinate and step values as 16.16 fixed point.
   int x = 0;
   int y = 0;
@@ -1120,23 +1226,25 @@ void ScalePlaneBilinearDown_16(int src_width,
   int dy = 0;
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row buffer.
-  align_buffer_64(row, src_width * 2);
+  align_buffer_64_scratch(row, Abs(src_width) * 2, scratch);
 
   const int max_y = (src_height - 1) << 16;
   int j;
   void (*ScaleFilterCols)(uint16_t * dst_ptr, const uint16_t* src_ptr,
                           int dst_width, int x, int dx) =
-      (src_width >= 32768) ? ScaleFilterCols64_16_C : ScaleFilterCols_16_C;
+      (Abs(src_width) >= 32768) ? ScaleFilterCols64_16_C
+                                : ScaleFilterCols_16_C;
   void (*InterpolateRow)(uint16_t * dst_ptr, const uint16_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_16_C;
   ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
              &dx, &dy);
+  y = ScaleClipY(y, dy, clip_y);
   src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
-    InterpolateRow = InterpolateRow_Any_16_SSE2;
+    InterpolateRow = InterpolateRow_16_Any_SSE2;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
@@ -1144,7 +1252,7 @@ void ScalePlaneBilinearDown_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_Any_16_SSSE3;
+    InterpolateRow = InterpolateRow_16_Any_SSSE3;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
     }
@@ -1152,7 +1260,7 @@ void ScalePlaneBilinearDown_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_16_AVX2;
+    InterpolateRow = InterpolateRow_16_Any_AVX2;
     if (IS_ALIGNED(src_width, 32)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
@@ -1160,23 +1268,50 @@ void ScalePlaneBilinearDown_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_16_NEON;
+    InterpolateRow = InterpolateRow_16_Any_NEON;
     if (IS_ALIGNED(src_width, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
     }
   }
 #endif
 
-#if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_16_SSSE3;
+#if defined(HAS_SCALEFILTERCOLS_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    if (src_width < 32768) {
+      ScaleFilterCols = ScaleFilterCols_16_Any_SSE2;
+      if (IS_ALIGNED(dst_width, 4)) {
+        ScaleFilterCols = ScaleFilterCols_16_SSE2;
+      }
+    } else {
+      ScaleFilterCols = ScaleFilterCols64_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    if (src_width < 32768) {
+      ScaleFilterCols = ScaleFilterCols_16_Any_AVX2;
+      if (IS_ALIGNED(dst_width, 8)) {
+        ScaleFilterCols = ScaleFilterCols_16_AVX2;
+      }
+    } else {
+      ScaleFilterCols = ScaleFilterCols64_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
+    ScaleFilterCols = ScaleFilterCols_16_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterCols = ScaleFilterCols_16_NEON;
+    }
   }
 #endif
   if (y > max_y) {
     y = max_y;
   }
 
-  for (j = 0; j < dst_height; ++j) {
+  for (j = 0; j < clip_height; ++j) {
     int yi = y >> 16;
     const uint16_t* src = src_ptr + yi * src_stride;
     if (filtering == kFilterLinear) {
@@ -1195,125 +1330,65 @@ void ScalePlaneBilinearDown_16(int src_width,
   free_aligned_buffer_64(row);
 }
 
+static void ScalePlaneBilinearUpInit(ScalePlaneScaler* s) {
+  const struct RowKernels* kernels = GetRowKernels();
+  s->InterpolateRow = ROW_KERNEL(kernels, InterpolateRow, s->dst_width);
+  ScalePlaneFilterColsInit(s, kernels);
+}
+
 // Scale up down with bilinear interpolation.
-void ScalePlaneBilinearUp(int src_width,
-                          int src_height,
-                          int dst_width,
-                          int dst_height,
-                          int src_stride,
-                          int dst_stride,
-                          const uint8_t* src_ptr,
-                          uint8_t* dst_ptr,
-                          enum FilterMode filtering) {
+static void ScalePlaneBilinearUp(const ScalePlaneScaler* s,
+                                 int src_stride,
+                                 int dst_stride,
+                                 const uint8_t* src_ptr,
+                                 int src_y,
+                                 uint8_t* dst_ptr,
+                                 int clip_y,
+                                 int clip_height,
+                                 const LibyuvScratch* scratch) {
   int j;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->dst_width;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
+  int y = ScaleClipY(s->y, dy, clip_y);
   const int max_y = (src_height - 1) << 16;
   void (*InterpolateRow)(uint8_t * dst_ptr, const uint8_t* src_ptr,
                          ptrdiff_t src_stride, int dst_width,
-                         int source_y_fraction) = InterpolateRow_C;
+                         int source_y_fraction) = s->InterpolateRow;
   void (*ScaleFilterCols)(uint8_t * dst_ptr, const uint8_t* src_ptr,
-                          int dst_width, int x, int dx) =
-      filtering ? ScaleFilterCols_C : ScaleCols_C;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-#if defined(HAS_INTERPOLATEROW_SSSE3)
-  if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_Any_SSSE3;
-    if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_SSSE3;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_AVX2)
-  if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_AVX2;
-    if (IS_ALIGNED(dst_width, 32)) {
-      InterpolateRow = InterpolateRow_AVX2;
-    }
-  }
-#endif
-#if defined(HAS_INTERPOLATEROW_NEON)
-  if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_NEON;
-    if (IS_ALIGNED(dst_width, 16)) {
-      InterpolateRow = InterpolateRow_NEON;
-    }
-  }
-#endif
-
-  if (filtering && src_width >= 32768) {
-    ScaleFilterCols = ScaleFilterCols64_C;
-  }
-#if defined(HAS_SCALEFILTERCOLS_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_SSSE3;
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_NEON)
-  if (filtering && TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_NEON;
-    if (IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleFilterCols_NEON;
-    }
-  }
-#endif
-#if defined(HAS_SCALEFILTERCOLS_MSA)
-  if (filtering && TestCpuFlag(kCpuHasMSA) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_Any_MSA;
-    if (IS_ALIGNED(dst_width, 16)) {
-      ScaleFilterCols = ScaleFilterCols_MSA;
-    }
-  }
-#endif
-  if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
-    ScaleFilterCols = ScaleColsUp2_C;
-#if defined(HAS_SCALECOLS_SSE2)
-    if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleColsUp2_SSE2;
-    }
-#endif
-#if defined(HAS_SCALECOLS_MMI)
-    if (TestCpuFlag(kCpuHasMMI) && IS_ALIGNED(dst_width, 8)) {
-      ScaleFilterCols = ScaleColsUp2_MMI;
-    }
-#endif
-  }
+                          int dst_width, int x, int dx) = s->ScaleCols;
 
   if (y > max_y) {
     y = max_y;
   }
   {
     int yi = y >> 16;
-    const uint8_t* src = src_ptr + yi * src_stride;
+    const uint8_t* src = src_ptr + (ptrdiff_t)(yi - src_y) * src_stride;
 
     // Allocate 2 row buffers.
     const int kRowSize = (dst_width + 31) & ~31;
-    align_buffer_64(row, kRowSize * 2);
+    align_buffer_64_scratch(row, kRowSize * 2, scratch);
 
     uint8_t* rowptr = row;
     int rowstride = kRowSize;
     int lasty = yi;
 
     ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
+    if (yi < src_height - 1) {
       src += src_stride;
     }
     ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
     src += src_stride;
 
-    for (j = 0; j < dst_height; ++j) {
+    for (j = 0; j < clip_height; ++j) {
       yi = y >> 16;
       if (yi != lasty) {
         if (y > max_y) {
           y = max_y;
           yi = y >> 16;
-          src = src_ptr + yi * src_stride;
+          src = src_ptr + (ptrdiff_t)(yi - src_y) * src_stride;
         }
         if (yi != lasty) {
           ScaleFilterCols(rowptr, src, dst_width, x, dx);
@@ -1323,7 +1398,7 @@ void ScalePlaneBilinearUp(int src_width,
           src += src_stride;
         }
       }
-      if (filtering == kFilterLinear) {
+      if (s->filtering == kFilterLinear) {
         InterpolateRow(dst_ptr, rowptr, 0, dst_width, 0);
       } else {
         int yf = (y >> 8) & 255;
@@ -1341,22 +1416,12 @@ void ScalePlaneBilinearUp(int src_width,
 // This is an optimized version for scaling up a plane to 2 times of
 // its original width, using linear interpolation.
 // This is used to scale U and V planes of I422 to I444.
-void ScalePlaneUp2_Linear(int src_width,
-                          int src_height,
-                          int dst_width,
-                          int dst_height,
-                          int src_stride,
-                          int dst_stride,
-                          const uint8_t* src_ptr,
-                          uint8_t* dst_ptr) {
+static void ScalePlaneUp2_LinearInit(ScalePlaneScaler* s) {
   void (*ScaleRowUp)(const uint8_t* src_ptr, uint8_t* dst_ptr, int dst_width) =
       ScaleRowUp2_Linear_Any_C;
-  int i;
-  int y;
-  int dy;
 
   // This function can only scale up by 2 times horizontally.
-  assert(src_width == ((dst_width + 1) / 2));
+  assert(s->src_width == ((s->dst_width + 1) / 2));
 
 #ifdef HAS_SCALEROWUP2LINEAR_SSE2
   if (TestCpuFlag(kCpuHasSSE2)) {
@@ -1381,17 +1446,33 @@ void ScalePlaneUp2_Linear(int src_width,
     ScaleRowUp = ScaleRowUp2_Linear_Any_NEON;
   }
 #endif
+  s->ScaleRowUp2 = ScaleRowUp;
+}
 
-  if (dst_height == 1) {
-    ScaleRowUp(src_ptr + ((src_height - 1) / 2) * src_stride, dst_ptr,
-               dst_width);
+static void ScalePlaneUp2_Linear(const ScalePlaneScaler* s,
+                                 int src_stride,
+                                 int dst_stride,
+                                 const uint8_t* src_ptr,
+                                 int src_y,
+                                 uint8_t* dst_ptr,
+                                 int clip_y,
+                                 int clip_height) {
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->dst_width;
+  int i;
+  int y;
+
+  if (s->dst_height == 1) {
+    s->ScaleRowUp2(
+        src_ptr + (ptrdiff_t)((src_height - 1) / 2 - src_y) * src_stride,
+        dst_ptr, dst_width);
   } else {
-    dy = FixedDiv(src_height - 1, dst_height - 1);
-    y = (1 << 15) - 1;
-    for (i = 0; i < dst_height; ++i) {
-      ScaleRowUp(src_ptr + (y >> 16) * src_stride, dst_ptr, dst_width);
+    y = ScaleClipY(s->y, s->dy, clip_y);
+    for (i = 0; i < clip_height; ++i) {
+      s->ScaleRowUp2(src_ptr + (ptrdiff_t)((y >> 16) - src_y) * src_stride,
+                     dst_ptr, dst_width);
       dst_ptr += dst_stride;
-      y += dy;
+      y += s->dy;
     }
   }
 }
@@ -1400,22 +1481,14 @@ void ScalePlaneUp2_Linear(int src_width,
 // This is an optimized version for scaling up a plane to 2 times of
 // its original size, using bilinear interpolation.
 // This is used to scale U and V planes of I420 to I444.
-void ScalePlaneUp2_Bilinear(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_ptr,
-                            uint8_t* dst_ptr) {
+static void ScalePlaneUp2_BilinearInit(ScalePlaneScaler* s) {
   void (*Scale2RowUp)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                       uint8_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
       ScaleRowUp2_Bilinear_Any_C;
-  int x;
 
   // This function can only scale up by 2 times.
-  assert(src_width == ((dst_width + 1) / 2));
-  assert(src_height == ((dst_height + 1) / 2));
+  assert(s->src_width == ((s->dst_width + 1) / 2));
+  assert(Abs(s->src_height) == ((s->dst_height + 1) / 2));
 
 #ifdef HAS_SCALEROWUP2BILINEAR_SSE2
   if (TestCpuFlag(kCpuHasSSE2)) {
@@ -1440,17 +1513,45 @@ void ScalePlaneUp2_Bilinear(int src_width,
     Scale2RowUp = ScaleRowUp2_Bilinear_Any_NEON;
   }
 #endif
+  s->Scale2RowUp2 = Scale2RowUp;
+}
 
-  Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
-  dst_ptr += dst_stride;
-  for (x = 0; x < src_height - 1; ++x) {
+static void ScalePlaneUp2_Bilinear(const ScalePlaneScaler* s,
+                                   int src_stride,
+                                   int dst_stride,
+                                   const uint8_t* src_ptr,
+                                   int src_y,
+                                   uint8_t* dst_ptr,
+                                   int clip_y,
+                                   int clip_height) {
+  void (*Scale2RowUp)(const uint8_t* src_ptr, ptrdiff_t src_stride,
+                      uint8_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
+      s->Scale2RowUp2;
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->dst_width;
+  int x;
+
+  // Destination rows 2x+1 and 2x+2 come from source rows x and x+1, so a clip
+  // must start on row 0 or an odd row and end on an odd row or the last row.
+  assert(clip_y == 0 || (clip_y & 1));
+  assert(clip_y + clip_height == s->dst_height || ((clip_y + clip_height) & 1));
+  if (clip_y == 0) {
+    Scale2RowUp(src_ptr - (ptrdiff_t)src_y * src_stride, 0, dst_ptr, 0,
+                dst_width);
+    dst_ptr += dst_stride;
+    clip_y = 1;
+    --clip_height;
+  }
+  src_ptr += (ptrdiff_t)((clip_y >> 1) - src_y) * src_stride;
+  for (x = clip_y >> 1; x < src_height - 1 && clip_height >= 2; ++x) {
     Scale2RowUp(src_ptr, src_stride, dst_ptr, dst_stride, dst_width);
     src_ptr += src_stride;
     // TODO(fbarchard): Test performance of writing one row of destination at a
     // time.
     dst_ptr += 2 * dst_stride;
+    clip_height -= 2;
   }
-  if (!(dst_height & 1)) {
+  if (clip_height == 1) {
     Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
   }
 }
@@ -1568,7 +1669,9 @@ void ScalePlaneUp2_16_Linear(int src_width,
                              int src_stride,
                              int dst_stride,
                              const uint16_t* src_ptr,
-                             uint16_t* dst_ptr) {
+                             uint16_t* dst_ptr,
+                             int clip_y,
+                             int clip_height) {
   void (*ScaleRowUp)(const uint16_t* src_ptr, uint16_t* dst_ptr,
                      int dst_width) = ScaleRowUp2_Linear_16_Any_C;
   int i;
@@ -1601,8 +1704,8 @@ void ScalePlaneUp2_16_Linear(int src_width,
                dst_width);
   } else {
     dy = FixedDiv(src_height - 1, dst_height - 1);
-    y = (1 << 15) - 1;
-    for (i = 0; i < dst_height; ++i) {
+    y = ScaleClipY((1 << 15) - 1, dy, clip_y);
+    for (i = 0; i < clip_height; ++i) {
       ScaleRowUp(src_ptr + (y >> 16) * src_stride, dst_ptr, dst_width);
       dst_ptr += dst_stride;
       y += dy;
@@ -1617,7 +1720,9 @@ void ScalePlaneUp2_16_Bilinear(int src_width,
                                int src_stride,
                                int dst_stride,
                                const uint16_t* src_ptr,
-                               uint16_t* dst_ptr) {
+                               uint16_t* dst_ptr,
+                               int clip_y,
+                               int clip_height) {
   void (*Scale2RowUp)(const uint16_t* src_ptr, ptrdiff_t src_stride,
                       uint16_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
       ScaleRowUp2_Bilinear_16_Any_C;
@@ -1645,14 +1750,24 @@ void ScalePlaneUp2_16_Bilinear(int src_width,
   }
 #endif
 
-  Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
-  dst_ptr += dst_stride;
-  for (x = 0; x < src_height - 1; ++x) {
+  // Destination rows 2x+1 and 2x+2 come from source rows x and x+1, so a clip
+  // must start on row 0 or an odd row and end on an odd row or the last row.
+  assert(clip_y == 0 || (clip_y & 1));
+  assert(clip_y + clip_height == dst_height || ((clip_y + clip_height) & 1));
+  if (clip_y == 0) {
+    Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
+    dst_ptr += dst_stride;
+    clip_y = 1;
+    --clip_height;
+  }
+  src_ptr += (ptrdiff_t)(clip_y >> 1) * src_stride;
+  for (x = clip_y >> 1; x < src_height - 1 && clip_height >= 2; ++x) {
     Scale2RowUp(src_ptr, src_stride, dst_ptr, dst_stride, dst_width);
     src_ptr += src_stride;
     dst_ptr += 2 * dst_stride;
+    clip_height -= 2;
   }
-  if (!(dst_height & 1)) {
+  if (clip_height == 1) {
     Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
   }
 }
@@ -1665,7 +1780,10 @@ void ScalePlaneBilinearUp_16(int src_width,
                              int dst_stride,
                              const uint16_t* src_ptr,
                              uint16_t* dst_ptr,
-                             enum FilterMode filtering) {
+                             int clip_y,
+                             int clip_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
   int j;
   // Initial source x/y coordinate and step values as 16.16 fixed point.
   int x = 0;
@@ -1681,11 +1799,12 @@ void ScalePlaneBilinearUp_16(int src_width,
       filtering ? ScaleFilterCols_16_C : ScaleCols_16_C;
   ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
              &dx, &dy);
+  y = ScaleClipY(y, dy, clip_y);
   src_width = Abs(src_width);
 
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
-    InterpolateRow = InterpolateRow_Any_16_SSE2;
+    InterpolateRow = InterpolateRow_16_Any_SSE2;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
@@ -1693,7 +1812,7 @@ void ScalePlaneBilinearUp_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_Any_16_SSSE3;
+    InterpolateRow = InterpolateRow_16_Any_SSSE3;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
     }
@@ -1701,7 +1820,7 @@ void ScalePlaneBilinearUp_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_16_AVX2;
+    InterpolateRow = InterpolateRow_16_Any_AVX2;
     if (IS_ALIGNED(dst_width, 32)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
@@ -1709,7 +1828,7 @@ void ScalePlaneBilinearUp_16(int src_width,
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_16_NEON;
+    InterpolateRow = InterpolateRow_16_Any_NEON;
     if (IS_ALIGNED(dst_width, 16)) {
       InterpolateRow = InterpolateRow_16_NEON;
     }
@@ -1719,9 +1838,36 @@ void ScalePlaneBilinearUp_16(int src_width,
   if (filtering && src_width >= 32768) {
     ScaleFilterCols = ScaleFilterCols64_16_C;
   }
-#if defined(HAS_SCALEFILTERCOLS_16_SSSE3)
-  if (filtering && TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
-    ScaleFilterCols = ScaleFilterCols_16_SSSE3;
+#if defined(HAS_SCALEFILTERCOLS_16_SSE2)
+  if (filtering && TestCpuFlag(kCpuHasSSE2)) {
+    if (src_width < 32768) {
+      ScaleFilterCols = ScaleFilterCols_16_Any_SSE2;
+      if (IS_ALIGNED(dst_width, 4)) {
+        ScaleFilterCols = ScaleFilterCols_16_SSE2;
+      }
+    } else {
+      ScaleFilterCols = ScaleFilterCols64_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2)) {
+    if (src_width < 32768) {
+      ScaleFilterCols = ScaleFilterCols_16_Any_AVX2;
+      if (IS_ALIGNED(dst_width, 8)) {
+        ScaleFilterCols = ScaleFilterCols_16_AVX2;
+      }
+    } else {
+      ScaleFilterCols = ScaleFilterCols64_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEFILTERCOLS_16_NEON)
+  if (filtering && TestCpuFlag(kCpuHasNEON) && src_width < 32768) {
+    ScaleFilterCols = ScaleFilterCols_16_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleFilterCols = ScaleFilterCols_16_NEON;
+    }
   }
 #endif
   if (!filtering && src_width * 2 == dst_width && x < 0x8000) {
@@ -1747,20 +1893,20 @@ void ScalePlaneBilinearUp_16(int src_width,
 
     // Allocate 2 row buffers.
     const int kRowSize = (dst_width + 31) & ~31;
-    align_buffer_64(row, kRowSize * 4);
+    align_buffer_64_scratch(row, kRowSize * 4, scratch);
 
     uint16_t* rowptr = (uint16_t*)row;
     int rowstride = kRowSize;
     int lasty = yi;
 
     ScaleFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
+    if (yi < src_height - 1) {
       src += src_stride;
     }
     ScaleFilterCols(rowptr + rowstride, src, dst_width, x, dx);
     src += src_stride;
 
-    for (j = 0; j < dst_height; ++j) {
+    for (j = 0; j < clip_height; ++j) {
       yi = y >> 16;
       if (yi != lasty) {
         if (y > max_y) {
@@ -1794,27 +1940,11 @@ void ScalePlaneBilinearUp_16(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScalePlaneSimple(int src_width,
-                             int src_height,
-                             int dst_width,
-                             int dst_height,
-                             int src_stride,
-                             int dst_stride,
-                             const uint8_t* src_ptr,
-                             uint8_t* dst_ptr) {
-  int i;
+static void ScalePlaneSimpleInit(ScalePlaneScaler* s) {
+  const int dst_width = s->dst_width;
   void (*ScaleCols)(uint8_t * dst_ptr, const uint8_t* src_ptr, int dst_width,
                     int x, int dx) = ScaleCols_C;
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
-
-  if (src_width * 2 == dst_width && x < 0x8000) {
+  if (Abs(s->src_width) * 2 == dst_width && s->x < 0x8000) {
     ScaleCols = ScaleColsUp2_C;
 #if defined(HAS_SCALECOLS_SSE2)
     if (TestCpuFlag(kCpuHasSSE2) && IS_ALIGNED(dst_width, 8)) {
@@ -1827,14 +1957,33 @@ static void ScalePlaneSimple(int src_width,
     }
 #endif
   }
+  s->ScaleCols = ScaleCols;
+}
 
-  for (i = 0; i < dst_height; ++i) {
-    ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride, dst_width, x, dx);
+static void ScalePlaneSimple(const ScalePlaneScaler* s,
+                             int src_stride,
+                             int dst_stride,
+                             const uint8_t* src_ptr,
+                             int src_y,
+                             uint8_t* dst_ptr,
+                             int clip_y,
+                             int clip_height) {
+  int i;
+  int y = ScaleClipY(s->y, s->dy, clip_y);
+  for (i = 0; i < clip_height; ++i) {
+    s->ScaleCols(dst_ptr, src_ptr + (ptrdiff_t)((y >> 16) - src_y) * src_stride,
+                 s->dst_width, s->x, s->dx);
     dst_ptr += dst_stride;
-    y += dy;
+    y += s->dy;
   }
 }
 
+// Scale plane vertically, unscaled horizontally.
+static void ScalePlaneVerticalInit(ScalePlaneScaler* s) {
+  const struct RowKernels* kernels = GetRowKernels();
+  s->InterpolateRow = ROW_KERNEL(kernels, InterpolateRow, s->dst_width);
+}
+
 static void ScalePlaneSimple_16(int src_width,
                                 int src_height,
                                 int dst_width,
@@ -1842,7 +1991,9 @@ static void ScalePlaneSimple_16(int src_width,
                                 int src_stride,
                                 int dst_stride,
                                 const uint16_t* src_ptr,
-                                uint16_t* dst_ptr) {
+                                uint16_t* dst_ptr,
+                                int clip_y,
+                                int clip_height) {
   int i;
   void (*ScaleCols)(uint16_t * dst_ptr, const uint16_t* src_ptr, int dst_width,
                     int x, int dx) = ScaleCols_16_C;
@@ -1853,6 +2004,7 @@ static void ScalePlaneSimple_16(int src_width,
   int dy = 0;
   ScaleSlope(src_width, src_height, dst_width, dst_height, kFilterNone, &x, &y,
              &dx, &dy);
+  y = ScaleClipY(y, dy, clip_y);
   src_width = Abs(src_width);
 
   if (src_width * 2 == dst_width && x < 0x8000) {
@@ -1869,202 +2021,836 @@ static void ScalePlaneSimple_16(int src_width,
 #endif
   }
 
-  for (i = 0; i < dst_height; ++i) {
+  for (i = 0; i < clip_height; ++i) {
     ScaleCols(dst_ptr, src_ptr + (y >> 16) * src_stride, dst_width, x, dx);
     dst_ptr += dst_stride;
     y += dy;
   }
 }
 
-// Scale a plane.
+// Choose the method and row functions of a plane scale once for a geometry.
 // This function dispatches to a specialized scaler based on scale factor.
-
-LIBYUV_API
-void ScalePlane(const uint8_t* src,
-                int src_stride,
-                int src_width,
-                int src_height,
-                uint8_t* dst,
-                int dst_stride,
-                int dst_width,
-                int dst_height,
-                enum FilterMode filtering) {
+static void ScalePlaneScalerChoose(ScalePlaneScaler* s,
+                                   int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   enum FilterMode filtering) {
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
-
-  // Negative height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
-    src_stride = -src_stride;
-  }
+  memset(s, 0, sizeof(*s));
+  s->src_width = src_width;
+  s->src_height = src_height;
+  s->dst_width = dst_width;
+  s->dst_height = dst_height;
+  s->filtering = filtering;
+  src_height = Abs(src_height);
 
   // Use specialized scales to improve performance for common resolutions.
   // For example, all the 1/2 scalings will use ScalePlaneDown2()
   if (dst_width == src_width && dst_height == src_height) {
     // Straight copy.
-    CopyPlane(src, src_stride, dst, dst_stride, dst_width, dst_height);
+    s->method = kScalePlaneCopy;
+    return;
+  }
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    s->method = kScalePlanePolyphase;
+    ScalePolyphaseInit(&s->polyphase, src_width, src_height, dst_width,
+                       dst_height, 1, filtering);
     return;
   }
   if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = FixedDiv(src_height, dst_height);
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, 0, 0, dy, 1, filtering);
+    s->method = kScalePlaneVertical;
+    s->dy = FixedDiv(src_height, dst_height);
+    ScalePlaneVerticalInit(s);
     return;
   }
   if (dst_width <= Abs(src_width) && dst_height <= src_height) {
     // Scale down.
     if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
       // optimized, 3/4
-      ScalePlaneDown34(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
+      s->method = kScalePlaneDown34;
+      ScalePlaneDown34Init(s);
       return;
     }
     if (2 * dst_width == src_width && 2 * dst_height == src_height) {
       // optimized, 1/2
-      ScalePlaneDown2(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
+      s->method = kScalePlaneDown2;
+      ScalePlaneDown2Init(s);
       return;
     }
     // 3/8 rounded up for odd sized chroma height.
     if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
       // optimized, 3/8
-      ScalePlaneDown38(src_width, src_height, dst_width, dst_height, src_stride,
-                       dst_stride, src, dst, filtering);
+      s->method = kScalePlaneDown38;
+      ScalePlaneDown38Init(s);
       return;
     }
     if (4 * dst_width == src_width && 4 * dst_height == src_height &&
         (filtering == kFilterBox || filtering == kFilterNone)) {
       // optimized, 1/4
-      ScalePlaneDown4(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst, filtering);
+      s->method = kScalePlaneDown4;
+      ScalePlaneDown4Init(s);
       return;
     }
   }
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &s->x,
+             &s->y, &s->dx, &s->dy);
   if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    ScalePlaneBox(src_width, src_height, dst_width, dst_height, src_stride,
-                  dst_stride, src, dst);
+    s->method = kScalePlaneBox;
+    ScalePlaneBoxInit(s);
     return;
   }
   if ((dst_width + 1) / 2 == src_width && filtering == kFilterLinear) {
-    ScalePlaneUp2_Linear(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst);
+    s->method = kScalePlaneUp2Linear;
+    s->x = 0;
+    s->dx = 0;
+    if (dst_height > 1) {
+      s->y = (1 << 15) - 1;
+      s->dy = FixedDiv(src_height - 1, dst_height - 1);
+    }
+    ScalePlaneUp2_LinearInit(s);
     return;
   }
   if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
       (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScalePlaneUp2_Bilinear(src_width, src_height, dst_width, dst_height,
-                           src_stride, dst_stride, src, dst);
+    s->method = kScalePlaneUp2Bilinear;
+    ScalePlaneUp2_BilinearInit(s);
     return;
   }
   if (filtering && dst_height > src_height) {
-    ScalePlaneBilinearUp(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
+    s->method = kScalePlaneBilinearUp;
+    ScalePlaneBilinearUpInit(s);
     return;
   }
   if (filtering) {
-    ScalePlaneBilinearDown(src_width, src_height, dst_width, dst_height,
-                           src_stride, dst_stride, src, dst, filtering);
+    s->method = kScalePlaneBilinearDown;
+    ScalePlaneBilinearDownInit(s);
     return;
   }
-  ScalePlaneSimple(src_width, src_height, dst_width, dst_height, src_stride,
-                   dst_stride, src, dst);
+  s->method = kScalePlaneSimple;
+  ScalePlaneSimpleInit(s);
 }
 
-LIBYUV_API
-void ScalePlane_16(const uint16_t* src,
-                   int src_stride,
-                   int src_width,
-                   int src_height,
-                   uint16_t* dst,
-                   int dst_stride,
-                   int dst_width,
-                   int dst_height,
-                   enum FilterMode filtering) {
-  // Simplify filtering when possible.
-  filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
-                                filtering);
-
-  // Negative height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
+// Choose the scaler and build its polyphase tables, which it owns until
+// ScalePlaneScalerFree, so that every call of ScalePlaneScalerRows shares
+// them.
+void ScalePlaneScalerInit(ScalePlaneScaler* s,
+                          int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  ScalePlaneScalerChoose(s, src_width, src_height, dst_width, dst_height,
+                         filtering);
+  if (s->method == kScalePlanePolyphase) {
+    ScalePolyphaseAllocTables(&s->polyphase);
+  }
+}
+
+void ScalePlaneScalerFree(ScalePlaneScaler* s) {
+  ScalePolyphaseFree(&s->polyphase);
+}
+
+// Each destination row is computed exactly as it would be for the whole
+// plane, so disjoint clips can be scaled independently.
+void ScalePlaneScalerRows(const ScalePlaneScaler* s,
+                          const uint8_t* src,
+                          int src_stride,
+                          int src_y,
+                          uint8_t* dst,
+                          int dst_stride,
+                          int clip_y,
+                          int clip_height,
+                          const LibyuvScratch* scratch) {
+  assert(src_y == 0 || s->src_height > 0);
+  // Negative height means invert the image.
+  if (s->src_height < 0) {
+    src = src + (-s->src_height - 1) * src_stride;
     src_stride = -src_stride;
   }
+  switch (s->method) {
+    case kScalePlaneCopy:
+      CopyPlane(src + (ptrdiff_t)(clip_y - src_y) * src_stride, src_stride,
+                dst, dst_stride, s->dst_width, clip_height);
+      break;
+    case kScalePlanePolyphase:
+      ScalePolyphaseRows(&s->polyphase, src, src_stride, src_y, dst,
+                         dst_stride, 0, clip_y, s->dst_width, clip_height,
+                         scratch);
+      break;
+    case kScalePlaneVertical:
+      ScalePlaneVerticalRows(Abs(s->src_height), s->dst_width, clip_height,
+                             src_stride, dst_stride, src, src_y, dst,
+                             ScaleClipY(0, s->dy, clip_y), s->dy, s->filtering,
+                             s->InterpolateRow);
+      break;
+    case kScalePlaneDown34:
+      ScalePlaneDown34(s, clip_height, src_stride, dst_stride,
+                       src + (ptrdiff_t)(clip_y / 3 * 4 - src_y) * src_stride,
+                       dst);
+      break;
+    case kScalePlaneDown2:
+      ScalePlaneDown2(s, clip_height, src_stride, dst_stride,
+                      src + (ptrdiff_t)(clip_y * 2 - src_y) * src_stride, dst);
+      break;
+    case kScalePlaneDown38:
+      ScalePlaneDown38(s, clip_height, src_stride, dst_stride,
+                       src + (ptrdiff_t)(clip_y / 3 * 8 - src_y) * src_stride,
+                       dst);
+      break;
+    case kScalePlaneDown4:
+      ScalePlaneDown4(s, clip_height, src_stride, dst_stride,
+                      src + (ptrdiff_t)(clip_y * 4 - src_y) * src_stride, dst);
+      break;
+    case kScalePlaneBox:
+      ScalePlaneBox(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                    clip_height, scratch);
+      break;
+    case kScalePlaneUp2Linear:
+      ScalePlaneUp2_Linear(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                           clip_height);
+      break;
+    case kScalePlaneUp2Bilinear:
+      ScalePlaneUp2_Bilinear(s, src_stride, dst_stride, src, src_y, dst,
+                             clip_y, clip_height);
+      break;
+    case kScalePlaneBilinearUp:
+      ScalePlaneBilinearUp(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                           clip_height, scratch);
+      break;
+    case kScalePlaneBilinearDown:
+      ScalePlaneBilinearDown(s, src_stride, dst_stride, src, src_y, dst,
+                             clip_y, clip_height, scratch);
+      break;
+    case kScalePlaneSimple:
+      ScalePlaneSimple(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                       clip_height);
+      break;
+  }
+}
+
+void ScalePlaneClip(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int clip_y,
+                    int clip_height,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch) {
+  // A single call builds the polyphase tables in scratch instead.
+  ScalePlaneScaler s;
+  ScalePlaneScalerChoose(&s, src_width, src_height, dst_width, dst_height,
+                         filtering);
+  ScalePlaneScalerRows(&s, src, src_stride, 0, dst, dst_stride, clip_y,
+                       clip_height, scratch);
+}
+
+// Row alignment required of clips of a scaler.
+// Clips start and end on a multiple of *align rows plus *offset, or on the
+// first or last row.  The 3/4 and 3/8 scalers produce rows in groups of 3 and
+// the 2x bilinear upsampler produces rows in pairs after the first row.
+static void ScalePlaneMethodAlign(enum ScalePlaneMethod method,
+                                  int* align,
+                                  int* offset) {
+  *align = 1;
+  *offset = 0;
+  switch (method) {
+    case kScalePlaneDown34:
+    case kScalePlaneDown38:
+      *align = 3;
+      break;
+    case kScalePlaneUp2Bilinear:
+      *align = 2;
+      *offset = 1;
+      break;
+    default:
+      break;
+  }
+}
+
+void ScalePlaneScalerAlign(const ScalePlaneScaler* s, int* align, int* offset) {
+  ScalePlaneMethodAlign(s->method, align, offset);
+}
+
+void ScalePlaneClipAlign(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering,
+                         int* align,
+                         int* offset) {
+  ScalePlaneScaler s;
+  ScalePlaneScalerChoose(&s, src_width, src_height, dst_width, dst_height,
+                         filtering);
+  ScalePlaneScalerAlign(&s, align, offset);
+}
+
+// Source rows that scaling a destination row may read beyond the rows it
+// spans.  The polyphase filters read up to 3 destination rows of source rows
+// either side, and windows at the edges are shifted inside the plane.
+static int ScaleBandMargin(int src_height,
+                           int dst_height,
+                           enum FilterMode filtering) {
+  int ratio = (src_height + dst_height - 1) / dst_height;
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    return 6 * ratio + 4;
+  }
+  return ratio + 2;
+}
+
+// The polyphase filter of a plane, or NULL if it is not scaled with one.
+static ScalePolyphaseFilter* ScaleBandPolyphase(ScaleBandPlane* p) {
+  if (p->bpp == 2) {
+    return p->uv.method == kScaleUVPolyphase ? &p->uv.polyphase : NULL;
+  }
+  return p->scaler.method == kScalePlanePolyphase ? &p->scaler.polyphase
+                                                  : NULL;
+}
+
+void ScaleBandPlaneInit(ScaleBandPlane* p,
+                        int src_width,
+                        int src_height,
+                        int src_rows,
+                        int dst_width,
+                        int dst_height,
+                        int bpp,
+                        enum FilterMode filtering,
+                        const LibyuvScratch* scratch) {
+  int ratio = (src_height + dst_height - 1) / dst_height;
+  int window_rows;
+  ScalePolyphaseFilter* f;
+  assert(bpp == 1 || bpp == 2);
+  p->src_width = src_width;
+  p->src_height = src_height;
+  p->src_rows = src_rows;
+  p->dst_width = dst_width;
+  p->dst_height = dst_height;
+  p->bpp = bpp;
+  p->src_stride = src_width * bpp;
+  p->filtering = filtering;
+  p->scratch = scratch;
+  if (bpp == 2) {
+    ScaleUVScalerInit(&p->uv, src_width, src_height, dst_width, dst_height, 0,
+                      dst_width, filtering);
+    // The 2x bilinear scaler produces rows in pairs after the first row.
+    p->align = p->uv.bilinear_up2 ? 2 : 1;
+    p->offset = p->uv.bilinear_up2 ? 1 : 0;
+  } else {
+    ScalePlaneScalerInit(&p->scaler, src_width, src_height, dst_width,
+                         dst_height, filtering);
+    ScalePlaneScalerAlign(&p->scaler, &p->align, &p->offset);
+  }
+  p->margin = ScaleBandMargin(src_height, dst_height, filtering);
+  // Rows kept for a band that is not complete yet, plus the appended rows.
+  window_rows = src_rows + p->align * ratio + 2 * p->margin + 2;
+  p->window_rows = window_rows < src_height ? window_rows : src_height;
+  p->window = NULL;
+  p->window_y = 0;
+  p->window_end = 0;
+  p->dst_y = 0;
+  f = ScaleBandPolyphase(p);
+  p->ring_size = f ? ScalePolyphaseRingSize(f) : 0;
+}
+
+void ScaleBandPlaneRing(ScaleBandPlane* p, uint8_t* ring) {
+  ScalePolyphaseFilter* f = ScaleBandPolyphase(p);
+  if (f && p->ring_size) {
+    ScalePolyphaseRing(f, ring);
+  }
+}
+
+void ScaleBandPlaneFree(ScaleBandPlane* p) {
+  if (p->bpp == 2) {
+    ScaleUVScalerFree(&p->uv);
+  } else {
+    ScalePlaneScalerFree(&p->scaler);
+  }
+}
+
+void ScaleBandPlaneReset(ScaleBandPlane* p) {
+  ScalePolyphaseFilter* f = ScaleBandPolyphase(p);
+  p->window_y = 0;
+  p->window_end = 0;
+  p->dst_y = 0;
+  if (f) {
+    ScalePolyphaseRingReset(f);
+  }
+}
+
+// First source row that scaling destination row y may read.
+static int ScaleBandRowTop(const ScaleBandPlane* p, int y) {
+  int top = (int)((int64_t)y * p->src_height / p->dst_height) - p->margin;
+  return top > 0 ? top : 0;
+}
+
+// Source row after the last that scaling destination row y may read.
+static int ScaleBandRowBottom(const ScaleBandPlane* p, int y) {
+  int bottom = (int)(((int64_t)(y + 1) * p->src_height + p->dst_height - 1) /
+                     p->dst_height) +
+               p->margin;
+  return bottom < p->src_height ? bottom : p->src_height;
+}
+
+// Round y down to a row that a ScalePlaneClip band may start or end on.
+static int ScaleBandBoundary(const ScaleBandPlane* p, int y) {
+  if (y >= p->dst_height) {
+    return p->dst_height;
+  }
+  if (y < p->offset) {
+    return 0;
+  }
+  return p->offset + (y - p->offset) / p->align * p->align;
+}
+
+uint8_t* ScaleBandAppend(ScaleBandPlane* p, int rows) {
+  int top = ScaleBandRowTop(p, p->dst_y);
+  uint8_t* dst;
+  if (rows < 0 || rows > p->src_rows ||
+      rows > p->src_height - p->window_end) {
+    return NULL;
+  }
+  if (top > p->window_y) {
+    int keep = p->window_end - top;
+    if (keep > 0) {
+      memmove(p->window, p->window + (top - p->window_y) * p->src_stride,
+              keep * p->src_stride);
+    }
+    p->window_y = top;
+  }
+  if (p->window_end - p->window_y + rows > p->window_rows) {
+    return NULL;
+  }
+  dst = p->window + (p->window_end - p->window_y) * p->src_stride;
+  p->window_end += rows;
+  return dst;
+}
+
+int ScaleBandHeight(const ScaleBandPlane* p, int max_rows) {
+  int y = p->dst_y + max_rows;
+  if (p->window_end < p->src_height) {
+    // Rows before the first whose ScaleBandRowBottom is past window_end.
+    int covered = (int)((int64_t)(p->window_end - p->margin) * p->dst_height /
+                        p->src_height);
+    if (y > covered) {
+      y = covered;
+    }
+  }
+  y = ScaleBandBoundary(p, y);
+  while (y > p->dst_y && ScaleBandRowBottom(p, y - 1) > p->window_end) {
+    y = ScaleBandBoundary(p, y - 1);
+  }
+  return y > p->dst_y ? y - p->dst_y : 0;
+}
+
+void ScaleBandRows(ScaleBandPlane* p, uint8_t* dst, int dst_stride, int rows) {
+  // The window holds source rows from window_y, which are the only rows read.
+  if (p->bpp == 2) {
+    ScaleUVScalerRows(&p->uv, p->window, p->src_stride, p->window_y, dst,
+                      dst_stride, p->dst_y, rows, p->scratch);
+  } else {
+    ScalePlaneScalerRows(&p->scaler, p->window, p->src_stride, p->window_y,
+                         dst, dst_stride, p->dst_y, rows, p->scratch);
+  }
+  p->dst_y += rows;
+}
+
+// Scale a plane.
+
+LIBYUV_API
+void ScalePlane(const uint8_t* src,
+                int src_stride,
+                int src_width,
+                int src_height,
+                uint8_t* dst,
+                int dst_stride,
+                int dst_width,
+                int dst_height,
+                enum FilterMode filtering) {
+  ScalePlaneClip(src, src_stride, src_width, src_height, dst, dst_stride,
+                 dst_width, dst_height, 0, dst_height, filtering, NULL);
+}
+
+LIBYUV_API
+void ScalePlane_WithScratch(const uint8_t* src,
+                            int src_stride,
+                            int src_width,
+                            int src_height,
+                            uint8_t* dst,
+                            int dst_stride,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            const LibyuvScratch* scratch) {
+  ScalePlaneClip(src, src_stride, src_width, src_height, dst, dst_stride,
+                 dst_width, dst_height, 0, dst_height, filtering, scratch);
+}
+
+// Largest row buffer allocated by the box and bilinear plane scalers, or the
+// tables and rows of the polyphase scaler.
+LIBYUV_API
+int ScalePlaneScratchSize(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  int box_size = Abs(src_width) * 2;
+  int up_size = ((dst_width + 31) & ~31) * 2;
+  if (filtering == kFilterNone) {
+    return 0;
+  }
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    return ScalePolyphaseScratchSize(src_width, src_height, dst_width,
+                                     dst_height, 1, filtering);
+  }
+  return (box_size > up_size ? box_size : up_size) + 63;
+}
+
+// The larger of the scratch sizes of the Y and U planes.
+LIBYUV_API
+int I420ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering) {
+  int y_size = ScalePlaneScratchSize(src_width, src_height, dst_width,
+                                     dst_height, filtering);
+  int uv_size = ScalePlaneScratchSize(
+      SUBSAMPLE(src_width, 1, 1), SUBSAMPLE(src_height, 1, 1),
+      SUBSAMPLE(dst_width, 1, 1), SUBSAMPLE(dst_height, 1, 1), filtering);
+  return y_size > uv_size ? y_size : uv_size;
+}
+
+// The larger of the scratch sizes of the Y and UV planes.
+LIBYUV_API
+int NV12ScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering) {
+  int y_size = ScalePlaneScratchSize(src_width, src_height, dst_width,
+                                     dst_height, filtering);
+  int uv_size = UVScaleScratchSize(
+      SUBSAMPLE(src_width, 1, 1), SUBSAMPLE(src_height, 1, 1),
+      SUBSAMPLE(dst_width, 1, 1), SUBSAMPLE(dst_height, 1, 1), filtering);
+  return y_size > uv_size ? y_size : uv_size;
+}
+
+// A horizontal band of one plane, scaled by one job of a threaded scale.
+// The bands of a plane share its scaler, whose tables they only read.
+typedef struct {
+  const ScalePlaneScaler* scaler;
+  const uint8_t* src;
+  int src_stride;
+  uint8_t* dst;
+  int dst_stride;
+  int clip_y;
+  int clip_height;
+} ScalePlaneBand;
+
+static void ScalePlaneBandJob(void* opaque, int index) {
+  const ScalePlaneBand* band = (const ScalePlaneBand*)(opaque) + index;
+  ScalePlaneScalerRows(band->scaler, band->src, band->src_stride, 0,
+                       band->dst + (ptrdiff_t)band->clip_y * band->dst_stride,
+                       band->dst_stride, band->clip_y, band->clip_height,
+                       NULL);
+}
+
+// Split a plane into at most num_jobs bands, aligned for the scaler.
+// Returns the number of bands written to bands.
+static int ScalePlaneSplitBands(const ScalePlaneScaler* s,
+                                const uint8_t* src,
+                                int src_stride,
+                                uint8_t* dst,
+                                int dst_stride,
+                                int num_jobs,
+                                ScalePlaneBand* bands) {
+  const int dst_height = s->dst_height;
+  int align, offset;
+  int band_height;
+  int y = 0;
+  int n = 0;
+  ScalePlaneScalerAlign(s, &align, &offset);
+  band_height = (dst_height + num_jobs - 1) / num_jobs;
+  band_height = (band_height + align - 1) / align * align;
+  while (y < dst_height) {
+    int next_y = (n + 1) * band_height + offset;
+    if (next_y > dst_height || n == num_jobs - 1) {
+      next_y = dst_height;
+    }
+    bands[n].scaler = s;
+    bands[n].src = src;
+    bands[n].src_stride = src_stride;
+    bands[n].dst = dst;
+    bands[n].dst_stride = dst_stride;
+    bands[n].clip_y = y;
+    bands[n].clip_height = next_y - y;
+    y = next_y;
+    ++n;
+  }
+  return n;
+}
 
+LIBYUV_API
+void ScalePlaneThreaded(const uint8_t* src,
+                        int src_stride,
+                        int src_width,
+                        int src_height,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering,
+                        int num_jobs,
+                        LibyuvDispatchFunc dispatch,
+                        void* dispatch_opaque) {
+  ScalePlaneScaler scaler;
+  ScalePlaneBand* bands;
+  int num_bands;
+  if (!dispatch || num_jobs <= 1 || dst_height <= 1) {
+    ScalePlane(src, src_stride, src_width, src_height, dst, dst_stride,
+               dst_width, dst_height, filtering);
+    return;
+  }
+  if (num_jobs > dst_height) {
+    num_jobs = dst_height;
+  }
+  bands = (ScalePlaneBand*)malloc(num_jobs * sizeof(ScalePlaneBand));
+  if (!bands) {
+    ScalePlane(src, src_stride, src_width, src_height, dst, dst_stride,
+               dst_width, dst_height, filtering);
+    return;
+  }
+  ScalePlaneScalerInit(&scaler, src_width, src_height, dst_width, dst_height,
+                       filtering);
+  num_bands = ScalePlaneSplitBands(&scaler, src, src_stride, dst, dst_stride,
+                                   num_jobs, bands);
+  dispatch(dispatch_opaque, ScalePlaneBandJob, bands, num_bands);
+  ScalePlaneScalerFree(&scaler);
+  free(bands);
+}
+
+// The method of a 16 bit plane scale, which has no polyphase filter or
+// scaler of its own.  src_height must be positive.
+static enum ScalePlaneMethod ScalePlaneMethod_16(int src_width,
+                                                 int src_height,
+                                                 int dst_width,
+                                                 int dst_height,
+                                                 enum FilterMode filtering) {
   // Use specialized scales to improve performance for common resolutions.
   // For example, all the 1/2 scalings will use ScalePlaneDown2()
   if (dst_width == src_width && dst_height == src_height) {
-    // Straight copy.
-    CopyPlane_16(src, src_stride, dst, dst_stride, dst_width, dst_height);
-    return;
+    return kScalePlaneCopy;
   }
   if (dst_width == src_width && filtering != kFilterBox) {
-    int dy = FixedDiv(src_height, dst_height);
-    // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical_16(src_height, dst_width, dst_height, src_stride,
-                          dst_stride, src, dst, 0, 0, dy, 1, filtering);
-    return;
+    return kScalePlaneVertical;
   }
   if (dst_width <= Abs(src_width) && dst_height <= src_height) {
     // Scale down.
     if (4 * dst_width == 3 * src_width && 4 * dst_height == 3 * src_height) {
-      // optimized, 3/4
-      ScalePlaneDown34_16(src_width, src_height, dst_width, dst_height,
-                          src_stride, dst_stride, src, dst, filtering);
-      return;
+      return kScalePlaneDown34;
     }
     if (2 * dst_width == src_width && 2 * dst_height == src_height) {
-      // optimized, 1/2
-      ScalePlaneDown2_16(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
-      return;
+      return kScalePlaneDown2;
     }
     // 3/8 rounded up for odd sized chroma height.
     if (8 * dst_width == 3 * src_width && 8 * dst_height == 3 * src_height) {
-      // optimized, 3/8
-      ScalePlaneDown38_16(src_width, src_height, dst_width, dst_height,
-                          src_stride, dst_stride, src, dst, filtering);
-      return;
+      return kScalePlaneDown38;
     }
     if (4 * dst_width == src_width && 4 * dst_height == src_height &&
         (filtering == kFilterBox || filtering == kFilterNone)) {
-      // optimized, 1/4
-      ScalePlaneDown4_16(src_width, src_height, dst_width, dst_height,
-                         src_stride, dst_stride, src, dst, filtering);
-      return;
+      return kScalePlaneDown4;
     }
   }
   if (filtering == kFilterBox && dst_height * 2 < src_height) {
-    ScalePlaneBox_16(src_width, src_height, dst_width, dst_height, src_stride,
-                     dst_stride, src, dst);
-    return;
+    return kScalePlaneBox;
   }
   if ((dst_width + 1) / 2 == src_width && filtering == kFilterLinear) {
-    ScalePlaneUp2_16_Linear(src_width, src_height, dst_width, dst_height,
-                            src_stride, dst_stride, src, dst);
-    return;
+    return kScalePlaneUp2Linear;
   }
   if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
       (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScalePlaneUp2_16_Bilinear(src_width, src_height, dst_width, dst_height,
-                              src_stride, dst_stride, src, dst);
-    return;
+    return kScalePlaneUp2Bilinear;
   }
   if (filtering && dst_height > src_height) {
-    ScalePlaneBilinearUp_16(src_width, src_height, dst_width, dst_height,
-                            src_stride, dst_stride, src, dst, filtering);
-    return;
+    return kScalePlaneBilinearUp;
   }
   if (filtering) {
-    ScalePlaneBilinearDown_16(src_width, src_height, dst_width, dst_height,
-                              src_stride, dst_stride, src, dst, filtering);
-    return;
+    return kScalePlaneBilinearDown;
+  }
+  return kScalePlaneSimple;
+}
+
+// The filtering that a 16 bit plane scale uses.
+static enum FilterMode ScalePlaneFilter_16(int src_width,
+                                           int src_height,
+                                           int dst_width,
+                                           int dst_height,
+                                           enum FilterMode filtering) {
+  // The polyphase filters are 8 bit only.
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    filtering = kFilterBox;
+  }
+  // Simplify filtering when possible.
+  return ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
+                           filtering);
+}
+
+void ScalePlaneClip_16(const uint16_t* src,
+                       int src_stride,
+                       int src_width,
+                       int src_height,
+                       uint16_t* dst,
+                       int dst_stride,
+                       int dst_width,
+                       int dst_height,
+                       int clip_y,
+                       int clip_height,
+                       enum FilterMode filtering,
+                       const LibyuvScratch* scratch) {
+  filtering = ScalePlaneFilter_16(src_width, src_height, dst_width,
+                                  dst_height, filtering);
+
+  // Negative height means invert the image.
+  if (src_height < 0) {
+    src_height = -src_height;
+    src = src + (src_height - 1) * src_stride;
+    src_stride = -src_stride;
   }
-  ScalePlaneSimple_16(src_width, src_height, dst_width, dst_height, src_stride,
-                      dst_stride, src, dst);
+
+  switch (ScalePlaneMethod_16(src_width, src_height, dst_width, dst_height,
+                              filtering)) {
+    case kScalePlaneCopy:
+      CopyPlane_16(src + (ptrdiff_t)clip_y * src_stride, src_stride, dst,
+                   dst_stride, dst_width, clip_height);
+      break;
+    case kScalePlaneVertical: {
+      int dy = FixedDiv(src_height, dst_height);
+      // Arbitrary scale vertically, but unscaled horizontally.
+      ScalePlaneVertical_16(src_height, dst_width, clip_height, src_stride,
+                            dst_stride, src, dst, 0, ScaleClipY(0, dy, clip_y),
+                            dy, 1, filtering);
+      break;
+    }
+    case kScalePlaneDown34:
+      ScalePlaneDown34_16(src_width, src_height, dst_width, dst_height,
+                          src_stride, dst_stride, src, dst, clip_y,
+                          clip_height, filtering);
+      break;
+    case kScalePlaneDown2:
+      ScalePlaneDown2_16(src_width, src_height, dst_width, dst_height,
+                         src_stride, dst_stride, src, dst, clip_y, clip_height,
+                         filtering);
+      break;
+    case kScalePlaneDown38:
+      ScalePlaneDown38_16(src_width, src_height, dst_width, dst_height,
+                          src_stride, dst_stride, src, dst, clip_y,
+                          clip_height, filtering);
+      break;
+    case kScalePlaneDown4:
+      ScalePlaneDown4_16(src_width, src_height, dst_width, dst_height,
+                         src_stride, dst_stride, src, dst, clip_y, clip_height,
+                         filtering);
+      break;
+    case kScalePlaneBox:
+      ScalePlaneBox_16(src_width, src_height, dst_width, dst_height,
+                       src_stride, dst_stride, src, dst, clip_y, clip_height,
+                       scratch);
+      break;
+    case kScalePlaneUp2Linear:
+      ScalePlaneUp2_16_Linear(src_width, src_height, dst_width, dst_height,
+                              src_stride, dst_stride, src, dst, clip_y,
+                              clip_height);
+      break;
+    case kScalePlaneUp2Bilinear:
+      ScalePlaneUp2_16_Bilinear(src_width, src_height, dst_width, dst_height,
+                                src_stride, dst_stride, src, dst, clip_y,
+                                clip_height);
+      break;
+    case kScalePlaneBilinearUp:
+      ScalePlaneBilinearUp_16(src_width, src_height, dst_width, dst_height,
+                              src_stride, dst_stride, src, dst, clip_y,
+                              clip_height, filtering, scratch);
+      break;
+    case kScalePlaneBilinearDown:
+      ScalePlaneBilinearDown_16(src_width, src_height, dst_width, dst_height,
+                                src_stride, dst_stride, src, dst, clip_y,
+                                clip_height, filtering, scratch);
+      break;
+    default:
+      ScalePlaneSimple_16(src_width, src_height, dst_width, dst_height,
+                          src_stride, dst_stride, src, dst, clip_y,
+                          clip_height);
+      break;
+  }
+}
+
+void ScalePlaneClipAlign_16(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            enum FilterMode filtering,
+                            int* align,
+                            int* offset) {
+  filtering = ScalePlaneFilter_16(src_width, src_height, dst_width,
+                                  dst_height, filtering);
+  ScalePlaneMethodAlign(ScalePlaneMethod_16(src_width, Abs(src_height),
+                                            dst_width, dst_height, filtering),
+                        align, offset);
+}
+
+LIBYUV_API
+void ScalePlane_16(const uint16_t* src,
+                   int src_stride,
+                   int src_width,
+                   int src_height,
+                   uint16_t* dst,
+                   int dst_stride,
+                   int dst_width,
+                   int dst_height,
+                   enum FilterMode filtering) {
+  ScalePlaneClip_16(src, src_stride, src_width, src_height, dst, dst_stride,
+                    dst_width, dst_height, 0, dst_height, filtering, NULL);
+}
+
+LIBYUV_API
+void ScalePlane_16_WithScratch(const uint16_t* src,
+                               int src_stride,
+                               int src_width,
+                               int src_height,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int dst_width,
+                               int dst_height,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch) {
+  ScalePlaneClip_16(src, src_stride, src_width, src_height, dst, dst_stride,
+                    dst_width, dst_height, 0, dst_height, filtering, scratch);
+}
+
+// Largest row buffer allocated by the 16 bit box and bilinear plane scalers.
+// The box scaler sums a row of 32 bit values.
+LIBYUV_API
+int ScalePlaneScratchSize_16(int src_width,
+                             int src_height,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering) {
+  int box_size = Abs(src_width) * 4;
+  int up_size = ((dst_width + 31) & ~31) * 4;
+  (void)src_height;
+  (void)dst_height;
+  if (filtering == kFilterNone) {
+    return 0;
+  }
+  return (box_size > up_size ? box_size : up_size) + 63;
 }
 
 LIBYUV_API
@@ -2077,6 +2863,25 @@ void ScalePlane_12(const uint16_t* src,
                    int dst_width,
                    int dst_height,
                    enum FilterMode filtering) {
+  ScalePlane_12_WithScratch(src, src_stride, src_width, src_height, dst,
+                            dst_stride, dst_width, dst_height, filtering, NULL);
+}
+
+LIBYUV_API
+void ScalePlane_12_WithScratch(const uint16_t* src,
+                               int src_stride,
+                               int src_width,
+                               int src_height,
+                               uint16_t* dst,
+                               int dst_stride,
+                               int dst_width,
+                               int dst_height,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch) {
+  // The polyphase filters are 8 bit only.
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    filtering = kFilterBox;
+  }
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
@@ -2100,8 +2905,9 @@ void ScalePlane_12(const uint16_t* src,
     return;
   }
 
-  ScalePlane_16(src, src_stride, src_width, src_height, dst, dst_stride,
-                dst_width, dst_height, filtering);
+  ScalePlane_16_WithScratch(src, src_stride, src_width, src_height, dst,
+                            dst_stride, dst_width, dst_height, filtering,
+                            scratch);
 }
 
 // Scale an I420 image.
@@ -2125,22 +2931,54 @@ int I420Scale(const uint8_t* src_y,
               int dst_width,
               int dst_height,
               enum FilterMode filtering) {
+  return I420Scale_WithScratch(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, src_width, src_height, dst_y,
+                               dst_stride_y, dst_u, dst_stride_u, dst_v,
+                               dst_stride_v, dst_width, dst_height, filtering,
+                               NULL);
+}
+
+LIBYUV_API
+int I420Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch) {
   int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
   int src_halfheight = SUBSAMPLE(src_height, 1, 1);
   int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
   int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  uint64_t profile_start = ProfileStart();
   if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
       dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
 
-  ScalePlane(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-             dst_width, dst_height, filtering);
-  ScalePlane(src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
-             dst_stride_u, dst_halfwidth, dst_halfheight, filtering);
-  ScalePlane(src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
-             dst_stride_v, dst_halfwidth, dst_halfheight, filtering);
+  ScalePlane_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                         dst_stride_y, dst_width, dst_height, filtering,
+                         scratch);
+  ScalePlane_WithScratch(src_u, src_stride_u, src_halfwidth, src_halfheight,
+                         dst_u, dst_stride_u, dst_halfwidth, dst_halfheight,
+                         filtering, scratch);
+  ScalePlane_WithScratch(src_v, src_stride_v, src_halfwidth, src_halfheight,
+                         dst_v, dst_stride_v, dst_halfwidth, dst_halfheight,
+                         filtering, scratch);
+  ProfileStop(kProfileI420Scale, profile_start,
+              (uint64_t)dst_width * dst_height, kProfileKernelMixed);
   return 0;
 }
 
@@ -2162,6 +3000,32 @@ int I420Scale_16(const uint16_t* src_y,
                  int dst_width,
                  int dst_height,
                  enum FilterMode filtering) {
+  return I420Scale_16_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I420Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
   int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
   int src_halfheight = SUBSAMPLE(src_height, 1, 1);
   int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
@@ -2172,12 +3036,15 @@ int I420Scale_16(const uint16_t* src_y,
     return -1;
   }
 
-  ScalePlane_16(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-                dst_width, dst_height, filtering);
-  ScalePlane_16(src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
-                dst_stride_u, dst_halfwidth, dst_halfheight, filtering);
-  ScalePlane_16(src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
-                dst_stride_v, dst_halfwidth, dst_halfheight, filtering);
+  ScalePlane_16_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_16_WithScratch(src_u, src_stride_u, src_halfwidth, src_halfheight,
+                            dst_u, dst_stride_u, dst_halfwidth, dst_halfheight,
+                            filtering, scratch);
+  ScalePlane_16_WithScratch(src_v, src_stride_v, src_halfwidth, src_halfheight,
+                            dst_v, dst_stride_v, dst_halfwidth, dst_halfheight,
+                            filtering, scratch);
   return 0;
 }
 
@@ -2199,6 +3066,32 @@ int I420Scale_12(const uint16_t* src_y,
                  int dst_width,
                  int dst_height,
                  enum FilterMode filtering) {
+  return I420Scale_12_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I420Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
   int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
   int src_halfheight = SUBSAMPLE(src_height, 1, 1);
   int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
@@ -2209,12 +3102,15 @@ int I420Scale_12(const uint16_t* src_y,
     return -1;
   }
 
-  ScalePlane_12(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-                dst_width, dst_height, filtering);
-  ScalePlane_12(src_u, src_stride_u, src_halfwidth, src_halfheight, dst_u,
-                dst_stride_u, dst_halfwidth, dst_halfheight, filtering);
-  ScalePlane_12(src_v, src_stride_v, src_halfwidth, src_halfheight, dst_v,
-                dst_stride_v, dst_halfwidth, dst_halfheight, filtering);
+  ScalePlane_12_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_12_WithScratch(src_u, src_stride_u, src_halfwidth, src_halfheight,
+                            dst_u, dst_stride_u, dst_halfwidth, dst_halfheight,
+                            filtering, scratch);
+  ScalePlane_12_WithScratch(src_v, src_stride_v, src_halfwidth, src_halfheight,
+                            dst_v, dst_stride_v, dst_halfwidth, dst_halfheight,
+                            filtering, scratch);
   return 0;
 }
 
@@ -2239,18 +3135,47 @@ int I444Scale(const uint8_t* src_y,
               int dst_width,
               int dst_height,
               enum FilterMode filtering) {
+  return I444Scale_WithScratch(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, src_width, src_height, dst_y,
+                               dst_stride_y, dst_u, dst_stride_u, dst_v,
+                               dst_stride_v, dst_width, dst_height, filtering,
+                               NULL);
+}
+
+LIBYUV_API
+int I444Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch) {
   if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
       dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
 
-  ScalePlane(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-             dst_width, dst_height, filtering);
-  ScalePlane(src_u, src_stride_u, src_width, src_height, dst_u, dst_stride_u,
-             dst_width, dst_height, filtering);
-  ScalePlane(src_v, src_stride_v, src_width, src_height, dst_v, dst_stride_v,
-             dst_width, dst_height, filtering);
+  ScalePlane_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                         dst_stride_y, dst_width, dst_height, filtering,
+                         scratch);
+  ScalePlane_WithScratch(src_u, src_stride_u, src_width, src_height, dst_u,
+                         dst_stride_u, dst_width, dst_height, filtering,
+                         scratch);
+  ScalePlane_WithScratch(src_v, src_stride_v, src_width, src_height, dst_v,
+                         dst_stride_v, dst_width, dst_height, filtering,
+                         scratch);
   return 0;
 }
 
@@ -2272,18 +3197,47 @@ int I444Scale_16(const uint16_t* src_y,
                  int dst_width,
                  int dst_height,
                  enum FilterMode filtering) {
+  return I444Scale_16_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I444Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
   if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
       dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
 
-  ScalePlane_16(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-                dst_width, dst_height, filtering);
-  ScalePlane_16(src_u, src_stride_u, src_width, src_height, dst_u, dst_stride_u,
-                dst_width, dst_height, filtering);
-  ScalePlane_16(src_v, src_stride_v, src_width, src_height, dst_v, dst_stride_v,
-                dst_width, dst_height, filtering);
+  ScalePlane_16_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_16_WithScratch(src_u, src_stride_u, src_width, src_height, dst_u,
+                            dst_stride_u, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_16_WithScratch(src_v, src_stride_v, src_width, src_height, dst_v,
+                            dst_stride_v, dst_width, dst_height, filtering,
+                            scratch);
   return 0;
 }
 
@@ -2305,18 +3259,242 @@ int I444Scale_12(const uint16_t* src_y,
                  int dst_width,
                  int dst_height,
                  enum FilterMode filtering) {
+  return I444Scale_12_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I444Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
   if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
       dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
 
-  ScalePlane_12(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
-                dst_width, dst_height, filtering);
-  ScalePlane_12(src_u, src_stride_u, src_width, src_height, dst_u, dst_stride_u,
-                dst_width, dst_height, filtering);
-  ScalePlane_12(src_v, src_stride_v, src_width, src_height, dst_v, dst_stride_v,
-                dst_width, dst_height, filtering);
+  ScalePlane_12_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_12_WithScratch(src_u, src_stride_u, src_width, src_height, dst_u,
+                            dst_stride_u, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_12_WithScratch(src_v, src_stride_v, src_width, src_height, dst_v,
+                            dst_stride_v, dst_width, dst_height, filtering,
+                            scratch);
+  return 0;
+}
+
+// Scale an I422 image.
+// This function in turn calls a scaling function for each plane.
+
+LIBYUV_API
+int I422Scale(const uint8_t* src_y,
+              int src_stride_y,
+              const uint8_t* src_u,
+              int src_stride_u,
+              const uint8_t* src_v,
+              int src_stride_v,
+              int src_width,
+              int src_height,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_u,
+              int dst_stride_u,
+              uint8_t* dst_v,
+              int dst_stride_v,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering) {
+  return I422Scale_WithScratch(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, src_width, src_height, dst_y,
+                               dst_stride_y, dst_u, dst_stride_u, dst_v,
+                               dst_stride_v, dst_width, dst_height, filtering,
+                               NULL);
+}
+
+LIBYUV_API
+int I422Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_u,
+                          int dst_stride_u,
+                          uint8_t* dst_v,
+                          int dst_stride_v,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                         dst_stride_y, dst_width, dst_height, filtering,
+                         scratch);
+  ScalePlane_WithScratch(src_u, src_stride_u, src_halfwidth, src_height,
+                         dst_u, dst_stride_u, dst_halfwidth, dst_height,
+                         filtering, scratch);
+  ScalePlane_WithScratch(src_v, src_stride_v, src_halfwidth, src_height,
+                         dst_v, dst_stride_v, dst_halfwidth, dst_height,
+                         filtering, scratch);
+  return 0;
+}
+
+LIBYUV_API
+int I422Scale_16(const uint16_t* src_y,
+                 int src_stride_y,
+                 const uint16_t* src_u,
+                 int src_stride_u,
+                 const uint16_t* src_v,
+                 int src_stride_v,
+                 int src_width,
+                 int src_height,
+                 uint16_t* dst_y,
+                 int dst_stride_y,
+                 uint16_t* dst_u,
+                 int dst_stride_u,
+                 uint16_t* dst_v,
+                 int dst_stride_v,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering) {
+  return I422Scale_16_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I422Scale_16_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_16_WithScratch(src_u, src_stride_u, src_halfwidth, src_height,
+                            dst_u, dst_stride_u, dst_halfwidth, dst_height,
+                            filtering, scratch);
+  ScalePlane_16_WithScratch(src_v, src_stride_v, src_halfwidth, src_height,
+                            dst_v, dst_stride_v, dst_halfwidth, dst_height,
+                            filtering, scratch);
+  return 0;
+}
+
+LIBYUV_API
+int I422Scale_12(const uint16_t* src_y,
+                 int src_stride_y,
+                 const uint16_t* src_u,
+                 int src_stride_u,
+                 const uint16_t* src_v,
+                 int src_stride_v,
+                 int src_width,
+                 int src_height,
+                 uint16_t* dst_y,
+                 int dst_stride_y,
+                 uint16_t* dst_u,
+                 int dst_stride_u,
+                 uint16_t* dst_v,
+                 int dst_stride_v,
+                 int dst_width,
+                 int dst_height,
+                 enum FilterMode filtering) {
+  return I422Scale_12_WithScratch(src_y, src_stride_y, src_u, src_stride_u,
+                                  src_v, src_stride_v, src_width, src_height,
+                                  dst_y, dst_stride_y, dst_u, dst_stride_u,
+                                  dst_v, dst_stride_v, dst_width, dst_height,
+                                  filtering, NULL);
+}
+
+LIBYUV_API
+int I422Scale_12_WithScratch(const uint16_t* src_y,
+                             int src_stride_y,
+                             const uint16_t* src_u,
+                             int src_stride_u,
+                             const uint16_t* src_v,
+                             int src_stride_v,
+                             int src_width,
+                             int src_height,
+                             uint16_t* dst_y,
+                             int dst_stride_y,
+                             uint16_t* dst_u,
+                             int dst_stride_u,
+                             uint16_t* dst_v,
+                             int dst_stride_v,
+                             int dst_width,
+                             int dst_height,
+                             enum FilterMode filtering,
+                             const LibyuvScratch* scratch) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_12_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                            dst_stride_y, dst_width, dst_height, filtering,
+                            scratch);
+  ScalePlane_12_WithScratch(src_u, src_stride_u, src_halfwidth, src_height,
+                            dst_u, dst_stride_u, dst_halfwidth, dst_height,
+                            filtering, scratch);
+  ScalePlane_12_WithScratch(src_v, src_stride_v, src_halfwidth, src_height,
+                            dst_v, dst_stride_v, dst_halfwidth, dst_height,
+                            filtering, scratch);
   return 0;
 }
 
@@ -2337,10 +3515,68 @@ int NV12Scale(const uint8_t* src_y,
               int dst_width,
               int dst_height,
               enum FilterMode filtering) {
+  return NV12Scale_WithScratch(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_y, dst_stride_y,
+                               dst_uv, dst_stride_uv, dst_width, dst_height,
+                               filtering, NULL);
+}
+
+LIBYUV_API
+int NV12Scale_WithScratch(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_y,
+                          int dst_stride_y,
+                          uint8_t* dst_uv,
+                          int dst_stride_uv,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch) {
   int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
   int src_halfheight = SUBSAMPLE(src_height, 1, 1);
   int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
   int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  uint64_t profile_start = ProfileStart();
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_uv ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_WithScratch(src_y, src_stride_y, src_width, src_height, dst_y,
+                         dst_stride_y, dst_width, dst_height, filtering,
+                         scratch);
+  UVScale_WithScratch(src_uv, src_stride_uv, src_halfwidth, src_halfheight,
+                      dst_uv, dst_stride_uv, dst_halfwidth, dst_halfheight,
+                      filtering, scratch);
+  ProfileStop(kProfileNV12Scale, profile_start,
+              (uint64_t)dst_width * dst_height, kProfileKernelMixed);
+  return 0;
+}
+
+// Scale an NV16 image.
+// This function in turn calls a scaling function for each plane.
+
+LIBYUV_API
+int NV16Scale(const uint8_t* src_y,
+              int src_stride_y,
+              const uint8_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint8_t* dst_y,
+              int dst_stride_y,
+              uint8_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
   if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
       src_width > 32768 || src_height > 32768 || !dst_y || !dst_uv ||
       dst_width <= 0 || dst_height <= 0) {
@@ -2349,11 +3585,347 @@ int NV12Scale(const uint8_t* src_y,
 
   ScalePlane(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
              dst_width, dst_height, filtering);
-  UVScale(src_uv, src_stride_uv, src_halfwidth, src_halfheight, dst_uv,
-          dst_stride_uv, dst_halfwidth, dst_halfheight, filtering);
+  UVScale(src_uv, src_stride_uv, src_halfwidth, src_height, dst_uv,
+          dst_stride_uv, dst_halfwidth, dst_height, filtering);
+  return 0;
+}
+
+// Scale a P010 image.
+// This function in turn calls a scaling function for each plane.
+
+LIBYUV_API
+int P010Scale(const uint16_t* src_y,
+              int src_stride_y,
+              const uint16_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint16_t* dst_y,
+              int dst_stride_y,
+              uint16_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_uv ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
+                dst_width, dst_height, filtering);
+  UVScale_16(src_uv, src_stride_uv, src_halfwidth, src_halfheight, dst_uv,
+             dst_stride_uv, dst_halfwidth, dst_halfheight, filtering);
   return 0;
 }
 
+// Scale a P210 image.
+// This function in turn calls a scaling function for each plane.
+
+LIBYUV_API
+int P210Scale(const uint16_t* src_y,
+              int src_stride_y,
+              const uint16_t* src_uv,
+              int src_stride_uv,
+              int src_width,
+              int src_height,
+              uint16_t* dst_y,
+              int dst_stride_y,
+              uint16_t* dst_uv,
+              int dst_stride_uv,
+              int dst_width,
+              int dst_height,
+              enum FilterMode filtering) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_uv ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+
+  ScalePlane_16(src_y, src_stride_y, src_width, src_height, dst_y, dst_stride_y,
+                dst_width, dst_height, filtering);
+  UVScale_16(src_uv, src_stride_uv, src_halfwidth, src_height, dst_uv,
+             dst_stride_uv, dst_halfwidth, dst_height, filtering);
+  return 0;
+}
+
+// Scale an I420 image, splitting each plane into bands that are scaled as
+// separate jobs.
+
+LIBYUV_API
+int I420ScaleThreaded(const uint8_t* src_y,
+                      int src_stride_y,
+                      const uint8_t* src_u,
+                      int src_stride_u,
+                      const uint8_t* src_v,
+                      int src_stride_v,
+                      int src_width,
+                      int src_height,
+                      uint8_t* dst_y,
+                      int dst_stride_y,
+                      uint8_t* dst_u,
+                      int dst_stride_u,
+                      uint8_t* dst_v,
+                      int dst_stride_v,
+                      int dst_width,
+                      int dst_height,
+                      enum FilterMode filtering,
+                      int num_jobs,
+                      LibyuvDispatchFunc dispatch,
+                      void* dispatch_opaque) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int num_uv_jobs;
+  ScalePlaneScaler scaler_y;
+  ScalePlaneScaler scaler_uv;  // Shared by the U and V planes.
+  ScalePlaneBand* bands;
+  int num_bands;
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_y || !dst_u || !dst_v ||
+      dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  if (!dispatch || num_jobs <= 1) {
+    return I420Scale(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                     src_stride_v, src_width, src_height, dst_y, dst_stride_y,
+                     dst_u, dst_stride_u, dst_v, dst_stride_v, dst_width,
+                     dst_height, filtering);
+  }
+  if (num_jobs > dst_height) {
+    num_jobs = dst_height;
+  }
+  // The Y plane gets num_jobs bands and each chroma plane half as many.
+  num_uv_jobs = (num_jobs + 1) / 2;
+  bands = (ScalePlaneBand*)malloc((num_jobs + num_uv_jobs * 2) *
+                                  sizeof(ScalePlaneBand));
+  if (!bands) {
+    return 1;  // Out of memory runtime error.
+  }
+  ScalePlaneScalerInit(&scaler_y, src_width, src_height, dst_width,
+                       dst_height, filtering);
+  ScalePlaneScalerInit(&scaler_uv, src_halfwidth, src_halfheight,
+                       dst_halfwidth, dst_halfheight, filtering);
+  num_bands = ScalePlaneSplitBands(&scaler_y, src_y, src_stride_y, dst_y,
+                                   dst_stride_y, num_jobs, bands);
+  num_bands += ScalePlaneSplitBands(&scaler_uv, src_u, src_stride_u, dst_u,
+                                    dst_stride_u, num_uv_jobs,
+                                    bands + num_bands);
+  num_bands += ScalePlaneSplitBands(&scaler_uv, src_v, src_stride_v, dst_v,
+                                    dst_stride_v, num_uv_jobs,
+                                    bands + num_bands);
+  dispatch(dispatch_opaque, ScalePlaneBandJob, bands, num_bands);
+  ScalePlaneScalerFree(&scaler_y);
+  ScalePlaneScalerFree(&scaler_uv);
+  free(bands);
+  return 0;
+}
+
+struct ScalePlan {
+  enum ScalePlanFormat format;
+  int src_width;
+  int src_height;
+  int dst_width;
+  int dst_height;
+  // The Y plane, or the single plane of kScalePlanPlane, and the U and V
+  // planes of I420, which share a geometry.
+  ScalePlaneScaler plane[2];
+  ScaleUVScaler uv;  // UV plane of NV12 or kScalePlanUV.
+  ScaleARGBScaler argb;
+  uint8_t* scratch_mem;
+  LibyuvScratch scratch;
+};
+
+LIBYUV_API
+ScalePlan* ScalePlanCreate(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           enum ScalePlanFormat format) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int scratch_size;
+  ScalePlan* plan;
+  if (src_width == 0 || src_height == 0 || src_width < -32768 ||
+      src_width > 32768 || src_height > 32768 || dst_width <= 0 ||
+      dst_height <= 0) {
+    return NULL;
+  }
+  // Only the single plane and ARGB scalers mirror.
+  if (src_width < 0 && format != kScalePlanPlane && format != kScalePlanARGB) {
+    return NULL;
+  }
+  switch (format) {
+    case kScalePlanPlane:
+    case kScalePlanI420:
+      // Chroma planes of I420 need less than the Y plane.
+      scratch_size = ScalePlaneScratchSize(src_width, src_height, dst_width,
+                                           dst_height, filtering);
+      break;
+    case kScalePlanNV12: {
+      int uv_size = UVScaleScratchSize(src_halfwidth, src_halfheight,
+                                       dst_halfwidth, dst_halfheight,
+                                       filtering);
+      scratch_size = ScalePlaneScratchSize(src_width, src_height, dst_width,
+                                           dst_height, filtering);
+      if (uv_size > scratch_size) {
+        scratch_size = uv_size;
+      }
+      break;
+    }
+    case kScalePlanARGB:
+      scratch_size = ARGBScaleScratchSize(src_width, src_height, dst_width,
+                                          dst_height, filtering);
+      break;
+    case kScalePlanUV:
+      scratch_size = UVScaleScratchSize(src_width, src_height, dst_width,
+                                        dst_height, filtering);
+      break;
+    default:
+      return NULL;
+  }
+  plan = (ScalePlan*)malloc(sizeof(ScalePlan));
+  if (!plan) {
+    return NULL;
+  }
+  memset(plan, 0, sizeof(ScalePlan));
+  plan->format = format;
+  plan->src_width = src_width;
+  plan->src_height = src_height;
+  plan->dst_width = dst_width;
+  plan->dst_height = dst_height;
+  plan->scratch_mem = (uint8_t*)malloc(scratch_size + 63);
+  if (!plan->scratch_mem) {
+    free(plan);
+    return NULL;
+  }
+  plan->scratch.buffer =
+      scratch_size ? (uint8_t*)(((uintptr_t)plan->scratch_mem + 63) &
+                                ~(uintptr_t)63)
+                   : NULL;
+  plan->scratch.size = (size_t)scratch_size;
+  // Choose the row functions and build the polyphase tables once, so that
+  // ScalePlanExecute only runs rows.
+  switch (format) {
+    case kScalePlanPlane:
+      ScalePlaneScalerInit(&plan->plane[0], src_width, src_height, dst_width,
+                           dst_height, filtering);
+      break;
+    case kScalePlanI420:
+      ScalePlaneScalerInit(&plan->plane[0], src_width, src_height, dst_width,
+                           dst_height, filtering);
+      ScalePlaneScalerInit(&plan->plane[1], src_halfwidth, src_halfheight,
+                           dst_halfwidth, dst_halfheight, filtering);
+      break;
+    case kScalePlanNV12:
+      ScalePlaneScalerInit(&plan->plane[0], src_width, src_height, dst_width,
+                           dst_height, filtering);
+      ScaleUVScalerInit(&plan->uv, src_halfwidth, src_halfheight,
+                        dst_halfwidth, dst_halfheight, 0, dst_halfwidth,
+                        filtering);
+      break;
+    case kScalePlanARGB:
+      ScaleARGBScalerInit(&plan->argb, src_width, src_height, dst_width,
+                          dst_height, 0, dst_width, filtering);
+      break;
+    case kScalePlanUV:
+      ScaleUVScalerInit(&plan->uv, src_width, src_height, dst_width,
+                        dst_height, 0, dst_width, filtering);
+      break;
+  }
+  return plan;
+}
+
+LIBYUV_API
+void ScalePlanFree(ScalePlan* plan) {
+  if (plan) {
+    // Scalers a format does not use are zeroed and own no tables.
+    ScalePlaneScalerFree(&plan->plane[0]);
+    ScalePlaneScalerFree(&plan->plane[1]);
+    ScaleUVScalerFree(&plan->uv);
+    ScaleARGBScalerFree(&plan->argb);
+    free(plan->scratch_mem);
+    free(plan);
+  }
+}
+
+LIBYUV_API
+int ScalePlanExecute(const ScalePlan* plan,
+                     const uint8_t* src_y,
+                     int src_stride_y,
+                     const uint8_t* src_u,
+                     int src_stride_u,
+                     const uint8_t* src_v,
+                     int src_stride_v,
+                     uint8_t* dst_y,
+                     int dst_stride_y,
+                     uint8_t* dst_u,
+                     int dst_stride_u,
+                     uint8_t* dst_v,
+                     int dst_stride_v) {
+  uint64_t profile_start = ProfileStart();
+  if (!plan || !src_y || !dst_y) {
+    return -1;
+  }
+  switch (plan->format) {
+    case kScalePlanPlane:
+      ScalePlaneScalerRows(&plan->plane[0], src_y, src_stride_y, 0, dst_y,
+                           dst_stride_y, 0, plan->dst_height, &plan->scratch);
+      return 0;
+    case kScalePlanI420:
+      if (!src_u || !src_v || !dst_u || !dst_v) {
+        return -1;
+      }
+      ScalePlaneScalerRows(&plan->plane[0], src_y, src_stride_y, 0, dst_y,
+                           dst_stride_y, 0, plan->dst_height, &plan->scratch);
+      ScalePlaneScalerRows(&plan->plane[1], src_u, src_stride_u, 0, dst_u,
+                           dst_stride_u, 0, plan->plane[1].dst_height,
+                           &plan->scratch);
+      ScalePlaneScalerRows(&plan->plane[1], src_v, src_stride_v, 0, dst_v,
+                           dst_stride_v, 0, plan->plane[1].dst_height,
+                           &plan->scratch);
+      ProfileStop(kProfileI420Scale, profile_start,
+                  (uint64_t)plan->dst_width * plan->dst_height,
+                  kProfileKernelMixed);
+      return 0;
+    case kScalePlanNV12:
+      if (!src_u || !dst_u) {
+        return -1;
+      }
+      ScalePlaneScalerRows(&plan->plane[0], src_y, src_stride_y, 0, dst_y,
+                           dst_stride_y, 0, plan->dst_height, &plan->scratch);
+      ScaleUVScalerRows(&plan->uv, src_u, src_stride_u, 0, dst_u,
+                        dst_stride_u, 0, plan->uv.dst_height, &plan->scratch);
+      ProfileStop(kProfileNV12Scale, profile_start,
+                  (uint64_t)plan->dst_width * plan->dst_height,
+                  kProfileKernelMixed);
+      return 0;
+    case kScalePlanARGB:
+      ScaleARGBScalerRows(&plan->argb, src_y, src_stride_y, dst_y,
+                          dst_stride_y, 0, plan->dst_height, &plan->scratch);
+      ProfileStop(kProfileARGBScale, profile_start,
+                  (uint64_t)plan->dst_width * plan->dst_height,
+                  kProfileKernelMixed);
+      return 0;
+    case kScalePlanUV:
+      ScaleUVScalerRows(&plan->uv, src_y, src_stride_y, 0, dst_y,
+                        dst_stride_y, 0, plan->dst_height, &plan->scratch);
+      return 0;
+  }
+  return -1;
+}
+
 // Deprecated api
 LIBYUV_API
 int Scale(const uint8_t* src_y,
@@ -238,6 +238,26 @@ SDANY(ScaleRowDown34_1_Box_Any_SSSE3,
       1,
       23)
 #endif
+#ifdef HAS_SCALEROWDOWN34_AVX2
+SDANY(ScaleRowDown34_Any_AVX2,
+      ScaleRowDown34_AVX2,
+      ScaleRowDown34_C,
+      4 / 3,
+      1,
+      47)
+SDANY(ScaleRowDown34_0_Box_Any_AVX2,
+      ScaleRowDown34_0_Box_AVX2,
+      ScaleRowDown34_0_Box_C,
+      4 / 3,
+      1,
+      47)
+SDANY(ScaleRowDown34_1_Box_Any_AVX2,
+      ScaleRowDown34_1_Box_AVX2,
+      ScaleRowDown34_1_Box_C,
+      4 / 3,
+      1,
+      47)
+#endif
 #ifdef HAS_SCALEROWDOWN34_NEON
 SDANY(ScaleRowDown34_Any_NEON,
       ScaleRowDown34_NEON,
@@ -306,6 +326,46 @@ SDANY(ScaleRowDown38_2_Box_Any_SSSE3,
       1,
       5)
 #endif
+#ifdef HAS_SCALEROWDOWN38_AVX2
+SDANY(ScaleRowDown38_Any_AVX2,
+      ScaleRowDown38_AVX2,
+      ScaleRowDown38_C,
+      8 / 3,
+      1,
+      23)
+SDANY(ScaleRowDown38_3_Box_Any_AVX2,
+      ScaleRowDown38_3_Box_AVX2,
+      ScaleRowDown38_3_Box_C,
+      8 / 3,
+      1,
+      23)
+SDANY(ScaleRowDown38_2_Box_Any_AVX2,
+      ScaleRowDown38_2_Box_AVX2,
+      ScaleRowDown38_2_Box_C,
+      8 / 3,
+      1,
+      23)
+#endif
+#ifdef HAS_SCALEROWDOWN38_AVX512BW
+SDANY(ScaleRowDown38_Any_AVX512BW,
+      ScaleRowDown38_AVX512BW,
+      ScaleRowDown38_C,
+      8 / 3,
+      1,
+      47)
+SDANY(ScaleRowDown38_3_Box_Any_AVX512BW,
+      ScaleRowDown38_3_Box_AVX512BW,
+      ScaleRowDown38_3_Box_C,
+      8 / 3,
+      1,
+      47)
+SDANY(ScaleRowDown38_2_Box_Any_AVX512BW,
+      ScaleRowDown38_2_Box_AVX512BW,
+      ScaleRowDown38_2_Box_C,
+      8 / 3,
+      1,
+      47)
+#endif
 #ifdef HAS_SCALEROWDOWN38_NEON
 SDANY(ScaleRowDown38_Any_NEON,
       ScaleRowDown38_NEON,
@@ -429,6 +489,65 @@ SDANY(ScaleARGBRowDown2Box_Any_MMI,
 #endif
 #undef SDANY
 
+// Fixed scale down for 16 bit pixels.
+#define SD16ANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, FACTOR, MASK) \
+  void NAMEANY(const uint16_t* src_ptr, ptrdiff_t src_stride,            \
+               uint16_t* dst_ptr, int dst_width) {                       \
+    int r = dst_width & MASK;                                            \
+    int n = dst_width & ~MASK;                                           \
+    if (n > 0) {                                                         \
+      SCALEROWDOWN_SIMD(src_ptr, src_stride, dst_ptr, n);                \
+    }                                                                    \
+    SCALEROWDOWN_C(src_ptr + n * FACTOR, src_stride, dst_ptr + n, r);    \
+  }
+
+#ifdef HAS_SCALEROWDOWN2_16_SSE2
+SD16ANY(ScaleRowDown2_16_Any_SSE2, ScaleRowDown2_16_SSE2, ScaleRowDown2_16_C,
+        2,
+        7)
+SD16ANY(ScaleRowDown2Linear_16_Any_SSE2,
+        ScaleRowDown2Linear_16_SSE2,
+        ScaleRowDown2Linear_16_C,
+        2,
+        7)
+SD16ANY(ScaleRowDown2Box_16_Any_SSE2,
+        ScaleRowDown2Box_16_SSE2,
+        ScaleRowDown2Box_16_C,
+        2,
+        7)
+#endif
+#ifdef HAS_SCALEROWDOWN2_16_AVX2
+SD16ANY(ScaleRowDown2_16_Any_AVX2, ScaleRowDown2_16_AVX2, ScaleRowDown2_16_C,
+        2,
+        15)
+SD16ANY(ScaleRowDown2Linear_16_Any_AVX2,
+        ScaleRowDown2Linear_16_AVX2,
+        ScaleRowDown2Linear_16_C,
+        2,
+        15)
+SD16ANY(ScaleRowDown2Box_16_Any_AVX2,
+        ScaleRowDown2Box_16_AVX2,
+        ScaleRowDown2Box_16_C,
+        2,
+        15)
+#endif
+#ifdef HAS_SCALEROWDOWN2_16_NEON
+SD16ANY(ScaleRowDown2_16_Any_NEON, ScaleRowDown2_16_NEON, ScaleRowDown2_16_C,
+        2,
+        7)
+SD16ANY(ScaleRowDown2Linear_16_Any_NEON,
+        ScaleRowDown2Linear_16_NEON,
+        ScaleRowDown2Linear_16_C,
+        2,
+        7)
+SD16ANY(ScaleRowDown2Box_16_Any_NEON,
+        ScaleRowDown2Box_16_NEON,
+        ScaleRowDown2Box_16_C,
+        2,
+        7)
+#endif
+#undef SD16ANY
+
 // Scale down by even scale factor.
 #define SDAANY(NAMEANY, SCALEROWDOWN_SIMD, SCALEROWDOWN_C, BPP, MASK)       \
   void NAMEANY(const uint8_t* src_ptr, ptrdiff_t src_stride, int src_stepx, \
@@ -566,6 +685,30 @@ SAANY(ScaleAddRow_Any_MMI, ScaleAddRow_MMI, ScaleAddRow_C, 7)
 
 #endif  // SASIMDONLY
 
+// Add rows box filter scale down for 16 bit pixels.  ScaleAddRow_16_C
+// requires a width, so it is only called for a remainder.
+#define SAANY16(NAMEANY, SCALEADDROW_SIMD, SCALEADDROW_C, MASK)              \
+  void NAMEANY(const uint16_t* src_ptr, uint32_t* dst_ptr, int src_width) { \
+    int n = src_width & ~MASK;                                              \
+    if (n > 0) {                                                            \
+      SCALEADDROW_SIMD(src_ptr, dst_ptr, n);                                \
+    }                                                                       \
+    if (src_width & MASK) {                                                 \
+      SCALEADDROW_C(src_ptr + n, dst_ptr + n, src_width & MASK);            \
+    }                                                                       \
+  }
+
+#ifdef HAS_SCALEADDROW_16_SSE2
+SAANY16(ScaleAddRow_16_Any_SSE2, ScaleAddRow_16_SSE2, ScaleAddRow_16_C, 7)
+#endif
+#ifdef HAS_SCALEADDROW_16_AVX2
+SAANY16(ScaleAddRow_16_Any_AVX2, ScaleAddRow_16_AVX2, ScaleAddRow_16_C, 15)
+#endif
+#ifdef HAS_SCALEADDROW_16_NEON
+SAANY16(ScaleAddRow_16_Any_NEON, ScaleAddRow_16_NEON, ScaleAddRow_16_C, 7)
+#endif
+#undef SAANY16
+
 // Definition for ScaleFilterCols, ScaleARGBCols and ScaleARGBFilterCols
 #define CANY(NAMEANY, TERP_SIMD, TERP_C, BPP, MASK)                            \
   void NAMEANY(uint8_t* dst_ptr, const uint8_t* src_ptr, int dst_width, int x, \
@@ -578,6 +721,16 @@ SAANY(ScaleAddRow_Any_MMI, ScaleAddRow_MMI, ScaleAddRow_C, 7)
     TERP_C(dst_ptr + n * BPP, src_ptr, r, x + n * dx, dx);                     \
   }
 
+#ifdef HAS_SCALEFILTERCOLS_AVX2
+CANY(ScaleFilterCols_Any_AVX2, ScaleFilterCols_AVX2, ScaleFilterCols_C, 1, 7)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_AVX512BW
+CANY(ScaleFilterCols_Any_AVX512BW,
+     ScaleFilterCols_AVX512BW,
+     ScaleFilterCols_C,
+     1,
+     15)
+#endif
 #ifdef HAS_SCALEFILTERCOLS_NEON
 CANY(ScaleFilterCols_Any_NEON, ScaleFilterCols_NEON, ScaleFilterCols_C, 1, 7)
 #endif
@@ -593,6 +746,20 @@ CANY(ScaleARGBCols_Any_MSA, ScaleARGBCols_MSA, ScaleARGBCols_C, 4, 3)
 #ifdef HAS_SCALEARGBCOLS_MMI
 CANY(ScaleARGBCols_Any_MMI, ScaleARGBCols_MMI, ScaleARGBCols_C, 4, 0)
 #endif
+#ifdef HAS_SCALEARGBFILTERCOLS_AVX2
+CANY(ScaleARGBFilterCols_Any_AVX2,
+     ScaleARGBFilterCols_AVX2,
+     ScaleARGBFilterCols_C,
+     4,
+     7)
+#endif
+#ifdef HAS_SCALEARGBFILTERCOLS_AVX512BW
+CANY(ScaleARGBFilterCols_Any_AVX512BW,
+     ScaleARGBFilterCols_AVX512BW,
+     ScaleARGBFilterCols_C,
+     4,
+     15)
+#endif
 #ifdef HAS_SCALEARGBFILTERCOLS_NEON
 CANY(ScaleARGBFilterCols_Any_NEON,
      ScaleARGBFilterCols_NEON,
@@ -609,6 +776,106 @@ CANY(ScaleARGBFilterCols_Any_MSA,
 #endif
 #undef CANY
 
+// Definition for ScaleFilterCols_16 and ScaleUVFilterCols_16.  BPP is in
+// uint16_t.
+#define CANY16(NAMEANY, TERP_SIMD, TERP_C, BPP, MASK)                     \
+  void NAMEANY(uint16_t* dst_ptr, const uint16_t* src_ptr, int dst_width, \
+               int x, int dx) {                                           \
+    int r = dst_width & MASK;                                             \
+    int n = dst_width & ~MASK;                                            \
+    if (n > 0) {                                                          \
+      TERP_SIMD(dst_ptr, src_ptr, n, x, dx);                              \
+    }                                                                     \
+    TERP_C(dst_ptr + n * BPP, src_ptr, r, x + n * dx, dx);                \
+  }
+
+#ifdef HAS_SCALEFILTERCOLS_16_SSE2
+CANY16(ScaleFilterCols_16_Any_SSE2,
+       ScaleFilterCols_16_SSE2,
+       ScaleFilterCols_16_C,
+       1,
+       3)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_16_AVX2
+CANY16(ScaleFilterCols_16_Any_AVX2,
+       ScaleFilterCols_16_AVX2,
+       ScaleFilterCols_16_C,
+       1,
+       7)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_16_NEON
+CANY16(ScaleFilterCols_16_Any_NEON,
+       ScaleFilterCols_16_NEON,
+       ScaleFilterCols_16_C,
+       1,
+       7)
+#endif
+#ifdef HAS_SCALEUVFILTERCOLS_16_AVX2
+CANY16(ScaleUVFilterCols_16_Any_AVX2,
+       ScaleUVFilterCols_16_AVX2,
+       ScaleUVFilterCols_16_C,
+       2,
+       7)
+#endif
+#undef CANY16
+
+// Definition for ScaleFilterCols64.  The SIMD column filters take a 32 bit x,
+// so the row is done in runs that each span less than 16384 source pixels,
+// with x relative to a source pointer just before the start of the run.
+#define C64ANY(NAMEANY, TERP_ANY, TERP_C, MASK, PTYPE)                         \
+  void NAMEANY(PTYPE* dst_ptr, const PTYPE* src_ptr, int dst_width, int x32,   \
+               int dx) {                                                       \
+    int64_t x = (int64_t)(x32);                                                \
+    int64_t adx = dx < 0 ? -(int64_t)dx : dx;                                  \
+    int run = (int)((adx ? 0x40000000 / adx : dst_width) & ~MASK);             \
+    if (run < MASK + 1) {                                                      \
+      TERP_C(dst_ptr, src_ptr, dst_width, x32, dx);                            \
+      return;                                                                  \
+    }                                                                          \
+    while (dst_width > 0) {                                                    \
+      int n = dst_width < run ? dst_width : run;                               \
+      int64_t x_last = x + (int64_t)(n - 1) * dx;                              \
+      int64_t base = ((x < x_last ? x : x_last) >> 16) - 2;                    \
+      if (base < 0) {                                                          \
+        base = 0;                                                              \
+      }                                                                        \
+      TERP_ANY(dst_ptr, src_ptr + base, n, (int)(x - (base << 16)), dx);       \
+      dst_ptr += n;                                                            \
+      dst_width -= n;                                                          \
+      x += (int64_t)n * dx;                                                    \
+    }                                                                          \
+  }
+
+#ifdef HAS_SCALEFILTERCOLS_AVX2
+C64ANY(ScaleFilterCols64_AVX2,
+       ScaleFilterCols_Any_AVX2,
+       ScaleFilterCols64_C,
+       7,
+       uint8_t)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_AVX512BW
+C64ANY(ScaleFilterCols64_AVX512BW,
+       ScaleFilterCols_Any_AVX512BW,
+       ScaleFilterCols64_C,
+       15,
+       uint8_t)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_16_SSE2
+C64ANY(ScaleFilterCols64_16_SSE2,
+       ScaleFilterCols_16_Any_SSE2,
+       ScaleFilterCols64_16_C,
+       3,
+       uint16_t)
+#endif
+#ifdef HAS_SCALEFILTERCOLS_16_AVX2
+C64ANY(ScaleFilterCols64_16_AVX2,
+       ScaleFilterCols_16_Any_AVX2,
+       ScaleFilterCols64_16_C,
+       7,
+       uint16_t)
+#endif
+#undef C64ANY
+
 // Scale up horizontally 2 times using linear filter.
 #define SUH2LANY(NAME, SIMD, C, MASK, PTYPE)                       \
   void NAME(const PTYPE* src_ptr, PTYPE* dst_ptr, int dst_width) { \
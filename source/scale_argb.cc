@@ -16,7 +16,11 @@
 #include "libyuv/cpu_id.h"
 #include "libyuv/planar_functions.h"  // For CopyARGB
 #include "libyuv/row.h"
+#include "libyuv/scale_argb.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/scale_uv.h"  // For UVScaleScratchSize
+
+#include "profile_internal.h"  // For ProfileStart
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -27,41 +31,22 @@ static __inline int Abs(int v) {
   return v >= 0 ? v : -v;
 }
 
+#define SUBSAMPLE(v, a, s) (v < 0) ? (-((-v + a) >> s)) : ((v + a) >> s)
+
 // ScaleARGB ARGB, 1/2
 // This is an optimized version for scaling down a ARGB to 1/2 of
 // its original size.
-static void ScaleARGBDown2(int src_width,
-                           int src_height,
-                           int dst_width,
-                           int dst_height,
-                           int src_stride,
-                           int dst_stride,
-                           const uint8_t* src_argb,
-                           uint8_t* dst_argb,
-                           int x,
-                           int dx,
-                           int y,
-                           int dy,
-                           enum FilterMode filtering) {
-  int j;
-  int row_stride = src_stride * (dy >> 16);
+static void ScaleARGBDown2Init(ScaleARGBScaler* s) {
+  const int dst_width = s->clip_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleARGBRowDown2)(const uint8_t* src_argb, ptrdiff_t src_stride,
                             uint8_t* dst_argb, int dst_width) =
       filtering == kFilterNone
           ? ScaleARGBRowDown2_C
           : (filtering == kFilterLinear ? ScaleARGBRowDown2Linear_C
                                         : ScaleARGBRowDown2Box_C);
-  (void)src_width;
-  (void)src_height;
-  (void)dx;
-  assert(dx == 65536 * 2);      // Test scale factor of 2.
-  assert((dy & 0x1ffff) == 0);  // Test vertical scale is multiple of 2.
-  // Advance to odd row, even column.
-  if (filtering == kFilterBilinear) {
-    src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
-  } else {
-    src_argb += (y >> 16) * src_stride + ((x >> 16) - 1) * 4;
-  }
+  assert(s->dx == 65536 * 2);      // Test scale factor of 2.
+  assert((s->dy & 0x1ffff) == 0);  // Test vertical scale is multiple of 2.
 
 #if defined(HAS_SCALEARGBROWDOWN2_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
@@ -127,12 +112,29 @@ static void ScaleARGBDown2(int src_width,
     }
   }
 #endif
+  s->ScaleARGBRowDown2 = ScaleARGBRowDown2;
+}
 
-  if (filtering == kFilterLinear) {
+static void ScaleARGBDown2(const ScaleARGBScaler* s,
+                           int dst_height,
+                           int src_stride,
+                           int dst_stride,
+                           const uint8_t* src_argb,
+                           uint8_t* dst_argb,
+                           int y) {
+  int j;
+  int row_stride = src_stride * (s->dy >> 16);
+  // Advance to odd row, even column.
+  if (s->filtering == kFilterBilinear) {
+    src_argb += (y >> 16) * src_stride + (s->x >> 16) * 4;
+  } else {
+    src_argb += (y >> 16) * src_stride + ((s->x >> 16) - 1) * 4;
+  }
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   for (j = 0; j < dst_height; ++j) {
-    ScaleARGBRowDown2(src_argb, src_stride, dst_argb, dst_width);
+    s->ScaleARGBRowDown2(src_argb, src_stride, dst_argb, s->clip_width);
     src_argb += row_stride;
     dst_argb += dst_stride;
   }
@@ -141,33 +143,13 @@ static void ScaleARGBDown2(int src_width,
 // ScaleARGB ARGB, 1/4
 // This is an optimized version for scaling down a ARGB to 1/4 of
 // its original size.
-static void ScaleARGBDown4Box(int src_width,
-                              int src_height,
-                              int dst_width,
-                              int dst_height,
-                              int src_stride,
-                              int dst_stride,
-                              const uint8_t* src_argb,
-                              uint8_t* dst_argb,
-                              int x,
-                              int dx,
-                              int y,
-                              int dy) {
-  int j;
-  // Allocate 2 rows of ARGB.
-  const int kRowSize = (dst_width * 2 * 4 + 31) & ~31;
-  align_buffer_64(row, kRowSize * 2);
-  int row_stride = src_stride * (dy >> 16);
+static void ScaleARGBDown4BoxInit(ScaleARGBScaler* s) {
+  const int dst_width = s->clip_width;
   void (*ScaleARGBRowDown2)(const uint8_t* src_argb, ptrdiff_t src_stride,
                             uint8_t* dst_argb, int dst_width) =
       ScaleARGBRowDown2Box_C;
-  // Advance to odd row, even column.
-  src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
-  (void)src_width;
-  (void)src_height;
-  (void)dx;
-  assert(dx == 65536 * 4);      // Test scale factor of 4.
-  assert((dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
+  assert(s->dx == 65536 * 4);      // Test scale factor of 4.
+  assert((s->dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
 #if defined(HAS_SCALEARGBROWDOWN2_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     ScaleARGBRowDown2 = ScaleARGBRowDown2Box_Any_SSE2;
@@ -184,12 +166,30 @@ static void ScaleARGBDown4Box(int src_width,
     }
   }
 #endif
+  s->ScaleARGBRowDown2 = ScaleARGBRowDown2;
+}
 
+static void ScaleARGBDown4Box(const ScaleARGBScaler* s,
+                              int dst_height,
+                              int src_stride,
+                              int dst_stride,
+                              const uint8_t* src_argb,
+                              uint8_t* dst_argb,
+                              int y,
+                              const LibyuvScratch* scratch) {
+  int j;
+  const int dst_width = s->clip_width;
+  // Allocate 2 rows of ARGB.
+  const int kRowSize = (dst_width * 2 * 4 + 31) & ~31;
+  align_buffer_64_scratch(row, kRowSize * 2, scratch);
+  int row_stride = src_stride * (s->dy >> 16);
+  // Advance to odd row, even column.
+  src_argb += (y >> 16) * src_stride + (s->x >> 16) * 4;
   for (j = 0; j < dst_height; ++j) {
-    ScaleARGBRowDown2(src_argb, src_stride, row, dst_width * 2);
-    ScaleARGBRowDown2(src_argb + src_stride * 2, src_stride, row + kRowSize,
-                      dst_width * 2);
-    ScaleARGBRowDown2(row, kRowSize, dst_argb, dst_width);
+    s->ScaleARGBRowDown2(src_argb, src_stride, row, dst_width * 2);
+    s->ScaleARGBRowDown2(src_argb + src_stride * 2, src_stride, row + kRowSize,
+                         dst_width * 2);
+    s->ScaleARGBRowDown2(row, kRowSize, dst_argb, dst_width);
     src_argb += row_stride;
     dst_argb += dst_stride;
   }
@@ -199,30 +199,14 @@ static void ScaleARGBDown4Box(int src_width,
 // ScaleARGB ARGB Even
 // This is an optimized version for scaling down a ARGB to even
 // multiple of its original size.
-static void ScaleARGBDownEven(int src_width,
-                              int src_height,
-                              int dst_width,
-                              int dst_height,
-                              int src_stride,
-                              int dst_stride,
-                              const uint8_t* src_argb,
-                              uint8_t* dst_argb,
-                              int x,
-                              int dx,
-                              int y,
-                              int dy,
-                              enum FilterMode filtering) {
-  int j;
-  int col_step = dx >> 16;
-  int row_stride = (dy >> 16) * src_stride;
+static void ScaleARGBDownEvenInit(ScaleARGBScaler* s) {
+  const int dst_width = s->clip_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleARGBRowDownEven)(const uint8_t* src_argb, ptrdiff_t src_stride,
                                int src_step, uint8_t* dst_argb, int dst_width) =
       filtering ? ScaleARGBRowDownEvenBox_C : ScaleARGBRowDownEven_C;
-  (void)src_width;
-  (void)src_height;
-  assert(IS_ALIGNED(src_width, 2));
-  assert(IS_ALIGNED(src_height, 2));
-  src_argb += (y >> 16) * src_stride + (x >> 16) * 4;
+  assert(IS_ALIGNED(s->src_width, 2));
+  assert(IS_ALIGNED(s->src_height, 2));
 #if defined(HAS_SCALEARGBROWDOWNEVEN_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
     ScaleARGBRowDownEven = filtering ? ScaleARGBRowDownEvenBox_Any_SSE2
@@ -263,32 +247,39 @@ static void ScaleARGBDownEven(int src_width,
     }
   }
 #endif
+  s->ScaleARGBRowDownEven = ScaleARGBRowDownEven;
+}
 
-  if (filtering == kFilterLinear) {
+static void ScaleARGBDownEven(const ScaleARGBScaler* s,
+                              int dst_height,
+                              int src_stride,
+                              int dst_stride,
+                              const uint8_t* src_argb,
+                              uint8_t* dst_argb,
+                              int y) {
+  int j;
+  int col_step = s->dx >> 16;
+  int row_stride = (s->dy >> 16) * src_stride;
+  src_argb += (y >> 16) * src_stride + (s->x >> 16) * 4;
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   for (j = 0; j < dst_height; ++j) {
-    ScaleARGBRowDownEven(src_argb, src_stride, col_step, dst_argb, dst_width);
+    s->ScaleARGBRowDownEven(src_argb, src_stride, col_step, dst_argb,
+                            s->clip_width);
     src_argb += row_stride;
     dst_argb += dst_stride;
   }
 }
 
 // Scale ARGB down with bilinear interpolation.
-static void ScaleARGBBilinearDown(int src_width,
-                                  int src_height,
-                                  int dst_width,
-                                  int dst_height,
-                                  int src_stride,
-                                  int dst_stride,
-                                  const uint8_t* src_argb,
-                                  uint8_t* dst_argb,
-                                  int x,
-                                  int dx,
-                                  int y,
-                                  int dy,
-                                  enum FilterMode filtering) {
-  int j;
+// The source columns of the clip are interpolated 4 pixel aligned, from
+// src_offset.
+static void ScaleARGBBilinearDownInit(ScaleARGBScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const int dx = s->dx;
   void (*InterpolateRow)(uint8_t * dst_argb, const uint8_t* src_argb,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
@@ -306,8 +297,9 @@ static void ScaleARGBBilinearDown(int src_width,
     xr = src_width;
   }
   clip_src_width = (int)(xr - xl) * 4;  // Width aligned to 4.
-  src_argb += xl * 4;
-  x -= (int)(xl << 16);
+  s->src_offset += (int)xl * 4;
+  s->x -= (int)(xl << 16);
+  s->row_bytes = clip_src_width;
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_SSSE3;
@@ -345,6 +337,22 @@ static void ScaleARGBBilinearDown(int src_width,
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
@@ -361,24 +369,44 @@ static void ScaleARGBBilinearDown(int src_width,
     }
   }
 #endif
+  s->InterpolateRow = InterpolateRow;
+  s->ScaleARGBCols = ScaleARGBFilterCols;
+}
+
+// Scale ARGB down with bilinear interpolation.  src_argb points to
+// src_offset.
+static void ScaleARGBBilinearDown(const ScaleARGBScaler* s,
+                                  int dst_height,
+                                  int src_stride,
+                                  int dst_stride,
+                                  const uint8_t* src_argb,
+                                  uint8_t* dst_argb,
+                                  int y,
+                                  const LibyuvScratch* scratch) {
+  int j;
+  const int dst_width = s->clip_width;
+  const int clip_src_width = s->row_bytes;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row of ARGB.
   {
-    align_buffer_64(row, clip_src_width * 4);
+    align_buffer_64_scratch(row, clip_src_width, scratch);
 
-    const int max_y = (src_height - 1) << 16;
+    const int max_y = (Abs(s->src_height) - 1) << 16;
     if (y > max_y) {
       y = max_y;
     }
     for (j = 0; j < dst_height; ++j) {
       int yi = y >> 16;
       const uint8_t* src = src_argb + yi * src_stride;
-      if (filtering == kFilterLinear) {
-        ScaleARGBFilterCols(dst_argb, src, dst_width, x, dx);
+      if (s->filtering == kFilterLinear) {
+        s->ScaleARGBCols(dst_argb, src, dst_width, x, dx);
       } else {
         int yf = (y >> 8) & 255;
-        InterpolateRow(row, src, src_stride, clip_src_width, yf);
-        ScaleARGBFilterCols(dst_argb, row, dst_width, x, dx);
+        s->InterpolateRow(row, src, src_stride, clip_src_width, yf);
+        s->ScaleARGBCols(dst_argb, row, dst_width, x, dx);
       }
       dst_argb += dst_stride;
       y += dy;
@@ -391,27 +419,17 @@ static void ScaleARGBBilinearDown(int src_width,
 }
 
 // Scale ARGB up with bilinear interpolation.
-static void ScaleARGBBilinearUp(int src_width,
-                                int src_height,
-                                int dst_width,
-                                int dst_height,
-                                int src_stride,
-                                int dst_stride,
-                                const uint8_t* src_argb,
-                                uint8_t* dst_argb,
-                                int x,
-                                int dx,
-                                int y,
-                                int dy,
-                                enum FilterMode filtering) {
-  int j;
+static void ScaleARGBBilinearUpInit(ScaleARGBScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const enum FilterMode filtering = s->filtering;
   void (*InterpolateRow)(uint8_t * dst_argb, const uint8_t* src_argb,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
   void (*ScaleARGBFilterCols)(uint8_t * dst_argb, const uint8_t* src_argb,
                               int dst_width, int x, int dx) =
       filtering ? ScaleARGBFilterCols_C : ScaleARGBCols_C;
-  const int max_y = (src_height - 1) << 16;
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_SSSE3;
@@ -461,6 +479,22 @@ static void ScaleARGBBilinearUp(int src_width,
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX512BW)
+  if (filtering && TestCpuFlag(kCpuHasAVX512BW) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (filtering && TestCpuFlag(kCpuHasNEON)) {
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
@@ -519,6 +553,30 @@ static void ScaleARGBBilinearUp(int src_width,
     }
 #endif
   }
+  s->InterpolateRow = InterpolateRow;
+  s->ScaleARGBCols = ScaleARGBFilterCols;
+}
+
+static void ScaleARGBBilinearUp(const ScaleARGBScaler* s,
+                                int dst_height,
+                                int src_stride,
+                                int dst_stride,
+                                const uint8_t* src_argb,
+                                uint8_t* dst_argb,
+                                int y,
+                                const LibyuvScratch* scratch) {
+  int j;
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
+  const int max_y = (src_height - 1) << 16;
+  void (*InterpolateRow)(uint8_t * dst_argb, const uint8_t* src_argb,
+                         ptrdiff_t src_stride, int dst_width,
+                         int source_y_fraction) = s->InterpolateRow;
+  void (*ScaleARGBFilterCols)(uint8_t * dst_argb, const uint8_t* src_argb,
+                              int dst_width, int x, int dx) = s->ScaleARGBCols;
 
   if (y > max_y) {
     y = max_y;
@@ -530,7 +588,7 @@ static void ScaleARGBBilinearUp(int src_width,
 
     // Allocate 2 rows of ARGB.
     const int kRowSize = (dst_width * 4 + 31) & ~31;
-    align_buffer_64(row, kRowSize * 2);
+    align_buffer_64_scratch(row, kRowSize * 2, scratch);
 
     uint8_t* rowptr = row;
     int rowstride = kRowSize;
@@ -559,7 +617,7 @@ static void ScaleARGBBilinearUp(int src_width,
           src += src_stride;
         }
       }
-      if (filtering == kFilterLinear) {
+      if (s->filtering == kFilterLinear) {
         InterpolateRow(dst_argb, rowptr, 0, dst_width * 4, 0);
       } else {
         int yf = (y >> 8) & 255;
@@ -611,6 +669,14 @@ static void ScaleYUVToARGBBilinearUp(int src_width,
     }
   }
 #endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(src_width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_I422TOARGBROW_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
     I422ToARGBRow = I422ToARGBRow_Any_NEON;
@@ -684,6 +750,22 @@ static void ScaleYUVToARGBBilinearUp(int src_width,
     ScaleARGBFilterCols = ScaleARGBFilterCols_SSSE3;
   }
 #endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX2)
+  if (filtering && TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEARGBFILTERCOLS_AVX512BW)
+  if (filtering && TestCpuFlag(kCpuHasAVX512BW) && src_width < 32768) {
+    ScaleARGBFilterCols = ScaleARGBFilterCols_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ScaleARGBFilterCols = ScaleARGBFilterCols_AVX512BW;
+    }
+  }
+#endif
 #if defined(HAS_SCALEARGBFILTERCOLS_NEON)
   if (filtering && TestCpuFlag(kCpuHasNEON)) {
     ScaleARGBFilterCols = ScaleARGBFilterCols_Any_NEON;
@@ -827,23 +909,13 @@ static void ScaleYUVToARGBBilinearUp(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScaleARGBSimple(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_argb,
-                            uint8_t* dst_argb,
-                            int x,
-                            int dx,
-                            int y,
-                            int dy) {
-  int j;
+static void ScaleARGBSimpleInit(ScaleARGBScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
   void (*ScaleARGBCols)(uint8_t * dst_argb, const uint8_t* src_argb,
                         int dst_width, int x, int dx) =
       (src_width >= 32768) ? ScaleARGBCols64_C : ScaleARGBCols_C;
-  (void)src_height;
 #if defined(HAS_SCALEARGBCOLS_SSE2)
   if (TestCpuFlag(kCpuHasSSE2) && src_width < 32768) {
     ScaleARGBCols = ScaleARGBCols_SSE2;
@@ -886,120 +958,226 @@ static void ScaleARGBSimple(int src_width,
     }
 #endif
   }
+  s->ScaleARGBCols = ScaleARGBCols;
+}
 
+static void ScaleARGBSimple(const ScaleARGBScaler* s,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_argb,
+                            uint8_t* dst_argb,
+                            int y) {
+  int j;
   for (j = 0; j < dst_height; ++j) {
-    ScaleARGBCols(dst_argb, src_argb + (y >> 16) * src_stride, dst_width, x,
-                  dx);
+    s->ScaleARGBCols(dst_argb, src_argb + (y >> 16) * src_stride,
+                     s->clip_width, s->x, s->dx);
     dst_argb += dst_stride;
-    y += dy;
+    y += s->dy;
   }
 }
 
-// ScaleARGB a ARGB.
-// This function in turn calls a scaling function
-// suitable for handling the desired resolutions.
-static void ScaleARGB(const uint8_t* src,
-                      int src_stride,
-                      int src_width,
-                      int src_height,
-                      uint8_t* dst,
-                      int dst_stride,
-                      int dst_width,
-                      int dst_height,
-                      int clip_x,
-                      int clip_y,
-                      int clip_width,
-                      int clip_height,
-                      enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
+// Scale ARGB vertically, unscaled horizontally.
+static void ScaleARGBVerticalInit(ScaleARGBScaler* s) {
+  const struct RowKernels* kernels = GetRowKernels();
+  s->InterpolateRow = ROW_KERNEL(kernels, InterpolateRow, s->clip_width * 4);
+}
+
+// Choose the method and row functions of an ARGB scale, once for a geometry.
+static void ScaleARGBScalerChoose(ScaleARGBScaler* s,
+                                  int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  int clip_x,
+                                  int clip_width,
+                                  enum FilterMode filtering) {
   // ARGB does not support box filter yet, but allow the user to pass it.
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
-
-  // Negative src_height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
-    src_stride = -src_stride;
+  memset(s, 0, sizeof(*s));
+  s->src_width = src_width;
+  s->src_height = src_height;
+  s->dst_width = dst_width;
+  s->dst_height = dst_height;
+  s->clip_x = clip_x;
+  s->clip_width = clip_width;
+  s->filtering = filtering;
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    s->method = kScaleARGBPolyphase;
+    ScalePolyphaseInit(&s->polyphase, src_width, Abs(src_height), dst_width,
+                       dst_height, 4, filtering);
+    return;
   }
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
-  src_width = Abs(src_width);
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, Abs(src_height), dst_width, dst_height, filtering,
+             &s->x, &s->y, &s->dx, &s->dy);
   if (clip_x) {
-    int64_t clipf = (int64_t)(clip_x)*dx;
-    x += (clipf & 0xffff);
-    src += (clipf >> 16) * 4;
-    dst += clip_x * 4;
-  }
-  if (clip_y) {
-    int64_t clipf = (int64_t)(clip_y)*dy;
-    y += (clipf & 0xffff);
-    src += (clipf >> 16) * src_stride;
-    dst += clip_y * dst_stride;
+    int64_t clipf = (int64_t)(clip_x)*s->dx;
+    s->x += (clipf & 0xffff);
+    s->src_offset = (int)(clipf >> 16) * 4;
   }
 
   // Special case for integer step values.
-  if (((dx | dy) & 0xffff) == 0) {
-    if (!dx || !dy) {  // 1 pixel wide and/or tall.
-      filtering = kFilterNone;
+  if (((s->dx | s->dy) & 0xffff) == 0) {
+    if (!s->dx || !s->dy) {  // 1 pixel wide and/or tall.
+      s->filtering = kFilterNone;
     } else {
       // Optimized even scale down. ie 2, 4, 6, 8, 10x.
-      if (!(dx & 0x10000) && !(dy & 0x10000)) {
-        if (dx == 0x20000) {
+      if (!(s->dx & 0x10000) && !(s->dy & 0x10000)) {
+        if (s->dx == 0x20000) {
           // Optimized 1/2 downsample.
-          ScaleARGBDown2(src_width, src_height, clip_width, clip_height,
-                         src_stride, dst_stride, src, dst, x, dx, y, dy,
-                         filtering);
+          s->method = kScaleARGBDown2;
+          ScaleARGBDown2Init(s);
           return;
         }
-        if (dx == 0x40000 && filtering == kFilterBox) {
+        if (s->dx == 0x40000 && s->filtering == kFilterBox) {
           // Optimized 1/4 box downsample.
-          ScaleARGBDown4Box(src_width, src_height, clip_width, clip_height,
-                            src_stride, dst_stride, src, dst, x, dx, y, dy);
+          s->method = kScaleARGBDown4Box;
+          ScaleARGBDown4BoxInit(s);
           return;
         }
-        ScaleARGBDownEven(src_width, src_height, clip_width, clip_height,
-                          src_stride, dst_stride, src, dst, x, dx, y, dy,
-                          filtering);
+        s->method = kScaleARGBDownEven;
+        ScaleARGBDownEvenInit(s);
         return;
       }
       // Optimized odd scale down. ie 3, 5, 7, 9x.
-      if ((dx & 0x10000) && (dy & 0x10000)) {
-        filtering = kFilterNone;
-        if (dx == 0x10000 && dy == 0x10000) {
+      if ((s->dx & 0x10000) && (s->dy & 0x10000)) {
+        s->filtering = kFilterNone;
+        if (s->dx == 0x10000 && s->dy == 0x10000) {
           // Straight copy.
-          ARGBCopy(src + (y >> 16) * src_stride + (x >> 16) * 4, src_stride,
-                   dst, dst_stride, clip_width, clip_height);
+          s->method = kScaleARGBCopy;
           return;
         }
       }
     }
   }
-  if (dx == 0x10000 && (x & 0xffff) == 0) {
+  if (s->dx == 0x10000 && (s->x & 0xffff) == 0) {
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
-                       dst_stride, src, dst, x, y, dy, 4, filtering);
+    s->method = kScaleARGBVertical;
+    ScaleARGBVerticalInit(s);
     return;
   }
-  if (filtering && dy < 65536) {
-    ScaleARGBBilinearUp(src_width, src_height, clip_width, clip_height,
-                        src_stride, dst_stride, src, dst, x, dx, y, dy,
-                        filtering);
+  if (s->filtering && s->dy < 65536) {
+    s->method = kScaleARGBBilinearUp;
+    ScaleARGBBilinearUpInit(s);
     return;
   }
-  if (filtering) {
-    ScaleARGBBilinearDown(src_width, src_height, clip_width, clip_height,
-                          src_stride, dst_stride, src, dst, x, dx, y, dy,
-                          filtering);
+  if (s->filtering) {
+    s->method = kScaleARGBBilinearDown;
+    ScaleARGBBilinearDownInit(s);
     return;
   }
-  ScaleARGBSimple(src_width, src_height, clip_width, clip_height, src_stride,
-                  dst_stride, src, dst, x, dx, y, dy);
+  s->method = kScaleARGBSimple;
+  ScaleARGBSimpleInit(s);
+}
+
+// Choose the scaler and build its polyphase tables, which it owns until
+// ScaleARGBScalerFree, so that every call of ScaleARGBScalerRows shares them.
+void ScaleARGBScalerInit(ScaleARGBScaler* s,
+                         int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         int clip_x,
+                         int clip_width,
+                         enum FilterMode filtering) {
+  ScaleARGBScalerChoose(s, src_width, src_height, dst_width, dst_height,
+                        clip_x, clip_width, filtering);
+  if (s->method == kScaleARGBPolyphase) {
+    ScalePolyphaseAllocTables(&s->polyphase);
+  }
+}
+
+void ScaleARGBScalerFree(ScaleARGBScaler* s) {
+  ScalePolyphaseFree(&s->polyphase);
+}
+
+void ScaleARGBScalerRows(const ScaleARGBScaler* s,
+                         const uint8_t* src,
+                         int src_stride,
+                         uint8_t* dst,
+                         int dst_stride,
+                         int clip_y,
+                         int clip_height,
+                         const LibyuvScratch* scratch) {
+  int y = s->y;
+  // Negative src_height means invert the image.
+  if (s->src_height < 0) {
+    src = src + (-s->src_height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+  if (s->method == kScaleARGBPolyphase) {
+    ScalePolyphaseRows(&s->polyphase, src, src_stride, 0, dst, dst_stride,
+                       s->clip_x, clip_y, s->clip_width, clip_height, scratch);
+    return;
+  }
+  src += s->src_offset;
+  if (clip_y) {
+    int64_t clipf = (int64_t)(clip_y)*s->dy;
+    y += (clipf & 0xffff);
+    src += (clipf >> 16) * src_stride;
+  }
+  switch (s->method) {
+    case kScaleARGBDown2:
+      ScaleARGBDown2(s, clip_height, src_stride, dst_stride, src, dst, y);
+      break;
+    case kScaleARGBDown4Box:
+      ScaleARGBDown4Box(s, clip_height, src_stride, dst_stride, src, dst, y,
+                        scratch);
+      break;
+    case kScaleARGBDownEven:
+      ScaleARGBDownEven(s, clip_height, src_stride, dst_stride, src, dst, y);
+      break;
+    case kScaleARGBCopy:
+      ARGBCopy(src + (y >> 16) * src_stride + (s->x >> 16) * 4, src_stride,
+               dst, dst_stride, s->clip_width, clip_height);
+      break;
+    case kScaleARGBVertical:
+      ScalePlaneVerticalRows(Abs(s->src_height), s->clip_width * 4,
+                             clip_height, src_stride, dst_stride,
+                             src + (s->x >> 16) * 4, 0, dst, y, s->dy,
+                             s->filtering, s->InterpolateRow);
+      break;
+    case kScaleARGBBilinearUp:
+      ScaleARGBBilinearUp(s, clip_height, src_stride, dst_stride, src, dst, y,
+                          scratch);
+      break;
+    case kScaleARGBBilinearDown:
+      ScaleARGBBilinearDown(s, clip_height, src_stride, dst_stride, src, dst,
+                            y, scratch);
+      break;
+    default:
+      ScaleARGBSimple(s, clip_height, src_stride, dst_stride, src, dst, y);
+      break;
+  }
+}
+
+// ScaleARGB a ARGB.
+// This function in turn calls a scaling function
+// suitable for handling the desired resolutions.
+static void ScaleARGB(const uint8_t* src,
+                      int src_stride,
+                      int src_width,
+                      int src_height,
+                      uint8_t* dst,
+                      int dst_stride,
+                      int dst_width,
+                      int dst_height,
+                      int clip_x,
+                      int clip_y,
+                      int clip_width,
+                      int clip_height,
+                      enum FilterMode filtering,
+                      const LibyuvScratch* scratch) {
+  // A single call builds the polyphase tables in scratch instead.
+  ScaleARGBScaler s;
+  ScaleARGBScalerChoose(&s, src_width, src_height, dst_width, dst_height,
+                        clip_x, clip_width, filtering);
+  ScaleARGBScalerRows(&s, src, src_stride,
+                      dst + clip_y * dst_stride + clip_x * 4, dst_stride,
+                      clip_y, clip_height, scratch);
 }
 
 LIBYUV_API
@@ -1016,6 +1194,27 @@ int ARGBScaleClip(const uint8_t* src_argb,
                   int clip_width,
                   int clip_height,
                   enum FilterMode filtering) {
+  return ARGBScaleClip_WithScratch(src_argb, src_stride_argb, src_width,
+                                   src_height, dst_argb, dst_stride_argb,
+                                   dst_width, dst_height, clip_x, clip_y,
+                                   clip_width, clip_height, filtering, NULL);
+}
+
+LIBYUV_API
+int ARGBScaleClip_WithScratch(const uint8_t* src_argb,
+                              int src_stride_argb,
+                              int src_width,
+                              int src_height,
+                              uint8_t* dst_argb,
+                              int dst_stride_argb,
+                              int dst_width,
+                              int dst_height,
+                              int clip_x,
+                              int clip_y,
+                              int clip_width,
+                              int clip_height,
+                              enum FilterMode filtering,
+                              const LibyuvScratch* scratch) {
   if (!src_argb || src_width == 0 || src_height == 0 || !dst_argb ||
       dst_width <= 0 || dst_height <= 0 || clip_x < 0 || clip_y < 0 ||
       clip_width > 32768 || clip_height > 32768 ||
@@ -1025,7 +1224,7 @@ int ARGBScaleClip(const uint8_t* src_argb,
   }
   ScaleARGB(src_argb, src_stride_argb, src_width, src_height, dst_argb,
             dst_stride_argb, dst_width, dst_height, clip_x, clip_y, clip_width,
-            clip_height, filtering);
+            clip_height, filtering, scratch);
   return 0;
 }
 
@@ -1040,13 +1239,150 @@ int ARGBScale(const uint8_t* src_argb,
               int dst_width,
               int dst_height,
               enum FilterMode filtering) {
+  return ARGBScale_WithScratch(src_argb, src_stride_argb, src_width,
+                               src_height, dst_argb, dst_stride_argb,
+                               dst_width, dst_height, filtering, NULL);
+}
+
+LIBYUV_API
+int ARGBScale_WithScratch(const uint8_t* src_argb,
+                          int src_stride_argb,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          const LibyuvScratch* scratch) {
+  uint64_t profile_start = ProfileStart();
   if (!src_argb || src_width == 0 || src_height == 0 || src_width > 32768 ||
       src_height > 32768 || !dst_argb || dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
   ScaleARGB(src_argb, src_stride_argb, src_width, src_height, dst_argb,
             dst_stride_argb, dst_width, dst_height, 0, 0, dst_width, dst_height,
-            filtering);
+            filtering, scratch);
+  ProfileStop(kProfileARGBScale, profile_start,
+              (uint64_t)dst_width * dst_height, kProfileKernelMixed);
+  return 0;
+}
+
+// Largest row buffer allocated by the ARGB scalers.  The bilinear down
+// scaler buffers one row of its clipped source width, 4 bytes per pixel.
+// The polyphase scaler also needs its tables and rows.
+LIBYUV_API
+int ARGBScaleScratchSize(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering) {
+  int down_size = Abs(src_width) * 4;
+  int up_size = ((dst_width * 2 * 4 + 31) & ~31) * 2;
+  if (filtering == kFilterNone) {
+    return 0;
+  }
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    return ScalePolyphaseScratchSize(src_width, src_height, dst_width,
+                                     dst_height, 4, filtering);
+  }
+  return (down_size > up_size ? down_size : up_size) + 63;
+}
+
+// State shared by the jobs of ARGBScaleBatch.
+typedef struct ARGBScaleBatchJob {
+  const LibyuvConstFrame* src_frames;
+  const LibyuvFrame* dst_frames;
+  int num_frames;
+  int num_jobs;
+  enum FilterMode filtering;
+  uint8_t* scratch;  // scratch_size bytes for each job, or NULL.
+  int scratch_size;
+} ARGBScaleBatchJob;
+
+// Scale the index'th run of frames with the index'th part of the scratch.
+// The scaler is chosen once for each run of frames of the same geometry.
+static void ARGBScaleBatchFrames(void* job_opaque, int index) {
+  const ARGBScaleBatchJob* job = (const ARGBScaleBatchJob*)job_opaque;
+  int begin = (int)((int64_t)job->num_frames * index / job->num_jobs);
+  int end = (int)((int64_t)job->num_frames * (index + 1) / job->num_jobs);
+  LibyuvScratch scratch;
+  ScaleARGBScaler s;
+  int i;
+  // If the scratch is NULL the scalers allocate for themselves.
+  scratch.buffer =
+      job->scratch ? job->scratch + (size_t)job->scratch_size * index : NULL;
+  scratch.size = job->scratch ? (size_t)job->scratch_size : 0;
+  for (i = begin; i < end; ++i) {
+    const LibyuvConstFrame* src = &job->src_frames[i];
+    const LibyuvFrame* dst = &job->dst_frames[i];
+    if (i == begin || src->width != s.src_width ||
+        src->height != s.src_height || dst->width != s.dst_width ||
+        dst->height != s.dst_height) {
+      if (i != begin) {
+        ScaleARGBScalerFree(&s);
+      }
+      ScaleARGBScalerInit(&s, src->width, src->height, dst->width,
+                          dst->height, 0, dst->width, job->filtering);
+    }
+    ScaleARGBScalerRows(&s, src->data[0], src->stride[0], dst->data[0],
+                        dst->stride[0], 0, dst->height, &scratch);
+  }
+  if (end > begin) {
+    ScaleARGBScalerFree(&s);
+  }
+}
+
+LIBYUV_API
+int ARGBScaleBatch(const LibyuvConstFrame* src_frames,
+                   const LibyuvFrame* dst_frames,
+                   int num_frames,
+                   enum FilterMode filtering,
+                   int num_jobs,
+                   LibyuvDispatchFunc dispatch,
+                   void* dispatch_opaque) {
+  ARGBScaleBatchJob job;
+  int scratch_size = 0;
+  int i;
+  if (!src_frames || !dst_frames || num_frames <= 0) {
+    return -1;
+  }
+  for (i = 0; i < num_frames; ++i) {
+    const LibyuvConstFrame* src = &src_frames[i];
+    const LibyuvFrame* dst = &dst_frames[i];
+    int size;
+    if (!src->data[0] || src->width == 0 || src->height == 0 ||
+        src->width > 32768 || src->height > 32768 || !dst->data[0] ||
+        dst->width <= 0 || dst->height <= 0) {
+      return -1;
+    }
+    size = ARGBScaleScratchSize(src->width, src->height, dst->width,
+                                dst->height, filtering);
+    if (size > scratch_size) {
+      scratch_size = size;
+    }
+  }
+  if (num_jobs > num_frames) {
+    num_jobs = num_frames;
+  }
+  if (!dispatch || num_jobs <= 1) {
+    num_jobs = 1;
+  }
+  job.src_frames = src_frames;
+  job.dst_frames = dst_frames;
+  job.num_frames = num_frames;
+  job.num_jobs = num_jobs;
+  job.filtering = filtering;
+  job.scratch_size = scratch_size;
+  // One allocation for the whole batch instead of one per job.
+  job.scratch =
+      scratch_size ? (uint8_t*)malloc((size_t)scratch_size * num_jobs) : NULL;
+  if (num_jobs == 1) {
+    ARGBScaleBatchFrames(&job, 0);
+  } else {
+    dispatch(dispatch_opaque, ARGBScaleBatchFrames, &job, num_jobs);
+  }
+  free(job.scratch);
   return 0;
 }
 
@@ -1071,20 +1407,1020 @@ int YUVToARGBScaleClip(const uint8_t* src_y,
                        int clip_width,
                        int clip_height,
                        enum FilterMode filtering) {
-  uint8_t* argb_buffer = (uint8_t*)malloc(src_width * src_height * 4);
+  return YUVToARGBScaleClip_WithScratch(
+      src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
+      src_fourcc, src_width, src_height, dst_argb, dst_stride_argb, dst_fourcc,
+      dst_width, dst_height, clip_x, clip_y, clip_width, clip_height,
+      filtering, NULL);
+}
+
+LIBYUV_API
+int YUVToARGBScaleClip_WithScratch(const uint8_t* src_y,
+                                   int src_stride_y,
+                                   const uint8_t* src_u,
+                                   int src_stride_u,
+                                   const uint8_t* src_v,
+                                   int src_stride_v,
+                                   uint32_t src_fourcc,
+                                   int src_width,
+                                   int src_height,
+                                   uint8_t* dst_argb,
+                                   int dst_stride_argb,
+                                   uint32_t dst_fourcc,
+                                   int dst_width,
+                                   int dst_height,
+                                   int clip_x,
+                                   int clip_y,
+                                   int clip_width,
+                                   int clip_height,
+                                   enum FilterMode filtering,
+                                   const LibyuvScratch* scratch) {
+  const size_t argb_size = (size_t)src_width * src_height * 4;
+  LibyuvScratch scale_scratch = {NULL, 0};
   int r;
+  // The ARGB frame comes first in the scratch and the scaler gets the rest.
+  align_buffer_64_scratch(argb_buffer, argb_size, scratch);
   (void)src_fourcc;  // TODO(fbarchard): implement and/or assert.
   (void)dst_fourcc;
+  if (!argb_buffer) {
+    return 1;
+  }
+  if (SCRATCH_FITS(scratch, argb_size)) {
+    scale_scratch.buffer = scratch->buffer + argb_size + 63;
+    scale_scratch.size = scratch->size - argb_size - 63;
+  } else if (scratch) {
+    scale_scratch = *scratch;
+  }
   I420ToARGB(src_y, src_stride_y, src_u, src_stride_u, src_v, src_stride_v,
              argb_buffer, src_width * 4, src_width, src_height);
 
-  r = ARGBScaleClip(argb_buffer, src_width * 4, src_width, src_height, dst_argb,
-                    dst_stride_argb, dst_width, dst_height, clip_x, clip_y,
-                    clip_width, clip_height, filtering);
-  free(argb_buffer);
+  r = ARGBScaleClip_WithScratch(argb_buffer, src_width * 4, src_width,
+                                src_height, dst_argb, dst_stride_argb,
+                                dst_width, dst_height, clip_x, clip_y,
+                                clip_width, clip_height, filtering,
+                                &scale_scratch);
+  free_aligned_buffer_64(argb_buffer);
   return r;
 }
 
+// The ARGB frame of the whole source, then the scaler's row buffers.
+LIBYUV_API
+int YUVToARGBScaleClipScratchSize(int src_width,
+                                  int src_height,
+                                  int dst_width,
+                                  int dst_height,
+                                  enum FilterMode filtering) {
+  return src_width * src_height * 4 + 63 +
+         ARGBScaleScratchSize(src_width, src_height, dst_width, dst_height,
+                              filtering);
+}
+
+// Number of destination rows that the fused YUV scale and convert functions
+// scale at a time.
+#define kYUVScaleStripRows 16
+
+// Rows in a strip of a scaled plane, rounded up to its clip alignment.
+static int YUVScaleStripRows(int align) {
+  return (kYUVScaleStripRows + align - 1) / align * align;
+}
+
+// End of the strip of scaled rows that starts at row begin.  The first strip
+// is extended by the clip offset so later strips start on aligned rows.
+static int YUVScaleStripEnd(int begin, int strip_rows, int offset, int height) {
+  int end = begin + strip_rows + (begin ? 0 : offset);
+  return end < height ? end : height;
+}
+
+// Scale I420 one strip of rows at a time and convert each row with
+// I422ToRGBRow.  The scalers for Y and for both U and V are chosen once.
+static int I420ScaleToRGB(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_rgb,
+                          int dst_stride_rgb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          void (*I422ToRGBRow)(const uint8_t* y_buf,
+                                               const uint8_t* u_buf,
+                                               const uint8_t* v_buf,
+                                               uint8_t* rgb_buf,
+                                               const struct YuvConstants*
+                                                   yuvconstants,
+                                               int width)) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int y_align, y_offset, uv_align, uv_offset;
+  int y_strip, uv_strip;
+  int y_begin = 0;
+  int y_end = 0;
+  int uv_begin = 0;
+  int uv_end = 0;
+  int y;
+  const int kRowStrideY = (dst_width + 63) & ~63;
+  const int kRowStrideUV = (dst_halfwidth + 63) & ~63;
+  ScalePlaneScaler scaler_y;
+  ScalePlaneScaler scaler_uv;
+  LibyuvScratch scratch;
+  if (!src_y || !src_u || !src_v || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_rgb || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+  scratch.size = (size_t)ScalePlaneScratchSize(src_width, src_height,
+                                               dst_width, dst_height, filtering);
+  ScalePlaneScalerInit(&scaler_y, src_width, src_height, dst_width, dst_height,
+                       filtering);
+  ScalePlaneScalerInit(&scaler_uv, src_halfwidth, src_halfheight,
+                       dst_halfwidth, dst_halfheight, filtering);
+  ScalePlaneScalerAlign(&scaler_y, &y_align, &y_offset);
+  ScalePlaneScalerAlign(&scaler_uv, &uv_align, &uv_offset);
+  y_strip = YUVScaleStripRows(y_align);
+  uv_strip = YUVScaleStripRows(uv_align);
+
+  {
+    // Strips of Y, U and V rows followed by the scalers' row buffers.
+    const int kStripSizeY = kRowStrideY * (y_strip + y_offset);
+    const int kStripSizeUV = kRowStrideUV * (uv_strip + uv_offset);
+    align_buffer_64(rows, kStripSizeY + kStripSizeUV * 2 + (int)scratch.size);
+    uint8_t* row_y = rows;
+    uint8_t* row_u = rows + kStripSizeY;
+    uint8_t* row_v = row_u + kStripSizeUV;
+    if (!rows) {
+      ScalePlaneScalerFree(&scaler_y);
+      ScalePlaneScalerFree(&scaler_uv);
+      return 1;
+    }
+    scratch.buffer = row_v + kStripSizeUV;
+
+    for (y = 0; y < dst_height; ++y) {
+      if (y == y_end) {
+        y_begin = y_end;
+        y_end = YUVScaleStripEnd(y_begin, y_strip, y_offset, dst_height);
+        ScalePlaneScalerRows(&scaler_y, src_y, src_stride_y, 0, row_y,
+                             kRowStrideY, y_begin, y_end - y_begin, &scratch);
+      }
+      if ((y >> 1) == uv_end) {
+        uv_begin = uv_end;
+        uv_end = YUVScaleStripEnd(uv_begin, uv_strip, uv_offset,
+                                  dst_halfheight);
+        ScalePlaneScalerRows(&scaler_uv, src_u, src_stride_u, 0, row_u,
+                             kRowStrideUV, uv_begin, uv_end - uv_begin,
+                             &scratch);
+        ScalePlaneScalerRows(&scaler_uv, src_v, src_stride_v, 0, row_v,
+                             kRowStrideUV, uv_begin, uv_end - uv_begin,
+                             &scratch);
+      }
+      I422ToRGBRow(row_y + (y - y_begin) * kRowStrideY,
+                   row_u + ((y >> 1) - uv_begin) * kRowStrideUV,
+                   row_v + ((y >> 1) - uv_begin) * kRowStrideUV, dst_rgb,
+                   yuvconstants, dst_width);
+      dst_rgb += dst_stride_rgb;
+    }
+    free_aligned_buffer_64(rows);
+  }
+  ScalePlaneScalerFree(&scaler_y);
+  ScalePlaneScalerFree(&scaler_uv);
+  return 0;
+}
+
+// Scale NV12 one strip of rows at a time and convert each row with
+// NVToRGBRow, or split the UV row and convert it with I422ToRGBRow when
+// NVToRGBRow is NULL.  The scalers for Y and UV are chosen once.
+static int NV12ScaleToRGB(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_rgb,
+                          int dst_stride_rgb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          void (*NVToRGBRow)(const uint8_t* y_buf,
+                                             const uint8_t* uv_buf,
+                                             uint8_t* rgb_buf,
+                                             const struct YuvConstants*
+                                                 yuvconstants,
+                                             int width),
+                          void (*I422ToRGBRow)(const uint8_t* y_buf,
+                                               const uint8_t* u_buf,
+                                               const uint8_t* v_buf,
+                                               uint8_t* rgb_buf,
+                                               const struct YuvConstants*
+                                                   yuvconstants,
+                                               int width)) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int y_align, y_offset, uv_align, uv_offset;
+  int y_strip, uv_strip;
+  int y_begin = 0;
+  int y_end = 0;
+  int uv_begin = 0;
+  int uv_end = 0;
+  int y;
+  const int kRowStrideY = (dst_width + 63) & ~63;
+  const int kRowStrideUV = (dst_halfwidth * 2 + 63) & ~63;
+  int uv_scratch_size;
+  ScalePlaneScaler scaler_y;
+  ScaleUVScaler scaler_uv;
+  LibyuvScratch scratch;
+  void (*SplitUVRow)(const uint8_t* src_uv, uint8_t* dst_u, uint8_t* dst_v,
+                     int width) = SplitUVRow_C;
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_rgb || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+#if defined(HAS_SPLITUVROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    SplitUVRow = SplitUVRow_Any_SSE2;
+    if (IS_ALIGNED(dst_halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    SplitUVRow = SplitUVRow_Any_AVX2;
+    if (IS_ALIGNED(dst_halfwidth, 32)) {
+      SplitUVRow = SplitUVRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SPLITUVROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    SplitUVRow = SplitUVRow_Any_NEON;
+    if (IS_ALIGNED(dst_halfwidth, 16)) {
+      SplitUVRow = SplitUVRow_NEON;
+    }
+  }
+#endif
+  scratch.size = (size_t)ScalePlaneScratchSize(src_width, src_height,
+                                               dst_width, dst_height, filtering);
+  uv_scratch_size = UVScaleScratchSize(src_halfwidth, src_halfheight,
+                                       dst_halfwidth, dst_halfheight, filtering);
+  if ((size_t)uv_scratch_size > scratch.size) {
+    scratch.size = (size_t)uv_scratch_size;
+  }
+  ScalePlaneScalerInit(&scaler_y, src_width, src_height, dst_width, dst_height,
+                       filtering);
+  ScaleUVScalerInit(&scaler_uv, src_halfwidth, src_halfheight, dst_halfwidth,
+                    dst_halfheight, 0, dst_halfwidth, filtering);
+  ScalePlaneScalerAlign(&scaler_y, &y_align, &y_offset);
+  uv_align = scaler_uv.bilinear_up2 ? 2 : 1;
+  uv_offset = scaler_uv.bilinear_up2 ? 1 : 0;
+  y_strip = YUVScaleStripRows(y_align);
+  uv_strip = YUVScaleStripRows(uv_align);
+
+  {
+    // Strips of Y and UV rows, U and V rows split from a UV row, then the
+    // scalers' row buffers.
+    const int kStripSizeY = kRowStrideY * (y_strip + y_offset);
+    const int kStripSizeUV = kRowStrideUV * (uv_strip + uv_offset);
+    align_buffer_64(rows, kStripSizeY + kStripSizeUV + kRowStrideUV +
+                              (int)scratch.size);
+    uint8_t* row_y = rows;
+    uint8_t* row_uv = rows + kStripSizeY;
+    uint8_t* row_u = row_uv + kStripSizeUV;
+    uint8_t* row_v = row_u + kRowStrideUV / 2;
+    if (!rows) {
+      ScalePlaneScalerFree(&scaler_y);
+      ScaleUVScalerFree(&scaler_uv);
+      return 1;
+    }
+    scratch.buffer = row_u + kRowStrideUV;
+
+    for (y = 0; y < dst_height; ++y) {
+      const uint8_t* uv;
+      if (y == y_end) {
+        y_begin = y_end;
+        y_end = YUVScaleStripEnd(y_begin, y_strip, y_offset, dst_height);
+        ScalePlaneScalerRows(&scaler_y, src_y, src_stride_y, 0, row_y,
+                             kRowStrideY, y_begin, y_end - y_begin, &scratch);
+      }
+      if ((y >> 1) == uv_end) {
+        uv_begin = uv_end;
+        uv_end = YUVScaleStripEnd(uv_begin, uv_strip, uv_offset,
+                                  dst_halfheight);
+        ScaleUVScalerRows(&scaler_uv, src_uv, src_stride_uv, 0, row_uv,
+                          kRowStrideUV, uv_begin, uv_end - uv_begin, &scratch);
+      }
+      uv = row_uv + ((y >> 1) - uv_begin) * kRowStrideUV;
+      if (NVToRGBRow) {
+        NVToRGBRow(row_y + (y - y_begin) * kRowStrideY, uv, dst_rgb,
+                   yuvconstants, dst_width);
+      } else {
+        SplitUVRow(uv, row_u, row_v, dst_halfwidth);
+        I422ToRGBRow(row_y + (y - y_begin) * kRowStrideY, row_u, row_v,
+                     dst_rgb, yuvconstants, dst_width);
+      }
+      dst_rgb += dst_stride_rgb;
+    }
+    free_aligned_buffer_64(rows);
+  }
+  ScalePlaneScalerFree(&scaler_y);
+  ScaleUVScalerFree(&scaler_uv);
+  return 0;
+}
+
+// Scale P010 one strip of rows at a time with the 16 bit scalers and convert
+// each row with P210ToRGBRow.  When shuffler is not NULL, the ARGB rows are
+// shuffled into dst_rgb.
+static int P010ScaleToRGB(const uint16_t* src_y,
+                          int src_stride_y,
+                          const uint16_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_rgb,
+                          int dst_stride_rgb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering,
+                          void (*P210ToRGBRow)(const uint16_t* y_buf,
+                                               const uint16_t* uv_buf,
+                                               uint8_t* rgb_buf,
+                                               const struct YuvConstants*
+                                                   yuvconstants,
+                                               int width),
+                          const uint8_t* shuffler) {
+  int src_halfwidth = SUBSAMPLE(src_width, 1, 1);
+  int src_halfheight = SUBSAMPLE(src_height, 1, 1);
+  int dst_halfwidth = SUBSAMPLE(dst_width, 1, 1);
+  int dst_halfheight = SUBSAMPLE(dst_height, 1, 1);
+  int y_align, y_offset, uv_align, uv_offset;
+  int y_strip, uv_strip;
+  int y_begin = 0;
+  int y_end = 0;
+  int uv_begin = 0;
+  int uv_end = 0;
+  int y;
+  // Row strides in uint16_t.
+  const int kRowStrideY = (dst_width + 31) & ~31;
+  const int kRowStrideUV = (dst_halfwidth * 2 + 31) & ~31;
+  const int kRowSizeARGB = (dst_width * 4 + 63) & ~63;
+  int uv_scratch_size;
+  LibyuvScratch scratch;
+  void (*ARGBShuffleRow)(const uint8_t* src_bgra, uint8_t* dst_argb,
+                         const uint8_t* shuffler, int width) = ARGBShuffleRow_C;
+  if (!src_y || !src_uv || src_width <= 0 || src_height == 0 ||
+      src_width > 32768 || src_height > 32768 || !dst_rgb || dst_width <= 0 ||
+      dst_height <= 0) {
+    return -1;
+  }
+#if defined(HAS_ARGBSHUFFLEROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    ARGBShuffleRow = ARGBShuffleRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ARGBShuffleRow = ARGBShuffleRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_ARGBSHUFFLEROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ARGBShuffleRow = ARGBShuffleRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      ARGBShuffleRow = ARGBShuffleRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_ARGBSHUFFLEROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ARGBShuffleRow = ARGBShuffleRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 4)) {
+      ARGBShuffleRow = ARGBShuffleRow_NEON;
+    }
+  }
+#endif
+  scratch.size = (size_t)ScalePlaneScratchSize_16(
+      src_width, src_height, dst_width, dst_height, filtering);
+  uv_scratch_size = UVScaleScratchSize_16(src_halfwidth, src_halfheight,
+                                          dst_halfwidth, dst_halfheight,
+                                          filtering);
+  if ((size_t)uv_scratch_size > scratch.size) {
+    scratch.size = (size_t)uv_scratch_size;
+  }
+  ScalePlaneClipAlign_16(src_width, src_height, dst_width, dst_height,
+                         filtering, &y_align, &y_offset);
+  UVScaleClipAlign_16(src_halfwidth, src_halfheight, dst_halfwidth,
+                      dst_halfheight, filtering, &uv_align, &uv_offset);
+  y_strip = YUVScaleStripRows(y_align);
+  uv_strip = YUVScaleStripRows(uv_align);
+
+  {
+    // Strips of Y and UV rows, an ARGB row to shuffle, then the scalers'
+    // row buffers.
+    const int kStripSizeY = kRowStrideY * (y_strip + y_offset);
+    const int kStripSizeUV = kRowStrideUV * (uv_strip + uv_offset);
+    align_buffer_64(rows, (kStripSizeY + kStripSizeUV) * 2 + kRowSizeARGB +
+                              (int)scratch.size);
+    uint16_t* row_y = (uint16_t*)rows;
+    uint16_t* row_uv = row_y + kStripSizeY;
+    uint8_t* row_argb = (uint8_t*)(row_uv + kStripSizeUV);
+    if (!rows) {
+      return 1;
+    }
+    scratch.buffer = row_argb + kRowSizeARGB;
+
+    for (y = 0; y < dst_height; ++y) {
+      if (y == y_end) {
+        y_begin = y_end;
+        y_end = YUVScaleStripEnd(y_begin, y_strip, y_offset, dst_height);
+        ScalePlaneClip_16(src_y, src_stride_y, src_width, src_height, row_y,
+                          kRowStrideY, dst_width, dst_height, y_begin,
+                          y_end - y_begin, filtering, &scratch);
+      }
+      if ((y >> 1) == uv_end) {
+        uv_begin = uv_end;
+        uv_end = YUVScaleStripEnd(uv_begin, uv_strip, uv_offset,
+                                  dst_halfheight);
+        UVScaleClip_16(src_uv, src_stride_uv, src_halfwidth, src_halfheight,
+                       row_uv, kRowStrideUV, dst_halfwidth, dst_halfheight,
+                       uv_begin, uv_end - uv_begin, filtering, &scratch);
+      }
+      if (shuffler) {
+        P210ToRGBRow(row_y + (y - y_begin) * kRowStrideY,
+                     row_uv + ((y >> 1) - uv_begin) * kRowStrideUV, row_argb,
+                     yuvconstants, dst_width);
+        ARGBShuffleRow(row_argb, dst_rgb, shuffler, dst_width);
+      } else {
+        P210ToRGBRow(row_y + (y - y_begin) * kRowStrideY,
+                     row_uv + ((y >> 1) - uv_begin) * kRowStrideUV, dst_rgb,
+                     yuvconstants, dst_width);
+      }
+      dst_rgb += dst_stride_rgb;
+    }
+    free_aligned_buffer_64(rows);
+  }
+  return 0;
+}
+
+// Scale I420 and convert to ARGB with matrix.
+LIBYUV_API
+int I420ScaleToARGBMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  void (*I422ToARGBRow)(const uint8_t* y_buf, const uint8_t* u_buf,
+                        const uint8_t* v_buf, uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants, int width) =
+      I422ToARGBRow_C;
+#if defined(HAS_I422TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    I422ToARGBRow = I422ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      I422ToARGBRow = I422ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      I422ToARGBRow = I422ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    I422ToARGBRow = I422ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 32)) {
+      I422ToARGBRow = I422ToARGBRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    I422ToARGBRow = I422ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      I422ToARGBRow = I422ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    I422ToARGBRow = I422ToARGBRow_Any_MMI;
+    if (IS_ALIGNED(dst_width, 4)) {
+      I422ToARGBRow = I422ToARGBRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_I422TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    I422ToARGBRow = I422ToARGBRow_Any_MSA;
+    if (IS_ALIGNED(dst_width, 8)) {
+      I422ToARGBRow = I422ToARGBRow_MSA;
+    }
+  }
+#endif
+  return I420ScaleToRGB(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                        src_stride_v, src_width, src_height, dst_argb,
+                        dst_stride_argb, yuvconstants, dst_width, dst_height,
+                        filtering, I422ToARGBRow);
+}
+
+// Scale I420 and convert to ARGB.
+LIBYUV_API
+int I420ScaleToARGB(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return I420ScaleToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, src_width, src_height, dst_argb,
+                               dst_stride_argb, &kYuvI601Constants, dst_width,
+                               dst_height, filtering);
+}
+
+// Scale I420 and convert to ABGR.
+LIBYUV_API
+int I420ScaleToABGR(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return I420ScaleToARGBMatrix(src_y, src_stride_y, src_v,
+                               src_stride_v,  // Swap U and V
+                               src_u, src_stride_u, src_width, src_height,
+                               dst_abgr, dst_stride_abgr,
+                               &kYvuI601Constants,  // Use Yvu matrix
+                               dst_width, dst_height, filtering);
+}
+
+// Scale I420 and convert to AR30 with matrix.
+LIBYUV_API
+int I420ScaleToAR30Matrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_u,
+                          int src_stride_u,
+                          const uint8_t* src_v,
+                          int src_stride_v,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  void (*I422ToAR30Row)(const uint8_t* y_buf, const uint8_t* u_buf,
+                        const uint8_t* v_buf, uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants, int width) =
+      I422ToAR30Row_C;
+#if defined(HAS_I422TOAR30ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    I422ToAR30Row = I422ToAR30Row_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      I422ToAR30Row = I422ToAR30Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_I422TOAR30ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I422ToAR30Row = I422ToAR30Row_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      I422ToAR30Row = I422ToAR30Row_AVX2;
+    }
+  }
+#endif
+  return I420ScaleToRGB(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                        src_stride_v, src_width, src_height, dst_ar30,
+                        dst_stride_ar30, yuvconstants, dst_width, dst_height,
+                        filtering, I422ToAR30Row);
+}
+
+// Scale I420 and convert to AR30.
+LIBYUV_API
+int I420ScaleToAR30(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return I420ScaleToAR30Matrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                               src_stride_v, src_width, src_height, dst_ar30,
+                               dst_stride_ar30, &kYuvI601Constants, dst_width,
+                               dst_height, filtering);
+}
+
+// Scale NV12 and convert to ARGB with matrix.
+LIBYUV_API
+int NV12ScaleToARGBMatrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  void (*NV12ToARGBRow)(
+      const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants, int width) = NV12ToARGBRow_C;
+#if defined(HAS_NV12TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_AVX512BW)
+  if (TestCpuFlag(kCpuHasAVX512BW)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_AVX512BW;
+    if (IS_ALIGNED(dst_width, 32)) {
+      NV12ToARGBRow = NV12ToARGBRow_AVX512BW;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_MMI;
+    if (IS_ALIGNED(dst_width, 4)) {
+      NV12ToARGBRow = NV12ToARGBRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_NV12TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    NV12ToARGBRow = NV12ToARGBRow_Any_MSA;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV12ToARGBRow = NV12ToARGBRow_MSA;
+    }
+  }
+#endif
+  return NV12ScaleToRGB(src_y, src_stride_y, src_uv, src_stride_uv, src_width,
+                        src_height, dst_argb, dst_stride_argb, yuvconstants,
+                        dst_width, dst_height, filtering, NV12ToARGBRow, NULL);
+}
+
+// Scale NV12 and convert to ARGB.
+LIBYUV_API
+int NV12ScaleToARGB(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return NV12ScaleToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_argb,
+                               dst_stride_argb, &kYuvI601Constants, dst_width,
+                               dst_height, filtering);
+}
+
+// Scale NV12 and convert to ABGR.
+LIBYUV_API
+int NV12ScaleToABGR(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  void (*NV21ToARGBRow)(
+      const uint8_t* y_buf, const uint8_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants, int width) = NV21ToARGBRow_C;
+#if defined(HAS_NV21TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    NV21ToARGBRow = NV21ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV21ToARGBRow = NV21ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    NV21ToARGBRow = NV21ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      NV21ToARGBRow = NV21ToARGBRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    NV21ToARGBRow = NV21ToARGBRow_Any_NEON;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV21ToARGBRow = NV21ToARGBRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    NV21ToARGBRow = NV21ToARGBRow_Any_MMI;
+    if (IS_ALIGNED(dst_width, 4)) {
+      NV21ToARGBRow = NV21ToARGBRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_NV21TOARGBROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    NV21ToARGBRow = NV21ToARGBRow_Any_MSA;
+    if (IS_ALIGNED(dst_width, 8)) {
+      NV21ToARGBRow = NV21ToARGBRow_MSA;
+    }
+  }
+#endif
+  // NV12 read as NV21 with the Yvu matrix produces ABGR.
+  return NV12ScaleToRGB(src_y, src_stride_y, src_uv, src_stride_uv, src_width,
+                        src_height, dst_abgr, dst_stride_abgr,
+                        &kYvuI601Constants, dst_width, dst_height, filtering,
+                        NV21ToARGBRow, NULL);
+}
+
+// Scale NV12 and convert to AR30 with matrix.
+LIBYUV_API
+int NV12ScaleToAR30Matrix(const uint8_t* src_y,
+                          int src_stride_y,
+                          const uint8_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  void (*I422ToAR30Row)(const uint8_t* y_buf, const uint8_t* u_buf,
+                        const uint8_t* v_buf, uint8_t* rgb_buf,
+                        const struct YuvConstants* yuvconstants, int width) =
+      I422ToAR30Row_C;
+#if defined(HAS_I422TOAR30ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    I422ToAR30Row = I422ToAR30Row_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      I422ToAR30Row = I422ToAR30Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_I422TOAR30ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    I422ToAR30Row = I422ToAR30Row_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      I422ToAR30Row = I422ToAR30Row_AVX2;
+    }
+  }
+#endif
+  // There is no NV12 to AR30 row function, so UV rows are split for
+  // I422ToAR30Row.
+  return NV12ScaleToRGB(src_y, src_stride_y, src_uv, src_stride_uv, src_width,
+                        src_height, dst_ar30, dst_stride_ar30, yuvconstants,
+                        dst_width, dst_height, filtering, NULL, I422ToAR30Row);
+}
+
+// Scale NV12 and convert to AR30.
+LIBYUV_API
+int NV12ScaleToAR30(const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return NV12ScaleToAR30Matrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_ar30,
+                               dst_stride_ar30, &kYuvI601Constants, dst_width,
+                               dst_height, filtering);
+}
+
+// Shuffle table for converting ARGB to ABGR.
+static const uvec8 kShuffleMaskARGBToABGR = {
+    2u, 1u, 0u, 3u, 6u, 5u, 4u, 7u, 10u, 9u, 8u, 11u, 14u, 13u, 12u, 15u};
+
+// Scale P010 and convert to ARGB, or ABGR if abgr is set, with matrix.
+static int P010ScaleToARGBOrABGR(const uint16_t* src_y,
+                                 int src_stride_y,
+                                 const uint16_t* src_uv,
+                                 int src_stride_uv,
+                                 int src_width,
+                                 int src_height,
+                                 uint8_t* dst_argb,
+                                 int dst_stride_argb,
+                                 const struct YuvConstants* yuvconstants,
+                                 int dst_width,
+                                 int dst_height,
+                                 enum FilterMode filtering,
+                                 int abgr) {
+  void (*P210ToARGBRow)(
+      const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants, int width) = P210ToARGBRow_C;
+#if defined(HAS_P210TOARGBROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    P210ToARGBRow = P210ToARGBRow_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      P210ToARGBRow = P210ToARGBRow_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_P210TOARGBROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToARGBRow = P210ToARGBRow_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      P210ToARGBRow = P210ToARGBRow_AVX2;
+    }
+  }
+#endif
+  return P010ScaleToRGB(
+      src_y, src_stride_y, src_uv, src_stride_uv, src_width, src_height,
+      dst_argb, dst_stride_argb, yuvconstants, dst_width, dst_height,
+      filtering, P210ToARGBRow,
+      abgr ? (const uint8_t*)&kShuffleMaskARGBToABGR : NULL);
+}
+
+// Scale P010 and convert to ARGB with matrix.
+LIBYUV_API
+int P010ScaleToARGBMatrix(const uint16_t* src_y,
+                          int src_stride_y,
+                          const uint16_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_argb,
+                          int dst_stride_argb,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  return P010ScaleToARGBOrABGR(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_argb,
+                               dst_stride_argb, yuvconstants, dst_width,
+                               dst_height, filtering, 0);
+}
+
+// Scale P010 and convert to ARGB.
+LIBYUV_API
+int P010ScaleToARGB(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return P010ScaleToARGBOrABGR(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_argb,
+                               dst_stride_argb, &kYuv2020Constants, dst_width,
+                               dst_height, filtering, 0);
+}
+
+// Scale P010 and convert to ABGR.
+LIBYUV_API
+int P010ScaleToABGR(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_abgr,
+                    int dst_stride_abgr,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return P010ScaleToARGBOrABGR(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_abgr,
+                               dst_stride_abgr, &kYuv2020Constants, dst_width,
+                               dst_height, filtering, 1);
+}
+
+// Scale P010 and convert to AR30 with matrix.
+LIBYUV_API
+int P010ScaleToAR30Matrix(const uint16_t* src_y,
+                          int src_stride_y,
+                          const uint16_t* src_uv,
+                          int src_stride_uv,
+                          int src_width,
+                          int src_height,
+                          uint8_t* dst_ar30,
+                          int dst_stride_ar30,
+                          const struct YuvConstants* yuvconstants,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  void (*P210ToAR30Row)(
+      const uint16_t* y_buf, const uint16_t* uv_buf, uint8_t* rgb_buf,
+      const struct YuvConstants* yuvconstants, int width) = P210ToAR30Row_C;
+#if defined(HAS_P210TOAR30ROW_SSSE3)
+  if (TestCpuFlag(kCpuHasSSSE3)) {
+    P210ToAR30Row = P210ToAR30Row_Any_SSSE3;
+    if (IS_ALIGNED(dst_width, 8)) {
+      P210ToAR30Row = P210ToAR30Row_SSSE3;
+    }
+  }
+#endif
+#if defined(HAS_P210TOAR30ROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    P210ToAR30Row = P210ToAR30Row_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 16)) {
+      P210ToAR30Row = P210ToAR30Row_AVX2;
+    }
+  }
+#endif
+  return P010ScaleToRGB(src_y, src_stride_y, src_uv, src_stride_uv, src_width,
+                        src_height, dst_ar30, dst_stride_ar30, yuvconstants,
+                        dst_width, dst_height, filtering, P210ToAR30Row, NULL);
+}
+
+// Scale P010 and convert to AR30.
+LIBYUV_API
+int P010ScaleToAR30(const uint16_t* src_y,
+                    int src_stride_y,
+                    const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst_ar30,
+                    int dst_stride_ar30,
+                    int dst_width,
+                    int dst_height,
+                    enum FilterMode filtering) {
+  return P010ScaleToAR30Matrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                               src_width, src_height, dst_ar30,
+                               dst_stride_ar30, &kYuv2020Constants, dst_width,
+                               dst_height, filtering);
+}
+
 #ifdef __cplusplus
 }  // extern "C"
 }  // namespace libyuv
@@ -11,6 +11,8 @@
 #include "libyuv/scale.h"
 
 #include <assert.h>
+#include <math.h>
+#include <stdlib.h>  // For malloc.
 #include <string.h>
 
 #include "libyuv/cpu_id.h"
@@ -689,6 +691,40 @@ void ScaleFilterCols64_16_C(uint16_t* dst_ptr,
     dst_ptr[0] = BLENDER(a, b, x & 0xffff);
   }
 }
+
+// 16 bit UV versions.  x is stepped in 64 bits so that any width is supported.
+void ScaleUVCols_16_C(uint16_t* dst_uv,
+                      const uint16_t* src_uv,
+                      int dst_width,
+                      int x32,
+                      int dx) {
+  int64_t x = (int64_t)(x32);
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    int64_t xi = x >> 16;
+    dst_uv[0] = src_uv[xi * 2 + 0];
+    dst_uv[1] = src_uv[xi * 2 + 1];
+    x += dx;
+    dst_uv += 2;
+  }
+}
+
+void ScaleUVFilterCols_16_C(uint16_t* dst_uv,
+                            const uint16_t* src_uv,
+                            int dst_width,
+                            int x32,
+                            int dx) {
+  int64_t x = (int64_t)(x32);
+  int j;
+  for (j = 0; j < dst_width; ++j) {
+    int64_t xi = x >> 16;
+    const uint16_t* src = src_uv + xi * 2;
+    dst_uv[0] = BLENDER(src[0], src[2], x & 0xffff);
+    dst_uv[1] = BLENDER(src[1], src[3], x & 0xffff);
+    x += dx;
+    dst_uv += 2;
+  }
+}
 #undef BLENDER
 
 void ScaleRowDown38_C(const uint8_t* src_ptr,
@@ -1454,6 +1490,100 @@ void ScaleUVFilterCols64_C(uint8_t* dst_uv,
 #undef BLENDERC
 #undef BLENDER
 
+// Polyphase filters.  The horizontal pass filters a row of pixels into 16 bit
+// samples with 6 fractional bits, from taps source pixels starting at
+// starts[x] weighted by coefficients with 14 fractional bits.  The vertical
+// pass filters taps of those rows into a row of pixels.
+
+// Index of the coefficient of tap t of pixel x of a plane.  Coefficients are
+// stored 4 taps of 8 pixels at a time, in the pixel order the SIMD versions
+// produce after widening the source bytes to 16 bits.
+static __inline int PolyphaseIndex(int x, int t, int taps) {
+  static const int kPixelSlot[8] = {0, 1, 4, 5, 2, 3, 6, 7};
+  return ((x >> 3) * (taps >> 2) + (t >> 2)) * 32 + kPixelSlot[x & 7] * 4 +
+         (t & 3);
+}
+
+// dst_width is a multiple of 8 and taps is a multiple of 4.
+void ScaleRowPolyphaseH_C(const uint8_t* src_ptr,
+                          int16_t* dst_ptr,
+                          const int16_t* coeffs,
+                          const int* starts,
+                          int dst_width,
+                          int taps) {
+  int x, t;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_ptr + starts[x];
+    int sum = 0;
+    for (t = 0; t < taps; ++t) {
+      sum += src[t] * coeffs[PolyphaseIndex(x, t, taps)];
+    }
+    dst_ptr[x] = (int16_t)((sum + 128) >> 8);
+  }
+}
+
+// Coefficients of UV and ARGB pixels are stored taps per pixel.
+void ScaleUVRowPolyphaseH_C(const uint8_t* src_uv,
+                            int16_t* dst_ptr,
+                            const int16_t* coeffs,
+                            const int* starts,
+                            int dst_width,
+                            int taps) {
+  int x, t;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_uv + starts[x] * 2;
+    int sum0 = 0;
+    int sum1 = 0;
+    for (t = 0; t < taps; ++t) {
+      sum0 += src[t * 2 + 0] * coeffs[t];
+      sum1 += src[t * 2 + 1] * coeffs[t];
+    }
+    dst_ptr[0] = (int16_t)((sum0 + 128) >> 8);
+    dst_ptr[1] = (int16_t)((sum1 + 128) >> 8);
+    dst_ptr += 2;
+    coeffs += taps;
+  }
+}
+
+void ScaleARGBRowPolyphaseH_C(const uint8_t* src_argb,
+                              int16_t* dst_ptr,
+                              const int16_t* coeffs,
+                              const int* starts,
+                              int dst_width,
+                              int taps) {
+  int x, t, i;
+  for (x = 0; x < dst_width; ++x) {
+    const uint8_t* src = src_argb + starts[x] * 4;
+    for (i = 0; i < 4; ++i) {
+      int sum = 0;
+      for (t = 0; t < taps; ++t) {
+        sum += src[t * 4 + i] * coeffs[t];
+      }
+      dst_ptr[i] = (int16_t)((sum + 128) >> 8);
+    }
+    dst_ptr += 4;
+    coeffs += taps;
+  }
+}
+
+// taps is a multiple of 2.
+void ScaleRowPolyphaseV_C(const int16_t* const* src_rows,
+                          uint8_t* dst_ptr,
+                          const int16_t* coeffs,
+                          int dst_width,
+                          int taps) {
+  int x, t;
+  for (x = 0; x < dst_width; ++x) {
+    int sum = 0;
+    int v;
+    for (t = 0; t < taps; ++t) {
+      sum += src_rows[t][x] * coeffs[t];
+    }
+    v = (sum + (1 << 19)) >> 20;
+    dst_ptr[x] = (uint8_t)(v < 0 ? 0 : (v > 255 ? 255 : v));
+  }
+}
+
 // Scale plane vertically with bilinear interpolation.
 void ScalePlaneVertical(int src_height,
                         int dst_width,
@@ -1472,8 +1602,6 @@ void ScalePlaneVertical(int src_height,
   void (*InterpolateRow)(uint8_t * dst_argb, const uint8_t* src_argb,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
-  const int max_y = (src_height > 1) ? ((src_height - 1) << 16) - 1 : 0;
-  int j;
   assert(bpp >= 1 && bpp <= 4);
   assert(src_height != 0);
   assert(dst_width > 0);
@@ -1519,6 +1647,29 @@ void ScalePlaneVertical(int src_height,
     }
   }
 #endif
+  ScalePlaneVerticalRows(src_height, dst_width_bytes, dst_height, src_stride,
+                         dst_stride, src_argb, 0, dst_argb, y, dy, filtering,
+                         InterpolateRow);
+}
+
+void ScalePlaneVerticalRows(int src_height,
+                            int dst_width_bytes,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_argb,
+                            int src_y,
+                            uint8_t* dst_argb,
+                            int y,
+                            int dy,
+                            enum FilterMode filtering,
+                            void (*InterpolateRow)(uint8_t* dst_ptr,
+                                                   const uint8_t* src_ptr,
+                                                   ptrdiff_t src_stride,
+                                                   int dst_width,
+                                                   int source_y_fraction)) {
+  const int max_y = (src_height > 1) ? ((src_height - 1) << 16) - 1 : 0;
+  int j;
   for (j = 0; j < dst_height; ++j) {
     int yi;
     int yf;
@@ -1527,8 +1678,8 @@ void ScalePlaneVertical(int src_height,
     }
     yi = y >> 16;
     yf = filtering ? ((y >> 8) & 255) : 0;
-    InterpolateRow(dst_argb, src_argb + yi * src_stride, src_stride,
-                   dst_width_bytes, yf);
+    InterpolateRow(dst_argb, src_argb + (ptrdiff_t)(yi - src_y) * src_stride,
+                   src_stride, dst_width_bytes, yf);
     dst_argb += dst_stride;
     y += dy;
   }
@@ -1559,32 +1710,32 @@ void ScalePlaneVertical_16(int src_height,
   src_argb += (x >> 16) * wpp;
 #if defined(HAS_INTERPOLATEROW_16_SSE2)
   if (TestCpuFlag(kCpuHasSSE2)) {
-    InterpolateRow = InterpolateRow_Any_16_SSE2;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    InterpolateRow = InterpolateRow_16_Any_SSE2;
+    if (IS_ALIGNED(dst_width_words, 8)) {
       InterpolateRow = InterpolateRow_16_SSE2;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
-    InterpolateRow = InterpolateRow_Any_16_SSSE3;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    InterpolateRow = InterpolateRow_16_Any_SSSE3;
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_SSSE3;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_AVX2)
   if (TestCpuFlag(kCpuHasAVX2)) {
-    InterpolateRow = InterpolateRow_Any_16_AVX2;
-    if (IS_ALIGNED(dst_width_bytes, 32)) {
+    InterpolateRow = InterpolateRow_16_Any_AVX2;
+    if (IS_ALIGNED(dst_width_words, 16)) {
       InterpolateRow = InterpolateRow_16_AVX2;
     }
   }
 #endif
 #if defined(HAS_INTERPOLATEROW_16_NEON)
   if (TestCpuFlag(kCpuHasNEON)) {
-    InterpolateRow = InterpolateRow_Any_16_NEON;
-    if (IS_ALIGNED(dst_width_bytes, 16)) {
+    InterpolateRow = InterpolateRow_16_Any_NEON;
+    if (IS_ALIGNED(dst_width_words, 8)) {
       InterpolateRow = InterpolateRow_16_NEON;
     }
   }
@@ -1604,6 +1755,544 @@ void ScalePlaneVertical_16(int src_height,
   }
 }
 
+// Samples per source pixel of the Lanczos kernel table.
+#define kPolyphaseLanczosSteps 256
+#define kPolyphaseLanczosSize (3 * kPolyphaseLanczosSteps + 1)
+
+// Most source pixels that contribute to a destination pixel.  Scaling down by
+// more than kPolyphaseMaxTaps / (2 * radius), 5.3x for Lanczos and 8x for
+// bicubic, narrows the kernel to fit, so the work per pixel stays bounded at
+// the cost of some aliasing.  Past 32x some source pixels are skipped.
+#define kPolyphaseMaxTaps 32
+
+// Radius of the filter kernel in source pixels when scaling up.
+static int PolyphaseRadius(enum FilterMode filtering) {
+  return filtering == kFilterLanczos ? 3 : 2;
+}
+
+// Scale of the kernel in source pixels.  Scaling down stretches the kernel
+// to cover the source pixels of each destination pixel, up to
+// kPolyphaseMaxTaps.
+static double PolyphaseStretch(int src_size,
+                               int dst_size,
+                               enum FilterMode filtering) {
+  const double max_stretch =
+      kPolyphaseMaxTaps / (2.0 * PolyphaseRadius(filtering));
+  double stretch = (double)src_size / dst_size;
+  if (stretch < 1.0) {
+    stretch = 1.0;
+  }
+  return stretch < max_stretch ? stretch : max_stretch;
+}
+
+// Number of source pixels that contribute to a destination pixel.
+static int PolyphaseTaps(int src_size,
+                         int dst_size,
+                         enum FilterMode filtering) {
+  int taps = (int)ceil(2.0 * PolyphaseRadius(filtering) *
+                       PolyphaseStretch(src_size, dst_size, filtering));
+  return taps < kPolyphaseMaxTaps ? taps : kPolyphaseMaxTaps;
+}
+
+// Lanczos 3 kernel, sinc(x) * sinc(x / 3), sampled for PolyphaseWeight.
+static void PolyphaseLanczosTable(float* lanczos) {
+  const double kPi = 3.14159265358979323846;
+  int i;
+  lanczos[0] = 1.f;
+  for (i = 1; i < kPolyphaseLanczosSize; ++i) {
+    double x = kPi * i / kPolyphaseLanczosSteps;
+    lanczos[i] = (float)(3.0 * sin(x) * sin(x / 3.0) / (x * x));
+  }
+}
+
+// Weight of a source pixel x pixels from the center of the kernel.
+static double PolyphaseWeight(enum FilterMode filtering,
+                              const float* lanczos,
+                              double x) {
+  x = fabs(x);
+  if (filtering == kFilterBicubic) {
+    // Keys cubic with a = -0.5, also known as Catmull-Rom.
+    if (x < 1.0) {
+      return (1.5 * x - 2.5) * x * x + 1.0;
+    }
+    if (x < 2.0) {
+      return ((-0.5 * x + 2.5) * x - 4.0) * x + 2.0;
+    }
+    return 0.0;
+  }
+  x *= kPolyphaseLanczosSteps;
+  if (x < 3 * kPolyphaseLanczosSteps) {
+    int i = (int)x;
+    return lanczos[i] + (lanczos[i + 1] - lanczos[i]) * (x - i);
+  }
+  return 0.0;
+}
+
+// Compute the window starts and coefficients of destination pixels
+// [clip, clip + clip_size) for scaling src_size pixels to dst_size.  Windows
+// of window source pixels are kept inside the source, and the weights of
+// pixels past the edges are added to the edge pixels.  coeffs has taps
+// entries per pixel, must be zeroed, and is in the layout of
+// ScaleRowPolyphaseH_C if grouped.  The weights of each pixel sum to 1 << 14.
+static void PolyphaseFilter(int src_size,
+                            int dst_size,
+                            int clip,
+                            int clip_size,
+                            int taps,
+                            int window,
+                            LIBYUV_BOOL mirror,
+                            LIBYUV_BOOL grouped,
+                            enum FilterMode filtering,
+                            const float* lanczos,
+                            int* starts,
+                            int16_t* coeffs) {
+  const double scale = (double)src_size / dst_size;
+  const double stretch = PolyphaseStretch(src_size, dst_size, filtering);
+  const double radius = PolyphaseRadius(filtering) * stretch;
+  const int max_taps = PolyphaseTaps(src_size, dst_size, filtering);
+  int i, p, t;
+  for (i = 0; i < clip_size; ++i) {
+    int x = mirror ? dst_size - 1 - clip - i : clip + i;
+    double center = (x + 0.5) * scale - 0.5;
+    int left = (int)floor(center - radius) + 1;
+    int right = (int)ceil(center + radius);
+    int start = 0;
+    int total = 0;
+    int max_t = 0;
+    double sum = 0.0;
+    if (right > left + max_taps) {
+      right = left + max_taps;
+    }
+    if (src_size > window) {
+      start = left < 0 ? 0 : left;
+      start = start > src_size - window ? src_size - window : start;
+      if (mirror) {
+        start = src_size - window - start;
+      }
+    }
+    for (p = left; p < right; ++p) {
+      sum += PolyphaseWeight(filtering, lanczos, (p - center) / stretch);
+    }
+    for (p = left; p < right; ++p) {
+      int q = p < 0 ? 0 : (p >= src_size ? src_size - 1 : p);
+      int c = (int)floor(
+          PolyphaseWeight(filtering, lanczos, (p - center) / stretch) *
+              16384.0 / sum +
+          0.5);
+      t = (mirror ? src_size - 1 - q : q) - start;
+      assert(t >= 0 && t < window);
+      coeffs[grouped ? PolyphaseIndex(i, t, taps) : i * taps + t] +=
+          (int16_t)c;
+      total += c;
+    }
+    // Add the rounding error to the largest weight.
+    for (t = 1; t < window; ++t) {
+      int j = grouped ? PolyphaseIndex(i, t, taps) : i * taps + t;
+      int k = grouped ? PolyphaseIndex(i, max_t, taps) : i * taps + max_t;
+      if (coeffs[j] > coeffs[k]) {
+        max_t = t;
+      }
+    }
+    coeffs[grouped ? PolyphaseIndex(i, max_t, taps) : i * taps + max_t] +=
+        (int16_t)(16384 - total);
+    starts[i] = start;
+  }
+}
+
+// Tables and row buffers of ScalePolyphaseRows, at 64 byte aligned offsets.
+// The tables are only laid out when the filter has none of its own.
+typedef struct {
+  int width;     // Destination pixels filtered horizontally, padded.
+  int row_size;  // Samples in a horizontally filtered row.
+  int64_t x_starts;
+  int64_t x_coeffs;
+  int64_t y_starts;
+  int64_t y_coeffs;
+  int64_t lanczos;
+  int64_t rows;
+  int64_t row_ids;
+  int64_t src_row;
+  int64_t dst_row;
+  int64_t ring;
+  int64_t size;
+} PolyphaseLayout;
+
+static int64_t PolyphaseAppend(PolyphaseLayout* layout, int64_t size) {
+  int64_t offset = layout->size;
+  layout->size += (size + 63) & ~63;
+  return offset;
+}
+
+// Lay out the tables of table_width by table_height destination pixels,
+// if table_width is not 0, then the row buffers of a clip_width wide clip.
+static void PolyphaseLayoutInit(PolyphaseLayout* layout,
+                                const ScalePolyphaseFilter* f,
+                                int table_width,
+                                int table_height,
+                                int clip_width) {
+  const int bpp = f->bpp;
+  layout->width = bpp == 1 ? (clip_width + 7) & ~7 : (clip_width + 1) & ~1;
+  layout->row_size = (layout->width * bpp + 15) & ~15;
+  layout->size = 0;
+  layout->x_starts = 0;
+  layout->x_coeffs = 0;
+  layout->y_starts = 0;
+  layout->y_coeffs = 0;
+  layout->lanczos = 0;
+  if (table_width) {
+    // The horizontal filter runs on whole groups of pixels.
+    const int x_width =
+        table_width > layout->width ? table_width : layout->width;
+    layout->x_starts = PolyphaseAppend(layout, (int64_t)x_width * 4);
+    layout->x_coeffs =
+        PolyphaseAppend(layout, (int64_t)x_width * f->taps_x * 2);
+    layout->y_starts = PolyphaseAppend(layout, (int64_t)table_height * 4);
+    layout->y_coeffs =
+        PolyphaseAppend(layout, (int64_t)table_height * f->taps_y * 2);
+    layout->lanczos = PolyphaseAppend(layout, kPolyphaseLanczosSize * 4);
+  }
+  layout->rows = PolyphaseAppend(layout, f->taps_y * (int64_t)sizeof(int16_t*));
+  layout->row_ids = PolyphaseAppend(layout, (int64_t)f->taps_y * 4);
+  layout->src_row = PolyphaseAppend(layout, (int64_t)f->taps_x * bpp);
+  layout->dst_row = PolyphaseAppend(layout, layout->row_size);
+  layout->ring =
+      PolyphaseAppend(layout, (int64_t)f->taps_y * layout->row_size * 2);
+}
+
+// Destination pixels in the horizontal tables of ScalePolyphaseTables.  The
+// horizontal filter of a clip reads up to 7 pixels past the clip.
+static int PolyphaseTableWidth(const ScalePolyphaseFilter* f) {
+  return (f->dst_width + 8) & ~7;
+}
+
+// Build the window starts and coefficients of clip_width by clip_height
+// destination pixels from clip_x, clip_y at layout offsets in buffer, which
+// is zeroed.
+static void PolyphaseBuildTables(const ScalePolyphaseFilter* f,
+                                 const PolyphaseLayout* layout,
+                                 uint8_t* buffer,
+                                 int clip_x,
+                                 int clip_y,
+                                 int clip_width,
+                                 int clip_height) {
+  float* lanczos = (float*)(buffer + layout->lanczos);
+  if (f->filtering == kFilterLanczos) {
+    PolyphaseLanczosTable(lanczos);
+  }
+  PolyphaseFilter(Abs(f->src_width), f->dst_width, clip_x, clip_width,
+                  f->taps_x, f->taps_x, f->src_width < 0, f->bpp == 1,
+                  f->filtering, lanczos, (int*)(buffer + layout->x_starts),
+                  (int16_t*)(buffer + layout->x_coeffs));
+  PolyphaseFilter(f->src_height, f->dst_height, clip_y, clip_height,
+                  f->taps_y, f->window_y, 0, 0, f->filtering, lanczos,
+                  (int*)(buffer + layout->y_starts),
+                  (int16_t*)(buffer + layout->y_coeffs));
+}
+
+void ScalePolyphaseInit(ScalePolyphaseFilter* f,
+                        int src_width,
+                        int src_height,
+                        int dst_width,
+                        int dst_height,
+                        int bpp,
+                        enum FilterMode filtering) {
+  const int abs_width = Abs(src_width);
+  int taps_x = PolyphaseTaps(abs_width, dst_width, filtering);
+  int taps_y = PolyphaseTaps(src_height, dst_height, filtering);
+  assert(bpp == 1 || bpp == 2 || bpp == 4);
+  assert(src_height > 0);
+  f->src_width = src_width;
+  f->src_height = src_height;
+  f->dst_width = dst_width;
+  f->dst_height = dst_height;
+  f->bpp = bpp;
+  f->filtering = filtering;
+  f->taps_x = ((taps_x < abs_width ? taps_x : abs_width) + 3) & ~3;
+  f->window_y = taps_y < src_height ? taps_y : src_height;
+  f->taps_y = (f->window_y + 1) & ~1;
+  f->v_align = 1;
+  f->x_starts = NULL;
+  f->x_coeffs = NULL;
+  f->y_starts = NULL;
+  f->y_coeffs = NULL;
+  f->tables_mem = NULL;
+  f->ring = NULL;
+  f->ring_ids = NULL;
+
+  f->ScaleRowPolyphaseH = bpp == 1   ? ScaleRowPolyphaseH_C
+                          : bpp == 2 ? ScaleUVRowPolyphaseH_C
+                                     : ScaleARGBRowPolyphaseH_C;
+  f->ScaleRowPolyphaseV = ScaleRowPolyphaseV_C;
+  if (bpp == 1) {
+#if defined(HAS_SCALEROWPOLYPHASEH_SSSE3)
+    if (TestCpuFlag(kCpuHasSSSE3)) {
+      f->ScaleRowPolyphaseH = ScaleRowPolyphaseH_SSSE3;
+    }
+#endif
+#if defined(HAS_SCALEROWPOLYPHASEH_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      f->ScaleRowPolyphaseH = ScaleRowPolyphaseH_AVX2;
+    }
+#endif
+#if defined(HAS_SCALEROWPOLYPHASEH_NEON)
+    if (TestCpuFlag(kCpuHasNEON)) {
+      f->ScaleRowPolyphaseH = ScaleRowPolyphaseH_NEON;
+    }
+#endif
+  } else if (bpp == 2) {
+#if defined(HAS_SCALEUVROWPOLYPHASEH_SSSE3)
+    if (TestCpuFlag(kCpuHasSSSE3)) {
+      f->ScaleRowPolyphaseH = ScaleUVRowPolyphaseH_SSSE3;
+    }
+#endif
+#if defined(HAS_SCALEUVROWPOLYPHASEH_NEON)
+    if (TestCpuFlag(kCpuHasNEON)) {
+      f->ScaleRowPolyphaseH = ScaleUVRowPolyphaseH_NEON;
+    }
+#endif
+  } else {
+#if defined(HAS_SCALEARGBROWPOLYPHASEH_SSSE3)
+    if (TestCpuFlag(kCpuHasSSSE3)) {
+      f->ScaleRowPolyphaseH = ScaleARGBRowPolyphaseH_SSSE3;
+    }
+#endif
+#if defined(HAS_SCALEARGBROWPOLYPHASEH_AVX2)
+    if (TestCpuFlag(kCpuHasAVX2)) {
+      f->ScaleRowPolyphaseH = ScaleARGBRowPolyphaseH_AVX2;
+    }
+#endif
+#if defined(HAS_SCALEARGBROWPOLYPHASEH_NEON)
+    if (TestCpuFlag(kCpuHasNEON)) {
+      f->ScaleRowPolyphaseH = ScaleARGBRowPolyphaseH_NEON;
+    }
+#endif
+  }
+  // The SIMD vertical filters write multiples of 16 pixels.  Odd widths are
+  // written to a row buffer and copied.
+#if defined(HAS_SCALEROWPOLYPHASEV_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    f->ScaleRowPolyphaseV = ScaleRowPolyphaseV_SSE2;
+    f->v_align = 16;
+  }
+#endif
+#if defined(HAS_SCALEROWPOLYPHASEV_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    f->ScaleRowPolyphaseV = ScaleRowPolyphaseV_AVX2;
+    f->v_align = 16;
+  }
+#endif
+#if defined(HAS_SCALEROWPOLYPHASEV_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    f->ScaleRowPolyphaseV = ScaleRowPolyphaseV_NEON;
+    f->v_align = 16;
+  }
+#endif
+}
+
+int ScalePolyphaseTablesSize(const ScalePolyphaseFilter* f) {
+  PolyphaseLayout layout;
+  PolyphaseLayoutInit(&layout, f, PolyphaseTableWidth(f), f->dst_height, 0);
+  return layout.rows <= 0x7fffffff ? (int)layout.rows : 0;
+}
+
+void ScalePolyphaseTables(ScalePolyphaseFilter* f, uint8_t* tables) {
+  PolyphaseLayout layout;
+  PolyphaseLayoutInit(&layout, f, PolyphaseTableWidth(f), f->dst_height, 0);
+  memset(tables, 0, (size_t)layout.rows);
+  PolyphaseBuildTables(f, &layout, tables, 0, 0, f->dst_width,
+                       f->dst_height);
+  f->x_starts = (const int*)(tables + layout.x_starts);
+  f->x_coeffs = (const int16_t*)(tables + layout.x_coeffs);
+  f->y_starts = (const int*)(tables + layout.y_starts);
+  f->y_coeffs = (const int16_t*)(tables + layout.y_coeffs);
+}
+
+void ScalePolyphaseAllocTables(ScalePolyphaseFilter* f) {
+  int size = ScalePolyphaseTablesSize(f);
+  if (size > 0 && !f->tables_mem) {
+    f->tables_mem = (uint8_t*)malloc((size_t)size + 63);
+    if (f->tables_mem) {
+      ScalePolyphaseTables(
+          f, (uint8_t*)(((intptr_t)f->tables_mem + 63) & ~63));
+    }
+  }
+}
+
+void ScalePolyphaseFree(ScalePolyphaseFilter* f) {
+  if (f->tables_mem) {
+    free(f->tables_mem);
+    f->tables_mem = NULL;
+    f->x_starts = NULL;
+    f->x_coeffs = NULL;
+    f->y_starts = NULL;
+    f->y_coeffs = NULL;
+  }
+}
+
+// The ring keeps its row ids, then taps_y rows of the full destination width.
+int ScalePolyphaseRingSize(const ScalePolyphaseFilter* f) {
+  PolyphaseLayout layout;
+  int64_t size;
+  PolyphaseLayoutInit(&layout, f, 0, 0, f->dst_width);
+  size = (((int64_t)f->taps_y * 4 + 63) & ~63) +
+         (int64_t)f->taps_y * layout.row_size * 2;
+  return size <= 0x7fffffff ? (int)size : 0;
+}
+
+void ScalePolyphaseRing(ScalePolyphaseFilter* f, uint8_t* ring) {
+  memset(ring, 0, (size_t)ScalePolyphaseRingSize(f));
+  f->ring_ids = (int*)ring;
+  f->ring = (int16_t*)(ring + (((size_t)f->taps_y * 4 + 63) & ~63));
+  ScalePolyphaseRingReset(f);
+}
+
+void ScalePolyphaseRingReset(const ScalePolyphaseFilter* f) {
+  int t;
+  if (f->ring_ids) {
+    for (t = 0; t < f->taps_y; ++t) {
+      f->ring_ids[t] = -1;
+    }
+  }
+}
+
+// Size of the scratch buffer used by ScalePolyphase, or 0 if it is too large
+// to pass as scratch.
+int ScalePolyphaseScratchSize(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              int bpp,
+                              enum FilterMode filtering) {
+  ScalePolyphaseFilter f;
+  PolyphaseLayout layout;
+  ScalePolyphaseInit(&f, src_width, Abs(src_height), dst_width, dst_height,
+                     bpp, filtering);
+  PolyphaseLayoutInit(&layout, &f, dst_width, dst_height, dst_width);
+  return layout.size + 63 <= 0x7fffffff ? (int)layout.size + 63 : 0;
+}
+
+// Each source row is filtered horizontally once, into a ring of taps rows
+// that the vertical filter reads.  Full width clips use the ring of
+// ScalePolyphaseRing, if any, so rows shared with the previous clip are not
+// filtered again.
+void ScalePolyphaseRows(const ScalePolyphaseFilter* f,
+                        const uint8_t* src,
+                        int src_stride,
+                        int src_y,
+                        uint8_t* dst,
+                        int dst_stride,
+                        int clip_x,
+                        int clip_y,
+                        int clip_width,
+                        int clip_height,
+                        const LibyuvScratch* scratch) {
+  const int bpp = f->bpp;
+  const int src_width = Abs(f->src_width);
+  const int dst_width_bytes = clip_width * bpp;
+  const int v_width = (dst_width_bytes + f->v_align - 1) & ~(f->v_align - 1);
+  const LIBYUV_BOOL has_tables = f->x_coeffs != NULL;
+  const LIBYUV_BOOL keep_ring =
+      f->ring != NULL && clip_x == 0 && clip_width == f->dst_width;
+  PolyphaseLayout layout;
+  int y, t;
+  assert(clip_width > 0);
+  // Coefficients of 8 pixels are interleaved for 1 byte pixels.
+  assert(bpp != 1 || (clip_x & 7) == 0);
+  PolyphaseLayoutInit(&layout, f, has_tables ? 0 : clip_width, clip_height,
+                      clip_width);
+
+  {
+    align_buffer_64_scratch(buffer, layout.size, scratch);
+    const int* x_starts;
+    const int16_t* x_coeffs;
+    const int* y_starts;
+    const int16_t* y_coeffs;
+    const int16_t** rows = (const int16_t**)(buffer + layout.rows);
+    int* row_ids = keep_ring ? f->ring_ids : (int*)(buffer + layout.row_ids);
+    uint8_t* src_row = buffer + layout.src_row;
+    uint8_t* dst_row = buffer + layout.dst_row;
+    int16_t* ring = keep_ring ? f->ring : (int16_t*)(buffer + layout.ring);
+    if (!buffer) {
+      return;
+    }
+    memset(buffer, 0, (size_t)(keep_ring ? layout.ring : layout.size));
+    if (has_tables) {
+      x_starts = f->x_starts + clip_x;
+      x_coeffs = f->x_coeffs + (ptrdiff_t)clip_x * f->taps_x;
+      y_starts = f->y_starts + clip_y;
+      y_coeffs = f->y_coeffs + (ptrdiff_t)clip_y * f->taps_y;
+    } else {
+      PolyphaseBuildTables(f, &layout, buffer, clip_x, clip_y, clip_width,
+                           clip_height);
+      x_starts = (const int*)(buffer + layout.x_starts);
+      x_coeffs = (const int16_t*)(buffer + layout.x_coeffs);
+      y_starts = (const int*)(buffer + layout.y_starts);
+      y_coeffs = (const int16_t*)(buffer + layout.y_coeffs);
+    }
+    if (!keep_ring) {
+      for (t = 0; t < f->taps_y; ++t) {
+        row_ids[t] = -1;
+      }
+    }
+
+    for (y = 0; y < clip_height; ++y) {
+      // Filter the source rows of the window that are not in the ring yet.
+      // Taps past the window have no weight and reuse the first row.
+      for (t = 0; t < f->taps_y; ++t) {
+        int row = y_starts[y] + (t < f->window_y ? t : 0);
+        int slot = row % f->taps_y;
+        int16_t* ring_row = ring + (ptrdiff_t)slot * layout.row_size;
+        if (row_ids[slot] != row) {
+          const uint8_t* src_ptr = src + (ptrdiff_t)(row - src_y) * src_stride;
+          if (src_width < f->taps_x) {
+            memcpy(src_row, src_ptr, src_width * bpp);
+            src_ptr = src_row;
+          }
+          f->ScaleRowPolyphaseH(src_ptr, ring_row, x_coeffs, x_starts,
+                                layout.width, f->taps_x);
+          row_ids[slot] = row;
+        }
+        rows[t] = ring_row;
+      }
+      if (v_width == dst_width_bytes) {
+        f->ScaleRowPolyphaseV(rows, dst, y_coeffs + y * f->taps_y, v_width,
+                              f->taps_y);
+      } else {
+        f->ScaleRowPolyphaseV(rows, dst_row, y_coeffs + y * f->taps_y,
+                              v_width, f->taps_y);
+        memcpy(dst, dst_row, dst_width_bytes);
+      }
+      dst += dst_stride;
+    }
+    free_aligned_buffer_64(buffer);
+  }
+}
+
+// Scale the clip rectangle of a plane of bpp byte pixels with a polyphase
+// filter.  dst points to the clip rectangle.  A negative src_width mirrors
+// the image.
+void ScalePolyphase(const uint8_t* src,
+                    int src_stride,
+                    int src_width,
+                    int src_height,
+                    uint8_t* dst,
+                    int dst_stride,
+                    int dst_width,
+                    int dst_height,
+                    int clip_x,
+                    int clip_y,
+                    int clip_width,
+                    int clip_height,
+                    int bpp,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch) {
+  ScalePolyphaseFilter f;
+  ScalePolyphaseInit(&f, src_width, src_height, dst_width, dst_height, bpp,
+                     filtering);
+  ScalePolyphaseRows(&f, src, src_stride, 0, dst, dst_stride, clip_x, clip_y,
+                     clip_width, clip_height, scratch);
+}
+
 // Simplify the filtering based on scale factors.
 enum FilterMode ScaleFilterReduce(int src_width,
                                   int src_height,
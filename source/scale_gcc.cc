@@ -293,6 +293,224 @@ void ScaleRowDown2Box_AVX2(const uint8_t* src_ptr,
 }
 #endif  // HAS_SCALEROWDOWN2_AVX2
 
+#ifdef HAS_SCALEROWDOWN2_16_SSE2
+// 16 bit versions of the ScaleRowDown2 functions.  Without packusdw the
+// results are packed with packssdw, either from values that already fit in
+// a signed short or from values biased by -0x8000.
+void ScaleRowDown2_16_SSE2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      // 8 pixel loop.
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "movdqu      0x10(%0),%%xmm1               \n"
+      "lea         0x20(%0),%0                   \n"
+      "psrad       $0x10,%%xmm0                  \n"
+      "psrad       $0x10,%%xmm1                  \n"
+      "packssdw    %%xmm1,%%xmm0                 \n"
+      "movdqu      %%xmm0,(%1)                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst),       // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1");
+}
+
+void ScaleRowDown2Linear_16_SSE2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "movdqu      0x10(%0),%%xmm1               \n"
+      "lea         0x20(%0),%0                   \n"
+      "movdqa      %%xmm0,%%xmm2                 \n"
+      "movdqa      %%xmm1,%%xmm3                 \n"
+      "pslld       $0x10,%%xmm0                  \n"
+      "pslld       $0x10,%%xmm1                  \n"
+      "psrad       $0x10,%%xmm0                  \n"  // even pixels
+      "psrad       $0x10,%%xmm1                  \n"
+      "psrad       $0x10,%%xmm2                  \n"  // odd pixels
+      "psrad       $0x10,%%xmm3                  \n"
+      "packssdw    %%xmm1,%%xmm0                 \n"
+      "packssdw    %%xmm3,%%xmm2                 \n"
+      "pavgw       %%xmm2,%%xmm0                 \n"
+      "movdqu      %%xmm0,(%1)                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst),       // %1
+        "+r"(dst_width)  // %2
+        ::"memory",
+        "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+
+void ScaleRowDown2Box_16_SSE2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              int dst_width) {
+  asm volatile(
+      "pcmpeqb     %%xmm4,%%xmm4                 \n"
+      "psllw       $0xf,%%xmm4                   \n"  // 0x8000
+      "pcmpeqb     %%xmm5,%%xmm5                 \n"
+      "psrlw       $0xf,%%xmm5                   \n"  // 1
+      "pcmpeqb     %%xmm6,%%xmm6                 \n"
+      "psrld       $0x1f,%%xmm6                  \n"
+      "pslld       $0x1,%%xmm6                   \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm0                   \n"
+      "movdqu      0x10(%0),%%xmm1               \n"
+      "movdqu      0x00(%0,%3,2),%%xmm2          \n"
+      "movdqu      0x10(%0,%3,2),%%xmm3          \n"
+      "lea         0x20(%0),%0                   \n"
+      "pxor        %%xmm4,%%xmm0                 \n"  // make pixels signed.
+      "pxor        %%xmm4,%%xmm1                 \n"
+      "pxor        %%xmm4,%%xmm2                 \n"
+      "pxor        %%xmm4,%%xmm3                 \n"
+      "pmaddwd     %%xmm5,%%xmm0                 \n"
+      "pmaddwd     %%xmm5,%%xmm1                 \n"
+      "pmaddwd     %%xmm5,%%xmm2                 \n"
+      "pmaddwd     %%xmm5,%%xmm3                 \n"
+      "paddd       %%xmm2,%%xmm0                 \n"
+      "paddd       %%xmm3,%%xmm1                 \n"
+      "paddd       %%xmm6,%%xmm0                 \n"
+      "paddd       %%xmm6,%%xmm1                 \n"
+      "psrad       $0x2,%%xmm0                   \n"
+      "psrad       $0x2,%%xmm1                   \n"
+      "packssdw    %%xmm1,%%xmm0                 \n"
+      "pxor        %%xmm4,%%xmm0                 \n"  // make pixels unsigned.
+      "movdqu      %%xmm0,(%1)                   \n"
+      "lea         0x10(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst),                   // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_16_SSE2
+
+#ifdef HAS_SCALEROWDOWN2_16_AVX2
+void ScaleRowDown2_16_AVX2(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpsrad      $0x10,%%ymm0,%%ymm0           \n"
+      "vpsrad      $0x10,%%ymm1,%%ymm1           \n"
+      "vpackssdw   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+               : "+r"(src_ptr),   // %0
+                 "+r"(dst),       // %1
+                 "+r"(dst_width)  // %2
+                 ::"memory",
+                 "cc", "xmm0", "xmm1");
+}
+
+void ScaleRowDown2Linear_16_AVX2(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpsrad      $0x10,%%ymm0,%%ymm2           \n"  // odd pixels
+      "vpsrad      $0x10,%%ymm1,%%ymm3           \n"
+      "vpslld      $0x10,%%ymm0,%%ymm0           \n"
+      "vpslld      $0x10,%%ymm1,%%ymm1           \n"
+      "vpsrad      $0x10,%%ymm0,%%ymm0           \n"  // even pixels
+      "vpsrad      $0x10,%%ymm1,%%ymm1           \n"
+      "vpackssdw   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpackssdw   %%ymm3,%%ymm2,%%ymm2          \n"
+      "vpavgw      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+               : "+r"(src_ptr),   // %0
+                 "+r"(dst),       // %1
+                 "+r"(dst_width)  // %2
+                 ::"memory",
+                 "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+
+void ScaleRowDown2Box_16_AVX2(const uint16_t* src_ptr,
+                              ptrdiff_t src_stride,
+                              uint16_t* dst,
+                              int dst_width) {
+  asm volatile(
+      "vpcmpeqb    %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpsllw      $0xf,%%ymm4,%%ymm4            \n"  // 0x8000
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+      "vpsrlw      $0xf,%%ymm5,%%ymm5            \n"  // 1
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1f,%%ymm6,%%ymm6           \n"
+      "vpslld      $0x1,%%ymm6,%%ymm6            \n"  // 2
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpxor       (%0),%%ymm4,%%ymm0            \n"  // make pixels signed.
+      "vpxor       0x20(%0),%%ymm4,%%ymm1        \n"
+      "vpxor       0x00(%0,%3,2),%%ymm4,%%ymm2   \n"
+      "vpxor       0x20(%0,%3,2),%%ymm4,%%ymm3   \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpmaddwd    %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpmaddwd    %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpmaddwd    %%ymm5,%%ymm3,%%ymm3          \n"
+      "vpaddd      %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpaddd      %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm6,%%ymm1,%%ymm1          \n"
+      "vpsrad      $0x2,%%ymm0,%%ymm0            \n"
+      "vpsrad      $0x2,%%ymm1,%%ymm1            \n"
+      "vpackssdw   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpxor       %%ymm4,%%ymm0,%%ymm0          \n"  // make pixels unsigned.
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),               // %0
+        "+r"(dst),                   // %1
+        "+r"(dst_width)              // %2
+      : "r"((intptr_t)(src_stride))  // %3
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6");
+}
+#endif  // HAS_SCALEROWDOWN2_16_AVX2
+
 void ScaleRowDown4_SSSE3(const uint8_t* src_ptr,
                          ptrdiff_t src_stride,
                          uint8_t* dst_ptr,
@@ -766,13 +984,602 @@ void ScaleRowDown38_3_Box_SSSE3(const uint8_t* src_ptr,
       "lea         0x6(%1),%1                    \n"
       "sub         $0x6,%2                       \n"
       "jg          1b                            \n"
-               : "+r"(src_ptr),               // %0
-                 "+r"(dst_ptr),               // %1
-                 "+r"(dst_width)              // %2
-               : "r"((intptr_t)(src_stride))  // %3
-               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
-                 "xmm6", "xmm7");
+               : "+r"(src_ptr),               // %0
+                 "+r"(dst_ptr),               // %1
+                 "+r"(dst_width)              // %2
+               : "r"((intptr_t)(src_stride))  // %3
+               : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+                 "xmm6", "xmm7");
+}
+#if defined(HAS_SCALEROWDOWN34_AVX2) || defined(HAS_SCALEROWDOWN38_AVX2)
+// vpermd to pack the first 12 bytes of each lane together.
+static const uvec8 kPermdLanes12 = {0,  1,  2,  4,  5, 6, 8,  9,
+                                    10, 12, 13, 14, 3, 7, 11, 15};
+#endif
+
+#ifdef HAS_SCALEROWDOWN34_AVX2
+// Offsets of the 12 source bytes of each 16 that ScaleRowDown34 keeps.
+static const uvec8 kShufDown34 = {0,  1,  3,  4,   5,   7,   8,   9,
+                                  11, 12, 13, 15, 128, 128, 128, 128};
+
+// kShuf01, kShuf11 and kShuf21 twice, so that each 2 or 4 consecutive entries
+// are the shuffles for windows of 16 source bytes 8 bytes apart.
+static const uvec8 kShuf34Box[6] = {
+    {0, 1, 1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10},
+    {2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13},
+    {5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13, 13, 14, 14, 15},
+    {0, 1, 1, 2, 2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10},
+    {2, 3, 4, 5, 5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13},
+    {5, 6, 6, 7, 8, 9, 9, 10, 10, 11, 12, 13, 13, 14, 14, 15}};
+
+// kMadd01, kMadd11 and kMadd21 twice, to match kShuf34Box.
+static const uvec8 kMadd34Box[6] = {
+    {3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2},
+    {1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1},
+    {2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3},
+    {3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2},
+    {1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1},
+    {2, 2, 1, 3, 3, 1, 2, 2, 1, 3, 3, 1, 2, 2, 1, 3}};
+
+// 64 pixels to 48, as 4 lanes of 16 pixels to 12.
+void ScaleRowDown34_AVX2(const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         uint8_t* dst_ptr,
+                         int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vbroadcasti128 %3,%%ymm4                  \n"
+      "vpmovzxbd   %4,%%ymm5                     \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpshufb     %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm4,%%ymm1,%%ymm1          \n"
+      "vpermd      %%ymm0,%%ymm5,%%ymm0          \n"
+      "vpermd      %%ymm1,%%ymm5,%%ymm1          \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"  // last 8 are rewritten
+      "vmovdqu     %%xmm1,0x18(%1)               \n"
+      "vextracti128 $0x1,%%ymm1,%%xmm1           \n"
+      "vmovq       %%xmm1,0x28(%1)               \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),      // %0
+        "+r"(dst_ptr),      // %1
+        "+r"(dst_width)     // %2
+      : "m"(kShufDown34),   // %3
+        "m"(kPermdLanes12)  // %4
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5");
+}
+
+// The 3 windows of 16 source bytes that ScaleRowDown34_1_Box_SSSE3 filters
+// per 32 are paired into lanes, for 48 pixels from 64.
+void ScaleRowDown34_1_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width) {
+  asm volatile(
+      "vmovdqu     (%4),%%ymm8                   \n"  // windows 0 | 8
+      "vmovdqu     0x20(%4),%%ymm9               \n"  // windows 16 | 32
+      "vmovdqu     0x10(%4),%%ymm10              \n"  // windows 40 | 48
+      "vmovdqu     (%5),%%ymm11                  \n"
+      "vmovdqu     0x20(%5),%%ymm12              \n"
+      "vmovdqu     0x10(%5),%%ymm13              \n"
+      "vbroadcasti128 %6,%%ymm14                 \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%xmm0                   \n"
+      "vinserti128 $0x1,0x8(%0),%%ymm0,%%ymm0    \n"
+      "vmovdqu     0x00(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x8(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm3,%%ymm0,%%ymm0          \n"
+      "vmovdqu     0x10(%0),%%xmm1               \n"
+      "vinserti128 $0x1,0x20(%0),%%ymm1,%%ymm1   \n"
+      "vmovdqu     0x10(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x20(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x28(%0),%%xmm2               \n"
+      "vinserti128 $0x1,0x30(%0),%%ymm2,%%ymm2   \n"
+      "vmovdqu     0x28(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x30(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpshufb     %%ymm8,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm9,%%ymm1,%%ymm1          \n"
+      "vpshufb     %%ymm10,%%ymm2,%%ymm2         \n"
+      "vpmaddubsw  %%ymm11,%%ymm0,%%ymm0         \n"
+      "vpmaddubsw  %%ymm12,%%ymm1,%%ymm1         \n"
+      "vpmaddubsw  %%ymm13,%%ymm2,%%ymm2         \n"
+      "vpaddsw     %%ymm14,%%ymm0,%%ymm0         \n"
+      "vpaddsw     %%ymm14,%%ymm1,%%ymm1         \n"
+      "vpaddsw     %%ymm14,%%ymm2,%%ymm2         \n"
+      "vpsrlw      $0x2,%%ymm0,%%ymm0            \n"
+      "vpsrlw      $0x2,%%ymm1,%%ymm1            \n"
+      "vpsrlw      $0x2,%%ymm2,%%ymm2            \n"
+      "vpackuswb   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpackuswb   %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vpermq      $0x8,%%ymm2,%%ymm2            \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "vmovdqu     %%xmm2,0x20(%1)               \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "r"(kShuf34Box),              // %4
+        "r"(kMadd34Box),              // %5
+        "m"(kRound34)                 // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm8", "xmm9", "xmm10",
+        "xmm11", "xmm12", "xmm13", "xmm14");
+}
+
+void ScaleRowDown34_0_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width) {
+  asm volatile(
+      "vmovdqu     (%4),%%ymm8                   \n"  // windows 0 | 8
+      "vmovdqu     0x20(%4),%%ymm9               \n"  // windows 16 | 32
+      "vmovdqu     0x10(%4),%%ymm10              \n"  // windows 40 | 48
+      "vmovdqu     (%5),%%ymm11                  \n"
+      "vmovdqu     0x20(%5),%%ymm12              \n"
+      "vmovdqu     0x10(%5),%%ymm13              \n"
+      "vbroadcasti128 %6,%%ymm14                 \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%xmm0                   \n"
+      "vinserti128 $0x1,0x8(%0),%%ymm0,%%ymm0    \n"
+      "vmovdqu     0x00(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x8(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm0,%%ymm3,%%ymm3          \n"
+      "vpavgb      %%ymm3,%%ymm0,%%ymm0          \n"
+      "vmovdqu     0x10(%0),%%xmm1               \n"
+      "vinserti128 $0x1,0x20(%0),%%ymm1,%%ymm1   \n"
+      "vmovdqu     0x10(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x20(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm1,%%ymm3,%%ymm3          \n"
+      "vpavgb      %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x28(%0),%%xmm2               \n"
+      "vinserti128 $0x1,0x30(%0),%%ymm2,%%ymm2   \n"
+      "vmovdqu     0x28(%0,%3,1),%%xmm3          \n"
+      "vinserti128 $0x1,0x30(%0,%3,1),%%ymm3,%%ymm3 \n"
+      "vpavgb      %%ymm2,%%ymm3,%%ymm3          \n"
+      "vpavgb      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpshufb     %%ymm8,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm9,%%ymm1,%%ymm1          \n"
+      "vpshufb     %%ymm10,%%ymm2,%%ymm2         \n"
+      "vpmaddubsw  %%ymm11,%%ymm0,%%ymm0         \n"
+      "vpmaddubsw  %%ymm12,%%ymm1,%%ymm1         \n"
+      "vpmaddubsw  %%ymm13,%%ymm2,%%ymm2         \n"
+      "vpaddsw     %%ymm14,%%ymm0,%%ymm0         \n"
+      "vpaddsw     %%ymm14,%%ymm1,%%ymm1         \n"
+      "vpaddsw     %%ymm14,%%ymm2,%%ymm2         \n"
+      "vpsrlw      $0x2,%%ymm0,%%ymm0            \n"
+      "vpsrlw      $0x2,%%ymm1,%%ymm1            \n"
+      "vpsrlw      $0x2,%%ymm2,%%ymm2            \n"
+      "vpackuswb   %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpackuswb   %%ymm2,%%ymm2,%%ymm2          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vpermq      $0x8,%%ymm2,%%ymm2            \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "vmovdqu     %%xmm2,0x20(%1)               \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "r"(kShuf34Box),              // %4
+        "r"(kMadd34Box),              // %5
+        "m"(kRound34)                 // %6
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm8", "xmm9", "xmm10",
+        "xmm11", "xmm12", "xmm13", "xmm14");
+}
+#endif  // HAS_SCALEROWDOWN34_AVX2
+
+#ifdef HAS_SCALEROWDOWN38_AVX2
+// Pack the first 6 bytes of each qword together.
+static const uvec8 kShufPack38 = {0,  1,  2,  3,  4,   5,   8,   9,
+                                  10, 11, 12, 13, 128, 128, 128, 128};
+
+// 64 pixels to 24.  Lanes of 16 pixels 32 apart are shuffled like
+// ScaleRowDown38_SSSE3, then the 12 pixels of each lane are packed.
+void ScaleRowDown38_AVX2(const uint8_t* src_ptr,
+                         ptrdiff_t src_stride,
+                         uint8_t* dst_ptr,
+                         int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vbroadcasti128 %3,%%ymm4                  \n"
+      "vbroadcasti128 %4,%%ymm5                  \n"
+      "vpmovzxbd   %5,%%ymm6                     \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%xmm0                   \n"
+      "vinserti128 $0x1,0x20(%0),%%ymm0,%%ymm0   \n"
+      "vmovdqu     0x10(%0),%%xmm1               \n"
+      "vinserti128 $0x1,0x30(%0),%%ymm1,%%ymm1   \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpshufb     %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpor        %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpermd      %%ymm0,%%ymm6,%%ymm0          \n"
+      "vmovdqu     %%xmm0,(%1)                   \n"
+      "vextracti128 $0x1,%%ymm0,%%xmm0           \n"
+      "vmovq       %%xmm0,0x10(%1)               \n"
+      "lea         0x18(%1),%1                   \n"
+      "sub         $0x18,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),      // %0
+        "+r"(dst_ptr),      // %1
+        "+r"(dst_width)     // %2
+      : "m"(kShuf38a),      // %3
+        "m"(kShuf38b),      // %4
+        "m"(kPermdLanes12)  // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5", "xmm6");
+}
+
+// 64 pixels to 24.  Each lane of 16 pixels is filtered like
+// ScaleRowDown38_2_Box_SSSE3, then the 6 pixels of each lane are packed.
+void ScaleRowDown38_2_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width) {
+  asm volatile(
+      "vbroadcasti128 %4,%%ymm2                  \n"
+      "vbroadcasti128 %5,%%ymm3                  \n"
+      "vbroadcasti128 %6,%%ymm4                  \n"
+      "vbroadcasti128 %7,%%ymm5                  \n"
+      "vbroadcasti128 %8,%%ymm6                  \n"
+      "vpmovzxbd   %9,%%ymm7                     \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vpavgb      0x00(%0,%3,1),%%ymm0,%%ymm0   \n"
+      "vmovdqu     0x20(%0),%%ymm1               \n"
+      "vpavgb      0x20(%0,%3,1),%%ymm1,%%ymm1   \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpshufb     %%ymm2,%%ymm0,%%ymm8          \n"
+      "vpshufb     %%ymm3,%%ymm0,%%ymm9          \n"
+      "vpshufb     %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm9,%%ymm8,%%ymm8          \n"
+      "vpaddusw    %%ymm0,%%ymm8,%%ymm8          \n"
+      "vpmulhuw    %%ymm5,%%ymm8,%%ymm8          \n"
+      "vpshufb     %%ymm2,%%ymm1,%%ymm0          \n"
+      "vpshufb     %%ymm3,%%ymm1,%%ymm9          \n"
+      "vpshufb     %%ymm4,%%ymm1,%%ymm1          \n"
+      "vpaddusw    %%ymm9,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmulhuw    %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpackuswb   %%ymm0,%%ymm8,%%ymm8          \n"
+      "vpermq      $0xd8,%%ymm8,%%ymm8           \n"
+      "vpshufb     %%ymm6,%%ymm8,%%ymm8          \n"
+      "vpermd      %%ymm8,%%ymm7,%%ymm8          \n"
+      "vmovdqu     %%xmm8,(%1)                   \n"
+      "vextracti128 $0x1,%%ymm8,%%xmm8           \n"
+      "vmovq       %%xmm8,0x10(%1)               \n"
+      "lea         0x18(%1),%1                   \n"
+      "sub         $0x18,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShufAb0),                // %4
+        "m"(kShufAb1),                // %5
+        "m"(kShufAb2),                // %6
+        "m"(kScaleAb2),               // %7
+        "m"(kShufPack38),             // %8
+        "m"(kPermdLanes12)            // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9");
+}
+
+// 64 pixels to 24.  Each lane of 16 pixels is filtered like
+// ScaleRowDown38_3_Box_SSSE3, then the 6 pixels of each lane are packed.
+void ScaleRowDown38_3_Box_AVX2(const uint8_t* src_ptr,
+                               ptrdiff_t src_stride,
+                               uint8_t* dst_ptr,
+                               int dst_width) {
+  asm volatile(
+      "vbroadcasti128 %4,%%ymm6                  \n"
+      "vbroadcasti128 %5,%%ymm7                  \n"
+      "vbroadcasti128 %6,%%ymm8                  \n"
+      "vbroadcasti128 %7,%%ymm9                  \n"
+      "vpmovzxbd   %8,%%ymm10                    \n"
+      "vpxor       %%ymm5,%%ymm5,%%ymm5          \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%0),%%ymm0                   \n"
+      "vmovdqu     0x00(%0,%3,1),%%ymm2          \n"
+      "vpunpckhbw  %%ymm5,%%ymm0,%%ymm1          \n"
+      "vpunpcklbw  %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpunpckhbw  %%ymm5,%%ymm2,%%ymm3          \n"
+      "vpunpcklbw  %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x00(%0,%3,2),%%ymm2          \n"
+      "vpunpckhbw  %%ymm5,%%ymm2,%%ymm3          \n"
+      "vpunpcklbw  %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpsrldq     $0x2,%%ymm0,%%ymm2            \n"
+      "vpsrldq     $0x4,%%ymm0,%%ymm3            \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpsrldq     $0x2,%%ymm1,%%ymm2            \n"
+      "vpsrldq     $0x4,%%ymm1,%%ymm3            \n"
+      "vpaddusw    %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpshufb     %%ymm7,%%ymm1,%%ymm1          \n"
+      "vpaddusw    %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmulhuw    %%ymm8,%%ymm0,%%ymm4          \n"  // pixels 0 to 11
+
+      "vmovdqu     0x20(%0),%%ymm0               \n"
+      "vmovdqu     0x20(%0,%3,1),%%ymm2          \n"
+      "vpunpckhbw  %%ymm5,%%ymm0,%%ymm1          \n"
+      "vpunpcklbw  %%ymm5,%%ymm0,%%ymm0          \n"
+      "vpunpckhbw  %%ymm5,%%ymm2,%%ymm3          \n"
+      "vpunpcklbw  %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vmovdqu     0x20(%0,%3,2),%%ymm2          \n"
+      "lea         0x40(%0),%0                   \n"
+      "vpunpckhbw  %%ymm5,%%ymm2,%%ymm3          \n"
+      "vpunpcklbw  %%ymm5,%%ymm2,%%ymm2          \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpsrldq     $0x2,%%ymm0,%%ymm2            \n"
+      "vpsrldq     $0x4,%%ymm0,%%ymm3            \n"
+      "vpaddusw    %%ymm2,%%ymm0,%%ymm0          \n"
+      "vpaddusw    %%ymm3,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpsrldq     $0x2,%%ymm1,%%ymm2            \n"
+      "vpsrldq     $0x4,%%ymm1,%%ymm3            \n"
+      "vpaddusw    %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpaddusw    %%ymm3,%%ymm1,%%ymm1          \n"
+      "vpshufb     %%ymm7,%%ymm1,%%ymm1          \n"
+      "vpaddusw    %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmulhuw    %%ymm8,%%ymm0,%%ymm0          \n"  // pixels 12 to 23
+
+      "vpackuswb   %%ymm0,%%ymm4,%%ymm4          \n"
+      "vpermq      $0xd8,%%ymm4,%%ymm4           \n"
+      "vpshufb     %%ymm9,%%ymm4,%%ymm4          \n"
+      "vpermd      %%ymm4,%%ymm10,%%ymm4         \n"
+      "vmovdqu     %%xmm4,(%1)                   \n"
+      "vextracti128 $0x1,%%ymm4,%%xmm4           \n"
+      "vmovq       %%xmm4,0x10(%1)               \n"
+      "lea         0x18(%1),%1                   \n"
+      "sub         $0x18,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShufAc),                 // %4
+        "m"(kShufAc3),                // %5
+        "m"(kScaleAc33),              // %6
+        "m"(kShufPack38),             // %7
+        "m"(kPermdLanes12)            // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+#endif  // HAS_SCALEROWDOWN38_AVX2
+
+#ifdef HAS_SCALEROWDOWN38_AVX512BW
+// vpermq to put the qwords of vpackuswb back in order.
+static const uvec8 kPermqPack38 = {0, 2, 4, 6, 1, 3, 5, 7,
+                                   0, 0, 0, 0, 0, 0, 0, 0};
+
+// 128 pixels to 48.  The lanes of 16 pixels are split into even and odd lanes
+// for the shuffles of ScaleRowDown38_SSSE3.
+void ScaleRowDown38_AVX512BW(const uint8_t* src_ptr,
+                             ptrdiff_t src_stride,
+                             uint8_t* dst_ptr,
+                             int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "vbroadcasti32x4 %3,%%zmm4                 \n"
+      "vbroadcasti32x4 %4,%%zmm5                 \n"
+      "vpmovzxbd   %5,%%zmm6                     \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "vmovdqu64   0x40(%0),%%zmm1               \n"
+      "lea         0x80(%0),%0                   \n"
+      "vshufi64x2  $0x88,%%zmm1,%%zmm0,%%zmm2    \n"  // even lanes
+      "vshufi64x2  $0xdd,%%zmm1,%%zmm0,%%zmm3    \n"  // odd lanes
+      "vpshufb     %%zmm4,%%zmm2,%%zmm2          \n"
+      "vpshufb     %%zmm5,%%zmm3,%%zmm3          \n"
+      "vporq       %%zmm3,%%zmm2,%%zmm2          \n"
+      "vpermd      %%zmm2,%%zmm6,%%zmm2          \n"
+      "vmovdqu     %%ymm2,(%1)                   \n"
+      "vextracti32x4 $0x2,%%zmm2,0x20(%1)        \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),      // %0
+        "+r"(dst_ptr),      // %1
+        "+r"(dst_width)     // %2
+      : "m"(kShuf38a),      // %3
+        "m"(kShuf38b),      // %4
+        "m"(kPermdLanes12)  // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+}
+
+// ScaleRowDown38_2_Box_AVX2 with 4 lanes, for 48 pixels from 128.
+void ScaleRowDown38_2_Box_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "vbroadcasti32x4 %4,%%zmm2                 \n"
+      "vbroadcasti32x4 %5,%%zmm3                 \n"
+      "vbroadcasti32x4 %6,%%zmm4                 \n"
+      "vbroadcasti32x4 %7,%%zmm5                 \n"
+      "vbroadcasti32x4 %8,%%zmm6                 \n"
+      "vpmovzxbd   %9,%%zmm7                     \n"
+      "vpmovzxbq   %10,%%zmm10                   \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "vpavgb      0x00(%0,%3,1),%%zmm0,%%zmm0   \n"
+      "vmovdqu64   0x40(%0),%%zmm1               \n"
+      "vpavgb      0x40(%0,%3,1),%%zmm1,%%zmm1   \n"
+      "lea         0x80(%0),%0                   \n"
+      "vpshufb     %%zmm2,%%zmm0,%%zmm8          \n"
+      "vpshufb     %%zmm3,%%zmm0,%%zmm9          \n"
+      "vpshufb     %%zmm4,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm9,%%zmm8,%%zmm8          \n"
+      "vpaddusw    %%zmm0,%%zmm8,%%zmm8          \n"
+      "vpmulhuw    %%zmm5,%%zmm8,%%zmm8          \n"
+      "vpshufb     %%zmm2,%%zmm1,%%zmm0          \n"
+      "vpshufb     %%zmm3,%%zmm1,%%zmm9          \n"
+      "vpshufb     %%zmm4,%%zmm1,%%zmm1          \n"
+      "vpaddusw    %%zmm9,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm1,%%zmm0,%%zmm0          \n"
+      "vpmulhuw    %%zmm5,%%zmm0,%%zmm0          \n"
+      "vpackuswb   %%zmm0,%%zmm8,%%zmm8          \n"
+      "vpermq      %%zmm8,%%zmm10,%%zmm8         \n"
+      "vpshufb     %%zmm6,%%zmm8,%%zmm8          \n"
+      "vpermd      %%zmm8,%%zmm7,%%zmm8          \n"
+      "vmovdqu     %%ymm8,(%1)                   \n"
+      "vextracti32x4 $0x2,%%zmm8,0x20(%1)        \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShufAb0),                // %4
+        "m"(kShufAb1),                // %5
+        "m"(kShufAb2),                // %6
+        "m"(kScaleAb2),               // %7
+        "m"(kShufPack38),             // %8
+        "m"(kPermdLanes12),           // %9
+        "m"(kPermqPack38)             // %10
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+
+// ScaleRowDown38_3_Box_AVX2 with 4 lanes, for 48 pixels from 128.
+void ScaleRowDown38_3_Box_AVX512BW(const uint8_t* src_ptr,
+                                   ptrdiff_t src_stride,
+                                   uint8_t* dst_ptr,
+                                   int dst_width) {
+  asm volatile(
+      "vbroadcasti32x4 %4,%%zmm6                 \n"
+      "vbroadcasti32x4 %5,%%zmm7                 \n"
+      "vbroadcasti32x4 %6,%%zmm8                 \n"
+      "vbroadcasti32x4 %7,%%zmm9                 \n"
+      "vpmovzxbd   %8,%%zmm10                    \n"
+      "vpmovzxbq   %9,%%zmm11                    \n"
+      "vpxord      %%zmm5,%%zmm5,%%zmm5          \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu64   (%0),%%zmm0                   \n"
+      "vmovdqu64   0x00(%0,%3,1),%%zmm2          \n"
+      "vpunpckhbw  %%zmm5,%%zmm0,%%zmm1          \n"
+      "vpunpcklbw  %%zmm5,%%zmm0,%%zmm0          \n"
+      "vpunpckhbw  %%zmm5,%%zmm2,%%zmm3          \n"
+      "vpunpcklbw  %%zmm5,%%zmm2,%%zmm2          \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vmovdqu64   0x00(%0,%3,2),%%zmm2          \n"
+      "vpunpckhbw  %%zmm5,%%zmm2,%%zmm3          \n"
+      "vpunpcklbw  %%zmm5,%%zmm2,%%zmm2          \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vpsrldq     $0x2,%%zmm0,%%zmm2            \n"
+      "vpsrldq     $0x4,%%zmm0,%%zmm3            \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm0,%%zmm0          \n"
+      "vpshufb     %%zmm6,%%zmm0,%%zmm0          \n"
+      "vpsrldq     $0x2,%%zmm1,%%zmm2            \n"
+      "vpsrldq     $0x4,%%zmm1,%%zmm3            \n"
+      "vpaddusw    %%zmm2,%%zmm1,%%zmm1          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vpshufb     %%zmm7,%%zmm1,%%zmm1          \n"
+      "vpaddusw    %%zmm1,%%zmm0,%%zmm0          \n"
+      "vpmulhuw    %%zmm8,%%zmm0,%%zmm4          \n"  // pixels 0 to 23
+
+      "vmovdqu64   0x40(%0),%%zmm0               \n"
+      "vmovdqu64   0x40(%0,%3,1),%%zmm2          \n"
+      "vpunpckhbw  %%zmm5,%%zmm0,%%zmm1          \n"
+      "vpunpcklbw  %%zmm5,%%zmm0,%%zmm0          \n"
+      "vpunpckhbw  %%zmm5,%%zmm2,%%zmm3          \n"
+      "vpunpcklbw  %%zmm5,%%zmm2,%%zmm2          \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vmovdqu64   0x40(%0,%3,2),%%zmm2          \n"
+      "lea         0x80(%0),%0                   \n"
+      "vpunpckhbw  %%zmm5,%%zmm2,%%zmm3          \n"
+      "vpunpcklbw  %%zmm5,%%zmm2,%%zmm2          \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vpsrldq     $0x2,%%zmm0,%%zmm2            \n"
+      "vpsrldq     $0x4,%%zmm0,%%zmm3            \n"
+      "vpaddusw    %%zmm2,%%zmm0,%%zmm0          \n"
+      "vpaddusw    %%zmm3,%%zmm0,%%zmm0          \n"
+      "vpshufb     %%zmm6,%%zmm0,%%zmm0          \n"
+      "vpsrldq     $0x2,%%zmm1,%%zmm2            \n"
+      "vpsrldq     $0x4,%%zmm1,%%zmm3            \n"
+      "vpaddusw    %%zmm2,%%zmm1,%%zmm1          \n"
+      "vpaddusw    %%zmm3,%%zmm1,%%zmm1          \n"
+      "vpshufb     %%zmm7,%%zmm1,%%zmm1          \n"
+      "vpaddusw    %%zmm1,%%zmm0,%%zmm0          \n"
+      "vpmulhuw    %%zmm8,%%zmm0,%%zmm0          \n"  // pixels 24 to 47
+
+      "vpackuswb   %%zmm0,%%zmm4,%%zmm4          \n"
+      "vpermq      %%zmm4,%%zmm11,%%zmm4         \n"
+      "vpshufb     %%zmm9,%%zmm4,%%zmm4          \n"
+      "vpermd      %%zmm4,%%zmm10,%%zmm4         \n"
+      "vmovdqu     %%ymm4,(%1)                   \n"
+      "vextracti32x4 $0x2,%%zmm4,0x20(%1)        \n"
+      "lea         0x30(%1),%1                   \n"
+      "sub         $0x30,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),                // %0
+        "+r"(dst_ptr),                // %1
+        "+r"(dst_width)               // %2
+      : "r"((intptr_t)(src_stride)),  // %3
+        "m"(kShufAc),                 // %4
+        "m"(kShufAc3),                // %5
+        "m"(kScaleAc33),              // %6
+        "m"(kShufPack38),             // %7
+        "m"(kPermdLanes12),           // %8
+        "m"(kPermqPack38)             // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10", "xmm11");
 }
+#endif  // HAS_SCALEROWDOWN38_AVX512BW
 
 static const uvec8 kLinearShuffleFar = {2,  3,  0, 1, 6,  7,  4,  5,
                                         10, 11, 8, 9, 14, 15, 12, 13};
@@ -1100,6 +1907,9 @@ void ScaleRowUp2_Bilinear_12_SSSE3(const uint16_t* src_ptr,
 #endif
 
 #ifdef HAS_SCALEROWUP2LINEAR_16_SSE2
+// The 16 bit up2 rows shift the result into the high half of each dword and
+// shift it back arithmetically so that packssdw keeps all 16 bits without
+// needing the SSE4.1 packusdw.
 void ScaleRowUp2_Linear_16_SSE2(const uint16_t* src_ptr,
                                 uint16_t* dst_ptr,
                                 int dst_width) {
@@ -1132,8 +1942,10 @@ void ScaleRowUp2_Linear_16_SSE2(const uint16_t* src_ptr,
       "paddd       %%xmm2,%%xmm0                 \n"  // 3*near+far+2 (lo)
       "paddd       %%xmm3,%%xmm1                 \n"  // 3*near+far+2 (hi)
 
-      "psrld       $2,%%xmm0                     \n"  // 3/4*near+1/4*far (lo)
-      "psrld       $2,%%xmm1                     \n"  // 3/4*near+1/4*far (hi)
+      "pslld       $14,%%xmm0                    \n"
+      "pslld       $14,%%xmm1                    \n"
+      "psrad       $16,%%xmm0                    \n"  // 3/4*near+1/4*far (lo)
+      "psrad       $16,%%xmm1                    \n"  // 3/4*near+1/4*far (hi)
       "packssdw    %%xmm1,%%xmm0                 \n"
       "pshufd      $0b11011000,%%xmm0,%%xmm0     \n"
       "movdqu      %%xmm0,(%1)                   \n"
@@ -1215,14 +2027,16 @@ void ScaleRowUp2_Bilinear_16_SSE2(const uint16_t* src_ptr,
       "paddd       %%xmm6,%%xmm5                 \n"  // 3*near+far+8 (2, lo)
       "paddd       %%xmm0,%%xmm4                 \n"  // 9*near+3*far (1, lo)
       "paddd       %%xmm5,%%xmm4                 \n"  // 9 3 3 1 + 8 (1, lo)
-      "psrld       $4,%%xmm4                     \n"  // ^ div by 16 (1, lo)
+      "pslld       $12,%%xmm4                    \n"
+      "psrad       $16,%%xmm4                    \n"  // ^ div by 16 (1, lo)
 
       "movdqa      %%xmm2,%%xmm5                 \n"
       "paddd       %%xmm2,%%xmm5                 \n"  // 6*near+2*far (2, lo)
       "paddd       %%xmm6,%%xmm0                 \n"  // 3*near+far+8 (1, lo)
       "paddd       %%xmm2,%%xmm5                 \n"  // 9*near+3*far (2, lo)
       "paddd       %%xmm0,%%xmm5                 \n"  // 9 3 3 1 + 8 (2, lo)
-      "psrld       $4,%%xmm5                     \n"  // ^ div by 16 (2, lo)
+      "pslld       $12,%%xmm5                    \n"
+      "psrad       $16,%%xmm5                    \n"  // ^ div by 16 (2, lo)
 
       "movdqa      %%xmm1,%%xmm0                 \n"
       "movdqa      %%xmm3,%%xmm2                 \n"
@@ -1230,20 +2044,22 @@ void ScaleRowUp2_Bilinear_16_SSE2(const uint16_t* src_ptr,
       "paddd       %%xmm6,%%xmm2                 \n"  // 3*near+far+8 (2, hi)
       "paddd       %%xmm1,%%xmm0                 \n"  // 9*near+3*far (1, hi)
       "paddd       %%xmm2,%%xmm0                 \n"  // 9 3 3 1 + 8 (1, hi)
-      "psrld       $4,%%xmm0                     \n"  // ^ div by 16 (1, hi)
+      "pslld       $12,%%xmm0                    \n"
+      "psrad       $16,%%xmm0                    \n"  // ^ div by 16 (1, hi)
 
       "movdqa      %%xmm3,%%xmm2                 \n"
       "paddd       %%xmm3,%%xmm2                 \n"  // 6*near+2*far (2, hi)
       "paddd       %%xmm6,%%xmm1                 \n"  // 3*near+far+8 (1, hi)
       "paddd       %%xmm3,%%xmm2                 \n"  // 9*near+3*far (2, hi)
       "paddd       %%xmm1,%%xmm2                 \n"  // 9 3 3 1 + 8 (2, hi)
-      "psrld       $4,%%xmm2                     \n"  // ^ div by 16 (2, hi)
+      "pslld       $12,%%xmm2                    \n"
+      "psrad       $16,%%xmm2                    \n"  // ^ div by 16 (2, hi)
 
       "packssdw    %%xmm0,%%xmm4                 \n"
       "pshufd      $0b11011000,%%xmm4,%%xmm4     \n"
       "movdqu      %%xmm4,(%1)                   \n"  // store above
       "packssdw    %%xmm2,%%xmm5                 \n"
-      "pshufd      $0b11011000,%%xmm4,%%xmm4     \n"
+      "pshufd      $0b11011000,%%xmm5,%%xmm5     \n"
       "movdqu      %%xmm5,(%1,%4,2)              \n"  // store below
 
       "lea         0x8(%0),%0                    \n"
@@ -1255,7 +2071,8 @@ void ScaleRowUp2_Bilinear_16_SSE2(const uint16_t* src_ptr,
         "+r"(dst_width)               // %2
       : "r"((intptr_t)(src_stride)),  // %3
         "r"((intptr_t)(dst_stride))   // %4
-      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
 }
 #endif
 
@@ -1819,6 +2636,65 @@ void ScaleAddRow_AVX2(const uint8_t* src_ptr,
 }
 #endif  // HAS_SCALEADDROW_AVX2
 
+#ifdef HAS_SCALEADDROW_16_SSE2
+// Reads 8 shorts and accumulates to 8 ints at a time.
+void ScaleAddRow_16_SSE2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width) {
+  asm volatile(
+      "pxor        %%xmm5,%%xmm5                 \n"
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqu      (%0),%%xmm3                   \n"
+      "lea         0x10(%0),%0                   \n"  // src_ptr += 8
+      "movdqu      (%1),%%xmm0                   \n"
+      "movdqu      0x10(%1),%%xmm1               \n"
+      "movdqa      %%xmm3,%%xmm2                 \n"
+      "punpcklwd   %%xmm5,%%xmm2                 \n"
+      "punpckhwd   %%xmm5,%%xmm3                 \n"
+      "paddd       %%xmm2,%%xmm0                 \n"
+      "paddd       %%xmm3,%%xmm1                 \n"
+      "movdqu      %%xmm0,(%1)                   \n"
+      "movdqu      %%xmm1,0x10(%1)               \n"
+      "lea         0x20(%1),%1                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm5");
+}
+#endif  // HAS_SCALEADDROW_16_SSE2
+
+#ifdef HAS_SCALEADDROW_16_AVX2
+// Reads 16 shorts and accumulates to 16 ints at a time.
+void ScaleAddRow_16_AVX2(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width) {
+  asm volatile(
+      LABELALIGN
+      "1:                                        \n"
+      "vpmovzxwd   (%0),%%ymm2                   \n"
+      "vpmovzxwd   0x10(%0),%%ymm3               \n"
+      "lea         0x20(%0),%0                   \n"  // src_ptr += 16
+      "vpaddd      (%1),%%ymm2,%%ymm0            \n"
+      "vpaddd      0x20(%1),%%ymm3,%%ymm1        \n"
+      "vmovdqu     %%ymm0,(%1)                   \n"
+      "vmovdqu     %%ymm1,0x20(%1)               \n"
+      "lea         0x40(%1),%1                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3");
+}
+#endif  // HAS_SCALEADDROW_16_AVX2
+
 // Constant for making pixels signed to avoid pmaddubsw
 // saturation.
 static const uvec8 kFsub80 = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
@@ -1923,6 +2799,290 @@ void ScaleFilterCols_SSSE3(uint8_t* dst_ptr,
         "xmm7");
 }
 
+// The gathers of the AVX-512 column filters use mask register k1, which can
+// only be named as a clobber when the compiler itself targets AVX-512.
+#if defined(__AVX512F__)
+#define CLOBBER_K1 , "k1"
+#else
+#define CLOBBER_K1
+#endif
+
+#if defined(HAS_SCALEFILTERCOLS_AVX2) ||      \
+    defined(HAS_SCALEARGBFILTERCOLS_AVX2) ||  \
+    defined(HAS_SCALEFILTERCOLS_16_AVX2) ||   \
+    defined(HAS_SCALEUVFILTERCOLS_16_AVX2)
+// 0 to 15, for the x of each lane.
+static const uvec8 kLaneIndex = {0, 1, 2,  3,  4,  5,  6,  7,
+                                 8, 9, 10, 11, 12, 13, 14, 15};
+#endif
+
+#ifdef HAS_SCALEFILTERCOLS_AVX2
+// Bilinear column filtering, 8 pixels at a time.  The 2 source pixels of each
+// destination pixel are gathered as the dword that ends with them, so that no
+// more is read past them than ScaleFilterCols_C reads, or for the first 2
+// source pixels as the first dword of the row.  Same math as the SSSE3
+// version.
+void ScaleFilterCols_AVX2(uint8_t* dst_ptr,
+                          const uint8_t* src_ptr,
+                          int dst_width,
+                          int x,
+                          int dx) {
+  asm volatile(
+      "vmovd       %3,%%xmm2                     \n"
+      "vpbroadcastd %%xmm2,%%ymm2                \n"
+      "vmovd       %4,%%xmm3                     \n"
+      "vpbroadcastd %%xmm3,%%ymm3                \n"
+      "vpmovzxbd   %5,%%ymm0                     \n"
+      "vpmulld     %%ymm0,%%ymm3,%%ymm0          \n"
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"  // x of 8 pixels
+      "vpslld      $0x3,%%ymm3,%%ymm3            \n"  // dx * 8
+      "vpcmpeqb    %%ymm5,%%ymm5,%%ymm5          \n"
+      "vpsrld      $0x1f,%%ymm5,%%ymm6           \n"  // 1
+      "vpslld      $0x1,%%ymm6,%%ymm4            \n"  // 2
+      "vpslld      $0xe,%%ymm6,%%ymm7            \n"
+      "vpslld      $0x6,%%ymm6,%%ymm0            \n"
+      "vpor        %%ymm0,%%ymm7,%%ymm7          \n"  // 0x4040
+      "vpslld      $0x7,%%ymm6,%%ymm6            \n"  // 128
+      "vpabsb      %%ymm5,%%ymm5                 \n"
+      "vpsllw      $0x7,%%ymm5,%%ymm5            \n"  // 0x80 bytes
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrld      $0x10,%%ymm2,%%ymm1           \n"  // xi
+      "vpmaxsd     %%ymm4,%%ymm1,%%ymm0          \n"
+      "vpminsd     %%ymm4,%%ymm1,%%ymm1          \n"
+      "vpcmpeqd    %%ymm8,%%ymm8,%%ymm8          \n"
+      "vpxor       %%ymm9,%%ymm9,%%ymm9          \n"
+      "vpgatherdd  %%ymm8,-0x2(%1,%%ymm0,1),%%ymm9 \n"
+      "vpslld      $0x3,%%ymm1,%%ymm1            \n"
+      "vpsrlvd     %%ymm1,%%ymm9,%%ymm9          \n"  // pixel xi in byte 0
+      "vpxor       %%ymm5,%%ymm9,%%ymm9          \n"  // make pixels signed.
+      "vpslld      $0x10,%%ymm2,%%ymm0           \n"
+      "vpsrld      $0x19,%%ymm0,%%ymm0           \n"  // f = x >> 9 & 127
+      "vpslld      $0x8,%%ymm0,%%ymm1            \n"
+      "vpsubd      %%ymm0,%%ymm1,%%ymm1          \n"
+      "vpaddd      %%ymm6,%%ymm1,%%ymm1          \n"  // 128 - f, f
+      "vpmaddubsw  %%ymm9,%%ymm1,%%ymm1          \n"
+      "vpaddw      %%ymm7,%%ymm1,%%ymm1          \n"  // make pixels unsigned.
+      "vpsrld      $0x7,%%ymm1,%%ymm1            \n"
+      "vpackusdw   %%ymm1,%%ymm1,%%ymm1          \n"
+      "vpackuswb   %%ymm1,%%ymm1,%%ymm1          \n"
+      "vextracti128 $0x1,%%ymm1,%%xmm0           \n"
+      "vpunpckldq  %%xmm0,%%xmm1,%%xmm1          \n"
+      "vmovq       %%xmm1,(%0)                   \n"
+      "vpaddd      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x8(%0),%0                    \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),    // %0
+        "+r"(src_ptr),    // %1
+        "+r"(dst_width)   // %2
+      : "rm"(x),          // %3
+        "rm"(dx),         // %4
+        "m"(kLaneIndex)   // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9");
+}
+#endif  // HAS_SCALEFILTERCOLS_AVX2
+
+#ifdef HAS_SCALEFILTERCOLS_AVX512BW
+// ScaleFilterCols_AVX2 for 16 pixels at a time.
+void ScaleFilterCols_AVX512BW(uint8_t* dst_ptr,
+                              const uint8_t* src_ptr,
+                              int dst_width,
+                              int x,
+                              int dx) {
+  asm volatile(
+      "vpbroadcastd %3,%%zmm2                    \n"
+      "vpbroadcastd %4,%%zmm3                    \n"
+      "vpmovzxbd   %5,%%zmm0                     \n"
+      "vpmulld     %%zmm0,%%zmm3,%%zmm0          \n"
+      "vpaddd      %%zmm0,%%zmm2,%%zmm2          \n"  // x of 16 pixels
+      "vpslld      $0x4,%%zmm3,%%zmm3            \n"  // dx * 16
+      "vpternlogd  $0xff,%%zmm5,%%zmm5,%%zmm5    \n"
+      "vpsrld      $0x1f,%%zmm5,%%zmm6           \n"  // 1
+      "vpslld      $0x1,%%zmm6,%%zmm4            \n"  // 2
+      "vpslld      $0xe,%%zmm6,%%zmm7            \n"
+      "vpslld      $0x6,%%zmm6,%%zmm0            \n"
+      "vpord       %%zmm0,%%zmm7,%%zmm7          \n"  // 0x4040
+      "vpslld      $0x7,%%zmm6,%%zmm6            \n"  // 128
+      "vpabsb      %%zmm5,%%zmm5                 \n"
+      "vpsllw      $0x7,%%zmm5,%%zmm5            \n"  // 0x80 bytes
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrld      $0x10,%%zmm2,%%zmm1           \n"  // xi
+      "vpmaxsd     %%zmm4,%%zmm1,%%zmm0          \n"
+      "vpminsd     %%zmm4,%%zmm1,%%zmm1          \n"
+      "kxnorw      %%k1,%%k1,%%k1                \n"
+      "vpxord      %%zmm9,%%zmm9,%%zmm9          \n"
+      "vpgatherdd  -0x2(%1,%%zmm0,1),%%zmm9%{%%k1%} \n"
+      "vpslld      $0x3,%%zmm1,%%zmm1            \n"
+      "vpsrlvd     %%zmm1,%%zmm9,%%zmm9          \n"  // pixel xi in byte 0
+      "vpxord      %%zmm5,%%zmm9,%%zmm9          \n"  // make pixels signed.
+      "vpslld      $0x10,%%zmm2,%%zmm0           \n"
+      "vpsrld      $0x19,%%zmm0,%%zmm0           \n"  // f = x >> 9 & 127
+      "vpslld      $0x8,%%zmm0,%%zmm1            \n"
+      "vpsubd      %%zmm0,%%zmm1,%%zmm1          \n"
+      "vpaddd      %%zmm6,%%zmm1,%%zmm1          \n"  // 128 - f, f
+      "vpmaddubsw  %%zmm9,%%zmm1,%%zmm1          \n"
+      "vpaddw      %%zmm7,%%zmm1,%%zmm1          \n"  // make pixels unsigned.
+      "vpsrld      $0x7,%%zmm1,%%zmm1            \n"
+      "vpmovdb     %%zmm1,(%0)                   \n"
+      "vpaddd      %%zmm3,%%zmm2,%%zmm2          \n"
+      "lea         0x10(%0),%0                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),    // %0
+        "+r"(src_ptr),    // %1
+        "+r"(dst_width)   // %2
+      : "rm"(x),          // %3
+        "rm"(dx),         // %4
+        "m"(kLaneIndex)   // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm9" CLOBBER_K1);
+}
+#endif  // HAS_SCALEFILTERCOLS_AVX512BW
+
+#ifdef HAS_SCALEFILTERCOLS_16_SSE2
+// Bilinear column filtering for 16 bit pixels, 4 pixels at a time.  Same
+// math as ScaleFilterCols_16_C: a + ((f * (b - a) + 0x8000) >> 16) is the
+// high short of (a << 16) + f * b - f * a + 0x8000, which is less than 2^32.
+// The 2 source pixels of each destination pixel are loaded as one dword.
+void ScaleFilterCols_16_SSE2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx) {
+  intptr_t x0;
+  asm volatile(
+      "movd        %4,%%xmm2                     \n"
+      "pshufd      $0x0,%%xmm2,%%xmm2            \n"
+      "movd        %5,%%xmm3                     \n"
+      "pshufd      $0x0,%%xmm3,%%xmm3            \n"
+      "movdqa      %%xmm3,%%xmm0                 \n"
+      "pslldq      $0x4,%%xmm0                   \n"  // 0, dx, dx, dx
+      "movdqa      %%xmm0,%%xmm1                 \n"
+      "pslldq      $0x4,%%xmm1                   \n"  // 0, 0, dx, dx
+      "paddd       %%xmm1,%%xmm0                 \n"
+      "pslldq      $0x4,%%xmm1                   \n"  // 0, 0, 0, dx
+      "paddd       %%xmm1,%%xmm0                 \n"
+      "paddd       %%xmm0,%%xmm2                 \n"  // x of 4 pixels
+      "pslld       $0x2,%%xmm3                   \n"  // dx * 4
+      "pcmpeqb     %%xmm7,%%xmm7                 \n"
+      "psrld       $0x1f,%%xmm7                  \n"
+      "pslld       $0xf,%%xmm7                   \n"  // 0x8000
+
+      LABELALIGN
+      "1:                                        \n"
+      "pextrw      $0x1,%%xmm2,%k3               \n"
+      "movd        0x00(%1,%3,2),%%xmm0          \n"
+      "pextrw      $0x3,%%xmm2,%k3               \n"
+      "movd        0x00(%1,%3,2),%%xmm1          \n"
+      "punpckldq   %%xmm1,%%xmm0                 \n"
+      "pextrw      $0x5,%%xmm2,%k3               \n"
+      "movd        0x00(%1,%3,2),%%xmm1          \n"
+      "pextrw      $0x7,%%xmm2,%k3               \n"
+      "movd        0x00(%1,%3,2),%%xmm4          \n"
+      "punpckldq   %%xmm4,%%xmm1                 \n"
+      "punpcklqdq  %%xmm1,%%xmm0                 \n"  // a | b << 16
+      "pshuflw     $0xa0,%%xmm2,%%xmm1           \n"
+      "pshufhw     $0xa0,%%xmm1,%%xmm1           \n"  // f, f
+      "movdqa      %%xmm0,%%xmm4                 \n"
+      "movdqa      %%xmm0,%%xmm5                 \n"
+      "pmullw      %%xmm1,%%xmm4                 \n"
+      "pmulhuw     %%xmm1,%%xmm5                 \n"
+      "movdqa      %%xmm4,%%xmm1                 \n"
+      "punpcklwd   %%xmm5,%%xmm4                 \n"
+      "punpckhwd   %%xmm5,%%xmm1                 \n"
+      "movdqa      %%xmm4,%%xmm5                 \n"
+      "shufps      $0x88,%%xmm1,%%xmm4           \n"  // f * a
+      "shufps      $0xdd,%%xmm1,%%xmm5           \n"  // f * b
+      "pslld       $0x10,%%xmm0                  \n"  // a << 16
+      "paddd       %%xmm5,%%xmm0                 \n"
+      "psubd       %%xmm4,%%xmm0                 \n"
+      "paddd       %%xmm7,%%xmm0                 \n"
+      "psrad       $0x10,%%xmm0                  \n"
+      "packssdw    %%xmm0,%%xmm0                 \n"
+      "movq        %%xmm0,(%0)                   \n"
+      "paddd       %%xmm3,%%xmm2                 \n"
+      "lea         0x8(%0),%0                    \n"
+      "subl        $0x4,%2                       \n"
+      "jg          1b                            \n"
+      : "+r"(dst_ptr),  // %0
+        "+r"(src_ptr),  // %1
+#if defined(__x86_64__)
+        "+rm"(dst_width),  // %2
+#else
+        "+m"(dst_width),  // %2
+#endif
+        "=&r"(x0)  // %3
+      : "rm"(x),   // %4
+        "rm"(dx)   // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm7");
+}
+#endif  // HAS_SCALEFILTERCOLS_16_SSE2
+
+#ifdef HAS_SCALEFILTERCOLS_16_AVX2
+// Bilinear column filtering for 16 bit pixels, 8 pixels at a time.  Same
+// math as the SSE2 version, with the 2 source pixels of each destination
+// pixel gathered as a dword.
+void ScaleFilterCols_16_AVX2(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx) {
+  asm volatile(
+      "vmovd       %3,%%xmm2                     \n"
+      "vpbroadcastd %%xmm2,%%ymm2                \n"
+      "vmovd       %4,%%xmm3                     \n"
+      "vpbroadcastd %%xmm3,%%ymm3                \n"
+      "vpmovzxbd   %5,%%ymm0                     \n"
+      "vpmulld     %%ymm0,%%ymm3,%%ymm0          \n"
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"  // x of 8 pixels
+      "vpslld      $0x3,%%ymm3,%%ymm3            \n"  // dx * 8
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1f,%%ymm6,%%ymm7           \n"
+      "vpslld      $0xf,%%ymm7,%%ymm7            \n"  // 0x8000
+      "vpsrld      $0x10,%%ymm6,%%ymm6           \n"  // 0xffff
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrad      $0x10,%%ymm2,%%ymm1           \n"  // xi
+      "vpcmpeqd    %%ymm5,%%ymm5,%%ymm5          \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpgatherdd  %%ymm5,(%1,%%ymm1,2),%%ymm0   \n"  // a | b << 16
+      "vpand       %%ymm6,%%ymm2,%%ymm4          \n"  // f
+      "vpand       %%ymm6,%%ymm0,%%ymm5          \n"  // a
+      "vpsrld      $0x10,%%ymm0,%%ymm1           \n"  // b
+      "vpsubd      %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpmulld     %%ymm4,%%ymm1,%%ymm1          \n"  // f * (b - a)
+      "vpslld      $0x10,%%ymm0,%%ymm0           \n"  // a << 16
+      "vpaddd      %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpaddd      %%ymm7,%%ymm0,%%ymm0          \n"
+      "vpsrld      $0x10,%%ymm0,%%ymm0           \n"
+      "vpackusdw   %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpermq      $0x8,%%ymm0,%%ymm0            \n"
+      "vmovdqu     %%xmm0,(%0)                   \n"
+      "vpaddd      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x10(%0),%0                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),    // %0
+        "+r"(src_ptr),    // %1
+        "+r"(dst_width)   // %2
+      : "rm"(x),          // %3
+        "rm"(dx),         // %4
+        "m"(kLaneIndex)   // %5
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEFILTERCOLS_16_AVX2
+
 // Reads 4 pixels, duplicates them and writes 8 pixels.
 // Alignment requirement: src_argb 16 byte aligned, dst_argb 16 byte aligned.
 void ScaleColsUp2_SSE2(uint8_t* dst_ptr,
@@ -2296,6 +3456,225 @@ void ScaleARGBFilterCols_SSSE3(uint8_t* dst_argb,
       : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6");
 }
 
+#ifdef HAS_SCALEARGBFILTERCOLS_AVX2
+// Shuffle table for duplicating the fractions of 2 pixels, from dwords 0 and 2.
+static const uvec8 kShuffleFractionsQ = {
+    0u, 0u, 0u, 0u, 0u, 0u, 0u, 0u, 8u, 8u, 8u, 8u, 8u, 8u, 8u, 8u,
+};
+
+// Bilinear row filtering combines 4x2 -> 4x1, 8 pixels at a time.  Each pair
+// of source pixels is gathered as a qword.
+void ScaleARGBFilterCols_AVX2(uint8_t* dst_argb,
+                              const uint8_t* src_argb,
+                              int dst_width,
+                              int x,
+                              int dx) {
+  asm volatile(
+      "vmovd       %3,%%xmm2                     \n"
+      "vpbroadcastd %%xmm2,%%ymm2                \n"
+      "vmovd       %4,%%xmm3                     \n"
+      "vpbroadcastd %%xmm3,%%ymm3                \n"
+      "vpmovzxbd   %5,%%ymm0                     \n"
+      "vpmulld     %%ymm0,%%ymm3,%%ymm0          \n"
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"  // x of 8 pixels
+      "vpslld      $0x3,%%ymm3,%%ymm3            \n"  // dx * 8
+      "vbroadcasti128 %6,%%ymm4                  \n"
+      "vbroadcasti128 %7,%%ymm5                  \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrlw      $0x9,%%ymm6,%%ymm6            \n"  // 0x007f007f
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrld      $0x10,%%ymm2,%%ymm1           \n"  // xi
+      "vpcmpeqd    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpgatherdq  %%ymm7,(%1,%%xmm1,4),%%ymm0   \n"  // pixels 0 to 3
+      "vextracti128 $0x1,%%ymm1,%%xmm1           \n"
+      "vpcmpeqd    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpxor       %%ymm8,%%ymm8,%%ymm8          \n"
+      "vpgatherdq  %%ymm7,(%1,%%xmm1,4),%%ymm8   \n"  // pixels 4 to 7
+      "vpsrlw      $0x9,%%ymm2,%%ymm1            \n"
+      "vpmovzxdq   %%xmm1,%%ymm9                 \n"
+      "vextracti128 $0x1,%%ymm1,%%xmm1           \n"
+      "vpmovzxdq   %%xmm1,%%ymm1                 \n"
+      "vpshufb     %%ymm5,%%ymm9,%%ymm9          \n"
+      "vpshufb     %%ymm5,%%ymm1,%%ymm1          \n"
+      "vpxor       %%ymm6,%%ymm9,%%ymm9          \n"
+      "vpxor       %%ymm6,%%ymm1,%%ymm1          \n"
+      "vpshufb     %%ymm4,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm4,%%ymm8,%%ymm8          \n"
+      "vpmaddubsw  %%ymm9,%%ymm0,%%ymm0          \n"
+      "vpmaddubsw  %%ymm1,%%ymm8,%%ymm8          \n"
+      "vpsrlw      $0x7,%%ymm0,%%ymm0            \n"
+      "vpsrlw      $0x7,%%ymm8,%%ymm8            \n"
+      "vpackuswb   %%ymm8,%%ymm0,%%ymm0          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%0)                   \n"
+      "vpaddd      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x20(%0),%0                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_argb),          // %0
+        "+r"(src_argb),          // %1
+        "+r"(dst_width)          // %2
+      : "rm"(x),                 // %3
+        "rm"(dx),                // %4
+        "m"(kLaneIndex),         // %5
+        "m"(kShuffleColARGB),    // %6
+        "m"(kShuffleFractionsQ)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9");
+}
+#endif  // HAS_SCALEARGBFILTERCOLS_AVX2
+
+#ifdef HAS_SCALEARGBFILTERCOLS_AVX512BW
+// ScaleARGBFilterCols_AVX2 for 16 pixels at a time.
+void ScaleARGBFilterCols_AVX512BW(uint8_t* dst_argb,
+                                  const uint8_t* src_argb,
+                                  int dst_width,
+                                  int x,
+                                  int dx) {
+  asm volatile(
+      "vpbroadcastd %3,%%zmm2                    \n"
+      "vpbroadcastd %4,%%zmm3                    \n"
+      "vpmovzxbd   %5,%%zmm0                     \n"
+      "vpmulld     %%zmm0,%%zmm3,%%zmm0          \n"
+      "vpaddd      %%zmm0,%%zmm2,%%zmm2          \n"  // x of 16 pixels
+      "vpslld      $0x4,%%zmm3,%%zmm3            \n"  // dx * 16
+      "vbroadcasti32x4 %6,%%zmm4                 \n"
+      "vbroadcasti32x4 %7,%%zmm5                 \n"
+      "vpternlogd  $0xff,%%zmm6,%%zmm6,%%zmm6    \n"
+      "vpsrlw      $0x9,%%zmm6,%%zmm6            \n"  // 0x007f007f
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrld      $0x10,%%zmm2,%%zmm1           \n"  // xi
+      "kxnorw      %%k1,%%k1,%%k1                \n"
+      "vpxord      %%zmm0,%%zmm0,%%zmm0          \n"
+      "vpgatherdq  (%1,%%ymm1,4),%%zmm0%{%%k1%}  \n"  // pixels 0 to 7
+      "vextracti64x4 $0x1,%%zmm1,%%ymm1          \n"
+      "kxnorw      %%k1,%%k1,%%k1                \n"
+      "vpxord      %%zmm8,%%zmm8,%%zmm8          \n"
+      "vpgatherdq  (%1,%%ymm1,4),%%zmm8%{%%k1%}  \n"  // pixels 8 to 15
+      "vpsrlw      $0x9,%%zmm2,%%zmm1            \n"
+      "vpmovzxdq   %%ymm1,%%zmm9                 \n"
+      "vextracti64x4 $0x1,%%zmm1,%%ymm1          \n"
+      "vpmovzxdq   %%ymm1,%%zmm1                 \n"
+      "vpshufb     %%zmm5,%%zmm9,%%zmm9          \n"
+      "vpshufb     %%zmm5,%%zmm1,%%zmm1          \n"
+      "vpxord      %%zmm6,%%zmm9,%%zmm9          \n"
+      "vpxord      %%zmm6,%%zmm1,%%zmm1          \n"
+      "vpshufb     %%zmm4,%%zmm0,%%zmm0          \n"
+      "vpshufb     %%zmm4,%%zmm8,%%zmm8          \n"
+      "vpmaddubsw  %%zmm9,%%zmm0,%%zmm0          \n"
+      "vpmaddubsw  %%zmm1,%%zmm8,%%zmm8          \n"
+      "vpsrlw      $0x7,%%zmm0,%%zmm0            \n"
+      "vpsrlw      $0x7,%%zmm8,%%zmm8            \n"
+      "vpmovwb     %%zmm0,(%0)                   \n"
+      "vpmovwb     %%zmm8,0x20(%0)               \n"
+      "vpaddd      %%zmm3,%%zmm2,%%zmm2          \n"
+      "lea         0x40(%0),%0                   \n"
+      "sub         $0x10,%2                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_argb),          // %0
+        "+r"(src_argb),          // %1
+        "+r"(dst_width)          // %2
+      : "rm"(x),                 // %3
+        "rm"(dx),                // %4
+        "m"(kLaneIndex),         // %5
+        "m"(kShuffleColARGB),    // %6
+        "m"(kShuffleFractionsQ)  // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm8", "xmm9" CLOBBER_K1);
+}
+#endif  // HAS_SCALEARGBFILTERCOLS_AVX512BW
+
+#ifdef HAS_SCALEUVFILTERCOLS_16_AVX2
+// Shuffle tables for the first and second UV of a qword into dwords.
+static const uvec8 kShuffleUV16A = {0u, 1u, 128u, 128u, 2u,  3u,  128u, 128u,
+                                    8u, 9u, 128u, 128u, 10u, 11u, 128u, 128u};
+static const uvec8 kShuffleUV16B = {4u,  5u,  128u, 128u, 6u,  7u,  128u, 128u,
+                                    12u, 13u, 128u, 128u, 14u, 15u, 128u, 128u};
+
+// Bilinear column filtering for 16 bit UV, 8 UV pixels at a time.  Each pair
+// of source UV pixels is gathered as a qword.  Same math as
+// ScaleFilterCols_16_AVX2.
+void ScaleUVFilterCols_16_AVX2(uint16_t* dst_uv,
+                               const uint16_t* src_uv,
+                               int dst_width,
+                               int x,
+                               int dx) {
+  asm volatile(
+      "vmovd       %3,%%xmm2                     \n"
+      "vpbroadcastd %%xmm2,%%ymm2                \n"
+      "vmovd       %4,%%xmm3                     \n"
+      "vpbroadcastd %%xmm3,%%ymm3                \n"
+      "vpmovzxbd   %5,%%ymm0                     \n"
+      "vpmulld     %%ymm0,%%ymm3,%%ymm0          \n"
+      "vpaddd      %%ymm0,%%ymm2,%%ymm2          \n"  // x of 8 pixels
+      "vpslld      $0x3,%%ymm3,%%ymm3            \n"  // dx * 8
+      "vbroadcasti128 %6,%%ymm4                  \n"
+      "vbroadcasti128 %7,%%ymm5                  \n"
+      "vpcmpeqb    %%ymm6,%%ymm6,%%ymm6          \n"
+      "vpsrld      $0x1f,%%ymm6,%%ymm10          \n"
+      "vpslld      $0xf,%%ymm10,%%ymm10          \n"  // 0x8000
+      "vpsrld      $0x10,%%ymm6,%%ymm6           \n"  // 0xffff
+
+      LABELALIGN
+      "1:                                        \n"
+      "vpsrad      $0x10,%%ymm2,%%ymm1           \n"  // xi
+      "vpcmpeqd    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpgatherdq  %%ymm7,(%1,%%xmm1,4),%%ymm0   \n"  // pixels 0 to 3
+      "vextracti128 $0x1,%%ymm1,%%xmm1           \n"
+      "vpcmpeqd    %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpxor       %%ymm8,%%ymm8,%%ymm8          \n"
+      "vpgatherdq  %%ymm7,(%1,%%xmm1,4),%%ymm8   \n"  // pixels 4 to 7
+      "vpand       %%ymm6,%%ymm2,%%ymm1          \n"  // f
+      "vpmovzxdq   %%xmm1,%%ymm9                 \n"
+      "vextracti128 $0x1,%%ymm1,%%xmm1           \n"
+      "vpmovzxdq   %%xmm1,%%ymm1                 \n"
+      "vpshufd     $0xa0,%%ymm9,%%ymm9           \n"  // f of pixels 0 to 3
+      "vpshufd     $0xa0,%%ymm1,%%ymm1           \n"  // f of pixels 4 to 7
+      "vpshufb     %%ymm4,%%ymm0,%%ymm7          \n"  // a
+      "vpshufb     %%ymm5,%%ymm0,%%ymm0          \n"  // b
+      "vpsubd      %%ymm7,%%ymm0,%%ymm0          \n"
+      "vpmulld     %%ymm9,%%ymm0,%%ymm0          \n"  // f * (b - a)
+      "vpslld      $0x10,%%ymm7,%%ymm7           \n"  // a << 16
+      "vpaddd      %%ymm7,%%ymm0,%%ymm0          \n"
+      "vpshufb     %%ymm4,%%ymm8,%%ymm9          \n"
+      "vpshufb     %%ymm5,%%ymm8,%%ymm8          \n"
+      "vpsubd      %%ymm9,%%ymm8,%%ymm8          \n"
+      "vpmulld     %%ymm1,%%ymm8,%%ymm8          \n"
+      "vpslld      $0x10,%%ymm9,%%ymm9           \n"
+      "vpaddd      %%ymm9,%%ymm8,%%ymm8          \n"
+      "vpaddd      %%ymm10,%%ymm0,%%ymm0         \n"
+      "vpaddd      %%ymm10,%%ymm8,%%ymm8         \n"
+      "vpsrld      $0x10,%%ymm0,%%ymm0           \n"
+      "vpsrld      $0x10,%%ymm8,%%ymm8           \n"
+      "vpackusdw   %%ymm8,%%ymm0,%%ymm0          \n"
+      "vpermq      $0xd8,%%ymm0,%%ymm0           \n"
+      "vmovdqu     %%ymm0,(%0)                   \n"
+      "vpaddd      %%ymm3,%%ymm2,%%ymm2          \n"
+      "lea         0x20(%0),%0                   \n"
+      "sub         $0x8,%2                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_uv),          // %0
+        "+r"(src_uv),          // %1
+        "+r"(dst_width)        // %2
+      : "rm"(x),               // %3
+        "rm"(dx),              // %4
+        "m"(kLaneIndex),       // %5
+        "m"(kShuffleUV16A),    // %6
+        "m"(kShuffleUV16B)     // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7", "xmm8", "xmm9", "xmm10");
+}
+#endif  // HAS_SCALEUVFILTERCOLS_16_AVX2
+
 // Divide num by div and return as 16.16 fixed point result.
 int FixedDiv_X86(int num, int div) {
   asm volatile(
@@ -2940,6 +4319,521 @@ void ScaleUVRowUp2_Bilinear_16_AVX2(const uint16_t* src_ptr,
 }
 #endif
 
+#ifdef HAS_SCALEROWPOLYPHASEH_SSSE3
+// Filter 8 pixels at a time.  4 taps of each pixel are loaded with movd and
+// the products of pairs of taps are added with phaddd.
+void ScaleRowPolyphaseH_SSSE3(const uint8_t* src_ptr,
+                              int16_t* dst_ptr,
+                              const int16_t* coeffs,
+                              const int* starts,
+                              int dst_width,
+                              int taps) {
+  const uint8_t* src_tap;
+  intptr_t tap_count;
+  intptr_t start;
+  asm volatile(
+      "pxor        %%xmm7,%%xmm7                 \n"
+      "pcmpeqb     %%xmm4,%%xmm4                 \n"
+      "psrld       $0x1f,%%xmm4                  \n"
+      "pslld       $0x7,%%xmm4                   \n"  // 128 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "pxor        %%xmm5,%%xmm5                 \n"
+      "pxor        %%xmm6,%%xmm6                 \n"
+      "mov         %7,%4                         \n"
+      "mov         %8,%5                         \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movslq      (%2),%6                       \n"
+      "movd        (%4,%6),%%xmm0                \n"
+      "movslq      0x4(%2),%6                    \n"
+      "movd        (%4,%6),%%xmm1                \n"
+      "punpckldq   %%xmm1,%%xmm0                 \n"
+      "movslq      0x10(%2),%6                   \n"
+      "movd        (%4,%6),%%xmm1                \n"
+      "movslq      0x14(%2),%6                   \n"
+      "movd        (%4,%6),%%xmm2                \n"
+      "punpckldq   %%xmm2,%%xmm1                 \n"
+      "punpcklqdq  %%xmm1,%%xmm0                 \n"  // p0 p1 p4 p5
+      "movslq      0x8(%2),%6                    \n"
+      "movd        (%4,%6),%%xmm1                \n"
+      "movslq      0xc(%2),%6                    \n"
+      "movd        (%4,%6),%%xmm2                \n"
+      "punpckldq   %%xmm2,%%xmm1                 \n"
+      "movslq      0x18(%2),%6                   \n"
+      "movd        (%4,%6),%%xmm2                \n"
+      "movslq      0x1c(%2),%6                   \n"
+      "movd        (%4,%6),%%xmm3                \n"
+      "punpckldq   %%xmm3,%%xmm2                 \n"
+      "punpcklqdq  %%xmm2,%%xmm1                 \n"  // p2 p3 p6 p7
+      "movdqa      %%xmm0,%%xmm2                 \n"
+      "punpcklbw   %%xmm7,%%xmm0                 \n"
+      "punpckhbw   %%xmm7,%%xmm2                 \n"
+      "movdqa      %%xmm1,%%xmm3                 \n"
+      "punpcklbw   %%xmm7,%%xmm1                 \n"
+      "punpckhbw   %%xmm7,%%xmm3                 \n"
+      "pmaddwd     (%1),%%xmm0                   \n"
+      "pmaddwd     0x10(%1),%%xmm2               \n"
+      "pmaddwd     0x20(%1),%%xmm1               \n"
+      "pmaddwd     0x30(%1),%%xmm3               \n"
+      "phaddd      %%xmm1,%%xmm0                 \n"  // p0 p1 p2 p3
+      "phaddd      %%xmm3,%%xmm2                 \n"  // p4 p5 p6 p7
+      "paddd       %%xmm0,%%xmm5                 \n"
+      "paddd       %%xmm2,%%xmm6                 \n"
+      "add         $0x40,%1                      \n"
+      "add         $0x4,%4                       \n"
+      "sub         $0x4,%5                       \n"
+      "jg          2b                            \n"
+
+      "paddd       %%xmm4,%%xmm5                 \n"
+      "paddd       %%xmm4,%%xmm6                 \n"
+      "psrad       $0x8,%%xmm5                   \n"
+      "psrad       $0x8,%%xmm6                   \n"
+      "packssdw    %%xmm6,%%xmm5                 \n"
+      "movdqu      %%xmm5,(%0)                   \n"
+      "add         $0x20,%2                      \n"
+      "add         $0x10,%0                      \n"
+      "sub         $0x8,%3                       \n"
+      "jg          1b                            \n"
+      : "+r"(dst_ptr),          // %0
+        "+r"(coeffs),           // %1
+        "+r"(starts),           // %2
+        "+r"(dst_width),        // %3
+        "=&r"(src_tap),         // %4
+        "=&r"(tap_count),       // %5
+        "=&r"(start)            // %6
+      : "r"(src_ptr),           // %7
+        "r"((intptr_t)(taps))   // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEROWPOLYPHASEH_SSSE3
+
+#ifdef HAS_SCALEROWPOLYPHASEH_AVX2
+// Filter 8 pixels at a time, gathering 4 taps of each pixel.
+void ScaleRowPolyphaseH_AVX2(const uint8_t* src_ptr,
+                             int16_t* dst_ptr,
+                             const int16_t* coeffs,
+                             const int* starts,
+                             int dst_width,
+                             int taps) {
+  const uint8_t* src_tap;
+  intptr_t tap_count;
+  asm volatile(
+      "vpxor       %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpcmpeqb    %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpsrld      $0x1f,%%ymm4,%%ymm4           \n"
+      "vpslld      $0x7,%%ymm4,%%ymm4            \n"  // 128 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqu     (%2),%%ymm6                   \n"  // starts of 8 pixels
+      "vpxor       %%ymm5,%%ymm5,%%ymm5          \n"
+      "mov         %6,%4                         \n"
+      "mov         %7,%5                         \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "vpcmpeqd    %%ymm3,%%ymm3,%%ymm3          \n"
+      "vpxor       %%ymm0,%%ymm0,%%ymm0          \n"
+      "vpgatherdd  %%ymm3,(%4,%%ymm6,1),%%ymm0   \n"
+      "vpunpckhbw  %%ymm7,%%ymm0,%%ymm1          \n"  // p2 p3 | p6 p7
+      "vpunpcklbw  %%ymm7,%%ymm0,%%ymm0          \n"  // p0 p1 | p4 p5
+      "vpmaddwd    (%1),%%ymm0,%%ymm0            \n"
+      "vpmaddwd    0x20(%1),%%ymm1,%%ymm1        \n"
+      "vphaddd     %%ymm1,%%ymm0,%%ymm0          \n"  // p0 p1 p2 p3 | p4..p7
+      "vpaddd      %%ymm0,%%ymm5,%%ymm5          \n"
+      "add         $0x40,%1                      \n"
+      "add         $0x4,%4                       \n"
+      "sub         $0x4,%5                       \n"
+      "jg          2b                            \n"
+
+      "vpaddd      %%ymm4,%%ymm5,%%ymm5          \n"
+      "vpsrad      $0x8,%%ymm5,%%ymm5            \n"
+      "vextracti128 $0x1,%%ymm5,%%xmm1           \n"
+      "vpackssdw   %%xmm1,%%xmm5,%%xmm5          \n"
+      "vmovdqu     %%xmm5,(%0)                   \n"
+      "add         $0x20,%2                      \n"
+      "add         $0x10,%0                      \n"
+      "sub         $0x8,%3                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),          // %0
+        "+r"(coeffs),           // %1
+        "+r"(starts),           // %2
+        "+r"(dst_width),        // %3
+        "=&r"(src_tap),         // %4
+        "=&r"(tap_count)        // %5
+      : "r"(src_ptr),           // %6
+        "r"((intptr_t)(taps))   // %7
+      : "memory", "cc", "xmm0", "xmm1", "xmm3", "xmm4", "xmm5", "xmm6",
+        "xmm7");
+}
+#endif  // HAS_SCALEROWPOLYPHASEH_AVX2
+
+#ifdef HAS_SCALEUVROWPOLYPHASEH_SSSE3
+// Shuffle UVUVUVUV to UUVVUUVV.
+static const uvec8 kShuffleUVPolyphase = {0,   2,   1,   3,   4,   6,
+                                          5,   7,   128, 128, 128, 128,
+                                          128, 128, 128, 128};
+
+// Filter 1 UV pixel at a time, 4 taps at a time.
+void ScaleUVRowPolyphaseH_SSSE3(const uint8_t* src_uv,
+                                int16_t* dst_ptr,
+                                const int16_t* coeffs,
+                                const int* starts,
+                                int dst_width,
+                                int taps) {
+  const uint8_t* src_tap;
+  intptr_t tap_count;
+  intptr_t start;
+  asm volatile(
+      "movdqa      %9,%%xmm6                     \n"
+      "pxor        %%xmm7,%%xmm7                 \n"
+      "pcmpeqb     %%xmm4,%%xmm4                 \n"
+      "psrld       $0x1f,%%xmm4                  \n"
+      "pslld       $0x7,%%xmm4                   \n"  // 128 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "movslq      (%2),%6                       \n"
+      "lea         (%7,%6,2),%4                  \n"
+      "mov         %8,%5                         \n"
+      "pxor        %%xmm5,%%xmm5                 \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movq        (%4),%%xmm0                   \n"
+      "pshufb      %%xmm6,%%xmm0                 \n"
+      "punpcklbw   %%xmm7,%%xmm0                 \n"  // U0 U1 V0 V1 U2 U3 V2 V3
+      "movq        (%1),%%xmm1                   \n"
+      "pshufd      $0x50,%%xmm1,%%xmm1           \n"  // C0 C1 C0 C1 C2 C3 C2 C3
+      "pmaddwd     %%xmm1,%%xmm0                 \n"
+      "paddd       %%xmm0,%%xmm5                 \n"
+      "add         $0x8,%1                       \n"
+      "add         $0x8,%4                       \n"
+      "sub         $0x4,%5                       \n"
+      "jg          2b                            \n"
+
+      "pshufd      $0x4e,%%xmm5,%%xmm0           \n"
+      "paddd       %%xmm0,%%xmm5                 \n"
+      "paddd       %%xmm4,%%xmm5                 \n"
+      "psrad       $0x8,%%xmm5                   \n"
+      "packssdw    %%xmm5,%%xmm5                 \n"
+      "movd        %%xmm5,(%0)                   \n"
+      "add         $0x4,%2                       \n"
+      "add         $0x4,%0                       \n"
+      "sub         $0x1,%3                       \n"
+      "jg          1b                            \n"
+      : "+r"(dst_ptr),             // %0
+        "+r"(coeffs),              // %1
+        "+r"(starts),              // %2
+        "+r"(dst_width),           // %3
+        "=&r"(src_tap),            // %4
+        "=&r"(tap_count),          // %5
+        "=&r"(start)               // %6
+      : "r"(src_uv),               // %7
+        "r"((intptr_t)(taps)),     // %8
+        "m"(kShuffleUVPolyphase)   // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm4", "xmm5", "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEUVROWPOLYPHASEH_SSSE3
+
+#if defined(HAS_SCALEARGBROWPOLYPHASEH_SSSE3) || \
+    defined(HAS_SCALEARGBROWPOLYPHASEH_AVX2)
+// Shuffle 4 ARGB pixels to BBGGRRAA of pixels 0 and 1, then of 2 and 3.
+static const uvec8 kShuffleARGBPolyphase = {0, 4,  1, 5,  2,  6,  3,  7,
+                                            8, 12, 9, 13, 10, 14, 11, 15};
+#endif
+
+#ifdef HAS_SCALEARGBROWPOLYPHASEH_SSSE3
+// Filter 1 ARGB pixel at a time, 4 taps at a time.
+void ScaleARGBRowPolyphaseH_SSSE3(const uint8_t* src_argb,
+                                  int16_t* dst_ptr,
+                                  const int16_t* coeffs,
+                                  const int* starts,
+                                  int dst_width,
+                                  int taps) {
+  const uint8_t* src_tap;
+  intptr_t tap_count;
+  intptr_t start;
+  asm volatile(
+      "movdqa      %9,%%xmm6                     \n"
+      "pxor        %%xmm7,%%xmm7                 \n"
+      "pcmpeqb     %%xmm4,%%xmm4                 \n"
+      "psrld       $0x1f,%%xmm4                  \n"
+      "pslld       $0x7,%%xmm4                   \n"  // 128 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "movslq      (%2),%6                       \n"
+      "lea         (%7,%6,4),%4                  \n"
+      "mov         %8,%5                         \n"
+      "pxor        %%xmm5,%%xmm5                 \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "movdqu      (%4),%%xmm0                   \n"
+      "pshufb      %%xmm6,%%xmm0                 \n"
+      "movdqa      %%xmm0,%%xmm1                 \n"
+      "punpcklbw   %%xmm7,%%xmm0                 \n"  // B0 B1 G0 G1 R0 R1 A0 A1
+      "punpckhbw   %%xmm7,%%xmm1                 \n"  // B2 B3 G2 G3 R2 R3 A2 A3
+      "movq        (%1),%%xmm2                   \n"
+      "pshufd      $0x0,%%xmm2,%%xmm3            \n"  // C0 C1
+      "pshufd      $0x55,%%xmm2,%%xmm2           \n"  // C2 C3
+      "pmaddwd     %%xmm3,%%xmm0                 \n"
+      "pmaddwd     %%xmm2,%%xmm1                 \n"
+      "paddd       %%xmm0,%%xmm5                 \n"
+      "paddd       %%xmm1,%%xmm5                 \n"
+      "add         $0x8,%1                       \n"
+      "add         $0x10,%4                      \n"
+      "sub         $0x4,%5                       \n"
+      "jg          2b                            \n"
+
+      "paddd       %%xmm4,%%xmm5                 \n"
+      "psrad       $0x8,%%xmm5                   \n"
+      "packssdw    %%xmm5,%%xmm5                 \n"
+      "movq        %%xmm5,(%0)                   \n"
+      "add         $0x4,%2                       \n"
+      "add         $0x8,%0                       \n"
+      "sub         $0x1,%3                       \n"
+      "jg          1b                            \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(coeffs),                // %1
+        "+r"(starts),                // %2
+        "+r"(dst_width),             // %3
+        "=&r"(src_tap),              // %4
+        "=&r"(tap_count),            // %5
+        "=&r"(start)                 // %6
+      : "r"(src_argb),               // %7
+        "r"((intptr_t)(taps)),       // %8
+        "m"(kShuffleARGBPolyphase)   // %9
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEARGBROWPOLYPHASEH_SSSE3
+
+#ifdef HAS_SCALEARGBROWPOLYPHASEH_AVX2
+// Filter 2 ARGB pixels at a time, one in each lane.
+void ScaleARGBRowPolyphaseH_AVX2(const uint8_t* src_argb,
+                                 int16_t* dst_ptr,
+                                 const int16_t* coeffs,
+                                 const int* starts,
+                                 int dst_width,
+                                 int taps) {
+  const uint8_t* src_tap0;
+  const uint8_t* src_tap1;
+  intptr_t tap_count;
+  intptr_t start;
+  asm volatile(
+      "vbroadcastf128 %10,%%ymm6                 \n"
+      "vpxor       %%ymm7,%%ymm7,%%ymm7          \n"
+      "vpcmpeqb    %%ymm4,%%ymm4,%%ymm4          \n"
+      "vpsrld      $0x1f,%%ymm4,%%ymm4           \n"
+      "vpslld      $0x7,%%ymm4,%%ymm4            \n"  // 128 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "movslq      (%2),%7                       \n"
+      "lea         (%8,%7,4),%4                  \n"
+      "movslq      0x4(%2),%7                    \n"
+      "lea         (%8,%7,4),%5                  \n"
+      "mov         %9,%6                         \n"
+      "vpxor       %%ymm5,%%ymm5,%%ymm5          \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "vmovdqu     (%4),%%xmm0                   \n"
+      "vinserti128 $0x1,(%5),%%ymm0,%%ymm0       \n"
+      "vpshufb     %%ymm6,%%ymm0,%%ymm0          \n"
+      "vpunpckhbw  %%ymm7,%%ymm0,%%ymm1          \n"
+      "vpunpcklbw  %%ymm7,%%ymm0,%%ymm0          \n"
+      "vmovq       (%1),%%xmm2                   \n"
+      "vmovq       (%1,%9,2),%%xmm3              \n"
+      "vinserti128 $0x1,%%xmm3,%%ymm2,%%ymm2     \n"
+      "vpshufd     $0x0,%%ymm2,%%ymm3            \n"  // C0 C1
+      "vpshufd     $0x55,%%ymm2,%%ymm2           \n"  // C2 C3
+      "vpmaddwd    %%ymm3,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm2,%%ymm1,%%ymm1          \n"
+      "vpaddd      %%ymm0,%%ymm5,%%ymm5          \n"
+      "vpaddd      %%ymm1,%%ymm5,%%ymm5          \n"
+      "add         $0x8,%1                       \n"
+      "add         $0x10,%4                      \n"
+      "add         $0x10,%5                      \n"
+      "sub         $0x4,%6                       \n"
+      "jg          2b                            \n"
+
+      "lea         (%1,%9,2),%1                  \n"  // skip second pixel
+      "vpaddd      %%ymm4,%%ymm5,%%ymm5          \n"
+      "vpsrad      $0x8,%%ymm5,%%ymm5            \n"
+      "vextracti128 $0x1,%%ymm5,%%xmm1           \n"
+      "vpackssdw   %%xmm1,%%xmm5,%%xmm5          \n"
+      "vmovdqu     %%xmm5,(%0)                   \n"
+      "add         $0x8,%2                       \n"
+      "add         $0x10,%0                      \n"
+      "sub         $0x2,%3                       \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),               // %0
+        "+r"(coeffs),                // %1
+        "+r"(starts),                // %2
+        "+r"(dst_width),             // %3
+        "=&r"(src_tap0),             // %4
+        "=&r"(src_tap1),             // %5
+        "=&r"(tap_count),            // %6
+        "=&r"(start)                 // %7
+      : "r"(src_argb),               // %8
+        "r"((intptr_t)(taps)),       // %9
+        "m"(kShuffleARGBPolyphase)   // %10
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm3", "xmm4", "xmm5",
+        "xmm6", "xmm7");
+}
+#endif  // HAS_SCALEARGBROWPOLYPHASEH_AVX2
+
+#ifdef HAS_SCALEROWPOLYPHASEV_SSE2
+// Filter 16 pixels at a time, 2 rows at a time.
+void ScaleRowPolyphaseV_SSE2(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps) {
+  intptr_t offset = 0;
+  intptr_t tap;
+  const int16_t* src_row0;
+  const int16_t* src_row1;
+  asm volatile(
+      "pcmpeqb     %%xmm9,%%xmm9                 \n"
+      "psrld       $0x1f,%%xmm9                  \n"
+      "pslld       $0x13,%%xmm9                  \n"  // 1 << 19 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "movdqa      %%xmm9,%%xmm4                 \n"
+      "movdqa      %%xmm9,%%xmm5                 \n"
+      "movdqa      %%xmm9,%%xmm6                 \n"
+      "movdqa      %%xmm9,%%xmm7                 \n"
+      "xor         %3,%3                         \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "mov         (%6,%3,8),%4                  \n"
+      "mov         0x8(%6,%3,8),%5               \n"
+      "movd        (%7,%3,2),%%xmm8              \n"
+      "pshufd      $0x0,%%xmm8,%%xmm8            \n"  // C0 C1
+      "movdqu      (%4,%2),%%xmm0                \n"
+      "movdqu      (%5,%2),%%xmm1                \n"
+      "movdqa      %%xmm0,%%xmm2                 \n"
+      "punpcklwd   %%xmm1,%%xmm0                 \n"
+      "punpckhwd   %%xmm1,%%xmm2                 \n"
+      "pmaddwd     %%xmm8,%%xmm0                 \n"
+      "pmaddwd     %%xmm8,%%xmm2                 \n"
+      "paddd       %%xmm0,%%xmm4                 \n"
+      "paddd       %%xmm2,%%xmm5                 \n"
+      "movdqu      0x10(%4,%2),%%xmm0            \n"
+      "movdqu      0x10(%5,%2),%%xmm1            \n"
+      "movdqa      %%xmm0,%%xmm2                 \n"
+      "punpcklwd   %%xmm1,%%xmm0                 \n"
+      "punpckhwd   %%xmm1,%%xmm2                 \n"
+      "pmaddwd     %%xmm8,%%xmm0                 \n"
+      "pmaddwd     %%xmm8,%%xmm2                 \n"
+      "paddd       %%xmm0,%%xmm6                 \n"
+      "paddd       %%xmm2,%%xmm7                 \n"
+      "add         $0x2,%3                       \n"
+      "cmp         %8,%3                         \n"
+      "jl          2b                            \n"
+
+      "psrad       $0x14,%%xmm4                  \n"
+      "psrad       $0x14,%%xmm5                  \n"
+      "psrad       $0x14,%%xmm6                  \n"
+      "psrad       $0x14,%%xmm7                  \n"
+      "packssdw    %%xmm5,%%xmm4                 \n"
+      "packssdw    %%xmm7,%%xmm6                 \n"
+      "packuswb    %%xmm6,%%xmm4                 \n"
+      "movdqu      %%xmm4,(%0)                   \n"
+      "add         $0x10,%0                      \n"
+      "add         $0x20,%2                      \n"
+      "sub         $0x10,%1                      \n"
+      "jg          1b                            \n"
+      : "+r"(dst_ptr),          // %0
+        "+r"(dst_width),        // %1
+        "+r"(offset),           // %2
+        "=&r"(tap),             // %3
+        "=&r"(src_row0),        // %4
+        "=&r"(src_row1)         // %5
+      : "r"(src_rows),          // %6
+        "r"(coeffs),            // %7
+        "r"((intptr_t)(taps))   // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5", "xmm6", "xmm7",
+        "xmm8", "xmm9");
+}
+#endif  // HAS_SCALEROWPOLYPHASEV_SSE2
+
+#ifdef HAS_SCALEROWPOLYPHASEV_AVX2
+// Filter 16 pixels at a time, 2 rows at a time.
+void ScaleRowPolyphaseV_AVX2(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps) {
+  intptr_t offset = 0;
+  intptr_t tap;
+  const int16_t* src_row0;
+  const int16_t* src_row1;
+  asm volatile(
+      "vpcmpeqb    %%ymm9,%%ymm9,%%ymm9          \n"
+      "vpsrld      $0x1f,%%ymm9,%%ymm9           \n"
+      "vpslld      $0x13,%%ymm9,%%ymm9           \n"  // 1 << 19 for rounding
+
+      LABELALIGN
+      "1:                                        \n"
+      "vmovdqa     %%ymm9,%%ymm4                 \n"
+      "vmovdqa     %%ymm9,%%ymm5                 \n"
+      "xor         %3,%3                         \n"
+
+      LABELALIGN
+      "2:                                        \n"
+      "mov         (%6,%3,8),%4                  \n"
+      "mov         0x8(%6,%3,8),%5               \n"
+      "vpbroadcastd (%7,%3,2),%%ymm8             \n"  // C0 C1
+      "vmovdqu     (%4,%2),%%ymm0                \n"
+      "vmovdqu     (%5,%2),%%ymm1                \n"
+      "vpunpckhwd  %%ymm1,%%ymm0,%%ymm2          \n"
+      "vpunpcklwd  %%ymm1,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm8,%%ymm0,%%ymm0          \n"
+      "vpmaddwd    %%ymm8,%%ymm2,%%ymm2          \n"
+      "vpaddd      %%ymm0,%%ymm4,%%ymm4          \n"
+      "vpaddd      %%ymm2,%%ymm5,%%ymm5          \n"
+      "add         $0x2,%3                       \n"
+      "cmp         %8,%3                         \n"
+      "jl          2b                            \n"
+
+      "vpsrad      $0x14,%%ymm4,%%ymm4           \n"
+      "vpsrad      $0x14,%%ymm5,%%ymm5           \n"
+      "vpackssdw   %%ymm5,%%ymm4,%%ymm4          \n"
+      "vextracti128 $0x1,%%ymm4,%%xmm5           \n"
+      "vpackuswb   %%xmm5,%%xmm4,%%xmm4          \n"
+      "vmovdqu     %%xmm4,(%0)                   \n"
+      "add         $0x10,%0                      \n"
+      "add         $0x20,%2                      \n"
+      "sub         $0x10,%1                      \n"
+      "jg          1b                            \n"
+      "vzeroupper                                \n"
+      : "+r"(dst_ptr),          // %0
+        "+r"(dst_width),        // %1
+        "+r"(offset),           // %2
+        "=&r"(tap),             // %3
+        "=&r"(src_row0),        // %4
+        "=&r"(src_row1)         // %5
+      : "r"(src_rows),          // %6
+        "r"(coeffs),            // %7
+        "r"((intptr_t)(taps))   // %8
+      : "memory", "cc", "xmm0", "xmm1", "xmm2", "xmm4", "xmm5", "xmm8",
+        "xmm9");
+}
+#endif  // HAS_SCALEROWPOLYPHASEV_AVX2
+
 #endif  // defined(__x86_64__) || defined(__i386__)
 
 #ifdef __cplusplus
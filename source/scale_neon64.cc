@@ -1145,6 +1145,106 @@ void ScaleFilterCols_NEON(uint8_t* dst_ptr,
 
 #undef LOAD2_DATA8_LANE
 
+#ifdef HAS_SCALEADDROW_16_NEON
+// Add a row of shorts to a row of ints.  Used for 16 bit box filter.
+// Reads 8 shorts and accumulates to 8 ints at a time.
+void ScaleAddRow_16_NEON(const uint16_t* src_ptr,
+                         uint32_t* dst_ptr,
+                         int src_width) {
+  asm volatile(
+      "1:                                        \n"
+      "ld1         {v1.4s, v2.4s}, [%1]          \n"  // load accumulator
+      "ld1         {v0.8h}, [%0], #16            \n"  // load 8 shorts
+      "uaddw2      v2.4s, v2.4s, v0.8h           \n"  // add
+      "prfm        pldl1keep, [%0, 448]          \n"  // prefetch 7 lines ahead
+      "uaddw       v1.4s, v1.4s, v0.4h           \n"
+      "st1         {v1.4s, v2.4s}, [%1], #32     \n"  // store accumulator
+      "subs        %w2, %w2, #8                  \n"  // 8 processed per loop
+      "b.gt        1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst_ptr),   // %1
+        "+r"(src_width)  // %2
+      :
+      : "memory", "cc", "v0", "v1", "v2"  // Clobber List
+  );
+}
+#endif  // HAS_SCALEADDROW_16_NEON
+
+#ifdef HAS_SCALEFILTERCOLS_16_NEON
+#define LOAD2_DATA16_LANE(n)                     \
+  "lsr        %5, %3, #16                    \n" \
+  "add        %6, %1, %5, lsl #1             \n" \
+  "add        %3, %3, %4                     \n" \
+  "ld2        {v4.h, v5.h}[" #n "], [%6]     \n"
+
+// The NEON version mimics this formula (from scale_common.cc):
+// #define BLENDER(a, b, f) (uint16_t)((int)(a) +
+//    (int)((((int64_t)((f)) * ((int64_t)(b) - (int)(a))) + 0x8000) >> 16))
+// as the rounded high short of (a << 16) + f * (b - a).
+
+void ScaleFilterCols_16_NEON(uint16_t* dst_ptr,
+                             const uint16_t* src_ptr,
+                             int dst_width,
+                             int x,
+                             int dx) {
+  int dx_offset[4] = {0, 1, 2, 3};
+  int* tmp = dx_offset;
+  const uint16_t* src_tmp = src_ptr;
+  int64_t x64 = (int64_t)x;    // NOLINT
+  int64_t dx64 = (int64_t)dx;  // NOLINT
+  asm volatile (
+      "dup         v0.4s, %w3                    \n"  // x
+      "dup         v1.4s, %w4                    \n"  // dx
+      "ld1         {v2.4s}, [%5]                 \n"  // 0 1 2 3
+      "shl         v3.4s, v1.4s, #2              \n"  // 4 * dx
+      "mul         v1.4s, v1.4s, v2.4s           \n"
+    // x         , x + 1 * dx, x + 2 * dx, x + 3 * dx
+      "add         v1.4s, v1.4s, v0.4s           \n"
+    // x + 4 * dx, x + 5 * dx, x + 6 * dx, x + 7 * dx
+      "add         v2.4s, v1.4s, v3.4s           \n"
+      "shl         v0.4s, v3.4s, #1              \n"  // 8 * dx
+      "1:                                        \n"
+    LOAD2_DATA16_LANE(0)
+    LOAD2_DATA16_LANE(1)
+    LOAD2_DATA16_LANE(2)
+    LOAD2_DATA16_LANE(3)
+    LOAD2_DATA16_LANE(4)
+    LOAD2_DATA16_LANE(5)
+    LOAD2_DATA16_LANE(6)
+    LOAD2_DATA16_LANE(7)
+      "uzp1        v6.8h, v1.8h, v2.8h           \n"  // f
+      "usubl       v16.4s, v5.4h, v4.4h          \n"  // b - a
+      "usubl2      v17.4s, v5.8h, v4.8h          \n"
+      "ushll       v7.4s, v6.4h, #0              \n"
+      "ushll2      v6.4s, v6.8h, #0              \n"
+      "shll        v18.4s, v4.4h, #16            \n"  // a << 16
+      "shll2       v19.4s, v4.8h, #16            \n"
+      "mla         v18.4s, v16.4s, v7.4s         \n"
+      "mla         v19.4s, v17.4s, v6.4s         \n"
+      "rshrn       v4.4h, v18.4s, #16            \n"
+      "rshrn2      v4.8h, v19.4s, #16            \n"
+
+      "st1         {v4.8h}, [%0], #16            \n"  // store pixels
+      "add         v1.4s, v1.4s, v0.4s           \n"
+      "add         v2.4s, v2.4s, v0.4s           \n"
+      "subs        %w2, %w2, #8                  \n"  // 8 processed per loop
+      "b.gt        1b                            \n"
+  : "+r"(dst_ptr),          // %0
+    "+r"(src_ptr),          // %1
+    "+r"(dst_width),        // %2
+    "+r"(x64),              // %3
+    "+r"(dx64),             // %4
+    "+r"(tmp),              // %5
+    "+r"(src_tmp)           // %6
+  :
+  : "memory", "cc", "v0", "v1", "v2", "v3", "v4", "v5", "v6", "v7",
+    "v16", "v17", "v18", "v19"
+  );
+}
+
+#undef LOAD2_DATA16_LANE
+#endif  // HAS_SCALEFILTERCOLS_16_NEON
+
 // 16x2 -> 16x1
 void ScaleFilterRows_NEON(uint8_t* dst_ptr,
                           const uint8_t* src_ptr,
@@ -1539,10 +1639,57 @@ void ScaleRowDown2Box_16_NEON(const uint16_t* src_ptr,
         "+r"(dst),         // %2
         "+r"(dst_width)    // %3
       :
-      : "v0", "v1", "v2", "v3"  // Clobber List
+      : "memory", "cc", "v0", "v1", "v2", "v3"  // Clobber List
   );
 }
 
+#ifdef HAS_SCALEROWDOWN2_16_NEON
+// Read 16x1 point sample down and write 8x1.
+void ScaleRowDown2_16_NEON(const uint16_t* src_ptr,
+                           ptrdiff_t src_stride,
+                           uint16_t* dst,
+                           int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "1:                                        \n"
+      // load even pixels into v0, odd into v1
+      "ld2         {v0.8h,v1.8h}, [%0], #32      \n"
+      "subs        %w2, %w2, #8                  \n"  // 8 processed per loop
+      "prfm        pldl1keep, [%0, 448]          \n"  // prefetch 7 lines ahead
+      "st1         {v1.8h}, [%1], #16            \n"  // store odd pixels
+      "b.gt        1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst),       // %1
+        "+r"(dst_width)  // %2
+      :
+      : "memory", "cc", "v0", "v1"  // Clobber List
+  );
+}
+
+// Read 16x1 average down and write 8x1.
+void ScaleRowDown2Linear_16_NEON(const uint16_t* src_ptr,
+                                 ptrdiff_t src_stride,
+                                 uint16_t* dst,
+                                 int dst_width) {
+  (void)src_stride;
+  asm volatile(
+      "1:                                        \n"
+      // load even pixels into v0, odd into v1
+      "ld2         {v0.8h,v1.8h}, [%0], #32      \n"
+      "subs        %w2, %w2, #8                  \n"  // 8 processed per loop
+      "urhadd      v0.8h, v0.8h, v1.8h           \n"  // rounding half add
+      "prfm        pldl1keep, [%0, 448]          \n"  // prefetch 7 lines ahead
+      "st1         {v0.8h}, [%1], #16            \n"
+      "b.gt        1b                            \n"
+      : "+r"(src_ptr),   // %0
+        "+r"(dst),       // %1
+        "+r"(dst_width)  // %2
+      :
+      : "memory", "cc", "v0", "v1"  // Clobber List
+  );
+}
+#endif  // HAS_SCALEROWDOWN2_16_NEON
+
 // Read 8x2 upsample with filtering and write 16x1.
 // Actually reads an extra pixel, so 9x2.
 void ScaleRowUp2_16_NEON(const uint16_t* src_ptr,
@@ -1653,6 +1800,218 @@ void ScaleUVRowDownEven_NEON(const uint8_t* src_ptr,
       : "memory", "cc", "v0", "v1", "v2", "v3");
 }
 
+// Filter 8 pixels at a time.  4 taps of each pixel are loaded into a lane and
+// the products are summed with addp.
+void ScaleRowPolyphaseH_NEON(const uint8_t* src_ptr,
+                             int16_t* dst_ptr,
+                             const int16_t* coeffs,
+                             const int* starts,
+                             int dst_width,
+                             int taps) {
+  asm volatile(
+      "1:                                        \n"
+      "ldpsw       x10, x11, [%2]                \n"
+      "ldpsw       x12, x13, [%2, #8]            \n"
+      "ldpsw       x14, x15, [%2, #16]           \n"
+      "ldpsw       x16, x17, [%2, #24]           \n"
+      "add         x10, %4, x10                  \n"
+      "add         x11, %4, x11                  \n"
+      "add         x12, %4, x12                  \n"
+      "add         x13, %4, x13                  \n"
+      "add         x14, %4, x14                  \n"
+      "add         x15, %4, x15                  \n"
+      "add         x16, %4, x16                  \n"
+      "add         x17, %4, x17                  \n"
+      "mov         w9, %w5                       \n"
+      "movi        v24.4s, #0                    \n"
+      "movi        v25.4s, #0                    \n"
+      "movi        v26.4s, #0                    \n"
+      "movi        v27.4s, #0                    \n"
+      "movi        v28.4s, #0                    \n"
+      "movi        v29.4s, #0                    \n"
+      "movi        v30.4s, #0                    \n"
+      "movi        v31.4s, #0                    \n"
+
+      "2:                                        \n"
+      "ld1         {v0.s}[0], [x10], #4          \n"
+      "ld1         {v0.s}[1], [x11], #4          \n"
+      "ld1         {v0.s}[2], [x14], #4          \n"
+      "ld1         {v0.s}[3], [x15], #4          \n"  // p0 p1 p4 p5
+      "ld1         {v1.s}[0], [x12], #4          \n"
+      "ld1         {v1.s}[1], [x13], #4          \n"
+      "ld1         {v1.s}[2], [x16], #4          \n"
+      "ld1         {v1.s}[3], [x17], #4          \n"  // p2 p3 p6 p7
+      "ld1         {v16.8h, v17.8h, v18.8h, v19.8h}, [%1], #64 \n"
+      "ushll       v2.8h, v0.8b, #0              \n"  // p0 p1
+      "ushll2      v3.8h, v0.16b, #0             \n"  // p4 p5
+      "ushll       v4.8h, v1.8b, #0              \n"  // p2 p3
+      "ushll2      v5.8h, v1.16b, #0             \n"  // p6 p7
+      "smlal       v24.4s, v2.4h, v16.4h         \n"
+      "smlal2      v25.4s, v2.8h, v16.8h         \n"
+      "smlal       v28.4s, v3.4h, v17.4h         \n"
+      "smlal2      v29.4s, v3.8h, v17.8h         \n"
+      "smlal       v26.4s, v4.4h, v18.4h         \n"
+      "smlal2      v27.4s, v4.8h, v18.8h         \n"
+      "smlal       v30.4s, v5.4h, v19.4h         \n"
+      "smlal2      v31.4s, v5.8h, v19.8h         \n"
+      "subs        w9, w9, #4                    \n"
+      "b.gt        2b                            \n"
+
+      "addp        v24.4s, v24.4s, v25.4s        \n"
+      "addp        v26.4s, v26.4s, v27.4s        \n"
+      "addp        v28.4s, v28.4s, v29.4s        \n"
+      "addp        v30.4s, v30.4s, v31.4s        \n"
+      "addp        v24.4s, v24.4s, v26.4s        \n"  // p0 p1 p2 p3
+      "addp        v28.4s, v28.4s, v30.4s        \n"  // p4 p5 p6 p7
+      "sqrshrn     v0.4h, v24.4s, #8             \n"
+      "sqrshrn2    v0.8h, v28.4s, #8             \n"
+      "st1         {v0.8h}, [%0], #16            \n"
+      "add         %2, %2, #32                   \n"
+      "subs        %w3, %w3, #8                  \n"
+      "b.gt        1b                            \n"
+      : "+r"(dst_ptr),         // %0
+        "+r"(coeffs),          // %1
+        "+r"(starts),          // %2
+        "+r"(dst_width)        // %3
+      : "r"(src_ptr),          // %4
+        "r"(taps)              // %5
+      : "memory", "cc", "x9", "x10", "x11", "x12", "x13", "x14", "x15", "x16",
+        "x17", "v0", "v1", "v2", "v3", "v4", "v5", "v16", "v17", "v18", "v19",
+        "v24", "v25", "v26", "v27", "v28", "v29", "v30", "v31");
+}
+
+// Filter 1 UV pixel at a time, 4 taps at a time.
+void ScaleUVRowPolyphaseH_NEON(const uint8_t* src_uv,
+                               int16_t* dst_ptr,
+                               const int16_t* coeffs,
+                               const int* starts,
+                               int dst_width,
+                               int taps) {
+  asm volatile(
+      "1:                                        \n"
+      "ldrsw       x10, [%2], #4                 \n"
+      "add         x10, %4, x10, lsl #1          \n"
+      "mov         w9, %w5                       \n"
+      "movi        v4.4s, #0                     \n"
+      "movi        v5.4s, #0                     \n"
+
+      "2:                                        \n"
+      "ld1         {v0.8b}, [x10], #8            \n"  // U0 V0 U1 V1 ...
+      "ld1         {v1.4h}, [%1], #8             \n"  // C0 C1 C2 C3
+      "ushll       v0.8h, v0.8b, #0              \n"
+      "zip1        v1.8h, v1.8h, v1.8h           \n"  // C0 C0 C1 C1 ...
+      "smlal       v4.4s, v0.4h, v1.4h           \n"
+      "smlal2      v5.4s, v0.8h, v1.8h           \n"
+      "subs        w9, w9, #4                    \n"
+      "b.gt        2b                            \n"
+
+      "add         v4.4s, v4.4s, v5.4s           \n"  // U V U V
+      "ext         v5.16b, v4.16b, v4.16b, #8    \n"
+      "add         v4.2s, v4.2s, v5.2s           \n"
+      "sqrshrn     v4.4h, v4.4s, #8              \n"
+      "st1         {v4.s}[0], [%0], #4           \n"
+      "subs        %w3, %w3, #1                  \n"
+      "b.gt        1b                            \n"
+      : "+r"(dst_ptr),         // %0
+        "+r"(coeffs),          // %1
+        "+r"(starts),          // %2
+        "+r"(dst_width)        // %3
+      : "r"(src_uv),           // %4
+        "r"(taps)              // %5
+      : "memory", "cc", "x9", "x10", "v0", "v1", "v4", "v5");
+}
+
+// Filter 1 ARGB pixel at a time, 4 taps at a time.
+void ScaleARGBRowPolyphaseH_NEON(const uint8_t* src_argb,
+                                 int16_t* dst_ptr,
+                                 const int16_t* coeffs,
+                                 const int* starts,
+                                 int dst_width,
+                                 int taps) {
+  asm volatile(
+      "1:                                        \n"
+      "ldrsw       x10, [%2], #4                 \n"
+      "add         x10, %4, x10, lsl #2          \n"
+      "mov         w9, %w5                       \n"
+      "movi        v4.4s, #0                     \n"
+
+      "2:                                        \n"
+      "ld1         {v0.16b}, [x10], #16          \n"  // 4 ARGB pixels
+      "ld1         {v3.4h}, [%1], #8             \n"  // C0 C1 C2 C3
+      "ushll       v1.8h, v0.8b, #0              \n"
+      "ushll2      v2.8h, v0.16b, #0             \n"
+      "smlal       v4.4s, v1.4h, v3.h[0]         \n"
+      "smlal2      v4.4s, v1.8h, v3.h[1]         \n"
+      "smlal       v4.4s, v2.4h, v3.h[2]         \n"
+      "smlal2      v4.4s, v2.8h, v3.h[3]         \n"
+      "subs        w9, w9, #4                    \n"
+      "b.gt        2b                            \n"
+
+      "sqrshrn     v4.4h, v4.4s, #8              \n"
+      "st1         {v4.4h}, [%0], #8             \n"
+      "subs        %w3, %w3, #1                  \n"
+      "b.gt        1b                            \n"
+      : "+r"(dst_ptr),         // %0
+        "+r"(coeffs),          // %1
+        "+r"(starts),          // %2
+        "+r"(dst_width)        // %3
+      : "r"(src_argb),         // %4
+        "r"(taps)              // %5
+      : "memory", "cc", "x9", "x10", "v0", "v1", "v2", "v3", "v4");
+}
+
+// Filter 16 pixels at a time, 1 row at a time.
+void ScaleRowPolyphaseV_NEON(const int16_t* const* src_rows,
+                             uint8_t* dst_ptr,
+                             const int16_t* coeffs,
+                             int dst_width,
+                             int taps) {
+  int64_t offset = 0;
+  asm volatile(
+      "1:                                        \n"
+      "movi        v4.4s, #0                     \n"
+      "movi        v5.4s, #0                     \n"
+      "movi        v6.4s, #0                     \n"
+      "movi        v7.4s, #0                     \n"
+      "mov         x9, #0                        \n"
+
+      "2:                                        \n"
+      "ldr         x10, [%3, x9, lsl #3]         \n"
+      "ldr         h3, [%4, x9, lsl #1]          \n"
+      "add         x10, x10, %2                  \n"
+      "ld1         {v0.8h, v1.8h}, [x10]         \n"
+      "smlal       v4.4s, v0.4h, v3.h[0]         \n"
+      "smlal2      v5.4s, v0.8h, v3.h[0]         \n"
+      "smlal       v6.4s, v1.4h, v3.h[0]         \n"
+      "smlal2      v7.4s, v1.8h, v3.h[0]         \n"
+      "add         x9, x9, #1                    \n"
+      "cmp         x9, %5                        \n"
+      "b.lt        2b                            \n"
+
+      "srshr       v4.4s, v4.4s, #20             \n"
+      "srshr       v5.4s, v5.4s, #20             \n"
+      "srshr       v6.4s, v6.4s, #20             \n"
+      "srshr       v7.4s, v7.4s, #20             \n"
+      "sqxtn       v0.4h, v4.4s                  \n"
+      "sqxtn2      v0.8h, v5.4s                  \n"
+      "sqxtn       v1.4h, v6.4s                  \n"
+      "sqxtn2      v1.8h, v7.4s                  \n"
+      "sqxtun      v0.8b, v0.8h                  \n"
+      "sqxtun2     v0.16b, v1.8h                 \n"
+      "st1         {v0.16b}, [%0], #16           \n"
+      "add         %2, %2, #32                   \n"
+      "subs        %w1, %w1, #16                 \n"
+      "b.gt        1b                            \n"
+      : "+r"(dst_ptr),            // %0
+        "+r"(dst_width),          // %1
+        "+r"(offset)              // %2
+      : "r"(src_rows),            // %3
+        "r"(coeffs),              // %4
+        "r"((int64_t)(taps))      // %5
+      : "memory", "cc", "x9", "x10", "v0", "v1", "v3", "v4", "v5", "v6",
+        "v7");
+}
+
 #endif  // !defined(LIBYUV_DISABLE_NEON) && defined(__aarch64__)
 
 #ifdef __cplusplus
@@ -17,6 +17,7 @@
 #include "libyuv/planar_functions.h"  // For CopyUV
 #include "libyuv/row.h"
 #include "libyuv/scale_row.h"
+#include "libyuv/scale_uv.h"
 
 #ifdef __cplusplus
 namespace libyuv {
@@ -40,6 +41,9 @@ extern "C" {
 #ifndef HAS_SCALEUVBILINEARUP
 #define HAS_SCALEUVBILINEARUP 1
 #endif
+#ifndef HAS_SCALEUVBOX
+#define HAS_SCALEUVBOX 1
+#endif
 #ifndef HAS_UVCOPY
 #define HAS_UVCOPY 1
 #endif
@@ -55,38 +59,17 @@ static __inline int Abs(int v) {
 // This is an optimized version for scaling down a UV to 1/2 of
 // its original size.
 #if HAS_SCALEUVDOWN2
-static void ScaleUVDown2(int src_width,
-                         int src_height,
-                         int dst_width,
-                         int dst_height,
-                         int src_stride,
-                         int dst_stride,
-                         const uint8_t* src_uv,
-                         uint8_t* dst_uv,
-                         int x,
-                         int dx,
-                         int y,
-                         int dy,
-                         enum FilterMode filtering) {
-  int j;
-  int row_stride = src_stride * (dy >> 16);
+static void ScaleUVDown2Init(ScaleUVScaler* s) {
+  const int dst_width = s->clip_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleUVRowDown2)(const uint8_t* src_uv, ptrdiff_t src_stride,
                           uint8_t* dst_uv, int dst_width) =
       filtering == kFilterNone
           ? ScaleUVRowDown2_C
           : (filtering == kFilterLinear ? ScaleUVRowDown2Linear_C
                                         : ScaleUVRowDown2Box_C);
-  (void)src_width;
-  (void)src_height;
-  (void)dx;
-  assert(dx == 65536 * 2);      // Test scale factor of 2.
-  assert((dy & 0x1ffff) == 0);  // Test vertical scale is multiple of 2.
-  // Advance to odd row, even column.
-  if (filtering == kFilterBilinear) {
-    src_uv += (y >> 16) * src_stride + (x >> 16) * 2;
-  } else {
-    src_uv += (y >> 16) * src_stride + ((x >> 16) - 1) * 2;
-  }
+  assert(s->dx == 65536 * 2);      // Test scale factor of 2.
+  assert((s->dy & 0x1ffff) == 0);  // Test vertical scale is multiple of 2.
 
 #if defined(HAS_SCALEUVROWDOWN2BOX_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && filtering) {
@@ -180,11 +163,31 @@ static void ScaleUVDown2(int src_width,
   }
 #endif
 
-  if (filtering == kFilterLinear) {
+  s->ScaleUVRowDown2 = ScaleUVRowDown2;
+}
+
+static void ScaleUVDown2(const ScaleUVScaler* s,
+                         int dst_height,
+                         int src_stride,
+                         int dst_stride,
+                         const uint8_t* src_uv,
+                         int src_y,
+                         uint8_t* dst_uv,
+                         int y) {
+  int j;
+  int row_stride = src_stride * (s->dy >> 16);
+  // Advance to odd row, even column.
+  if (s->filtering == kFilterBilinear) {
+    src_uv += (ptrdiff_t)((y >> 16) - src_y) * src_stride + (s->x >> 16) * 2;
+  } else {
+    src_uv +=
+        (ptrdiff_t)((y >> 16) - src_y) * src_stride + ((s->x >> 16) - 1) * 2;
+  }
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   for (j = 0; j < dst_height; ++j) {
-    ScaleUVRowDown2(src_uv, src_stride, dst_uv, dst_width);
+    s->ScaleUVRowDown2(src_uv, src_stride, dst_uv, s->clip_width);
     src_uv += row_stride;
     dst_uv += dst_stride;
   }
@@ -195,33 +198,13 @@ static void ScaleUVDown2(int src_width,
 // This is an optimized version for scaling down a UV to 1/4 of
 // its original size.
 #if HAS_SCALEUVDOWN4BOX
-static void ScaleUVDown4Box(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_uv,
-                            uint8_t* dst_uv,
-                            int x,
-                            int dx,
-                            int y,
-                            int dy) {
-  int j;
-  // Allocate 2 rows of UV.
-  const int kRowSize = (dst_width * 2 * 2 + 15) & ~15;
-  align_buffer_64(row, kRowSize * 2);
-  int row_stride = src_stride * (dy >> 16);
+static void ScaleUVDown4BoxInit(ScaleUVScaler* s) {
+  const int dst_width = s->clip_width;
   void (*ScaleUVRowDown2)(const uint8_t* src_uv, ptrdiff_t src_stride,
                           uint8_t* dst_uv, int dst_width) =
       ScaleUVRowDown2Box_C;
-  // Advance to odd row, even column.
-  src_uv += (y >> 16) * src_stride + (x >> 16) * 2;
-  (void)src_width;
-  (void)src_height;
-  (void)dx;
-  assert(dx == 65536 * 4);      // Test scale factor of 4.
-  assert((dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
+  assert(s->dx == 65536 * 4);      // Test scale factor of 4.
+  assert((s->dy & 0x3ffff) == 0);  // Test vertical scale is multiple of 4.
 
 #if defined(HAS_SCALEUVROWDOWN2BOX_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
@@ -247,12 +230,31 @@ static void ScaleUVDown4Box(int src_width,
     }
   }
 #endif
+  s->ScaleUVRowDown2 = ScaleUVRowDown2;
+}
 
+static void ScaleUVDown4Box(const ScaleUVScaler* s,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_uv,
+                            int src_y,
+                            uint8_t* dst_uv,
+                            int y,
+                            const LibyuvScratch* scratch) {
+  int j;
+  const int dst_width = s->clip_width;
+  // Allocate 2 rows of UV.
+  const int kRowSize = (dst_width * 2 * 2 + 15) & ~15;
+  align_buffer_64_scratch(row, kRowSize * 2, scratch);
+  int row_stride = src_stride * (s->dy >> 16);
+  // Advance to odd row, even column.
+  src_uv += (ptrdiff_t)((y >> 16) - src_y) * src_stride + (s->x >> 16) * 2;
   for (j = 0; j < dst_height; ++j) {
-    ScaleUVRowDown2(src_uv, src_stride, row, dst_width * 2);
-    ScaleUVRowDown2(src_uv + src_stride * 2, src_stride, row + kRowSize,
-                    dst_width * 2);
-    ScaleUVRowDown2(row, kRowSize, dst_uv, dst_width);
+    s->ScaleUVRowDown2(src_uv, src_stride, row, dst_width * 2);
+    s->ScaleUVRowDown2(src_uv + src_stride * 2, src_stride, row + kRowSize,
+                       dst_width * 2);
+    s->ScaleUVRowDown2(row, kRowSize, dst_uv, dst_width);
     src_uv += row_stride;
     dst_uv += dst_stride;
   }
@@ -264,30 +266,15 @@ static void ScaleUVDown4Box(int src_width,
 // This is an optimized version for scaling down a UV to even
 // multiple of its original size.
 #if HAS_SCALEUVDOWNEVEN
-static void ScaleUVDownEven(int src_width,
-                            int src_height,
-                            int dst_width,
-                            int dst_height,
-                            int src_stride,
-                            int dst_stride,
-                            const uint8_t* src_uv,
-                            uint8_t* dst_uv,
-                            int x,
-                            int dx,
-                            int y,
-                            int dy,
-                            enum FilterMode filtering) {
-  int j;
-  int col_step = dx >> 16;
-  int row_stride = (dy >> 16) * src_stride;
+static void ScaleUVDownEvenInit(ScaleUVScaler* s) {
+  const int dst_width = s->clip_width;
+  const enum FilterMode filtering = s->filtering;
   void (*ScaleUVRowDownEven)(const uint8_t* src_uv, ptrdiff_t src_stride,
                              int src_step, uint8_t* dst_uv, int dst_width) =
       filtering ? ScaleUVRowDownEvenBox_C : ScaleUVRowDownEven_C;
-  (void)src_width;
-  (void)src_height;
-  assert(IS_ALIGNED(src_width, 2));
-  assert(IS_ALIGNED(src_height, 2));
-  src_uv += (y >> 16) * src_stride + (x >> 16) * 2;
+  (void)dst_width;
+  assert(IS_ALIGNED(s->src_width, 2));
+  assert(IS_ALIGNED(s->src_height, 2));
 #if defined(HAS_SCALEUVROWDOWNEVEN_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     ScaleUVRowDownEven = filtering ? ScaleUVRowDownEvenBox_Any_SSSE3
@@ -336,12 +323,26 @@ static void ScaleUVDownEven(int src_width,
     }
   }
 #endif
+  s->ScaleUVRowDownEven = ScaleUVRowDownEven;
+}
 
-  if (filtering == kFilterLinear) {
+static void ScaleUVDownEven(const ScaleUVScaler* s,
+                            int dst_height,
+                            int src_stride,
+                            int dst_stride,
+                            const uint8_t* src_uv,
+                            int src_y,
+                            uint8_t* dst_uv,
+                            int y) {
+  int j;
+  int col_step = s->dx >> 16;
+  int row_stride = (s->dy >> 16) * src_stride;
+  src_uv += (ptrdiff_t)((y >> 16) - src_y) * src_stride + (s->x >> 16) * 2;
+  if (s->filtering == kFilterLinear) {
     src_stride = 0;
   }
   for (j = 0; j < dst_height; ++j) {
-    ScaleUVRowDownEven(src_uv, src_stride, col_step, dst_uv, dst_width);
+    s->ScaleUVRowDownEven(src_uv, src_stride, col_step, dst_uv, s->clip_width);
     src_uv += row_stride;
     dst_uv += dst_stride;
   }
@@ -350,20 +351,11 @@ static void ScaleUVDownEven(int src_width,
 
 // Scale UV down with bilinear interpolation.
 #if HAS_SCALEUVBILINEARDOWN
-static void ScaleUVBilinearDown(int src_width,
-                                int src_height,
-                                int dst_width,
-                                int dst_height,
-                                int src_stride,
-                                int dst_stride,
-                                const uint8_t* src_uv,
-                                uint8_t* dst_uv,
-                                int x,
-                                int dx,
-                                int y,
-                                int dy,
-                                enum FilterMode filtering) {
-  int j;
+static void ScaleUVBilinearDownInit(ScaleUVScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const int dx = s->dx;
   void (*InterpolateRow)(uint8_t * dst_uv, const uint8_t* src_uv,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
@@ -381,8 +373,9 @@ static void ScaleUVBilinearDown(int src_width,
     xr = src_width;
   }
   clip_src_width = (int)(xr - xl) * 2;  // Width aligned to 2.
-  src_uv += xl * 2;
-  x -= (int)(xl << 16);
+  s->src_offset += (int)xl * 2;
+  s->x -= (int)(xl << 16);
+  s->row_bytes = clip_src_width;
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_SSSE3;
@@ -436,24 +429,44 @@ static void ScaleUVBilinearDown(int src_width,
     }
   }
 #endif
+  s->InterpolateRow = InterpolateRow;
+  s->ScaleUVCols = ScaleUVFilterCols;
+}
+
+// src_uv points to src_offset.
+static void ScaleUVBilinearDown(const ScaleUVScaler* s,
+                                int dst_height,
+                                int src_stride,
+                                int dst_stride,
+                                const uint8_t* src_uv,
+                                int src_y,
+                                uint8_t* dst_uv,
+                                int y,
+                                const LibyuvScratch* scratch) {
+  int j;
+  const int dst_width = s->clip_width;
+  const int clip_src_width = s->row_bytes;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
   // TODO(fbarchard): Consider not allocating row buffer for kFilterLinear.
   // Allocate a row of UV.
   {
-    align_buffer_64(row, clip_src_width * 2);
+    align_buffer_64_scratch(row, clip_src_width * 2, scratch);
 
-    const int max_y = (src_height - 1) << 16;
+    const int max_y = (Abs(s->src_height) - 1) << 16;
     if (y > max_y) {
       y = max_y;
     }
     for (j = 0; j < dst_height; ++j) {
       int yi = y >> 16;
-      const uint8_t* src = src_uv + yi * src_stride;
-      if (filtering == kFilterLinear) {
-        ScaleUVFilterCols(dst_uv, src, dst_width, x, dx);
+      const uint8_t* src = src_uv + (ptrdiff_t)(yi - src_y) * src_stride;
+      if (s->filtering == kFilterLinear) {
+        s->ScaleUVCols(dst_uv, src, dst_width, x, dx);
       } else {
         int yf = (y >> 8) & 255;
-        InterpolateRow(row, src, src_stride, clip_src_width, yf);
-        ScaleUVFilterCols(dst_uv, row, dst_width, x, dx);
+        s->InterpolateRow(row, src, src_stride, clip_src_width, yf);
+        s->ScaleUVCols(dst_uv, row, dst_width, x, dx);
       }
       dst_uv += dst_stride;
       y += dy;
@@ -466,29 +479,181 @@ static void ScaleUVBilinearDown(int src_width,
 }
 #endif
 
-// Scale UV up with bilinear interpolation.
-#if HAS_SCALEUVBILINEARUP
-static void ScaleUVBilinearUp(int src_width,
-                              int src_height,
-                              int dst_width,
-                              int dst_height,
-                              int src_stride,
-                              int dst_stride,
-                              const uint8_t* src_uv,
-                              uint8_t* dst_uv,
+#if HAS_SCALEUVBOX
+#define MIN1(x) ((x) < 1 ? 1 : (x))
+
+static __inline uint32_t SumUVPixels(int iboxwidth, const uint16_t* src_ptr) {
+  uint32_t sum = 0u;
+  int x;
+  assert(iboxwidth > 0);
+  for (x = 0; x < iboxwidth; ++x) {
+    sum += src_ptr[x * 2];
+  }
+  return sum;
+}
+
+static void ScaleUVAddCols2_C(int dst_width,
+                              int boxheight,
                               int x,
                               int dx,
-                              int y,
-                              int dy,
-                              enum FilterMode filtering) {
-  int j;
+                              const uint16_t* src_ptr,
+                              uint8_t* dst_uv) {
+  int i;
+  int scaletbl[2];
+  int minboxwidth = dx >> 16;
+  int boxwidth;
+  scaletbl[0] = 65536 / (MIN1(minboxwidth) * boxheight);
+  scaletbl[1] = 65536 / (MIN1(minboxwidth + 1) * boxheight);
+  for (i = 0; i < dst_width; ++i) {
+    int ix = x >> 16;
+    int scaleval;
+    x += dx;
+    boxwidth = MIN1((x >> 16) - ix);
+    scaleval = scaletbl[boxwidth - minboxwidth];
+    dst_uv[0] = SumUVPixels(boxwidth, src_ptr + ix * 2) * scaleval >> 16;
+    dst_uv[1] = SumUVPixels(boxwidth, src_ptr + ix * 2 + 1) * scaleval >> 16;
+    dst_uv += 2;
+  }
+}
+
+static void ScaleUVAddCols1_C(int dst_width,
+                              int boxheight,
+                              int x,
+                              int dx,
+                              const uint16_t* src_ptr,
+                              uint8_t* dst_uv) {
+  int boxwidth = MIN1(dx >> 16);
+  int scaleval = 65536 / (boxwidth * boxheight);
+  int i;
+  x >>= 16;
+  for (i = 0; i < dst_width; ++i) {
+    dst_uv[0] = SumUVPixels(boxwidth, src_ptr + x * 2) * scaleval >> 16;
+    dst_uv[1] = SumUVPixels(boxwidth, src_ptr + x * 2 + 1) * scaleval >> 16;
+    dst_uv += 2;
+    x += boxwidth;
+  }
+}
+
+// Scale UV down to any dimensions with a box filter, averaging every source
+// pixel covered by each destination pixel.  Rows are summed as interleaved
+// bytes, so the plane ScaleAddRow functions are used on a row of
+// src_width * 2 bytes, and the columns are summed per channel.
+static void ScaleUVBoxInit(ScaleUVScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const int dx = s->dx;
+  int64_t xr = ((int64_t)x + (int64_t)dst_width * dx) >> 16;
+  int clip_src_width;
+  void (*ScaleUVAddCols)(int dst_width, int boxheight, int x, int dx,
+                         const uint16_t* src_ptr, uint8_t* dst_uv) =
+      (dx & 0xffff) ? ScaleUVAddCols2_C : ScaleUVAddCols1_C;
+  void (*ScaleAddRow)(const uint8_t* src_ptr, uint16_t* dst_ptr,
+                      int src_width) = ScaleAddRow_C;
+  if (xr < (x >> 16) + 1) {
+    xr = (x >> 16) + 1;  // Box is at least 1 pixel.
+  }
+  if (xr > src_width) {
+    xr = src_width;
+  }
+  clip_src_width = (int)xr * 2;  // Bytes of U and V summed per row.
+#if defined(HAS_SCALEADDROW_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    ScaleAddRow = ScaleAddRow_Any_SSE2;
+    if (IS_ALIGNED(clip_src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEADDROW_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    ScaleAddRow = ScaleAddRow_Any_AVX2;
+    if (IS_ALIGNED(clip_src_width, 32)) {
+      ScaleAddRow = ScaleAddRow_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_SCALEADDROW_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    ScaleAddRow = ScaleAddRow_Any_NEON;
+    if (IS_ALIGNED(clip_src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_NEON;
+    }
+  }
+#endif
+#if defined(HAS_SCALEADDROW_MMI)
+  if (TestCpuFlag(kCpuHasMMI)) {
+    ScaleAddRow = ScaleAddRow_Any_MMI;
+    if (IS_ALIGNED(clip_src_width, 8)) {
+      ScaleAddRow = ScaleAddRow_MMI;
+    }
+  }
+#endif
+#if defined(HAS_SCALEADDROW_MSA)
+  if (TestCpuFlag(kCpuHasMSA)) {
+    ScaleAddRow = ScaleAddRow_Any_MSA;
+    if (IS_ALIGNED(clip_src_width, 16)) {
+      ScaleAddRow = ScaleAddRow_MSA;
+    }
+  }
+#endif
+  s->row_bytes = clip_src_width;
+  s->ScaleAddRow = ScaleAddRow;
+  s->ScaleUVAddCols = ScaleUVAddCols;
+}
+
+static void ScaleUVBox(const ScaleUVScaler* s,
+                       int dst_height,
+                       int src_stride,
+                       int dst_stride,
+                       const uint8_t* src_uv,
+                       int src_y,
+                       uint8_t* dst_uv,
+                       int y,
+                       const LibyuvScratch* scratch) {
+  int j, k;
+  const int max_y = (Abs(s->src_height) << 16);
+  const int clip_src_width = s->row_bytes;
+  const int dy = s->dy;
+  {
+    // Allocate a row buffer of uint16_t sums of U and V.
+    align_buffer_64_scratch(row16, clip_src_width * 2, scratch);
+    for (j = 0; j < dst_height; ++j) {
+      int boxheight;
+      int iy = y >> 16;
+      const uint8_t* src = src_uv + (ptrdiff_t)(iy - src_y) * src_stride;
+      y += dy;
+      if (y > max_y) {
+        y = max_y;
+      }
+      boxheight = MIN1((y >> 16) - iy);
+      memset(row16, 0, clip_src_width * 2);
+      for (k = 0; k < boxheight; ++k) {
+        s->ScaleAddRow(src, (uint16_t*)(row16), clip_src_width);
+        src += src_stride;
+      }
+      s->ScaleUVAddCols(s->clip_width, boxheight, s->x, s->dx,
+                        (uint16_t*)(row16), dst_uv);
+      dst_uv += dst_stride;
+    }
+    free_aligned_buffer_64(row16);
+  }
+}
+#endif
+
+// Scale UV up with bilinear interpolation.
+#if HAS_SCALEUVBILINEARUP
+static void ScaleUVBilinearUpInit(ScaleUVScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const enum FilterMode filtering = s->filtering;
   void (*InterpolateRow)(uint8_t * dst_uv, const uint8_t* src_uv,
                          ptrdiff_t src_stride, int dst_width,
                          int source_y_fraction) = InterpolateRow_C;
   void (*ScaleUVFilterCols)(uint8_t * dst_uv, const uint8_t* src_uv,
                             int dst_width, int x, int dx) =
       filtering ? ScaleUVFilterCols_C : ScaleUVCols_C;
-  const int max_y = (src_height - 1) << 16;
 #if defined(HAS_INTERPOLATEROW_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3)) {
     InterpolateRow = InterpolateRow_Any_SSSE3;
@@ -595,6 +760,31 @@ static void ScaleUVBilinearUp(int src_width,
     }
 #endif
   }
+  s->InterpolateRow = InterpolateRow;
+  s->ScaleUVCols = ScaleUVFilterCols;
+}
+
+static void ScaleUVBilinearUp(const ScaleUVScaler* s,
+                              int dst_height,
+                              int src_stride,
+                              int dst_stride,
+                              const uint8_t* src_uv,
+                              int src_y,
+                              uint8_t* dst_uv,
+                              int y,
+                              const LibyuvScratch* scratch) {
+  int j;
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
+  const int dx = s->dx;
+  const int dy = s->dy;
+  const int max_y = (src_height - 1) << 16;
+  void (*InterpolateRow)(uint8_t * dst_uv, const uint8_t* src_uv,
+                         ptrdiff_t src_stride, int dst_width,
+                         int source_y_fraction) = s->InterpolateRow;
+  void (*ScaleUVFilterCols)(uint8_t * dst_uv, const uint8_t* src_uv,
+                            int dst_width, int x, int dx) = s->ScaleUVCols;
 
   if (y > max_y) {
     y = max_y;
@@ -602,18 +792,18 @@ static void ScaleUVBilinearUp(int src_width,
 
   {
     int yi = y >> 16;
-    const uint8_t* src = src_uv + yi * src_stride;
+    const uint8_t* src = src_uv + (ptrdiff_t)(yi - src_y) * src_stride;
 
     // Allocate 2 rows of UV.
     const int kRowSize = (dst_width * 2 + 15) & ~15;
-    align_buffer_64(row, kRowSize * 2);
+    align_buffer_64_scratch(row, kRowSize * 2, scratch);
 
     uint8_t* rowptr = row;
     int rowstride = kRowSize;
     int lasty = yi;
 
     ScaleUVFilterCols(rowptr, src, dst_width, x, dx);
-    if (src_height > 1) {
+    if (yi < src_height - 1) {
       src += src_stride;
     }
     ScaleUVFilterCols(rowptr + rowstride, src, dst_width, x, dx);
@@ -625,7 +815,7 @@ static void ScaleUVBilinearUp(int src_width,
         if (y > max_y) {
           y = max_y;
           yi = y >> 16;
-          src = src_uv + yi * src_stride;
+          src = src_uv + (ptrdiff_t)(yi - src_y) * src_stride;
         }
         if (yi != lasty) {
           ScaleUVFilterCols(rowptr, src, dst_width, x, dx);
@@ -635,7 +825,7 @@ static void ScaleUVBilinearUp(int src_width,
           src += src_stride;
         }
       }
-      if (filtering == kFilterLinear) {
+      if (s->filtering == kFilterLinear) {
         InterpolateRow(dst_uv, rowptr, 0, dst_width * 2, 0);
       } else {
         int yf = (y >> 8) & 255;
@@ -654,22 +844,12 @@ static void ScaleUVBilinearUp(int src_width,
 // This is an optimized version for scaling up a plane to 2 times of
 // its original width, using linear interpolation.
 // This is used to scale U and V planes of NV16 to NV24.
-void ScaleUVLinearUp2(int src_width,
-                      int src_height,
-                      int dst_width,
-                      int dst_height,
-                      int src_stride,
-                      int dst_stride,
-                      const uint8_t* src_uv,
-                      uint8_t* dst_uv) {
+static void ScaleUVLinearUp2Init(ScaleUVScaler* s) {
   void (*ScaleRowUp)(const uint8_t* src_uv, uint8_t* dst_uv, int dst_width) =
       ScaleUVRowUp2_Linear_Any_C;
-  int i;
-  int y;
-  int dy;
 
   // This function can only scale up by 2 times horizontally.
-  assert(src_width == ((dst_width + 1) / 2));
+  assert(s->src_width == ((s->dst_width + 1) / 2));
 
 #ifdef HAS_SCALEUVROWUP2LINEAR_SSSE3
   if (TestCpuFlag(kCpuHasSSSE3)) {
@@ -688,14 +868,34 @@ void ScaleUVLinearUp2(int src_width,
     ScaleRowUp = ScaleUVRowUp2_Linear_Any_NEON;
   }
 #endif
+  s->ScaleUVRowUp2 = ScaleRowUp;
+}
+
+static void ScaleUVLinearUp2(const ScaleUVScaler* s,
+                             int src_stride,
+                             int dst_stride,
+                             const uint8_t* src_uv,
+                             int src_y,
+                             uint8_t* dst_uv,
+                             int clip_y,
+                             int clip_height) {
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->dst_width;
+  const int dst_height = s->dst_height;
+  int i;
+  int y;
+  int dy;
 
   if (dst_height == 1) {
-    ScaleRowUp(src_uv + ((src_height - 1) / 2) * src_stride, dst_uv, dst_width);
+    s->ScaleUVRowUp2(
+        src_uv + (ptrdiff_t)((src_height - 1) / 2 - src_y) * src_stride,
+        dst_uv, dst_width);
   } else {
     dy = FixedDiv(src_height - 1, dst_height - 1);
-    y = (1 << 15) - 1;
-    for (i = 0; i < dst_height; ++i) {
-      ScaleRowUp(src_uv + (y >> 16) * src_stride, dst_uv, dst_width);
+    y = (int)((1 << 15) - 1 + (int64_t)(clip_y)*dy);
+    for (i = 0; i < clip_height; ++i) {
+      s->ScaleUVRowUp2(src_uv + (ptrdiff_t)((y >> 16) - src_y) * src_stride,
+                       dst_uv, dst_width);
       dst_uv += dst_stride;
       y += dy;
     }
@@ -706,22 +906,14 @@ void ScaleUVLinearUp2(int src_width,
 // This is an optimized version for scaling up a plane to 2 times of
 // its original size, using bilinear interpolation.
 // This is used to scale U and V planes of NV12 to NV24.
-void ScaleUVBilinearUp2(int src_width,
-                        int src_height,
-                        int dst_width,
-                        int dst_height,
-                        int src_stride,
-                        int dst_stride,
-                        const uint8_t* src_ptr,
-                        uint8_t* dst_ptr) {
+static void ScaleUVBilinearUp2Init(ScaleUVScaler* s) {
   void (*Scale2RowUp)(const uint8_t* src_ptr, ptrdiff_t src_stride,
                       uint8_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
       ScaleUVRowUp2_Bilinear_Any_C;
-  int x;
 
   // This function can only scale up by 2 times.
-  assert(src_width == ((dst_width + 1) / 2));
-  assert(src_height == ((dst_height + 1) / 2));
+  assert(s->src_width == ((s->dst_width + 1) / 2));
+  assert(Abs(s->src_height) == ((s->dst_height + 1) / 2));
 
 #ifdef HAS_SCALEUVROWUP2BILINEAR_SSSE3
   if (TestCpuFlag(kCpuHasSSSE3)) {
@@ -740,17 +932,43 @@ void ScaleUVBilinearUp2(int src_width,
     Scale2RowUp = ScaleUVRowUp2_Bilinear_Any_NEON;
   }
 #endif
+  s->Scale2RowUp2 = Scale2RowUp;
+}
+
+static void ScaleUVBilinearUp2(const ScaleUVScaler* s,
+                               int src_stride,
+                               int dst_stride,
+                               const uint8_t* src_ptr,
+                               int src_y,
+                               uint8_t* dst_ptr,
+                               int clip_y,
+                               int clip_height) {
+  void (*Scale2RowUp)(const uint8_t* src_ptr, ptrdiff_t src_stride,
+                      uint8_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
+      s->Scale2RowUp2;
+  const int src_height = Abs(s->src_height);
+  const int dst_width = s->dst_width;
+  int x;
 
-  Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
-  dst_ptr += dst_stride;
-  for (x = 0; x < src_height - 1; ++x) {
+  // As ScalePlaneUp2_Bilinear, destination rows 2x+1 and 2x+2 come from
+  // source rows x and x+1.
+  if (clip_y == 0) {
+    Scale2RowUp(src_ptr - (ptrdiff_t)src_y * src_stride, 0, dst_ptr, 0,
+                dst_width);
+    dst_ptr += dst_stride;
+    clip_y = 1;
+    --clip_height;
+  }
+  src_ptr += (ptrdiff_t)((clip_y >> 1) - src_y) * src_stride;
+  for (x = clip_y >> 1; x < src_height - 1 && clip_height >= 2; ++x) {
     Scale2RowUp(src_ptr, src_stride, dst_ptr, dst_stride, dst_width);
     src_ptr += src_stride;
     // TODO(fbarchard): Test performance of writing one row of destination at a
     // time.
     dst_ptr += 2 * dst_stride;
+    clip_height -= 2;
   }
-  if (!(dst_height & 1)) {
+  if (clip_height == 1) {
     Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
   }
 }
@@ -767,7 +985,9 @@ void ScaleUVLinearUp2_16(int src_width,
                          int src_stride,
                          int dst_stride,
                          const uint16_t* src_uv,
-                         uint16_t* dst_uv) {
+                         uint16_t* dst_uv,
+                         int clip_y,
+                         int clip_height) {
   void (*ScaleRowUp)(const uint16_t* src_uv, uint16_t* dst_uv, int dst_width) =
       ScaleUVRowUp2_Linear_16_Any_C;
   int i;
@@ -799,9 +1019,9 @@ void ScaleUVLinearUp2_16(int src_width,
     ScaleRowUp(src_uv + ((src_height - 1) / 2) * src_stride, dst_uv, dst_width);
   } else {
     dy = FixedDiv(src_height - 1, dst_height - 1);
-    y = (1 << 15) - 1;
-    for (i = 0; i < dst_height; ++i) {
-      ScaleRowUp(src_uv + (y >> 16) * src_stride, dst_uv, dst_width);
+    y = (int)((1 << 15) - 1 + (int64_t)(clip_y)*dy);
+    for (i = 0; i < clip_height; ++i) {
+      ScaleRowUp(src_uv + (ptrdiff_t)(y >> 16) * src_stride, dst_uv, dst_width);
       dst_uv += dst_stride;
       y += dy;
     }
@@ -819,7 +1039,9 @@ void ScaleUVBilinearUp2_16(int src_width,
                            int src_stride,
                            int dst_stride,
                            const uint16_t* src_ptr,
-                           uint16_t* dst_ptr) {
+                           uint16_t* dst_ptr,
+                           int clip_y,
+                           int clip_height) {
   void (*Scale2RowUp)(const uint16_t* src_ptr, ptrdiff_t src_stride,
                       uint16_t* dst_ptr, ptrdiff_t dst_stride, int dst_width) =
       ScaleUVRowUp2_Bilinear_16_Any_C;
@@ -847,16 +1069,26 @@ void ScaleUVBilinearUp2_16(int src_width,
   }
 #endif
 
-  Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
-  dst_ptr += dst_stride;
-  for (x = 0; x < src_height - 1; ++x) {
+  // Clips start on the first row or an odd row, and end on the last row or
+  // an odd row, as for ScaleUVBilinearUp2.
+  assert(clip_y == 0 || (clip_y & 1));
+  assert(clip_y + clip_height == dst_height || ((clip_y + clip_height) & 1));
+  if (clip_y == 0) {
+    Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
+    dst_ptr += dst_stride;
+    clip_y = 1;
+    --clip_height;
+  }
+  src_ptr += (ptrdiff_t)(clip_y >> 1) * src_stride;
+  for (x = clip_y >> 1; x < src_height - 1 && clip_height >= 2; ++x) {
     Scale2RowUp(src_ptr, src_stride, dst_ptr, dst_stride, dst_width);
     src_ptr += src_stride;
     // TODO(fbarchard): Test performance of writing one row of destination at a
     // time.
     dst_ptr += 2 * dst_stride;
+    clip_height -= 2;
   }
-  if (!(dst_height & 1)) {
+  if (clip_height == 1) {
     Scale2RowUp(src_ptr, 0, dst_ptr, 0, dst_width);
   }
 }
@@ -866,23 +1098,13 @@ void ScaleUVBilinearUp2_16(int src_width,
 // of x and dx is the integer part of the source position and
 // the lower 16 bits are the fixed decimal part.
 
-static void ScaleUVSimple(int src_width,
-                          int src_height,
-                          int dst_width,
-                          int dst_height,
-                          int src_stride,
-                          int dst_stride,
-                          const uint8_t* src_uv,
-                          uint8_t* dst_uv,
-                          int x,
-                          int dx,
-                          int y,
-                          int dy) {
-  int j;
+static void ScaleUVSimpleInit(ScaleUVScaler* s) {
+  const int src_width = Abs(s->src_width);
+  const int dst_width = s->clip_width;
+  const int x = s->x;
   void (*ScaleUVCols)(uint8_t * dst_uv, const uint8_t* src_uv, int dst_width,
                       int x, int dx) =
       (src_width >= 32768) ? ScaleUVCols64_C : ScaleUVCols_C;
-  (void)src_height;
 #if defined(HAS_SCALEUVCOLS_SSSE3)
   if (TestCpuFlag(kCpuHasSSSE3) && src_width < 32768) {
     ScaleUVCols = ScaleUVCols_SSSE3;
@@ -925,11 +1147,23 @@ static void ScaleUVSimple(int src_width,
     }
 #endif
   }
+  s->ScaleUVCols = ScaleUVCols;
+}
 
+static void ScaleUVSimple(const ScaleUVScaler* s,
+                          int dst_height,
+                          int src_stride,
+                          int dst_stride,
+                          const uint8_t* src_uv,
+                          int src_y,
+                          uint8_t* dst_uv,
+                          int y) {
+  int j;
   for (j = 0; j < dst_height; ++j) {
-    ScaleUVCols(dst_uv, src_uv + (y >> 16) * src_stride, dst_width, x, dx);
+    s->ScaleUVCols(dst_uv, src_uv + (ptrdiff_t)((y >> 16) - src_y) * src_stride,
+                   s->clip_width, s->x, s->dx);
     dst_uv += dst_stride;
-    y += dy;
+    y += s->dy;
   }
 }
 
@@ -976,93 +1210,197 @@ static int UVCopy_16(const uint16_t* src_UV,
 }
 #endif  // HAS_UVCOPY
 
-// Scale a UV plane (from NV12)
-// This function in turn calls a scaling function
-// suitable for handling the desired resolutions.
-static void ScaleUV(const uint8_t* src,
-                    int src_stride,
-                    int src_width,
-                    int src_height,
-                    uint8_t* dst,
-                    int dst_stride,
-                    int dst_width,
-                    int dst_height,
-                    int clip_x,
-                    int clip_y,
-                    int clip_width,
-                    int clip_height,
-                    enum FilterMode filtering) {
-  // Initial source x/y coordinate and step values as 16.16 fixed point.
-  int x = 0;
-  int y = 0;
-  int dx = 0;
-  int dy = 0;
-  // UV does not support box filter yet, but allow the user to pass it.
+// Scale 16 bit UV with bilinear or linear filtering.  Each destination row
+// interpolates a source row into a row buffer, which is then filtered
+// horizontally.  The row buffer has an extra pixel so the horizontal filter
+// may read 1 pixel beyond the right edge.
+static void ScaleUVBilinear_16(int src_width,
+                               int src_height,
+                               int dst_width,
+                               int dst_height,
+                               int src_stride,
+                               int dst_stride,
+                               const uint16_t* src_uv,
+                               uint16_t* dst_uv,
+                               int x,
+                               int dx,
+                               int y,
+                               int dy,
+                               enum FilterMode filtering,
+                               const LibyuvScratch* scratch) {
+  int j;
+  const int max_y = (src_height - 1) << 16;
+  void (*InterpolateRow)(uint16_t * dst_ptr, const uint16_t* src_ptr,
+                         ptrdiff_t src_stride, int dst_width,
+                         int source_y_fraction) = InterpolateRow_16_C;
+  void (*ScaleUVFilterCols)(uint16_t * dst_uv, const uint16_t* src_uv,
+                            int dst_width, int x, int dx) =
+      ScaleUVFilterCols_16_C;
+  align_buffer_64_scratch(row, (src_width + 1) * 4, scratch);
+  uint16_t* row16 = (uint16_t*)row;
+  if (!row) {
+    return;
+  }
+#if defined(HAS_INTERPOLATEROW_16_SSE2)
+  if (TestCpuFlag(kCpuHasSSE2)) {
+    InterpolateRow = InterpolateRow_16_Any_SSE2;
+    if (IS_ALIGNED(src_width * 2, 8)) {
+      InterpolateRow = InterpolateRow_16_SSE2;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2)) {
+    InterpolateRow = InterpolateRow_16_Any_AVX2;
+    if (IS_ALIGNED(src_width * 2, 16)) {
+      InterpolateRow = InterpolateRow_16_AVX2;
+    }
+  }
+#endif
+#if defined(HAS_INTERPOLATEROW_16_NEON)
+  if (TestCpuFlag(kCpuHasNEON)) {
+    InterpolateRow = InterpolateRow_16_Any_NEON;
+    if (IS_ALIGNED(src_width * 2, 8)) {
+      InterpolateRow = InterpolateRow_16_NEON;
+    }
+  }
+#endif
+#if defined(HAS_SCALEUVFILTERCOLS_16_AVX2)
+  if (TestCpuFlag(kCpuHasAVX2) && src_width < 32768) {
+    ScaleUVFilterCols = ScaleUVFilterCols_16_Any_AVX2;
+    if (IS_ALIGNED(dst_width, 8)) {
+      ScaleUVFilterCols = ScaleUVFilterCols_16_AVX2;
+    }
+  }
+#endif
+  if (y > max_y) {
+    y = max_y;
+  }
+  for (j = 0; j < dst_height; ++j) {
+    int yi = y >> 16;
+    int yf = (filtering == kFilterLinear) ? 0 : (y >> 8) & 255;
+    InterpolateRow(row16, src_uv + yi * src_stride, src_stride, src_width * 2,
+                   yf);
+    row16[src_width * 2 + 0] = row16[src_width * 2 - 2];
+    row16[src_width * 2 + 1] = row16[src_width * 2 - 1];
+    ScaleUVFilterCols(dst_uv, row16, dst_width, x, dx);
+    dst_uv += dst_stride;
+    y += dy;
+    if (y > max_y) {
+      y = max_y;
+    }
+  }
+  free_aligned_buffer_64(row);
+}
+
+// Scale 16 bit UV with point sampling.
+static void ScaleUVSimple_16(int dst_width,
+                             int dst_height,
+                             int src_stride,
+                             int dst_stride,
+                             const uint16_t* src_uv,
+                             uint16_t* dst_uv,
+                             int x,
+                             int dx,
+                             int y,
+                             int dy) {
+  int j;
+  for (j = 0; j < dst_height; ++j) {
+    ScaleUVCols_16_C(dst_uv, src_uv + (y >> 16) * src_stride, dst_width, x,
+                     dx);
+    dst_uv += dst_stride;
+    y += dy;
+  }
+}
+
+// Scale UV vertically, unscaled horizontally.
+static void ScaleUVVerticalInit(ScaleUVScaler* s) {
+  const struct RowKernels* kernels = GetRowKernels();
+  s->InterpolateRow = ROW_KERNEL(kernels, InterpolateRow, s->clip_width * 2);
+}
+
+// Choose the method and row functions of a UV scale, once for a geometry.
+static void ScaleUVScalerChoose(ScaleUVScaler* s,
+                                int src_width,
+                                int src_height,
+                                int dst_width,
+                                int dst_height,
+                                int clip_x,
+                                int clip_width,
+                                enum FilterMode filtering) {
   // Simplify filtering when possible.
   filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
                                 filtering);
-
-  // Negative src_height means invert the image.
-  if (src_height < 0) {
-    src_height = -src_height;
-    src = src + (src_height - 1) * src_stride;
-    src_stride = -src_stride;
+  memset(s, 0, sizeof(*s));
+  s->src_width = src_width;
+  s->src_height = src_height;
+  s->dst_width = dst_width;
+  s->dst_height = dst_height;
+  s->clip_x = clip_x;
+  s->clip_width = clip_width;
+  s->filtering = filtering;
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    s->method = kScaleUVPolyphase;
+    ScalePolyphaseInit(&s->polyphase, src_width, Abs(src_height), dst_width,
+                       dst_height, 2, filtering);
+    return;
   }
-  ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
-             &dx, &dy);
+  // Initial source x/y coordinate and step values as 16.16 fixed point.
+  ScaleSlope(src_width, Abs(src_height), dst_width, dst_height, filtering,
+             &s->x, &s->y, &s->dx, &s->dy);
   src_width = Abs(src_width);
+  src_height = Abs(src_height);
   if (clip_x) {
-    int64_t clipf = (int64_t)(clip_x)*dx;
-    x += (clipf & 0xffff);
-    src += (clipf >> 16) * 2;
-    dst += clip_x * 2;
-  }
-  if (clip_y) {
-    int64_t clipf = (int64_t)(clip_y)*dy;
-    y += (clipf & 0xffff);
-    src += (clipf >> 16) * src_stride;
-    dst += clip_y * dst_stride;
+    int64_t clipf = (int64_t)(clip_x)*s->dx;
+    s->x += (clipf & 0xffff);
+    s->src_offset = (int)(clipf >> 16) * 2;
   }
 
+#if HAS_SCALEUVBOX
+  // Box filter any scale factor other than the optimized 1/2 and 1/4.
+  if (filtering == kFilterBox &&
+      !(s->dx == s->dy && (s->dx == 0x20000 || s->dx == 0x40000))) {
+    s->method = kScaleUVBox;
+    ScaleUVBoxInit(s);
+    return;
+  }
+#endif
   // Special case for integer step values.
-  if (((dx | dy) & 0xffff) == 0) {
-    if (!dx || !dy) {  // 1 pixel wide and/or tall.
-      filtering = kFilterNone;
+  if (((s->dx | s->dy) & 0xffff) == 0) {
+    if (!s->dx || !s->dy) {  // 1 pixel wide and/or tall.
+      s->filtering = kFilterNone;
     } else {
       // Optimized even scale down. ie 2, 4, 6, 8, 10x.
-      if (!(dx & 0x10000) && !(dy & 0x10000)) {
+      if (!(s->dx & 0x10000) && !(s->dy & 0x10000)) {
 #if HAS_SCALEUVDOWN2
-        if (dx == 0x20000) {
+        if (s->dx == 0x20000) {
           // Optimized 1/2 downsample.
-          ScaleUVDown2(src_width, src_height, clip_width, clip_height,
-                       src_stride, dst_stride, src, dst, x, dx, y, dy,
-                       filtering);
+          s->method = kScaleUVDown2;
+          ScaleUVDown2Init(s);
           return;
         }
 #endif
 #if HAS_SCALEUVDOWN4BOX
-        if (dx == 0x40000 && filtering == kFilterBox) {
+        if (s->dx == 0x40000 && s->filtering == kFilterBox) {
           // Optimized 1/4 box downsample.
-          ScaleUVDown4Box(src_width, src_height, clip_width, clip_height,
-                          src_stride, dst_stride, src, dst, x, dx, y, dy);
+          s->method = kScaleUVDown4Box;
+          ScaleUVDown4BoxInit(s);
           return;
         }
 #endif
 #if HAS_SCALEUVDOWNEVEN
-        ScaleUVDownEven(src_width, src_height, clip_width, clip_height,
-                        src_stride, dst_stride, src, dst, x, dx, y, dy,
-                        filtering);
+        s->method = kScaleUVDownEven;
+        ScaleUVDownEvenInit(s);
         return;
 #endif
       }
       // Optimized odd scale down. ie 3, 5, 7, 9x.
-      if ((dx & 0x10000) && (dy & 0x10000)) {
-        filtering = kFilterNone;
+      if ((s->dx & 0x10000) && (s->dy & 0x10000)) {
+        s->filtering = kFilterNone;
 #ifdef HAS_UVCOPY
-        if (dx == 0x10000 && dy == 0x10000) {
+        if (s->dx == 0x10000 && s->dy == 0x10000) {
           // Straight copy.
-          UVCopy(src + (y >> 16) * src_stride + (x >> 16) * 2, src_stride, dst,
-                 dst_stride, clip_width, clip_height);
+          s->method = kScaleUVCopy;
           return;
         }
 #endif
@@ -1070,42 +1408,181 @@ static void ScaleUV(const uint8_t* src,
     }
   }
   // HAS_SCALEPLANEVERTICAL
-  if (dx == 0x10000 && (x & 0xffff) == 0) {
+  if (s->dx == 0x10000 && (s->x & 0xffff) == 0) {
     // Arbitrary scale vertically, but unscaled horizontally.
-    ScalePlaneVertical(src_height, clip_width, clip_height, src_stride,
-                       dst_stride, src, dst, x, y, dy, 4, filtering);
+    s->method = kScaleUVVertical;
+    ScaleUVVerticalInit(s);
     return;
   }
-  if (filtering && (dst_width + 1) / 2 == src_width) {
-    ScaleUVLinearUp2(src_width, src_height, clip_width, clip_height, src_stride,
-                     dst_stride, src, dst);
+  if (s->filtering && (dst_width + 1) / 2 == src_width &&
+      clip_width == dst_width) {
+    s->method = kScaleUVLinearUp2;
+    ScaleUVLinearUp2Init(s);
     return;
   }
-  if ((clip_height + 1) / 2 == src_height &&
-      (clip_width + 1) / 2 == src_width &&
-      (filtering == kFilterBilinear || filtering == kFilterBox)) {
-    ScaleUVBilinearUp2(src_width, src_height, clip_width, clip_height,
-                       src_stride, dst_stride, src, dst);
-    return;
+  // The 2x bilinear scaler scales clips on its row pairs.  Other clips use
+  // the general scaler chosen below.
+  if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
+      clip_width == dst_width &&
+      (s->filtering == kFilterBilinear || s->filtering == kFilterBox)) {
+    s->bilinear_up2 = 1;
+    ScaleUVBilinearUp2Init(s);
   }
 #if HAS_SCALEUVBILINEARUP
-  if (filtering && dy < 65536) {
-    ScaleUVBilinearUp(src_width, src_height, clip_width, clip_height,
-                      src_stride, dst_stride, src, dst, x, dx, y, dy,
-                      filtering);
+  if (s->filtering && s->dy < 65536) {
+    s->method = kScaleUVBilinearUp;
+    ScaleUVBilinearUpInit(s);
     return;
   }
 #endif
 #if HAS_SCALEUVBILINEARDOWN
-  if (filtering) {
-    ScaleUVBilinearDown(src_width, src_height, clip_width, clip_height,
-                        src_stride, dst_stride, src, dst, x, dx, y, dy,
-                        filtering);
+  if (s->filtering) {
+    s->method = kScaleUVBilinearDown;
+    ScaleUVBilinearDownInit(s);
+    return;
+  }
+#endif
+  s->method = kScaleUVSimple;
+  ScaleUVSimpleInit(s);
+}
+
+// Choose the scaler and build its polyphase tables, which it owns until
+// ScaleUVScalerFree, so that every call of ScaleUVScalerRows shares them.
+void ScaleUVScalerInit(ScaleUVScaler* s,
+                       int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       int clip_x,
+                       int clip_width,
+                       enum FilterMode filtering) {
+  ScaleUVScalerChoose(s, src_width, src_height, dst_width, dst_height, clip_x,
+                      clip_width, filtering);
+  if (s->method == kScaleUVPolyphase) {
+    ScalePolyphaseAllocTables(&s->polyphase);
+  }
+}
+
+void ScaleUVScalerFree(ScaleUVScaler* s) {
+  ScalePolyphaseFree(&s->polyphase);
+}
+
+void ScaleUVScalerRows(const ScaleUVScaler* s,
+                       const uint8_t* src,
+                       int src_stride,
+                       int src_y,
+                       uint8_t* dst,
+                       int dst_stride,
+                       int clip_y,
+                       int clip_height,
+                       const LibyuvScratch* scratch) {
+  const int clip_end = clip_y + clip_height;
+  int y;
+  assert(src_y == 0 || s->src_height > 0);
+  // Negative src_height means invert the image.
+  if (s->src_height < 0) {
+    src = src + (-s->src_height - 1) * src_stride;
+    src_stride = -src_stride;
+  }
+  if (s->method == kScaleUVPolyphase) {
+    ScalePolyphaseRows(&s->polyphase, src, src_stride, src_y, dst,
+                       dst_stride, s->clip_x, clip_y, s->clip_width,
+                       clip_height, scratch);
     return;
   }
+  if (s->bilinear_up2 && (clip_y == 0 || (clip_y & 1)) &&
+      (clip_end == s->dst_height || (clip_end & 1))) {
+    ScaleUVBilinearUp2(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                       clip_height);
+    return;
+  }
+  src += s->src_offset;
+  y = (int)(s->y + (int64_t)(clip_y)*s->dy);
+  switch (s->method) {
+#if HAS_SCALEUVBOX
+    case kScaleUVBox:
+      ScaleUVBox(s, clip_height, src_stride, dst_stride, src, src_y, dst, y,
+                 scratch);
+      break;
+#endif
+#if HAS_SCALEUVDOWN2
+    case kScaleUVDown2:
+      ScaleUVDown2(s, clip_height, src_stride, dst_stride, src, src_y, dst, y);
+      break;
+#endif
+#if HAS_SCALEUVDOWN4BOX
+    case kScaleUVDown4Box:
+      ScaleUVDown4Box(s, clip_height, src_stride, dst_stride, src, src_y, dst,
+                      y, scratch);
+      break;
+#endif
+#if HAS_SCALEUVDOWNEVEN
+    case kScaleUVDownEven:
+      ScaleUVDownEven(s, clip_height, src_stride, dst_stride, src, src_y, dst,
+                      y);
+      break;
+#endif
+#ifdef HAS_UVCOPY
+    case kScaleUVCopy:
+      UVCopy(src + (ptrdiff_t)((y >> 16) - src_y) * src_stride +
+                 (s->x >> 16) * 2,
+             src_stride, dst, dst_stride, s->clip_width, clip_height);
+      break;
+#endif
+    case kScaleUVVertical:
+      ScalePlaneVerticalRows(Abs(s->src_height), s->clip_width * 2,
+                             clip_height, src_stride, dst_stride,
+                             src + (s->x >> 16) * 2, src_y, dst, y, s->dy,
+                             s->filtering, s->InterpolateRow);
+      break;
+    case kScaleUVLinearUp2:
+      ScaleUVLinearUp2(s, src_stride, dst_stride, src, src_y, dst, clip_y,
+                       clip_height);
+      break;
+#if HAS_SCALEUVBILINEARUP
+    case kScaleUVBilinearUp:
+      ScaleUVBilinearUp(s, clip_height, src_stride, dst_stride, src, src_y, dst,
+                        y, scratch);
+      break;
+#endif
+#if HAS_SCALEUVBILINEARDOWN
+    case kScaleUVBilinearDown:
+      ScaleUVBilinearDown(s, clip_height, src_stride, dst_stride, src, src_y,
+                          dst, y, scratch);
+      break;
 #endif
-  ScaleUVSimple(src_width, src_height, clip_width, clip_height, src_stride,
-                dst_stride, src, dst, x, dx, y, dy);
+    default:
+      ScaleUVSimple(s, clip_height, src_stride, dst_stride, src, src_y, dst, y);
+      break;
+  }
+}
+
+// Scale a UV plane (from NV12)
+// This function in turn calls a scaling function
+// suitable for handling the desired resolutions.
+// dst points to the clip rectangle.  Rows are computed from the same source
+// position as for the whole plane, so that horizontal strips can be scaled
+// independently.
+void ScaleUV(const uint8_t* src,
+             int src_stride,
+             int src_width,
+             int src_height,
+             uint8_t* dst,
+             int dst_stride,
+             int dst_width,
+             int dst_height,
+             int clip_x,
+             int clip_y,
+             int clip_width,
+             int clip_height,
+             enum FilterMode filtering,
+             const LibyuvScratch* scratch) {
+  // A single call builds the polyphase tables in scratch instead.
+  ScaleUVScaler s;
+  ScaleUVScalerChoose(&s, src_width, src_height, dst_width, dst_height, clip_x,
+                      clip_width, filtering);
+  ScaleUVScalerRows(&s, src, src_stride, 0, dst, dst_stride, clip_y,
+                    clip_height, scratch);
 }
 
 // Scale an UV image.
@@ -1119,38 +1596,105 @@ int UVScale(const uint8_t* src_uv,
             int dst_width,
             int dst_height,
             enum FilterMode filtering) {
+  return UVScale_WithScratch(src_uv, src_stride_uv, src_width, src_height,
+                             dst_uv, dst_stride_uv, dst_width, dst_height,
+                             filtering, NULL);
+}
+
+LIBYUV_API
+int UVScale_WithScratch(const uint8_t* src_uv,
+                        int src_stride_uv,
+                        int src_width,
+                        int src_height,
+                        uint8_t* dst_uv,
+                        int dst_stride_uv,
+                        int dst_width,
+                        int dst_height,
+                        enum FilterMode filtering,
+                        const LibyuvScratch* scratch) {
   if (!src_uv || src_width <= 0 || src_height == 0 || src_width > 32768 ||
       src_height > 32768 || !dst_uv || dst_width <= 0 || dst_height <= 0) {
     return -1;
   }
   ScaleUV(src_uv, src_stride_uv, src_width, src_height, dst_uv, dst_stride_uv,
-          dst_width, dst_height, 0, 0, dst_width, dst_height, filtering);
+          dst_width, dst_height, 0, 0, dst_width, dst_height, filtering,
+          scratch);
   return 0;
 }
 
-// Scale a 16 bit UV image.
-// This function is currently incomplete, it can't handle all cases.
+// Largest row buffer allocated by the UV scalers.  The bilinear down
+// scaler buffers 2 rows of its clipped source width, and the box scaler 1
+// row of 16 bit sums.
 LIBYUV_API
-int UVScale_16(const uint16_t* src_uv,
-               int src_stride_uv,
-               int src_width,
-               int src_height,
-               uint16_t* dst_uv,
-               int dst_stride_uv,
-               int dst_width,
-               int dst_height,
-               enum FilterMode filtering) {
-  int dy = 0;
-
-  if (!src_uv || src_width <= 0 || src_height == 0 || src_width > 32768 ||
-      src_height > 32768 || !dst_uv || dst_width <= 0 || dst_height <= 0) {
-    return -1;
+int UVScaleScratchSize(int src_width,
+                       int src_height,
+                       int dst_width,
+                       int dst_height,
+                       enum FilterMode filtering) {
+  int down_size = (Abs(src_width) + 8) * 2 * 2;
+  int up_size = ((dst_width * 2 * 2 + 15) & ~15) * 2;
+  if (filtering == kFilterNone) {
+    return 0;
+  }
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    return ScalePolyphaseScratchSize(src_width, src_height, dst_width,
+                                     dst_height, 2, filtering);
   }
+  return (down_size > up_size ? down_size : up_size) + 63;
+}
 
-  // UV does not support box filter yet, but allow the user to pass it.
+// The filtering that a 16 bit UV scale uses.  The polyphase filters are 8 bit
+// only and box is not supported for 16 bit UV, so both are scaled as
+// bilinear or reduced further.
+static enum FilterMode UVScaleFilter_16(int src_width,
+                                        int src_height,
+                                        int dst_width,
+                                        int dst_height,
+                                        enum FilterMode filtering) {
+  if (filtering == kFilterBicubic || filtering == kFilterLanczos) {
+    filtering = kFilterBox;
+  }
   // Simplify filtering when possible.
-  filtering = ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
-                                filtering);
+  return ScaleFilterReduce(src_width, src_height, dst_width, dst_height,
+                           filtering);
+}
+
+// Whether a 16 bit UV scale uses ScaleUVBilinearUp2_16, whose clips must be
+// aligned.  src_height must be positive.
+static int UVScaleBilinearUp2_16(int src_width,
+                                 int src_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 enum FilterMode filtering) {
+#ifdef HAS_UVCOPY
+  if (!filtering && src_width == dst_width && (src_height % dst_height == 0)) {
+    return 0;
+  }
+#endif
+  if (filtering && (dst_width + 1) / 2 == src_width) {
+    return 0;
+  }
+  return (dst_height + 1) / 2 == src_height &&
+         (dst_width + 1) / 2 == src_width &&
+         (filtering == kFilterBilinear || filtering == kFilterBox);
+}
+
+void UVScaleClip_16(const uint16_t* src_uv,
+                    int src_stride_uv,
+                    int src_width,
+                    int src_height,
+                    uint16_t* dst_uv,
+                    int dst_stride_uv,
+                    int dst_width,
+                    int dst_height,
+                    int clip_y,
+                    int clip_height,
+                    enum FilterMode filtering,
+                    const LibyuvScratch* scratch) {
+  int dy = 0;
+
+  filtering = UVScaleFilter_16(src_width, src_height, dst_width, dst_height,
+                               filtering);
 
   // Negative src_height means invert the image.
   if (src_height < 0) {
@@ -1167,28 +1711,134 @@ int UVScale_16(const uint16_t* src_uv,
                 dst_uv, dst_stride_uv, dst_width, dst_height);
     } else {
       dy = src_height / dst_height;
-      UVCopy_16(src_uv + src_stride_uv * ((dy - 1) / 2), src_stride_uv * dy,
-                dst_uv, dst_stride_uv, dst_width, dst_height);
+      UVCopy_16(
+          src_uv + src_stride_uv * ((dy - 1) / 2 + (ptrdiff_t)clip_y * dy),
+          src_stride_uv * dy, dst_uv, dst_stride_uv, dst_width, clip_height);
     }
-
-    return 0;
+    return;
   }
 #endif
 
   if (filtering && (dst_width + 1) / 2 == src_width) {
     ScaleUVLinearUp2_16(src_width, src_height, dst_width, dst_height,
-                        src_stride_uv, dst_stride_uv, src_uv, dst_uv);
-    return 0;
+                        src_stride_uv, dst_stride_uv, src_uv, dst_uv, clip_y,
+                        clip_height);
+    return;
   }
 
-  if ((dst_height + 1) / 2 == src_height && (dst_width + 1) / 2 == src_width &&
-      (filtering == kFilterBilinear || filtering == kFilterBox)) {
+  if (UVScaleBilinearUp2_16(src_width, src_height, dst_width, dst_height,
+                            filtering)) {
     ScaleUVBilinearUp2_16(src_width, src_height, dst_width, dst_height,
-                          src_stride_uv, dst_stride_uv, src_uv, dst_uv);
-    return 0;
+                          src_stride_uv, dst_stride_uv, src_uv, dst_uv, clip_y,
+                          clip_height);
+    return;
+  }
+
+  // Other sizes.  Box is not supported for 16 bit UV and is treated as
+  // bilinear.
+  {
+    int x = 0;
+    int y = 0;
+    int dx = 0;
+    if (filtering == kFilterBox) {
+      filtering = kFilterBilinear;
+    }
+    ScaleSlope(src_width, src_height, dst_width, dst_height, filtering, &x, &y,
+               &dx, &dy);
+    y = (int)(y + (int64_t)(clip_y)*dy);
+    if (dx == 0x10000 && (x & 0xffff) == 0) {
+      // Arbitrary scale vertically, but unscaled horizontally.
+      ScalePlaneVertical_16(src_height, dst_width, clip_height, src_stride_uv,
+                            dst_stride_uv, src_uv, dst_uv, x, y, dy, 2,
+                            filtering);
+    } else if (filtering) {
+      ScaleUVBilinear_16(src_width, src_height, dst_width, clip_height,
+                         src_stride_uv, dst_stride_uv, src_uv, dst_uv, x, dx,
+                         y, dy, filtering, scratch);
+    } else {
+      ScaleUVSimple_16(dst_width, clip_height, src_stride_uv, dst_stride_uv,
+                       src_uv, dst_uv, x, dx, y, dy);
+    }
+  }
+}
+
+void UVScaleClipAlign_16(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         enum FilterMode filtering,
+                         int* align,
+                         int* offset) {
+  filtering = UVScaleFilter_16(src_width, src_height, dst_width, dst_height,
+                               filtering);
+  if (UVScaleBilinearUp2_16(Abs(src_width), Abs(src_height), dst_width,
+                            dst_height, filtering)) {
+    *align = 2;
+    *offset = 1;
+  } else {
+    *align = 1;
+    *offset = 0;
+  }
+}
+
+// Scale a 16 bit UV image.
+// This function is currently incomplete, it can't handle all cases.
+LIBYUV_API
+int UVScale_16(const uint16_t* src_uv,
+               int src_stride_uv,
+               int src_width,
+               int src_height,
+               uint16_t* dst_uv,
+               int dst_stride_uv,
+               int dst_width,
+               int dst_height,
+               enum FilterMode filtering) {
+  if (!src_uv || src_width <= 0 || src_height == 0 || src_width > 32768 ||
+      src_height > 32768 || !dst_uv || dst_width <= 0 || dst_height <= 0) {
+    return -1;
+  }
+  UVScaleClip_16(src_uv, src_stride_uv, src_width, src_height, dst_uv,
+                 dst_stride_uv, dst_width, dst_height, 0, dst_height, filtering,
+                 NULL);
+  return 0;
+}
+
+LIBYUV_API
+int UVScale_16_WithScratch(const uint16_t* src_uv,
+                           int src_stride_uv,
+                           int src_width,
+                           int src_height,
+                           uint16_t* dst_uv,
+                           int dst_stride_uv,
+                           int dst_width,
+                           int dst_height,
+                           enum FilterMode filtering,
+                           const LibyuvScratch* scratch) {
+  if (!src_uv || src_width <= 0 || src_height == 0 || src_width > 32768 ||
+      src_height > 32768 || !dst_uv || dst_width <= 0 || dst_height <= 0) {
+    return -1;
   }
+  UVScaleClip_16(src_uv, src_stride_uv, src_width, src_height, dst_uv,
+                 dst_stride_uv, dst_width, dst_height, 0, dst_height, filtering,
+                 scratch);
+  return 0;
+}
 
-  return -1;
+// The 16 bit bilinear scaler buffers one source row of UV pixels, plus one
+// pixel for its horizontal filter.
+LIBYUV_API
+int UVScaleScratchSize_16(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          enum FilterMode filtering) {
+  (void)src_height;
+  (void)dst_width;
+  (void)dst_height;
+  if (filtering == kFilterNone) {
+    return 0;
+  }
+  return (Abs(src_width) + 1) * 4 + 63;
 }
 
 #ifdef __cplusplus
@@ -0,0 +1,399 @@
+/*
+ *  Copyright 2026 The LibYuv Project Authors. All rights reserved.
+ *
+ *  Use of this source code is governed by a BSD-style license
+ *  that can be found in the LICENSE file in the root of the source
+ *  tree. An additional intellectual property rights grant can be found
+ *  in the file PATENTS. All contributing project authors may
+ *  be found in the AUTHORS file in the root of the source tree.
+ */
+
+#include "libyuv/slice.h"
+
+#include <stdlib.h>  // For malloc.
+
+#include "libyuv/planar_functions.h"  // For CopyPlane.
+#include "libyuv/scale_row.h"         // For ScaleBandPlane.
+#include "libyuv/scale_uv.h"          // For UVScaleScratchSize.
+
+#ifdef __cplusplus
+namespace libyuv {
+extern "C" {
+#endif
+
+enum SliceKind {
+  kSliceI420Scale,
+  kSliceNV12Scale,
+  kSliceI420ToARGB,
+  kSliceNV12ToARGB,
+};
+
+struct SliceContext {
+  enum SliceKind kind;
+  int src_width;
+  int src_height;
+  int dst_width;
+  int dst_height;
+  int max_rows;
+  int src_y;  // Source rows of the frame received so far.
+  const struct YuvConstants* yuvconstants;
+  // Scalers: Y, U and V, or Y and interleaved UV for NV12.
+  ScaleBandPlane planes[3];
+  int num_planes;
+  uint8_t* rings;  // Polyphase rings of the planes, or NULL.
+  LibyuvScratch scratch;
+};
+
+static SliceContext* SliceScaleCreate(enum SliceKind kind,
+                                      int src_width,
+                                      int src_height,
+                                      int dst_width,
+                                      int dst_height,
+                                      enum FilterMode filtering,
+                                      int max_slice_rows) {
+  const int src_halfwidth = (src_width + 1) >> 1;
+  const int src_halfheight = (src_height + 1) >> 1;
+  const int dst_halfwidth = (dst_width + 1) >> 1;
+  const int dst_halfheight = (dst_height + 1) >> 1;
+  // NV12 scales its UV plane as one plane of 2 byte pixels.
+  const int num_planes = kind == kSliceNV12Scale ? 2 : 3;
+  const int uv_bpp = kind == kSliceNV12Scale ? 2 : 1;
+  size_t size = sizeof(SliceContext);
+  int scratch_size;
+  int uv_scratch_size;
+  ScaleBandPlane planes[3];
+  SliceContext* slice;
+  uint8_t* ptr;
+  int i;
+  if (src_width <= 0 || src_height <= 0 || src_width > 32768 ||
+      src_height > 32768 || dst_width <= 0 || dst_height <= 0 ||
+      max_slice_rows <= 0) {
+    return NULL;
+  }
+  scratch_size = ScalePlaneScratchSize(src_width, src_height, dst_width,
+                                       dst_height, filtering);
+  uv_scratch_size =
+      uv_bpp == 2 ? UVScaleScratchSize(src_halfwidth, src_halfheight,
+                                       dst_halfwidth, dst_halfheight, filtering)
+                  : ScalePlaneScratchSize(src_halfwidth, src_halfheight,
+                                          dst_halfwidth, dst_halfheight,
+                                          filtering);
+  if (uv_scratch_size > scratch_size) {
+    scratch_size = uv_scratch_size;
+  }
+  // Set up the planes, which build their polyphase tables once for every
+  // frame of the context, to learn their window sizes.
+  for (i = 0; i < num_planes; ++i) {
+    ScaleBandPlaneInit(&planes[i], i ? src_halfwidth : src_width,
+                       i ? src_halfheight : src_height,
+                       i ? (max_slice_rows + 1) >> 1 : max_slice_rows,
+                       i ? dst_halfwidth : dst_width,
+                       i ? dst_halfheight : dst_height, i ? uv_bpp : 1,
+                       filtering, NULL);
+    size += (size_t)planes[i].src_stride * planes[i].window_rows;
+  }
+  slice = (SliceContext*)malloc(size + scratch_size);
+  if (!slice) {
+    for (i = 0; i < num_planes; ++i) {
+      ScaleBandPlaneFree(&planes[i]);
+    }
+    return NULL;
+  }
+  slice->rings = NULL;
+  slice->kind = kind;
+  slice->src_width = src_width;
+  slice->src_height = src_height;
+  slice->dst_width = dst_width;
+  slice->dst_height = dst_height;
+  slice->max_rows = max_slice_rows;
+  slice->src_y = 0;
+  slice->yuvconstants = NULL;
+  slice->num_planes = num_planes;
+  for (i = 0; i < num_planes; ++i) {
+    slice->planes[i] = planes[i];
+    slice->planes[i].scratch = &slice->scratch;
+  }
+  {
+    size_t rings_size = 0;
+    for (i = 0; i < num_planes; ++i) {
+      rings_size += (size_t)slice->planes[i].ring_size;
+    }
+    if (rings_size) {
+      slice->rings = (uint8_t*)malloc(rings_size + 63);
+    }
+    if (slice->rings) {
+      ptr = (uint8_t*)(((uintptr_t)slice->rings + 63) & ~(uintptr_t)63);
+      for (i = 0; i < num_planes; ++i) {
+        ScaleBandPlaneRing(&slice->planes[i], ptr);
+        ptr += slice->planes[i].ring_size;
+      }
+    }
+  }
+  ptr = (uint8_t*)(slice + 1);
+  for (i = 0; i < num_planes; ++i) {
+    slice->planes[i].window = ptr;
+    ptr += slice->planes[i].src_stride * slice->planes[i].window_rows;
+  }
+  slice->scratch.buffer = scratch_size ? ptr : NULL;
+  slice->scratch.size = (size_t)scratch_size;
+  return slice;
+}
+
+LIBYUV_API
+SliceContext* I420ScaleSliceCreate(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   enum FilterMode filtering,
+                                   int max_slice_rows) {
+  return SliceScaleCreate(kSliceI420Scale, src_width, src_height, dst_width,
+                          dst_height, filtering, max_slice_rows);
+}
+
+LIBYUV_API
+SliceContext* NV12ScaleSliceCreate(int src_width,
+                                   int src_height,
+                                   int dst_width,
+                                   int dst_height,
+                                   enum FilterMode filtering,
+                                   int max_slice_rows) {
+  return SliceScaleCreate(kSliceNV12Scale, src_width, src_height, dst_width,
+                          dst_height, filtering, max_slice_rows);
+}
+
+static SliceContext* SliceConvertCreate(enum SliceKind kind,
+                                        const struct YuvConstants* yuvconstants,
+                                        int width,
+                                        int height) {
+  SliceContext* slice;
+  if (!yuvconstants || width <= 0 || height <= 0) {
+    return NULL;
+  }
+  slice = (SliceContext*)malloc(sizeof(SliceContext));
+  if (!slice) {
+    return NULL;
+  }
+  slice->kind = kind;
+  slice->src_width = width;
+  slice->src_height = height;
+  slice->dst_width = width;
+  slice->dst_height = height;
+  slice->max_rows = height;
+  slice->src_y = 0;
+  slice->yuvconstants = yuvconstants;
+  slice->num_planes = 0;
+  slice->rings = NULL;
+  return slice;
+}
+
+LIBYUV_API
+SliceContext* I420ToARGBSliceCreate(const struct YuvConstants* yuvconstants,
+                                    int width,
+                                    int height) {
+  return SliceConvertCreate(kSliceI420ToARGB, yuvconstants, width, height);
+}
+
+LIBYUV_API
+SliceContext* NV12ToARGBSliceCreate(const struct YuvConstants* yuvconstants,
+                                    int width,
+                                    int height) {
+  return SliceConvertCreate(kSliceNV12ToARGB, yuvconstants, width, height);
+}
+
+LIBYUV_API
+void SliceFree(SliceContext* slice) {
+  int i;
+  if (slice) {
+    for (i = 0; i < slice->num_planes; ++i) {
+      ScaleBandPlaneFree(&slice->planes[i]);
+    }
+    free(slice->rings);
+    free(slice);
+  }
+}
+
+LIBYUV_API
+void SliceReset(SliceContext* slice) {
+  int i;
+  if (!slice) {
+    return;
+  }
+  slice->src_y = 0;
+  for (i = 0; i < slice->num_planes; ++i) {
+    ScaleBandPlaneReset(&slice->planes[i]);
+  }
+}
+
+// Returns whether the next band of a frame may have src_rows rows: bands
+// start on even rows so that they start on a chroma row.
+static LIBYUV_BOOL SliceRowsValid(const SliceContext* slice, int src_rows) {
+  return src_rows > 0 && src_rows <= slice->max_rows &&
+         src_rows <= slice->src_height - slice->src_y &&
+         (!(src_rows & 1) || slice->src_y + src_rows == slice->src_height);
+}
+
+// Start a new frame after the last destination row.
+static int SliceFinish(SliceContext* slice, int dst_rows) {
+  if (dst_rows == slice->dst_height) {
+    SliceReset(slice);
+  }
+  return dst_rows;
+}
+
+// Destination rows with Y, U and V all scaled.
+static int SliceScaledRows(const SliceContext* slice) {
+  int rows = slice->planes[0].dst_y;
+  int uv_rows = slice->planes[1].dst_y * 2;
+  if (uv_rows > slice->dst_height) {
+    uv_rows = slice->dst_height;
+  }
+  return rows < uv_rows ? rows : uv_rows;
+}
+
+// Scale each destination row of a plane that its window covers.
+static void SliceScalePlane(ScaleBandPlane* p, uint8_t* dst, int dst_stride) {
+  int n;
+  while ((n = ScaleBandHeight(p, p->dst_height)) > 0) {
+    ScaleBandRows(p, dst + (ptrdiff_t)p->dst_y * dst_stride, dst_stride, n);
+  }
+}
+
+LIBYUV_API
+int I420ScaleSlice(SliceContext* slice,
+                   const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_u,
+                   int src_stride_u,
+                   const uint8_t* src_v,
+                   int src_stride_v,
+                   int src_rows,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_u,
+                   int dst_stride_u,
+                   uint8_t* dst_v,
+                   int dst_stride_v) {
+  const int uv_rows = (src_rows + 1) >> 1;
+  ScaleBandPlane* planes;
+  uint8_t* window_y;
+  uint8_t* window_u;
+  uint8_t* window_v;
+  if (!slice || slice->kind != kSliceI420Scale || !src_y || !src_u ||
+      !src_v || !dst_y || !dst_u || !dst_v ||
+      !SliceRowsValid(slice, src_rows)) {
+    return -1;
+  }
+  planes = slice->planes;
+  window_y = ScaleBandAppend(&planes[0], src_rows);
+  window_u = ScaleBandAppend(&planes[1], uv_rows);
+  window_v = ScaleBandAppend(&planes[2], uv_rows);
+  if (!window_y || !window_u || !window_v) {
+    SliceReset(slice);
+    return -1;
+  }
+  CopyPlane(src_y, src_stride_y, window_y, planes[0].src_width,
+            planes[0].src_width, src_rows);
+  CopyPlane(src_u, src_stride_u, window_u, planes[1].src_width,
+            planes[1].src_width, uv_rows);
+  CopyPlane(src_v, src_stride_v, window_v, planes[2].src_width,
+            planes[2].src_width, uv_rows);
+  slice->src_y += src_rows;
+  SliceScalePlane(&planes[0], dst_y, dst_stride_y);
+  SliceScalePlane(&planes[1], dst_u, dst_stride_u);
+  SliceScalePlane(&planes[2], dst_v, dst_stride_v);
+  return SliceFinish(slice, SliceScaledRows(slice));
+}
+
+LIBYUV_API
+int NV12ScaleSlice(SliceContext* slice,
+                   const uint8_t* src_y,
+                   int src_stride_y,
+                   const uint8_t* src_uv,
+                   int src_stride_uv,
+                   int src_rows,
+                   uint8_t* dst_y,
+                   int dst_stride_y,
+                   uint8_t* dst_uv,
+                   int dst_stride_uv) {
+  const int uv_rows = (src_rows + 1) >> 1;
+  ScaleBandPlane* planes;
+  uint8_t* window_y;
+  uint8_t* window_uv;
+  if (!slice || slice->kind != kSliceNV12Scale || !src_y || !src_uv ||
+      !dst_y || !dst_uv || !SliceRowsValid(slice, src_rows)) {
+    return -1;
+  }
+  planes = slice->planes;
+  window_y = ScaleBandAppend(&planes[0], src_rows);
+  window_uv = ScaleBandAppend(&planes[1], uv_rows);
+  if (!window_y || !window_uv) {
+    SliceReset(slice);
+    return -1;
+  }
+  CopyPlane(src_y, src_stride_y, window_y, planes[0].src_width,
+            planes[0].src_width, src_rows);
+  CopyPlane(src_uv, src_stride_uv, window_uv, planes[1].src_stride,
+            planes[1].src_stride, uv_rows);
+  slice->src_y += src_rows;
+  SliceScalePlane(&planes[0], dst_y, dst_stride_y);
+  SliceScalePlane(&planes[1], dst_uv, dst_stride_uv);
+  return SliceFinish(slice, SliceScaledRows(slice));
+}
+
+LIBYUV_API
+int I420ToARGBSlice(SliceContext* slice,
+                    const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_u,
+                    int src_stride_u,
+                    const uint8_t* src_v,
+                    int src_stride_v,
+                    int src_rows,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb) {
+  int r;
+  if (!slice || slice->kind != kSliceI420ToARGB || !dst_argb ||
+      !SliceRowsValid(slice, src_rows)) {
+    return -1;
+  }
+  r = I420ToARGBMatrix(src_y, src_stride_y, src_u, src_stride_u, src_v,
+                       src_stride_v,
+                       dst_argb + (ptrdiff_t)slice->src_y * dst_stride_argb,
+                       dst_stride_argb, slice->yuvconstants, slice->src_width,
+                       src_rows);
+  if (r) {
+    return -1;
+  }
+  slice->src_y += src_rows;
+  return SliceFinish(slice, slice->src_y);
+}
+
+LIBYUV_API
+int NV12ToARGBSlice(SliceContext* slice,
+                    const uint8_t* src_y,
+                    int src_stride_y,
+                    const uint8_t* src_uv,
+                    int src_stride_uv,
+                    int src_rows,
+                    uint8_t* dst_argb,
+                    int dst_stride_argb) {
+  int r;
+  if (!slice || slice->kind != kSliceNV12ToARGB || !dst_argb ||
+      !SliceRowsValid(slice, src_rows)) {
+    return -1;
+  }
+  r = NV12ToARGBMatrix(src_y, src_stride_y, src_uv, src_stride_uv,
+                       dst_argb + (ptrdiff_t)slice->src_y * dst_stride_argb,
+                       dst_stride_argb, slice->yuvconstants, slice->src_width,
+                       src_rows);
+  if (r) {
+    return -1;
+  }
+  slice->src_y += src_rows;
+  return SliceFinish(slice, slice->src_y);
+}
+
+#ifdef __cplusplus
+}  // extern "C"
+}  // namespace libyuv
+#endif
@@ -407,6 +407,48 @@ TEST_F(LibYUVCompareTest, TestHammingDistance_Opt) {
   free_aligned_buffer_page_end(src_a);
   free_aligned_buffer_page_end(src_b);
 }
+
+TEST_F(LibYUVCompareTest, TestSsim8x8_Opt) {
+  const int kStride = 64;
+  align_buffer_page_end(src_a, kStride * 8);
+  align_buffer_page_end(src_b, kStride * 8);
+  for (int n = 0; n < 1000; ++n) {
+    for (int i = 0; i < kStride * 8; ++i) {
+      // Include flat blocks of the extreme values.
+      src_a[i] = n == 0 ? 255 : (n == 1 ? 0 : (fastrand() & 0xff));
+      src_b[i] = n == 0 ? 255 : (n == 1 ? 255 : (fastrand() & 0xff));
+    }
+    int offset = n & 31;
+    double ssim_c = Ssim8x8_C(src_a + offset, kStride, src_b + offset, kStride);
+    double ssim_opt = ssim_c;
+#if defined(HAS_SSIM8X8_NEON)
+    int has_neon = TestCpuFlag(kCpuHasNEON);
+    if (has_neon) {
+      ssim_opt =
+          Ssim8x8_NEON(src_a + offset, kStride, src_b + offset, kStride);
+    }
+    EXPECT_EQ(ssim_c, ssim_opt);
+#endif
+#if defined(HAS_SSIM8X8_SSE41)
+    int has_sse41 = TestCpuFlag(kCpuHasSSE41);
+    if (has_sse41) {
+      ssim_opt =
+          Ssim8x8_SSE41(src_a + offset, kStride, src_b + offset, kStride);
+    }
+    EXPECT_EQ(ssim_c, ssim_opt);
+#endif
+#if defined(HAS_SSIM8X8_AVX2)
+    int has_avx2 = TestCpuFlag(kCpuHasAVX2);
+    if (has_avx2) {
+      ssim_opt =
+          Ssim8x8_AVX2(src_a + offset, kStride, src_b + offset, kStride);
+    }
+#endif
+    EXPECT_EQ(ssim_c, ssim_opt);
+  }
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
 #endif  // ENABLE_ROW_TESTS
 
 TEST_F(LibYUVCompareTest, TestHammingDistance) {
@@ -736,4 +778,87 @@ TEST_F(LibYUVCompareTest, Ssim) {
   free_aligned_buffer_page_end(src_b);
 }
 
+// Compare threaded I420 PSNR and SSIM against single threaded.  Results must
+// be identical, not just close.
+static void TestI420CompareThreaded(int width, int height, int num_jobs) {
+  const int kHalfWidth = (width + 1) / 2;
+  const int kHalfHeight = (height + 1) / 2;
+  const int kYSize = width * height;
+  const int kUVSize = kHalfWidth * kHalfHeight;
+  align_buffer_page_end(src_a, kYSize + kUVSize * 2);
+  align_buffer_page_end(src_b, kYSize + kUVSize * 2);
+  for (int i = 0; i < kYSize + kUVSize * 2; ++i) {
+    src_a[i] = fastrand() & 0xff;
+    src_b[i] = (src_a[i] + (fastrand() & 7)) & 0xff;
+  }
+  const uint8_t* src_u_a = src_a + kYSize;
+  const uint8_t* src_v_a = src_u_a + kUVSize;
+  const uint8_t* src_u_b = src_b + kYSize;
+  const uint8_t* src_v_b = src_u_b + kUVSize;
+
+  double psnr = I420Psnr(src_a, width, src_u_a, kHalfWidth, src_v_a,
+                         kHalfWidth, src_b, width, src_u_b, kHalfWidth,
+                         src_v_b, kHalfWidth, width, height);
+  double ssim = I420Ssim(src_a, width, src_u_a, kHalfWidth, src_v_a,
+                         kHalfWidth, src_b, width, src_u_b, kHalfWidth,
+                         src_v_b, kHalfWidth, width, height);
+  int num_calls = 0;
+  double psnr_threaded = I420PsnrThreaded(
+      src_a, width, src_u_a, kHalfWidth, src_v_a, kHalfWidth, src_b, width,
+      src_u_b, kHalfWidth, src_v_b, kHalfWidth, width, height, num_jobs,
+      TestDispatch, &num_calls);
+  double ssim_threaded = I420SsimThreaded(
+      src_a, width, src_u_a, kHalfWidth, src_v_a, kHalfWidth, src_b, width,
+      src_u_b, kHalfWidth, src_v_b, kHalfWidth, width, height, num_jobs,
+      TestDispatch, &num_calls);
+  EXPECT_EQ(psnr, psnr_threaded);
+  EXPECT_EQ(ssim, ssim_threaded);
+  if (num_jobs > 1 && height > 12) {
+    EXPECT_EQ(2, num_calls);
+  }
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
+TEST_F(LibYUVCompareTest, I420CompareThreaded) {
+  TestI420CompareThreaded(benchmark_width_, benchmark_height_, 4);
+  TestI420CompareThreaded(benchmark_width_ + 3, benchmark_height_ + 5, 7);
+  TestI420CompareThreaded(benchmark_width_, benchmark_height_, 1);
+  TestI420CompareThreaded(33, 17, 64);
+}
+
+TEST_F(LibYUVCompareTest, BenchmarkI420SsimThreaded_Opt) {
+  const int kHalfWidth = (benchmark_width_ + 1) / 2;
+  const int kHalfHeight = (benchmark_height_ + 1) / 2;
+  const int kYSize = benchmark_width_ * benchmark_height_;
+  const int kUVSize = kHalfWidth * kHalfHeight;
+  align_buffer_page_end(src_a, kYSize + kUVSize * 2);
+  align_buffer_page_end(src_b, kYSize + kUVSize * 2);
+  for (int i = 0; i < kYSize + kUVSize * 2; ++i) {
+    src_a[i] = fastrand() & 0xff;
+    src_b[i] = fastrand() & 0xff;
+  }
+
+  MaskCpuFlags(benchmark_cpu_info_);
+
+  int num_calls = 0;
+  double opt_time = get_time();
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    I420SsimThreaded(src_a, benchmark_width_, src_a + kYSize, kHalfWidth,
+                     src_a + kYSize + kUVSize, kHalfWidth, src_b,
+                     benchmark_width_, src_b + kYSize, kHalfWidth,
+                     src_b + kYSize + kUVSize, kHalfWidth, benchmark_width_,
+                     benchmark_height_, 4, TestDispatch, &num_calls);
+  }
+
+  opt_time = (get_time() - opt_time) / benchmark_iterations_;
+  printf("BenchmarkI420SsimThreaded_Opt - %8.2f us opt\n", opt_time * 1e6);
+
+  EXPECT_EQ(0, 0);  // Pass if we get this far.
+
+  free_aligned_buffer_page_end(src_a);
+  free_aligned_buffer_page_end(src_b);
+}
+
 }  // namespace libyuv
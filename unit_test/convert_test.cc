@@ -9,6 +9,7 @@
  */
 
 #include <assert.h>
+#include <math.h>
 #include <stdlib.h>
 #include <time.h>
 
@@ -20,11 +21,19 @@
 #include "libyuv/convert_from_argb.h"
 #include "libyuv/cpu_id.h"
 #ifdef HAVE_JPEG
+#include <stdio.h>  // For jpeglib.h.
+
 #include "libyuv/mjpeg_decoder.h"
+extern "C" {
+#include <jpeglib.h>
+}
 #endif
 #include "../unit_test/unit_test.h"
 #include "libyuv/planar_functions.h"
 #include "libyuv/rotate.h"
+#include "libyuv/rotate_argb.h"
+#include "libyuv/scale.h"
+#include "libyuv/slice.h"
 #include "libyuv/video_common.h"
 
 #ifdef ENABLE_ROW_TESTS
@@ -522,6 +531,95 @@ TESTBIPLANARTOBP(P212, uint16_t, 2, 2, 1, P412, uint16_t, 2, 1, 1, 12)
 TESTBIPLANARTOBP(P016, uint16_t, 2, 2, 2, P416, uint16_t, 2, 1, 1, 12)
 TESTBIPLANARTOBP(P216, uint16_t, 2, 2, 1, P416, uint16_t, 2, 1, 1, 12)
 
+// Tile a plane like MM21: 16 byte wide tiles of tile_height rows.
+static void TileMM21(const uint8_t* src,
+                     int src_stride,
+                     uint8_t* dst,
+                     int dst_stride,
+                     int width,
+                     int height,
+                     int tile_height) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      dst[(y / tile_height) * tile_height * dst_stride +
+          (x / 16) * 16 * tile_height + (y % tile_height) * 16 + x % 16] =
+          src[y * src_stride + x];
+    }
+  }
+}
+
+// Convert NV12 to MM21 and back to NV12, I420 and ARGB.
+TEST_F(LibYUVConvertTest, MM21ToNV12) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_ | 1;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  const int kTileStride = (kWidth + 15) & ~15;
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_uv, kHalfWidth * 2 * kHalfHeight);
+  align_buffer_page_end(tile_y, kTileStride * ((kHeight + 31) & ~31));
+  align_buffer_page_end(tile_uv, kTileStride * ((kHalfHeight + 15) & ~15));
+  align_buffer_page_end(dst_y, kWidth * kHeight);
+  align_buffer_page_end(dst_uv, kHalfWidth * 2 * kHalfHeight);
+  align_buffer_page_end(dst_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(dst_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(ref_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(ref_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(dst_argb, kWidth * 4 * kHeight);
+  align_buffer_page_end(ref_argb, kWidth * 4 * kHeight);
+
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_uv, kHalfWidth * 2 * kHalfHeight);
+  memset(tile_y, 0, kTileStride * ((kHeight + 31) & ~31));
+  memset(tile_uv, 0, kTileStride * ((kHalfHeight + 15) & ~15));
+  TileMM21(src_y, kWidth, tile_y, kTileStride, kWidth, kHeight, 32);
+  TileMM21(src_uv, kHalfWidth * 2, tile_uv, kTileStride, kHalfWidth * 2,
+           kHalfHeight, 16);
+
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, MM21ToNV12(tile_y, kTileStride, tile_uv, kTileStride, dst_y,
+                            kWidth, dst_uv, kHalfWidth * 2, kWidth, kHeight));
+  }
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(src_y[i], dst_y[i]);
+  }
+  for (int i = 0; i < kHalfWidth * 2 * kHalfHeight; ++i) {
+    EXPECT_EQ(src_uv[i], dst_uv[i]);
+  }
+
+  memset(dst_y, 0, kWidth * kHeight);
+  EXPECT_EQ(0, MM21ToI420(tile_y, kTileStride, tile_uv, kTileStride, dst_y,
+                          kWidth, dst_u, kHalfWidth, dst_v, kHalfWidth, kWidth,
+                          kHeight));
+  NV12ToI420(src_y, kWidth, src_uv, kHalfWidth * 2, dst_y, kWidth, ref_u,
+             kHalfWidth, ref_v, kHalfWidth, kWidth, kHeight);
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {
+    EXPECT_EQ(ref_u[i], dst_u[i]);
+    EXPECT_EQ(ref_v[i], dst_v[i]);
+  }
+
+  EXPECT_EQ(0, MM21ToARGB(tile_y, kTileStride, tile_uv, kTileStride, dst_argb,
+                          kWidth * 4, kWidth, kHeight));
+  NV12ToARGB(src_y, kWidth, src_uv, kHalfWidth * 2, ref_argb, kWidth * 4,
+             kWidth, kHeight);
+  for (int i = 0; i < kWidth * 4 * kHeight; ++i) {
+    EXPECT_EQ(ref_argb[i], dst_argb[i]);
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(tile_y);
+  free_aligned_buffer_page_end(tile_uv);
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_uv);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+  free_aligned_buffer_page_end(ref_u);
+  free_aligned_buffer_page_end(ref_v);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(ref_argb);
+}
+
 #define TESTBIPLANARTOPI(SRC_FMT_PLANAR, SRC_T, SRC_BPC, SRC_SUBSAMP_X,       \
                          SRC_SUBSAMP_Y, FMT_PLANAR, DST_T, DST_BPC,           \
                          DST_SUBSAMP_X, DST_SUBSAMP_Y, W1280, N, NEG, OFF,    \
@@ -1216,6 +1314,8 @@ TESTATOBIPLANAR(YUY2, 2, 4, NV12, 2, 2)
 TESTATOBIPLANAR(UYVY, 2, 4, NV12, 2, 2)
 TESTATOBIPLANAR(AYUV, 1, 4, NV12, 2, 2)
 TESTATOBIPLANAR(AYUV, 1, 4, NV21, 2, 2)
+TESTATOBIPLANAR(RGB24, 1, 3, NV12, 2, 2)
+TESTATOBIPLANAR(RAW, 1, 3, NV12, 2, 2)
 
 #define TESTATOBI(FMT_A, TYPE_A, EPP_A, STRIDE_A, HEIGHT_A, FMT_B, TYPE_B,     \
                   EPP_B, STRIDE_B, HEIGHT_B, W1280, N, NEG, OFF)               \
@@ -1530,6 +1630,107 @@ TEST_F(LibYUVConvertTest, Test565) {
   EXPECT_EQ(610919429u, checksum);
 }
 
+// RGB24ToNV12 and RAWToNV12 share their row functions with RGB24ToI420 and
+// RAWToI420, so the UV plane is the interleaved U and V planes.
+TEST_F(LibYUVConvertTest, RGB24ToNV12MatchesI420) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_ | 1;
+  const int kStrideUV = SUBSAMPLE(kWidth, 2);
+  const int kHeightUV = SUBSAMPLE(kHeight, 2);
+  align_buffer_page_end(src_rgb, kWidth * kHeight * 3);
+  align_buffer_page_end(dst_y_i420, kWidth * kHeight);
+  align_buffer_page_end(dst_u, kStrideUV * kHeightUV);
+  align_buffer_page_end(dst_v, kStrideUV * kHeightUV);
+  align_buffer_page_end(dst_y_nv12, kWidth * kHeight);
+  align_buffer_page_end(dst_uv, kStrideUV * 2 * kHeightUV);
+  MemRandomize(src_rgb, kWidth * kHeight * 3);
+
+  for (int raw = 0; raw < 2; ++raw) {
+    if (raw) {
+      RAWToI420(src_rgb, kWidth * 3, dst_y_i420, kWidth, dst_u, kStrideUV,
+                dst_v, kStrideUV, kWidth, kHeight);
+      RAWToNV12(src_rgb, kWidth * 3, dst_y_nv12, kWidth, dst_uv,
+                kStrideUV * 2, kWidth, kHeight);
+    } else {
+      RGB24ToI420(src_rgb, kWidth * 3, dst_y_i420, kWidth, dst_u, kStrideUV,
+                  dst_v, kStrideUV, kWidth, kHeight);
+      RGB24ToNV12(src_rgb, kWidth * 3, dst_y_nv12, kWidth, dst_uv,
+                  kStrideUV * 2, kWidth, kHeight);
+    }
+    for (int i = 0; i < kWidth * kHeight; ++i) {
+      EXPECT_EQ(dst_y_i420[i], dst_y_nv12[i]);
+    }
+    for (int i = 0; i < kStrideUV * kHeightUV; ++i) {
+      EXPECT_EQ(dst_u[i], dst_uv[i * 2 + 0]);
+      EXPECT_EQ(dst_v[i], dst_uv[i * 2 + 1]);
+    }
+  }
+
+  free_aligned_buffer_page_end(src_rgb);
+  free_aligned_buffer_page_end(dst_y_i420);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+  free_aligned_buffer_page_end(dst_y_nv12);
+  free_aligned_buffer_page_end(dst_uv);
+}
+
+// The _WithScratch converters give the same result as the allocating ones,
+// with the scratch sized by their ScratchSize functions.
+TEST_F(LibYUVConvertTest, ConvertWithScratch) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_ | 1;
+  const int kStrideUV = SUBSAMPLE(kWidth, 2);
+  const int kHeightUV = SUBSAMPLE(kHeight, 2);
+  const int kSizeY = kWidth * kHeight;
+  const int kSizeUV = kStrideUV * 2 * kHeightUV;
+  int scratch_size = RGB24ToI420ScratchSize(kWidth);
+  if (ARGBToNV12ScratchSize(kWidth) > scratch_size) {
+    scratch_size = ARGBToNV12ScratchSize(kWidth);
+  }
+  if (YUY2ToNV12ScratchSize(kWidth) > scratch_size) {
+    scratch_size = YUY2ToNV12ScratchSize(kWidth);
+  }
+  align_buffer_page_end(src, kSizeY * 4);
+  align_buffer_page_end(dst_c, kSizeY + kSizeUV);
+  align_buffer_page_end(dst_opt, kSizeY + kSizeUV);
+  align_buffer_page_end(scratch_mem, scratch_size + 1);
+  LibyuvScratch scratch = {scratch_mem, (size_t)scratch_size};
+  MemRandomize(src, kSizeY * 4);
+
+  for (int format = 0; format < 3; ++format) {
+    memset(dst_c, 1, kSizeY + kSizeUV);
+    memset(dst_opt, 2, kSizeY + kSizeUV);
+    if (format == 0) {
+      RGB24ToI420(src, kWidth * 3, dst_c, kWidth, dst_c + kSizeY, kStrideUV,
+                  dst_c + kSizeY + kSizeUV / 2, kStrideUV, kWidth, kHeight);
+      RGB24ToI420_WithScratch(src, kWidth * 3, dst_opt, kWidth,
+                              dst_opt + kSizeY, kStrideUV,
+                              dst_opt + kSizeY + kSizeUV / 2, kStrideUV,
+                              kWidth, kHeight, &scratch);
+    } else if (format == 1) {
+      ARGBToNV12(src, kWidth * 4, dst_c, kWidth, dst_c + kSizeY,
+                 kStrideUV * 2, kWidth, kHeight);
+      ARGBToNV12_WithScratch(src, kWidth * 4, dst_opt, kWidth,
+                             dst_opt + kSizeY, kStrideUV * 2, kWidth, kHeight,
+                             &scratch);
+    } else {
+      YUY2ToNV12(src, kStrideUV * 4, dst_c, kWidth, dst_c + kSizeY,
+                 kStrideUV * 2, kWidth, kHeight);
+      YUY2ToNV12_WithScratch(src, kStrideUV * 4, dst_opt, kWidth,
+                             dst_opt + kSizeY, kStrideUV * 2, kWidth, kHeight,
+                             &scratch);
+    }
+    for (int i = 0; i < kSizeY + kSizeUV; ++i) {
+      EXPECT_EQ(dst_c[i], dst_opt[i]);
+    }
+  }
+
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(scratch_mem);
+}
+
 #ifdef HAVE_JPEG
 TEST_F(LibYUVConvertTest, ValidateJpeg) {
   const int kOff = 10;
@@ -2451,6 +2652,351 @@ TEST_F(LibYUVConvertTest, TestMJPGInfo) {
   EXPECT_EQ(1, ShowJPegInfo(kTest4Jpg,
                             kTest4JpgLen));  // Valid but unsupported.
 }
+
+// Encode a synthetic frame with libjpeg.  components is 3 for YCbCr with luma
+// sampling factors h_samp x v_samp, or 1 for grey.  Free the result with free.
+static unsigned long EncodeTestJpeg(int width,
+                                    int height,
+                                    int components,
+                                    int h_samp,
+                                    int v_samp,
+                                    uint8_t** jpeg) {
+  jpeg_compress_struct cinfo;
+  jpeg_error_mgr jerr;
+  unsigned long jpeg_size = 0;
+  cinfo.err = jpeg_std_error(&jerr);
+  jpeg_create_compress(&cinfo);
+  *jpeg = NULL;
+  jpeg_mem_dest(&cinfo, jpeg, &jpeg_size);
+  cinfo.image_width = width;
+  cinfo.image_height = height;
+  cinfo.input_components = components;
+  cinfo.in_color_space = components == 3 ? JCS_RGB : JCS_GRAYSCALE;
+  jpeg_set_defaults(&cinfo);
+  cinfo.comp_info[0].h_samp_factor = h_samp;
+  cinfo.comp_info[0].v_samp_factor = v_samp;
+  jpeg_set_quality(&cinfo, 90, TRUE);
+  jpeg_start_compress(&cinfo, TRUE);
+  align_buffer_page_end(row, width * components);
+  while (cinfo.next_scanline < cinfo.image_height) {
+    int y = cinfo.next_scanline;
+    for (int x = 0; x < width * components; ++x) {
+      row[x] = static_cast<uint8_t>(x * 7 / components + y * 3 +
+                                    ((x / 16 + y / 16) & 1) * 64 +
+                                    (fastrand() & 15));
+    }
+    JSAMPROW rows[1] = {row};
+    jpeg_write_scanlines(&cinfo, rows, 1);
+  }
+  jpeg_finish_compress(&cinfo);
+  jpeg_destroy_compress(&cinfo);
+  free_aligned_buffer_page_end(row);
+  return jpeg_size;
+}
+
+// Compare MJPGScaleToNV12 to decoding at the same DCT scale and then scaling,
+// rotating and interleaving whole planes.  Returns the max difference.
+static int TestMJPGScaleToNV12(int src_width,
+                               int src_height,
+                               int components,
+                               int h_samp,
+                               int v_samp,
+                               int dst_width,
+                               int dst_height,
+                               FilterMode filtering,
+                               RotationMode rotation,
+                               int benchmark_iterations) {
+  uint8_t* jpeg = NULL;
+  unsigned long jpeg_size = EncodeTestJpeg(src_width, src_height, components,
+                                           h_samp, v_samp, &jpeg);
+  const int kWidth = (rotation == kRotate90 || rotation == kRotate270)
+                         ? dst_height
+                         : dst_width;
+  const int kHeight = (rotation == kRotate90 || rotation == kRotate270)
+                          ? dst_width
+                          : dst_height;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kDstHalfWidth = (dst_width + 1) / 2;
+  const int kDstHalfHeight = (dst_height + 1) / 2;
+  align_buffer_page_end(dst_y_c, dst_width * dst_height);
+  align_buffer_page_end(dst_uv_c, kDstHalfWidth * 2 * kDstHalfHeight);
+  align_buffer_page_end(dst_y_opt, dst_width * dst_height);
+  align_buffer_page_end(dst_uv_opt, kDstHalfWidth * 2 * kDstHalfHeight);
+  align_buffer_page_end(scaled_y, kWidth * kHeight);
+  align_buffer_page_end(scaled_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(scaled_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(rotated_u, kDstHalfWidth * kDstHalfHeight);
+  align_buffer_page_end(rotated_v, kDstHalfWidth * kDstHalfHeight);
+
+  // Reference.
+  MJpegDecoder mjpeg_decoder;
+  EXPECT_TRUE(mjpeg_decoder.LoadFrame(jpeg, jpeg_size));
+  int scale_denom = 8;
+  while (scale_denom > 1 && ((src_width + scale_denom - 1) / scale_denom <
+                                 kWidth ||
+                             (src_height + scale_denom - 1) / scale_denom <
+                                 kHeight)) {
+    scale_denom >>= 1;
+  }
+  EXPECT_TRUE(mjpeg_decoder.SetScaleDenom(scale_denom));
+  // The component sizes are not available after decoding.
+  uint8_t* planes[3];
+  uint8_t* plane_mem[3];
+  int plane_width[3];
+  int plane_height[3];
+  for (int i = 0; i < components; ++i) {
+    plane_width[i] = mjpeg_decoder.GetComponentWidth(i);
+    plane_height[i] = mjpeg_decoder.GetComponentHeight(i);
+    plane_mem[i] = planes[i] =
+        static_cast<uint8_t*>(malloc(plane_width[i] * plane_height[i]));
+  }
+  EXPECT_TRUE(mjpeg_decoder.DecodeToBuffers(planes,
+                                            mjpeg_decoder.GetScaledWidth(),
+                                            mjpeg_decoder.GetScaledHeight()));
+  uint8_t* scaled[3] = {scaled_y, scaled_u, scaled_v};
+  for (int i = 0; i < components; ++i) {
+    ScalePlane(plane_mem[i], plane_width[i], plane_width[i], plane_height[i],
+               scaled[i], i ? kHalfWidth : kWidth, i ? kHalfWidth : kWidth,
+               i ? kHalfHeight : kHeight, filtering);
+    free(plane_mem[i]);
+  }
+  RotatePlane(scaled_y, kWidth, dst_y_c, dst_width, kWidth, kHeight, rotation);
+  if (components == 3) {
+    RotatePlane(scaled_u, kHalfWidth, rotated_u, kDstHalfWidth, kHalfWidth,
+                kHalfHeight, rotation);
+    RotatePlane(scaled_v, kHalfWidth, rotated_v, kDstHalfWidth, kHalfWidth,
+                kHalfHeight, rotation);
+    MergeUVPlane(rotated_u, kDstHalfWidth, rotated_v, kDstHalfWidth, dst_uv_c,
+                 kDstHalfWidth * 2, kDstHalfWidth, kDstHalfHeight);
+  } else {
+    memset(dst_uv_c, 128, kDstHalfWidth * 2 * kDstHalfHeight);
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, MJPGScaleToNV12(jpeg, jpeg_size, dst_y_opt, dst_width,
+                                 dst_uv_opt, kDstHalfWidth * 2, src_width,
+                                 src_height, dst_width, dst_height, filtering,
+                                 rotation));
+  }
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_width * dst_height; ++i) {
+    int abs_diff = abs(dst_y_c[i] - dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (int i = 0; i < kDstHalfWidth * 2 * kDstHalfHeight; ++i) {
+    int abs_diff = abs(dst_uv_c[i] - dst_uv_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  free(jpeg);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free_aligned_buffer_page_end(scaled_y);
+  free_aligned_buffer_page_end(scaled_u);
+  free_aligned_buffer_page_end(scaled_v);
+  free_aligned_buffer_page_end(rotated_u);
+  free_aligned_buffer_page_end(rotated_v);
+  return max_diff;
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Down2_420) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1280, 720, 3, 2, 2, 640, 360, kFilterBox,
+                                   kRotate0, benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Bilinear_Rotate90_420) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1280, 720, 3, 2, 2, 270, 480,
+                                   kFilterBilinear, kRotate90,
+                                   benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Box_Rotate180_422) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1280, 720, 3, 2, 1, 301, 199, kFilterBox,
+                                   kRotate180, benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Rotate270_444) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1280, 720, 3, 1, 1, 360, 480,
+                                   kFilterBilinear, kRotate270,
+                                   benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Up_420) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(320, 240, 3, 2, 2, 1001, 753,
+                                   kFilterBilinear, kRotate0,
+                                   benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Rotate90_400) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1920, 1080, 1, 1, 1, 120, 68, kFilterBox,
+                                   kRotate90, benchmark_iterations_));
+}
+
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_None_420) {
+  EXPECT_EQ(0, TestMJPGScaleToNV12(1280, 720, 3, 2, 2, 1000, 500, kFilterNone,
+                                   kRotate0, benchmark_iterations_));
+}
+
+// Unscaled, the output matches MJPGToNV12.
+TEST_F(LibYUVConvertTest, MJPGScaleToNV12_Unscaled) {
+  int width = 0;
+  int height = 0;
+  EXPECT_EQ(0, MJPGSize(kTest2Jpg, kTest2JpgLen, &width, &height));
+  int half_width = (width + 1) / 2;
+  int half_height = (height + 1) / 2;
+  align_buffer_page_end(dst_y_c, width * height);
+  align_buffer_page_end(dst_uv_c, half_width * 2 * half_height);
+  align_buffer_page_end(dst_y_opt, width * height);
+  align_buffer_page_end(dst_uv_opt, half_width * 2 * half_height);
+  EXPECT_EQ(0, MJPGToNV12(kTest2Jpg, kTest2JpgLen, dst_y_c, width, dst_uv_c,
+                          half_width * 2, width, height, width, height));
+  EXPECT_EQ(0, MJPGScaleToNV12(kTest2Jpg, kTest2JpgLen, dst_y_opt, width,
+                               dst_uv_opt, half_width * 2, width, height,
+                               width, height, kFilterBox, kRotate0));
+  for (int i = 0; i < width * height; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < half_width * 2 * half_height; ++i) {
+    EXPECT_EQ(dst_uv_c[i], dst_uv_opt[i]);
+  }
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+}
+
+// Decode a stream of frames with one MJPGDecoder.  Output matches the MJPGTo
+// functions, and once a frame of each format has been decoded, decoding more
+// frames like it does not allocate.
+TEST_F(LibYUVConvertTest, MJPGDecoderToI420_Allocations) {
+  uint8_t* jpeg_720p = NULL;
+  unsigned long jpeg_720p_size =
+      EncodeTestJpeg(1280, 720, 3, 2, 2, &jpeg_720p);
+  const uint8_t* const kJpgs[] = {kTest0Jpg, kTest1Jpg, kTest2Jpg, kTest3Jpg,
+                                  jpeg_720p};
+  const size_t kJpgLens[] = {kTest0JpgLen, kTest1JpgLen, kTest2JpgLen,
+                             kTest3JpgLen, jpeg_720p_size};
+  MJPGDecoder* decoder = MJPGDecoderCreate();
+  ASSERT_TRUE(decoder != NULL);
+  for (int n = 0; n < 5; ++n) {
+    int width = 0;
+    int height = 0;
+    EXPECT_EQ(0, MJPGSize(kJpgs[n], kJpgLens[n], &width, &height));
+    int half_width = (width + 1) / 2;
+    int half_height = (height + 1) / 2;
+    int benchmark_iterations = benchmark_iterations_ * benchmark_width_ *
+                               benchmark_height_ / (width * height);
+    if (benchmark_iterations < 2) {
+      benchmark_iterations = 2;
+    }
+    align_buffer_page_end(dst_y_c, width * height);
+    align_buffer_page_end(dst_u_c, half_width * half_height);
+    align_buffer_page_end(dst_v_c, half_width * half_height);
+    align_buffer_page_end(dst_y_opt, width * height);
+    align_buffer_page_end(dst_u_opt, half_width * half_height);
+    align_buffer_page_end(dst_v_opt, half_width * half_height);
+    align_buffer_page_end(dst_uv_c, half_width * 2 * half_height);
+    align_buffer_page_end(dst_uv_opt, half_width * 2 * half_height);
+    EXPECT_EQ(0, MJPGToI420(kJpgs[n], kJpgLens[n], dst_y_c, width, dst_u_c,
+                            half_width, dst_v_c, half_width, width, height,
+                            width, height));
+    EXPECT_EQ(0, MJPGToNV12(kJpgs[n], kJpgLens[n], dst_y_c, width, dst_uv_c,
+                            half_width * 2, width, height, width, height));
+
+    int first_allocations = MJPGDecoderAllocationCount(decoder);
+    EXPECT_EQ(0, MJPGDecoderToI420(decoder, kJpgs[n], kJpgLens[n], dst_y_opt,
+                                   width, dst_u_opt, half_width, dst_v_opt,
+                                   half_width, width, height, width, height));
+    first_allocations = MJPGDecoderAllocationCount(decoder) - first_allocations;
+    int allocations = MJPGDecoderAllocationCount(decoder);
+    for (int times = 0; times < benchmark_iterations; ++times) {
+      EXPECT_EQ(0, MJPGDecoderToNV12(decoder, kJpgs[n], kJpgLens[n], dst_y_opt,
+                                     width, dst_uv_opt, half_width * 2, width,
+                                     height, width, height));
+      EXPECT_EQ(0, MJPGDecoderToI420(decoder, kJpgs[n], kJpgLens[n],
+                                     dst_y_opt, width, dst_u_opt, half_width,
+                                     dst_v_opt, half_width, width, height,
+                                     width, height));
+    }
+    allocations = MJPGDecoderAllocationCount(decoder) - allocations;
+    printf("%dx%d frame: %d allocations for the first frame, %d for %d more\n",
+           width, height, first_allocations, allocations,
+           benchmark_iterations * 2);
+    EXPECT_EQ(0, allocations);
+
+    for (int i = 0; i < width * height; ++i) {
+      EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+    }
+    for (int i = 0; i < half_width * half_height; ++i) {
+      EXPECT_EQ(dst_u_c[i], dst_u_opt[i]);
+      EXPECT_EQ(dst_v_c[i], dst_v_opt[i]);
+    }
+    for (int i = 0; i < half_width * 2 * half_height; ++i) {
+      EXPECT_EQ(dst_uv_c[i], dst_uv_opt[i]);
+    }
+    free_aligned_buffer_page_end(dst_y_c);
+    free_aligned_buffer_page_end(dst_u_c);
+    free_aligned_buffer_page_end(dst_v_c);
+    free_aligned_buffer_page_end(dst_y_opt);
+    free_aligned_buffer_page_end(dst_u_opt);
+    free_aligned_buffer_page_end(dst_v_opt);
+    free_aligned_buffer_page_end(dst_uv_c);
+    free_aligned_buffer_page_end(dst_uv_opt);
+  }
+  MJPGDecoderFree(decoder);
+  free(jpeg_720p);
+}
+
+TEST_F(LibYUVConvertTest, MJPGDecoderScaleToNV12_Allocations) {
+  const int kWidth = 640;
+  const int kHeight = 360;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  uint8_t* jpeg = NULL;
+  unsigned long jpeg_size = EncodeTestJpeg(1280, 720, 3, 2, 1, &jpeg);
+  align_buffer_page_end(dst_y_c, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_c, kHalfWidth * 2 * kHalfHeight);
+  align_buffer_page_end(dst_y_opt, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_opt, kHalfWidth * 2 * kHalfHeight);
+  EXPECT_EQ(0, MJPGScaleToNV12(jpeg, jpeg_size, dst_y_c, kWidth, dst_uv_c,
+                               kHalfWidth * 2, 1280, 720, kWidth, kHeight,
+                               kFilterBilinear, kRotate0));
+
+  MJPGDecoder* decoder = MJPGDecoderCreate();
+  ASSERT_TRUE(decoder != NULL);
+  EXPECT_EQ(0, MJPGDecoderScaleToNV12(decoder, jpeg, jpeg_size, dst_y_opt,
+                                      kWidth, dst_uv_opt, kHalfWidth * 2, 1280,
+                                      720, kWidth, kHeight, kFilterBilinear,
+                                      kRotate0));
+  int allocations = MJPGDecoderAllocationCount(decoder);
+  for (int times = 0; times < benchmark_iterations_; ++times) {
+    EXPECT_EQ(0, MJPGDecoderScaleToNV12(decoder, jpeg, jpeg_size, dst_y_opt,
+                                        kWidth, dst_uv_opt, kHalfWidth * 2,
+                                        1280, 720, kWidth, kHeight,
+                                        kFilterBilinear, kRotate0));
+  }
+  EXPECT_EQ(allocations, MJPGDecoderAllocationCount(decoder));
+
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < kHalfWidth * 2 * kHalfHeight; ++i) {
+    EXPECT_EQ(dst_uv_c[i], dst_uv_opt[i]);
+  }
+  MJPGDecoderFree(decoder);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free(jpeg);
+}
 #endif  // HAVE_JPEG
 
 TEST_F(LibYUVConvertTest, NV12Crop) {
@@ -3126,6 +3672,183 @@ TEST_F(LibYUVConvertTest, RotateWithARGBSource) {
   EXPECT_EQ(dst[3], src[1]);
 }
 
+// Camera samples that need conversion are rotated a strip of rows at a time.
+// Compare with converting the whole frame and then rotating it, for sizes
+// that take several strips, odd heights and inverted samples.
+static const uint32_t kRotateFourCCs[] = {
+    FOURCC_YUY2, FOURCC_UYVY, FOURCC_RGBP, FOURCC_24BG,
+    FOURCC_RAW,  FOURCC_BGRA, FOURCC_I400, FOURCC_I422,
+    FOURCC_YV16, FOURCC_I444, FOURCC_I420, FOURCC_NV12};
+static const RotationMode kRotateModes[] = {kRotate90, kRotate180, kRotate270};
+// 1920x1082 takes several strips even with a large L2 cache.
+static const int kRotateSizes[][2] = {
+    {640, 360}, {642, 353}, {100, 16}, {1920, 1082}};
+
+TEST_F(LibYUVConvertTest, ConvertToI420_RotateStrips) {
+  for (const int* size : kRotateSizes) {
+    const int kWidth = size[0];
+    const int kHeight = size[1];
+    const int kCropWidth = kWidth - 4;
+    const int kCropHeight = kHeight - 4;
+    const int kSampleSize = kWidth * kHeight * 4;
+    const int kStrideUV = (kCropWidth + 1) / 2;
+    const int kSizeY = kCropWidth * kCropHeight;
+    const int kSizeUV = kStrideUV * ((kCropHeight + 1) / 2);
+    align_buffer_page_end(sample, kSampleSize);
+    align_buffer_page_end(convert, kSizeY + kSizeUV * 2);
+    align_buffer_page_end(dst_c, kSizeY + kSizeUV * 2);
+    align_buffer_page_end(dst_opt, kSizeY + kSizeUV * 2);
+    MemRandomize(sample, kSampleSize);
+    for (uint32_t fourcc : kRotateFourCCs) {
+      for (RotationMode rotation : kRotateModes) {
+        for (int invert = 1; invert >= -1; invert -= 2) {
+          // Rotated by 90 or 270, the crop height is the destination width.
+          const int kDstStrideY =
+              (rotation == kRotate180) ? kCropWidth : kCropHeight;
+          const int kDstStrideUV = (kDstStrideY + 1) / 2;
+          memset(dst_c, 1, kSizeY + kSizeUV * 2);
+          memset(dst_opt, 2, kSizeY + kSizeUV * 2);
+          EXPECT_EQ(0, ConvertToI420(sample, kSampleSize, convert, kCropWidth,
+                                     convert + kSizeY, kStrideUV,
+                                     convert + kSizeY + kSizeUV, kStrideUV, 2,
+                                     2, kWidth, kHeight * invert, kCropWidth,
+                                     kCropHeight, kRotate0, fourcc));
+          I420Rotate(convert, kCropWidth, convert + kSizeY, kStrideUV,
+                     convert + kSizeY + kSizeUV, kStrideUV, dst_c,
+                     kDstStrideY, dst_c + kSizeY, kDstStrideUV,
+                     dst_c + kSizeY + kSizeUV, kDstStrideUV, kCropWidth,
+                     kCropHeight, rotation);
+          EXPECT_EQ(0, ConvertToI420(sample, kSampleSize, dst_opt, kDstStrideY,
+                                     dst_opt + kSizeY, kDstStrideUV,
+                                     dst_opt + kSizeY + kSizeUV, kDstStrideUV,
+                                     2, 2, kWidth, kHeight * invert,
+                                     kCropWidth, kCropHeight, rotation,
+                                     fourcc));
+          EXPECT_EQ(0, memcmp(dst_c, dst_opt, kSizeY + kSizeUV * 2))
+              << "fourcc " << std::hex << fourcc << std::dec << " rotation "
+              << rotation << " " << kWidth << "x" << kHeight * invert;
+        }
+      }
+    }
+    free_aligned_buffer_page_end(sample);
+    free_aligned_buffer_page_end(convert);
+    free_aligned_buffer_page_end(dst_c);
+    free_aligned_buffer_page_end(dst_opt);
+  }
+}
+
+TEST_F(LibYUVConvertTest, ConvertToARGB_RotateStrips) {
+  for (const int* size : kRotateSizes) {
+    const int kWidth = size[0];
+    const int kHeight = size[1];
+    const int kCropWidth = kWidth - 4;
+    const int kCropHeight = kHeight - 4;
+    const int kSampleSize = kWidth * kHeight * 4;
+    const int kSize = kCropWidth * 4 * kCropHeight;
+    align_buffer_page_end(sample, kSampleSize);
+    align_buffer_page_end(convert, kSize);
+    align_buffer_page_end(dst_c, kSize);
+    align_buffer_page_end(dst_opt, kSize);
+    MemRandomize(sample, kSampleSize);
+    for (uint32_t fourcc : kRotateFourCCs) {
+      for (RotationMode rotation : kRotateModes) {
+        for (int invert = 1; invert >= -1; invert -= 2) {
+          const int kDstStride =
+              ((rotation == kRotate180) ? kCropWidth : kCropHeight) * 4;
+          memset(dst_c, 1, kSize);
+          memset(dst_opt, 2, kSize);
+          EXPECT_EQ(0, ConvertToARGB(sample, kSampleSize, convert,
+                                     kCropWidth * 4, 2, 2, kWidth,
+                                     kHeight * invert, kCropWidth, kCropHeight,
+                                     kRotate0, fourcc));
+          ARGBRotate(convert, kCropWidth * 4, dst_c, kDstStride, kCropWidth,
+                     kCropHeight, rotation);
+          EXPECT_EQ(0, ConvertToARGB(sample, kSampleSize, dst_opt, kDstStride,
+                                     2, 2, kWidth, kHeight * invert,
+                                     kCropWidth, kCropHeight, rotation,
+                                     fourcc));
+          EXPECT_EQ(0, memcmp(dst_c, dst_opt, kSize))
+              << "fourcc " << std::hex << fourcc << std::dec << " rotation "
+              << rotation << " " << kWidth << "x" << kHeight * invert;
+        }
+      }
+    }
+    free_aligned_buffer_page_end(sample);
+    free_aligned_buffer_page_end(convert);
+    free_aligned_buffer_page_end(dst_c);
+    free_aligned_buffer_page_end(dst_opt);
+  }
+}
+
+// Convert a frame a slice at a time, each slice in a buffer of its own, and
+// compare with converting the whole frame.
+static void TestToARGBSlice(bool nv12, int width, int height, int slice_rows) {
+  const int kWidthUV = (width + 1) / 2;
+  const int kHeightUV = (height + 1) / 2;
+  align_buffer_page_end(src_y, width * height);
+  align_buffer_page_end(src_u, kWidthUV * kHeightUV);
+  align_buffer_page_end(src_v, kWidthUV * kHeightUV);
+  align_buffer_page_end(src_uv, kWidthUV * 2 * kHeightUV);
+  align_buffer_page_end(band, width * slice_rows * 2);
+  align_buffer_page_end(dst_c, width * 4 * height);
+  align_buffer_page_end(dst_opt, width * 4 * height);
+  MemRandomize(src_y, width * height);
+  MemRandomize(src_u, kWidthUV * kHeightUV);
+  MemRandomize(src_v, kWidthUV * kHeightUV);
+  MergeUVPlane(src_u, kWidthUV, src_v, kWidthUV, src_uv, kWidthUV * 2,
+               kWidthUV, kHeightUV);
+  memset(dst_opt, 0, width * 4 * height);
+  SliceContext* slice =
+      nv12 ? NV12ToARGBSliceCreate(&kYuvI601Constants, width, height)
+           : I420ToARGBSliceCreate(&kYuvI601Constants, width, height);
+  ASSERT_TRUE(slice != NULL);
+  if (nv12) {
+    NV12ToARGB(src_y, width, src_uv, kWidthUV * 2, dst_c, width * 4, width,
+               height);
+  } else {
+    I420ToARGB(src_y, width, src_u, kWidthUV, src_v, kWidthUV, dst_c,
+               width * 4, width, height);
+  }
+  for (int y = 0; y < height; y += slice_rows) {
+    int rows = height - y < slice_rows ? height - y : slice_rows;
+    int uv_rows = (rows + 1) / 2;
+    uint8_t* band_u = band + width * rows;
+    uint8_t* band_v = band_u + kWidthUV * uv_rows;
+    int ret;
+    memcpy(band, src_y + y * width, width * rows);
+    if (nv12) {
+      memcpy(band_u, src_uv + y / 2 * kWidthUV * 2, kWidthUV * 2 * uv_rows);
+      ret = NV12ToARGBSlice(slice, band, width, band_u, kWidthUV * 2, rows,
+                            dst_opt, width * 4);
+    } else {
+      memcpy(band_u, src_u + y / 2 * kWidthUV, kWidthUV * uv_rows);
+      memcpy(band_v, src_v + y / 2 * kWidthUV, kWidthUV * uv_rows);
+      ret = I420ToARGBSlice(slice, band, width, band_u, kWidthUV, band_v,
+                            kWidthUV, rows, dst_opt, width * 4);
+    }
+    EXPECT_EQ(y + rows, ret);
+  }
+  EXPECT_EQ(0, memcmp(dst_c, dst_opt, width * 4 * height));
+  SliceFree(slice);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(band);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBSlice) {
+  TestToARGBSlice(false, benchmark_width_, benchmark_height_, 16);
+  TestToARGBSlice(false, 641, 361, 16);
+}
+
+TEST_F(LibYUVConvertTest, NV12ToARGBSlice) {
+  TestToARGBSlice(true, benchmark_width_, benchmark_height_, 16);
+  TestToARGBSlice(true, 641, 361, 16);
+}
+
 #ifdef HAS_ARGBTOAR30ROW_AVX2
 TEST_F(LibYUVConvertTest, ARGBToAR30Row_Opt) {
   // ARGBToAR30Row_AVX2 expects a multiple of 8 pixels.
@@ -3646,6 +4369,198 @@ TESTBIPLANAR16TOB(P216, 2, 1, AR30, 4, 4, 1, 16)
 #endif  // LITTLE_ENDIAN_ONLY_TEST
 #endif  // defined(ENABLE_SLOW_TESTS)
 
+// Tone mapping tables are built once and shared by the tests.
+static const struct ToneMapConstants* PQToneMap() {
+  static struct ToneMapConstants tonemap;
+  static int init = InitToneMapConstants(&tonemap, kHdrTransferPQ,
+                                         kToneMapBT2390, 1000, 203);
+  (void)init;
+  return &tonemap;
+}
+
+static const struct ToneMapConstants* HLGToneMap() {
+  static struct ToneMapConstants tonemap;
+  static int init = InitToneMapConstants(&tonemap, kHdrTransferHLG,
+                                         kToneMapHable, 1000, 203);
+  (void)init;
+  return &tonemap;
+}
+
+#define P010ToARGBTonePQ(a, b, c, d, e, f, g, h) \
+  P010ToARGBToneMap(a, b, c, d, e, f, PQToneMap(), g, h)
+#define P010ToARGBToneHLG(a, b, c, d, e, f, g, h) \
+  P010ToARGBToneMap(a, b, c, d, e, f, HLGToneMap(), g, h)
+#define I010ToARGBTonePQ(a, b, c, d, e, f, g, h, i, j) \
+  I010ToARGBToneMap(a, b, c, d, e, f, g, h, PQToneMap(), i, j)
+
+#if defined(ENABLE_SLOW_TESTS) || defined(__x86_64__) || defined(__i386__)
+TESTBIPLANAR16TOB(P010, 2, 2, ARGBTonePQ, 4, 4, 1, 10)
+TESTBIPLANAR16TOB(P010, 2, 2, ARGBToneHLG, 4, 4, 1, 10)
+TESTPLANAR16TOB(I010, 2, 2, 0x3ff, ARGBTonePQ, 4, 4, 1)
+#endif  // defined(ENABLE_SLOW_TESTS)
+
+// Tone map to NV12 with C and with SIMD, and compare to I010ToI420ToneMap.
+TEST_F(LibYUVConvertTest, P010ToNV12ToneMap) {
+  const int kWidth = benchmark_width_ | 1;
+  const int kHeight = benchmark_height_ | 1;
+  const int kHalfWidth = SUBSAMPLE(kWidth, 2);
+  const int kHalfHeight = SUBSAMPLE(kHeight, 2);
+  const struct ToneMapConstants* tonemap = PQToneMap();
+  align_buffer_page_end(src_y, kWidth * kHeight * 2);
+  align_buffer_page_end(src_uv, kHalfWidth * kHalfHeight * 4);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_y_c, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_c, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_y_opt, kWidth * kHeight);
+  align_buffer_page_end(dst_uv_opt, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(dst_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(dst_v, kHalfWidth * kHalfHeight);
+  uint16_t* y16 = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* uv16 = reinterpret_cast<uint16_t*>(src_uv);
+  uint16_t* u16 = reinterpret_cast<uint16_t*>(src_u);
+  uint16_t* v16 = reinterpret_cast<uint16_t*>(src_v);
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    y16[i] = (fastrand() & 0x3ff) << 6;
+  }
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {
+    uv16[i * 2 + 0] = (fastrand() & 0x3ff) << 6;
+    uv16[i * 2 + 1] = (fastrand() & 0x3ff) << 6;
+    u16[i] = uv16[i * 2 + 0] >> 6;
+    v16[i] = uv16[i * 2 + 1] >> 6;
+  }
+  memset(dst_y_c, 1, kWidth * kHeight);
+  memset(dst_uv_c, 2, kHalfWidth * kHalfHeight * 2);
+  memset(dst_y_opt, 101, kWidth * kHeight);
+  memset(dst_uv_opt, 102, kHalfWidth * kHalfHeight * 2);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  EXPECT_EQ(0, P010ToNV12ToneMap(y16, kWidth, uv16, kHalfWidth * 2, dst_y_c,
+                                 kWidth, dst_uv_c, kHalfWidth * 2, tonemap,
+                                 kWidth, kHeight));
+  MaskCpuFlags(benchmark_cpu_info_);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    P010ToNV12ToneMap(y16, kWidth, uv16, kHalfWidth * 2, dst_y_opt, kWidth,
+                      dst_uv_opt, kHalfWidth * 2, tonemap, kWidth, kHeight);
+  }
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < kHalfWidth * kHalfHeight * 2; ++i) {
+    EXPECT_EQ(dst_uv_c[i], dst_uv_opt[i]);
+  }
+
+  // I010 holds the 10 bit values in the low bits.  Same result as P010.
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    y16[i] >>= 6;
+  }
+  EXPECT_EQ(0, I010ToI420ToneMap(y16, kWidth, u16, kHalfWidth, v16,
+                                 kHalfWidth, dst_y_c, kWidth, dst_u,
+                                 kHalfWidth, dst_v, kHalfWidth, tonemap,
+                                 kWidth, kHeight));
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(dst_y_c[i], dst_y_opt[i]);
+  }
+  for (int i = 0; i < kHalfWidth * kHalfHeight; ++i) {
+    EXPECT_EQ(dst_u[i], dst_uv_opt[i * 2 + 0]);
+    EXPECT_EQ(dst_v[i], dst_uv_opt[i * 2 + 1]);
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_v);
+}
+
+// Tone map a flat gray I010 frame and return the I420 Y, U and V.
+static void ToneMapGray(const struct ToneMapConstants* tonemap,
+                        int y10,
+                        int* y,
+                        int* u,
+                        int* v) {
+  uint16_t src_y[8 * 2];
+  uint16_t src_uv[4];
+  uint8_t dst_y[8 * 2];
+  uint8_t dst_u[4];
+  uint8_t dst_v[4];
+  for (int i = 0; i < 8 * 2; ++i) {
+    src_y[i] = y10;
+  }
+  for (int i = 0; i < 4; ++i) {
+    src_uv[i] = 512;
+  }
+  EXPECT_EQ(0, I010ToI420ToneMap(src_y, 8, src_uv, 4, src_uv, 4, dst_y, 8,
+                                 dst_u, 4, dst_v, 4, tonemap, 8, 2));
+  *y = dst_y[0];
+  *u = dst_u[0];
+  *v = dst_v[0];
+}
+
+// HDR reference white maps to SDR white and black stays black.
+TEST_F(LibYUVConvertTest, ToneMapReferenceWhite) {
+  struct ToneMapConstants tonemap;
+  int y, u, v;
+  // 203 nits in PQ is 58%, Y = 64 + 876 * 0.58.
+  // I010ToAR30 is within 1% of full range, so allow 2 for white.
+  EXPECT_EQ(0, InitToneMapConstants(&tonemap, kHdrTransferPQ, kToneMapClip,
+                                    1000, 203));
+  ToneMapGray(&tonemap, 573, &y, &u, &v);
+  EXPECT_NEAR(235, y, 2);
+  EXPECT_NEAR(128, u, 1);
+  EXPECT_NEAR(128, v, 1);
+  ToneMapGray(&tonemap, 64, &y, &u, &v);
+  EXPECT_EQ(16, y);
+  EXPECT_NEAR(128, u, 1);
+  EXPECT_NEAR(128, v, 1);
+
+  // HLG 75% is reference white on a 1000 nit display.
+  EXPECT_EQ(0, InitToneMapConstants(&tonemap, kHdrTransferHLG, kToneMapClip,
+                                    1000, 203));
+  ToneMapGray(&tonemap, 721, &y, &u, &v);
+  EXPECT_NEAR(235, y, 2);
+  EXPECT_NEAR(128, u, 1);
+  EXPECT_NEAR(128, v, 1);
+
+  // Curves that roll off highlights keep the peak at white, and are
+  // monotonic.
+  for (int curve = kToneMapReinhard; curve <= kToneMapBT2390; ++curve) {
+    int last_y = 0;
+    EXPECT_EQ(0, InitToneMapConstants(&tonemap, kHdrTransferPQ,
+                                      static_cast<ToneMapCurve>(curve), 1000,
+                                      203));
+    for (int i = 64; i <= 940; i += 4) {
+      ToneMapGray(&tonemap, i, &y, &u, &v);
+      EXPECT_LE(last_y, y);
+      last_y = y;
+    }
+    // 1000 nits in PQ is 75%, Y = 64 + 876 * 0.75.
+    ToneMapGray(&tonemap, 724, &y, &u, &v);
+    EXPECT_NEAR(235, y, 1);
+  }
+}
+
+TEST_F(LibYUVConvertTest, ToneMapInvalid) {
+  struct ToneMapConstants tonemap;
+  EXPECT_EQ(-1, InitToneMapConstants(NULL, kHdrTransferPQ, kToneMapClip, 1000,
+                                     203));
+  EXPECT_EQ(-1, InitToneMapConstants(&tonemap, kHdrTransferPQ, kToneMapClip,
+                                     0, 203));
+  EXPECT_EQ(-1, InitToneMapConstants(&tonemap, kHdrTransferPQ, kToneMapClip,
+                                     1000, 0));
+  EXPECT_EQ(-1, InitToneMapConstants(&tonemap, static_cast<HdrTransfer>(2),
+                                     kToneMapClip, 1000, 203));
+  EXPECT_EQ(-1, InitToneMapConstants(&tonemap, kHdrTransferPQ,
+                                     static_cast<ToneMapCurve>(4), 1000, 203));
+  EXPECT_EQ(-1, P010ToNV12ToneMap(NULL, 0, NULL, 0, NULL, 0, NULL, 0,
+                                  &tonemap, 16, 16));
+}
+
 static int Clamp(int y) {
   if (y < 0) {
     y = 0;
@@ -4064,4 +4979,478 @@ TEST_F(LibYUVConvertTest, TestI400) {
   free_aligned_buffer_page_end(argb_pixels_2020_i400);
 }
 
+// Compare AVX512BW row functions against AVX2 through the public API, and
+// print the time of each with LIBYUV_REPEAT.  Without AVX512BW both run the
+// same code.
+#define TESTAVX512BW(NAME, CONVERT)                                          \
+  TEST_F(LibYUVConvertTest, NAME##_AVX512BW) {                              \
+    const int kWidth = benchmark_width_;                                    \
+    const int kHeight = benchmark_height_;                                  \
+    const int kSize = kWidth * kHeight * 4;                                 \
+    align_buffer_page_end(src_a, kSize);                                    \
+    align_buffer_page_end(src_b, kSize);                                    \
+    align_buffer_page_end(src_c, kSize);                                    \
+    align_buffer_page_end(dst_a, kSize);                                    \
+    align_buffer_page_end(dst_b, kSize);                                    \
+    align_buffer_page_end(dst_c, kSize);                                    \
+    align_buffer_page_end(avx2_a, kSize);                                   \
+    align_buffer_page_end(avx2_b, kSize);                                   \
+    align_buffer_page_end(avx2_c, kSize);                                   \
+    MemRandomize(src_a, kSize);                                             \
+    MemRandomize(src_b, kSize);                                             \
+    MemRandomize(src_c, kSize);                                             \
+    memset(dst_a, 1, kSize);                                                \
+    memset(dst_b, 1, kSize);                                                \
+    memset(dst_c, 1, kSize);                                                \
+    MaskCpuFlags(benchmark_cpu_info_ & ~kCpuHasAVX512BW);                   \
+    double avx2_time = get_time();                                          \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                       \
+      CONVERT;                                                              \
+    }                                                                       \
+    avx2_time = (get_time() - avx2_time) / benchmark_iterations_;           \
+    memcpy(avx2_a, dst_a, kSize);                                           \
+    memcpy(avx2_b, dst_b, kSize);                                           \
+    memcpy(avx2_c, dst_c, kSize);                                           \
+    memset(dst_a, 1, kSize);                                                \
+    memset(dst_b, 1, kSize);                                                \
+    memset(dst_c, 1, kSize);                                                \
+    MaskCpuFlags(benchmark_cpu_info_);                                      \
+    double opt_time = get_time();                                           \
+    for (int i = 0; i < benchmark_iterations_; ++i) {                       \
+      CONVERT;                                                              \
+    }                                                                       \
+    opt_time = (get_time() - opt_time) / benchmark_iterations_;             \
+    printf("%-26s %8.2f us AVX2 %8.2f us AVX512BW\n", #NAME,                \
+           avx2_time * 1e6, opt_time * 1e6);                                \
+    EXPECT_EQ(0, memcmp(avx2_a, dst_a, kSize));                             \
+    EXPECT_EQ(0, memcmp(avx2_b, dst_b, kSize));                             \
+    EXPECT_EQ(0, memcmp(avx2_c, dst_c, kSize));                             \
+    free_aligned_buffer_page_end(src_a);                                    \
+    free_aligned_buffer_page_end(src_b);                                    \
+    free_aligned_buffer_page_end(src_c);                                    \
+    free_aligned_buffer_page_end(dst_a);                                    \
+    free_aligned_buffer_page_end(dst_b);                                    \
+    free_aligned_buffer_page_end(dst_c);                                    \
+    free_aligned_buffer_page_end(avx2_a);                                   \
+    free_aligned_buffer_page_end(avx2_b);                                   \
+    free_aligned_buffer_page_end(avx2_c);                                   \
+  }
+
+TESTAVX512BW(I420ToARGB,
+             I420ToARGB(src_a, kWidth, src_b, SUBSAMPLE(kWidth, 2), src_c,
+                        SUBSAMPLE(kWidth, 2), dst_a, kWidth * 4, kWidth,
+                        kHeight))
+TESTAVX512BW(I422ToARGB,
+             I422ToARGB(src_a, kWidth, src_b, SUBSAMPLE(kWidth, 2), src_c,
+                        SUBSAMPLE(kWidth, 2), dst_a, kWidth * 4, kWidth,
+                        kHeight))
+TESTAVX512BW(NV12ToARGB,
+             NV12ToARGB(src_a, kWidth, src_b, SUBSAMPLE(kWidth, 2) * 2, dst_a,
+                        kWidth * 4, kWidth, kHeight))
+TESTAVX512BW(ARGBToI420,
+             ARGBToI420(src_a, kWidth * 4, dst_a, kWidth, dst_b,
+                        SUBSAMPLE(kWidth, 2), dst_c, SUBSAMPLE(kWidth, 2),
+                        kWidth, kHeight))
+TESTAVX512BW(ARGBToI420_Any,
+             ARGBToI420(src_a, kWidth * 4, dst_a, kWidth, dst_b,
+                        SUBSAMPLE(kWidth - 1, 2), dst_c,
+                        SUBSAMPLE(kWidth - 1, 2), kWidth - 1, kHeight))
+TESTAVX512BW(NV12ToARGB_Any,
+             NV12ToARGB(src_a, kWidth, src_b, SUBSAMPLE(kWidth, 2) * 2, dst_a,
+                        kWidth * 4, kWidth - 1, kHeight))
+
+// Batches of small frames of different sizes, one of them inverted.
+static const int kBatchFrames = 16;
+static const int kBatchSlot = 160 * 100;  // Pixels per frame slot.
+
+static void BatchFrameSize(int i, int* width, int* height) {
+  *width = 32 + i * 7;
+  *height = 16 + i * 5;
+}
+
+static int TestI420ToARGBBatch(int num_jobs, int benchmark_iterations) {
+  LibyuvConstFrame src_frames[kBatchFrames];
+  LibyuvFrame dst_frames[kBatchFrames];
+  int num_calls = 0;
+  int num_diff = 0;
+  align_buffer_page_end(src_y, kBatchSlot * kBatchFrames);
+  align_buffer_page_end(src_u, kBatchSlot * kBatchFrames / 4);
+  align_buffer_page_end(src_v, kBatchSlot * kBatchFrames / 4);
+  align_buffer_page_end(dst_c, kBatchSlot * kBatchFrames * 4);
+  align_buffer_page_end(dst_opt, kBatchSlot * kBatchFrames * 4);
+  MemRandomize(src_y, kBatchSlot * kBatchFrames);
+  MemRandomize(src_u, kBatchSlot * kBatchFrames / 4);
+  MemRandomize(src_v, kBatchSlot * kBatchFrames / 4);
+  memset(dst_c, 1, kBatchSlot * kBatchFrames * 4);
+  memset(dst_opt, 1, kBatchSlot * kBatchFrames * 4);
+
+  for (int i = 0; i < kBatchFrames; ++i) {
+    int width, height;
+    BatchFrameSize(i, &width, &height);
+    int halfwidth = (width + 1) / 2;
+    src_frames[i].data[0] = src_y + i * kBatchSlot;
+    src_frames[i].data[1] = src_u + i * kBatchSlot / 4;
+    src_frames[i].data[2] = src_v + i * kBatchSlot / 4;
+    src_frames[i].stride[0] = width;
+    src_frames[i].stride[1] = halfwidth;
+    src_frames[i].stride[2] = halfwidth;
+    src_frames[i].width = width;
+    src_frames[i].height = i == 3 ? -height : height;
+    dst_frames[i].data[0] = dst_opt + i * kBatchSlot * 4;
+    dst_frames[i].stride[0] = width * 4;
+    I420ToARGB(src_frames[i].data[0], width, src_frames[i].data[1], halfwidth,
+               src_frames[i].data[2], halfwidth, dst_c + i * kBatchSlot * 4,
+               width * 4, width, src_frames[i].height);
+  }
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, I420ToARGBBatch(src_frames, dst_frames, kBatchFrames,
+                                 num_jobs, TestDispatch, &num_calls));
+  }
+  EXPECT_EQ(num_jobs > 1 ? benchmark_iterations : 0, num_calls);
+  for (int i = 0; i < kBatchSlot * kBatchFrames * 4; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return num_diff;
+}
+
+TEST_F(LibYUVConvertTest, I420ToARGBBatch) {
+  EXPECT_EQ(0, TestI420ToARGBBatch(1, benchmark_iterations_));
+  EXPECT_EQ(0, TestI420ToARGBBatch(5, benchmark_iterations_));
+}
+
+static int TestARGBToI420Batch(int num_jobs, int benchmark_iterations) {
+  LibyuvConstFrame src_frames[kBatchFrames];
+  LibyuvFrame dst_frames[kBatchFrames];
+  int num_calls = 0;
+  int num_diff = 0;
+  const int kDstSize = kBatchSlot * kBatchFrames * 3 / 2;
+  align_buffer_page_end(src_argb, kBatchSlot * kBatchFrames * 4);
+  align_buffer_page_end(dst_c, kDstSize);
+  align_buffer_page_end(dst_opt, kDstSize);
+  MemRandomize(src_argb, kBatchSlot * kBatchFrames * 4);
+  memset(dst_c, 1, kDstSize);
+  memset(dst_opt, 1, kDstSize);
+
+  for (int i = 0; i < kBatchFrames; ++i) {
+    int width, height;
+    BatchFrameSize(i, &width, &height);
+    int halfwidth = (width + 1) / 2;
+    int y_offset = i * kBatchSlot;
+    int u_offset = kBatchSlot * kBatchFrames + i * kBatchSlot / 4;
+    int v_offset = u_offset + kBatchSlot * kBatchFrames / 4;
+    src_frames[i].data[0] = src_argb + i * kBatchSlot * 4;
+    src_frames[i].stride[0] = width * 4;
+    src_frames[i].width = width;
+    src_frames[i].height = i == 3 ? -height : height;
+    dst_frames[i].data[0] = dst_opt + y_offset;
+    dst_frames[i].data[1] = dst_opt + u_offset;
+    dst_frames[i].data[2] = dst_opt + v_offset;
+    dst_frames[i].stride[0] = width;
+    dst_frames[i].stride[1] = halfwidth;
+    dst_frames[i].stride[2] = halfwidth;
+    ARGBToI420(src_frames[i].data[0], width * 4, dst_c + y_offset, width,
+               dst_c + u_offset, halfwidth, dst_c + v_offset, halfwidth, width,
+               src_frames[i].height);
+  }
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, ARGBToI420Batch(src_frames, dst_frames, kBatchFrames,
+                                 num_jobs, TestDispatch, &num_calls));
+  }
+  EXPECT_EQ(num_jobs > 1 ? benchmark_iterations : 0, num_calls);
+  for (int i = 0; i < kDstSize; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  // Nothing is converted if any frame is invalid.
+  src_frames[kBatchFrames - 1].data[0] = NULL;
+  memset(dst_opt, 2, kDstSize);
+  EXPECT_EQ(-1, ARGBToI420Batch(src_frames, dst_frames, kBatchFrames,
+                                num_jobs, TestDispatch, &num_calls));
+  EXPECT_EQ(2, dst_opt[0]);
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return num_diff;
+}
+
+TEST_F(LibYUVConvertTest, ARGBToI420Batch) {
+  EXPECT_EQ(0, TestARGBToI420Batch(1, benchmark_iterations_));
+  EXPECT_EQ(0, TestARGBToI420Batch(5, benchmark_iterations_));
+}
+
+static float HalfToFloat(uint16_t h) {
+  int exponent = (h >> 10) & 31;
+  float value = exponent ? (float)((h & 1023) | 1024) * (1 << exponent)
+                         : (float)(h & 1023) * 2.f;
+  value *= 1.f / (1 << 25);
+  return (h & 0x8000) ? -value : value;
+}
+
+// Returns element i of a tensor as a float.
+static float TensorValue(const uint8_t* tensor,
+                         RGBTensorFormat format,
+                         int i) {
+  if (format == kTensorHalfCHW || format == kTensorHalfHWC) {
+    return HalfToFloat(reinterpret_cast<const uint16_t*>(tensor)[i]);
+  }
+  return reinterpret_cast<const float*>(tensor)[i];
+}
+
+static const float kTensorMean[3] = {123.675f, 116.28f, 103.53f};
+static const float kTensorScale[3] = {1.f / 58.395f, 1.f / 57.12f,
+                                      1.f / 57.375f};
+
+// Returns the largest difference between the C and the optimized tensor.
+static float TestARGBToRGBTensor(int src_width,
+                                 int src_height,
+                                 int dst_width,
+                                 int dst_height,
+                                 RGBTensorFormat format,
+                                 FilterMode filtering,
+                                 int benchmark_iterations,
+                                 int disable_cpu_flags,
+                                 int benchmark_cpu_info) {
+  const int kSrcSize = src_width * src_height * 4;
+  const int kDstSize = dst_width * dst_height * 3 * 4;
+  align_buffer_page_end(src_argb, kSrcSize);
+  align_buffer_page_end(dst_c, kDstSize);
+  align_buffer_page_end(dst_opt, kDstSize);
+  MemRandomize(src_argb, kSrcSize);
+  memset(dst_c, 1, kDstSize);
+  memset(dst_opt, 2, kDstSize);
+
+  MaskCpuFlags(disable_cpu_flags);
+  EXPECT_EQ(0, ARGBToRGBTensor(src_argb, src_width * 4, src_width, src_height,
+                               dst_c, dst_width, dst_height, format,
+                               kTensorMean, kTensorScale, filtering));
+  MaskCpuFlags(benchmark_cpu_info);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    EXPECT_EQ(0, ARGBToRGBTensor(src_argb, src_width * 4, src_width,
+                                 src_height, dst_opt, dst_width, dst_height,
+                                 format, kTensorMean, kTensorScale,
+                                 filtering));
+  }
+  float max_diff = 0.f;
+  for (int i = 0; i < dst_width * dst_height * 3; ++i) {
+    float diff = fabsf(TensorValue(dst_c, format, i) -
+                       TensorValue(dst_opt, format, i));
+    if (diff > max_diff) {
+      max_diff = diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return max_diff;
+}
+
+TEST_F(LibYUVConvertTest, ARGBToRGBTensor_Opt) {
+  for (int format = kTensorFloatCHW; format <= kTensorHalfHWC; ++format) {
+    RGBTensorFormat f = static_cast<RGBTensorFormat>(format);
+    EXPECT_LE(TestARGBToRGBTensor(benchmark_width_, benchmark_height_,
+                                  benchmark_width_, benchmark_height_, f,
+                                  kFilterBilinear, benchmark_iterations_,
+                                  disable_cpu_flags_, benchmark_cpu_info_),
+              1e-5f);
+    EXPECT_LE(TestARGBToRGBTensor(benchmark_width_, benchmark_height_, 224,
+                                  224, f, kFilterBilinear, 1,
+                                  disable_cpu_flags_, benchmark_cpu_info_),
+              1e-5f);
+    EXPECT_LE(TestARGBToRGBTensor(benchmark_width_, benchmark_height_, 97, 61,
+                                  f, kFilterNone, 1, disable_cpu_flags_,
+                                  benchmark_cpu_info_),
+              1e-5f);
+    EXPECT_LE(TestARGBToRGBTensor(33, 17, 301, 203, f, kFilterBox, 1,
+                                  disable_cpu_flags_, benchmark_cpu_info_),
+              1e-5f);
+  }
+}
+
+// Checks the normalization and the layouts against the ARGB pixels.
+TEST_F(LibYUVConvertTest, ARGBToRGBTensor_Reference) {
+  const int kWidth = 37;
+  const int kHeight = 9;
+  const int kPlane = kWidth * kHeight;
+  const int kOffsets[3] = {2, 1, 0};  // R, G, B in ARGB.
+  align_buffer_page_end(src_argb, kPlane * 4);
+  align_buffer_page_end(dst_chw, kPlane * 3 * 4);
+  align_buffer_page_end(dst_tensor, kPlane * 3 * 4);
+  MemRandomize(src_argb, kPlane * 4);
+  const float* chw = reinterpret_cast<const float*>(dst_chw);
+
+  EXPECT_EQ(0, ARGBToRGBTensor(src_argb, kWidth * 4, kWidth, kHeight, dst_chw,
+                               kWidth, kHeight, kTensorFloatCHW, kTensorMean,
+                               kTensorScale, kFilterNone));
+  for (int c = 0; c < 3; ++c) {
+    for (int i = 0; i < kPlane; ++i) {
+      float expected =
+          (src_argb[i * 4 + kOffsets[c]] - kTensorMean[c]) * kTensorScale[c];
+      EXPECT_NEAR(expected, chw[c * kPlane + i], 1e-5f);
+    }
+  }
+
+  // Default normalization is 0 to 1.
+  EXPECT_EQ(0, ARGBToRGBTensor(src_argb, kWidth * 4, kWidth, kHeight,
+                               dst_tensor, kWidth, kHeight, kTensorFloatCHW,
+                               NULL, NULL, kFilterNone));
+  for (int i = 0; i < kPlane; ++i) {
+    EXPECT_NEAR(src_argb[i * 4 + 2] / 255.f,
+                reinterpret_cast<const float*>(dst_tensor)[i], 1e-6f);
+  }
+
+  for (int format = kTensorFloatHWC; format <= kTensorHalfHWC; ++format) {
+    RGBTensorFormat f = static_cast<RGBTensorFormat>(format);
+    int hwc = f == kTensorFloatHWC || f == kTensorHalfHWC;
+    // Half floats keep 11 bits and round toward zero.
+    float tolerance = f == kTensorFloatHWC ? 0.f : 1.f / 1024.f;
+    EXPECT_EQ(0, ARGBToRGBTensor(src_argb, kWidth * 4, kWidth, kHeight,
+                                 dst_tensor, kWidth, kHeight, f, kTensorMean,
+                                 kTensorScale, kFilterNone));
+    for (int c = 0; c < 3; ++c) {
+      for (int i = 0; i < kPlane; ++i) {
+        float expected = chw[c * kPlane + i];
+        float value =
+            TensorValue(dst_tensor, f, hwc ? i * 3 + c : c * kPlane + i);
+        EXPECT_NEAR(expected, value, fabsf(expected) * tolerance);
+      }
+    }
+  }
+
+  // Negative height inverts the image.
+  EXPECT_EQ(0, ARGBToRGBTensor(src_argb, kWidth * 4, kWidth, -kHeight,
+                               dst_tensor, kWidth, kHeight, kTensorFloatCHW,
+                               kTensorMean, kTensorScale, kFilterNone));
+  for (int c = 0; c < 3; ++c) {
+    for (int y = 0; y < kHeight; ++y) {
+      EXPECT_EQ(0, memcmp(chw + c * kPlane + y * kWidth,
+                          reinterpret_cast<const float*>(dst_tensor) +
+                              c * kPlane + (kHeight - 1 - y) * kWidth,
+                          kWidth * sizeof(float)));
+    }
+  }
+
+  EXPECT_EQ(-1, ARGBToRGBTensor(src_argb, kWidth * 4, kWidth, kHeight,
+                                dst_tensor, 0, kHeight, kTensorFloatCHW, NULL,
+                                NULL, kFilterNone));
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_chw);
+  free_aligned_buffer_page_end(dst_tensor);
+}
+
+// The YUV sources give the same tensor as converting to ARGB first.
+TEST_F(LibYUVConvertTest, YUVToRGBTensor) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  const int kDstWidth = 160;
+  const int kDstHeight = 120;
+  const int kDstSize = kDstWidth * kDstHeight * 3 * 4;
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_uv, kHalfWidth * kHalfHeight * 2);
+  align_buffer_page_end(argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb, kDstSize);
+  align_buffer_page_end(dst_yuv, kDstSize);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kHalfWidth * kHalfHeight);
+  MemRandomize(src_v, kHalfWidth * kHalfHeight);
+  MergeUVPlane(src_u, kHalfWidth, src_v, kHalfWidth, src_uv, kHalfWidth * 2,
+               kHalfWidth, kHalfHeight);
+
+  I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth, argb,
+             kWidth * 4, kWidth, kHeight);
+  EXPECT_EQ(0, ARGBToRGBTensor(argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                               kDstWidth, kDstHeight, kTensorFloatHWC,
+                               kTensorMean, kTensorScale, kFilterBilinear));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, I420ToRGBTensorMatrix(
+                     src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth,
+                     &kYuvI601Constants, kWidth, kHeight, dst_yuv, kDstWidth,
+                     kDstHeight, kTensorFloatHWC, kTensorMean, kTensorScale,
+                     kFilterBilinear));
+  }
+  EXPECT_EQ(0, memcmp(dst_argb, dst_yuv, kDstSize));
+
+  NV12ToARGB(src_y, kWidth, src_uv, kHalfWidth * 2, argb, kWidth * 4, kWidth,
+             kHeight);
+  EXPECT_EQ(0, ARGBToRGBTensor(argb, kWidth * 4, kWidth, kHeight, dst_argb,
+                               kDstWidth, kDstHeight, kTensorHalfCHW,
+                               kTensorMean, kTensorScale, kFilterBilinear));
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    EXPECT_EQ(0, NV12ToRGBTensorMatrix(
+                     src_y, kWidth, src_uv, kHalfWidth * 2, &kYuvI601Constants,
+                     kWidth, kHeight, dst_yuv, kDstWidth, kDstHeight,
+                     kTensorHalfCHW, kTensorMean, kTensorScale,
+                     kFilterBilinear));
+  }
+  EXPECT_EQ(0, memcmp(dst_argb, dst_yuv, kDstSize / 2));
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(argb);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_yuv);
+}
+
+// Many calls on tiny images, where choosing the row functions is a large part
+// of each call.  Times the per call overhead.
+TEST_F(LibYUVConvertTest, SmallImageCalls) {
+  const int kWidth = 16;
+  const int kHeight = 2;
+  const int kIterations =
+      benchmark_width_ * benchmark_height_ / (kWidth * kHeight) *
+      benchmark_iterations_;
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_u, kWidth / 2);
+  align_buffer_page_end(src_v, kWidth / 2);
+  align_buffer_page_end(dst_argb_c, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb_opt, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_yuv, kWidth * kHeight * 3 / 2);
+  MemRandomize(src_y, kWidth * kHeight);
+  MemRandomize(src_u, kWidth / 2);
+  MemRandomize(src_v, kWidth / 2);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  I420ToARGB(src_y, kWidth, src_u, kWidth / 2, src_v, kWidth / 2, dst_argb_c,
+             kWidth * 4, kWidth, kHeight);
+  MaskCpuFlags(benchmark_cpu_info_);
+  for (int i = 0; i < kIterations; ++i) {
+    I420ToARGB(src_y, kWidth, src_u, kWidth / 2, src_v, kWidth / 2,
+               dst_argb_opt, kWidth * 4, kWidth, kHeight);
+  }
+  for (int i = 0; i < kWidth * kHeight * 4; ++i) {
+    EXPECT_EQ(dst_argb_c[i], dst_argb_opt[i]);
+  }
+  for (int i = 0; i < kIterations; ++i) {
+    ARGBToI420(dst_argb_opt, kWidth * 4, dst_yuv, kWidth,
+               dst_yuv + kWidth * kHeight, kWidth / 2,
+               dst_yuv + kWidth * kHeight * 5 / 4, kWidth / 2, kWidth,
+               kHeight);
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  free_aligned_buffer_page_end(dst_yuv);
+}
+
 }  // namespace libyuv
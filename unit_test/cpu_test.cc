@@ -11,9 +11,15 @@
 #include <stdlib.h>
 #include <string.h>
 
+// row.h defines SIMD_ALIGNED, so include it before unit_test.h.
+#include "libyuv/row.h"  // For GetRowKernels
+
 #include "../unit_test/unit_test.h"
 #include "libyuv/basic_types.h"
+#include "libyuv/convert_argb.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/profile.h"
+#include "libyuv/scale_argb.h"
 #include "libyuv/version.h"
 
 namespace libyuv {
@@ -134,6 +140,19 @@ TEST_F(LibYUVBaseTest, TestCpuId) {
            model);
   }
 }
+
+TEST_F(LibYUVBaseTest, TestCpuCacheSize) {
+  int l1 = GetCpuCacheSize(1);
+  int l2 = GetCpuCacheSize(2);
+  int l3 = GetCpuCacheSize(3);
+  printf("L1 data cache %d KB\n", l1 / 1024);
+  printf("L2 cache %d KB\n", l2 / 1024);
+  printf("L3 cache %d KB\n", l3 / 1024);
+  EXPECT_GE(l1, 0);
+  EXPECT_GE(l2, 0);
+  EXPECT_GE(l3, 0);
+  EXPECT_EQ(0, GetCpuCacheSize(0));
+}
 #endif
 
 static int FileExists(const char* file_name) {
@@ -205,4 +224,104 @@ TEST_F(LibYUVBaseTest, TestSetCpuFlags) {
   MaskCpuFlags(benchmark_cpu_info_);
 }
 
+struct ProfileCallbackCount {
+  int calls;
+  uint64_t pixels;
+};
+
+static void CountProfileCallback(void* opaque,
+                                 const char* name,
+                                 uint64_t start_ns,
+                                 uint64_t nanoseconds,
+                                 uint64_t pixels,
+                                 int kernel) {
+  ProfileCallbackCount* count = static_cast<ProfileCallbackCount*>(opaque);
+  (void)name;
+  (void)start_ns;
+  (void)nanoseconds;
+  (void)kernel;
+  ++count->calls;
+  count->pixels += pixels;
+}
+
+// Each set of flags has its own table, which masking the flags leaves intact.
+TEST_F(LibYUVBaseTest, TestGetRowKernels) {
+  MaskCpuFlags(benchmark_cpu_info_);
+  const struct RowKernels* kernels = GetRowKernels();
+  int cpu_info = TestCpuFlag(-1);
+  EXPECT_EQ(cpu_info, kernels->cpu_info);
+  EXPECT_EQ(kernels, GetRowKernels());
+
+  MaskCpuFlags(1);  // Disable all cpu specific optimizations.
+  const struct RowKernels* kernels_c = GetRowKernels();
+  EXPECT_EQ(TestCpuFlag(-1), kernels_c->cpu_info);
+  EXPECT_EQ(0, kernels_c->I422ToARGBRow_Cpu);
+  EXPECT_EQ(1, kernels_c->I422ToARGBRow_Align);
+  EXPECT_EQ(cpu_info, kernels->cpu_info);
+
+  MaskCpuFlags(benchmark_cpu_info_);
+  EXPECT_EQ(kernels, GetRowKernels());
+}
+
+TEST_F(LibYUVBaseTest, TestProfile) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = (kWidth + 1) / 2;
+  const int kHalfHeight = (kHeight + 1) / 2;
+  align_buffer_page_end(src_y, kWidth * kHeight);
+  align_buffer_page_end(src_u, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(src_v, kHalfWidth * kHalfHeight);
+  align_buffer_page_end(dst_argb, kWidth * kHeight * 4);
+  align_buffer_page_end(dst_argb_half, kHalfWidth * kHalfHeight * 4);
+  memset(src_y, 16, kWidth * kHeight);
+  memset(src_u, 128, kHalfWidth * kHalfHeight);
+  memset(src_v, 128, kHalfWidth * kHalfHeight);
+  ProfileCallbackCount count = {0, 0};
+  ProfileStats stats[kProfileFunctionCount];
+
+  ResetProfileStats();
+  SetProfileCallback(CountProfileCallback, &count);
+  if (!EnableProfile(1)) {
+    printf("Profiling is disabled; Test skipped.\n");
+  } else {
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth, dst_argb,
+               kWidth * 4, kWidth, kHeight);
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth, dst_argb,
+               kWidth * 4, kWidth, -kHeight);
+    ARGBScale(dst_argb, kWidth * 4, kWidth, kHeight, dst_argb_half,
+              kHalfWidth * 4, kHalfWidth, kHalfHeight, kFilterBilinear);
+    // Failed calls are not counted.
+    EXPECT_EQ(-1, I420ToARGB(NULL, kWidth, src_u, kHalfWidth, src_v,
+                             kHalfWidth, dst_argb, kWidth * 4, kWidth,
+                             kHeight));
+    EnableProfile(0);
+    // Nor are calls while profiling is off.
+    I420ToARGB(src_y, kWidth, src_u, kHalfWidth, src_v, kHalfWidth, dst_argb,
+               kWidth * 4, kWidth, kHeight);
+
+    ASSERT_EQ(2, GetProfileStats(stats, kProfileFunctionCount));
+    EXPECT_STREQ("I420ToARGBMatrix", stats[0].name);
+    EXPECT_EQ(2u, stats[0].calls);
+    EXPECT_EQ(2u * kWidth * kHeight, stats[0].pixels);
+    EXPECT_EQ(GetRowKernels()->I422ToARGBRow_Cpu, stats[0].kernel);
+    EXPECT_STREQ("ARGBScale", stats[1].name);
+    EXPECT_EQ(1u, stats[1].calls);
+    EXPECT_EQ(static_cast<uint64_t>(kHalfWidth) * kHalfHeight,
+              stats[1].pixels);
+    EXPECT_EQ(kProfileKernelMixed, stats[1].kernel);
+    EXPECT_EQ(3, count.calls);
+    EXPECT_EQ(stats[0].pixels + stats[1].pixels, count.pixels);
+    EXPECT_EQ(1, GetProfileStats(stats, 1));
+  }
+  SetProfileCallback(NULL, NULL);
+  ResetProfileStats();
+  EXPECT_EQ(0, GetProfileStats(stats, kProfileFunctionCount));
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_argb_half);
+}
+
 }  // namespace libyuv
@@ -2598,6 +2598,107 @@ TEST_F(LibYUVPlanarTest, MergeUVPlane_Opt) {
   free_aligned_buffer_page_end(dst_pixels_c);
 }
 
+// Tile a plane into 16 byte wide tiles of tile_height rows.
+static void TilePlane(const uint8_t* src,
+                      int src_stride,
+                      uint8_t* dst,
+                      int dst_stride,
+                      int width,
+                      int height,
+                      int tile_height) {
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      dst[(y / tile_height) * tile_height * dst_stride +
+          (x / 16) * 16 * tile_height + (y % tile_height) * 16 + x % 16] =
+          src[y * src_stride + x];
+    }
+  }
+}
+
+TEST_F(LibYUVPlanarTest, DetilePlane) {
+  const int kWidth = benchmark_width_;
+  const int kHeight = benchmark_height_;
+  const int kTileStride = (kWidth + 15) & ~15;
+  const int kTileHeight = (kHeight + 31) & ~31;
+  align_buffer_page_end(orig_y, kWidth * kHeight);
+  align_buffer_page_end(tile_y, kTileStride * kTileHeight);
+  align_buffer_page_end(dst_c, kWidth * kHeight);
+  align_buffer_page_end(dst_opt, kWidth * kHeight);
+
+  MemRandomize(orig_y, kWidth * kHeight);
+  memset(tile_y, 0, kTileStride * kTileHeight);
+  memset(dst_c, 1, kWidth * kHeight);
+  memset(dst_opt, 2, kWidth * kHeight);
+  TilePlane(orig_y, kWidth, tile_y, kTileStride, kWidth, kHeight, 32);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  EXPECT_EQ(0, DetilePlane(tile_y, kTileStride, dst_c, kWidth, kWidth, kHeight,
+                           32));
+  MaskCpuFlags(benchmark_cpu_info_);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    DetilePlane(tile_y, kTileStride, dst_opt, kWidth, kWidth, kHeight, 32);
+  }
+
+  for (int i = 0; i < kWidth * kHeight; ++i) {
+    EXPECT_EQ(orig_y[i], dst_c[i]);
+    EXPECT_EQ(orig_y[i], dst_opt[i]);
+  }
+
+  // Tile height must be a power of 2.
+  EXPECT_EQ(-1, DetilePlane(tile_y, kTileStride, dst_c, kWidth, kWidth,
+                            kHeight, 24));
+
+  free_aligned_buffer_page_end(orig_y);
+  free_aligned_buffer_page_end(tile_y);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+}
+
+TEST_F(LibYUVPlanarTest, DetileSplitUVPlane) {
+  const int kWidth = (benchmark_width_ + 1) & ~1;  // Bytes of UV.
+  const int kHeight = benchmark_height_;
+  const int kHalfWidth = kWidth / 2;
+  const int kTileStride = (kWidth + 15) & ~15;
+  const int kTileHeight = (kHeight + 15) & ~15;
+  align_buffer_page_end(orig_uv, kWidth * kHeight);
+  align_buffer_page_end(tile_uv, kTileStride * kTileHeight);
+  align_buffer_page_end(dst_u_c, kHalfWidth * kHeight);
+  align_buffer_page_end(dst_v_c, kHalfWidth * kHeight);
+  align_buffer_page_end(dst_u_opt, kHalfWidth * kHeight);
+  align_buffer_page_end(dst_v_opt, kHalfWidth * kHeight);
+
+  MemRandomize(orig_uv, kWidth * kHeight);
+  memset(tile_uv, 0, kTileStride * kTileHeight);
+  memset(dst_u_c, 1, kHalfWidth * kHeight);
+  memset(dst_v_c, 1, kHalfWidth * kHeight);
+  memset(dst_u_opt, 2, kHalfWidth * kHeight);
+  memset(dst_v_opt, 2, kHalfWidth * kHeight);
+  TilePlane(orig_uv, kWidth, tile_uv, kTileStride, kWidth, kHeight, 16);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  EXPECT_EQ(0, DetileSplitUVPlane(tile_uv, kTileStride, dst_u_c, kHalfWidth,
+                                  dst_v_c, kHalfWidth, kWidth, kHeight, 16));
+  MaskCpuFlags(benchmark_cpu_info_);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    DetileSplitUVPlane(tile_uv, kTileStride, dst_u_opt, kHalfWidth, dst_v_opt,
+                       kHalfWidth, kWidth, kHeight, 16);
+  }
+
+  for (int i = 0; i < kHalfWidth * kHeight; ++i) {
+    EXPECT_EQ(orig_uv[i * 2 + 0], dst_u_c[i]);
+    EXPECT_EQ(orig_uv[i * 2 + 1], dst_v_c[i]);
+    EXPECT_EQ(orig_uv[i * 2 + 0], dst_u_opt[i]);
+    EXPECT_EQ(orig_uv[i * 2 + 1], dst_v_opt[i]);
+  }
+
+  free_aligned_buffer_page_end(orig_uv);
+  free_aligned_buffer_page_end(tile_uv);
+  free_aligned_buffer_page_end(dst_u_c);
+  free_aligned_buffer_page_end(dst_v_c);
+  free_aligned_buffer_page_end(dst_u_opt);
+  free_aligned_buffer_page_end(dst_v_opt);
+}
+
 // 16 bit channel split and merge
 TEST_F(LibYUVPlanarTest, MergeUVPlane_16_Opt) {
   const int kPixels = benchmark_width_ * benchmark_height_;
@@ -12,6 +12,7 @@
 
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/rotate.h"
 #include "libyuv/rotate_argb.h"
 
 namespace libyuv {
@@ -225,4 +226,155 @@ TEST_F(LibYUVRotateTest, RotatePlane90_TestStride) {
   free_aligned_buffer_page_end(src_argb);
 }
 
+// Small tiles that do not divide the frame exercise the tile edges.
+TEST_F(LibYUVRotateTest, RotatePlane90_Tiled) {
+  SetRotateTileSize(20, 24);
+  TestRotatePlane(benchmark_width_ + 1, benchmark_height_ + 1,
+                  benchmark_height_ + 1, benchmark_width_ + 1, kRotate90,
+                  benchmark_iterations_, disable_cpu_flags_,
+                  benchmark_cpu_info_);
+  SetRotateTileSize(0, 0);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane270_Tiled) {
+  SetRotateTileSize(20, 24);
+  TestRotatePlane(benchmark_width_ + 1, benchmark_height_ + 1,
+                  benchmark_height_ + 1, benchmark_width_ + 1, kRotate270,
+                  benchmark_iterations_, disable_cpu_flags_,
+                  benchmark_cpu_info_);
+  SetRotateTileSize(0, 0);
+}
+
+// A tile width that is not a multiple of the kernel block on an aligned
+// width must not select the aligned kernels for the partial tiles, which
+// would write past the end of the destination.
+TEST_F(LibYUVRotateTest, RotatePlane90_TiledAligned) {
+  const int kWidth = (benchmark_width_ + 31) & ~31;
+  const int kHeight = benchmark_height_ > 0 ? benchmark_height_ : 1;
+  const int kSize = kWidth * kHeight;
+  const int kGuard = 4096;
+  align_buffer_page_end(src, kSize);
+  align_buffer_page_end(dst_c, kSize);
+  align_buffer_page_end(dst_opt, kSize + kGuard);
+  MemRandomize(src, kSize);
+  memset(dst_c, 2, kSize);
+  memset(dst_opt, 3, kSize + kGuard);
+
+  MaskCpuFlags(disable_cpu_flags_);
+  RotatePlane(src, kWidth, dst_c, kHeight, kWidth, kHeight, kRotate90);
+  MaskCpuFlags(benchmark_cpu_info_);
+  SetRotateTileSize(20, 24);
+  for (int i = 0; i < benchmark_iterations_; ++i) {
+    RotatePlane(src, kWidth, dst_opt, kHeight, kWidth, kHeight, kRotate90);
+  }
+  SetRotateTileSize(0, 0);
+
+  int guard_diff = 0;
+  for (int i = 0; i < kGuard; ++i) {
+    guard_diff += dst_opt[kSize + i] != 3;
+  }
+  EXPECT_EQ(0, memcmp(dst_c, dst_opt, kSize));
+  EXPECT_EQ(0, guard_diff);
+
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_Tiled) {
+  SetRotateTileSize(3, 0);
+  ARGBTestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
+                 benchmark_height_ + 1, benchmark_width_ + 1, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+  SetRotateTileSize(0, 0);
+}
+
+// Compare throughput of tiled rotation against a single tile covering the
+// whole frame, which is equivalent to rotating without cache blocking.
+static void TestRotateThroughput(int width,
+                                 int height,
+                                 int benchmark_iterations,
+                                 int benchmark_cpu_info,
+                                 const int kBpp) {
+  int src_stride = width * kBpp;
+  int dst_stride = height * kBpp;
+  int plane_size = src_stride * height;
+  align_buffer_page_end(src, plane_size);
+  align_buffer_page_end(dst_untiled, plane_size);
+  align_buffer_page_end(dst_tiled, plane_size);
+  for (int i = 0; i < plane_size; ++i) {
+    src[i] = fastrand() & 0xff;
+  }
+  memset(dst_untiled, 2, plane_size);
+  memset(dst_tiled, 3, plane_size);
+  MaskCpuFlags(benchmark_cpu_info);
+
+  double times[2];
+  for (int tiled = 0; tiled < 2; ++tiled) {
+    uint8_t* dst = tiled ? dst_tiled : dst_untiled;
+    if (tiled) {
+      SetRotateTileSize(0, 0);
+    } else {
+      SetRotateTileSize(width, height);
+    }
+    double time = get_time();
+    for (int i = 0; i < benchmark_iterations; ++i) {
+      if (kBpp == 1) {
+        RotatePlane(src, src_stride, dst, dst_stride, width, height,
+                    kRotate90);
+      } else {
+        ARGBRotate(src, src_stride, dst, dst_stride, width, height,
+                   kRotate90);
+      }
+    }
+    times[tiled] = (get_time() - time) / benchmark_iterations;
+  }
+  SetRotateTileSize(0, 0);
+
+  printf("%s90 %dx%d - %8.2f MB/s untiled - %8.2f MB/s tiled\n",
+         kBpp == 1 ? "RotatePlane" : "ARGBRotate", width, height,
+         plane_size / times[0] * 1e-6, plane_size / times[1] * 1e-6);
+  EXPECT_EQ(0, memcmp(dst_untiled, dst_tiled, plane_size));
+
+  free_aligned_buffer_page_end(dst_tiled);
+  free_aligned_buffer_page_end(dst_untiled);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_Throughput_720p) {
+  TestRotateThroughput(1280, 720, benchmark_iterations_, benchmark_cpu_info_,
+                       1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_Throughput_1080p) {
+  TestRotateThroughput(1920, 1080, benchmark_iterations_, benchmark_cpu_info_,
+                       1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_Throughput_2160p) {
+  TestRotateThroughput(3840, 2160, benchmark_iterations_, benchmark_cpu_info_,
+                       1);
+}
+
+TEST_F(LibYUVRotateTest, RotatePlane90_Throughput_4320p) {
+  TestRotateThroughput(7680, 4320, benchmark_iterations_, benchmark_cpu_info_,
+                       1);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_Throughput_720p) {
+  TestRotateThroughput(1280, 720, benchmark_iterations_, benchmark_cpu_info_,
+                       4);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_Throughput_1080p) {
+  TestRotateThroughput(1920, 1080, benchmark_iterations_, benchmark_cpu_info_,
+                       4);
+}
+
+TEST_F(LibYUVRotateTest, ARGBRotate90_Throughput_2160p) {
+  TestRotateThroughput(3840, 2160, benchmark_iterations_, benchmark_cpu_info_,
+                       4);
+}
+
 }  // namespace libyuv
@@ -104,6 +104,21 @@ TEST_F(LibYUVRotateTest, I420Rotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+// Even sizes that are not a multiple of the 16 and 32 pixel transpose tiles.
+TEST_F(LibYUVRotateTest, I420Rotate90_Any) {
+  I420TestRotate(benchmark_width_ - 4, benchmark_height_ - 4,
+                 benchmark_height_ - 4, benchmark_width_ - 4, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, I420Rotate270_Any) {
+  I420TestRotate(benchmark_width_ - 4, benchmark_height_ - 4,
+                 benchmark_height_ - 4, benchmark_width_ - 4, kRotate270,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
 // TODO(fbarchard): Remove odd width tests.
 // Odd width tests work but disabled because they use C code and can be
 // tested by passing an odd width command line or environment variable.
@@ -339,6 +354,37 @@ TEST_F(LibYUVRotateTest, NV12Rotate270_Opt) {
                  disable_cpu_flags_, benchmark_cpu_info_);
 }
 
+TEST_F(LibYUVRotateTest, NV12Rotate90_Any) {
+  NV12TestRotate(benchmark_width_ - 4, benchmark_height_ - 4,
+                 benchmark_height_ - 4, benchmark_width_ - 4, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12Rotate270_Any) {
+  NV12TestRotate(benchmark_width_ - 4, benchmark_height_ - 4,
+                 benchmark_height_ - 4, benchmark_width_ - 4, kRotate270,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+}
+
+TEST_F(LibYUVRotateTest, NV12Rotate90_Tiled) {
+  SetRotateTileSize(20, 24);
+  NV12TestRotate(benchmark_width_ - 4, benchmark_height_ - 4,
+                 benchmark_height_ - 4, benchmark_width_ - 4, kRotate90,
+                 benchmark_iterations_, disable_cpu_flags_,
+                 benchmark_cpu_info_);
+  SetRotateTileSize(0, 0);
+}
+
+TEST_F(LibYUVRotateTest, NV12Rotate90_TiledAligned) {
+  SetRotateTileSize(20, 24);
+  NV12TestRotate(benchmark_width_, benchmark_height_, benchmark_height_,
+                 benchmark_width_, kRotate90, benchmark_iterations_,
+                 disable_cpu_flags_, benchmark_cpu_info_);
+  SetRotateTileSize(0, 0);
+}
+
 TEST_F(LibYUVRotateTest, DISABLED_NV12Rotate0_Odd) {
   NV12TestRotate(benchmark_width_ + 1, benchmark_height_ + 1,
                  benchmark_width_ + 1, benchmark_height_ + 1, kRotate0,
@@ -12,7 +12,9 @@
 #include <time.h>
 
 #include "../unit_test/unit_test.h"
+#include "libyuv/convert.h"
 #include "libyuv/convert_argb.h"
+#include "libyuv/convert_from_argb.h"
 #include "libyuv/cpu_id.h"
 #include "libyuv/scale_argb.h"
 #include "libyuv/video_common.h"
@@ -345,6 +347,29 @@ TEST_SCALESWAPXY1(ARGBScale, Linear, 0)
 TEST_SCALESWAPXY1(ARGBScale, Bilinear, 0)
 #undef TEST_SCALESWAPXY1
 
+// The polyphase filters are exact between C and SIMD, and clipped tiles match
+// the full image.
+#define TEST_POLYPHASE1(name, sw, sh, dw, dh, filter)                      \
+  TEST_F(LibYUVScaleTest, ARGBScalePolyphase##name##_##filter) {           \
+    EXPECT_EQ(0, ARGBTestFilter(sw, sh, dw, dh, kFilter##filter,           \
+                                benchmark_iterations_, disable_cpu_flags_, \
+                                benchmark_cpu_info_));                     \
+  }                                                                        \
+  TEST_F(LibYUVScaleTest, ARGBScaleClipPolyphase##name##_##filter) {       \
+    EXPECT_EQ(0, ARGBClipTestFilter(sw, sh, dw, dh, kFilter##filter, 1));  \
+  }
+
+#define TEST_POLYPHASE(name, sw, sh, dw, dh)     \
+  TEST_POLYPHASE1(name, sw, sh, dw, dh, Bicubic) \
+  TEST_POLYPHASE1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_POLYPHASE(Down, 1281, 723, 359, 201)
+TEST_POLYPHASE(Up, 321, 179, 1279, 721)
+TEST_POLYPHASE(Tiny, 3, 5, 17, 2)
+TEST_POLYPHASE(Mirror, -640, 360, 1280, 720)
+#undef TEST_POLYPHASE1
+#undef TEST_POLYPHASE
+
 // Scale with YUV conversion to ARGB and clipping.
 // TODO(fbarchard): Add fourcc support.  All 4 ARGB formats is easy to support.
 LIBYUV_API
@@ -489,6 +514,383 @@ TEST_F(LibYUVScaleTest, YUVToRGBScaleDown) {
   EXPECT_LE(diff, 10);
 }
 
+// Scale and convert I420 in one pass and compare to I420Scale followed by a
+// conversion.  dst_fourcc is ARGB, ABGR or AR30.  Returns the number of
+// different bytes.
+static int I420ScaleToRGBTest(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode f,
+                              uint32_t dst_fourcc,
+                              int benchmark_iterations) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_y_plane_size = src_width * Abs(src_height);
+  int src_uv_plane_size = src_width_uv * src_height_uv;
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv;
+  int dst_stride_argb = dst_width * 4;
+  int dst_argb_plane_size = dst_stride_argb * dst_height;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  align_buffer_page_end(dst_i420, dst_y_plane_size + dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_argb_c, dst_argb_plane_size);
+  align_buffer_page_end(dst_argb_opt, dst_argb_plane_size);
+  uint8_t* dst_u = dst_i420 + dst_y_plane_size;
+  uint8_t* dst_v = dst_u + dst_uv_plane_size;
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+  memset(dst_argb_c, 2, dst_argb_plane_size);
+  memset(dst_argb_opt, 3, dst_argb_plane_size);
+
+  I420Scale(src_y, src_width, src_u, src_width_uv, src_v, src_width_uv,
+            src_width, src_height, dst_i420, dst_width, dst_u, dst_width_uv,
+            dst_v, dst_width_uv, dst_width, dst_height, f);
+  if (dst_fourcc == FOURCC_ABGR) {
+    I420ToABGR(dst_i420, dst_width, dst_u, dst_width_uv, dst_v, dst_width_uv,
+               dst_argb_c, dst_stride_argb, dst_width, dst_height);
+  } else if (dst_fourcc == FOURCC_AR30) {
+    I420ToAR30(dst_i420, dst_width, dst_u, dst_width_uv, dst_v, dst_width_uv,
+               dst_argb_c, dst_stride_argb, dst_width, dst_height);
+  } else {
+    I420ToARGB(dst_i420, dst_width, dst_u, dst_width_uv, dst_v, dst_width_uv,
+               dst_argb_c, dst_stride_argb, dst_width, dst_height);
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (dst_fourcc == FOURCC_ABGR) {
+      I420ScaleToABGR(src_y, src_width, src_u, src_width_uv, src_v,
+                      src_width_uv, src_width, src_height, dst_argb_opt,
+                      dst_stride_argb, dst_width, dst_height, f);
+    } else if (dst_fourcc == FOURCC_AR30) {
+      I420ScaleToAR30(src_y, src_width, src_u, src_width_uv, src_v,
+                      src_width_uv, src_width, src_height, dst_argb_opt,
+                      dst_stride_argb, dst_width, dst_height, f);
+    } else {
+      I420ScaleToARGB(src_y, src_width, src_u, src_width_uv, src_v,
+                      src_width_uv, src_width, src_height, dst_argb_opt,
+                      dst_stride_argb, dst_width, dst_height, f);
+    }
+  }
+
+  int num_diff = 0;
+  for (int i = 0; i < dst_argb_plane_size; ++i) {
+    if (dst_argb_c[i] != dst_argb_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  free_aligned_buffer_page_end(dst_i420);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  return num_diff;
+}
+
+// Scale and convert NV12 in one pass and compare to NV12Scale followed by a
+// conversion.  dst_fourcc is ARGB, ABGR or AR30.  Returns the maximum
+// difference.
+static int NV12ScaleToRGBTest(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode f,
+                              uint32_t dst_fourcc,
+                              int benchmark_iterations) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_y_plane_size = src_width * Abs(src_height);
+  int src_uv_plane_size = src_width_uv * src_height_uv * 2;
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv * 2;
+  int dst_stride_argb = dst_width * 4;
+  int dst_argb_plane_size = dst_stride_argb * dst_height;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_uv, src_uv_plane_size);
+  align_buffer_page_end(dst_nv12, dst_y_plane_size + dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_argb_c, dst_argb_plane_size);
+  align_buffer_page_end(dst_argb_opt, dst_argb_plane_size);
+  uint8_t* dst_uv = dst_nv12 + dst_y_plane_size;
+  // I420 chroma for the AR30 reference, after the NV12 chroma.
+  uint8_t* dst_u = dst_uv + dst_uv_plane_size;
+  uint8_t* dst_v = dst_u + dst_uv_plane_size / 2;
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_uv, src_uv_plane_size);
+  memset(dst_argb_c, 2, dst_argb_plane_size);
+  memset(dst_argb_opt, 3, dst_argb_plane_size);
+
+  NV12Scale(src_y, src_width, src_uv, src_width_uv * 2, src_width, src_height,
+            dst_nv12, dst_width, dst_uv, dst_width_uv * 2, dst_width,
+            dst_height, f);
+  if (dst_fourcc == FOURCC_ABGR) {
+    NV12ToABGR(dst_nv12, dst_width, dst_uv, dst_width_uv * 2, dst_argb_c,
+               dst_stride_argb, dst_width, dst_height);
+  } else if (dst_fourcc == FOURCC_AR30) {
+    SplitUVPlane(dst_uv, dst_width_uv * 2, dst_u, dst_width_uv, dst_v,
+                 dst_width_uv, dst_width_uv, dst_height_uv);
+    I420ToAR30(dst_nv12, dst_width, dst_u, dst_width_uv, dst_v, dst_width_uv,
+               dst_argb_c, dst_stride_argb, dst_width, dst_height);
+  } else {
+    NV12ToARGB(dst_nv12, dst_width, dst_uv, dst_width_uv * 2, dst_argb_c,
+               dst_stride_argb, dst_width, dst_height);
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (dst_fourcc == FOURCC_ABGR) {
+      NV12ScaleToABGR(src_y, src_width, src_uv, src_width_uv * 2, src_width,
+                      src_height, dst_argb_opt, dst_stride_argb, dst_width,
+                      dst_height, f);
+    } else if (dst_fourcc == FOURCC_AR30) {
+      NV12ScaleToAR30(src_y, src_width, src_uv, src_width_uv * 2, src_width,
+                      src_height, dst_argb_opt, dst_stride_argb, dst_width,
+                      dst_height, f);
+    } else {
+      NV12ScaleToARGB(src_y, src_width, src_uv, src_width_uv * 2, src_width,
+                      src_height, dst_argb_opt, dst_stride_argb, dst_width,
+                      dst_height, f);
+    }
+  }
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_argb_plane_size; ++i) {
+    int abs_diff = Abs(dst_argb_c[i] - dst_argb_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  free_aligned_buffer_page_end(dst_nv12);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  return max_diff;
+}
+
+// Scale and convert P010 in one pass and compare to P010Scale followed by a
+// conversion with BT.2020.  dst_fourcc is ARGB, ABGR or AR30.  Returns the
+// number of different bytes.
+static int P010ScaleToRGBTest(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode f,
+                              uint32_t dst_fourcc,
+                              int benchmark_iterations) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_y_plane_size = src_width * Abs(src_height) * 2;
+  int src_uv_plane_size = src_width_uv * src_height_uv * 4;
+  int dst_y_plane_size = dst_width * dst_height * 2;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv * 4;
+  int dst_stride_argb = dst_width * 4;
+  int dst_argb_plane_size = dst_stride_argb * dst_height;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_uv, src_uv_plane_size);
+  align_buffer_page_end(dst_p010, dst_y_plane_size + dst_uv_plane_size);
+  align_buffer_page_end(dst_argb_c, dst_argb_plane_size);
+  align_buffer_page_end(dst_argb_opt, dst_argb_plane_size);
+  uint16_t* src_y_16 = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* src_uv_16 = reinterpret_cast<uint16_t*>(src_uv);
+  uint16_t* dst_y_16 = reinterpret_cast<uint16_t*>(dst_p010);
+  uint16_t* dst_uv_16 =
+      reinterpret_cast<uint16_t*>(dst_p010 + dst_y_plane_size);
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_uv, src_uv_plane_size);
+  // P010 keeps 10 bits in the upper bits.
+  for (int i = 0; i < src_y_plane_size / 2; ++i) {
+    src_y_16[i] &= 0xffc0;
+  }
+  for (int i = 0; i < src_uv_plane_size / 2; ++i) {
+    src_uv_16[i] &= 0xffc0;
+  }
+  memset(dst_argb_c, 2, dst_argb_plane_size);
+  memset(dst_argb_opt, 3, dst_argb_plane_size);
+
+  P010Scale(src_y_16, src_width, src_uv_16, src_width_uv * 2, src_width,
+            src_height, dst_y_16, dst_width, dst_uv_16, dst_width_uv * 2,
+            dst_width, dst_height, f);
+  if (dst_fourcc == FOURCC_AR30) {
+    P010ToAR30Matrix(dst_y_16, dst_width, dst_uv_16, dst_width_uv * 2,
+                     dst_argb_c, dst_stride_argb, &kYuv2020Constants,
+                     dst_width, dst_height);
+  } else {
+    P010ToARGBMatrix(dst_y_16, dst_width, dst_uv_16, dst_width_uv * 2,
+                     dst_argb_c, dst_stride_argb, &kYuv2020Constants,
+                     dst_width, dst_height);
+    if (dst_fourcc == FOURCC_ABGR) {
+      ARGBToABGR(dst_argb_c, dst_stride_argb, dst_argb_c, dst_stride_argb,
+                 dst_width, dst_height);
+    }
+  }
+
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    if (dst_fourcc == FOURCC_ABGR) {
+      P010ScaleToABGR(src_y_16, src_width, src_uv_16, src_width_uv * 2,
+                      src_width, src_height, dst_argb_opt, dst_stride_argb,
+                      dst_width, dst_height, f);
+    } else if (dst_fourcc == FOURCC_AR30) {
+      P010ScaleToAR30(src_y_16, src_width, src_uv_16, src_width_uv * 2,
+                      src_width, src_height, dst_argb_opt, dst_stride_argb,
+                      dst_width, dst_height, f);
+    } else {
+      P010ScaleToARGB(src_y_16, src_width, src_uv_16, src_width_uv * 2,
+                      src_width, src_height, dst_argb_opt, dst_stride_argb,
+                      dst_width, dst_height, f);
+    }
+  }
+
+  int num_diff = 0;
+  for (int i = 0; i < dst_argb_plane_size; ++i) {
+    if (dst_argb_c[i] != dst_argb_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_argb_c);
+  free_aligned_buffer_page_end(dst_argb_opt);
+  free_aligned_buffer_page_end(dst_p010);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  return num_diff;
+}
+
+#define TEST_SCALETORGB1(name, sw, sh, dw, dh, filter)                      \
+  TEST_F(LibYUVScaleTest, I420ScaleToARGB##name##_##filter) {               \
+    EXPECT_EQ(0, I420ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ARGB, benchmark_iterations_));   \
+    EXPECT_EQ(0, I420ScaleToRGBTest(sw, -(sh), dw, dh, kFilter##filter,     \
+                                    FOURCC_ARGB, 1));                       \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, I420ScaleToABGR##name##_##filter) {               \
+    EXPECT_EQ(0, I420ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ABGR, 1));                       \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, I420ScaleToAR30##name##_##filter) {               \
+    EXPECT_EQ(0, I420ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_AR30, 1));                       \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, NV12ScaleToARGB##name##_##filter) {               \
+    EXPECT_EQ(0, NV12ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ARGB, benchmark_iterations_));   \
+    EXPECT_EQ(0, NV12ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ABGR, 1));                       \
+    EXPECT_EQ(0, NV12ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_AR30, 1));                       \
+  }                                                                         \
+  TEST_F(LibYUVScaleTest, P010ScaleToARGB##name##_##filter) {               \
+    EXPECT_EQ(0, P010ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ARGB, benchmark_iterations_));   \
+    EXPECT_EQ(0, P010ScaleToRGBTest(sw, -(sh), dw, dh, kFilter##filter,     \
+                                    FOURCC_ARGB, 1));                       \
+    EXPECT_EQ(0, P010ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_ABGR, 1));                       \
+    EXPECT_EQ(0, P010ScaleToRGBTest(sw, sh, dw, dh, kFilter##filter,        \
+                                    FOURCC_AR30, 1));                       \
+  }
+
+#define TEST_SCALETORGB(name, sw, sh, dw, dh)        \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, None)     \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, Box)      \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_SCALETORGB1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_SCALETORGB(Down2, 1280, 720, 640, 360)
+TEST_SCALETORGB(Down3by4, 1280, 720, 960, 540)
+TEST_SCALETORGB(Down, 1281, 723, 359, 201)
+TEST_SCALETORGB(Up2, 321, 179, 642, 358)
+TEST_SCALETORGB(Up, 321, 179, 1279, 721)
+TEST_SCALETORGB(UpHorizontal, 320, 180, 640, 180)
+
+// Time the fused I420 scale and convert against I420Scale followed by
+// I420ToARGB, for the polyphase filters.  The fused path must not be much
+// slower, as it scales the same rows without the intermediate frame.
+static void I420ScaleToARGBBenchmark(int src_width,
+                                     int src_height,
+                                     int dst_width,
+                                     int dst_height,
+                                     FilterMode f,
+                                     int benchmark_iterations) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (src_height + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_y_plane_size = src_width * src_height;
+  int src_uv_plane_size = src_width_uv * src_height_uv;
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv;
+  int dst_stride_argb = dst_width * 4;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  align_buffer_page_end(dst_i420, dst_y_plane_size + dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_argb, dst_stride_argb * dst_height);
+  uint8_t* dst_u = dst_i420 + dst_y_plane_size;
+  uint8_t* dst_v = dst_u + dst_uv_plane_size;
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+
+  double two_pass_time = get_time();
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    I420Scale(src_y, src_width, src_u, src_width_uv, src_v, src_width_uv,
+              src_width, src_height, dst_i420, dst_width, dst_u, dst_width_uv,
+              dst_v, dst_width_uv, dst_width, dst_height, f);
+    I420ToARGB(dst_i420, dst_width, dst_u, dst_width_uv, dst_v, dst_width_uv,
+               dst_argb, dst_stride_argb, dst_width, dst_height);
+  }
+  two_pass_time = (get_time() - two_pass_time) / benchmark_iterations;
+
+  double fused_time = get_time();
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    I420ScaleToARGB(src_y, src_width, src_u, src_width_uv, src_v, src_width_uv,
+                    src_width, src_height, dst_argb, dst_stride_argb,
+                    dst_width, dst_height, f);
+  }
+  fused_time = (get_time() - fused_time) / benchmark_iterations;
+
+  printf("I420ScaleToARGB %dx%d to %dx%d - %8.2f us fused, %8.2f us two pass\n",
+         src_width, src_height, dst_width, dst_height, fused_time * 1e6,
+         two_pass_time * 1e6);
+  // Loose bound, as the timings of a loaded machine are noisy.
+  EXPECT_LE(fused_time, two_pass_time * 2 + 0.001);
+
+  free_aligned_buffer_page_end(dst_argb);
+  free_aligned_buffer_page_end(dst_i420);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+}
+
+TEST_F(LibYUVScaleTest, I420ScaleToARGBBenchmark_Bicubic) {
+  I420ScaleToARGBBenchmark(benchmark_width_, benchmark_height_,
+                           benchmark_width_ * 3 / 4, benchmark_height_ * 3 / 4,
+                           kFilterBicubic, benchmark_iterations_);
+}
+
+TEST_F(LibYUVScaleTest, I420ScaleToARGBBenchmark_Lanczos) {
+  I420ScaleToARGBBenchmark(benchmark_width_, benchmark_height_,
+                           benchmark_width_ * 3 / 4, benchmark_height_ * 3 / 4,
+                           kFilterLanczos, benchmark_iterations_);
+}
+
 TEST_F(LibYUVScaleTest, ARGBTest3x) {
   const int kSrcStride = 48 * 4;
   const int kDstStride = 16 * 4;
@@ -564,4 +966,209 @@ TEST_F(LibYUVScaleTest, ARGBTest4x) {
   free_aligned_buffer_page_end(orig_pixels);
 }
 
+// Scales a batch of frames of different sizes and compares each frame with
+// ARGBScale.
+static int TestARGBScaleBatch(FilterMode f, int num_jobs) {
+  const int kFrames = 12;
+  const int kSlot = 160 * 100 * 4;
+  LibyuvConstFrame src_frames[kFrames];
+  LibyuvFrame dst_frames[kFrames];
+  int num_calls = 0;
+  int num_diff = 0;
+  align_buffer_page_end(src_argb, kSlot * kFrames);
+  align_buffer_page_end(dst_c, kSlot * kFrames);
+  align_buffer_page_end(dst_opt, kSlot * kFrames);
+  MemRandomize(src_argb, kSlot * kFrames);
+  memset(dst_c, 1, kSlot * kFrames);
+  memset(dst_opt, 1, kSlot * kFrames);
+
+  // Frames come in pairs of the same size, so jobs reuse their scaler.
+  for (int i = 0; i < kFrames; ++i) {
+    int g = i >> 1;
+    int src_width = 40 + g * 9;
+    int src_height = 30 + g * 5;
+    int dst_width = 150 - g * 11;
+    int dst_height = g & 1 ? 90 - g * 3 : 20 + g * 4;
+    src_frames[i].data[0] = src_argb + i * kSlot;
+    src_frames[i].stride[0] = src_width * 4;
+    src_frames[i].width = src_width;
+    src_frames[i].height = i == 5 ? -src_height : src_height;
+    dst_frames[i].data[0] = dst_opt + i * kSlot;
+    dst_frames[i].stride[0] = dst_width * 4;
+    dst_frames[i].width = dst_width;
+    dst_frames[i].height = dst_height;
+    ARGBScale(src_frames[i].data[0], src_width * 4, src_width,
+              src_frames[i].height, dst_c + i * kSlot, dst_width * 4,
+              dst_width, dst_height, f);
+  }
+  EXPECT_EQ(0, ARGBScaleBatch(src_frames, dst_frames, kFrames, f, num_jobs,
+                              TestDispatch, &num_calls));
+  EXPECT_EQ(num_jobs > 1 ? 1 : 0, num_calls);
+  for (int i = 0; i < kSlot * kFrames; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  // Nothing is scaled if any frame is invalid.
+  dst_frames[kFrames - 1].width = 0;
+  memset(dst_opt, 2, kSlot * kFrames);
+  EXPECT_EQ(-1, ARGBScaleBatch(src_frames, dst_frames, kFrames, f, num_jobs,
+                               TestDispatch, &num_calls));
+  EXPECT_EQ(2, dst_opt[0]);
+
+  free_aligned_buffer_page_end(src_argb);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  return num_diff;
+}
+
+TEST_F(LibYUVScaleTest, ARGBScaleBatch) {
+  EXPECT_EQ(0, TestARGBScaleBatch(kFilterNone, 1));
+  EXPECT_EQ(0, TestARGBScaleBatch(kFilterBilinear, 1));
+  EXPECT_EQ(0, TestARGBScaleBatch(kFilterBox, 3));
+  EXPECT_EQ(0, TestARGBScaleBatch(kFilterBicubic, 3));
+}
+
+// Scale with a caller supplied scratch and compare to ARGBScale.
+static int ARGBTestScratch(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           FilterMode f) {
+  const int src_size = src_width * src_height * 4;
+  const int dst_size = dst_width * dst_height * 4;
+  int scratch_size =
+      ARGBScaleScratchSize(src_width, src_height, dst_width, dst_height, f);
+  EXPECT_LE(0, scratch_size);
+  align_buffer_page_end(src_argb, src_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  align_buffer_page_end(scratch_mem, scratch_size + 1);
+  MemRandomize(src_argb, src_size);
+  memset(dst_c, 1, dst_size);
+  memset(dst_opt, 2, dst_size);
+  LibyuvScratch scratch = {scratch_mem, (size_t)scratch_size};
+
+  ARGBScale(src_argb, src_width * 4, src_width, src_height, dst_c,
+            dst_width * 4, dst_width, dst_height, f);
+  ARGBScale_WithScratch(src_argb, src_width * 4, src_width, src_height,
+                        dst_opt, dst_width * 4, dst_width, dst_height, f,
+                        &scratch);
+
+  int num_diff = 0;
+  for (int i = 0; i < dst_size; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(scratch_mem);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src_argb);
+  return num_diff;
+}
+
+#define TEST_SCRATCH1(name, sw, sh, dw, dh, filter)                  \
+  TEST_F(LibYUVScaleTest, ARGBScratch##name##_##filter) {            \
+    EXPECT_EQ(0, ARGBTestScratch(sw, sh, dw, dh, kFilter##filter));  \
+  }
+
+#define TEST_SCRATCH(name, sw, sh, dw, dh)        \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, None)     \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Box)      \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_SCRATCH(Down4, 1280, 720, 320, 180)
+TEST_SCRATCH(Down, 1281, 723, 359, 201)
+TEST_SCRATCH(Up, 321, 179, 1279, 721)
+#undef TEST_SCRATCH1
+#undef TEST_SCRATCH
+
+// Scale a clip of the destination with a caller supplied scratch, from ARGB
+// and from I420, and compare to ARGBScaleClip and YUVToARGBScaleClip.
+static int ARGBClipTestScratch(int src_width,
+                               int src_height,
+                               int dst_width,
+                               int dst_height,
+                               FilterMode f) {
+  const int src_size = src_width * src_height * 4;
+  const int dst_size = dst_width * dst_height * 4;
+  const int src_halfwidth = (src_width + 1) / 2;
+  const int src_halfheight = (src_height + 1) / 2;
+  const int clip_x = dst_width / 4;
+  const int clip_y = dst_height / 4;
+  const int clip_width = dst_width / 2;
+  const int clip_height = dst_height / 2;
+  int scratch_size = YUVToARGBScaleClipScratchSize(src_width, src_height,
+                                                   dst_width, dst_height, f);
+  EXPECT_LE(0, scratch_size);
+  align_buffer_page_end(src_argb, src_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  align_buffer_page_end(scratch_mem, scratch_size + 1);
+  MemRandomize(src_argb, src_size);
+  // Only the clip is written, so the rest of both must start out the same.
+  memset(dst_c, 1, dst_size);
+  memset(dst_opt, 1, dst_size);
+  LibyuvScratch scratch = {scratch_mem, (size_t)scratch_size};
+  const uint8_t* src_u = src_argb + src_width * src_height;
+  const uint8_t* src_v = src_u + src_halfwidth * src_halfheight;
+  int num_diff = 0;
+
+  ARGBScaleClip(src_argb, src_width * 4, src_width, src_height, dst_c,
+                dst_width * 4, dst_width, dst_height, clip_x, clip_y,
+                clip_width, clip_height, f);
+  ARGBScaleClip_WithScratch(src_argb, src_width * 4, src_width, src_height,
+                            dst_opt, dst_width * 4, dst_width, dst_height,
+                            clip_x, clip_y, clip_width, clip_height, f,
+                            &scratch);
+  for (int i = 0; i < dst_size; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  YUVToARGBScaleClip(src_argb, src_width, src_u, src_halfwidth, src_v,
+                     src_halfwidth, libyuv::FOURCC_I420, src_width, src_height,
+                     dst_c, dst_width * 4, libyuv::FOURCC_ARGB, dst_width,
+                     dst_height, clip_x, clip_y, clip_width, clip_height, f);
+  YUVToARGBScaleClip_WithScratch(
+      src_argb, src_width, src_u, src_halfwidth, src_v, src_halfwidth,
+      libyuv::FOURCC_I420, src_width, src_height, dst_opt, dst_width * 4,
+      libyuv::FOURCC_ARGB, dst_width, dst_height, clip_x, clip_y, clip_width,
+      clip_height, f, &scratch);
+  for (int i = 0; i < dst_size; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(scratch_mem);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src_argb);
+  return num_diff;
+}
+
+#define TEST_SCRATCH1(name, sw, sh, dw, dh, filter)                     \
+  TEST_F(LibYUVScaleTest, ARGBClipScratch##name##_##filter) {           \
+    EXPECT_EQ(0, ARGBClipTestScratch(sw, sh, dw, dh, kFilter##filter)); \
+  }
+
+#define TEST_SCRATCH(name, sw, sh, dw, dh)        \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, None)     \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Box)      \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bicubic)
+
+TEST_SCRATCH(Down, 1281, 723, 359, 201)
+TEST_SCRATCH(Up, 321, 179, 1279, 721)
+#undef TEST_SCRATCH1
+#undef TEST_SCRATCH
+
 }  // namespace libyuv
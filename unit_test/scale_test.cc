@@ -13,7 +13,11 @@
 
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
 #include "libyuv/scale.h"
+#include "libyuv/scale_argb.h"
+#include "libyuv/scale_uv.h"
+#include "libyuv/slice.h"
 
 #ifdef ENABLE_ROW_TESTS
 #include "libyuv/scale_row.h"  // For ScaleRowDown2Box_Odd_C
@@ -1102,6 +1106,542 @@ TEST_SCALESWAPXY1(DISABLED_, Scale, Box, 3)
 
 #undef TEST_SCALESWAPXY1
 
+// Test widths that use the remainder and 64 bit paths of the column filters,
+// and the 3/4 and 3/8 row scalers at widths that are not a multiple of their
+// SIMD step.
+#define TEST_SCALECOLS1(name, sw, sh, dw, dh, filter, max_diff)              \
+  TEST_F(LibYUVScaleTest, I420ScaleCols##name##_##filter) {                 \
+    int diff = I420TestFilter(sw, sh, dw, dh, kFilter##filter,             \
+                              benchmark_iterations_, disable_cpu_flags_,    \
+                              benchmark_cpu_info_);                         \
+    EXPECT_LE(diff, max_diff);                                              \
+  }
+
+#define TEST_SCALECOLS(name, sw, sh, dw, dh)         \
+  TEST_SCALECOLS1(name, sw, sh, dw, dh, None, 0)     \
+  TEST_SCALECOLS1(name, sw, sh, dw, dh, Linear, 3)   \
+  TEST_SCALECOLS1(name, sw, sh, dw, dh, Bilinear, 3) \
+  TEST_SCALECOLS1(name, sw, sh, dw, dh, Box, 3)
+
+TEST_SCALECOLS(Odd, 1283, 17, 937, 13)
+TEST_SCALECOLS(Up, 937, 13, 1283, 17)
+TEST_SCALECOLS(3by4, 1284, 16, 963, 12)
+TEST_SCALECOLS(3by8, 1288, 16, 483, 6)
+#undef TEST_SCALECOLS1
+#undef TEST_SCALECOLS
+
+// Source widths of 32768 or more are beyond SizeValid and use the 64 bit
+// column filters.  Test a few rows of one with C vs Opt.  A negative source
+// width mirrors.
+static int PlaneTestWide(int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         FilterMode f,
+                         int benchmark_iterations,
+                         int disable_cpu_flags,
+                         int benchmark_cpu_info) {
+  int i;
+  int64_t src_plane_size = (int64_t)(Abs(src_width)) * src_height;
+  int64_t dst_plane_size = (int64_t)(dst_width)*dst_height;
+
+  align_buffer_page_end(src_y, src_plane_size);
+  align_buffer_page_end(dst_y_c, dst_plane_size);
+  align_buffer_page_end(dst_y_opt, dst_plane_size);
+  if (!src_y || !dst_y_c || !dst_y_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  MemRandomize(src_y, src_plane_size);
+  memset(dst_y_c, 2, dst_plane_size);
+  memset(dst_y_opt, 3, dst_plane_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  ScalePlane(src_y, Abs(src_width), src_width, src_height, dst_y_c, dst_width,
+             dst_width, dst_height, f);
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    ScalePlane(src_y, Abs(src_width), src_width, src_height, dst_y_opt,
+               dst_width, dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_plane_size; ++i) {
+    int abs_diff = Abs(dst_y_c[i] - dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(src_y);
+  return max_diff;
+}
+
+TEST_F(LibYUVScaleTest, ScalePlaneWide_Linear) {
+  int diff = PlaneTestWide(40000, 8, 30001, 6, kFilterLinear,
+                           benchmark_iterations_, disable_cpu_flags_,
+                           benchmark_cpu_info_);
+  EXPECT_LE(diff, 3);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlaneWide_Bilinear) {
+  int diff = PlaneTestWide(40000, 8, 30001, 6, kFilterBilinear,
+                           benchmark_iterations_, disable_cpu_flags_,
+                           benchmark_cpu_info_);
+  EXPECT_LE(diff, 3);
+}
+
+TEST_F(LibYUVScaleTest, ScalePlaneWideUp_Bilinear) {
+  int diff = PlaneTestWide(33001, 4, 50000, 6, kFilterBilinear,
+                           benchmark_iterations_, disable_cpu_flags_,
+                           benchmark_cpu_info_);
+  EXPECT_LE(diff, 3);
+}
+
+#define TEST_SCALEMIRROR(name, sw, sh, dw, dh, filter, max_diff)          \
+  TEST_F(LibYUVScaleTest, ScalePlaneMirror##name##_##filter) {            \
+    int diff = PlaneTestWide(sw, sh, dw, dh, kFilter##filter,             \
+                             benchmark_iterations_, disable_cpu_flags_,   \
+                             benchmark_cpu_info_);                        \
+    EXPECT_LE(diff, max_diff);                                            \
+  }
+
+TEST_SCALEMIRROR(Odd, -1283, 17, 937, 13, None, 0)
+TEST_SCALEMIRROR(Odd, -1283, 17, 937, 13, Linear, 3)
+TEST_SCALEMIRROR(Odd, -1283, 17, 937, 13, Bilinear, 3)
+TEST_SCALEMIRROR(Odd, -1283, 17, 937, 13, Box, 3)
+TEST_SCALEMIRROR(Up, -937, 13, 1283, 17, Bilinear, 3)
+#undef TEST_SCALEMIRROR
+
+// Test scaling a plane of full range 16 bit pixels with C vs Opt and return
+// maximum pixel difference.  The 16 bit row functions are exact.
+static int PlaneTestFilter_16(int src_width,
+                              int src_height,
+                              int dst_width,
+                              int dst_height,
+                              FilterMode f,
+                              int benchmark_iterations,
+                              int disable_cpu_flags,
+                              int benchmark_cpu_info) {
+  int i;
+  int64_t src_plane_size = (int64_t)(Abs(src_width)) * src_height;
+  int64_t dst_plane_size = (int64_t)(dst_width)*dst_height;
+
+  align_buffer_page_end(src_y, src_plane_size * 2);
+  align_buffer_page_end(dst_y_c, dst_plane_size * 2);
+  align_buffer_page_end(dst_y_opt, dst_plane_size * 2);
+  if (!src_y || !dst_y_c || !dst_y_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  uint16_t* p_src_y = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* p_dst_y_c = reinterpret_cast<uint16_t*>(dst_y_c);
+  uint16_t* p_dst_y_opt = reinterpret_cast<uint16_t*>(dst_y_opt);
+  MemRandomize(src_y, src_plane_size * 2);
+  memset(dst_y_c, 2, dst_plane_size * 2);
+  memset(dst_y_opt, 3, dst_plane_size * 2);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  ScalePlane_16(p_src_y, Abs(src_width), src_width, src_height, p_dst_y_c,
+                dst_width, dst_width, dst_height, f);
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    ScalePlane_16(p_src_y, Abs(src_width), src_width, src_height, p_dst_y_opt,
+                  dst_width, dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_y_c[i] - p_dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(src_y);
+  return max_diff;
+}
+
+#define TEST_SCALE16_1(name, sw, sh, dw, dh, filter)                          \
+  TEST_F(LibYUVScaleTest, ScalePlane16##name##_##filter) {                    \
+    int diff =                                                                \
+        PlaneTestFilter_16(sw, sh, dw, dh, kFilter##filter,                   \
+                           benchmark_iterations_, disable_cpu_flags_,         \
+                           benchmark_cpu_info_);                              \
+    EXPECT_EQ(0, diff);                                                       \
+  }
+
+#define TEST_SCALE16(name, sw, sh, dw, dh)       \
+  TEST_SCALE16_1(name, sw, sh, dw, dh, None)     \
+  TEST_SCALE16_1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SCALE16_1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCALE16_1(name, sw, sh, dw, dh, Box)
+
+TEST_SCALE16(Odd, 1283, 17, 937, 13)
+TEST_SCALE16(Mirror, -1283, 17, 937, 13)
+TEST_SCALE16(Up, 937, 13, 1283, 17)
+TEST_SCALE16(By2, 1286, 18, 643, 9)
+TEST_SCALE16(By3, 1287, 18, 429, 6)
+// Point sampling has no 64 bit column function, so only the filters are
+// tested at a width of 32768 or more.
+TEST_SCALE16_1(Wide, 40000, 8, 30001, 6, Linear)
+TEST_SCALE16_1(Wide, 40000, 8, 30001, 6, Bilinear)
+TEST_SCALE16_1(Wide, 40000, 8, 30001, 6, Box)
+#undef TEST_SCALE16_1
+#undef TEST_SCALE16
+
+// The polyphase filters use the same fixed point math in C and SIMD, so the
+// optimized result is expected to be exact.
+#define TEST_POLYPHASE1(name, sw, sh, dw, dh, filter)                      \
+  TEST_F(LibYUVScaleTest, I420ScalePolyphase##name##_##filter) {           \
+    EXPECT_EQ(0, I420TestFilter(sw, sh, dw, dh, kFilter##filter,           \
+                                benchmark_iterations_, disable_cpu_flags_, \
+                                benchmark_cpu_info_));                     \
+  }                                                                        \
+  TEST_F(LibYUVScaleTest, I444ScalePolyphase##name##_##filter) {           \
+    EXPECT_EQ(0, I444TestFilter(sw, sh, dw, dh, kFilter##filter, 1,        \
+                                disable_cpu_flags_, benchmark_cpu_info_)); \
+  }                                                                        \
+  TEST_F(LibYUVScaleTest, NV12ScalePolyphase##name##_##filter) {           \
+    EXPECT_EQ(0, NV12TestFilter(sw, sh, dw, dh, kFilter##filter, 1,        \
+                                disable_cpu_flags_, benchmark_cpu_info_)); \
+  }
+
+#define TEST_POLYPHASE(name, sw, sh, dw, dh)     \
+  TEST_POLYPHASE1(name, sw, sh, dw, dh, Bicubic) \
+  TEST_POLYPHASE1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_POLYPHASE(Down2, 1280, 720, 640, 360)
+TEST_POLYPHASE(Down3by4, 1280, 720, 960, 540)
+TEST_POLYPHASE(Down, 1281, 723, 359, 201)
+// Past 8x the tap count is capped, so the kernel narrows.
+TEST_POLYPHASE(Down20, 1280, 720, 64, 36)
+TEST_POLYPHASE(Up, 321, 179, 1279, 721)
+TEST_POLYPHASE(UpHorizontal, 320, 180, 640, 180)
+TEST_POLYPHASE(Tiny, 3, 5, 17, 2)
+TEST_POLYPHASE(Invert, 640, -360, 1280, 720)
+#undef TEST_POLYPHASE1
+#undef TEST_POLYPHASE
+
+// A flat image has to stay flat and a ramp has to stay a ramp, which checks
+// that the filter weights sum to 1 and that the edges are handled.
+TEST_F(LibYUVScaleTest, ScalePolyphaseFlat) {
+  const int kSrcWidth = 77;
+  const int kSrcHeight = 43;
+  const int kDstWidth = 300;
+  const int kDstHeight = 19;
+  align_buffer_page_end(src, kSrcWidth * kSrcHeight);
+  align_buffer_page_end(dst, kDstWidth * kDstHeight);
+  for (int f = kFilterBicubic; f <= kFilterLanczos; ++f) {
+    for (int value = 0; value < 256; value += 51) {
+      memset(src, value, kSrcWidth * kSrcHeight);
+      ScalePlane(src, kSrcWidth, kSrcWidth, kSrcHeight, dst, kDstWidth,
+                 kDstWidth, kDstHeight, static_cast<FilterMode>(f));
+      for (int i = 0; i < kDstWidth * kDstHeight; ++i) {
+        EXPECT_EQ(value, dst[i]);
+      }
+    }
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+TEST_F(LibYUVScaleTest, ScalePolyphaseRamp) {
+  const int kSrcWidth = 64;
+  const int kDstWidth = 256;
+  const int kHeight = 4;
+  align_buffer_page_end(src, kSrcWidth * kHeight);
+  align_buffer_page_end(dst, kDstWidth * kHeight);
+  for (int y = 0; y < kHeight; ++y) {
+    for (int x = 0; x < kSrcWidth; ++x) {
+      src[y * kSrcWidth + x] = x * 4;
+    }
+  }
+  for (int f = kFilterBicubic; f <= kFilterLanczos; ++f) {
+    ScalePlane(src, kSrcWidth, kSrcWidth, kHeight, dst, kDstWidth, kDstWidth,
+               kHeight, static_cast<FilterMode>(f));
+    // Away from the edges the output samples the ramp at (x + 0.5) / 4 - 0.5.
+    for (int y = 0; y < kHeight; ++y) {
+      for (int x = 8; x < kDstWidth - 8; ++x) {
+        EXPECT_NEAR(x - 1.5, dst[y * kDstWidth + x], 1.0);
+      }
+    }
+  }
+  free_aligned_buffer_page_end(dst);
+  free_aligned_buffer_page_end(src);
+}
+
+// Test I422Scale and NV16Scale with C vs Opt and return maximum pixel
+// difference.  The I422 U and V planes are compared as one half width plane
+// each, and the NV16 UV plane as a half width plane of pairs.
+static int I422TestFilter(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          FilterMode f,
+                          int benchmark_iterations,
+                          int disable_cpu_flags,
+                          int benchmark_cpu_info,
+                          bool biplanar) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i, j;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_stride_y = Abs(src_width);
+  int src_stride_uv = biplanar ? src_width_uv * 2 : src_width_uv;
+  int64_t src_y_plane_size = src_stride_y * Abs(src_height);
+  int64_t src_uv_plane_size = src_stride_uv * Abs(src_height);
+
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_stride_y = dst_width;
+  int dst_stride_uv = biplanar ? dst_width_uv * 2 : dst_width_uv;
+  int64_t dst_y_plane_size = dst_stride_y * dst_height;
+  int64_t dst_uv_plane_size = dst_stride_uv * dst_height;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  align_buffer_page_end(dst_y_c, dst_y_plane_size);
+  align_buffer_page_end(dst_u_c, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_c, dst_uv_plane_size);
+  align_buffer_page_end(dst_y_opt, dst_y_plane_size);
+  align_buffer_page_end(dst_u_opt, dst_uv_plane_size);
+  align_buffer_page_end(dst_v_opt, dst_uv_plane_size);
+  if (!src_y || !src_u || !src_v || !dst_y_c || !dst_u_c || !dst_v_c ||
+      !dst_y_opt || !dst_u_opt || !dst_v_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+  memset(dst_v_c, 0, dst_uv_plane_size);
+  memset(dst_v_opt, 0, dst_uv_plane_size);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  double c_time = get_time();
+  if (biplanar) {
+    NV16Scale(src_y, src_stride_y, src_u, src_stride_uv, src_width, src_height,
+              dst_y_c, dst_stride_y, dst_u_c, dst_stride_uv, dst_width,
+              dst_height, f);
+  } else {
+    I422Scale(src_y, src_stride_y, src_u, src_stride_uv, src_v, src_stride_uv,
+              src_width, src_height, dst_y_c, dst_stride_y, dst_u_c,
+              dst_stride_uv, dst_v_c, dst_stride_uv, dst_width, dst_height, f);
+  }
+  c_time = (get_time() - c_time);
+
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  double opt_time = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    if (biplanar) {
+      NV16Scale(src_y, src_stride_y, src_u, src_stride_uv, src_width,
+                src_height, dst_y_opt, dst_stride_y, dst_u_opt, dst_stride_uv,
+                dst_width, dst_height, f);
+    } else {
+      I422Scale(src_y, src_stride_y, src_u, src_stride_uv, src_v,
+                src_stride_uv, src_width, src_height, dst_y_opt, dst_stride_y,
+                dst_u_opt, dst_stride_uv, dst_v_opt, dst_stride_uv, dst_width,
+                dst_height, f);
+    }
+  }
+  opt_time = (get_time() - opt_time) / benchmark_iterations;
+  // Report performance of C vs OPT.
+  printf("filter %d - %8d us C - %8d us OPT\n", f,
+         static_cast<int>(c_time * 1e6), static_cast<int>(opt_time * 1e6));
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(dst_y_c[i] - dst_y_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (i = 0; i < dst_height; ++i) {
+    for (j = 0; j < dst_stride_uv; ++j) {
+      int k = i * dst_stride_uv + j;
+      int abs_diff = Abs(dst_u_c[k] - dst_u_opt[k]);
+      if (abs_diff > max_diff) {
+        max_diff = abs_diff;
+      }
+      abs_diff = Abs(dst_v_c[k] - dst_v_opt[k]);
+      if (abs_diff > max_diff) {
+        max_diff = abs_diff;
+      }
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_y_c);
+  free_aligned_buffer_page_end(dst_u_c);
+  free_aligned_buffer_page_end(dst_v_c);
+  free_aligned_buffer_page_end(dst_y_opt);
+  free_aligned_buffer_page_end(dst_u_opt);
+  free_aligned_buffer_page_end(dst_v_opt);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  return max_diff;
+}
+
+// Scale P010 (subsample_y 2) or P210 (subsample_y 1) directly, and compare to
+// splitting the UV plane and scaling each plane with ScalePlane_16.  The
+// source is a ramp, because the plane scaler has special cases that filter
+// differently.  Returns the maximum difference in 10 bit units.
+static int P010TestFilter(int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          FilterMode f,
+                          int subsample_y,
+                          int benchmark_iterations) {
+  if (!SizeValid(src_width, src_height, dst_width, dst_height)) {
+    return 0;
+  }
+
+  int i;
+  int src_width_uv = (Abs(src_width) + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + subsample_y - 1) / subsample_y;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + subsample_y - 1) / subsample_y;
+  int src_y_plane_size = Abs(src_width) * Abs(src_height);
+  int src_uv_plane_size = src_width_uv * src_height_uv;
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv;
+
+  align_buffer_page_end(src_y, src_y_plane_size * 2);
+  align_buffer_page_end(src_uv, src_uv_plane_size * 4);
+  align_buffer_page_end(src_u, src_uv_plane_size * 2);
+  align_buffer_page_end(src_v, src_uv_plane_size * 2);
+  align_buffer_page_end(dst_y, dst_y_plane_size * 2);
+  align_buffer_page_end(dst_uv, dst_uv_plane_size * 4);
+  align_buffer_page_end(dst_y_ref, dst_y_plane_size * 2);
+  align_buffer_page_end(dst_u_ref, dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_v_ref, dst_uv_plane_size * 2);
+  if (!src_y || !src_uv || !src_u || !src_v || !dst_y || !dst_uv ||
+      !dst_y_ref || !dst_u_ref || !dst_v_ref) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  uint16_t* p_src_y = reinterpret_cast<uint16_t*>(src_y);
+  uint16_t* p_src_uv = reinterpret_cast<uint16_t*>(src_uv);
+  uint16_t* p_src_u = reinterpret_cast<uint16_t*>(src_u);
+  uint16_t* p_src_v = reinterpret_cast<uint16_t*>(src_v);
+  uint16_t* p_dst_y = reinterpret_cast<uint16_t*>(dst_y);
+  uint16_t* p_dst_uv = reinterpret_cast<uint16_t*>(dst_uv);
+  uint16_t* p_dst_y_ref = reinterpret_cast<uint16_t*>(dst_y_ref);
+  uint16_t* p_dst_u_ref = reinterpret_cast<uint16_t*>(dst_u_ref);
+  uint16_t* p_dst_v_ref = reinterpret_cast<uint16_t*>(dst_v_ref);
+  // 10 bit samples in the upper bits.
+  for (i = 0; i < src_y_plane_size; ++i) {
+    int x = i % Abs(src_width);
+    int y = i / Abs(src_width);
+    p_src_y[i] = ((x + y) >> 1) << 6;
+  }
+  for (i = 0; i < src_uv_plane_size; ++i) {
+    int x = i % src_width_uv;
+    int y = i / src_width_uv;
+    p_src_uv[i * 2 + 0] = ((x + y) >> 1) << 6;
+    p_src_uv[i * 2 + 1] = (1023 - ((x * 2 + y) >> 1)) << 6;
+  }
+  SplitUVPlane_16(p_src_uv, src_width_uv * 2, p_src_u, src_width_uv, p_src_v,
+                  src_width_uv, src_width_uv, src_height_uv, 16);
+  int src_height_uv_signed = src_height < 0 ? -src_height_uv : src_height_uv;
+
+  ScalePlane_16(p_src_y, Abs(src_width), src_width, src_height, p_dst_y_ref,
+                dst_width, dst_width, dst_height, f);
+  ScalePlane_16(p_src_u, src_width_uv, src_width_uv, src_height_uv_signed,
+                p_dst_u_ref, dst_width_uv, dst_width_uv, dst_height_uv, f);
+  ScalePlane_16(p_src_v, src_width_uv, src_width_uv, src_height_uv_signed,
+                p_dst_v_ref, dst_width_uv, dst_width_uv, dst_height_uv, f);
+
+  double time0 = get_time();
+  for (i = 0; i < benchmark_iterations; ++i) {
+    if (subsample_y == 2) {
+      P010Scale(p_src_y, Abs(src_width), p_src_uv, src_width_uv * 2,
+                src_width, src_height, p_dst_y, dst_width, p_dst_uv,
+                dst_width_uv * 2, dst_width, dst_height, f);
+    } else {
+      P210Scale(p_src_y, Abs(src_width), p_src_uv, src_width_uv * 2,
+                src_width, src_height, p_dst_y, dst_width, p_dst_uv,
+                dst_width_uv * 2, dst_width, dst_height, f);
+    }
+  }
+  time0 = (get_time() - time0) / benchmark_iterations;
+  printf("filter %d - %8d us P%d10Scale\n", f, static_cast<int>(time0 * 1e6),
+         subsample_y == 2 ? 0 : 2);
+
+  int max_diff = 0;
+  for (i = 0; i < dst_y_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_y[i] - p_dst_y_ref[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_uv[i * 2 + 0] - p_dst_u_ref[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(p_dst_uv[i * 2 + 1] - p_dst_v_ref[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(dst_y);
+  free_aligned_buffer_page_end(dst_uv);
+  free_aligned_buffer_page_end(dst_y_ref);
+  free_aligned_buffer_page_end(dst_u_ref);
+  free_aligned_buffer_page_end(dst_v_ref);
+  return max_diff >> 6;
+}
+
+#define TEST_SCALE422_1(name, sw, sh, dw, dh, filter, max_diff)               \
+  TEST_F(LibYUVScaleTest, I422Scale##name##_##filter) {                       \
+    EXPECT_LE(I422TestFilter(sw, sh, dw, dh, kFilter##filter,                 \
+                             benchmark_iterations_, disable_cpu_flags_,       \
+                             benchmark_cpu_info_, false),                     \
+              max_diff);                                                      \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, NV16Scale##name##_##filter) {                       \
+    EXPECT_LE(I422TestFilter(sw, sh, dw, dh, kFilter##filter,                 \
+                             benchmark_iterations_, disable_cpu_flags_,       \
+                             benchmark_cpu_info_, true),                      \
+              max_diff);                                                      \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, P010Scale##name##_##filter) {                       \
+    EXPECT_LE(P010TestFilter(sw, sh, dw, dh, kFilter##filter, 2,              \
+                             benchmark_iterations_),                          \
+              max_diff / 3);                                                  \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, P210Scale##name##_##filter) {                       \
+    EXPECT_LE(P010TestFilter(sw, sh, dw, dh, kFilter##filter, 1,              \
+                             benchmark_iterations_),                          \
+              max_diff / 3);                                                  \
+  }
+
+#define TEST_SCALE422(name, sw, sh, dw, dh)        \
+  TEST_SCALE422_1(name, sw, sh, dw, dh, None, 0)   \
+  TEST_SCALE422_1(name, sw, sh, dw, dh, Linear, 3) \
+  TEST_SCALE422_1(name, sw, sh, dw, dh, Bilinear, 3)
+
+TEST_SCALE422(Down, 1281, 723, 359, 201)
+TEST_SCALE422(Down3by4, 1280, 720, 960, 540)
+TEST_SCALE422(Up, 321, 179, 1279, 721)
+TEST_SCALE422(Invert, 640, -362, 1280, 720)
+#undef TEST_SCALE422_1
+#undef TEST_SCALE422
+
 #ifdef ENABLE_ROW_TESTS
 #ifdef HAS_SCALEROWDOWN2_SSSE3
 TEST_F(LibYUVScaleTest, TestScaleRowDown2Box_Odd_SSSE3) {
@@ -1384,6 +1924,583 @@ TEST_FACTOR(3, 1, 3, 0)
 #undef SX
 #undef DX
 
+// Test threaded scaling against single threaded and return number of
+// mismatched pixels. 0 = exact.
+static int I420TestThreaded(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f,
+                            int num_jobs,
+                            int benchmark_iterations) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int src_y_plane_size = src_width * Abs(src_height);
+  int src_uv_plane_size = src_width_uv * src_height_uv;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int dst_y_plane_size = dst_width * dst_height;
+  int dst_uv_plane_size = dst_width_uv * dst_height_uv;
+  int num_calls = 0;
+
+  align_buffer_page_end(src_y, src_y_plane_size);
+  align_buffer_page_end(src_u, src_uv_plane_size);
+  align_buffer_page_end(src_v, src_uv_plane_size);
+  align_buffer_page_end(dst_c, dst_y_plane_size + dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_opt, dst_y_plane_size + dst_uv_plane_size * 2);
+  MemRandomize(src_y, src_y_plane_size);
+  MemRandomize(src_u, src_uv_plane_size);
+  MemRandomize(src_v, src_uv_plane_size);
+  memset(dst_c, 1, dst_y_plane_size + dst_uv_plane_size * 2);
+  memset(dst_opt, 2, dst_y_plane_size + dst_uv_plane_size * 2);
+
+  I420Scale(src_y, src_width, src_u, src_width_uv, src_v, src_width_uv,
+            src_width, src_height, dst_c, dst_width, dst_c + dst_y_plane_size,
+            dst_width_uv, dst_c + dst_y_plane_size + dst_uv_plane_size,
+            dst_width_uv, dst_width, dst_height, f);
+  for (int i = 0; i < benchmark_iterations; ++i) {
+    I420ScaleThreaded(src_y, src_width, src_u, src_width_uv, src_v,
+                      src_width_uv, src_width, src_height, dst_opt, dst_width,
+                      dst_opt + dst_y_plane_size, dst_width_uv,
+                      dst_opt + dst_y_plane_size + dst_uv_plane_size,
+                      dst_width_uv, dst_width, dst_height, f, num_jobs,
+                      TestDispatch, &num_calls);
+  }
+  EXPECT_EQ(benchmark_iterations, num_calls);
+
+  int num_diff = 0;
+  for (int i = 0; i < dst_y_plane_size + dst_uv_plane_size * 2; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_v);
+  return num_diff;
+}
+
+#define TEST_THREADED1(name, sw, sh, dw, dh, filter)                    \
+  TEST_F(LibYUVScaleTest, I420ScaleThreaded##name##_##filter) {         \
+    EXPECT_EQ(0, I420TestThreaded(sw, sh, dw, dh, kFilter##filter, 7,   \
+                                  benchmark_iterations_));              \
+    EXPECT_EQ(0, I420TestThreaded(sw, -(sh), dw, dh, kFilter##filter, 3, \
+                                  1));                                  \
+  }
+
+#define TEST_THREADED(name, sw, sh, dw, dh)        \
+  TEST_THREADED1(name, sw, sh, dw, dh, None)     \
+  TEST_THREADED1(name, sw, sh, dw, dh, Linear)   \
+  TEST_THREADED1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_THREADED1(name, sw, sh, dw, dh, Box)      \
+  TEST_THREADED1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_THREADED1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_THREADED(Down2, 1280, 720, 640, 360)
+TEST_THREADED(Down4, 1280, 720, 320, 180)
+TEST_THREADED(Down3by4, 1280, 720, 960, 540)
+TEST_THREADED(Down3by8, 1280, 720, 480, 270)
+TEST_THREADED(Down, 1281, 723, 359, 201)
+TEST_THREADED(DownVertical, 640, 722, 640, 97)
+TEST_THREADED(Up2, 321, 179, 642, 358)
+TEST_THREADED(Up, 321, 179, 1279, 721)
+TEST_THREADED(UpVertical, 320, 90, 320, 541)
+
+// Scale with a caller supplied scratch and compare to ScalePlane.
+static int PlaneTestScratch(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f) {
+  int src_plane_size = src_width * src_height;
+  int dst_plane_size = dst_width * dst_height;
+  int scratch_size =
+      ScalePlaneScratchSize(src_width, src_height, dst_width, dst_height, f);
+  EXPECT_LE(0, scratch_size);
+  align_buffer_page_end(src, src_plane_size);
+  align_buffer_page_end(dst_c, dst_plane_size);
+  align_buffer_page_end(dst_opt, dst_plane_size);
+  align_buffer_page_end(scratch_mem, scratch_size + 1);
+  MemRandomize(src, src_plane_size);
+  memset(dst_c, 1, dst_plane_size);
+  memset(dst_opt, 2, dst_plane_size);
+  LibyuvScratch scratch = {scratch_mem, (size_t)scratch_size};
+
+  ScalePlane(src, src_width, src_width, src_height, dst_c, dst_width,
+             dst_width, dst_height, f);
+  ScalePlane_WithScratch(src, src_width, src_width, src_height, dst_opt,
+                         dst_width, dst_width, dst_height, f, &scratch);
+
+  int num_diff = 0;
+  for (int i = 0; i < dst_plane_size; ++i) {
+    if (dst_c[i] != dst_opt[i]) {
+      ++num_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(scratch_mem);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src);
+  return num_diff;
+}
+
+#define TEST_SCRATCH1(name, sw, sh, dw, dh, filter)                     \
+  TEST_F(LibYUVScaleTest, PlaneScratch##name##_##filter) {              \
+    EXPECT_EQ(0, PlaneTestScratch(sw, sh, dw, dh, kFilter##filter));    \
+  }
+
+#define TEST_SCRATCH(name, sw, sh, dw, dh)        \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, None)     \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Box)      \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_SCRATCH1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_SCRATCH(Down, 1281, 723, 359, 201)
+TEST_SCRATCH(Down3by4, 1280, 720, 960, 540)
+TEST_SCRATCH(Up, 321, 179, 1279, 721)
+
+static int CountDiff(const uint8_t* a, const uint8_t* b, int size) {
+  int num_diff = 0;
+  for (int i = 0; i < size; ++i) {
+    if (a[i] != b[i]) {
+      ++num_diff;
+    }
+  }
+  return num_diff;
+}
+
+// Scale NV12, I444, I422 and 16 bit I420 images with a caller supplied
+// scratch sized as scale.h describes, and compare to the allocating scalers.
+static int ImageTestScratch(int src_width,
+                            int src_height,
+                            int dst_width,
+                            int dst_height,
+                            FilterMode f) {
+  const int src_halfwidth = (src_width + 1) / 2;
+  const int dst_halfwidth = (dst_width + 1) / 2;
+  // Room for 3 full size 16 bit planes.
+  const int src_size = src_width * src_height * 2 * 3;
+  const int dst_size = dst_width * dst_height * 2 * 3;
+  const int dst_plane_size = dst_width * dst_height;
+  int scratch_size =
+      NV12ScaleScratchSize(src_width, src_height, dst_width, dst_height, f);
+  int size = ScalePlaneScratchSize(src_halfwidth, src_height, dst_halfwidth,
+                                   dst_height, f);
+  if (size > scratch_size) {
+    scratch_size = size;
+  }
+  size = ScalePlaneScratchSize_16(src_width, src_height, dst_width,
+                                  dst_height, f);
+  if (size > scratch_size) {
+    scratch_size = size;
+  }
+  EXPECT_LE(0, scratch_size);
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_opt, dst_size);
+  align_buffer_page_end(scratch_mem, scratch_size + 1);
+  MemRandomize(src, src_size);
+  LibyuvScratch scratch = {scratch_mem, (size_t)scratch_size};
+  const uint8_t* src_u = src + src_width * src_height;
+  const uint8_t* src_v = src_u + src_width * src_height;
+  int num_diff = 0;
+
+  // The images do not fill the buffers, so the rest of both must start out
+  // the same.
+  memset(dst_c, 1, dst_size);
+  memset(dst_opt, 1, dst_size);
+  NV12Scale(src, src_width, src_u, src_halfwidth * 2, src_width, src_height,
+            dst_c, dst_width, dst_c + dst_plane_size, dst_halfwidth * 2,
+            dst_width, dst_height, f);
+  NV12Scale_WithScratch(src, src_width, src_u, src_halfwidth * 2, src_width,
+                        src_height, dst_opt, dst_width,
+                        dst_opt + dst_plane_size, dst_halfwidth * 2, dst_width,
+                        dst_height, f, &scratch);
+  num_diff += CountDiff(dst_c, dst_opt, dst_size);
+
+  I444Scale(src, src_width, src_u, src_width, src_v, src_width, src_width,
+            src_height, dst_c, dst_width, dst_c + dst_plane_size, dst_width,
+            dst_c + dst_plane_size * 2, dst_width, dst_width, dst_height, f);
+  I444Scale_WithScratch(src, src_width, src_u, src_width, src_v, src_width,
+                        src_width, src_height, dst_opt, dst_width,
+                        dst_opt + dst_plane_size, dst_width,
+                        dst_opt + dst_plane_size * 2, dst_width, dst_width,
+                        dst_height, f, &scratch);
+  num_diff += CountDiff(dst_c, dst_opt, dst_size);
+
+  I422Scale(src, src_width, src_u, src_halfwidth, src_v, src_halfwidth,
+            src_width, src_height, dst_c, dst_width, dst_c + dst_plane_size,
+            dst_halfwidth, dst_c + dst_plane_size * 2, dst_halfwidth,
+            dst_width, dst_height, f);
+  I422Scale_WithScratch(src, src_width, src_u, src_halfwidth, src_v,
+                        src_halfwidth, src_width, src_height, dst_opt,
+                        dst_width, dst_opt + dst_plane_size, dst_halfwidth,
+                        dst_opt + dst_plane_size * 2, dst_halfwidth, dst_width,
+                        dst_height, f, &scratch);
+  num_diff += CountDiff(dst_c, dst_opt, dst_size);
+
+  // 10 bit samples for the 16 bit scalers.
+  uint16_t* src16 = reinterpret_cast<uint16_t*>(src);
+  for (int i = 0; i < src_size / 2; ++i) {
+    src16[i] &= 1023;
+  }
+  uint16_t* dst16_c = reinterpret_cast<uint16_t*>(dst_c);
+  uint16_t* dst16_opt = reinterpret_cast<uint16_t*>(dst_opt);
+  I420Scale_16(src16, src_width, src16 + src_width * src_height,
+               src_halfwidth, src16 + src_width * src_height * 2,
+               src_halfwidth, src_width, src_height, dst16_c, dst_width,
+               dst16_c + dst_plane_size, dst_halfwidth,
+               dst16_c + dst_plane_size * 2, dst_halfwidth, dst_width,
+               dst_height, f);
+  I420Scale_16_WithScratch(src16, src_width, src16 + src_width * src_height,
+                           src_halfwidth, src16 + src_width * src_height * 2,
+                           src_halfwidth, src_width, src_height, dst16_opt,
+                           dst_width, dst16_opt + dst_plane_size,
+                           dst_halfwidth, dst16_opt + dst_plane_size * 2,
+                           dst_halfwidth, dst_width, dst_height, f, &scratch);
+  num_diff += CountDiff(dst_c, dst_opt, dst_size);
+
+  free_aligned_buffer_page_end(scratch_mem);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src);
+  return num_diff;
+}
+
+#undef TEST_SCRATCH1
+#define TEST_SCRATCH1(name, sw, sh, dw, dh, filter)                     \
+  TEST_F(LibYUVScaleTest, ImageScratch##name##_##filter) {              \
+    EXPECT_EQ(0, ImageTestScratch(sw, sh, dw, dh, kFilter##filter));    \
+  }
+
+TEST_SCRATCH(Down, 1281, 723, 359, 201)
+TEST_SCRATCH(Up, 321, 179, 1279, 721)
+
+// Scale 2 frames with a ScalePlan and compare to the unplanned functions.
+static int ScalePlanTest(ScalePlanFormat format,
+                         int src_width,
+                         int src_height,
+                         int dst_width,
+                         int dst_height,
+                         FilterMode f) {
+  const int bpp = format == kScalePlanARGB ? 4 : format == kScalePlanUV ? 2 : 1;
+  // A negative src_width mirrors the single plane and ARGB formats.
+  int src_abs_width = Abs(src_width);
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (Abs(src_height) + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_y_size = src_abs_width * Abs(src_height) * bpp;
+  int src_uv_size = src_width_uv * src_height_uv * 2;
+  int dst_y_size = dst_width * dst_height * bpp;
+  int dst_uv_size = dst_width_uv * dst_height_uv * 2;
+  int compare_size = dst_y_size;
+  if (format == kScalePlanI420 || format == kScalePlanNV12) {
+    compare_size += dst_uv_size;
+  }
+  int num_diff = 0;
+
+  ScalePlan* plan = ScalePlanCreate(src_width, src_height, dst_width,
+                                    dst_height, f, format);
+  EXPECT_TRUE(plan != NULL);
+  if (!plan) {
+    return 1;
+  }
+  align_buffer_page_end(src_y, src_y_size);
+  align_buffer_page_end(src_uv, src_uv_size);
+  align_buffer_page_end(dst_c, dst_y_size + dst_uv_size);
+  align_buffer_page_end(dst_opt, dst_y_size + dst_uv_size);
+  uint8_t* dst_c_u = dst_c + dst_y_size;
+  uint8_t* dst_c_v = dst_c_u + dst_uv_size / 2;
+  uint8_t* dst_opt_u = dst_opt + dst_y_size;
+  uint8_t* dst_opt_v = dst_opt_u + dst_uv_size / 2;
+  const uint8_t* src_v = src_uv + src_uv_size / 2;
+
+  for (int frame = 0; frame < 2; ++frame) {
+    MemRandomize(src_y, src_y_size);
+    MemRandomize(src_uv, src_uv_size);
+    memset(dst_c, 1, dst_y_size + dst_uv_size);
+    memset(dst_opt, 2, dst_y_size + dst_uv_size);
+    switch (format) {
+      case kScalePlanPlane:
+        ScalePlane(src_y, src_abs_width, src_width, src_height, dst_c, dst_width,
+                   dst_width, dst_height, f);
+        break;
+      case kScalePlanI420:
+        I420Scale(src_y, src_width, src_uv, src_width_uv, src_v, src_width_uv,
+                  src_width, src_height, dst_c, dst_width, dst_c_u,
+                  dst_width_uv, dst_c_v, dst_width_uv, dst_width, dst_height,
+                  f);
+        break;
+      case kScalePlanNV12:
+        NV12Scale(src_y, src_width, src_uv, src_width_uv * 2, src_width,
+                  src_height, dst_c, dst_width, dst_c_u, dst_width_uv * 2,
+                  dst_width, dst_height, f);
+        break;
+      case kScalePlanARGB:
+        ARGBScale(src_y, src_abs_width * 4, src_width, src_height, dst_c,
+                  dst_width * 4, dst_width, dst_height, f);
+        break;
+      case kScalePlanUV:
+        UVScale(src_y, src_width * 2, src_width, src_height, dst_c,
+                dst_width * 2, dst_width, dst_height, f);
+        break;
+    }
+    if (format == kScalePlanI420) {
+      EXPECT_EQ(0, ScalePlanExecute(plan, src_y, src_width, src_uv,
+                                    src_width_uv, src_v, src_width_uv, dst_opt,
+                                    dst_width, dst_opt_u, dst_width_uv,
+                                    dst_opt_v, dst_width_uv));
+    } else {
+      EXPECT_EQ(0, ScalePlanExecute(plan, src_y, src_abs_width * bpp, src_uv,
+                                    src_width_uv * 2, NULL, 0, dst_opt,
+                                    dst_width * bpp, dst_opt_u,
+                                    dst_width_uv * 2, NULL, 0));
+    }
+    for (int i = 0; i < compare_size; ++i) {
+      if (dst_c[i] != dst_opt[i]) {
+        ++num_diff;
+      }
+    }
+  }
+
+  ScalePlanFree(plan);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_opt);
+  free_aligned_buffer_page_end(src_y);
+  free_aligned_buffer_page_end(src_uv);
+  return num_diff;
+}
+
+#define TEST_SCALEPLAN1(name, sw, sh, dw, dh, filter)                         \
+  TEST_F(LibYUVScaleTest, ScalePlan##name##_##filter) {                       \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanPlane, sw, sh, dw, dh,               \
+                               kFilter##filter));                             \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanI420, sw, -(sh), dw, dh,             \
+                               kFilter##filter));                             \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanNV12, sw, sh, dw, dh,                \
+                               kFilter##filter));                             \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanARGB, sw, sh, dw, dh,                \
+                               kFilter##filter));                             \
+    EXPECT_EQ(0,                                                              \
+              ScalePlanTest(kScalePlanUV, sw, sh, dw, dh, kFilter##filter));  \
+  }
+
+#define TEST_SCALEPLAN(name, sw, sh, dw, dh)        \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, None)     \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, Box)      \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_SCALEPLAN1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_SCALEPLAN(Down, 1281, 723, 359, 201)
+TEST_SCALEPLAN(Down4, 1280, 720, 320, 180)
+TEST_SCALEPLAN(Up, 321, 179, 1279, 721)
+
+// A negative src_width mirrors single planes and ARGB, as ScalePlane and
+// ARGBScale do.
+#define TEST_SCALEPLANMIRROR(name, sw, sh, dw, dh, filter)                   \
+  TEST_F(LibYUVScaleTest, ScalePlanMirror##name##_##filter) {                \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanPlane, -(sw), sh, dw, dh,           \
+                               kFilter##filter));                            \
+    EXPECT_EQ(0, ScalePlanTest(kScalePlanARGB, -(sw), sh, dw, dh,            \
+                               kFilter##filter));                            \
+  }
+
+TEST_SCALEPLANMIRROR(Down, 1281, 723, 359, 201, Bilinear)
+TEST_SCALEPLANMIRROR(Down, 1281, 723, 359, 201, Lanczos)
+TEST_SCALEPLANMIRROR(Up, 321, 179, 1279, 721, Box)
+
+TEST_F(LibYUVScaleTest, ScalePlanInvalid) {
+  EXPECT_TRUE(ScalePlanCreate(0, 720, 640, 360, kFilterBox, kScalePlanI420) ==
+              NULL);
+  EXPECT_TRUE(ScalePlanCreate(1280, 720, 640, 0, kFilterBox, kScalePlanI420) ==
+              NULL);
+  // The multi plane and UV scalers do not mirror.
+  EXPECT_TRUE(ScalePlanCreate(-1280, 720, 640, 360, kFilterBox,
+                              kScalePlanI420) == NULL);
+  EXPECT_TRUE(ScalePlanCreate(-1280, 720, 640, 360, kFilterBox,
+                              kScalePlanNV12) == NULL);
+  EXPECT_TRUE(ScalePlanCreate(-1280, 720, 640, 360, kFilterBox,
+                              kScalePlanUV) == NULL);
+  EXPECT_EQ(-1, ScalePlanExecute(NULL, NULL, 0, NULL, 0, NULL, 0, NULL, 0,
+                                 NULL, 0, NULL, 0));
+}
+
+// Scale 2 frames a slice at a time, each slice in a buffer of its own.  After
+// each slice the finished rows must match I420Scale or NV12Scale of the whole
+// frame.
+static int SliceScaleTest(bool nv12,
+                          int src_width,
+                          int src_height,
+                          int dst_width,
+                          int dst_height,
+                          FilterMode f,
+                          int slice_rows) {
+  int src_width_uv = (src_width + 1) >> 1;
+  int src_height_uv = (src_height + 1) >> 1;
+  int dst_width_uv = (dst_width + 1) >> 1;
+  int dst_height_uv = (dst_height + 1) >> 1;
+  int src_uv_size = src_width_uv * src_height_uv;
+  int dst_uv_size = dst_width_uv * dst_height_uv;
+  int src_size = src_width * src_height + src_uv_size * 2;
+  int dst_size = dst_width * dst_height + dst_uv_size * 2;
+  int num_diff = 0;
+
+  SliceContext* slice =
+      nv12 ? NV12ScaleSliceCreate(src_width, src_height, dst_width, dst_height,
+                                  f, slice_rows)
+           : I420ScaleSliceCreate(src_width, src_height, dst_width, dst_height,
+                                  f, slice_rows);
+  EXPECT_TRUE(slice != NULL);
+  if (!slice) {
+    return 1;
+  }
+  align_buffer_page_end(src, src_size);
+  align_buffer_page_end(src_uv, src_uv_size * 2);
+  align_buffer_page_end(band, src_width * slice_rows * 2);
+  align_buffer_page_end(dst_c, dst_size);
+  align_buffer_page_end(dst_c_uv, dst_uv_size * 2);
+  align_buffer_page_end(dst_opt, dst_size);
+  uint8_t* src_u = src + src_width * src_height;
+  uint8_t* src_v = src_u + src_uv_size;
+  uint8_t* dst_c_u = dst_c + dst_width * dst_height;
+  uint8_t* dst_c_v = dst_c_u + dst_uv_size;
+  uint8_t* dst_opt_u = dst_opt + dst_width * dst_height;
+  uint8_t* dst_opt_v = dst_opt_u + dst_uv_size;
+
+  for (int frame = 0; frame < 2; ++frame) {
+    MemRandomize(src, src_size);
+    memset(dst_opt, 0, dst_size);
+    if (nv12) {
+      MergeUVPlane(src_u, src_width_uv, src_v, src_width_uv, src_uv,
+                   src_width_uv * 2, src_width_uv, src_height_uv);
+      NV12Scale(src, src_width, src_uv, src_width_uv * 2, src_width,
+                src_height, dst_c, dst_width, dst_c_uv, dst_width_uv * 2,
+                dst_width, dst_height, f);
+    } else {
+      I420Scale(src, src_width, src_u, src_width_uv, src_v, src_width_uv,
+                src_width, src_height, dst_c, dst_width, dst_c_u, dst_width_uv,
+                dst_c_v, dst_width_uv, dst_width, dst_height, f);
+    }
+    int done = 0;
+    for (int y = 0; y < src_height; y += slice_rows) {
+      int rows = src_height - y < slice_rows ? src_height - y : slice_rows;
+      int uv_rows = (rows + 1) >> 1;
+      uint8_t* band_u = band + src_width * rows;
+      uint8_t* band_v = band_u + src_width_uv * uv_rows;
+      int ret;
+      memcpy(band, src + y * src_width, src_width * rows);
+      if (nv12) {
+        memcpy(band_u, src_uv + (y >> 1) * src_width_uv * 2,
+               src_width_uv * 2 * uv_rows);
+        ret = NV12ScaleSlice(slice, band, src_width, band_u, src_width_uv * 2,
+                             rows, dst_opt, dst_width, dst_opt_u,
+                             dst_width_uv * 2);
+      } else {
+        memcpy(band_u, src_u + (y >> 1) * src_width_uv, src_width_uv * uv_rows);
+        memcpy(band_v, src_v + (y >> 1) * src_width_uv, src_width_uv * uv_rows);
+        ret = I420ScaleSlice(slice, band, src_width, band_u, src_width_uv,
+                             band_v, src_width_uv, rows, dst_opt, dst_width,
+                             dst_opt_u, dst_width_uv, dst_opt_v, dst_width_uv);
+      }
+      EXPECT_LE(done, ret);
+      done = ret;
+      // The finished rows, and their chroma, are final.
+      int uv_done = (done + 1) >> 1;
+      for (int i = 0; i < dst_width * done; ++i) {
+        num_diff += dst_c[i] != dst_opt[i];
+      }
+      if (nv12) {
+        for (int i = 0; i < dst_width_uv * 2 * uv_done; ++i) {
+          num_diff += dst_c_uv[i] != dst_opt_u[i];
+        }
+      } else {
+        for (int i = 0; i < dst_width_uv * uv_done; ++i) {
+          num_diff += dst_c_u[i] != dst_opt_u[i];
+          num_diff += dst_c_v[i] != dst_opt_v[i];
+        }
+      }
+    }
+    EXPECT_EQ(dst_height, done);
+  }
+
+  SliceFree(slice);
+  free_aligned_buffer_page_end(src);
+  free_aligned_buffer_page_end(src_uv);
+  free_aligned_buffer_page_end(band);
+  free_aligned_buffer_page_end(dst_c);
+  free_aligned_buffer_page_end(dst_c_uv);
+  free_aligned_buffer_page_end(dst_opt);
+  return num_diff;
+}
+
+#define TEST_SLICE1(name, sw, sh, dw, dh, filter)                      \
+  TEST_F(LibYUVScaleTest, I420ScaleSlice##name##_##filter) {           \
+    EXPECT_EQ(0, SliceScaleTest(false, sw, sh, dw, dh, kFilter##filter, \
+                                16));                                  \
+  }                                                                    \
+  TEST_F(LibYUVScaleTest, NV12ScaleSlice##name##_##filter) {           \
+    EXPECT_EQ(0, SliceScaleTest(true, sw, sh, dw, dh, kFilter##filter,  \
+                                32));                                  \
+  }
+
+#define TEST_SLICE(name, sw, sh, dw, dh)        \
+  TEST_SLICE1(name, sw, sh, dw, dh, None)     \
+  TEST_SLICE1(name, sw, sh, dw, dh, Linear)   \
+  TEST_SLICE1(name, sw, sh, dw, dh, Bilinear) \
+  TEST_SLICE1(name, sw, sh, dw, dh, Box)      \
+  TEST_SLICE1(name, sw, sh, dw, dh, Bicubic)  \
+  TEST_SLICE1(name, sw, sh, dw, dh, Lanczos)
+
+TEST_SLICE(Down, 1281, 723, 359, 201)
+TEST_SLICE(Down2, 1280, 720, 640, 360)
+TEST_SLICE(Down4, 1280, 720, 320, 180)
+TEST_SLICE(Down3by4, 1280, 720, 960, 540)
+TEST_SLICE(DownOdd, 640, 360, 427, 241)
+TEST_SLICE(Up, 321, 179, 1279, 721)
+TEST_SLICE(Up2, 640, 360, 1280, 720)
+
+TEST_F(LibYUVScaleTest, ScaleSliceInvalid) {
+  uint8_t src[64 * 8];
+  uint8_t dst[32 * 4];
+  EXPECT_TRUE(I420ScaleSliceCreate(0, 720, 640, 360, kFilterBox, 16) == NULL);
+  EXPECT_TRUE(I420ScaleSliceCreate(1280, 720, 640, 360, kFilterBox, 0) ==
+              NULL);
+  SliceContext* slice = I420ScaleSliceCreate(64, 8, 32, 4, kFilterBox, 4);
+  ASSERT_TRUE(slice != NULL);
+  // Only the last slice of a frame may have an odd number of rows, and no
+  // slice may be larger than max_slice_rows.
+  EXPECT_EQ(-1, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 3, dst, 32,
+                               dst, 16, dst, 16));
+  EXPECT_EQ(-1, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 6, dst, 32,
+                               dst, 16, dst, 16));
+  // Wrong kind of slice.
+  EXPECT_EQ(-1, NV12ScaleSlice(slice, src, 64, src, 64, 4, dst, 32, dst, 32));
+  // The box filter reads past the first slice, so only the second slice
+  // finishes rows.
+  EXPECT_EQ(0, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 4, dst, 32,
+                              dst, 16, dst, 16));
+  SliceReset(slice);
+  EXPECT_EQ(0, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 4, dst, 32,
+                              dst, 16, dst, 16));
+  EXPECT_EQ(4, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 4, dst, 32,
+                              dst, 16, dst, 16));
+  // The frame is done, so the next slice starts a new one.
+  EXPECT_EQ(0, I420ScaleSlice(slice, src, 64, src, 32, src, 32, 4, dst, 32,
+                              dst, 16, dst, 16));
+  SliceFree(slice);
+}
+#undef TEST_THREADED
+#undef TEST_THREADED1
+
 TEST_F(LibYUVScaleTest, PlaneTest3x) {
   const int kSrcStride = 48;
   const int kDstStride = 16;
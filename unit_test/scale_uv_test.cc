@@ -13,6 +13,8 @@
 
 #include "../unit_test/unit_test.h"
 #include "libyuv/cpu_id.h"
+#include "libyuv/planar_functions.h"
+#include "libyuv/scale.h"
 #include "libyuv/scale_uv.h"
 
 namespace libyuv {
@@ -163,7 +165,8 @@ TEST_FACTOR(3, 1, 3)
 #define TEST_SCALETO(name, width, height)       \
   TEST_SCALETO1(name, width, height, None, 0)   \
   TEST_SCALETO1(name, width, height, Linear, 3) \
-  TEST_SCALETO1(name, width, height, Bilinear, 3)
+  TEST_SCALETO1(name, width, height, Bilinear, 3) \
+  TEST_SCALETO1(name, width, height, Box, 3)
 
 TEST_SCALETO(UVScale, 1, 1)
 TEST_SCALETO(UVScale, 256, 144) /* 128x72 * 2 */
@@ -192,6 +195,145 @@ TEST_SCALESWAPXY1(UVScale, Linear, 0)
 TEST_SCALESWAPXY1(UVScale, Bilinear, 0)
 #undef TEST_SCALESWAPXY1
 
+// The polyphase filters are exact between C and SIMD.
+#define TEST_POLYPHASE(name, sw, sh, dw, dh)                             \
+  TEST_F(LibYUVScaleTest, UVScalePolyphase##name##_Bicubic) {            \
+    EXPECT_EQ(0, UVTestFilter(sw, sh, dw, dh, kFilterBicubic,            \
+                              benchmark_iterations_, disable_cpu_flags_, \
+                              benchmark_cpu_info_));                     \
+  }                                                                      \
+  TEST_F(LibYUVScaleTest, UVScalePolyphase##name##_Lanczos) {            \
+    EXPECT_EQ(0, UVTestFilter(sw, sh, dw, dh, kFilterLanczos,            \
+                              benchmark_iterations_, disable_cpu_flags_, \
+                              benchmark_cpu_info_));                     \
+  }
+
+TEST_POLYPHASE(Down, 1281, 723, 359, 201)
+TEST_POLYPHASE(Up, 321, 179, 1279, 721)
+TEST_POLYPHASE(Tiny, 3, 5, 17, 2)
+#undef TEST_POLYPHASE
+
+// Test scaling 16 bit UV with C vs Opt and return maximum pixel difference.
+static int UVTestFilter_16(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height,
+                           FilterMode f,
+                           int benchmark_iterations,
+                           int disable_cpu_flags,
+                           int benchmark_cpu_info) {
+  int i;
+  int64_t src_uv_plane_size = (int64_t)(src_width)*src_height * 2;
+  int64_t dst_uv_plane_size = (int64_t)(dst_width)*dst_height * 2;
+
+  align_buffer_page_end(src_uv, src_uv_plane_size * 2);
+  align_buffer_page_end(dst_uv_c, dst_uv_plane_size * 2);
+  align_buffer_page_end(dst_uv_opt, dst_uv_plane_size * 2);
+  if (!src_uv || !dst_uv_c || !dst_uv_opt) {
+    printf("Skipped.  Alloc failed " FILELINESTR(__FILE__, __LINE__) "\n");
+    return 0;
+  }
+  uint16_t* p_src_uv = reinterpret_cast<uint16_t*>(src_uv);
+  uint16_t* p_dst_uv_c = reinterpret_cast<uint16_t*>(dst_uv_c);
+  uint16_t* p_dst_uv_opt = reinterpret_cast<uint16_t*>(dst_uv_opt);
+  MemRandomize(src_uv, src_uv_plane_size * 2);
+  memset(dst_uv_c, 2, dst_uv_plane_size * 2);
+  memset(dst_uv_opt, 3, dst_uv_plane_size * 2);
+
+  MaskCpuFlags(disable_cpu_flags);  // Disable all CPU optimization.
+  UVScale_16(p_src_uv, src_width * 2, src_width, src_height, p_dst_uv_c,
+             dst_width * 2, dst_width, dst_height, f);
+  MaskCpuFlags(benchmark_cpu_info);  // Enable all CPU optimization.
+  for (i = 0; i < benchmark_iterations; ++i) {
+    UVScale_16(p_src_uv, src_width * 2, src_width, src_height, p_dst_uv_opt,
+               dst_width * 2, dst_width, dst_height, f);
+  }
+
+  int max_diff = 0;
+  for (i = 0; i < dst_uv_plane_size; ++i) {
+    int abs_diff = Abs(p_dst_uv_c[i] - p_dst_uv_opt[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_uv_c);
+  free_aligned_buffer_page_end(dst_uv_opt);
+  free_aligned_buffer_page_end(src_uv);
+  return max_diff;
+}
+
+#define TEST_SCALE16(name, sw, sh, dw, dh)                                    \
+  TEST_F(LibYUVScaleTest, UVScale16##name##_Linear) {                         \
+    EXPECT_EQ(0, UVTestFilter_16(sw, sh, dw, dh, kFilterLinear,               \
+                                 benchmark_iterations_, disable_cpu_flags_,   \
+                                 benchmark_cpu_info_));                       \
+  }                                                                           \
+  TEST_F(LibYUVScaleTest, UVScale16##name##_Bilinear) {                       \
+    EXPECT_EQ(0, UVTestFilter_16(sw, sh, dw, dh, kFilterBilinear,             \
+                                 benchmark_iterations_, disable_cpu_flags_,   \
+                                 benchmark_cpu_info_));                       \
+  }
+
+TEST_SCALE16(Down, 1283, 17, 937, 13)
+TEST_SCALE16(Up, 937, 13, 1283, 17)
+#undef TEST_SCALE16
+
+// Box filter UV and return the maximum difference from box filtering the U
+// and V planes separately.  0 = exact.
+static int UVTestBoxPlanes(int src_width,
+                           int src_height,
+                           int dst_width,
+                           int dst_height) {
+  const int src_uv_size = src_width * src_height * 2;
+  const int dst_uv_size = dst_width * dst_height * 2;
+  align_buffer_page_end(src_uv, src_uv_size);
+  align_buffer_page_end(src_u, src_width * src_height);
+  align_buffer_page_end(src_v, src_width * src_height);
+  align_buffer_page_end(dst_uv, dst_uv_size);
+  align_buffer_page_end(dst_u, dst_width * dst_height);
+  align_buffer_page_end(dst_v, dst_width * dst_height);
+  MemRandomize(src_uv, src_uv_size);
+  SplitUVPlane(src_uv, src_width * 2, src_u, src_width, src_v, src_width,
+               src_width, src_height);
+
+  UVScale(src_uv, src_width * 2, src_width, src_height, dst_uv, dst_width * 2,
+          dst_width, dst_height, kFilterBox);
+  ScalePlane(src_u, src_width, src_width, src_height, dst_u, dst_width,
+             dst_width, dst_height, kFilterBox);
+  ScalePlane(src_v, src_width, src_width, src_height, dst_v, dst_width,
+             dst_width, dst_height, kFilterBox);
+
+  int max_diff = 0;
+  for (int i = 0; i < dst_width * dst_height; ++i) {
+    int abs_diff = Abs(dst_uv[i * 2 + 0] - dst_u[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+    abs_diff = Abs(dst_uv[i * 2 + 1] - dst_v[i]);
+    if (abs_diff > max_diff) {
+      max_diff = abs_diff;
+    }
+  }
+
+  free_aligned_buffer_page_end(dst_v);
+  free_aligned_buffer_page_end(dst_u);
+  free_aligned_buffer_page_end(dst_uv);
+  free_aligned_buffer_page_end(src_v);
+  free_aligned_buffer_page_end(src_u);
+  free_aligned_buffer_page_end(src_uv);
+  return max_diff;
+}
+
+// Box filtered UV matches the plane box filter for scale factors without an
+// optimized 1/2 or 1/4 path.
+TEST_F(LibYUVScaleTest, UVScaleBoxMatchesPlanes) {
+  EXPECT_EQ(0, UVTestBoxPlanes(1280, 720, 213, 121));
+  EXPECT_EQ(0, UVTestBoxPlanes(1281, 723, 427, 241));  // 1/3
+  EXPECT_EQ(0, UVTestBoxPlanes(1284, 726, 214, 121));  // 1/6
+  EXPECT_EQ(0, UVTestBoxPlanes(1283, 17, 97, 3));
+}
+
 TEST_F(LibYUVScaleTest, UVTest3x) {
   const int kSrcStride = 48 * 2;
   const int kDstStride = 16 * 2;
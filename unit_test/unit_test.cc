@@ -20,6 +20,18 @@
 #endif
 #include "libyuv/cpu_id.h"
 
+#if defined(__clang__) && !defined(__wasm__)
+#if __has_include(<pthread.h>)
+#define LIBYUV_HAVE_PTHREAD 1
+#endif
+#elif defined(__linux__)
+#define LIBYUV_HAVE_PTHREAD 1
+#endif
+
+#ifdef LIBYUV_HAVE_PTHREAD
+#include <pthread.h>
+#endif
+
 unsigned int fastrand_seed = 0xfb;
 
 #ifdef LIBYUV_USE_ABSL_FLAGS
@@ -538,6 +550,48 @@ LibYUVCompareTest::LibYUVCompareTest()
                        1280.0);
 }
 
+#ifdef LIBYUV_HAVE_PTHREAD
+struct TestDispatchThread {
+  LibyuvJobFunc job;
+  void* job_opaque;
+  int first;
+  int step;
+  int num_jobs;
+};
+
+static void* TestDispatchThreadMain(void* arg) {
+  TestDispatchThread* t = static_cast<TestDispatchThread*>(arg);
+  for (int i = t->first; i < t->num_jobs; i += t->step) {
+    t->job(t->job_opaque, i);
+  }
+  return nullptr;
+}
+#endif  // LIBYUV_HAVE_PTHREAD
+
+void TestDispatch(void* dispatch_opaque,
+                  LibyuvJobFunc job,
+                  void* job_opaque,
+                  int num_jobs) {
+  int* num_calls = static_cast<int*>(dispatch_opaque);
+  ++*num_calls;
+#ifdef LIBYUV_HAVE_PTHREAD
+  const int kNumThreads = 4;
+  pthread_t threads[kNumThreads];
+  TestDispatchThread args[kNumThreads];
+  for (int i = 0; i < kNumThreads; ++i) {
+    args[i] = {job, job_opaque, i, kNumThreads, num_jobs};
+    pthread_create(&threads[i], nullptr, TestDispatchThreadMain, &args[i]);
+  }
+  for (int i = 0; i < kNumThreads; ++i) {
+    pthread_join(threads[i], nullptr);
+  }
+#else
+  for (int i = num_jobs - 1; i >= 0; --i) {
+    job(job_opaque, i);
+  }
+#endif  // LIBYUV_HAVE_PTHREAD
+}
+
 int main(int argc, char** argv) {
   ::testing::InitGoogleTest(&argc, argv);
 #ifdef LIBYUV_USE_ABSL_FLAGS
@@ -122,6 +122,14 @@ static inline void MemRandomize(uint8_t* dst, int64_t len) {
   }
 }
 
+// Dispatcher for the threaded functions.  Runs jobs on 4 threads, or in
+// reverse order on the calling thread when pthreads are unavailable.
+// dispatch_opaque points to an int that counts the calls.
+void TestDispatch(void* dispatch_opaque,
+                  LibyuvJobFunc job,
+                  void* job_opaque,
+                  int num_jobs);
+
 class LibYUVColorTest : public ::testing::Test {
  protected:
   LibYUVColorTest();
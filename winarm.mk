@@ -21,6 +21,7 @@ LOCAL_OBJ_FILES = \
 	source/convert_to_i420.o\
 	source/cpu_id.o\
 	source/planar_functions.o\
+	source/profile.o\
 	source/rotate.o\
 	source/rotate_any.o\
 	source/rotate_argb.o\
@@ -32,6 +33,7 @@ LOCAL_OBJ_FILES = \
 	source/scale_argb.o\
 	source/scale_common.o\
 	source/scale_uv.o\
+	source/slice.o\
 	source/video_common.o
 
 .cc.o: